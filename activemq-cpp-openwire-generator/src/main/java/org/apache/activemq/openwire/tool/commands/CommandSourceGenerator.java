@@ -183,7 +183,7 @@ public class CommandSourceGenerator extends CommandCodeGenerator {
         if (isHashable()) {
             out.println("////////////////////////////////////////////////////////////////////////////////");
             out.println("int " + getClassName() + "::getHashCode() const {");
-            out.println("    return decaf::util::HashCode<std::string>()(this->toString());");
+            generateHashCodeBody(out);
             out.println("}");
             out.println("");
         }
@@ -273,12 +273,20 @@ public class CommandSourceGenerator extends CommandCodeGenerator {
 
     protected void generateCopyDataStructureBody( PrintWriter out ) {
         for( JProperty property : getProperties() ) {
-            String getter = property.getGetter().getSimpleName();
-            String setter = property.getSetter().getSimpleName();
-            out.println("    this->"+setter+"(srcPtr->"+getter+"());");
+            generatePropertyCopy(out, property);
         }
     }
 
+    /**
+     * Emits the copy of one property in copyDataStructure, by default through the
+     * setter so that the mutation and setter hooks run.
+     */
+    protected void generatePropertyCopy( PrintWriter out, JProperty property ) {
+        String getter = property.getGetter().getSimpleName();
+        String setter = property.getSetter().getSimpleName();
+        out.println("    this->"+setter+"(srcPtr->"+getter+"());");
+    }
+
     protected void generateToStringBody( PrintWriter out ) {
 
         out.println("    ostringstream stream;" );
@@ -308,12 +316,7 @@ public class CommandSourceGenerator extends CommandCodeGenerator {
 
             if( property.getType().getSimpleName().equals("ByteSequence") ) {
 
-                out.println("    stream << \""+propertyName+" = \";");
-                out.println("    if (this->"+getter+"().size() > 0) {");
-                out.println("        stream << \"[size=\" << this->" + getter + "().size() << \"]\";");
-                out.println("    } else {");
-                out.println("        stream << \"NULL\";");
-                out.println("    }");
+                generateByteSequenceToString(out, property);
 
             } else if( type.equals("unsigned char") ){
                 out.println("    stream << \""+propertyName+" = \" << (int)this->"+getter+"();");
@@ -374,6 +377,10 @@ public class CommandSourceGenerator extends CommandCodeGenerator {
         out.println("    return stream.str();");
     }
 
+    protected void generateHashCodeBody( PrintWriter out ) {
+        out.println("    return decaf::util::HashCode<std::string>()(this->toString());");
+    }
+
     protected void generateEqualsBody( PrintWriter out ) {
         for( JProperty property : getProperties() ) {
             String type = toCppType(property.getType());
@@ -382,11 +389,7 @@ public class CommandSourceGenerator extends CommandCodeGenerator {
             String getter = property.getGetter().getSimpleName();
 
             if( property.getType().getSimpleName().equals("ByteSequence") ) {
-                out.println("    for (size_t i" + parameterName + " = 0; i" + parameterName + " < this->"+getter+"().size(); ++i" + parameterName + ") {");
-                out.println("        if (this->"+getter+"()[i" + parameterName+"] != valuePtr->"+getter+"()[i"+parameterName+"]) {" );
-                out.println("            return false;" );
-                out.println("        }" );
-                out.println("    }" );
+                generateByteSequenceEquals(out, property);
             } else if( property.getType().isPrimitiveType() || type.equals("std::string") ){
                 out.println("    if (this->"+getter+"() != valuePtr->"+getter+"()) {");
                 out.println("        return false;" );
@@ -423,6 +426,35 @@ public class CommandSourceGenerator extends CommandCodeGenerator {
         }
     }
 
+    /**
+     * Emits the toString() output for a ByteSequence property, which is its size.
+     */
+    protected void generateByteSequenceToString( PrintWriter out, JProperty property ) {
+        String propertyName = property.getSimpleName();
+        String getter = property.getGetter().getSimpleName();
+
+        out.println("    stream << \""+propertyName+" = \";");
+        out.println("    if (this->"+getter+"().size() > 0) {");
+        out.println("        stream << \"[size=\" << this->" + getter + "().size() << \"]\";");
+        out.println("    } else {");
+        out.println("        stream << \"NULL\";");
+        out.println("    }");
+    }
+
+    /**
+     * Emits the equals() comparison of a ByteSequence property.
+     */
+    protected void generateByteSequenceEquals( PrintWriter out, JProperty property ) {
+        String parameterName = decapitalize(property.getSimpleName());
+        String getter = property.getGetter().getSimpleName();
+
+        out.println("    for (size_t i" + parameterName + " = 0; i" + parameterName + " < this->"+getter+"().size(); ++i" + parameterName + ") {");
+        out.println("        if (this->"+getter+"()[i" + parameterName+"] != valuePtr->"+getter+"()[i"+parameterName+"]) {" );
+        out.println("            return false;" );
+        out.println("        }" );
+        out.println("    }" );
+    }
+
     protected void generatePropertyAccessors( PrintWriter out ) {
         for( JProperty property : getProperties() ) {
 
@@ -460,6 +492,8 @@ public class CommandSourceGenerator extends CommandCodeGenerator {
                 out.println("");
                 out.println("////////////////////////////////////////////////////////////////////////////////");
                 out.println(""+type+" "+getClassName()+"::"+getter+"() {");
+                generatePropertyAccessHook(out, property);
+                generatePropertyMutationHook(out, property);
                 out.println("    return "+parameterName+";");
                 out.println("}");
                 out.println("");
@@ -467,11 +501,34 @@ public class CommandSourceGenerator extends CommandCodeGenerator {
             out.println("////////////////////////////////////////////////////////////////////////////////");
             out.println("void " + getClassName() + "::" + setter+"(" + constNess + type+ " " + parameterName +") {");
             out.println("    this->"+parameterName+" = "+parameterName+";");
+            generatePropertyMutationHook(out, property);
+            generatePropertySetterHook(out, property);
             out.println("}");
             out.println("");
         }
     }
 
+    /**
+     * Emits code that runs before a property is handed out for modification by its
+     * non-const getter, ahead of the mutation hook.  Nothing is emitted by default.
+     */
+    protected void generatePropertyAccessHook( PrintWriter out, JProperty property ) {
+    }
+
+    /**
+     * Emits code that runs whenever a property may have been modified, which is
+     * in its setter and in its non-const getter.  Nothing is emitted by default.
+     */
+    protected void generatePropertyMutationHook( PrintWriter out, JProperty property ) {
+    }
+
+    /**
+     * Emits code that runs only in a property's setter, after the mutation hook.
+     * Nothing is emitted by default.
+     */
+    protected void generatePropertySetterHook( PrintWriter out, JProperty property ) {
+    }
+
     protected void generateCompareToBody( PrintWriter out ) {
         for( JProperty property : getProperties() ) {
 
@@ -0,0 +1,71 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package org.apache.activemq.openwire.tool.commands;
+
+import java.io.PrintWriter;
+import java.util.Set;
+
+/**
+ * Base for the header generators of the ids that carry a connection id string, see
+ * ConnectionScopedIdSourceGenerator.  The private section opened here is where the
+ * subclasses add their own cached members.
+ *
+ * @since 3.8
+ */
+public abstract class ConnectionScopedIdHeaderGenerator extends CommandHeaderGenerator {
+
+    protected void populateIncludeFilesSet() {
+        Set<String> includes = getIncludeFiles();
+        includes.add("<activemq/util/CompactId.h>");
+
+        super.populateIncludeFilesSet();
+    }
+
+    protected void generateProperties( PrintWriter out ) {
+
+        super.generateProperties(out);
+
+        out.println("    private:");
+        out.println("");
+        out.println("        activemq::util::ConnectionKey connectionKey;");
+    }
+
+    protected void generateAdditonalMembers( PrintWriter out ) {
+        out.println("        /**");
+        out.println("         * @return the interned form of this id's connection id, updated by setConnectionId.");
+        out.println("         */");
+        out.println("        const activemq::util::ConnectionKey& getConnectionKey() const;");
+        out.println("");
+        out.println("        /**");
+        out.println("         * Sets the connection id from an already interned key, used by the marshalers");
+        out.println("         * so that the ids read from one connection don't each go through the table.");
+        out.println("         *");
+        out.println("         * @param connectionKey");
+        out.println("         *      The interned connection id, a NULL key clears the connection id.");
+        out.println("         */");
+        out.println("        void setConnectionKey(const activemq::util::ConnectionKey& connectionKey);");
+        out.println("");
+        out.println("        /**");
+        out.println("         * @return the numeric form of this id, used as the key in maps that see every message.");
+        out.println("         */");
+        out.println("        activemq::util::CompactId getCompactId() const;");
+        out.println("");
+
+        super.generateAdditonalMembers( out );
+    }
+
+}
@@ -0,0 +1,115 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package org.apache.activemq.openwire.tool.commands;
+
+import java.io.PrintWriter;
+
+import org.codehaus.jam.JProperty;
+
+/**
+ * Base for the source generators of the ids that carry a connection id string, adds
+ * the interned connection key and the CompactId form used for comparing and hashing
+ * them.  The key is interned whenever the connection id is set, unless it already
+ * holds that id, and copied along with it, so the const accessors never modify the id.
+ *
+ * @since 3.8
+ */
+public abstract class ConnectionScopedIdSourceGenerator extends CommandSourceGenerator {
+
+    /**
+     * @return the session, value and sequence arguments passed to the CompactId
+     *         constructor after the connection key.
+     */
+    protected abstract String getCompactIdArguments();
+
+    protected String generateInitializerList() {
+        return super.generateInitializerList() + ", connectionKey()";
+    }
+
+    protected void generateCopyDataStructureBody( PrintWriter out ) {
+        for( JProperty property : getProperties() ) {
+            if( property.getSimpleName().equals("ConnectionId") ) {
+                out.println("    this->connectionId = srcPtr->connectionId;");
+                out.println("    this->connectionKey = srcPtr->connectionKey;");
+            } else {
+                String getter = property.getGetter().getSimpleName();
+                String setter = property.getSetter().getSimpleName();
+                out.println("    this->"+setter+"(srcPtr->"+getter+"());");
+            }
+        }
+    }
+
+    protected void generatePropertySetterHook( PrintWriter out, JProperty property ) {
+        super.generatePropertySetterHook(out, property);
+
+        if( property.getSimpleName().equals("ConnectionId") ) {
+            out.println("    if (this->connectionKey == NULL || this->connectionKey->getConnectionId() != this->connectionId) {");
+            out.println("        this->connectionKey = activemq::util::ConnectionIdTable::intern(this->connectionId);");
+            out.println("    }");
+        }
+    }
+
+    protected void generateCompareToBody( PrintWriter out ) {
+        for( JProperty property : getProperties() ) {
+
+            String parameterName = decapitalize(property.getSimpleName());
+
+            if( property.getSimpleName().equals("ConnectionId") ) {
+                out.println("    if (this->connectionKey == NULL || this->connectionKey != value.connectionKey) {");
+                out.println("        int connectionIdComp = StringUtils::compareIgnoreCase(this->connectionId.c_str(), value.connectionId.c_str());");
+                out.println("        if (connectionIdComp != 0) {");
+                out.println("            return connectionIdComp;");
+                out.println("        }");
+                out.println("    }");
+                out.println("");
+            } else {
+                out.println("    if (this->"+parameterName+" > value."+parameterName+") {");
+                out.println("        return 1;");
+                out.println("    } else if(this->"+parameterName+" < value."+parameterName+") {");
+                out.println("        return -1;");
+                out.println("    }");
+                out.println("");
+            }
+        }
+    }
+
+    protected void generateHashCodeBody( PrintWriter out ) {
+        out.println("    return this->getCompactId().getHashCode();");
+    }
+
+    protected void generateAdditionalMethods( PrintWriter out ) {
+        out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("const activemq::util::ConnectionKey& "+getClassName()+"::getConnectionKey() const {");
+        out.println("    return this->connectionKey;");
+        out.println("}");
+        out.println("");
+        out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("void "+getClassName()+"::setConnectionKey(const activemq::util::ConnectionKey& connectionKey) {");
+        out.println("    this->connectionKey = connectionKey;");
+        out.println("    this->connectionId = connectionKey != NULL ? connectionKey->getConnectionId() : std::string();");
+        out.println("}");
+        out.println("");
+        out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("activemq::util::CompactId "+getClassName()+"::getCompactId() const {");
+        out.println("    return activemq::util::CompactId(this->getConnectionKey(), "+getCompactIdArguments()+");");
+        out.println("}");
+        out.println("");
+
+        super.generateAdditionalMethods(out);
+    }
+
+}
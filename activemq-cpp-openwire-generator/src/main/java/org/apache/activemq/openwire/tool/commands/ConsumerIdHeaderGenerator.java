@@ -19,7 +19,7 @@ package org.apache.activemq.openwire.tool.commands;
 import java.io.PrintWriter;
 import java.util.Set;
 
-public class ConsumerIdHeaderGenerator extends CommandHeaderGenerator {
+public class ConsumerIdHeaderGenerator extends ConnectionScopedIdHeaderGenerator {
 
     protected void populateIncludeFilesSet() {
         Set<String> includes = getIncludeFiles();
@@ -39,8 +39,6 @@ public class ConsumerIdHeaderGenerator extends CommandHeaderGenerator {
 
         super.generateProperties(out);
 
-        out.println("    private:");
-        out.println("");
         out.println("        mutable Pointer<SessionId> parentId;");
         out.println("");
     }
@@ -19,7 +19,7 @@ package org.apache.activemq.openwire.tool.commands;
 import java.io.PrintWriter;
 import java.util.Set;
 
-public class ConsumerIdSourceGenerator extends CommandSourceGenerator {
+public class ConsumerIdSourceGenerator extends ConnectionScopedIdSourceGenerator {
 
     protected void generateAdditionalConstructors( PrintWriter out ) {
 
@@ -28,6 +28,7 @@ public class ConsumerIdSourceGenerator extends CommandSourceGenerator {
         out.println("    " + generateInitializerList() + " {");
         out.println("");
         out.println("    this->connectionId = sessionId.getConnectionId();");
+        out.println("    this->connectionKey = sessionId.getConnectionKey();");
         out.println("    this->sessionId = sessionId.getValue();");
         out.println("    this->value = consumerId;");
         out.println("}");
@@ -36,6 +37,10 @@ public class ConsumerIdSourceGenerator extends CommandSourceGenerator {
         super.generateAdditionalConstructors(out);
     }
 
+    protected String getCompactIdArguments() {
+        return "this->sessionId, this->value";
+    }
+
     protected String generateInitializerList() {
         return super.generateInitializerList() + ", parentId()";
     }
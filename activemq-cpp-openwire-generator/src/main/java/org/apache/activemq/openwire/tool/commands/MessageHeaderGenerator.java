@@ -28,6 +28,8 @@ public class MessageHeaderGenerator extends CommandHeaderGenerator {
         Set<String> includes = getIncludeFiles();
         includes.add("<activemq/util/PrimitiveMap.h>");
         includes.add("<activemq/core/ActiveMQAckHandler.h>");
+        includes.add("<activemq/metrics/MessageTrace.h>");
+        includes.add("<activemq/util/MappedFileRegion.h>");
     }
 
     protected void generateNamespaceWrapper( PrintWriter out ) {
@@ -52,7 +54,7 @@ public class MessageHeaderGenerator extends CommandHeaderGenerator {
         out.println("");
         out.println("        // Message properties, these are Marshaled and Unmarshaled from the Message");
         out.println("        // Command's marshaledProperties vector.");
-        out.println("        activemq::util::PrimitiveMap properties;");
+        out.println("        mutable activemq::util::PrimitiveMap properties;");
         out.println("");
         out.println("        // Indicates if the Message Properties are Read Only");
         out.println("        bool readOnlyProperties;");
@@ -60,6 +62,26 @@ public class MessageHeaderGenerator extends CommandHeaderGenerator {
         out.println("        // Indicates if the Message Body are Read Only");
         out.println("        bool readOnlyBody;");
         out.println("");
+        out.println("        // Latency trace of this message when it has been sampled, never marshaled.");
+        out.println("        Pointer<metrics::MessageTrace> trace;");
+        out.println("");
+        out.println("        // The body when it is mapped from a file in place of content, shared by");
+        out.println("        // copies of this Message and marshaled directly from the mapping.");
+        out.println("        Pointer<activemq::util::MappedFileRegion> mappedContent;");
+        out.println("");
+        out.println("        // Indicates that marshalledProperties holds the encoding of the current");
+        out.println("        // properties so they need not be encoded again, never marshaled.");
+        out.println("        bool propertiesMarshalled;");
+        out.println("");
+        out.println("        // Indicates that the properties were supplied already encoded and are only");
+        out.println("        // decoded into the properties map when first read, never marshaled.");
+        out.println("        mutable bool propertiesPending;");
+        out.println("");
+        out.println("        // The last complete frame this Message was marshaled into along with the");
+        out.println("        // key of the wire format settings used, a key of zero means no frame.");
+        out.println("        std::vector<unsigned char> cachedWireForm;");
+        out.println("        int cachedWireFormKey;");
+        out.println("");
         out.println("    protected:");
         out.println("");
         out.println("        core::ActiveMQConnection* connection;");
@@ -170,13 +192,22 @@ public class MessageHeaderGenerator extends CommandHeaderGenerator {
         out.println("         * @return a reference to the Primitive Map that holds message properties.");
         out.println("         */");
         out.println("        util::PrimitiveMap& getMessageProperties() {");
+        out.println("            this->unmarshalPendingProperties();");
+        out.println("            this->invalidateMarshalledProperties();");
         out.println("            return this->properties;");
         out.println("        }");
         out.println("        const util::PrimitiveMap& getMessageProperties() const {");
+        out.println("            this->unmarshalPendingProperties();");
         out.println("            return this->properties;");
         out.println("        }");
         out.println("");
         out.println("        /**");
+        out.println("         * Decodes properties that were supplied already encoded into the properties");
+        out.println("         * map, does nothing when there are none pending.");
+        out.println("         */");
+        out.println("        void unmarshalPendingProperties() const;");
+        out.println("");
+        out.println("        /**");
         out.println("         * Returns if the Message Properties Are Read Only");
         out.println("         * @return true if Message Properties are Read Only.");
         out.println("         */");
@@ -208,6 +239,129 @@ public class MessageHeaderGenerator extends CommandHeaderGenerator {
         out.println("            this->readOnlyBody = value;");
         out.println("        }");
         out.println("");
+        out.println("        /**");
+        out.println("         * Gets the latency trace that follows this Message through the send or");
+        out.println("         * dispatch pipeline.");
+        out.println("         * @returns the trace or NULL if this Message wasn't sampled.");
+        out.println("         */");
+        out.println("        const Pointer<metrics::MessageTrace>& getTrace() const {");
+        out.println("            return this->trace;");
+        out.println("        }");
+        out.println("");
+        out.println("        /**");
+        out.println("         * Sets the latency trace that follows this Message through the send or");
+        out.println("         * dispatch pipeline.");
+        out.println("         * @param trace - the trace to stamp or NULL to stop tracing.");
+        out.println("         */");
+        out.println("        void setTrace(const Pointer<metrics::MessageTrace>& trace) {");
+        out.println("            this->trace = trace;");
+        out.println("        }");
+        out.println("");
+        out.println("        /**");
+        out.println("         * Encodes the Message properties into the marshalled properties unless the");
+        out.println("         * current properties have already been encoded.  Clones copy the encoding");
+        out.println("         * so a Message sent to many destinations has its properties encoded once.");
+        out.println("         *");
+        out.println("         * @throws IOException if the properties cannot be encoded.");
+        out.println("         */");
+        out.println("        void marshalProperties();");
+        out.println("");
+        out.println("        /**");
+        out.println("         * Marks the Message properties as modified, the encoded properties and any");
+        out.println("         * cached frame are discarded.  Code that writes the properties other than");
+        out.println("         * through getMessageProperties() must call this afterwards.");
+        out.println("         */");
+        out.println("        void invalidateMarshalledProperties() {");
+        out.println("            this->propertiesMarshalled = false;");
+        out.println("            this->clearCachedWireForm();");
+        out.println("        }");
+        out.println("");
+        out.println("        /**");
+        out.println("         * Replaces the properties of this Message with ones that were encoded elsewhere,");
+        out.println("         * the encoding is sent as is and only decoded if the properties are read.  The");
+        out.println("         * given vector receives the previous encoding so its storage can be reused.");
+        out.println("         *");
+        out.println("         * @param encoded - the properties in the form PrimitiveTypesMarshaller writes.");
+        out.println("         */");
+        out.println("        void swapEncodedProperties(std::vector<unsigned char>& encoded);");
+        out.println("");
+        out.println("        /**");
+        out.println("         * Returns true if this Message holds a frame marshaled with the wire format");
+        out.println("         * settings identified by the given key and has not been modified since.");
+        out.println("         *");
+        out.println("         * @param key - the non-zero key of the wire format settings.");
+        out.println("         */");
+        out.println("        bool hasCachedWireForm(int key) const {");
+        out.println("            return key != 0 && this->cachedWireFormKey == key;");
+        out.println("        }");
+        out.println("");
+        out.println("        /**");
+        out.println("         * @returns the cached frame, empty when hasCachedWireForm is false.");
+        out.println("         */");
+        out.println("        const std::vector<unsigned char>& getCachedWireForm() const {");
+        out.println("            return this->cachedWireForm;");
+        out.println("        }");
+        out.println("");
+        out.println("        /**");
+        out.println("         * Stores the frame this Message was just marshaled into, the frame is");
+        out.println("         * dropped again by any setter or non-const getter of this Message.");
+        out.println("         *");
+        out.println("         * @param key - the non-zero key of the wire format settings used.");
+        out.println("         * @param frame - the encoded frame.");
+        out.println("         * @param length - the number of bytes in the frame.");
+        out.println("         */");
+        out.println("        void setCachedWireForm(int key, const unsigned char* frame, int length);");
+        out.println("");
+        out.println("        /**");
+        out.println("         * Discards the cached frame, if any.");
+        out.println("         */");
+        out.println("        void clearCachedWireForm() {");
+        out.println("            if (this->cachedWireFormKey != 0) {");
+        out.println("                this->cachedWireFormKey = 0;");
+        out.println("                std::vector<unsigned char>().swap(this->cachedWireForm);");
+        out.println("            }");
+        out.println("        }");
+        out.println("");
+        out.println("        /**");
+        out.println("         * Replaces the body of this Message with a region of a mapped file, the");
+        out.println("         * content stays empty until the non-const getContent() copies the body into it.");
+        out.println("         * The body is read in place with getContentBytes() and getContentLength().");
+        out.println("         *");
+        out.println("         * @param region - the mapped bytes that form the body.");
+        out.println("         */");
+        out.println("        void setMappedContent(const Pointer<activemq::util::MappedFileRegion>& region);");
+        out.println("");
+        out.println("        /**");
+        out.println("         * @returns the mapped region holding the body or NULL if the body is in the content.");
+        out.println("         */");
+        out.println("        const Pointer<activemq::util::MappedFileRegion>& getMappedContent() const {");
+        out.println("            return this->mappedContent;");
+        out.println("        }");
+        out.println("");
+        out.println("        /**");
+        out.println("         * Copies a mapped body into the content and releases the mapping, the");
+        out.println("         * non-const getContent() does this before handing out the content.");
+        out.println("         */");
+        out.println("        void loadMappedContent();");
+        out.println("");
+        out.println("        /**");
+        out.println("         * @returns the number of bytes in the body, whether mapped or not.");
+        out.println("         */");
+        out.println("        int getContentLength() const {");
+        out.println("            return this->mappedContent != NULL ?");
+        out.println("                this->mappedContent->getLength() : (int) this->content.size();");
+        out.println("        }");
+        out.println("");
+        out.println("        /**");
+        out.println("         * @returns the bytes of the body, whether mapped or not, or NULL when it is empty.");
+        out.println("         */");
+        out.println("        const unsigned char* getContentBytes() const {");
+        out.println("            if (this->mappedContent != NULL) {");
+        out.println("                return this->mappedContent->getData();");
+        out.println("            }");
+        out.println("            return this->content.empty() ? NULL : &this->content[0];");
+        out.println("        }");
+        out.println("");
     }
 
 }
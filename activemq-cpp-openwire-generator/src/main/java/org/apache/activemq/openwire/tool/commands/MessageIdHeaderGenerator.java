@@ -58,6 +58,12 @@ public class MessageIdHeaderGenerator extends CommandHeaderGenerator {
         out.println("");
         out.println("        void setTextView(const std::string& key);");
         out.println("");
+        out.println("        /**");
+        out.println("         * @return the numeric form of this id, the CompactId of the producer that sent");
+        out.println("         *         it with the producer sequence id added.");
+        out.println("         */");
+        out.println("        activemq::util::CompactId getCompactId() const;");
+        out.println("");
 
         super.generateAdditonalMembers( out );
     }
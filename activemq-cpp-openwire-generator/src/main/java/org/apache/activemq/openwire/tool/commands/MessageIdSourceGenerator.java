@@ -85,6 +85,17 @@ public class MessageIdSourceGenerator extends CommandSourceGenerator {
         out.println("    this->key = key;");
         out.println("}");
         out.println("");
+        out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("activemq::util::CompactId MessageId::getCompactId() const {");
+        out.println("");
+        out.println("    if (this->producerId == NULL) {");
+        out.println("        return activemq::util::CompactId(activemq::util::ConnectionKey(), 0, 0, this->producerSequenceId);");
+        out.println("    }");
+        out.println("");
+        out.println("    return activemq::util::CompactId(this->producerId->getConnectionKey(), this->producerId->getSessionId(),");
+        out.println("                                     this->producerId->getValue(), this->producerSequenceId);");
+        out.println("}");
+        out.println("");
 
         super.generateAdditionalMethods(out);
     }
@@ -98,6 +109,10 @@ public class MessageIdSourceGenerator extends CommandSourceGenerator {
         includes.add("<sstream>");
     }
 
+    protected void generateHashCodeBody( PrintWriter out ) {
+        out.println("    return this->getCompactId().getHashCode();");
+    }
+
     protected void generateToStringBody( PrintWriter out ) {
         out.println("    if (key.empty()) {");
         out.println("        this->key = this->producerId->toString() + \":\" + ");
@@ -19,6 +19,8 @@ package org.apache.activemq.openwire.tool.commands;
 import java.io.PrintWriter;
 import java.util.Set;
 
+import org.codehaus.jam.JProperty;
+
 public class MessageSourceGenerator extends CommandSourceGenerator {
 
     protected void populateIncludeFilesSet() {
@@ -29,6 +31,7 @@ public class MessageSourceGenerator extends CommandSourceGenerator {
         includes.add("<activemq/core/ActiveMQAckHandler.h>");
         includes.add("<activemq/core/ActiveMQConnection.h>");
         includes.add("<decaf/lang/System.h>");
+        includes.add("<cstring>");
     }
 
     protected String generateInitializerList() {
@@ -39,6 +42,12 @@ public class MessageSourceGenerator extends CommandSourceGenerator {
         result.append(", properties()");
         result.append(", readOnlyProperties(false)");
         result.append(", readOnlyBody(false)");
+        result.append(", trace()");
+        result.append(", mappedContent()");
+        result.append(", propertiesMarshalled(false)");
+        result.append(", propertiesPending(false)");
+        result.append(", cachedWireForm()");
+        result.append(", cachedWireFormKey(0)");
         result.append(", connection(NULL)");
 
         return result.toString();
@@ -52,6 +61,69 @@ public class MessageSourceGenerator extends CommandSourceGenerator {
         out.println("    this->setReadOnlyBody(srcPtr->isReadOnlyBody());");
         out.println("    this->setReadOnlyProperties(srcPtr->isReadOnlyProperties());");
         out.println("    this->setConnection(srcPtr->getConnection());");
+        out.println("    this->propertiesMarshalled = srcPtr->propertiesMarshalled;");
+        out.println("    this->propertiesPending = srcPtr->propertiesPending;");
+    }
+
+    protected void generatePropertyCopy( PrintWriter out, JProperty property ) {
+
+        // A mapped body is shared with the copy rather than read into its content.
+        if( property.getSimpleName().equals("Content") ) {
+            out.println("    this->content = srcPtr->content;");
+            out.println("    this->mappedContent = srcPtr->mappedContent;");
+        } else {
+            super.generatePropertyCopy(out, property);
+        }
+    }
+
+    protected void generatePropertyAccessHook( PrintWriter out, JProperty property ) {
+        super.generatePropertyAccessHook(out, property);
+
+        if( property.getSimpleName().equals("Content") ) {
+            out.println("    this->loadMappedContent();");
+        }
+    }
+
+    protected void generateByteSequenceToString( PrintWriter out, JProperty property ) {
+        if( !property.getSimpleName().equals("Content") ) {
+            super.generateByteSequenceToString(out, property);
+            return;
+        }
+
+        out.println("    stream << \"Content = \";");
+        out.println("    if (this->getContentLength() > 0) {");
+        out.println("        stream << \"[size=\" << this->getContentLength() << \"]\";");
+        out.println("    } else {");
+        out.println("        stream << \"NULL\";");
+        out.println("    }");
+    }
+
+    protected void generateByteSequenceEquals( PrintWriter out, JProperty property ) {
+        if( !property.getSimpleName().equals("Content") ) {
+            super.generateByteSequenceEquals(out, property);
+            return;
+        }
+
+        out.println("    if (this->getContentLength() != valuePtr->getContentLength()) {");
+        out.println("        return false;");
+        out.println("    }");
+        out.println("    if (this->getContentLength() > 0 &&");
+        out.println("        std::memcmp(this->getContentBytes(), valuePtr->getContentBytes(), this->getContentLength()) != 0) {");
+        out.println("        return false;");
+        out.println("    }");
+    }
+
+    protected void generatePropertyMutationHook( PrintWriter out, JProperty property ) {
+        super.generatePropertyMutationHook(out, property);
+
+        if( property.getSimpleName().equals("MarshalledProperties") ) {
+            out.println("    this->invalidateMarshalledProperties();");
+        } else if( property.getSimpleName().equals("Content") ) {
+            out.println("    this->mappedContent.reset(NULL);");
+            out.println("    this->clearCachedWireForm();");
+        } else {
+            out.println("    this->clearCachedWireForm();");
+        }
     }
 
     protected void generateToStringBody( PrintWriter out ) {
@@ -65,7 +137,7 @@ public class MessageSourceGenerator extends CommandSourceGenerator {
         out.println("        return false;");
         out.println("    }");
         out.println("");
-        out.println("    if (!properties.equals(valuePtr->properties)) {");
+        out.println("    if (!getMessageProperties().equals(valuePtr->getMessageProperties())) {");
         out.println("        return false;");
         out.println("    }");
         out.println("");
@@ -102,7 +174,7 @@ public class MessageSourceGenerator extends CommandSourceGenerator {
         out.println("");
         out.println("    unsigned int size = DEFAULT_MESSAGE_SIZE;");
         out.println("");
-        out.println("    size += (unsigned int)this->getContent().size();");
+        out.println("    size += (unsigned int)this->getContentLength();");
         out.println("    size += (unsigned int)this->getMarshalledProperties().size();");
         out.println("");
         out.println("    return size;");
@@ -112,11 +184,41 @@ public class MessageSourceGenerator extends CommandSourceGenerator {
         out.println("void Message::beforeMarshal(wireformat::WireFormat* wireFormat AMQCPP_UNUSED) {");
         out.println("");
         out.println("    try {");
+        out.println("        this->marshalProperties();");
+        out.println("    }");
+        out.println("    AMQ_CATCH_RETHROW(decaf::io::IOException)");
+        out.println("    AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::Exception, decaf::io::IOException)");
+        out.println("    AMQ_CATCHALL_THROW(decaf::io::IOException)");
+        out.println("}");
+        out.println("");
+        out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("void Message::afterUnmarshal(wireformat::WireFormat* wireFormat AMQCPP_UNUSED) {");
+        out.println("");
+        out.println("    try {");
+        out.println("        wireformat::openwire::marshal::PrimitiveTypesMarshaller::unmarshal(");
+        out.println("            &properties, marshalledProperties);");
+        out.println("        this->propertiesMarshalled = true;");
+        out.println("        this->propertiesPending = false;");
+        out.println("    }");
+        out.println("    AMQ_CATCH_RETHROW(decaf::io::IOException)");
+        out.println("    AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::Exception, decaf::io::IOException)");
+        out.println("    AMQ_CATCHALL_THROW(decaf::io::IOException)");
+        out.println("}");
+        out.println("");
+        out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("void Message::marshalProperties() {");
+        out.println("");
+        out.println("    try {");
+        out.println("        if (this->propertiesMarshalled || this->propertiesPending) {");
+        out.println("            return;");
+        out.println("        }");
+        out.println("");
         out.println("        marshalledProperties.clear();");
         out.println("        if (!properties.isEmpty()) {");
         out.println("            wireformat::openwire::marshal::PrimitiveTypesMarshaller::marshal(");
         out.println("                &properties, marshalledProperties );");
         out.println("        }");
+        out.println("        this->propertiesMarshalled = true;");
         out.println("    }");
         out.println("    AMQ_CATCH_RETHROW(decaf::io::IOException)");
         out.println("    AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::Exception, decaf::io::IOException)");
@@ -124,17 +226,67 @@ public class MessageSourceGenerator extends CommandSourceGenerator {
         out.println("}");
         out.println("");
         out.println("////////////////////////////////////////////////////////////////////////////////");
-        out.println("void Message::afterUnmarshal(wireformat::WireFormat* wireFormat AMQCPP_UNUSED) {");
+        out.println("void Message::unmarshalPendingProperties() const {");
         out.println("");
         out.println("    try {");
-        out.println("        wireformat::openwire::marshal::PrimitiveTypesMarshaller::unmarshal(");
-        out.println("            &properties, marshalledProperties);");
+        out.println("        if (!this->propertiesPending) {");
+        out.println("            return;");
+        out.println("        }");
+        out.println("");
+        out.println("        properties.clear();");
+        out.println("        if (!marshalledProperties.empty()) {");
+        out.println("            wireformat::openwire::marshal::PrimitiveTypesMarshaller::unmarshal(");
+        out.println("                &properties, marshalledProperties);");
+        out.println("        }");
+        out.println("        this->propertiesPending = false;");
         out.println("    }");
         out.println("    AMQ_CATCH_RETHROW(decaf::io::IOException)");
         out.println("    AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::Exception, decaf::io::IOException)");
         out.println("    AMQ_CATCHALL_THROW(decaf::io::IOException)");
         out.println("}");
         out.println("");
+        out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("void Message::swapEncodedProperties(std::vector<unsigned char>& encoded) {");
+        out.println("");
+        out.println("    this->properties.clear();");
+        out.println("    this->marshalledProperties.swap(encoded);");
+        out.println("    this->propertiesMarshalled = true;");
+        out.println("    this->propertiesPending = true;");
+        out.println("    this->clearCachedWireForm();");
+        out.println("}");
+        out.println("");
+        out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("void Message::setCachedWireForm(int key, const unsigned char* frame, int length) {");
+        out.println("");
+        out.println("    if (key == 0 || frame == NULL || length <= 0) {");
+        out.println("        this->clearCachedWireForm();");
+        out.println("        return;");
+        out.println("    }");
+        out.println("");
+        out.println("    this->cachedWireForm.assign(frame, frame + length);");
+        out.println("    this->cachedWireFormKey = key;");
+        out.println("}");
+        out.println("");
+        out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("void Message::setMappedContent(const Pointer<activemq::util::MappedFileRegion>& region) {");
+        out.println("");
+        out.println("    std::vector<unsigned char>().swap(this->content);");
+        out.println("    this->mappedContent = region;");
+        out.println("    this->clearCachedWireForm();");
+        out.println("}");
+        out.println("");
+        out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("void Message::loadMappedContent() {");
+        out.println("");
+        out.println("    if (this->mappedContent == NULL) {");
+        out.println("        return;");
+        out.println("    }");
+        out.println("");
+        out.println("    const unsigned char* data = this->mappedContent->getData();");
+        out.println("    this->content.assign(data, data + this->mappedContent->getLength());");
+        out.println("    this->mappedContent.reset(NULL);");
+        out.println("}");
+        out.println("");
     }
 
 }
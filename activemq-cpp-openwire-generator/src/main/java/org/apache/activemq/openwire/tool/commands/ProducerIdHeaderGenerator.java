@@ -19,7 +19,7 @@ package org.apache.activemq.openwire.tool.commands;
 import java.io.PrintWriter;
 import java.util.Set;
 
-public class ProducerIdHeaderGenerator extends CommandHeaderGenerator {
+public class ProducerIdHeaderGenerator extends ConnectionScopedIdHeaderGenerator {
 
     protected void populateIncludeFilesSet() {
         Set<String> includes = getIncludeFiles();
@@ -41,8 +41,6 @@ public class ProducerIdHeaderGenerator extends CommandHeaderGenerator {
 
         super.generateProperties(out);
 
-        out.println("    private:");
-        out.println("");
         out.println("        mutable Pointer<SessionId> parentId;");
         out.println("");
     }
@@ -19,7 +19,7 @@ package org.apache.activemq.openwire.tool.commands;
 import java.io.PrintWriter;
 import java.util.Set;
 
-public class ProducerIdSourceGenerator extends CommandSourceGenerator {
+public class ProducerIdSourceGenerator extends ConnectionScopedIdSourceGenerator {
 
     protected void generateAdditionalConstructors( PrintWriter out ) {
 
@@ -28,6 +28,7 @@ public class ProducerIdSourceGenerator extends CommandSourceGenerator {
         out.println("    " + generateInitializerList() + " {");
         out.println("");
         out.println("    this->connectionId = sessionId.getConnectionId();");
+        out.println("    this->connectionKey = sessionId.getConnectionKey();");
         out.println("    this->sessionId = sessionId.getValue();");
         out.println("    this->value = consumerId;");
         out.println("}");
@@ -51,6 +52,10 @@ public class ProducerIdSourceGenerator extends CommandSourceGenerator {
         super.generateAdditionalConstructors(out);
     }
 
+    protected String getCompactIdArguments() {
+        return "this->sessionId, this->value";
+    }
+
     protected String generateInitializerList() {
         return super.generateInitializerList() + ", parentId()";
     }
@@ -77,7 +82,9 @@ public class ProducerIdSourceGenerator extends CommandSourceGenerator {
         out.println("");
         out.println("    // The rest is the value");
         out.println("    this->connectionId = sessionKey;");
+        out.println("    this->connectionKey = activemq::util::ConnectionIdTable::intern(this->connectionId);");
         out.println("}");
+        out.println("");
 
         super.generateAdditionalMethods(out);
     }
@@ -19,7 +19,7 @@ package org.apache.activemq.openwire.tool.commands;
 import java.io.PrintWriter;
 import java.util.Set;
 
-public class SessionIdHeaderGenerator extends CommandHeaderGenerator {
+public class SessionIdHeaderGenerator extends ConnectionScopedIdHeaderGenerator {
 
     protected void populateIncludeFilesSet() {
         Set<String> includes = getIncludeFiles();
@@ -50,8 +50,6 @@ public class SessionIdHeaderGenerator extends CommandHeaderGenerator {
 
         super.generateProperties(out);
 
-        out.println("    private:");
-        out.println("");
         out.println("        mutable Pointer<ConnectionId> parentId;");
         out.println("");
     }
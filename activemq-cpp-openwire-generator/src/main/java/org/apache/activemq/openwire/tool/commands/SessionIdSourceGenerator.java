@@ -19,7 +19,7 @@ package org.apache.activemq.openwire.tool.commands;
 import java.io.PrintWriter;
 import java.util.Set;
 
-public class SessionIdSourceGenerator extends CommandSourceGenerator {
+public class SessionIdSourceGenerator extends ConnectionScopedIdSourceGenerator {
 
     protected void populateIncludeFilesSet() {
         Set<String> includes = getIncludeFiles();
@@ -39,6 +39,10 @@ public class SessionIdSourceGenerator extends CommandSourceGenerator {
         out.println("    return stream.str();");
     }
 
+    protected String getCompactIdArguments() {
+        return "this->value, 0";
+    }
+
     protected String generateInitializerList() {
         return super.generateInitializerList() + ", parentId()";
     }
@@ -50,6 +54,7 @@ public class SessionIdSourceGenerator extends CommandSourceGenerator {
         out.println("    " + generateInitializerList() + " {");
         out.println("");
         out.println("    this->connectionId = connectionId->getValue();");
+        out.println("    this->connectionKey = activemq::util::ConnectionIdTable::intern(this->connectionId);");
         out.println("    this->value = sessionId;");
         out.println("}");
         out.println("");
@@ -58,6 +63,7 @@ public class SessionIdSourceGenerator extends CommandSourceGenerator {
         out.println("    " + generateInitializerList() + " {");
         out.println("");
         out.println("    this->connectionId = producerId->getConnectionId();");
+        out.println("    this->connectionKey = producerId->getConnectionKey();");
         out.println("    this->value = producerId->getSessionId();");
         out.println("}");
         out.println("");
@@ -66,6 +72,7 @@ public class SessionIdSourceGenerator extends CommandSourceGenerator {
         out.println("    " + generateInitializerList() + " {");
         out.println("");
         out.println("    this->connectionId = consumerId->getConnectionId();");
+        out.println("    this->connectionKey = consumerId->getConnectionKey();");
         out.println("    this->value = consumerId->getSessionId();");
         out.println("}");
         out.println("");
@@ -115,6 +115,25 @@ public class AmqCppMarshallingClassesGenerator extends AmqCppMarshallingHeadersG
         return false;
     }
 
+    /**
+     * The body of a Message may be mapped from a file rather than held in its content
+     * vector, so it is marshaled through the length and bytes accessors that cover both.
+     */
+    protected boolean isMessageContent(JProperty property) {
+        return jclass.getSimpleName().equals("Message") && property.getSimpleName().equals("Content");
+    }
+
+    /**
+     * The ProducerId, ConsumerId and SessionId commands intern their connection id, when
+     * unmarshaled the wire format hands them the key it last interned for the connection
+     * so that the table's lock stays off the unmarshal path.
+     */
+    protected boolean isInternedConnectionId(JProperty property) {
+        String name = jclass.getSimpleName();
+        return property.getSimpleName().equals("ConnectionId") &&
+               (name.equals("ProducerId") || name.equals("ConsumerId") || name.equals("SessionId"));
+    }
+
     //////////////////////////////////////////////////////////////////////////////////////
     // This section is for the tight wire format encoding generator
     //////////////////////////////////////////////////////////////////////////////////////
@@ -170,6 +189,9 @@ public class AmqCppMarshallingClassesGenerator extends AmqCppMarshallingHeadersG
         else if( type.equals("long") ) {
             out.println(indent + "info->" + setter + "(tightUnmarshalLong(wireFormat, dataIn, bs));");
         }
+        else if( type.equals("String") && isInternedConnectionId(property) ) {
+            out.println(indent + "info->setConnectionKey(wireFormat->internConnectionId(tightUnmarshalString(dataIn, bs)));");
+        }
         else if( type.equals("String") ) {
             out.println(indent + "info->" + setter + "(tightUnmarshalString(dataIn, bs));");
         }
@@ -263,6 +285,10 @@ public class AmqCppMarshallingClassesGenerator extends AmqCppMarshallingHeadersG
                 out.print("");
                 out.println(indent + "rc += tightMarshalString1(" + getter + ", bs);" );
             }
+            else if (isMessageContent(property)) {
+                out.println(indent + "bs->writeBoolean(info->getContentLength() != 0);" );
+                out.println(indent + "rc += info->getContentLength() == 0 ? 0 : info->getContentLength() + 4;");
+            }
             else if (type.equals("byte[]") || type.equals("ByteSequence")) {
                 if (size == null) {
                     out.println(indent + "bs->writeBoolean(" + getter + ".size() != 0);" );
@@ -340,6 +366,12 @@ public class AmqCppMarshallingClassesGenerator extends AmqCppMarshallingHeadersG
             else if (type.equals("String")) {
                 out.println(indent + "tightMarshalString2(" + getter + ", dataOut, bs);");
             }
+            else if (isMessageContent(property)) {
+                out.println(indent + "if (bs->readBoolean()) {");
+                out.println(indent + "    dataOut->writeInt(info->getContentLength());");
+                out.println(indent + "    dataOut->write(info->getContentBytes(), info->getContentLength(), 0, info->getContentLength());");
+                out.println(indent + "}");
+            }
             else if (type.equals("byte[]") || type.equals("ByteSequence")) {
                 if (size != null) {
                     out.println(indent + "dataOut->write((const unsigned char*)(&" + getter + "[0]), " + size.asInt() + ", 0, " + size.asInt() + ");");
@@ -431,6 +463,9 @@ public class AmqCppMarshallingClassesGenerator extends AmqCppMarshallingHeadersG
         else if (type.equals("long")) {
             out.println(indent + "info->" + setter + "(looseUnmarshalLong(wireFormat, dataIn));");
         }
+        else if (type.equals("String") && isInternedConnectionId(property)) {
+            out.println(indent + "info->setConnectionKey(wireFormat->internConnectionId(looseUnmarshalString(dataIn)));");
+        }
         else if (type.equals("String")) {
             out.println(indent + "info->" + setter + "(looseUnmarshalString(dataIn));");
         }
@@ -525,6 +560,13 @@ public class AmqCppMarshallingClassesGenerator extends AmqCppMarshallingHeadersG
             else if( type.equals("String") ) {
                 out.println(indent + "looseMarshalString(" + getter + ", dataOut);");
             }
+            else if( isMessageContent(property) ) {
+                out.println(indent + "dataOut->write( info->getContentLength() != 0 );");
+                out.println(indent + "if( info->getContentLength() != 0 ) {");
+                out.println(indent + "    dataOut->writeInt( info->getContentLength() );");
+                out.println(indent + "    dataOut->write(info->getContentBytes(), info->getContentLength(), 0, info->getContentLength());");
+                out.println(indent + "}");
+            }
             else if( type.equals("byte[]") || type.equals("ByteSequence") ) {
                 if(size != null) {
                     out.println(indent + "dataOut->write((const unsigned char*)(&" + getter + "[0]), " + size.asInt() + ", 0, " + size.asInt() + ");");
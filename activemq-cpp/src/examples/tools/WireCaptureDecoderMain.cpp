@@ -0,0 +1,60 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <activemq/library/ActiveMQCPP.h>
+#include <activemq/transport/capture/WireCaptureDecoder.h>
+#include <decaf/lang/Exception.h>
+
+#include <iostream>
+
+using namespace activemq;
+using namespace activemq::transport::capture;
+
+////////////////////////////////////////////////////////////////////////////////
+// Prints the commands held in a set of wire capture files, the files written by
+// a connection with transport.captureFile set.
+int main(int argc, char* argv[]) {
+
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <capture file> [<capture file> ...]" << std::endl;
+        return 1;
+    }
+
+    activemq::library::ActiveMQCPP::initializeLibrary();
+
+    int result = 0;
+
+    try {
+
+        WireCaptureDecoder decoder;
+
+        for (int i = 1; i < argc; ++i) {
+            decoder.addFile(argv[i]);
+        }
+
+        int count = decoder.decode(std::cout);
+        std::cout << count << " commands decoded." << std::endl;
+
+    } catch (decaf::lang::Exception& ex) {
+        std::cerr << "Failed to decode the capture: " << ex.getMessage() << std::endl;
+        result = 1;
+    }
+
+    activemq::library::ActiveMQCPP::shutdownLibrary();
+
+    return result;
+}
@@ -17,6 +17,7 @@
 #include <activemq/commands/ActiveMQBytesMessage.h>
 
 #include <activemq/util/CMSExceptionSupport.h>
+#include <activemq/util/MappedFileRegion.h>
 
 #include <decaf/io/FilterOutputStream.h>
 #include <decaf/io/ByteArrayInputStream.h>
@@ -25,6 +26,9 @@
 
 #include <decaf/util/zip/DeflaterOutputStream.h>
 #include <decaf/util/zip/InflaterInputStream.h>
+#include <decaf/internal/io/MemoryMappedFile.h>
+
+#include <cstring>
 
 using namespace std;
 using namespace activemq;
@@ -36,6 +40,7 @@ using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
 using namespace decaf::util;
 using namespace decaf::util::zip;
+using namespace decaf::internal::io;
 
 ////////////////////////////////////////////////////////////////////////////////
 namespace{
@@ -70,7 +75,7 @@ namespace{
 
 ////////////////////////////////////////////////////////////////////////////////
 ActiveMQBytesMessage::ActiveMQBytesMessage() :
-    ActiveMQMessageTemplate<cms::BytesMessage>(), bytesOut(NULL), dataIn(), dataOut(), length(0) {
+    ActiveMQMessageTemplate<cms::BytesMessage>(), bytesOut(NULL), dataIn(), dataOut(), length(0), uncompressedBody() {
 
     this->clearBody();
 }
@@ -175,6 +180,7 @@ void ActiveMQBytesMessage::clearBody() {
     this->bytesOut = NULL;
     this->dataIn.reset( NULL );
     this->length = 0;
+    std::vector<unsigned char>().swap( this->uncompressedBody );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -573,6 +579,105 @@ void ActiveMQBytesMessage::writeUTF( const std::string& value ) {
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQBytesMessage::setBodyFromFile( const std::string& path, long long offset, int length ) {
+
+    this->failIfReadOnlyBody();
+    try {
+
+        Pointer<MappedFileRegion> region( new MappedFileRegion( path, offset, length ) );
+
+        this->dataOut.reset( NULL );
+        this->bytesOut = NULL;
+        this->dataIn.reset( NULL );
+        this->length = 0;
+
+        this->setCompressed( false );
+        this->setMappedContent( region );
+        this->setReadOnlyBody( true );
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQBytesMessage::writeBodyToFile( const std::string& path ) const {
+
+    this->failIfWriteOnlyBody();
+    try {
+
+        const unsigned char* bytes = this->getContentBytes();
+        int size = this->getContentLength();
+
+        ByteArrayInputStream input;
+        std::auto_ptr<InflaterInputStream> inflater;
+
+        if( this->isCompressed() && size > 0 ) {
+            input.setByteArray( bytes, size );
+            DataInputStream header( &input );
+            size = header.readInt();
+            inflater.reset( new InflaterInputStream( &input ) );
+        }
+
+        // A mapping can't be empty so an empty body still maps a byte that is
+        // truncated away again when the file is closed.
+        MemoryMappedFile file;
+        file.create( path, size > 0 ? size : 1 );
+
+        if( size > 0 ) {
+            if( inflater.get() != NULL ) {
+                DataInputStream data( inflater.get() );
+                data.readFully( file.getBuffer(), size );
+            } else {
+                std::memcpy( file.getBuffer(), bytes, size );
+            }
+        }
+
+        file.setLength( size );
+        file.close();
+
+        return size;
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::pair<const unsigned char*, int> ActiveMQBytesMessage::getBodyView() const {
+
+    this->failIfWriteOnlyBody();
+    try {
+
+        if( !this->isCompressed() ) {
+            return std::pair<const unsigned char*, int>( this->getContentBytes(), this->getContentLength() );
+        }
+
+        if( this->uncompressedBody.empty() && this->getContentLength() > 0 ) {
+
+            try {
+                ByteArrayInputStream bytes( this->getContentBytes(), this->getContentLength() );
+                DataInputStream header( &bytes );
+                int size = header.readInt();
+
+                if( size > 0 ) {
+                    std::vector<unsigned char> body( size );
+                    InflaterInputStream inflater( &bytes );
+                    DataInputStream data( &inflater );
+                    data.readFully( &body[0], size );
+                    this->uncompressedBody.swap( body );
+                }
+            } catch( IOException& ex ) {
+                throw CMSExceptionSupport::create( ex );
+            }
+        }
+
+        if( this->uncompressedBody.empty() ) {
+            return std::pair<const unsigned char*, int>( NULL, 0 );
+        }
+
+        return std::pair<const unsigned char*, int>( &this->uncompressedBody[0], (int)this->uncompressedBody.size() );
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQBytesMessage::storeContent() {
 
@@ -619,7 +724,8 @@ void ActiveMQBytesMessage::initializeReading() const {
     try {
 
         if (this->dataIn.get() == NULL) {
-            InputStream* is = new ByteArrayInputStream(this->getContent());
+            InputStream* is = this->getContentLength() == 0 ? new ByteArrayInputStream() :
+                new ByteArrayInputStream(this->getContentBytes(), this->getContentLength());
 
             if (this->isCompressed()) {
 
@@ -633,7 +739,7 @@ void ActiveMQBytesMessage::initializeReading() const {
                 is = new InflaterInputStream(is, true);
 
             } else {
-                this->length = (int) this->getContent().size();
+                this->length = this->getContentLength();
             }
             this->dataIn.reset(new DataInputStream(is, true));
         }
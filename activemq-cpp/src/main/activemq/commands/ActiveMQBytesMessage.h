@@ -32,6 +32,7 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <utility>
 
 namespace activemq{
 namespace commands{
@@ -61,6 +62,11 @@ namespace commands{
          */
         mutable int length;
 
+        /**
+         * The decompressed body of a compressed Message once a view of it is taken.
+         */
+        mutable std::vector<unsigned char> uncompressedBody;
+
     public:
 
         const static unsigned char ID_ACTIVEMQBYTESMESSAGE = 24;
@@ -161,6 +167,64 @@ namespace commands{
 
         virtual void writeUTF( const std::string& value );
 
+    public:
+
+        /**
+         * Replaces the body of this Message with a range of bytes from a file, the range
+         * is mapped into memory and sent from the mapping so a large file is never copied
+         * onto the heap.  The body becomes read only as it does after reset(), clearBody()
+         * discards the mapping and makes it writable again.  The bytes are sent as they are
+         * in the file, a body set this way is never compressed.
+         *
+         * The file must not be truncated or modified until the Message and any copies of
+         * it have been sent and deleted.
+         *
+         * @param path
+         *      The path of the file that holds the body.
+         * @param offset
+         *      The offset in the file of the first byte of the body.
+         * @param length
+         *      The number of bytes in the body, or -1 for the rest of the file.
+         *
+         * @throws CMSException if the file can't be mapped or the range is invalid.
+         * @throws MessageNotWriteableException if the body is read only.
+         *
+         * @since 3.8
+         */
+        void setBodyFromFile( const std::string& path, long long offset = 0, int length = -1 );
+
+        /**
+         * Writes the whole body of this Message into the named file through a memory
+         * mapping of the file, replacing it if it exists.  The body is decompressed if
+         * needed, the read position of the body is not changed.
+         *
+         * @param path
+         *      The path of the file to write the body to.
+         *
+         * @return the number of bytes written to the file.
+         *
+         * @throws CMSException if the file can't be written.
+         * @throws MessageNotReadableException if the body is write only.
+         *
+         * @since 3.8
+         */
+        int writeBodyToFile( const std::string& path ) const;
+
+        /**
+         * Returns the whole body of this Message without copying it, unlike getBodyBytes
+         * the read position of the body isn't changed.  The bytes are those of the Message
+         * content or its mapped file, a compressed body is decompressed once and kept.  The
+         * view is valid until the body is cleared or the Message is deleted.
+         *
+         * @return the first byte of the body, NULL when it is empty, and its length.
+         *
+         * @throws CMSException if a compressed body can't be decompressed.
+         * @throws MessageNotReadableException if the body is write only.
+         *
+         * @since 3.8
+         */
+        std::pair<const unsigned char*, int> getBodyView() const;
+
     private:
 
         void storeContent();
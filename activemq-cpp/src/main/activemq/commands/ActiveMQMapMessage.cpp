@@ -16,7 +16,10 @@
  */
 #include <activemq/commands/ActiveMQMapMessage.h>
 #include <activemq/wireformat/openwire/marshal/PrimitiveTypesMarshaller.h>
+#include <activemq/wireformat/openwire/marshal/PrimitiveMapReader.h>
+#include <activemq/wireformat/openwire/utils/ByteCursor.h>
 #include <activemq/util/CMSExceptionSupport.h>
+#include <activemq/util/PrimitiveValueConverter.h>
 
 #include <decaf/lang/exceptions/UnsupportedOperationException.h>
 
@@ -42,10 +45,21 @@ using namespace activemq::commands;
 using namespace activemq::wireformat;
 using namespace activemq::wireformat::openwire;
 using namespace activemq::wireformat::openwire::marshal;
+using namespace activemq::wireformat::openwire::utils;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    template<typename T>
+    T convertValue( const PrimitiveValueNode& value ) {
+        PrimitiveValueConverter converter;
+        return converter.convert<T>( value );
+    }
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 ActiveMQMapMessage::ActiveMQMapMessage() :
-    ActiveMQMessageTemplate<cms::MapMessage>(), map() {
+    ActiveMQMessageTemplate<cms::MapMessage>(), map(), reader() {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -68,6 +82,8 @@ ActiveMQMapMessage* ActiveMQMapMessage::cloneDataStructure() const {
 void ActiveMQMapMessage::copyDataStructure( const DataStructure* src ) {
     ActiveMQMessageTemplate<cms::MapMessage>::copyDataStructure( src );
 
+    this->reader.reset( NULL );
+
     const ActiveMQMapMessage* srcMap =
         dynamic_cast< const ActiveMQMapMessage* >( src );
 
@@ -90,9 +106,18 @@ bool ActiveMQMapMessage::equals( const DataStructure* value ) const {
 void ActiveMQMapMessage::clearBody() throw( cms::CMSException ) {
 
     ActiveMQMessageTemplate<cms::MapMessage>::clearBody();
+    this->reader.reset( NULL );
     this->getMap().clear();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQMapMessage::setContent( const std::vector<unsigned char>& content ) {
+
+    // The reader indexes the old content, it is rebuilt on the next read.
+    this->reader.reset( NULL );
+    ActiveMQMessageTemplate<cms::MapMessage>::setContent( content );
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQMapMessage::beforeMarshal( WireFormat* wireFormat ) {
 
@@ -101,7 +126,15 @@ void ActiveMQMapMessage::beforeMarshal( WireFormat* wireFormat ) {
         // Let the base class do its thing.
         ActiveMQMessageTemplate<cms::MapMessage>::beforeMarshal( wireFormat );
 
-        if( map.get() != NULL && !map->isEmpty() ) {
+        // A Map that was never unmarshaled, or only read through the reader, is
+        // unchanged so the content it came from is still current.
+        if( map.get() == NULL ) {
+            return;
+        }
+
+        this->reader.reset( NULL );
+
+        if( !map->isEmpty() ) {
 
             ByteArrayOutputStream* bytesOut = new ByteArrayOutputStream();
 
@@ -138,6 +171,7 @@ PrimitiveMap& ActiveMQMapMessage::getMap() {
     try{
 
         this->checkMapIsUnmarshalled();
+        this->clearCachedWireForm();
         return *map;
     }
     AMQ_CATCH_RETHROW( NullPointerException )
@@ -163,18 +197,28 @@ void ActiveMQMapMessage::checkMapIsUnmarshalled() const {
 
     try {
 
-        if( map.get() == NULL && !getContent().empty() ) {
+        if( map.get() == NULL && getContentLength() > 0 ) {
 
-            InputStream* is = new ByteArrayInputStream( getContent() );
+            this->reader.reset( NULL );
 
             if( isCompressed() ) {
+
+                InputStream* is = new ByteArrayInputStream( getContentBytes(), getContentLength() );
                 is = new InflaterInputStream( is, true );
                 is = new BufferedInputStream( is, true );
-            }
 
-            DataInputStream dataIn( is, true );
+                DataInputStream dataIn( is, true );
 
-            map.reset( PrimitiveTypesMarshaller::unmarshalMap( dataIn ) );
+                map.reset( PrimitiveTypesMarshaller::unmarshalMap( dataIn ) );
+
+            } else {
+
+                ByteCursor cursor( getContentBytes(), getContentLength() );
+
+                std::auto_ptr<PrimitiveMap> unmarshaled( new PrimitiveMap() );
+                PrimitiveTypesMarshaller::unmarshalPrimitiveMap( cursor, *unmarshaled );
+                map.reset( unmarshaled.release() );
+            }
 
             if( map.get() == NULL ) {
                 throw NullPointerException(
@@ -191,10 +235,40 @@ void ActiveMQMapMessage::checkMapIsUnmarshalled() const {
     AMQ_CATCHALL_THROW( NullPointerException )
 }
 
+////////////////////////////////////////////////////////////////////////////////
+const PrimitiveMapReader* ActiveMQMapMessage::getMapReader() const {
+
+    if( map.get() != NULL || isCompressed() || getContentLength() == 0 ) {
+        return NULL;
+    }
+
+    if( reader.get() == NULL ) {
+        reader.reset( new PrimitiveMapReader( getContentBytes(), getContentLength() ) );
+    }
+
+    return reader.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PrimitiveValueNode ActiveMQMapMessage::getValue( const std::string& name ) const {
+
+    const PrimitiveMapReader* mapReader = getMapReader();
+    if( mapReader != NULL ) {
+        return mapReader->get( name );
+    }
+
+    return getMap().get( name );
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool ActiveMQMapMessage::isEmpty() const {
 
     try{
+        const PrimitiveMapReader* mapReader = getMapReader();
+        if( mapReader != NULL ) {
+            return mapReader->isEmpty();
+        }
+
         return getMap().isEmpty();
     }
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
@@ -204,6 +278,11 @@ bool ActiveMQMapMessage::isEmpty() const {
 std::vector<std::string> ActiveMQMapMessage::getMapNames() const {
 
     try{
+        const PrimitiveMapReader* mapReader = getMapReader();
+        if( mapReader != NULL ) {
+            return mapReader->keySet();
+        }
+
         return getMap().keySet().toArray();
     }
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
@@ -213,6 +292,11 @@ std::vector<std::string> ActiveMQMapMessage::getMapNames() const {
 bool ActiveMQMapMessage::itemExists(const std::string& name) const {
 
     try {
+        const PrimitiveMapReader* mapReader = getMapReader();
+        if( mapReader != NULL ) {
+            return mapReader->containsKey( name );
+        }
+
         return getMap().containsKey( name );
     }
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
@@ -222,7 +306,9 @@ bool ActiveMQMapMessage::itemExists(const std::string& name) const {
 cms::Message::ValueType ActiveMQMapMessage::getValueType(const std::string& key) const {
 
     try {
-        util::PrimitiveValueNode::PrimitiveType type = this->getMap().getValueType(key);
+        const PrimitiveMapReader* mapReader = getMapReader();
+        util::PrimitiveValueNode::PrimitiveType type = mapReader != NULL ?
+            mapReader->getValueType(key) : this->getMap().getValueType(key);
 
         switch(type) {
             case util::PrimitiveValueNode::NULL_TYPE:
@@ -261,7 +347,7 @@ cms::Message::ValueType ActiveMQMapMessage::getValueType(const std::string& key)
 bool ActiveMQMapMessage::getBoolean( const std::string& name ) const {
 
     try{
-        return getMap().getBool( name );
+        return convertValue<bool>( getValue( name ) );
     } catch( UnsupportedOperationException& ex ) {
         throw CMSExceptionSupport::createMessageFormatException( ex );
     }
@@ -282,7 +368,7 @@ void ActiveMQMapMessage::setBoolean( const std::string& name, bool value ) {
 unsigned char ActiveMQMapMessage::getByte( const std::string& name ) const {
 
     try{
-        return getMap().getByte( name );
+        return convertValue<unsigned char>( getValue( name ) );
     } catch( UnsupportedOperationException& ex ) {
         throw CMSExceptionSupport::createMessageFormatException( ex );
     }
@@ -303,7 +389,7 @@ void ActiveMQMapMessage::setByte( const std::string& name, unsigned char value )
 std::vector<unsigned char> ActiveMQMapMessage::getBytes( const std::string& name ) const {
 
     try{
-        return getMap().getByteArray( name );
+        return convertValue<std::vector<unsigned char> >( getValue( name ) );
     } catch( UnsupportedOperationException& ex ) {
         throw CMSExceptionSupport::createMessageFormatException( ex );
     }
@@ -325,7 +411,7 @@ void ActiveMQMapMessage::setBytes( const std::string& name,
 char ActiveMQMapMessage::getChar( const std::string& name ) const {
 
     try{
-        return getMap().getChar( name );
+        return convertValue<char>( getValue( name ) );
     } catch( UnsupportedOperationException& ex ) {
         throw CMSExceptionSupport::createMessageFormatException( ex );
     }
@@ -346,7 +432,7 @@ void ActiveMQMapMessage::setChar( const std::string& name, char value ) {
 double ActiveMQMapMessage::getDouble( const std::string& name ) const {
 
     try{
-        return getMap().getDouble( name );
+        return convertValue<double>( getValue( name ) );
     } catch( UnsupportedOperationException& ex ) {
         throw CMSExceptionSupport::createMessageFormatException( ex );
     }
@@ -367,7 +453,7 @@ void ActiveMQMapMessage::setDouble( const std::string& name, double value ) {
 float ActiveMQMapMessage::getFloat( const std::string& name ) const {
 
     try{
-        return getMap().getFloat( name );
+        return convertValue<float>( getValue( name ) );
     } catch( UnsupportedOperationException& ex ) {
         throw CMSExceptionSupport::createMessageFormatException( ex );
     }
@@ -388,7 +474,7 @@ void ActiveMQMapMessage::setFloat( const std::string& name, float value ) {
 int ActiveMQMapMessage::getInt( const std::string& name ) const {
 
     try{
-        return getMap().getInt( name );
+        return convertValue<int>( getValue( name ) );
     } catch( UnsupportedOperationException& ex ) {
         throw CMSExceptionSupport::createMessageFormatException( ex );
     }
@@ -409,7 +495,7 @@ void ActiveMQMapMessage::setInt( const std::string& name, int value ) {
 long long ActiveMQMapMessage::getLong( const std::string& name ) const {
 
     try{
-        return getMap().getLong( name );
+        return convertValue<long long>( getValue( name ) );
     } catch( UnsupportedOperationException& ex ) {
         throw CMSExceptionSupport::createMessageFormatException( ex );
     }
@@ -430,7 +516,7 @@ void ActiveMQMapMessage::setLong( const std::string& name, long long value ) {
 short ActiveMQMapMessage::getShort( const std::string& name ) const {
 
     try{
-        return getMap().getShort( name );
+        return convertValue<short>( getValue( name ) );
     } catch( UnsupportedOperationException& ex ) {
         throw CMSExceptionSupport::createMessageFormatException( ex );
     }
@@ -451,7 +537,7 @@ void ActiveMQMapMessage::setShort( const std::string& name, short value ) {
 std::string ActiveMQMapMessage::getString( const std::string& name ) const {
 
     try{
-        return getMap().getString( name );
+        return convertValue<std::string>( getValue( name ) );
     } catch( UnsupportedOperationException& ex ) {
         throw CMSExceptionSupport::createMessageFormatException( ex );
     }
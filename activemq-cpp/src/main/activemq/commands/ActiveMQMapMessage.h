@@ -33,6 +33,11 @@
 #include <memory>
 
 namespace activemq{
+namespace wireformat{
+namespace openwire{
+namespace marshal{
+    class PrimitiveMapReader;
+}}}
 namespace commands{
 
     class AMQCPP_API ActiveMQMapMessage :
@@ -43,6 +48,9 @@ namespace commands{
         // Map Structure to hold unmarshaled Map Data
         mutable std::auto_ptr<util::PrimitiveMap> map;
 
+        // Index over the received content that decodes single entries until the Map is needed
+        mutable std::auto_ptr<wireformat::openwire::marshal::PrimitiveMapReader> reader;
+
     public:
 
         const static unsigned char ID_ACTIVEMQMAPMESSAGE = 25;
@@ -70,6 +78,8 @@ namespace commands{
 
         virtual void beforeMarshal( wireformat::WireFormat* wireFormat );
 
+        virtual void setContent( const std::vector<unsigned char>& content );
+
         virtual std::string toString() const;
 
         virtual bool equals( const DataStructure* value ) const;
@@ -227,6 +237,25 @@ namespace commands{
          */
         virtual void checkMapIsUnmarshalled() const;
 
+    private:
+
+        /**
+         * Returns a reader over the marshaled content that decodes single entries on demand,
+         * creating it on first use.  No reader is used once the content has been unmarshaled
+         * into the PrimitiveMap or when the content is compressed.
+         *
+         * @returns pointer to the reader or NULL if the PrimitiveMap must be used.
+         */
+        const wireformat::openwire::marshal::PrimitiveMapReader* getMapReader() const;
+
+        /**
+         * Fetches the value stored under the given name from the reader when there is one
+         * and from the PrimitiveMap otherwise.
+         *
+         * @throws NoSuchElementException if there is no value with the given name.
+         */
+        util::PrimitiveValueNode getValue( const std::string& name ) const;
+
     };
 
 }}
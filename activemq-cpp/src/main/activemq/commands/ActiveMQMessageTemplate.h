@@ -159,6 +159,7 @@ namespace commands {
 
         virtual bool getBooleanProperty(const std::string& name) const {
             try {
+                this->unmarshalPendingProperties();
                 return this->propertiesInterceptor->getBooleanProperty(name);
             } catch (decaf::lang::exceptions::UnsupportedOperationException& ex) {
                 throw activemq::util::CMSExceptionSupport::createMessageFormatException(ex);
@@ -168,6 +169,7 @@ namespace commands {
 
         virtual unsigned char getByteProperty(const std::string& name) const {
             try {
+                this->unmarshalPendingProperties();
                 return this->propertiesInterceptor->getByteProperty(name);
             } catch (decaf::lang::exceptions::UnsupportedOperationException& ex) {
                 throw activemq::util::CMSExceptionSupport::createMessageFormatException(ex);
@@ -178,6 +180,7 @@ namespace commands {
         virtual double getDoubleProperty(const std::string& name) const {
 
             try {
+                this->unmarshalPendingProperties();
                 return this->propertiesInterceptor->getDoubleProperty(name);
             } catch (decaf::lang::exceptions::UnsupportedOperationException& ex) {
                 throw activemq::util::CMSExceptionSupport::createMessageFormatException(ex);
@@ -188,6 +191,7 @@ namespace commands {
         virtual float getFloatProperty(const std::string& name) const {
 
             try {
+                this->unmarshalPendingProperties();
                 return this->propertiesInterceptor->getFloatProperty(name);
             } catch (decaf::lang::exceptions::UnsupportedOperationException& ex) {
                 throw activemq::util::CMSExceptionSupport::createMessageFormatException(ex);
@@ -198,6 +202,7 @@ namespace commands {
         virtual int getIntProperty(const std::string& name) const {
 
             try {
+                this->unmarshalPendingProperties();
                 return this->propertiesInterceptor->getIntProperty(name);
             } catch (decaf::lang::exceptions::UnsupportedOperationException& ex) {
                 throw activemq::util::CMSExceptionSupport::createMessageFormatException(ex);
@@ -208,6 +213,7 @@ namespace commands {
         virtual long long getLongProperty(const std::string& name) const {
 
             try {
+                this->unmarshalPendingProperties();
                 return this->propertiesInterceptor->getLongProperty(name);
             } catch (decaf::lang::exceptions::UnsupportedOperationException& ex) {
                 throw activemq::util::CMSExceptionSupport::createMessageFormatException(ex);
@@ -218,6 +224,7 @@ namespace commands {
         virtual short getShortProperty(const std::string& name) const {
 
             try {
+                this->unmarshalPendingProperties();
                 return this->propertiesInterceptor->getShortProperty(name);
             } catch (decaf::lang::exceptions::UnsupportedOperationException& ex) {
                 throw activemq::util::CMSExceptionSupport::createMessageFormatException(ex);
@@ -228,6 +235,7 @@ namespace commands {
         virtual std::string getStringProperty(const std::string& name) const {
 
             try {
+                this->unmarshalPendingProperties();
                 return this->propertiesInterceptor->getStringProperty(name);
             } catch (decaf::lang::exceptions::UnsupportedOperationException& ex) {
                 throw activemq::util::CMSExceptionSupport::createMessageFormatException(ex);
@@ -243,7 +251,9 @@ namespace commands {
 
             failIfReadOnlyProperties();
             try {
+                this->unmarshalPendingProperties();
                 this->propertiesInterceptor->setBooleanProperty(name, value);
+                this->invalidateMarshalledProperties();
             }
             AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
         }
@@ -256,7 +266,9 @@ namespace commands {
 
             failIfReadOnlyProperties();
             try {
+                this->unmarshalPendingProperties();
                 this->propertiesInterceptor->setByteProperty(name, value);
+                this->invalidateMarshalledProperties();
             }
             AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
         }
@@ -269,7 +281,9 @@ namespace commands {
 
             failIfReadOnlyProperties();
             try {
+                this->unmarshalPendingProperties();
                 this->propertiesInterceptor->setDoubleProperty(name, value);
+                this->invalidateMarshalledProperties();
             }
             AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
         }
@@ -282,7 +296,9 @@ namespace commands {
 
             failIfReadOnlyProperties();
             try {
+                this->unmarshalPendingProperties();
                 this->propertiesInterceptor->setFloatProperty(name, value);
+                this->invalidateMarshalledProperties();
             }
             AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
         }
@@ -295,7 +311,9 @@ namespace commands {
 
             failIfReadOnlyProperties();
             try {
+                this->unmarshalPendingProperties();
                 this->propertiesInterceptor->setIntProperty(name, value);
+                this->invalidateMarshalledProperties();
             }
             AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
         }
@@ -308,7 +326,9 @@ namespace commands {
 
             failIfReadOnlyProperties();
             try {
+                this->unmarshalPendingProperties();
                 this->propertiesInterceptor->setLongProperty(name, value);
+                this->invalidateMarshalledProperties();
             }
             AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
         }
@@ -321,7 +341,9 @@ namespace commands {
 
             failIfReadOnlyProperties();
             try {
+                this->unmarshalPendingProperties();
                 this->propertiesInterceptor->setShortProperty(name, value);
+                this->invalidateMarshalledProperties();
             }
             AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
         }
@@ -334,7 +356,9 @@ namespace commands {
 
             failIfReadOnlyProperties();
             try {
+                this->unmarshalPendingProperties();
                 this->propertiesInterceptor->setStringProperty(name, value);
+                this->invalidateMarshalledProperties();
             }
             AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
         }
@@ -18,6 +18,7 @@
 #include <activemq/util/PrimitiveValueNode.h>
 #include <activemq/util/CMSExceptionSupport.h>
 #include <activemq/util/MarshallingSupport.h>
+#include <activemq/wireformat/openwire/utils/ByteCursor.h>
 
 #include <cms/MessageEOFException.h>
 #include <cms/MessageFormatException.h>
@@ -38,7 +39,6 @@
 #include <decaf/lang/Float.h>
 #include <decaf/io/ByteArrayOutputStream.h>
 #include <decaf/io/ByteArrayInputStream.h>
-#include <decaf/io/BufferedInputStream.h>
 #include <decaf/util/zip/DeflaterOutputStream.h>
 #include <decaf/util/zip/InflaterInputStream.h>
 
@@ -50,6 +50,7 @@ using namespace activemq::commands;
 using namespace activemq::exceptions;
 using namespace activemq::wireformat;
 using namespace activemq::wireformat::openwire;
+using namespace activemq::wireformat::openwire::utils;
 using namespace decaf;
 using namespace decaf::io;
 using namespace decaf::lang;
@@ -69,9 +70,50 @@ namespace commands {
 
     public:
 
-        ActiveMQStreamMessageImpl() : bytesOut(NULL), remainingBytes(-1) {}
+        ActiveMQStreamMessageImpl() : bytesOut(NULL), remainingBytes(-1), cursor(), inflated(), markPosition(0) {}
         ~ActiveMQStreamMessageImpl() {}
 
+        // Saves the current read position so that a failed conversion can return to it.
+        void mark() {
+            this->markPosition = this->cursor->getPosition();
+        }
+
+        void reset() {
+            this->cursor->setPosition(this->markPosition);
+        }
+
+        // Reads the next byte, or returns -1 at the end of the body.
+        int read() {
+            return this->cursor->remaining() > 0 ? (int) this->cursor->readByte() : -1;
+        }
+
+        // Reads up to count bytes, or returns -1 if the end of the body has been reached.
+        int read(unsigned char* buffer, int count) {
+            int available = std::min(count, this->cursor->remaining());
+            if (available <= 0) {
+                return -1;
+            }
+
+            this->cursor->readBytes(buffer, available);
+            return available;
+        }
+
+        std::string readString(int length) {
+            if (length <= 0) {
+                return "";
+            }
+
+            std::string value(length, '\0');
+            this->cursor->readBytes((unsigned char*) &value[0], length);
+            return value;
+        }
+
+        void close() {
+            this->cursor.reset(NULL);
+            this->inflated.clear();
+            this->markPosition = 0;
+        }
+
     public:
 
         // Holds the contents of the message once written.
@@ -81,12 +123,18 @@ namespace commands {
         // are left unread since the last readBytes call.
         mutable int remainingBytes;
 
+        // Reads the body in place from the content, or from the inflated copy of
+        // it when the message was compressed.
+        std::auto_ptr<ByteCursor> cursor;
+        std::vector<unsigned char> inflated;
+        int markPosition;
+
     };
 }}
 
 ////////////////////////////////////////////////////////////////////////////////
 ActiveMQStreamMessage::ActiveMQStreamMessage() :
-    ActiveMQMessageTemplate<cms::StreamMessage>(), impl(new ActiveMQStreamMessageImpl()), dataIn(), dataOut() {
+    ActiveMQMessageTemplate<cms::StreamMessage>(), impl(new ActiveMQStreamMessageImpl()), dataOut() {
 
     this->clearBody();
 }
@@ -148,7 +196,7 @@ void ActiveMQStreamMessage::clearBody() {
     // Invoke base class's version.
     ActiveMQMessageTemplate<cms::StreamMessage>::clearBody();
 
-    this->dataIn.reset(NULL);
+    this->impl->close();
     this->dataOut.reset(NULL);
     this->impl->bytesOut = NULL;
     this->impl->remainingBytes = -1;
@@ -167,7 +215,7 @@ void ActiveMQStreamMessage::reset() {
     try {
         storeContent();
         this->impl->bytesOut = NULL;
-        this->dataIn.reset(NULL);
+        this->impl->close();
         this->dataOut.reset(NULL);
         this->impl->remainingBytes = -1;
         this->setReadOnlyBody(true);
@@ -182,25 +230,25 @@ bool ActiveMQStreamMessage::readBoolean() const {
 
         initializeReading();
 
-        this->dataIn->mark(10);
+        this->impl->mark();
 
-        int type = this->dataIn->read();
+        int type = this->impl->read();
 
         if (type == -1) {
             throw MessageEOFException("Reached the end of the Stream", NULL);
         }
         if (type == PrimitiveValueNode::BOOLEAN_TYPE) {
-            return this->dataIn->readBoolean();
+            return this->impl->cursor->readBoolean();
         }
         if (type == PrimitiveValueNode::STRING_TYPE) {
-            return Boolean::valueOf(this->dataIn->readUTF()).booleanValue();
+            return Boolean::valueOf(this->impl->cursor->readUTF()).booleanValue();
         }
 
         if (type == PrimitiveValueNode::NULL_TYPE) {
-            this->dataIn->reset();
+            this->impl->reset();
             throw NullPointerException(__FILE__, __LINE__, "Cannot convert NULL value to boolean.");
         } else {
-            this->dataIn->reset();
+            this->impl->reset();
             throw MessageFormatException("not a boolean type", NULL);
         }
 
@@ -230,31 +278,31 @@ unsigned char ActiveMQStreamMessage::readByte() const {
     initializeReading();
     try {
 
-        this->dataIn->mark(10);
-        int type = this->dataIn->read();
+        this->impl->mark();
+        int type = this->impl->read();
 
         if (type == -1) {
             throw MessageEOFException("reached end of data", NULL);
         }
         if (type == PrimitiveValueNode::BYTE_TYPE) {
-            return this->dataIn->readByte();
+            return this->impl->cursor->readByte();
         }
         if (type == PrimitiveValueNode::STRING_TYPE) {
-            return Byte::valueOf(this->dataIn->readUTF()).byteValue();
+            return Byte::valueOf(this->impl->cursor->readUTF()).byteValue();
         }
 
         if (type == PrimitiveValueNode::NULL_TYPE) {
-            this->dataIn->reset();
+            this->impl->reset();
             throw NullPointerException(__FILE__, __LINE__, "Cannot convert NULL value to byte.");
         } else {
-            this->dataIn->reset();
+            this->impl->reset();
             throw MessageFormatException(" not a byte type", NULL);
         }
 
     } catch (NumberFormatException& ex) {
 
         try {
-            this->dataIn->reset();
+            this->impl->reset();
         } catch (IOException& e) {
             throw CMSExceptionSupport::create(e);
         }
@@ -317,8 +365,8 @@ int ActiveMQStreamMessage::readBytes(unsigned char* buffer, int length) const {
 
         if (this->impl->remainingBytes == -1) {
 
-            this->dataIn->mark((int) length + 1);
-            int type = this->dataIn->read();
+            this->impl->mark();
+            int type = this->impl->read();
 
             if (type == -1) {
                 throw MessageEOFException("reached end of data", NULL);
@@ -328,7 +376,7 @@ int ActiveMQStreamMessage::readBytes(unsigned char* buffer, int length) const {
                 throw MessageFormatException("Not a byte array", NULL);
             }
 
-            this->impl->remainingBytes = this->dataIn->readInt();
+            this->impl->remainingBytes = this->impl->cursor->readInt();
 
         } else if (this->impl->remainingBytes == 0) {
             this->impl->remainingBytes = -1;
@@ -338,11 +386,11 @@ int ActiveMQStreamMessage::readBytes(unsigned char* buffer, int length) const {
         if (length <= this->impl->remainingBytes) {
             // small buffer
             this->impl->remainingBytes -= (int) length;
-            this->dataIn->readFully(buffer, length);
+            this->impl->cursor->readBytes(buffer, length);
             return length;
         } else {
             // big buffer
-            int rc = this->dataIn->read(buffer, length, 0, this->impl->remainingBytes);
+            int rc = this->impl->read(buffer, this->impl->remainingBytes);
             this->impl->remainingBytes = 0;
             return rc;
         }
@@ -374,28 +422,28 @@ char ActiveMQStreamMessage::readChar() const {
     initializeReading();
     try {
 
-        this->dataIn->mark(17);
-        int type = this->dataIn->read();
+        this->impl->mark();
+        int type = this->impl->read();
 
         if (type == -1) {
             throw MessageEOFException("reached end of data", NULL);
         }
         if (type == PrimitiveValueNode::CHAR_TYPE) {
-            return this->dataIn->readChar();
+            return this->impl->cursor->readChar();
         }
 
         if (type == PrimitiveValueNode::NULL_TYPE) {
-            this->dataIn->reset();
+            this->impl->reset();
             throw NullPointerException(__FILE__, __LINE__, "Cannot convert NULL value to char.");
         } else {
-            this->dataIn->reset();
+            this->impl->reset();
             throw MessageFormatException(" not a char type", NULL);
         }
 
     } catch (NumberFormatException& ex) {
 
         try {
-            this->dataIn->reset();
+            this->impl->reset();
         } catch (IOException& ioe) {
             throw CMSExceptionSupport::create(ioe);
         }
@@ -429,31 +477,31 @@ float ActiveMQStreamMessage::readFloat() const {
     initializeReading();
     try {
 
-        this->dataIn->mark(33);
-        int type = this->dataIn->read();
+        this->impl->mark();
+        int type = this->impl->read();
 
         if (type == -1) {
             throw MessageEOFException("reached end of data", NULL);
         }
         if (type == PrimitiveValueNode::FLOAT_TYPE) {
-            return this->dataIn->readFloat();
+            return this->impl->cursor->readFloat();
         }
         if (type == PrimitiveValueNode::STRING_TYPE) {
-            return Float::valueOf(this->dataIn->readUTF()).floatValue();
+            return Float::valueOf(this->impl->cursor->readUTF()).floatValue();
         }
 
         if (type == PrimitiveValueNode::NULL_TYPE) {
-            this->dataIn->reset();
+            this->impl->reset();
             throw NullPointerException(__FILE__, __LINE__, "Cannot convert NULL value to float.");
         } else {
-            this->dataIn->reset();
+            this->impl->reset();
             throw MessageFormatException(" not a float type", NULL);
         }
 
     } catch (NumberFormatException& ex) {
 
         try {
-            this->dataIn->reset();
+            this->impl->reset();
         } catch (IOException& ioe) {
             throw CMSExceptionSupport::create(ioe);
         }
@@ -486,34 +534,34 @@ double ActiveMQStreamMessage::readDouble() const {
     initializeReading();
     try {
 
-        this->dataIn->mark(33);
-        int type = this->dataIn->read();
+        this->impl->mark();
+        int type = this->impl->read();
 
         if (type == -1) {
             throw MessageEOFException("reached end of data", NULL);
         }
         if (type == PrimitiveValueNode::DOUBLE_TYPE) {
-            return this->dataIn->readDouble();
+            return this->impl->cursor->readDouble();
         }
         if (type == PrimitiveValueNode::FLOAT_TYPE) {
-            return this->dataIn->readFloat();
+            return this->impl->cursor->readFloat();
         }
         if (type == PrimitiveValueNode::STRING_TYPE) {
-            return Double::valueOf(this->dataIn->readUTF()).doubleValue();
+            return Double::valueOf(this->impl->cursor->readUTF()).doubleValue();
         }
 
         if (type == PrimitiveValueNode::NULL_TYPE) {
-            this->dataIn->reset();
+            this->impl->reset();
             throw NullPointerException(__FILE__, __LINE__, "Cannot convert NULL value to double.");
         } else {
-            this->dataIn->reset();
+            this->impl->reset();
             throw MessageFormatException(" not a double type", NULL);
         }
 
     } catch (NumberFormatException& ex) {
 
         try {
-            this->dataIn->reset();
+            this->impl->reset();
         } catch (IOException& ioe) {
             throw CMSExceptionSupport::create(ioe);
         }
@@ -546,34 +594,34 @@ short ActiveMQStreamMessage::readShort() const {
     initializeReading();
     try {
 
-        this->dataIn->mark(17);
-        int type = this->dataIn->read();
+        this->impl->mark();
+        int type = this->impl->read();
 
         if (type == -1) {
             throw MessageEOFException("reached end of data", NULL);
         }
         if (type == PrimitiveValueNode::SHORT_TYPE) {
-            return this->dataIn->readShort();
+            return this->impl->cursor->readShort();
         }
         if (type == PrimitiveValueNode::BYTE_TYPE) {
-            return this->dataIn->readByte();
+            return (char) this->impl->cursor->readByte();
         }
         if (type == PrimitiveValueNode::STRING_TYPE) {
-            return Short::valueOf(this->dataIn->readUTF()).shortValue();
+            return Short::valueOf(this->impl->cursor->readUTF()).shortValue();
         }
 
         if (type == PrimitiveValueNode::NULL_TYPE) {
-            this->dataIn->reset();
+            this->impl->reset();
             throw NullPointerException(__FILE__, __LINE__, "Cannot convert NULL value to short.");
         } else {
-            this->dataIn->reset();
+            this->impl->reset();
             throw MessageFormatException(" not a short type", NULL);
         }
 
     } catch (NumberFormatException& ex) {
 
         try {
-            this->dataIn->reset();
+            this->impl->reset();
         } catch (IOException& e) {
             throw CMSExceptionSupport::create(e);
         }
@@ -606,34 +654,34 @@ unsigned short ActiveMQStreamMessage::readUnsignedShort() const {
     initializeReading();
     try {
 
-        this->dataIn->mark(17);
-        int type = this->dataIn->read();
+        this->impl->mark();
+        int type = this->impl->read();
 
         if (type == -1) {
             throw MessageEOFException("reached end of data", NULL);
         }
         if (type == PrimitiveValueNode::SHORT_TYPE) {
-            return this->dataIn->readUnsignedShort();
+            return this->impl->cursor->readUnsignedShort();
         }
         if (type == PrimitiveValueNode::BYTE_TYPE) {
-            return this->dataIn->readByte();
+            return (char) this->impl->cursor->readByte();
         }
         if (type == PrimitiveValueNode::STRING_TYPE) {
-            return Short::valueOf(this->dataIn->readUTF()).shortValue();
+            return Short::valueOf(this->impl->cursor->readUTF()).shortValue();
         }
 
         if (type == PrimitiveValueNode::NULL_TYPE) {
-            this->dataIn->reset();
+            this->impl->reset();
             throw NullPointerException(__FILE__, __LINE__, "Cannot convert NULL value to short.");
         } else {
-            this->dataIn->reset();
+            this->impl->reset();
             throw MessageFormatException(" not a short type", NULL);
         }
 
     } catch (NumberFormatException& ex) {
 
         try {
-            this->dataIn->reset();
+            this->impl->reset();
         } catch (IOException& e) {
             throw CMSExceptionSupport::create(e);
         }
@@ -666,37 +714,37 @@ int ActiveMQStreamMessage::readInt() const {
     initializeReading();
     try {
 
-        this->dataIn->mark(33);
-        int type = this->dataIn->read();
+        this->impl->mark();
+        int type = this->impl->read();
 
         if (type == -1) {
             throw MessageEOFException("reached end of data", NULL);
         }
         if (type == PrimitiveValueNode::INTEGER_TYPE) {
-            return this->dataIn->readInt();
+            return this->impl->cursor->readInt();
         }
         if (type == PrimitiveValueNode::SHORT_TYPE) {
-            return this->dataIn->readShort();
+            return this->impl->cursor->readShort();
         }
         if (type == PrimitiveValueNode::BYTE_TYPE) {
-            return this->dataIn->readByte();
+            return (char) this->impl->cursor->readByte();
         }
         if (type == PrimitiveValueNode::STRING_TYPE) {
-            return Integer::valueOf(this->dataIn->readUTF()).intValue();
+            return Integer::valueOf(this->impl->cursor->readUTF()).intValue();
         }
 
         if (type == PrimitiveValueNode::NULL_TYPE) {
-            this->dataIn->reset();
+            this->impl->reset();
             throw NullPointerException(__FILE__, __LINE__, "Cannot convert NULL value to int.");
         } else {
-            this->dataIn->reset();
+            this->impl->reset();
             throw MessageFormatException(" not a int type", NULL);
         }
 
     } catch (NumberFormatException& ex) {
 
         try {
-            this->dataIn->reset();
+            this->impl->reset();
         } catch (IOException& e) {
             throw CMSExceptionSupport::create(e);
         }
@@ -729,40 +777,40 @@ long long ActiveMQStreamMessage::readLong() const {
     initializeReading();
     try {
 
-        this->dataIn->mark(65);
-        int type = this->dataIn->read();
+        this->impl->mark();
+        int type = this->impl->read();
 
         if (type == -1) {
             throw MessageEOFException("reached end of data", NULL);
         }
         if (type == PrimitiveValueNode::LONG_TYPE) {
-            return this->dataIn->readLong();
+            return this->impl->cursor->readLong();
         }
         if (type == PrimitiveValueNode::INTEGER_TYPE) {
-            return this->dataIn->readInt();
+            return this->impl->cursor->readInt();
         }
         if (type == PrimitiveValueNode::SHORT_TYPE) {
-            return this->dataIn->readShort();
+            return this->impl->cursor->readShort();
         }
         if (type == PrimitiveValueNode::BYTE_TYPE) {
-            return this->dataIn->readByte();
+            return (char) this->impl->cursor->readByte();
         }
         if (type == PrimitiveValueNode::STRING_TYPE) {
-            return Long::valueOf(this->dataIn->readUTF()).longValue();
+            return Long::valueOf(this->impl->cursor->readUTF()).longValue();
         }
 
         if (type == PrimitiveValueNode::NULL_TYPE) {
-            this->dataIn->reset();
+            this->impl->reset();
             throw NullPointerException(__FILE__, __LINE__, "Cannot convert NULL value to long.");
         } else {
-            this->dataIn->reset();
+            this->impl->reset();
             throw MessageFormatException(" not a long type", NULL);
         }
 
     } catch (NumberFormatException& ex) {
 
         try {
-            this->dataIn->reset();
+            this->impl->reset();
         } catch (IOException& e) {
             throw CMSExceptionSupport::create(e);
         }
@@ -795,8 +843,8 @@ std::string ActiveMQStreamMessage::readString() const {
     initializeReading();
     try {
 
-        this->dataIn->mark(65);
-        int type = this->dataIn->read();
+        this->impl->mark();
+        int type = this->impl->read();
 
         if (type == -1) {
             throw MessageEOFException("reached end of data", NULL);
@@ -805,44 +853,44 @@ std::string ActiveMQStreamMessage::readString() const {
             return "";
         }
         if (type == PrimitiveValueNode::BIG_STRING_TYPE) {
-            return MarshallingSupport::readString32(*this->dataIn);
+            return this->impl->readString(this->impl->cursor->readInt());
         }
         if (type == PrimitiveValueNode::STRING_TYPE) {
-            return MarshallingSupport::readString16(*this->dataIn);
+            return this->impl->readString(this->impl->cursor->readShort());
         }
         if (type == PrimitiveValueNode::LONG_TYPE) {
-            return Long(this->dataIn->readLong()).toString();
+            return Long(this->impl->cursor->readLong()).toString();
         }
         if (type == PrimitiveValueNode::INTEGER_TYPE) {
-            return Integer(this->dataIn->readInt()).toString();
+            return Integer(this->impl->cursor->readInt()).toString();
         }
         if (type == PrimitiveValueNode::SHORT_TYPE) {
-            return Short(this->dataIn->readShort()).toString();
+            return Short(this->impl->cursor->readShort()).toString();
         }
         if (type == PrimitiveValueNode::BYTE_TYPE) {
-            return Byte(this->dataIn->readByte()).toString();
+            return Byte(this->impl->cursor->readByte()).toString();
         }
         if (type == PrimitiveValueNode::FLOAT_TYPE) {
-            return Float(this->dataIn->readFloat()).toString();
+            return Float(this->impl->cursor->readFloat()).toString();
         }
         if (type == PrimitiveValueNode::DOUBLE_TYPE) {
-            return Double(this->dataIn->readDouble()).toString();
+            return Double(this->impl->cursor->readDouble()).toString();
         }
         if (type == PrimitiveValueNode::BOOLEAN_TYPE) {
-            return (this->dataIn->readBoolean() ? Boolean::_TRUE : Boolean::_FALSE).toString();
+            return (this->impl->cursor->readBoolean() ? Boolean::_TRUE : Boolean::_FALSE).toString();
         }
 
         if (type == PrimitiveValueNode::CHAR_TYPE) {
-            return Character(this->dataIn->readChar()).toString();
+            return Character(this->impl->cursor->readChar()).toString();
         } else {
-            this->dataIn->reset();
+            this->impl->reset();
             throw MessageFormatException(" not a String type", NULL);
         }
 
     } catch (NumberFormatException& ex) {
 
         try {
-            this->dataIn->reset();
+            this->impl->reset();
         } catch (IOException& ioe) {
             throw CMSExceptionSupport::create(ioe);
         }
@@ -879,14 +927,14 @@ cms::Message::ValueType ActiveMQStreamMessage::getNextValueType() const {
                 "Cannot read the next type during an byte array read operation, complete the read first.");
         }
 
-        this->dataIn->mark(10);
-        int type = this->dataIn->read();
+        this->impl->mark();
+        int type = this->impl->read();
 
         if (type == -1) {
             throw MessageEOFException("reached end of data", NULL);
         }
 
-        this->dataIn->reset();
+        this->impl->reset();
 
         switch(type) {
             case util::PrimitiveValueNode::NULL_TYPE:
@@ -950,15 +998,25 @@ void ActiveMQStreamMessage::initializeReading() const {
 
     this->failIfWriteOnlyBody();
     try {
-        if (this->dataIn.get() == NULL) {
-            InputStream* is = new ByteArrayInputStream(this->getContent());
+        if (this->impl->cursor.get() == NULL) {
 
-            if (isCompressed()) {
-                is = new InflaterInputStream(is, true);
-                is = new BufferedInputStream(is, true);
-            }
+            if (isCompressed() && getContentLength() > 0) {
+
+                // Inflate the whole body once so that every read works on plain bytes.
+                InflaterInputStream inflater(new ByteArrayInputStream(getContentBytes(), getContentLength()), true);
+
+                unsigned char chunk[8192];
+                int count = 0;
+                while ((count = inflater.read(chunk, (int) sizeof(chunk), 0, (int) sizeof(chunk))) != -1) {
+                    this->impl->inflated.insert(this->impl->inflated.end(), chunk, chunk + count);
+                }
 
-            this->dataIn.reset(new DataInputStream(is, true));
+                const unsigned char* bytes = this->impl->inflated.empty() ? NULL : &this->impl->inflated[0];
+                this->impl->cursor.reset(new ByteCursor(bytes, (int) this->impl->inflated.size()));
+
+            } else {
+                this->impl->cursor.reset(new ByteCursor(getContentBytes(), getContentLength()));
+            }
         }
     }
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
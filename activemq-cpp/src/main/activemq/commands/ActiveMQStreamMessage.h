@@ -47,7 +47,6 @@ namespace commands {
 
         ActiveMQStreamMessageImpl* impl;
 
-        mutable std::auto_ptr<decaf::io::DataInputStream> dataIn;
         mutable std::auto_ptr<decaf::io::DataOutputStream> dataOut;
 
     public:
@@ -172,17 +172,21 @@ std::string ActiveMQTextMessage::getText() const {
             return *( this->text.get() );
         } else {
 
-            if( this->getContent().size() <= 4 ) {
+            if( this->getContentLength() <= 4 ) {
                 return "";
             }
 
-            try {
+            // Uncompressed text is copied straight out of the content and not kept, so
+            // a Message that is forwarded isn't encoded again.
+            if( !isCompressed() ) {
+                std::pair<const char*, int> view = this->getTextView();
+                return std::string( view.first, view.second );
+            }
 
-                InputStream* is = new ByteArrayInputStream( getContent() );
+            try {
 
-                if( isCompressed() ) {
-                    is = new InflaterInputStream( is, true );
-                }
+                InputStream* is = new ByteArrayInputStream( this->getContentBytes(), this->getContentLength() );
+                is = new InflaterInputStream( is, true );
 
                 DataInputStream dataIn( is, true );
 
@@ -200,6 +204,43 @@ std::string ActiveMQTextMessage::getText() const {
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
 
+////////////////////////////////////////////////////////////////////////////////
+std::pair<const char*, int> ActiveMQTextMessage::getTextView() const {
+
+    try{
+
+        if( this->text.get() == NULL && isCompressed() ) {
+            this->getText();
+        }
+
+        if( this->text.get() != NULL ) {
+            return std::make_pair( this->text->data(), (int)this->text->size() );
+        }
+
+        const unsigned char* content = this->getContentBytes();
+        int size = this->getContentLength();
+
+        if( size <= 4 ) {
+            return std::make_pair( "", 0 );
+        }
+
+        // The big endian length prefix written by MarshallingSupport::writeString32.
+        int length = ( content[0] << 24 ) | ( content[1] << 16 ) | ( content[2] << 8 ) | content[3];
+
+        if( length <= 0 ) {
+            return std::make_pair( "", 0 );
+        }
+
+        if( length > size - 4 ) {
+            throw CMSExceptionSupport::createMessageFormatException( IOException(
+                __FILE__, __LINE__, "Text of %d bytes doesn't fit in %d bytes of content.", length, size - 4 ) );
+        }
+
+        return std::make_pair( (const char*)( content + 4 ), length );
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQTextMessage::setText( const char* msg ) {
 
@@ -215,6 +256,7 @@ void ActiveMQTextMessage::setText( const std::string& msg ) {
     try{
         failIfReadOnlyBody();
         this->text.reset( new std::string( msg ) );
+        this->clearCachedWireForm();
     }
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
@@ -29,6 +29,7 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <utility>
 
 namespace activemq{
 namespace commands{
@@ -84,6 +85,22 @@ namespace commands{
 
         virtual void setText( const std::string& msg );
 
+    public:
+
+        /**
+         * Returns the text of this Message without copying it.  Uncompressed text is read
+         * in place from the Message content and compressed text is decompressed once and
+         * kept, so repeated calls cost nothing.  The view is valid until the text is set,
+         * the body is cleared or the Message is deleted.
+         *
+         * @return the first byte of the text, which isn't null terminated, and its length.
+         *
+         * @throws CMSException if the content doesn't hold valid text.
+         *
+         * @since 3.8
+         */
+        std::pair<const char*, int> getTextView() const;
+
     };
 
 }}
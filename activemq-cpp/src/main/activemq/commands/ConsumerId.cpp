@@ -43,22 +43,23 @@ using namespace decaf::internal::util;
 
 ////////////////////////////////////////////////////////////////////////////////
 ConsumerId::ConsumerId() :
-    BaseDataStructure(), connectionId(""), sessionId(0), value(0), parentId() {
+    BaseDataStructure(), connectionId(""), sessionId(0), value(0), connectionKey(), parentId() {
 
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ConsumerId::ConsumerId(const ConsumerId& other) :
-    BaseDataStructure(), connectionId(""), sessionId(0), value(0), parentId() {
+    BaseDataStructure(), connectionId(""), sessionId(0), value(0), connectionKey(), parentId() {
 
     this->copyDataStructure(&other);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ConsumerId::ConsumerId(const SessionId& sessionId, long long consumerId) :
-    BaseDataStructure(), connectionId(""), sessionId(0), value(0), parentId() {
+    BaseDataStructure(), connectionId(""), sessionId(0), value(0), connectionKey(), parentId() {
 
     this->connectionId = sessionId.getConnectionId();
+    this->connectionKey = sessionId.getConnectionKey();
     this->sessionId = sessionId.getValue();
     this->value = consumerId;
 }
@@ -96,7 +97,8 @@ void ConsumerId::copyDataStructure(const DataStructure* src) {
     // Copy the data of the base class or classes
     BaseDataStructure::copyDataStructure(src);
 
-    this->setConnectionId(srcPtr->getConnectionId());
+    this->connectionId = srcPtr->connectionId;
+    this->connectionKey = srcPtr->connectionKey;
     this->setSessionId(srcPtr->getSessionId());
     this->setValue(srcPtr->getValue());
 }
@@ -159,6 +161,9 @@ std::string& ConsumerId::getConnectionId() {
 ////////////////////////////////////////////////////////////////////////////////
 void ConsumerId::setConnectionId(const std::string& connectionId) {
     this->connectionId = connectionId;
+    if (this->connectionKey == NULL || this->connectionKey->getConnectionId() != this->connectionId) {
+        this->connectionKey = activemq::util::ConnectionIdTable::intern(this->connectionId);
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -188,9 +193,11 @@ int ConsumerId::compareTo(const ConsumerId& value) const {
         return 0;
     }
 
-    int connectionIdComp = StringUtils::compareIgnoreCase(this->connectionId.c_str(), value.connectionId.c_str());
-    if (connectionIdComp != 0) {
-        return connectionIdComp;
+    if (this->connectionKey == NULL || this->connectionKey != value.connectionKey) {
+        int connectionIdComp = StringUtils::compareIgnoreCase(this->connectionId.c_str(), value.connectionId.c_str());
+        if (connectionIdComp != 0) {
+            return connectionIdComp;
+        }
     }
 
     if (this->sessionId > value.sessionId) {
@@ -231,7 +238,7 @@ ConsumerId& ConsumerId::operator= (const ConsumerId& other) {
 
 ////////////////////////////////////////////////////////////////////////////////
 int ConsumerId::getHashCode() const {
-    return decaf::util::HashCode<std::string>()(this->toString());
+    return this->getCompactId().getHashCode();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -242,3 +249,19 @@ const Pointer<SessionId>& ConsumerId::getParentId() const {
     return this->parentId;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+const activemq::util::ConnectionKey& ConsumerId::getConnectionKey() const {
+    return this->connectionKey;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ConsumerId::setConnectionKey(const activemq::util::ConnectionKey& connectionKey) {
+    this->connectionKey = connectionKey;
+    this->connectionId = connectionKey != NULL ? connectionKey->getConnectionId() : std::string();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+activemq::util::CompactId ConsumerId::getCompactId() const {
+    return activemq::util::CompactId(this->getConnectionKey(), this->sessionId, this->value);
+}
+
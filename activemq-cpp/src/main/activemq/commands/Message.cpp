@@ -22,6 +22,7 @@
 #include <activemq/state/CommandVisitor.h>
 #include <activemq/wireformat/openwire/marshal/BaseDataStreamMarshaller.h>
 #include <activemq/wireformat/openwire/marshal/PrimitiveTypesMarshaller.h>
+#include <cstring>
 #include <decaf/lang/System.h>
 #include <decaf/lang/exceptions/NullPointerException.h>
 
@@ -47,7 +48,7 @@ Message::Message() :
     BaseCommand(), producerId(NULL), destination(NULL), transactionId(NULL), originalDestination(NULL), messageId(NULL), originalTransactionId(NULL), 
       groupID(""), groupSequence(0), correlationId(""), persistent(false), expiration(0), priority(0), replyTo(NULL), timestamp(0), 
       type(""), content(), marshalledProperties(), dataStructure(NULL), targetConsumerId(NULL), compressed(false), redeliveryCounter(0), 
-      brokerPath(), arrival(0), userID(""), recievedByDFBridge(false), droppable(false), cluster(), brokerInTime(0), brokerOutTime(0), ackHandler(NULL), properties(), readOnlyProperties(false), readOnlyBody(false), connection(NULL) {
+      brokerPath(), arrival(0), userID(""), recievedByDFBridge(false), droppable(false), cluster(), brokerInTime(0), brokerOutTime(0), ackHandler(NULL), properties(), readOnlyProperties(false), readOnlyBody(false), trace(), mappedContent(), propertiesMarshalled(false), propertiesPending(false), cachedWireForm(), cachedWireFormKey(0), connection(NULL) {
 
 }
 
@@ -99,7 +100,8 @@ void Message::copyDataStructure(const DataStructure* src) {
     this->setReplyTo(srcPtr->getReplyTo());
     this->setTimestamp(srcPtr->getTimestamp());
     this->setType(srcPtr->getType());
-    this->setContent(srcPtr->getContent());
+    this->content = srcPtr->content;
+    this->mappedContent = srcPtr->mappedContent;
     this->setMarshalledProperties(srcPtr->getMarshalledProperties());
     this->setDataStructure(srcPtr->getDataStructure());
     this->setTargetConsumerId(srcPtr->getTargetConsumerId());
@@ -118,6 +120,8 @@ void Message::copyDataStructure(const DataStructure* src) {
     this->setReadOnlyBody(srcPtr->isReadOnlyBody());
     this->setReadOnlyProperties(srcPtr->isReadOnlyProperties());
     this->setConnection(srcPtr->getConnection());
+    this->propertiesMarshalled = srcPtr->propertiesMarshalled;
+    this->propertiesPending = srcPtr->propertiesPending;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -200,8 +204,8 @@ std::string Message::toString() const {
     stream << "Type = " << this->getType();
     stream << ", ";
     stream << "Content = ";
-    if (this->getContent().size() > 0) {
-        stream << "[size=" << this->getContent().size() << "]";
+    if (this->getContentLength() > 0) {
+        stream << "[size=" << this->getContentLength() << "]";
     } else {
         stream << "NULL";
     }
@@ -363,10 +367,12 @@ bool Message::equals(const DataStructure* value) const {
     if (this->getType() != valuePtr->getType()) {
         return false;
     }
-    for (size_t icontent = 0; icontent < this->getContent().size(); ++icontent) {
-        if (this->getContent()[icontent] != valuePtr->getContent()[icontent]) {
-            return false;
-        }
+    if (this->getContentLength() != valuePtr->getContentLength()) {
+        return false;
+    }
+    if (this->getContentLength() > 0 &&
+        std::memcmp(this->getContentBytes(), valuePtr->getContentBytes(), this->getContentLength()) != 0) {
+        return false;
     }
     for (size_t imarshalledProperties = 0; imarshalledProperties < this->getMarshalledProperties().size(); ++imarshalledProperties) {
         if (this->getMarshalledProperties()[imarshalledProperties] != valuePtr->getMarshalledProperties()[imarshalledProperties]) {
@@ -433,7 +439,7 @@ bool Message::equals(const DataStructure* value) const {
         return false;
     }
 
-    if (!properties.equals(valuePtr->properties)) {
+    if (!getMessageProperties().equals(valuePtr->getMessageProperties())) {
         return false;
     }
 
@@ -458,12 +464,14 @@ const decaf::lang::Pointer<ProducerId>& Message::getProducerId() const {
 
 ////////////////////////////////////////////////////////////////////////////////
 decaf::lang::Pointer<ProducerId>& Message::getProducerId() {
+    this->clearCachedWireForm();
     return producerId;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setProducerId(const decaf::lang::Pointer<ProducerId>& producerId) {
     this->producerId = producerId;
+    this->clearCachedWireForm();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -473,12 +481,14 @@ const decaf::lang::Pointer<ActiveMQDestination>& Message::getDestination() const
 
 ////////////////////////////////////////////////////////////////////////////////
 decaf::lang::Pointer<ActiveMQDestination>& Message::getDestination() {
+    this->clearCachedWireForm();
     return destination;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setDestination(const decaf::lang::Pointer<ActiveMQDestination>& destination) {
     this->destination = destination;
+    this->clearCachedWireForm();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -488,12 +498,14 @@ const decaf::lang::Pointer<TransactionId>& Message::getTransactionId() const {
 
 ////////////////////////////////////////////////////////////////////////////////
 decaf::lang::Pointer<TransactionId>& Message::getTransactionId() {
+    this->clearCachedWireForm();
     return transactionId;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setTransactionId(const decaf::lang::Pointer<TransactionId>& transactionId) {
     this->transactionId = transactionId;
+    this->clearCachedWireForm();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -503,12 +515,14 @@ const decaf::lang::Pointer<ActiveMQDestination>& Message::getOriginalDestination
 
 ////////////////////////////////////////////////////////////////////////////////
 decaf::lang::Pointer<ActiveMQDestination>& Message::getOriginalDestination() {
+    this->clearCachedWireForm();
     return originalDestination;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setOriginalDestination(const decaf::lang::Pointer<ActiveMQDestination>& originalDestination) {
     this->originalDestination = originalDestination;
+    this->clearCachedWireForm();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -518,12 +532,14 @@ const decaf::lang::Pointer<MessageId>& Message::getMessageId() const {
 
 ////////////////////////////////////////////////////////////////////////////////
 decaf::lang::Pointer<MessageId>& Message::getMessageId() {
+    this->clearCachedWireForm();
     return messageId;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setMessageId(const decaf::lang::Pointer<MessageId>& messageId) {
     this->messageId = messageId;
+    this->clearCachedWireForm();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -533,12 +549,14 @@ const decaf::lang::Pointer<TransactionId>& Message::getOriginalTransactionId() c
 
 ////////////////////////////////////////////////////////////////////////////////
 decaf::lang::Pointer<TransactionId>& Message::getOriginalTransactionId() {
+    this->clearCachedWireForm();
     return originalTransactionId;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setOriginalTransactionId(const decaf::lang::Pointer<TransactionId>& originalTransactionId) {
     this->originalTransactionId = originalTransactionId;
+    this->clearCachedWireForm();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -548,12 +566,14 @@ const std::string& Message::getGroupID() const {
 
 ////////////////////////////////////////////////////////////////////////////////
 std::string& Message::getGroupID() {
+    this->clearCachedWireForm();
     return groupID;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setGroupID(const std::string& groupID) {
     this->groupID = groupID;
+    this->clearCachedWireForm();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -564,6 +584,7 @@ int Message::getGroupSequence() const {
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setGroupSequence(int groupSequence) {
     this->groupSequence = groupSequence;
+    this->clearCachedWireForm();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -573,12 +594,14 @@ const std::string& Message::getCorrelationId() const {
 
 ////////////////////////////////////////////////////////////////////////////////
 std::string& Message::getCorrelationId() {
+    this->clearCachedWireForm();
     return correlationId;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setCorrelationId(const std::string& correlationId) {
     this->correlationId = correlationId;
+    this->clearCachedWireForm();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -589,6 +612,7 @@ bool Message::isPersistent() const {
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setPersistent(bool persistent) {
     this->persistent = persistent;
+    this->clearCachedWireForm();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -599,6 +623,7 @@ long long Message::getExpiration() const {
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setExpiration(long long expiration) {
     this->expiration = expiration;
+    this->clearCachedWireForm();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -609,6 +634,7 @@ unsigned char Message::getPriority() const {
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setPriority(unsigned char priority) {
     this->priority = priority;
+    this->clearCachedWireForm();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -618,12 +644,14 @@ const decaf::lang::Pointer<ActiveMQDestination>& Message::getReplyTo() const {
 
 ////////////////////////////////////////////////////////////////////////////////
 decaf::lang::Pointer<ActiveMQDestination>& Message::getReplyTo() {
+    this->clearCachedWireForm();
     return replyTo;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setReplyTo(const decaf::lang::Pointer<ActiveMQDestination>& replyTo) {
     this->replyTo = replyTo;
+    this->clearCachedWireForm();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -634,6 +662,7 @@ long long Message::getTimestamp() const {
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setTimestamp(long long timestamp) {
     this->timestamp = timestamp;
+    this->clearCachedWireForm();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -643,12 +672,14 @@ const std::string& Message::getType() const {
 
 ////////////////////////////////////////////////////////////////////////////////
 std::string& Message::getType() {
+    this->clearCachedWireForm();
     return type;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setType(const std::string& type) {
     this->type = type;
+    this->clearCachedWireForm();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -658,12 +689,16 @@ const std::vector<unsigned char>& Message::getContent() const {
 
 ////////////////////////////////////////////////////////////////////////////////
 std::vector<unsigned char>& Message::getContent() {
+    this->loadMappedContent();
+    this->clearCachedWireForm();
     return content;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setContent(const std::vector<unsigned char>& content) {
     this->content = content;
+    this->mappedContent.reset(NULL);
+    this->clearCachedWireForm();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -673,12 +708,14 @@ const std::vector<unsigned char>& Message::getMarshalledProperties() const {
 
 ////////////////////////////////////////////////////////////////////////////////
 std::vector<unsigned char>& Message::getMarshalledProperties() {
+    this->invalidateMarshalledProperties();
     return marshalledProperties;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setMarshalledProperties(const std::vector<unsigned char>& marshalledProperties) {
     this->marshalledProperties = marshalledProperties;
+    this->invalidateMarshalledProperties();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -688,12 +725,14 @@ const decaf::lang::Pointer<DataStructure>& Message::getDataStructure() const {
 
 ////////////////////////////////////////////////////////////////////////////////
 decaf::lang::Pointer<DataStructure>& Message::getDataStructure() {
+    this->clearCachedWireForm();
     return dataStructure;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setDataStructure(const decaf::lang::Pointer<DataStructure>& dataStructure) {
     this->dataStructure = dataStructure;
+    this->clearCachedWireForm();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -703,12 +742,14 @@ const decaf::lang::Pointer<ConsumerId>& Message::getTargetConsumerId() const {
 
 ////////////////////////////////////////////////////////////////////////////////
 decaf::lang::Pointer<ConsumerId>& Message::getTargetConsumerId() {
+    this->clearCachedWireForm();
     return targetConsumerId;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setTargetConsumerId(const decaf::lang::Pointer<ConsumerId>& targetConsumerId) {
     this->targetConsumerId = targetConsumerId;
+    this->clearCachedWireForm();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -719,6 +760,7 @@ bool Message::isCompressed() const {
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setCompressed(bool compressed) {
     this->compressed = compressed;
+    this->clearCachedWireForm();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -729,6 +771,7 @@ int Message::getRedeliveryCounter() const {
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setRedeliveryCounter(int redeliveryCounter) {
     this->redeliveryCounter = redeliveryCounter;
+    this->clearCachedWireForm();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -738,12 +781,14 @@ const std::vector< decaf::lang::Pointer<BrokerId> >& Message::getBrokerPath() co
 
 ////////////////////////////////////////////////////////////////////////////////
 std::vector< decaf::lang::Pointer<BrokerId> >& Message::getBrokerPath() {
+    this->clearCachedWireForm();
     return brokerPath;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setBrokerPath(const std::vector< decaf::lang::Pointer<BrokerId> >& brokerPath) {
     this->brokerPath = brokerPath;
+    this->clearCachedWireForm();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -754,6 +799,7 @@ long long Message::getArrival() const {
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setArrival(long long arrival) {
     this->arrival = arrival;
+    this->clearCachedWireForm();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -763,12 +809,14 @@ const std::string& Message::getUserID() const {
 
 ////////////////////////////////////////////////////////////////////////////////
 std::string& Message::getUserID() {
+    this->clearCachedWireForm();
     return userID;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setUserID(const std::string& userID) {
     this->userID = userID;
+    this->clearCachedWireForm();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -779,6 +827,7 @@ bool Message::isRecievedByDFBridge() const {
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setRecievedByDFBridge(bool recievedByDFBridge) {
     this->recievedByDFBridge = recievedByDFBridge;
+    this->clearCachedWireForm();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -789,6 +838,7 @@ bool Message::isDroppable() const {
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setDroppable(bool droppable) {
     this->droppable = droppable;
+    this->clearCachedWireForm();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -798,12 +848,14 @@ const std::vector< decaf::lang::Pointer<BrokerId> >& Message::getCluster() const
 
 ////////////////////////////////////////////////////////////////////////////////
 std::vector< decaf::lang::Pointer<BrokerId> >& Message::getCluster() {
+    this->clearCachedWireForm();
     return cluster;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setCluster(const std::vector< decaf::lang::Pointer<BrokerId> >& cluster) {
     this->cluster = cluster;
+    this->clearCachedWireForm();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -814,6 +866,7 @@ long long Message::getBrokerInTime() const {
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setBrokerInTime(long long brokerInTime) {
     this->brokerInTime = brokerInTime;
+    this->clearCachedWireForm();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -824,6 +877,7 @@ long long Message::getBrokerOutTime() const {
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setBrokerOutTime(long long brokerOutTime) {
     this->brokerOutTime = brokerOutTime;
+    this->clearCachedWireForm();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -846,7 +900,7 @@ unsigned int Message::getSize() const {
 
     unsigned int size = DEFAULT_MESSAGE_SIZE;
 
-    size += (unsigned int)this->getContent().size();
+    size += (unsigned int)this->getContentLength();
     size += (unsigned int)this->getMarshalledProperties().size();
 
     return size;
@@ -856,11 +910,41 @@ unsigned int Message::getSize() const {
 void Message::beforeMarshal(wireformat::WireFormat* wireFormat AMQCPP_UNUSED) {
 
     try {
+        this->marshalProperties();
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::Exception, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Message::afterUnmarshal(wireformat::WireFormat* wireFormat AMQCPP_UNUSED) {
+
+    try {
+        wireformat::openwire::marshal::PrimitiveTypesMarshaller::unmarshal(
+            &properties, marshalledProperties);
+        this->propertiesMarshalled = true;
+        this->propertiesPending = false;
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::Exception, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Message::marshalProperties() {
+
+    try {
+        if (this->propertiesMarshalled || this->propertiesPending) {
+            return;
+        }
+
         marshalledProperties.clear();
         if (!properties.isEmpty()) {
             wireformat::openwire::marshal::PrimitiveTypesMarshaller::marshal(
                 &properties, marshalledProperties );
         }
+        this->propertiesMarshalled = true;
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::Exception, decaf::io::IOException)
@@ -868,14 +952,64 @@ void Message::beforeMarshal(wireformat::WireFormat* wireFormat AMQCPP_UNUSED) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void Message::afterUnmarshal(wireformat::WireFormat* wireFormat AMQCPP_UNUSED) {
+void Message::unmarshalPendingProperties() const {
 
     try {
-        wireformat::openwire::marshal::PrimitiveTypesMarshaller::unmarshal(
-            &properties, marshalledProperties);
+        if (!this->propertiesPending) {
+            return;
+        }
+
+        properties.clear();
+        if (!marshalledProperties.empty()) {
+            wireformat::openwire::marshal::PrimitiveTypesMarshaller::unmarshal(
+                &properties, marshalledProperties);
+        }
+        this->propertiesPending = false;
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::Exception, decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void Message::swapEncodedProperties(std::vector<unsigned char>& encoded) {
+
+    this->properties.clear();
+    this->marshalledProperties.swap(encoded);
+    this->propertiesMarshalled = true;
+    this->propertiesPending = true;
+    this->clearCachedWireForm();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Message::setCachedWireForm(int key, const unsigned char* frame, int length) {
+
+    if (key == 0 || frame == NULL || length <= 0) {
+        this->clearCachedWireForm();
+        return;
+    }
+
+    this->cachedWireForm.assign(frame, frame + length);
+    this->cachedWireFormKey = key;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Message::setMappedContent(const Pointer<activemq::util::MappedFileRegion>& region) {
+
+    std::vector<unsigned char>().swap(this->content);
+    this->mappedContent = region;
+    this->clearCachedWireForm();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Message::loadMappedContent() {
+
+    if (this->mappedContent == NULL) {
+        return;
+    }
+
+    const unsigned char* data = this->mappedContent->getData();
+    this->content.assign(data, data + this->mappedContent->getLength());
+    this->mappedContent.reset(NULL);
+}
+
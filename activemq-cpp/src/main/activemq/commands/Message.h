@@ -32,7 +32,9 @@
 #include <activemq/commands/ProducerId.h>
 #include <activemq/commands/TransactionId.h>
 #include <activemq/core/ActiveMQAckHandler.h>
+#include <activemq/metrics/MessageTrace.h>
 #include <activemq/util/Config.h>
+#include <activemq/util/MappedFileRegion.h>
 #include <activemq/util/PrimitiveMap.h>
 #include <decaf/lang/Pointer.h>
 #include <string>
@@ -101,7 +103,7 @@ namespace commands{
 
         // Message properties, these are Marshaled and Unmarshaled from the Message
         // Command's marshaledProperties vector.
-        activemq::util::PrimitiveMap properties;
+        mutable activemq::util::PrimitiveMap properties;
 
         // Indicates if the Message Properties are Read Only
         bool readOnlyProperties;
@@ -109,6 +111,26 @@ namespace commands{
         // Indicates if the Message Body are Read Only
         bool readOnlyBody;
 
+        // Latency trace of this message when it has been sampled, never marshaled.
+        Pointer<metrics::MessageTrace> trace;
+
+        // The body when it is mapped from a file in place of content, shared by
+        // copies of this Message and marshaled directly from the mapping.
+        Pointer<activemq::util::MappedFileRegion> mappedContent;
+
+        // Indicates that marshalledProperties holds the encoding of the current
+        // properties so they need not be encoded again, never marshaled.
+        bool propertiesMarshalled;
+
+        // Indicates that the properties were supplied already encoded and are only
+        // decoded into the properties map when first read, never marshaled.
+        mutable bool propertiesPending;
+
+        // The last complete frame this Message was marshaled into along with the
+        // key of the wire format settings used, a key of zero means no frame.
+        std::vector<unsigned char> cachedWireForm;
+        int cachedWireFormKey;
+
     protected:
 
         core::ActiveMQConnection* connection;
@@ -233,12 +255,21 @@ namespace commands{
          * @return a reference to the Primitive Map that holds message properties.
          */
         util::PrimitiveMap& getMessageProperties() {
+            this->unmarshalPendingProperties();
+            this->invalidateMarshalledProperties();
             return this->properties;
         }
         const util::PrimitiveMap& getMessageProperties() const {
+            this->unmarshalPendingProperties();
             return this->properties;
         }
 
+        /**
+         * Decodes properties that were supplied already encoded into the properties
+         * map, does nothing when there are none pending.
+         */
+        void unmarshalPendingProperties() const;
+
         /**
          * Returns if the Message Properties Are Read Only
          * @return true if Message Properties are Read Only.
@@ -271,6 +302,129 @@ namespace commands{
             this->readOnlyBody = value;
         }
 
+        /**
+         * Gets the latency trace that follows this Message through the send or
+         * dispatch pipeline.
+         * @returns the trace or NULL if this Message wasn't sampled.
+         */
+        const Pointer<metrics::MessageTrace>& getTrace() const {
+            return this->trace;
+        }
+
+        /**
+         * Sets the latency trace that follows this Message through the send or
+         * dispatch pipeline.
+         * @param trace - the trace to stamp or NULL to stop tracing.
+         */
+        void setTrace(const Pointer<metrics::MessageTrace>& trace) {
+            this->trace = trace;
+        }
+
+        /**
+         * Encodes the Message properties into the marshalled properties unless the
+         * current properties have already been encoded.  Clones copy the encoding
+         * so a Message sent to many destinations has its properties encoded once.
+         *
+         * @throws IOException if the properties cannot be encoded.
+         */
+        void marshalProperties();
+
+        /**
+         * Marks the Message properties as modified, the encoded properties and any
+         * cached frame are discarded.  Code that writes the properties other than
+         * through getMessageProperties() must call this afterwards.
+         */
+        void invalidateMarshalledProperties() {
+            this->propertiesMarshalled = false;
+            this->clearCachedWireForm();
+        }
+
+        /**
+         * Replaces the properties of this Message with ones that were encoded elsewhere,
+         * the encoding is sent as is and only decoded if the properties are read.  The
+         * given vector receives the previous encoding so its storage can be reused.
+         *
+         * @param encoded - the properties in the form PrimitiveTypesMarshaller writes.
+         */
+        void swapEncodedProperties(std::vector<unsigned char>& encoded);
+
+        /**
+         * Returns true if this Message holds a frame marshaled with the wire format
+         * settings identified by the given key and has not been modified since.
+         *
+         * @param key - the non-zero key of the wire format settings.
+         */
+        bool hasCachedWireForm(int key) const {
+            return key != 0 && this->cachedWireFormKey == key;
+        }
+
+        /**
+         * @returns the cached frame, empty when hasCachedWireForm is false.
+         */
+        const std::vector<unsigned char>& getCachedWireForm() const {
+            return this->cachedWireForm;
+        }
+
+        /**
+         * Stores the frame this Message was just marshaled into, the frame is
+         * dropped again by any setter or non-const getter of this Message.
+         *
+         * @param key - the non-zero key of the wire format settings used.
+         * @param frame - the encoded frame.
+         * @param length - the number of bytes in the frame.
+         */
+        void setCachedWireForm(int key, const unsigned char* frame, int length);
+
+        /**
+         * Discards the cached frame, if any.
+         */
+        void clearCachedWireForm() {
+            if (this->cachedWireFormKey != 0) {
+                this->cachedWireFormKey = 0;
+                std::vector<unsigned char>().swap(this->cachedWireForm);
+            }
+        }
+
+        /**
+         * Replaces the body of this Message with a region of a mapped file, the
+         * content stays empty until the non-const getContent() copies the body into it.
+         * The body is read in place with getContentBytes() and getContentLength().
+         *
+         * @param region - the mapped bytes that form the body.
+         */
+        void setMappedContent(const Pointer<activemq::util::MappedFileRegion>& region);
+
+        /**
+         * @returns the mapped region holding the body or NULL if the body is in the content.
+         */
+        const Pointer<activemq::util::MappedFileRegion>& getMappedContent() const {
+            return this->mappedContent;
+        }
+
+        /**
+         * Copies a mapped body into the content and releases the mapping, the
+         * non-const getContent() does this before handing out the content.
+         */
+        void loadMappedContent();
+
+        /**
+         * @returns the number of bytes in the body, whether mapped or not.
+         */
+        int getContentLength() const {
+            return this->mappedContent != NULL ?
+                this->mappedContent->getLength() : (int) this->content.size();
+        }
+
+        /**
+         * @returns the bytes of the body, whether mapped or not, or NULL when it is empty.
+         */
+        const unsigned char* getContentBytes() const {
+            if (this->mappedContent != NULL) {
+                return this->mappedContent->getData();
+            }
+            return this->content.empty() ? NULL : &this->content[0];
+        }
+
         virtual const Pointer<ProducerId>& getProducerId() const;
         virtual Pointer<ProducerId>& getProducerId();
         virtual void setProducerId( const Pointer<ProducerId>& producerId );
@@ -257,7 +257,7 @@ MessageId& MessageId::operator= (const MessageId& other) {
 
 ////////////////////////////////////////////////////////////////////////////////
 int MessageId::getHashCode() const {
-    return decaf::util::HashCode<std::string>()(this->toString());
+    return this->getCompactId().getHashCode();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -282,3 +282,14 @@ void MessageId::setTextView(const std::string& key) {
     this->key = key;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+activemq::util::CompactId MessageId::getCompactId() const {
+
+    if (this->producerId == NULL) {
+        return activemq::util::CompactId(activemq::util::ConnectionKey(), 0, 0, this->producerSequenceId);
+    }
+
+    return activemq::util::CompactId(this->producerId->getConnectionKey(), this->producerId->getSessionId(),
+                                     this->producerId->getValue(), this->producerSequenceId);
+}
+
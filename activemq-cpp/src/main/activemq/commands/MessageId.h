@@ -93,6 +93,12 @@ namespace commands {
 
         void setTextView(const std::string& key);
 
+        /**
+         * @return the numeric form of this id, the CompactId of the producer that sent
+         *         it with the producer sequence id added.
+         */
+        activemq::util::CompactId getCompactId() const;
+
         virtual const Pointer<ProducerId>& getProducerId() const;
         virtual Pointer<ProducerId>& getProducerId();
         virtual void setProducerId( const Pointer<ProducerId>& producerId );
@@ -44,29 +44,30 @@ using namespace decaf::internal::util;
 
 ////////////////////////////////////////////////////////////////////////////////
 ProducerId::ProducerId() :
-    BaseDataStructure(), connectionId(""), value(0), sessionId(0), parentId() {
+    BaseDataStructure(), connectionId(""), value(0), sessionId(0), connectionKey(), parentId() {
 
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ProducerId::ProducerId(const ProducerId& other) :
-    BaseDataStructure(), connectionId(""), value(0), sessionId(0), parentId() {
+    BaseDataStructure(), connectionId(""), value(0), sessionId(0), connectionKey(), parentId() {
 
     this->copyDataStructure(&other);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ProducerId::ProducerId( const SessionId& sessionId, long long consumerId ) : 
-    BaseDataStructure(), connectionId(""), value(0), sessionId(0), parentId() {
+    BaseDataStructure(), connectionId(""), value(0), sessionId(0), connectionKey(), parentId() {
 
     this->connectionId = sessionId.getConnectionId();
+    this->connectionKey = sessionId.getConnectionKey();
     this->sessionId = sessionId.getValue();
     this->value = consumerId;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ProducerId::ProducerId(std::string producerKey) :
-    BaseDataStructure(), connectionId(""), value(0), sessionId(0), parentId() {
+    BaseDataStructure(), connectionId(""), value(0), sessionId(0), connectionKey(), parentId() {
 
     // Parse off the producerId
     std::size_t p = producerKey.rfind( ':' );
@@ -112,7 +113,8 @@ void ProducerId::copyDataStructure(const DataStructure* src) {
     // Copy the data of the base class or classes
     BaseDataStructure::copyDataStructure(src);
 
-    this->setConnectionId(srcPtr->getConnectionId());
+    this->connectionId = srcPtr->connectionId;
+    this->connectionKey = srcPtr->connectionKey;
     this->setValue(srcPtr->getValue());
     this->setSessionId(srcPtr->getSessionId());
 }
@@ -175,6 +177,9 @@ std::string& ProducerId::getConnectionId() {
 ////////////////////////////////////////////////////////////////////////////////
 void ProducerId::setConnectionId(const std::string& connectionId) {
     this->connectionId = connectionId;
+    if (this->connectionKey == NULL || this->connectionKey->getConnectionId() != this->connectionId) {
+        this->connectionKey = activemq::util::ConnectionIdTable::intern(this->connectionId);
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -204,9 +209,11 @@ int ProducerId::compareTo(const ProducerId& value) const {
         return 0;
     }
 
-    int connectionIdComp = StringUtils::compareIgnoreCase(this->connectionId.c_str(), value.connectionId.c_str());
-    if (connectionIdComp != 0) {
-        return connectionIdComp;
+    if (this->connectionKey == NULL || this->connectionKey != value.connectionKey) {
+        int connectionIdComp = StringUtils::compareIgnoreCase(this->connectionId.c_str(), value.connectionId.c_str());
+        if (connectionIdComp != 0) {
+            return connectionIdComp;
+        }
     }
 
     if (this->value > value.value) {
@@ -247,7 +254,7 @@ ProducerId& ProducerId::operator= (const ProducerId& other) {
 
 ////////////////////////////////////////////////////////////////////////////////
 int ProducerId::getHashCode() const {
-    return decaf::util::HashCode<std::string>()(this->toString());
+    return this->getCompactId().getHashCode();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -271,4 +278,22 @@ void ProducerId::setProducerSessionKey( std::string sessionKey ) {
 
     // The rest is the value
     this->connectionId = sessionKey;
+    this->connectionKey = activemq::util::ConnectionIdTable::intern(this->connectionId);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const activemq::util::ConnectionKey& ProducerId::getConnectionKey() const {
+    return this->connectionKey;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void ProducerId::setConnectionKey(const activemq::util::ConnectionKey& connectionKey) {
+    this->connectionKey = connectionKey;
+    this->connectionId = connectionKey != NULL ? connectionKey->getConnectionId() : std::string();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+activemq::util::CompactId ProducerId::getCompactId() const {
+    return activemq::util::CompactId(this->getConnectionKey(), this->sessionId, this->value);
+}
+
@@ -25,6 +25,7 @@
 
 #include <activemq/commands/BaseDataStructure.h>
 #include <activemq/commands/SessionId.h>
+#include <activemq/util/CompactId.h>
 #include <activemq/util/Config.h>
 #include <decaf/lang/Comparable.h>
 #include <decaf/lang/Pointer.h>
@@ -60,6 +61,7 @@ namespace commands {
 
     private:
 
+        activemq::util::ConnectionKey connectionKey;
         mutable Pointer<SessionId> parentId;
 
     public:
@@ -88,6 +90,25 @@ namespace commands {
 
         void setProducerSessionKey(std::string sessionKey);
 
+        /**
+         * @return the interned form of this id's connection id, updated by setConnectionId.
+         */
+        const activemq::util::ConnectionKey& getConnectionKey() const;
+
+        /**
+         * Sets the connection id from an already interned key, used by the marshalers
+         * so that the ids read from one connection don't each go through the table.
+         *
+         * @param connectionKey
+         *      The interned connection id, a NULL key clears the connection id.
+         */
+        void setConnectionKey(const activemq::util::ConnectionKey& connectionKey);
+
+        /**
+         * @return the numeric form of this id, used as the key in maps that see every message.
+         */
+        activemq::util::CompactId getCompactId() const;
+
         virtual const std::string& getConnectionId() const;
         virtual std::string& getConnectionId();
         virtual void setConnectionId( const std::string& connectionId );
@@ -46,38 +46,41 @@ using namespace decaf::internal::util;
 
 ////////////////////////////////////////////////////////////////////////////////
 SessionId::SessionId() :
-    BaseDataStructure(), connectionId(""), value(0), parentId() {
+    BaseDataStructure(), connectionId(""), value(0), connectionKey(), parentId() {
 
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 SessionId::SessionId(const SessionId& other) :
-    BaseDataStructure(), connectionId(""), value(0), parentId() {
+    BaseDataStructure(), connectionId(""), value(0), connectionKey(), parentId() {
 
     this->copyDataStructure(&other);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 SessionId::SessionId(const ConnectionId* connectionId, long long sessionId) :
-    BaseDataStructure(), connectionId(""), value(0), parentId() {
+    BaseDataStructure(), connectionId(""), value(0), connectionKey(), parentId() {
 
     this->connectionId = connectionId->getValue();
+    this->connectionKey = activemq::util::ConnectionIdTable::intern(this->connectionId);
     this->value = sessionId;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 SessionId::SessionId(const ProducerId* producerId) :
-    BaseDataStructure(), connectionId(""), value(0), parentId() {
+    BaseDataStructure(), connectionId(""), value(0), connectionKey(), parentId() {
 
     this->connectionId = producerId->getConnectionId();
+    this->connectionKey = producerId->getConnectionKey();
     this->value = producerId->getSessionId();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 SessionId::SessionId(const ConsumerId* consumerId) :
-    BaseDataStructure(), connectionId(""), value(0), parentId() {
+    BaseDataStructure(), connectionId(""), value(0), connectionKey(), parentId() {
 
     this->connectionId = consumerId->getConnectionId();
+    this->connectionKey = consumerId->getConnectionKey();
     this->value = consumerId->getSessionId();
 }
 
@@ -114,7 +117,8 @@ void SessionId::copyDataStructure(const DataStructure* src) {
     // Copy the data of the base class or classes
     BaseDataStructure::copyDataStructure(src);
 
-    this->setConnectionId(srcPtr->getConnectionId());
+    this->connectionId = srcPtr->connectionId;
+    this->connectionKey = srcPtr->connectionKey;
     this->setValue(srcPtr->getValue());
 }
 
@@ -171,6 +175,9 @@ std::string& SessionId::getConnectionId() {
 ////////////////////////////////////////////////////////////////////////////////
 void SessionId::setConnectionId(const std::string& connectionId) {
     this->connectionId = connectionId;
+    if (this->connectionKey == NULL || this->connectionKey->getConnectionId() != this->connectionId) {
+        this->connectionKey = activemq::util::ConnectionIdTable::intern(this->connectionId);
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -190,9 +197,11 @@ int SessionId::compareTo(const SessionId& value) const {
         return 0;
     }
 
-    int connectionIdComp = StringUtils::compareIgnoreCase(this->connectionId.c_str(), value.connectionId.c_str());
-    if (connectionIdComp != 0) {
-        return connectionIdComp;
+    if (this->connectionKey == NULL || this->connectionKey != value.connectionKey) {
+        int connectionIdComp = StringUtils::compareIgnoreCase(this->connectionId.c_str(), value.connectionId.c_str());
+        if (connectionIdComp != 0) {
+            return connectionIdComp;
+        }
     }
 
     if (this->value > value.value) {
@@ -227,7 +236,7 @@ SessionId& SessionId::operator= (const SessionId& other) {
 
 ////////////////////////////////////////////////////////////////////////////////
 int SessionId::getHashCode() const {
-    return decaf::util::HashCode<std::string>()(this->toString());
+    return this->getCompactId().getHashCode();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -238,3 +247,19 @@ const Pointer<ConnectionId>& SessionId::getParentId() const {
     return this->parentId;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+const activemq::util::ConnectionKey& SessionId::getConnectionKey() const {
+    return this->connectionKey;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SessionId::setConnectionKey(const activemq::util::ConnectionKey& connectionKey) {
+    this->connectionKey = connectionKey;
+    this->connectionId = connectionKey != NULL ? connectionKey->getConnectionId() : std::string();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+activemq::util::CompactId SessionId::getCompactId() const {
+    return activemq::util::CompactId(this->getConnectionKey(), this->value, 0);
+}
+
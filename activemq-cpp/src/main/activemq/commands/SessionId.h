@@ -25,6 +25,7 @@
 
 #include <activemq/commands/BaseDataStructure.h>
 #include <activemq/commands/ConnectionId.h>
+#include <activemq/util/CompactId.h>
 #include <activemq/util/Config.h>
 #include <decaf/lang/Comparable.h>
 #include <decaf/lang/Pointer.h>
@@ -62,6 +63,7 @@ namespace commands {
 
     private:
 
+        activemq::util::ConnectionKey connectionKey;
         mutable Pointer<ConnectionId> parentId;
 
     public:
@@ -90,6 +92,25 @@ namespace commands {
 
         const Pointer<ConnectionId>& getParentId() const;
 
+        /**
+         * @return the interned form of this id's connection id, updated by setConnectionId.
+         */
+        const activemq::util::ConnectionKey& getConnectionKey() const;
+
+        /**
+         * Sets the connection id from an already interned key, used by the marshalers
+         * so that the ids read from one connection don't each go through the table.
+         *
+         * @param connectionKey
+         *      The interned connection id, a NULL key clears the connection id.
+         */
+        void setConnectionKey(const activemq::util::ConnectionKey& connectionKey);
+
+        /**
+         * @return the numeric form of this id, used as the key in maps that see every message.
+         */
+        activemq::util::CompactId getCompactId() const;
+
         virtual const std::string& getConnectionId() const;
         virtual std::string& getConnectionId();
         virtual void setConnectionId( const std::string& connectionId );
@@ -25,6 +25,7 @@
 #include <activemq/core/ActiveMQMessageAudit.h>
 #include <activemq/core/AdvisoryConsumer.h>
 #include <activemq/core/ConnectionAudit.h>
+#include <activemq/core/GroupCommitter.h>
 #include <activemq/core/kernels/ActiveMQSessionKernel.h>
 #include <activemq/core/kernels/ActiveMQProducerKernel.h>
 #include <activemq/core/policies/DefaultPrefetchPolicy.h>
@@ -34,10 +35,13 @@
 #include <activemq/exceptions/ConnectionFailedException.h>
 #include <activemq/util/CMSExceptionSupport.h>
 #include <activemq/util/IdGenerator.h>
+#include <activemq/threads/ThreadPlacement.h>
 #include <activemq/transport/failover/FailoverTransport.h>
+#include <activemq/transport/IOTransport.h>
 #include <activemq/transport/ResponseCallback.h>
 
 #include <decaf/lang/Math.h>
+#include <decaf/lang/System.h>
 #include <decaf/lang/Boolean.h>
 #include <decaf/lang/Integer.h>
 #include <decaf/util/Iterator.h>
@@ -50,7 +54,8 @@
 #include <decaf/util/concurrent/CountDownLatch.h>
 #include <decaf/util/concurrent/ThreadPoolExecutor.h>
 #include <decaf/util/concurrent/LinkedBlockingQueue.h>
-#include <decaf/util/concurrent/locks/ReentrantReadWriteLock.h>
+#include <decaf/util/concurrent/locks/StripedReadWriteLock.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
 
 #include <activemq/commands/Command.h>
 #include <activemq/commands/ActiveMQMessage.h>
@@ -81,6 +86,7 @@ using namespace activemq::exceptions;
 using namespace activemq::threads;
 using namespace activemq::transport;
 using namespace activemq::transport::failover;
+using namespace activemq::metrics;
 using namespace decaf;
 using namespace decaf::io;
 using namespace decaf::util;
@@ -184,6 +190,10 @@ namespace core{
         long long optimizeAcknowledgeTimeOut;
         long long optimizedAckScheduledAckInterval;
         long long consumerFailoverRedeliveryWaitPeriod;
+        threads::ThreadPlacement sessionThreadPlacement;
+        long long consumerBusyPollTime;
+        bool adaptivePrefetch;
+        long long adaptivePrefetchTargetLatency;
 
         std::auto_ptr<PrefetchPolicy> defaultPrefetchPolicy;
         std::auto_ptr<RedeliveryPolicy> defaultRedeliveryPolicy;
@@ -194,6 +204,7 @@ namespace core{
         Pointer<commands::ConnectionInfo> connectionInfo;
         Pointer<commands::BrokerInfo> brokerInfo;
         Pointer<commands::WireFormatInfo> brokerWireFormatInfo;
+        decaf::util::concurrent::atomic::AtomicInteger protocolVersion;
         Pointer<CountDownLatch> transportInterruptionProcessingComplete;
         Pointer<CountDownLatch> brokerInfoReceived;
         Pointer<AdvisoryConsumer> advisoryConsumer;
@@ -203,7 +214,7 @@ namespace core{
         DispatcherMap dispatchers;
         ProducerMap activeProducers;
 
-        decaf::util::concurrent::locks::ReentrantReadWriteLock sessionsLock;
+        decaf::util::concurrent::locks::StripedReadWriteLock sessionsLock;
         decaf::util::LinkedList< Pointer<ActiveMQSessionKernel> > activeSessions;
         decaf::util::LinkedList<transport::TransportListener*> transportListeners;
 
@@ -211,6 +222,10 @@ namespace core{
 
         ConnectionAudit connectionAudit;
 
+        Pointer<GroupCommitter> groupCommitter;
+
+        ConnectionMetrics metrics;
+
         ConnectionConfig(const Pointer<transport::Transport> transport,
                          const Pointer<decaf::util::Properties> properties) :
                              properties(properties),
@@ -251,6 +266,10 @@ namespace core{
                              optimizeAcknowledgeTimeOut(300),
                              optimizedAckScheduledAckInterval(0),
                              consumerFailoverRedeliveryWaitPeriod(0),
+                             sessionThreadPlacement(),
+                             consumerBusyPollTime(0),
+                             adaptivePrefetch(false),
+                             adaptivePrefetchTargetLatency(500),
                              defaultPrefetchPolicy(NULL),
                              defaultRedeliveryPolicy(NULL),
                              exceptionListener(NULL),
@@ -258,6 +277,7 @@ namespace core{
                              connectionInfo(),
                              brokerInfo(),
                              brokerWireFormatInfo(),
+                             protocolVersion(),
                              transportInterruptionProcessingComplete(),
                              brokerInfoReceived(),
                              advisoryConsumer(),
@@ -267,13 +287,16 @@ namespace core{
                              sessionsLock(),
                              activeSessions(),
                              transportListeners(),
-                             activeTempDestinations() {
+                             activeTempDestinations(),
+                             groupCommitter(),
+                             metrics() {
 
             this->defaultPrefetchPolicy.reset(new DefaultPrefetchPolicy());
             this->defaultRedeliveryPolicy.reset(new DefaultRedeliveryPolicy());
             this->clientIdGenerator.reset(new util::IdGenerator);
             this->connectionInfo.reset(new ConnectionInfo());
             this->brokerInfoReceived.reset(new CountDownLatch(1));
+            this->groupCommitter.reset(new GroupCommitter(transport));
 
             // Generate a connectionId
             std::string uniqueId = CONNECTION_ID_GENERATOR.generateId();
@@ -484,6 +507,19 @@ ActiveMQConnection::ActiveMQConnection(const Pointer<transport::Transport> trans
 
     configuration->connectionAudit.setCheckForDuplicates(transport->isFaultTolerant());
 
+    // Have the Transport record into our metrics, a failover transport passes them on to
+    // each of the transports that it connects through.
+    Pointer<TransportMetrics> transportMetrics = configuration->metrics.getTransportMetrics();
+    FailoverTransport* failover = dynamic_cast<FailoverTransport*>(transport->narrow(typeid(FailoverTransport)));
+    if (failover != NULL) {
+        failover->setTransportMetrics(transportMetrics);
+    } else {
+        IOTransport* ioTransport = dynamic_cast<IOTransport*>(transport->narrow(typeid(IOTransport)));
+        if (ioTransport != NULL) {
+            ioTransport->setTransportMetrics(transportMetrics);
+        }
+    }
+
     this->config = configuration.release();
 }
 
@@ -732,6 +768,9 @@ void ActiveMQConnection::close() {
             }
         }
 
+        // The Sessions have seen their commits through so no more can be started.
+        this->config->groupCommitter->close();
+
         // As TemporaryQueue and TemporaryTopic instances are bound to a connection
         // we should just delete them after the connection is closed to free up memory
         ArrayList<Pointer<ActiveMQTempDestination> > tempDests(this->config->activeTempDestinations.values());
@@ -1070,6 +1109,10 @@ void ActiveMQConnection::onCommand(const Pointer<Command> command) {
                         message->setReadOnlyProperties(true);
                         message->setRedeliveryCounter(dispatch->getRedeliveryCounter());
                         message->setConnection(this);
+
+                        if (message->getTrace() != NULL) {
+                            message->getTrace()->mark(MessageTrace::CONNECTION_DISPATCH);
+                        }
                     }
 
                     dispatcher->dispatch(dispatch);
@@ -1091,6 +1134,7 @@ void ActiveMQConnection::onCommand(const Pointer<Command> command) {
 
         } else if (command->isWireFormatInfo()) {
             this->config->brokerWireFormatInfo = command.dynamicCast<WireFormatInfo>();
+            this->config->protocolVersion.set(this->config->brokerWireFormatInfo->getVersion());
         } else if (command->isBrokerInfo()) {
             this->config->brokerInfo = command.dynamicCast<BrokerInfo>();
             this->config->brokerInfoReceived->countDown();
@@ -1219,6 +1263,18 @@ void ActiveMQConnection::transportInterrupted() {
         throw;
     }
 
+    // Sends in flight when the transport went down won't be acknowledged by the Broker,
+    // clear the producer windows so that blocked senders aren't left waiting on them.
+    synchronized(&this->config->activeProducers) {
+        Pointer<Iterator<Pointer<ActiveMQProducerKernel> > > producers(this->config->activeProducers.values().iterator());
+        while (producers->hasNext()) {
+            try {
+                producers->next()->resetProducerWindow();
+            } catch (...) {
+            }
+        }
+    }
+
     synchronized(&this->config->transportListeners) {
         Pointer<Iterator<TransportListener*> > listeners(this->config->transportListeners.iterator());
         while (listeners->hasNext()) {
@@ -1233,6 +1289,18 @@ void ActiveMQConnection::transportInterrupted() {
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQConnection::transportResumed() {
 
+    // Anything sent while the transport was interrupted is resent or lost, either way
+    // the Broker won't acknowledge it against the current producer windows.
+    synchronized(&this->config->activeProducers) {
+        Pointer<Iterator<Pointer<ActiveMQProducerKernel> > > producers(this->config->activeProducers.values().iterator());
+        while (producers->hasNext()) {
+            try {
+                producers->next()->resetProducerWindow();
+            } catch (...) {
+            }
+        }
+    }
+
     synchronized(&this->config->transportListeners) {
         Pointer<Iterator<TransportListener*> > iter(this->config->transportListeners.iterator());
         while (iter->hasNext()) {
@@ -1266,12 +1334,25 @@ Pointer<Response> ActiveMQConnection::syncRequest(Pointer<Command> command, unsi
 
         Pointer<Response> response;
 
-        if (timeout == 0) {
-            response = this->config->transport->request(command);
-        } else {
-            response = this->config->transport->request(command, timeout);
+        ConnectionMetrics& connectionMetrics = this->config->metrics;
+        long long start = System::nanoTime();
+        connectionMetrics.getInFlightRequests().increment();
+
+        try {
+            if (timeout == 0) {
+                response = this->config->transport->request(command);
+            } else {
+                response = this->config->transport->request(command, timeout);
+            }
+        } catch (...) {
+            connectionMetrics.getInFlightRequests().decrement();
+            throw;
         }
 
+        connectionMetrics.getInFlightRequests().decrement();
+        connectionMetrics.getSyncRequests().increment();
+        connectionMetrics.getSyncRequestLatency().recordSince(start);
+
         commands::ExceptionResponse* exceptionResponse = dynamic_cast<ExceptionResponse*>(response.get());
 
         if (exceptionResponse != NULL) {
@@ -1309,6 +1390,19 @@ void ActiveMQConnection::asyncRequest(Pointer<Command> command, cms::AsyncCallba
     AMQ_CATCHALL_THROW(ActiveMQException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::commitAsync(Pointer<TransactionInfo> info, Pointer<cms::AsyncCallback> onComplete) {
+
+    try {
+
+        checkClosedOrFailed();
+        this->config->groupCommitter->commit(info, onComplete);
+    }
+    AMQ_CATCH_RETHROW(ActiveMQException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, ActiveMQException)
+    AMQ_CATCHALL_THROW(ActiveMQException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQConnection::checkClosed() const {
     if (this->isClosed()) {
@@ -1601,6 +1695,11 @@ void ActiveMQConnection::setCloseTimeout(unsigned int timeout) {
     this->config->closeTimeout = timeout;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQConnection::getProtocolVersion() const {
+    return this->config->protocolVersion.get();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 unsigned int ActiveMQConnection::getProducerWindowSize() const {
     return this->config->producerWindowSize;
@@ -1631,6 +1730,35 @@ Pointer<Scheduler> ActiveMQConnection::getScheduler() const {
     return this->config->scheduler;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+ConnectionMetrics& ActiveMQConnection::getConnectionMetrics() const {
+    return this->config->metrics;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ConnectionMetricsSnapshot ActiveMQConnection::getMetricsSnapshot() const {
+
+    ConnectionMetricsSnapshot snapshot;
+
+    snapshot.connectionId = this->config->connectionInfo->getConnectionId()->toString();
+    snapshot.timestamp = System::currentTimeMillis();
+    this->config->metrics.snapshot(snapshot);
+
+    this->config->sessionsLock.readLock().lock();
+    try {
+        std::auto_ptr<Iterator<Pointer<ActiveMQSessionKernel> > > iter(this->config->activeSessions.iterator());
+        while (iter->hasNext()) {
+            snapshot.sessions.push_back(iter->next()->getMetricsSnapshot());
+        }
+    } catch (...) {
+        this->config->sessionsLock.readLock().unlock();
+        throw;
+    }
+    this->config->sessionsLock.readLock().unlock();
+
+    return snapshot;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool ActiveMQConnection::isMessagePrioritySupported() const {
     return this->config->messagePrioritySupported;
@@ -1792,6 +1920,71 @@ void ActiveMQConnection::setConsumerFailoverRedeliveryWaitPeriod(long long value
     this->config->consumerFailoverRedeliveryWaitPeriod = value;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+std::string ActiveMQConnection::getSessionThreadAffinity() const {
+    return this->config->sessionThreadPlacement.toString();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setSessionThreadAffinity(const std::string& value) {
+    this->config->sessionThreadPlacement = threads::ThreadPlacement::parse(value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const threads::ThreadPlacement& ActiveMQConnection::getSessionThreadPlacement() const {
+    return this->config->sessionThreadPlacement;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long ActiveMQConnection::getConsumerBusyPollTime() const {
+    return this->config->consumerBusyPollTime;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setConsumerBusyPollTime(long long value) {
+    this->config->consumerBusyPollTime = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQConnection::getMessageTraceSampleRate() const {
+    return this->config->metrics.getMessageTracer().getSampleRate();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setMessageTraceSampleRate(int value) {
+    this->config->metrics.getMessageTracer().setSampleRate(value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnection::isAdaptivePrefetch() const {
+    return this->config->adaptivePrefetch;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setAdaptivePrefetch(bool value) {
+    this->config->adaptivePrefetch = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long ActiveMQConnection::getAdaptivePrefetchTargetLatency() const {
+    return this->config->adaptivePrefetchTargetLatency;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setAdaptivePrefetchTargetLatency(long long value) {
+    this->config->adaptivePrefetchTargetLatency = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQConnection::getMaxPendingCommits() const {
+    return this->config->groupCommitter->getMaxPendingCommits();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setMaxPendingCommits(int value) {
+    this->config->groupCommitter->setMaxPendingCommits(value);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool ActiveMQConnection::isUseRetroactiveConsumer() const {
     return this->config->useRetroactiveConsumer;
@@ -25,10 +25,14 @@
 #include <activemq/commands/ConnectionInfo.h>
 #include <activemq/commands/ConsumerInfo.h>
 #include <activemq/commands/SessionId.h>
+#include <activemq/commands/TransactionInfo.h>
 #include <activemq/exceptions/ActiveMQException.h>
 #include <activemq/transport/Transport.h>
 #include <activemq/transport/TransportListener.h>
 #include <activemq/threads/Scheduler.h>
+#include <activemq/threads/ThreadPlacement.h>
+#include <activemq/metrics/ConnectionMetrics.h>
+#include <activemq/metrics/MetricsSnapshot.h>
 #include <activemq/core/kernels/ActiveMQProducerKernel.h>
 #include <activemq/core/kernels/ActiveMQSessionKernel.h>
 #include <decaf/util/Properties.h>
@@ -504,6 +508,12 @@ namespace core{
          */
         void setCloseTimeout(unsigned int timeout);
 
+        /**
+         * @return the OpenWire version from the Broker's WireFormatInfo, or zero if the
+         *         Broker hasn't sent one yet.
+         */
+        int getProtocolVersion() const;
+
         /**
          * Gets the configured producer window size for Producers that are created
          * from this connector.  This only applies if there is no send timeout and the
@@ -682,6 +692,120 @@ namespace core{
          */
         void setConsumerFailoverRedeliveryWaitPeriod(long long value);
 
+        /**
+         * Gets the processor placement applied to the dispatch thread of each Session.
+         *
+         * @returns the placement string, empty if Session threads are not placed.
+         */
+        std::string getSessionThreadAffinity() const;
+
+        /**
+         * Sets the processor placement applied to the dispatch thread of each Session, the
+         * value is either a list of processors such as "0,2,4-7" or a NUMA node given as
+         * "node:1".  An empty value leaves the threads to the operating system.  Sessions
+         * whose dispatch thread is already running are not moved.
+         *
+         * @param value
+         *      The placement string to apply.
+         *
+         * @throws IllegalArgumentException if the value is malformed.
+         */
+        void setSessionThreadAffinity(const std::string& value);
+
+        /**
+         * Gets the time in microseconds that a synchronous receive on a new Consumer spins
+         * waiting for a Message before it blocks.
+         *
+         * @returns the busy poll time in microseconds, zero if spinning is disabled.
+         */
+        long long getConsumerBusyPollTime() const;
+
+        /**
+         * Sets the time in microseconds that a synchronous receive on a new Consumer spins
+         * waiting for a Message before it blocks.  Spinning burns a processor while the
+         * receive waits but avoids a thread wake-up for Messages that arrive in time.
+         *
+         * @param value
+         *      The busy poll time in microseconds, zero or less disables spinning.
+         */
+        void setConsumerBusyPollTime(long long value);
+
+        /**
+         * Gets the rate at which this Connection's Messages are sampled for latency tracing, one
+         * in every N Messages is traced.
+         *
+         * @returns the trace sample rate, zero if tracing is disabled.
+         */
+        int getMessageTraceSampleRate() const;
+
+        /**
+         * Sets the rate at which this Connection's Messages are sampled for latency tracing, one
+         * in every N Messages is traced.  A sampled Message records the time at which it
+         * passes each stage of the send and dispatch pipeline.
+         *
+         * @param value
+         *      The trace sample rate, zero or less disables tracing.
+         */
+        void setMessageTraceSampleRate(int value);
+
+        /**
+         * @returns true if this Connection's Consumers adapt their prefetch size to the rate at which they
+         *          consume Messages.
+         */
+        bool isAdaptivePrefetch() const;
+
+        /**
+         * Sets whether this Connection's Consumers adapt their prefetch size to the rate at which they consume
+         * Messages.  An adaptive Consumer starts at its configured prefetch size and then asks
+         * the Broker for a smaller or larger window, never above the configured size, so that
+         * the Messages it holds take about the target latency to consume.  The ack batch size
+         * follows the adapted prefetch size.
+         *
+         * @param value
+         *      True to enable adaptive prefetch.
+         */
+        void setAdaptivePrefetch(bool value);
+
+        /**
+         * Gets the time in milliseconds that the Messages prefetched by an adaptive Consumer
+         * should wait before they are consumed.
+         *
+         * @returns the adaptive prefetch target latency in milliseconds.
+         */
+        long long getAdaptivePrefetchTargetLatency() const;
+
+        /**
+         * Sets the time in milliseconds that the Messages prefetched by an adaptive Consumer
+         * should wait before they are consumed.
+         *
+         * @param value
+         *      The adaptive prefetch target latency in milliseconds.
+         */
+        void setAdaptivePrefetchTargetLatency(long long value);
+
+        /**
+         * Gets the maximum number of asynchronous commits, from all the Sessions of this
+         * Connection, that can be awaiting a response from the Broker at once.
+         *
+         * @returns the maximum number of pending asynchronous commits.
+         */
+        int getMaxPendingCommits() const;
+
+        /**
+         * Sets the maximum number of asynchronous commits, from all the Sessions of this
+         * Connection, that can be awaiting a response from the Broker at once.  A Session
+         * that commits while the limit is reached blocks until a response arrives.
+         *
+         * @param value
+         *      The maximum number of pending asynchronous commits, must be at least one.
+         */
+        void setMaxPendingCommits(int value);
+
+        /**
+         * @returns the parsed placement used for Session dispatch threads.
+         */
+        const threads::ThreadPlacement& getSessionThreadPlacement() const;
+
         /**
          * @return true if optimizeAcknowledge is enabled.
          */
@@ -861,6 +985,22 @@ namespace core{
          */
         Pointer<threads::Scheduler> getScheduler() const;
 
+        /**
+         * Gets the metrics that this Connection and its Transport record into.
+         *
+         * @return a reference to the ConnectionMetrics owned by this Connection.
+         */
+        metrics::ConnectionMetrics& getConnectionMetrics() const;
+
+        /**
+         * Takes a snapshot of the metrics of this Connection and all of its sessions,
+         * consumers and producers.  The snapshot is taken while they keep running, none
+         * of them is paused while their values are read.
+         *
+         * @return a snapshot of the current metrics.
+         */
+        metrics::ConnectionMetricsSnapshot getMetricsSnapshot() const;
+
         /**
          * Returns the Id of the Resource Manager that this client will use should
          * it be entered into an XA Transaction.
@@ -917,6 +1057,21 @@ namespace core{
          */
         void asyncRequest(Pointer<commands::Command> command, cms::AsyncCallback* onComplete);
 
+        /**
+         * Sends a local transaction commit to the broker without waiting for its response,
+         * commits from all the Sessions of this Connection are pipelined and written in
+         * groups.  The callback is invoked from the Transport thread once the response arrives.
+         *
+         * @param info
+         *      The TransactionInfo that commits the transaction.
+         * @param onComplete
+         *      Completion callback that will be notified of the commit's outcome.
+         *
+         * @throws ActiveMQException if the commit could not be sent, in which case the
+         *         callback is not invoked.
+         */
+        void commitAsync(Pointer<commands::TransactionInfo> info, Pointer<cms::AsyncCallback> onComplete);
+
         /**
          * Notify the exception listener
          * @param ex the exception to fire
@@ -98,6 +98,12 @@ namespace core{
         long long optimizeAcknowledgeTimeOut;
         long long optimizedAckScheduledAckInterval;
         long long consumerFailoverRedeliveryWaitPeriod;
+        std::string sessionThreadAffinity;
+        long long consumerBusyPollTime;
+        int messageTraceSampleRate;
+        bool adaptivePrefetch;
+        long long adaptivePrefetchTargetLatency;
+        int maxPendingCommits;
 
         cms::ExceptionListener* defaultListener;
         cms::MessageTransformer* defaultTransformer;
@@ -132,6 +138,12 @@ namespace core{
                             optimizeAcknowledgeTimeOut(300),
                             optimizedAckScheduledAckInterval(0),
                             consumerFailoverRedeliveryWaitPeriod(0),
+                            sessionThreadAffinity(),
+                            consumerBusyPollTime(0),
+                            messageTraceSampleRate(0),
+                            adaptivePrefetch(false),
+                            adaptivePrefetchTargetLatency(500),
+                            maxPendingCommits(64),
                             defaultListener(NULL),
                             defaultTransformer(NULL),
                             defaultPrefetchPolicy(new DefaultPrefetchPolicy()),
@@ -216,6 +228,18 @@ namespace core{
                 properties->getProperty("connection.nonBlockingRedelivery", Boolean::toString(nonBlockingRedelivery)));
             this->watchTopicAdvisories = Boolean::parseBoolean(
                 properties->getProperty("connection.watchTopicAdvisories", Boolean::toString(watchTopicAdvisories)));
+            this->sessionThreadAffinity =
+                properties->getProperty("connection.sessionThreadAffinity", sessionThreadAffinity);
+            this->consumerBusyPollTime = Long::parseLong(
+                properties->getProperty("connection.consumerBusyPollTime", Long::toString(consumerBusyPollTime)));
+            this->messageTraceSampleRate = Integer::parseInt(
+                properties->getProperty("connection.messageTraceSampleRate", Integer::toString(messageTraceSampleRate)));
+            this->adaptivePrefetch = Boolean::parseBoolean(
+                properties->getProperty("connection.adaptivePrefetch", Boolean::toString(adaptivePrefetch)));
+            this->adaptivePrefetchTargetLatency = Long::parseLong(
+                properties->getProperty("connection.adaptivePrefetchTargetLatency", Long::toString(adaptivePrefetchTargetLatency)));
+            this->maxPendingCommits = Integer::parseInt(
+                properties->getProperty("connection.maxPendingCommits", Integer::toString(maxPendingCommits)));
 
             this->defaultPrefetchPolicy->configure(*properties);
             this->defaultRedeliveryPolicy->configure(*properties);
@@ -411,6 +435,12 @@ void ActiveMQConnectionFactory::configureConnection(ActiveMQConnection* connecti
     connection->setUseRetroactiveConsumer(this->settings->useRetroactiveConsumer);
     connection->setNonBlockingRedelivery(this->settings->nonBlockingRedelivery);
     connection->setConsumerFailoverRedeliveryWaitPeriod(this->settings->consumerFailoverRedeliveryWaitPeriod);
+    connection->setSessionThreadAffinity(this->settings->sessionThreadAffinity);
+    connection->setConsumerBusyPollTime(this->settings->consumerBusyPollTime);
+    connection->setMessageTraceSampleRate(this->settings->messageTraceSampleRate);
+    connection->setAdaptivePrefetch(this->settings->adaptivePrefetch);
+    connection->setAdaptivePrefetchTargetLatency(this->settings->adaptivePrefetchTargetLatency);
+    connection->setMaxPendingCommits(this->settings->maxPendingCommits);
 
     if (this->settings->defaultListener) {
         connection->setExceptionListener(this->settings->defaultListener);
@@ -713,6 +743,66 @@ void ActiveMQConnectionFactory::setConsumerFailoverRedeliveryWaitPeriod(long lon
     this->settings->consumerFailoverRedeliveryWaitPeriod = value;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+std::string ActiveMQConnectionFactory::getSessionThreadAffinity() const {
+    return this->settings->sessionThreadAffinity;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setSessionThreadAffinity(const std::string& value) {
+    this->settings->sessionThreadAffinity = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long ActiveMQConnectionFactory::getConsumerBusyPollTime() const {
+    return this->settings->consumerBusyPollTime;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setConsumerBusyPollTime(long long value) {
+    this->settings->consumerBusyPollTime = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQConnectionFactory::getMessageTraceSampleRate() const {
+    return this->settings->messageTraceSampleRate;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setMessageTraceSampleRate(int value) {
+    this->settings->messageTraceSampleRate = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnectionFactory::isAdaptivePrefetch() const {
+    return this->settings->adaptivePrefetch;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setAdaptivePrefetch(bool value) {
+    this->settings->adaptivePrefetch = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long ActiveMQConnectionFactory::getAdaptivePrefetchTargetLatency() const {
+    return this->settings->adaptivePrefetchTargetLatency;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setAdaptivePrefetchTargetLatency(long long value) {
+    this->settings->adaptivePrefetchTargetLatency = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQConnectionFactory::getMaxPendingCommits() const {
+    return this->settings->maxPendingCommits;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setMaxPendingCommits(int value) {
+    this->settings->maxPendingCommits = value;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool ActiveMQConnectionFactory::isUseRetroactiveConsumer() const {
     return this->settings->useRetroactiveConsumer;
@@ -591,6 +591,112 @@ namespace core{
          */
         void setConsumerFailoverRedeliveryWaitPeriod(long long value);
 
+        /**
+         * Gets the processor placement applied to the dispatch thread of each Session
+         * created from this factory's Connections.
+         *
+         * @returns the placement string, empty if Session threads are not placed.
+         */
+        std::string getSessionThreadAffinity() const;
+
+        /**
+         * Sets the processor placement applied to the dispatch thread of each Session, the
+         * value is either a list of processors such as "0,2,4-7" or a NUMA node given as
+         * "node:1".  An empty value leaves the threads to the operating system.
+         *
+         * @param value
+         *      The placement string to apply.
+         */
+        void setSessionThreadAffinity(const std::string& value);
+
+        /**
+         * Gets the time in microseconds that a synchronous receive on a new Consumer spins
+         * waiting for a Message before it blocks.
+         *
+         * @returns the busy poll time in microseconds, zero if spinning is disabled.
+         */
+        long long getConsumerBusyPollTime() const;
+
+        /**
+         * Sets the time in microseconds that a synchronous receive on a new Consumer spins
+         * waiting for a Message before it blocks.  Spinning burns a processor while the
+         * receive waits but avoids a thread wake-up for Messages that arrive in time.
+         *
+         * @param value
+         *      The busy poll time in microseconds, zero or less disables spinning.
+         */
+        void setConsumerBusyPollTime(long long value);
+
+        /**
+         * Gets the rate at which a new Connection's Messages are sampled for latency tracing, one
+         * in every N Messages is traced.
+         *
+         * @returns the trace sample rate, zero if tracing is disabled.
+         */
+        int getMessageTraceSampleRate() const;
+
+        /**
+         * Sets the rate at which a new Connection's Messages are sampled for latency tracing, one
+         * in every N Messages is traced.  A sampled Message records the time at which it
+         * passes each stage of the send and dispatch pipeline.
+         *
+         * @param value
+         *      The trace sample rate, zero or less disables tracing.
+         */
+        void setMessageTraceSampleRate(int value);
+
+        /**
+         * @returns true if a new Connection's Consumers adapt their prefetch size to the rate at which they
+         *          consume Messages.
+         */
+        bool isAdaptivePrefetch() const;
+
+        /**
+         * Sets whether a new Connection's Consumers adapt their prefetch size to the rate at which they consume
+         * Messages.  An adaptive Consumer starts at its configured prefetch size and then asks
+         * the Broker for a smaller or larger window, never above the configured size, so that
+         * the Messages it holds take about the target latency to consume.  The ack batch size
+         * follows the adapted prefetch size.
+         *
+         * @param value
+         *      True to enable adaptive prefetch.
+         */
+        void setAdaptivePrefetch(bool value);
+
+        /**
+         * Gets the time in milliseconds that the Messages prefetched by an adaptive Consumer
+         * should wait before they are consumed.
+         *
+         * @returns the adaptive prefetch target latency in milliseconds.
+         */
+        long long getAdaptivePrefetchTargetLatency() const;
+
+        /**
+         * Sets the time in milliseconds that the Messages prefetched by an adaptive Consumer
+         * should wait before they are consumed.
+         *
+         * @param value
+         *      The adaptive prefetch target latency in milliseconds.
+         */
+        void setAdaptivePrefetchTargetLatency(long long value);
+
+        /**
+         * Gets the maximum number of asynchronous commits that a new Connection allows to
+         * be awaiting a response from the Broker at once.
+         *
+         * @returns the maximum number of pending asynchronous commits.
+         */
+        int getMaxPendingCommits() const;
+
+        /**
+         * Sets the maximum number of asynchronous commits that a new Connection allows to
+         * be awaiting a response from the Broker at once.
+         *
+         * @param value
+         *      The maximum number of pending asynchronous commits, must be at least one.
+         */
+        void setMaxPendingCommits(int value);
+
         /**
          * @return true if optimizeAcknowledge is enabled.
          */
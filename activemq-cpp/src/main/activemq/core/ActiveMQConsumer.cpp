@@ -149,6 +149,15 @@ cms::Message* ActiveMQConsumer::receiveNoWait() {
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
 
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQConsumer::receiveBatch(std::vector<cms::Message*>& messages, int maxMessages, int millisecs) {
+
+    try {
+        return this->config->kernel->receiveBatch(messages, maxMessages, millisecs);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQConsumer::setMessageListener(cms::MessageListener* listener) {
 
@@ -227,3 +236,23 @@ bool ActiveMQConsumer::isOptimizeAcknowledge() const {
 void ActiveMQConsumer::setOptimizeAcknowledge(bool value) {
     this->config->kernel->setOptimizeAcknowledge(value);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+long long ActiveMQConsumer::getBusyPollTime() const {
+    return this->config->kernel->getBusyPollTime();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConsumer::setBusyPollTime(long long value) {
+    this->config->kernel->setBusyPollTime(value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long ActiveMQConsumer::getBusyPollSpinCount() const {
+    return this->config->kernel->getBusyPollSpinCount();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long ActiveMQConsumer::getBusyPollWaitCount() const {
+    return this->config->kernel->getBusyPollWaitCount();
+}
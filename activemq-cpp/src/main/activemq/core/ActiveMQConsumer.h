@@ -29,6 +29,8 @@
 
 #include <decaf/lang/Pointer.h>
 
+#include <vector>
+
 namespace activemq{
 namespace core{
 
@@ -90,6 +92,30 @@ namespace core{
 
     public:
 
+        /**
+         * Synchronously Receive up to maxMessages Messages in one call.  The wait for the
+         * first Message is bounded by the millisecs value, a value of zero means don't wait
+         * and a negative value means wait until a Message arrives or the consumer is closed.
+         * Once the first Message arrives any other Messages that are already available are
+         * returned along with it and the whole batch is acknowledged at once rather than
+         * each Message individually.
+         *
+         * The received messages are appended to the given vector, the caller owns them and
+         * must delete them.
+         *
+         * @param messages
+         *      The vector that the received messages are appended to.
+         * @param maxMessages
+         *      The maximum number of messages to receive, must be greater than zero.
+         * @param millisecs
+         *      The time to wait for the first message to arrive.
+         *
+         * @return the number of messages that were appended to the vector.
+         *
+         * @throws CMSException - If an internal error occurs.
+         */
+        int receiveBatch(std::vector<cms::Message*>& messages, int maxMessages, int millisecs);
+
         /**
          * Get the Consumer information for this consumer
          * @return Reference to a Consumer Info Object
@@ -170,6 +196,34 @@ namespace core{
          */
         void setOptimizeAcknowledge(bool value);
 
+        /**
+         * Gets the time in microseconds that a synchronous receive spins waiting for a
+         * Message before it blocks, zero means the receive blocks right away.
+         *
+         * @returns the busy poll time in microseconds.
+         */
+        long long getBusyPollTime() const;
+
+        /**
+         * Sets the time in microseconds that a synchronous receive spins waiting for a
+         * Message before it blocks.  Spinning trades a processor for lower latency since
+         * a Message that arrives while spinning is received without waking the thread.
+         *
+         * @param value
+         *      The busy poll time in microseconds, zero or less disables spinning.
+         */
+        void setBusyPollTime(long long value);
+
+        /**
+         * @returns the number of receives that got a Message while spinning.
+         */
+        long long getBusyPollSpinCount() const;
+
+        /**
+         * @returns the number of receives whose spin ran out and had to block.
+         */
+        long long getBusyPollWaitCount() const;
+
     };
 
 }}
@@ -0,0 +1,216 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ActiveMQInputStream.h"
+
+#include <activemq/exceptions/ActiveMQException.h>
+
+#include <decaf/io/IOException.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/lang/exceptions/IndexOutOfBoundsException.h>
+#include <decaf/lang/exceptions/ClassCastException.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::exceptions;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+ActiveMQInputStream::ActiveMQInputStream(cms::Connection* connection, const cms::Destination* destination,
+                                         const std::string& selector, int timeout) :
+    InputStream(), session(), consumer(), chunk(), groupId(), timeout(timeout),
+    remaining(0), sequence(0), endOfStream(false), closed(false) {
+
+    if (connection == NULL || destination == NULL) {
+        throw NullPointerException(__FILE__, __LINE__, "Connection and Destination cannot be NULL");
+    }
+
+    try {
+        this->session.reset(connection->createSession(cms::Session::AUTO_ACKNOWLEDGE));
+        this->consumer.reset(this->session->createConsumer(destination, selector));
+    } catch (cms::CMSException& ex) {
+        throw IOException(__FILE__, __LINE__, ex.clone(), "Could not create the stream's consumer: %s", ex.getMessage().c_str());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ActiveMQInputStream::~ActiveMQInputStream() {
+    try {
+        close();
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQInputStream::close() {
+
+    if (this->closed) {
+        return;
+    }
+
+    this->closed = true;
+    this->chunk.reset(NULL);
+    this->remaining = 0;
+
+    try {
+        this->consumer->close();
+        this->session->close();
+    } catch (cms::CMSException& ex) {
+        throw IOException(__FILE__, __LINE__, ex.clone(), "Could not close the stream: %s", ex.getMessage().c_str());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQInputStream::available() const {
+    return this->closed ? 0 : this->remaining;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQInputStream::doReadByte() {
+
+    try {
+
+        checkClosed();
+
+        if (!nextChunk()) {
+            return -1;
+        }
+
+        unsigned char value = 0;
+        this->chunk->readBytes(&value, 1);
+        this->remaining--;
+
+        return value;
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    DECAF_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQInputStream::doReadArrayBounded(unsigned char* buffer, int size, int offset, int length) {
+
+    try {
+
+        if (length == 0) {
+            return 0;
+        }
+
+        if (buffer == NULL) {
+            throw NullPointerException(__FILE__, __LINE__, "ActiveMQInputStream::read - Buffer passed is Null");
+        }
+
+        if (size < 0) {
+            throw IndexOutOfBoundsException(__FILE__, __LINE__, "size parameter out of Bounds: %d.", size);
+        }
+
+        if (offset > size || offset < 0) {
+            throw IndexOutOfBoundsException(__FILE__, __LINE__, "offset parameter out of Bounds: %d.", offset);
+        }
+
+        if (length < 0 || length > size - offset) {
+            throw IndexOutOfBoundsException(__FILE__, __LINE__, "length parameter out of Bounds: %d.", length);
+        }
+
+        checkClosed();
+
+        if (!nextChunk()) {
+            return -1;
+        }
+
+        // Only what is left of the current chunk is returned so that a read never
+        // blocks once some bytes are available.
+        int count = this->chunk->readBytes(buffer + offset, length < this->remaining ? length : this->remaining);
+        this->remaining -= count;
+
+        return count;
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_RETHROW(NullPointerException)
+    DECAF_CATCH_RETHROW(IndexOutOfBoundsException)
+    DECAF_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    DECAF_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQInputStream::nextChunk() {
+
+    try {
+
+        while (this->remaining == 0) {
+
+            // The spent chunk is released before waiting for the next one.
+            this->chunk.reset(NULL);
+
+            if (this->endOfStream) {
+                return false;
+            }
+
+            Pointer<cms::Message> message(this->timeout < 0 ?
+                this->consumer->receive() : this->consumer->receive(this->timeout));
+
+            if (message == NULL) {
+                throw IOException(__FILE__, __LINE__, "No stream chunk was received from the Destination");
+            }
+
+            if (!message->propertyExists("JMSXGroupID") || !message->propertyExists("JMSXGroupSeq")) {
+                throw IOException(__FILE__, __LINE__, "Received a message that is not a stream chunk");
+            }
+
+            std::string group = message->getStringProperty("JMSXGroupID");
+            int groupSequence = message->getIntProperty("JMSXGroupSeq");
+
+            if (this->groupId.empty()) {
+                this->groupId = group;
+            } else if (group != this->groupId) {
+                throw IOException(__FILE__, __LINE__, "Received a chunk of stream %s while reading stream %s",
+                                  group.c_str(), this->groupId.c_str());
+            }
+
+            if (groupSequence == -1) {
+                this->endOfStream = true;
+                continue;
+            }
+
+            if (groupSequence != this->sequence + 1) {
+                throw IOException(__FILE__, __LINE__, "Received chunk %d of stream %s when chunk %d was expected",
+                                  groupSequence, group.c_str(), this->sequence + 1);
+            }
+
+            this->chunk = message.dynamicCast<cms::BytesMessage>();
+            this->remaining = this->chunk->getBodyLength();
+            this->sequence = groupSequence;
+        }
+
+        return true;
+    } catch (cms::CMSException& ex) {
+        throw IOException(__FILE__, __LINE__, ex.clone(), "Could not receive a stream chunk: %s", ex.getMessage().c_str());
+    } catch (ClassCastException&) {
+        throw IOException(__FILE__, __LINE__, "Received a stream chunk that is not a BytesMessage");
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQInputStream::checkClosed() const {
+    if (this->closed) {
+        throw IOException(__FILE__, __LINE__, "ActiveMQInputStream::read - Stream is closed");
+    }
+}
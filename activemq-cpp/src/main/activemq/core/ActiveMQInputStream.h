@@ -0,0 +1,137 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CORE_ACTIVEMQINPUTSTREAM_H_
+#define _ACTIVEMQ_CORE_ACTIVEMQINPUTSTREAM_H_
+
+#include <activemq/util/Config.h>
+
+#include <cms/Connection.h>
+#include <cms/Destination.h>
+#include <cms/Session.h>
+#include <cms/MessageConsumer.h>
+#include <cms/BytesMessage.h>
+
+#include <decaf/io/InputStream.h>
+#include <decaf/lang/Pointer.h>
+
+#include <string>
+
+namespace activemq {
+namespace core {
+
+    using decaf::lang::Pointer;
+
+    /**
+     * An InputStream that reassembles the chunks sent by an ActiveMQOutputStream.  Chunks
+     * are received one at a time as the stream is read, so only the current chunk and the
+     * chunks in the consumer's prefetch are held in memory, and a reader that falls behind
+     * stops the Broker from dispatching more until it catches up.  The memory used is
+     * therefore bounded by the prefetch size times the sender's chunk size whatever the
+     * size of the payload.
+     *
+     * The stream reads the first stream that arrives on the Destination and expects its
+     * chunks in order, a chunk from another group or a gap in the sequence is reported as
+     * an IOException.  Streams that share a Destination are kept apart with a selector
+     * on JMSXGroupID.  The stream receives on a Session of its own that it creates from
+     * the given Connection and closes when the stream is closed.
+     *
+     * This class is not thread safe.
+     *
+     * @since 3.8
+     */
+    class AMQCPP_API ActiveMQInputStream : public decaf::io::InputStream {
+    private:
+
+        Pointer<cms::Session> session;
+        Pointer<cms::MessageConsumer> consumer;
+        Pointer<cms::BytesMessage> chunk;
+        std::string groupId;
+        int timeout;
+        int remaining;
+        int sequence;
+        bool endOfStream;
+        bool closed;
+
+    private:
+
+        ActiveMQInputStream(const ActiveMQInputStream&);
+        ActiveMQInputStream& operator=(const ActiveMQInputStream&);
+
+    public:
+
+        /**
+         * Creates a new stream that receives from the given Destination.
+         *
+         * @param connection
+         *      The Connection to create the stream's Session from.
+         * @param destination
+         *      The Destination the chunks are sent to.
+         * @param selector
+         *      The selector for the stream's consumer, empty to read the first stream.
+         * @param timeout
+         *      The time in milliseconds to wait for each chunk, negative to wait forever.
+         *
+         * @throws NullPointerException if the connection or destination is NULL.
+         * @throws IOException if the Session or consumer can't be created.
+         */
+        ActiveMQInputStream(cms::Connection* connection, const cms::Destination* destination,
+                            const std::string& selector = "", int timeout = -1);
+
+        virtual ~ActiveMQInputStream();
+
+        /**
+         * Closes the stream's consumer and Session, chunks that are still in the prefetch
+         * are redelivered to other consumers.  Does nothing if the stream is already closed.
+         *
+         * @throws IOException if the consumer or Session can't be closed.
+         */
+        virtual void close();
+
+        /**
+         * @return the number of bytes left in the current chunk, these can be read
+         *         without waiting.
+         */
+        virtual int available() const;
+
+        /**
+         * @return the JMSXGroupID of the stream being read, empty until the first
+         *         chunk arrives.
+         */
+        const std::string& getGroupId() const {
+            return this->groupId;
+        }
+
+    protected:
+
+        virtual int doReadByte();
+
+        virtual int doReadArrayBounded(unsigned char* buffer, int size, int offset, int length);
+
+    private:
+
+        // Makes sure the current chunk has bytes left, receiving chunks as needed,
+        // returns false once the end of the stream has been reached.
+        bool nextChunk();
+
+        void checkClosed() const;
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_CORE_ACTIVEMQINPUTSTREAM_H_ */
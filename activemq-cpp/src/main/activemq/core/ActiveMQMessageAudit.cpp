@@ -17,6 +17,7 @@
 
 #include "ActiveMQMessageAudit.h"
 
+#include <activemq/util/CompactId.h>
 #include <activemq/util/IdGenerator.h>
 #include <activemq/exceptions/ActiveMQException.h>
 #include <activemq/commands/ProducerId.h>
@@ -58,19 +59,25 @@ namespace core {
         int maximumNumberOfProducersToTrack;
         Mutex mutex;
 
+        // Keyed by the seed of a string message id.
         LRUCache<std::string, Pointer<BitSet> > map;
 
+        // Keyed by the CompactId of the producer for MessageId and ProducerId lookups.
+        LRUCache<CompactId, Pointer<BitSet> > producers;
+
         MessageAuditImpl() : auditDepth(2048),
                              maximumNumberOfProducersToTrack(64),
                              mutex(),
-                             map() {
+                             map(),
+                             producers() {
         }
 
         MessageAuditImpl(int auditDepth, int maximumNumberOfProducersToTrack) :
             auditDepth(auditDepth),
             maximumNumberOfProducersToTrack(maximumNumberOfProducersToTrack),
             mutex(),
-            map() {
+            map(),
+            producers() {
         }
 
         void adjustMaxProducersToTrack(int value) {
@@ -83,8 +90,14 @@ namespace core {
                 newMap.putAll(this->map);
                 this->map.clear();
                 this->map.putAll(newMap);
+
+                LRUCache<CompactId, Pointer<BitSet> > newProducers(0, value, 0.75f, true);
+                newProducers.putAll(this->producers);
+                this->producers.clear();
+                this->producers.putAll(newProducers);
             }
             this->map.setMaxCacheSize(value);
+            this->producers.setMaxCacheSize(value);
             this->maximumNumberOfProducersToTrack = value;
         }
     };
@@ -168,30 +181,28 @@ bool ActiveMQMessageAudit::isDuplicate(decaf::lang::Pointer<MessageId> msgId) co
     if (msgId != NULL) {
         Pointer<ProducerId> pid = msgId->getProducerId();
         if (pid != NULL) {
-            std::string seed = pid->toString();
-            if (!seed.empty()) {
+            CompactId producer = pid->getCompactId();
 
-                synchronized(&this->impl->mutex) {
+            synchronized(&this->impl->mutex) {
 
-                    Pointer<BitSet> bits;
-                    try {
-                        bits = this->impl->map.get(seed);
-                    } catch (NoSuchElementException& ex) {
-                        bits.reset(new BitSet(this->impl->auditDepth));
-                        this->impl->map.put(seed, bits);
-                    }
+                Pointer<BitSet> bits;
+                try {
+                    bits = this->impl->producers.get(producer);
+                } catch (NoSuchElementException& ex) {
+                    bits.reset(new BitSet(this->impl->auditDepth));
+                    this->impl->producers.put(producer, bits);
+                }
 
-                    long long index = msgId->getProducerSequenceId();
-                    if (index >= 0) {
-                        int scaledIndex = (int) index;
-                        if (index > Integer::MAX_VALUE) {
-                            scaledIndex = (int)(index - Integer::MAX_VALUE);
-                        }
+                long long index = msgId->getProducerSequenceId();
+                if (index >= 0) {
+                    int scaledIndex = (int) index;
+                    if (index > Integer::MAX_VALUE) {
+                        scaledIndex = (int)(index - Integer::MAX_VALUE);
+                    }
 
-                        answer = bits->get(scaledIndex);
-                        if (!answer) {
-                            bits->set(scaledIndex, true);
-                        }
+                    answer = bits->get(scaledIndex);
+                    if (!answer) {
+                        bits->set(scaledIndex, true);
                     }
                 }
             }
@@ -233,27 +244,25 @@ void ActiveMQMessageAudit::rollback(decaf::lang::Pointer<commands::MessageId> ms
     if (msgId != NULL) {
         Pointer<ProducerId> pid = msgId->getProducerId();
         if (pid != NULL) {
-            std::string seed = pid->toString();
-            if (!seed.empty()) {
-
-                synchronized(&this->impl->mutex) {
+            CompactId producer = pid->getCompactId();
 
-                    Pointer<BitSet> bits;
-                    try {
-                        bits = this->impl->map.get(seed);
-                    } catch (NoSuchElementException& ex) {
-                    }
+            synchronized(&this->impl->mutex) {
 
-                    if (bits != NULL) {
-                        long long index = msgId->getProducerSequenceId();
-                        if (index >= 0) {
-                            int scaledIndex = (int) index;
-                            if (index > Integer::MAX_VALUE) {
-                                scaledIndex = (int)(index - Integer::MAX_VALUE);
-                            }
+                Pointer<BitSet> bits;
+                try {
+                    bits = this->impl->producers.get(producer);
+                } catch (NoSuchElementException& ex) {
+                }
 
-                            bits->set(scaledIndex, false);
+                if (bits != NULL) {
+                    long long index = msgId->getProducerSequenceId();
+                    if (index >= 0) {
+                        int scaledIndex = (int) index;
+                        if (index > Integer::MAX_VALUE) {
+                            scaledIndex = (int)(index - Integer::MAX_VALUE);
                         }
+
+                        bits->set(scaledIndex, false);
                     }
                 }
             }
@@ -302,27 +311,25 @@ bool ActiveMQMessageAudit::isInOrder(decaf::lang::Pointer<commands::MessageId> m
     if (msgId != NULL) {
         Pointer<ProducerId> pid = msgId->getProducerId();
         if (pid != NULL) {
-            std::string seed = pid->toString();
-            if (!seed.empty()) {
+            CompactId producer = pid->getCompactId();
 
-                synchronized(&this->impl->mutex) {
+            synchronized(&this->impl->mutex) {
 
-                    Pointer<BitSet> bits;
-                    try {
-                        bits = this->impl->map.get(seed);
-                    } catch (NoSuchElementException& ex) {
-                        bits.reset(new BitSet(this->impl->auditDepth));
-                        this->impl->map.put(seed, bits);
-                    }
+                Pointer<BitSet> bits;
+                try {
+                    bits = this->impl->producers.get(producer);
+                } catch (NoSuchElementException& ex) {
+                    bits.reset(new BitSet(this->impl->auditDepth));
+                    this->impl->producers.put(producer, bits);
+                }
 
-                    long long index = msgId->getProducerSequenceId();
-                    if (index >= 0) {
-                        int scaledIndex = (int) index;
-                        if (index > Integer::MAX_VALUE) {
-                            scaledIndex = (int)(index - Integer::MAX_VALUE);
-                        }
-                        answer = ((bits->length() - 1) == scaledIndex);
+                long long index = msgId->getProducerSequenceId();
+                if (index >= 0) {
+                    int scaledIndex = (int) index;
+                    if (index > Integer::MAX_VALUE) {
+                        scaledIndex = (int)(index - Integer::MAX_VALUE);
                     }
+                    answer = ((bits->length() - 1) == scaledIndex);
                 }
             }
         }
@@ -334,20 +341,18 @@ bool ActiveMQMessageAudit::isInOrder(decaf::lang::Pointer<commands::MessageId> m
 long long ActiveMQMessageAudit::getLastSeqId(decaf::lang::Pointer<commands::ProducerId> id) const {
     long result = -1;
     if (id != NULL) {
-        std::string seed = id->toString();
-        if (!seed.empty()) {
+        CompactId producer = id->getCompactId();
 
-            synchronized(&this->impl->mutex) {
+        synchronized(&this->impl->mutex) {
 
-                Pointer<BitSet> bits;
-                try {
-                    bits = this->impl->map.get(seed);
-                } catch (NoSuchElementException& ex) {
-                }
+            Pointer<BitSet> bits;
+            try {
+                bits = this->impl->producers.get(producer);
+            } catch (NoSuchElementException& ex) {
+            }
 
-                if (bits != NULL) {
-                    result = bits->length() - 1;
-                }
+            if (bits != NULL) {
+                result = bits->length() - 1;
             }
         }
     }
@@ -357,4 +362,5 @@ long long ActiveMQMessageAudit::getLastSeqId(decaf::lang::Pointer<commands::Prod
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQMessageAudit::clear() {
     this->impl->map.clear();
+    this->impl->producers.clear();
 }
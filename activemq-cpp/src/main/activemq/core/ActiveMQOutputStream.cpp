@@ -0,0 +1,230 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ActiveMQOutputStream.h"
+
+#include <activemq/exceptions/ActiveMQException.h>
+#include <activemq/util/IdGenerator.h>
+
+#include <cms/BytesMessage.h>
+
+#include <decaf/io/IOException.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/lang/exceptions/IndexOutOfBoundsException.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::exceptions;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+const int ActiveMQOutputStream::DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    activemq::util::IdGenerator STREAM_ID_GENERATOR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ActiveMQOutputStream::ActiveMQOutputStream(cms::Connection* connection, const cms::Destination* destination, int chunkSize) :
+    OutputStream(), session(), producer(), groupId(), buffer(), chunkSize(chunkSize), sequence(0), closed(false) {
+
+    if (connection == NULL || destination == NULL) {
+        throw NullPointerException(__FILE__, __LINE__, "Connection and Destination cannot be NULL");
+    }
+
+    if (chunkSize <= 0) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Chunk size must be greater than zero: %d", chunkSize);
+    }
+
+    try {
+        this->session.reset(connection->createSession(cms::Session::AUTO_ACKNOWLEDGE));
+        this->producer.reset(this->session->createProducer(destination));
+    } catch (cms::CMSException& ex) {
+        throw IOException(__FILE__, __LINE__, ex.clone(), "Could not create the stream's producer: %s", ex.getMessage().c_str());
+    }
+
+    this->groupId = STREAM_ID_GENERATOR.generateId();
+    this->buffer.reserve(chunkSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ActiveMQOutputStream::~ActiveMQOutputStream() {
+    try {
+        close();
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQOutputStream::close() {
+
+    if (this->closed) {
+        return;
+    }
+
+    // Marked first so that a failed send isn't retried when the stream is destroyed,
+    // the Session is then closed when it is deleted.
+    this->closed = true;
+
+    try {
+
+        if (!this->buffer.empty()) {
+            sendChunk(&this->buffer[0], (int) this->buffer.size(), this->sequence + 1);
+            this->buffer.clear();
+        }
+
+        // The end of stream marker, a sequence of -1 also closes the group on the Broker.
+        sendChunk(NULL, 0, -1);
+
+        this->producer->close();
+        this->session->close();
+    } catch (cms::CMSException& ex) {
+        throw IOException(__FILE__, __LINE__, ex.clone(), "Could not close the stream: %s", ex.getMessage().c_str());
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    DECAF_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQOutputStream::flush() {
+
+    try {
+
+        checkClosed();
+
+        if (!this->buffer.empty()) {
+            sendChunk(&this->buffer[0], (int) this->buffer.size(), this->sequence + 1);
+            this->buffer.clear();
+        }
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    DECAF_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQOutputStream::doWriteByte(unsigned char value) {
+
+    try {
+
+        checkClosed();
+
+        this->buffer.push_back(value);
+        if ((int) this->buffer.size() == this->chunkSize) {
+            sendChunk(&this->buffer[0], this->chunkSize, this->sequence + 1);
+            this->buffer.clear();
+        }
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    DECAF_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQOutputStream::doWriteArrayBounded(const unsigned char* buffer, int size, int offset, int length) {
+
+    try {
+
+        if (length == 0) {
+            return;
+        }
+
+        if (buffer == NULL) {
+            throw NullPointerException(__FILE__, __LINE__, "ActiveMQOutputStream::write - passed buffer is null");
+        }
+
+        if (size < 0) {
+            throw IndexOutOfBoundsException(__FILE__, __LINE__, "size parameter out of Bounds: %d.", size);
+        }
+
+        if (offset > size || offset < 0) {
+            throw IndexOutOfBoundsException(__FILE__, __LINE__, "offset parameter out of Bounds: %d.", offset);
+        }
+
+        if (length < 0 || length > size - offset) {
+            throw IndexOutOfBoundsException(__FILE__, __LINE__, "length parameter out of Bounds: %d.", length);
+        }
+
+        checkClosed();
+
+        const unsigned char* data = buffer + offset;
+        while (length > 0) {
+
+            // Whole chunks are sent straight from the caller's array when nothing
+            // is buffered ahead of them.
+            if (this->buffer.empty() && length >= this->chunkSize) {
+                sendChunk(data, this->chunkSize, this->sequence + 1);
+                data += this->chunkSize;
+                length -= this->chunkSize;
+                continue;
+            }
+
+            int count = std::min(length, this->chunkSize - (int) this->buffer.size());
+            this->buffer.insert(this->buffer.end(), data, data + count);
+            data += count;
+            length -= count;
+
+            if ((int) this->buffer.size() == this->chunkSize) {
+                sendChunk(&this->buffer[0], this->chunkSize, this->sequence + 1);
+                this->buffer.clear();
+            }
+        }
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_RETHROW(NullPointerException)
+    DECAF_CATCH_RETHROW(IndexOutOfBoundsException)
+    DECAF_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    DECAF_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQOutputStream::sendChunk(const unsigned char* data, int length, int groupSequence) {
+
+    try {
+
+        Pointer<cms::BytesMessage> message(length > 0 ?
+            this->session->createBytesMessage(data, length) : this->session->createBytesMessage());
+
+        message->setStringProperty("JMSXGroupID", this->groupId);
+        message->setIntProperty("JMSXGroupSeq", groupSequence);
+
+        this->producer->send(message.get());
+
+        if (groupSequence > 0) {
+            this->sequence = groupSequence;
+        }
+    } catch (cms::CMSException& ex) {
+        throw IOException(__FILE__, __LINE__, ex.clone(), "Could not send a stream chunk: %s", ex.getMessage().c_str());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQOutputStream::checkClosed() const {
+    if (this->closed) {
+        throw IOException(__FILE__, __LINE__, "ActiveMQOutputStream::write - Stream is closed");
+    }
+}
@@ -0,0 +1,151 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CORE_ACTIVEMQOUTPUTSTREAM_H_
+#define _ACTIVEMQ_CORE_ACTIVEMQOUTPUTSTREAM_H_
+
+#include <activemq/util/Config.h>
+
+#include <cms/Connection.h>
+#include <cms/Destination.h>
+#include <cms/Session.h>
+#include <cms/MessageProducer.h>
+
+#include <decaf/io/OutputStream.h>
+#include <decaf/lang/Pointer.h>
+
+#include <string>
+#include <vector>
+
+namespace activemq {
+namespace core {
+
+    using decaf::lang::Pointer;
+
+    /**
+     * An OutputStream that sends the bytes written to it to a Destination as a sequence
+     * of BytesMessages of at most the chunk size, so that a payload of any size can be
+     * sent while only one chunk is held in memory.  The chunks form a message group, each
+     * carries the stream's JMSXGroupID and its position in the stream as JMSXGroupSeq
+     * starting from one, and closing the stream sends an empty chunk with a JMSXGroupSeq
+     * of -1 that marks the end of the stream and closes the group on the Broker.
+     *
+     * The stream sends on a Session of its own that it creates from the given Connection
+     * and closes when the stream is closed.  An ActiveMQInputStream on the same Destination
+     * reassembles the chunks on the receiving side.
+     *
+     * This class is not thread safe.
+     *
+     * @since 3.8
+     */
+    class AMQCPP_API ActiveMQOutputStream : public decaf::io::OutputStream {
+    public:
+
+        /**
+         * The chunk size used when none is given.
+         */
+        static const int DEFAULT_CHUNK_SIZE;
+
+    private:
+
+        Pointer<cms::Session> session;
+        Pointer<cms::MessageProducer> producer;
+        std::string groupId;
+        std::vector<unsigned char> buffer;
+        int chunkSize;
+        int sequence;
+        bool closed;
+
+    private:
+
+        ActiveMQOutputStream(const ActiveMQOutputStream&);
+        ActiveMQOutputStream& operator=(const ActiveMQOutputStream&);
+
+    public:
+
+        /**
+         * Creates a new stream that sends to the given Destination.
+         *
+         * @param connection
+         *      The Connection to create the stream's Session from.
+         * @param destination
+         *      The Destination to send the chunks to.
+         * @param chunkSize
+         *      The largest number of bytes sent in a single chunk.
+         *
+         * @throws NullPointerException if the connection or destination is NULL.
+         * @throws IllegalArgumentException if the chunk size is not greater than zero.
+         * @throws IOException if the Session or producer can't be created.
+         */
+        ActiveMQOutputStream(cms::Connection* connection, const cms::Destination* destination,
+                             int chunkSize = DEFAULT_CHUNK_SIZE);
+
+        virtual ~ActiveMQOutputStream();
+
+        /**
+         * Sends any buffered bytes and the end of stream marker and then closes the
+         * stream's producer and Session.  Does nothing if the stream is already closed.
+         *
+         * @throws IOException if the remaining chunks can't be sent.
+         */
+        virtual void close();
+
+        /**
+         * Sends any buffered bytes as a chunk without waiting for it to fill up.
+         *
+         * @throws IOException if the stream is closed or the chunk can't be sent.
+         */
+        virtual void flush();
+
+        /**
+         * @return the JMSXGroupID that all the chunks of this stream carry.
+         */
+        const std::string& getGroupId() const {
+            return this->groupId;
+        }
+
+        /**
+         * @return the largest number of bytes sent in a single chunk.
+         */
+        int getChunkSize() const {
+            return this->chunkSize;
+        }
+
+        /**
+         * @return the number of chunks sent so far.
+         */
+        int getChunksSent() const {
+            return this->sequence;
+        }
+
+    protected:
+
+        virtual void doWriteByte(unsigned char value);
+
+        virtual void doWriteArrayBounded(const unsigned char* buffer, int size, int offset, int length);
+
+    private:
+
+        void sendChunk(const unsigned char* data, int length, int groupSequence);
+
+        void checkClosed() const;
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_CORE_ACTIVEMQOUTPUTSTREAM_H_ */
@@ -128,3 +128,49 @@ void ActiveMQProducer::send(const cms::Destination* destination, cms::Message* m
     }
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQProducer::trySend(cms::Message* message) {
+
+    try {
+        return this->kernel->trySend(message);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQProducer::trySend(const cms::Destination* destination, cms::Message* message) {
+
+    try {
+        return this->kernel->trySend(destination, message);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ProducerMessageTemplate* ActiveMQProducer::createMessageTemplate(const cms::Message* prototype,
+                                                                 const std::vector<std::string>& variableProperties) {
+
+    try {
+        return this->kernel->createMessageTemplate(prototype, variableProperties);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQProducer::send(ProducerMessageTemplate* messageTemplate) {
+
+    try {
+        this->kernel->send(messageTemplate);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQProducer::send(ProducerMessageTemplate* messageTemplate, int deliveryMode, int priority, long long timeToLive) {
+
+    try {
+        this->kernel->send(messageTemplate, deliveryMode, priority, timeToLive);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
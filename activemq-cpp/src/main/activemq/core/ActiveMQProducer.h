@@ -25,6 +25,10 @@
 #include <activemq/util/Config.h>
 #include <activemq/commands/ProducerInfo.h>
 #include <activemq/core/kernels/ActiveMQProducerKernel.h>
+#include <activemq/core/ProducerMessageTemplate.h>
+
+#include <string>
+#include <vector>
 
 namespace activemq{
 namespace core{
@@ -206,6 +210,84 @@ namespace core{
         const Pointer<commands::ProducerId>& getProducerId() const {
             return this->kernel->getProducerId();
         }
+
+        /**
+         * Sends the Message to the default Destination of this Producer unless the send
+         * window of this Producer is full, in which case the method returns at once rather
+         * than waiting for the Broker to acknowledge earlier sends.
+         *
+         * @param message
+         *      The Message to send.
+         *
+         * @returns true if the Message was sent, false if the send window was full.
+         *
+         * @throws CMSException if an error occurs while sending the message.
+         */
+        bool trySend(cms::Message* message);
+
+        /**
+         * Sends the Message to the given Destination unless the send window of this Producer
+         * is full, in which case the method returns at once rather than waiting for the Broker
+         * to acknowledge earlier sends.
+         *
+         * @param destination
+         *      The Destination to send the Message to.
+         * @param message
+         *      The Message to send.
+         *
+         * @returns true if the Message was sent, false if the send window was full.
+         *
+         * @throws CMSException if an error occurs while sending the message.
+         */
+        bool trySend(const cms::Destination* destination, cms::Message* message);
+
+        /**
+         * Creates a template for sending Messages that differ from the prototype only in
+         * the named properties and their body.  The prototype's headers and the rest of
+         * its properties are encoded once, each send of the template then only encodes
+         * the variable properties and the body while producing the same Message as
+         * sending the prototype with those values set would.
+         *
+         * @param prototype
+         *      The Message whose headers, properties and body the template starts from.
+         * @param variableProperties
+         *      The names of the properties that are set on the template for each send.
+         *
+         * @returns a new template which the caller owns.
+         *
+         * @throws CMSException if the template can't be created.
+         */
+        ProducerMessageTemplate* createMessageTemplate(const cms::Message* prototype,
+                                                       const std::vector<std::string>& variableProperties);
+
+        /**
+         * Sends the next Message of the template to the default Destination of this
+         * Producer using the default delivery mode, priority and time to live.
+         *
+         * @param messageTemplate
+         *      The template that creates the Message to send.
+         *
+         * @throws CMSException if an error occurs while sending the message.
+         * @throws UnsupportedOperationException if this Producer has no default Destination.
+         */
+        void send(ProducerMessageTemplate* messageTemplate);
+
+        /**
+         * Sends the next Message of the template to the default Destination of this Producer.
+         *
+         * @param messageTemplate
+         *      The template that creates the Message to send.
+         * @param deliveryMode
+         *      The delivery mode to be used.
+         * @param priority
+         *      The priority for this message.
+         * @param timeToLive
+         *      The time to live value for this message in milliseconds.
+         *
+         * @throws CMSException if an error occurs while sending the message.
+         * @throws UnsupportedOperationException if this Producer has no default Destination.
+         */
+        void send(ProducerMessageTemplate* messageTemplate, int deliveryMode, int priority, long long timeToLive);
    };
 
 }}
@@ -72,6 +72,14 @@ void ActiveMQSession::commit() {
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSession::commit(cms::AsyncCallback* onComplete) {
+    try {
+        this->kernel->commit(onComplete);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQSession::rollback() {
     try {
@@ -121,6 +129,17 @@ cms::MessageConsumer* ActiveMQSession::createDurableConsumer(const cms::Topic* d
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
 
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQSession::createConsumers(const std::vector<const cms::Destination*>& destinations,
+                                     const std::string& selector, bool noLocal,
+                                     std::vector<cms::MessageConsumer*>& consumers,
+                                     std::vector< Pointer<cms::CMSException> >& errors) {
+    try {
+        return this->kernel->createConsumers(destinations, selector, noLocal, consumers, errors);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 cms::MessageProducer* ActiveMQSession::createProducer(const cms::Destination* destination) {
     try {
@@ -18,6 +18,7 @@
 #define _ACTIVEMQ_CORE_ACTIVEMQSESSION_H_
 
 #include <cms/Session.h>
+#include <cms/AsyncCallback.h>
 #include <cms/ExceptionListener.h>
 
 #include <activemq/util/Config.h>
@@ -30,6 +31,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace activemq{
 namespace core{
@@ -73,6 +75,25 @@ namespace core{
             return this->kernel->isStarted();
         }
 
+        /**
+         * Commits all messages done in this transaction without waiting for the Broker to
+         * confirm the commit, the given callback is notified once the outcome is known.  The
+         * commit still waits for the outcome when the transaction consumed messages.
+         * Callbacks for the commits of this session are notified in the order the commits
+         * were made, a commit that could not be sent is reported to the callback as well.
+         *
+         * The callback is not owned by the session and must remain valid until it has been
+         * notified, it can be called from a provider thread and so must not block.  Passing
+         * NULL performs a normal blocking commit.
+         *
+         * @param onComplete
+         *      The callback to notify when the commit completes or fails.
+         *
+         * @throws CMSException - If an internal error occurs.
+         * @throws IllegalStateException - if the method is not called by a transacted session.
+         */
+        virtual void commit(cms::AsyncCallback* onComplete);
+
     public:   // Implements Methods
 
         virtual void close();
@@ -97,6 +118,31 @@ namespace core{
                                                             const std::string& selector,
                                                             bool noLocal = false);
 
+        /**
+         * Creates a MessageConsumer for each of the given destinations with the ConsumerInfo
+         * commands pipelined to the broker, see ActiveMQSessionKernel::createConsumers for
+         * the details of how results and per consumer errors are returned.
+         *
+         * @param destinations
+         *      The destinations to create the consumers on.
+         * @param selector
+         *      The message selector applied to each of the consumers.
+         * @param noLocal
+         *      If true, inhibits the delivery of messages published by this connection.
+         * @param consumers
+         *      The vector that receives the created consumers, NULL for each that failed.
+         * @param errors
+         *      The vector that receives the error for each consumer, NULL for each that succeeded.
+         *
+         * @return the number of consumers that were successfully created.
+         *
+         * @throws CMSException if the session is closed.
+         */
+        int createConsumers(const std::vector<const cms::Destination*>& destinations,
+                            const std::string& selector, bool noLocal,
+                            std::vector<cms::MessageConsumer*>& consumers,
+                            std::vector< Pointer<cms::CMSException> >& errors);
+
         virtual cms::MessageProducer* createProducer(const cms::Destination* destination);
 
         virtual cms::QueueBrowser* createBrowser(const cms::Queue* queue);
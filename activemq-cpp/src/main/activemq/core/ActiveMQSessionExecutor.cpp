@@ -22,7 +22,7 @@
 #include <activemq/core/kernels/ActiveMQSessionKernel.h>
 #include <activemq/core/ActiveMQSession.h>
 #include <activemq/core/FifoMessageDispatchChannel.h>
-#include <activemq/core/SimplePriorityMessageDispatchChannel.h>
+#include <activemq/core/PriorityMessageDispatchChannel.h>
 #include <activemq/commands/ConsumerInfo.h>
 #include <activemq/threads/DedicatedTaskRunner.h>
 
@@ -41,7 +41,7 @@ ActiveMQSessionExecutor::ActiveMQSessionExecutor(ActiveMQSessionKernel* session)
     session(session), messageQueue(), taskRunner() {
 
     if (this->session->getConnection()->isMessagePrioritySupported()) {
-        this->messageQueue.reset(new SimplePriorityMessageDispatchChannel());
+        this->messageQueue.reset(new PriorityMessageDispatchChannel());
     } else {
         this->messageQueue.reset(new FifoMessageDispatchChannel());
     }
@@ -100,7 +100,8 @@ void ActiveMQSessionExecutor::wakeup() {
     Pointer<TaskRunner> taskRunner;
     synchronized(messageQueue.get()) {
         if (this->taskRunner == NULL) {
-            this->taskRunner.reset(new DedicatedTaskRunner(this));
+            this->taskRunner.reset(new DedicatedTaskRunner(
+                this, this->session->getConnection()->getSessionThreadPlacement()));
             this->taskRunner->start();
         }
 
@@ -153,6 +154,11 @@ void ActiveMQSessionExecutor::dispatch(const Pointer<MessageDispatch>& dispatch)
         // If the consumer is not available, just ignore the message.
         // Otherwise, dispatch the message to the consumer.
         if (consumer != NULL) {
+            const commands::Message* message = dispatch->getMessage().get();
+            if (message != NULL && message->getTrace() != NULL) {
+                message->getTrace()->mark(metrics::MessageTrace::SESSION_DISPATCH);
+            }
+
             consumer->dispatch(dispatch);
         }
 
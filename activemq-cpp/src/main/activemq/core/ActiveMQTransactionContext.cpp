@@ -35,6 +35,8 @@
 #include <decaf/lang/Long.h>
 #include <decaf/util/Iterator.h>
 #include <decaf/util/concurrent/ConcurrentStlMap.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/lang/System.h>
 
 using namespace std;
 using namespace cms;
@@ -54,6 +56,107 @@ using namespace decaf::util::concurrent;
 namespace activemq{
 namespace core{
 
+    /**
+     * Tracks a commit that was sent without waiting for its response, the outcome is
+     * delivered from the Transport thread and then passed on to the callbacks.
+     */
+    class AsyncCommit : public cms::AsyncCallback {
+    private:
+
+        AsyncCommit(const AsyncCommit&);
+        AsyncCommit& operator=(const AsyncCommit&);
+
+    private:
+
+        mutable Mutex mutex;
+        cms::AsyncCallback* callback;
+        std::vector<cms::AsyncCallback*> followers;
+        bool completed;
+
+    public:
+
+        AsyncCommit(cms::AsyncCallback* callback) : mutex(), callback(callback), followers(), completed(false) {
+        }
+
+        virtual ~AsyncCommit() {}
+
+        virtual void onSuccess() {
+            complete(NULL);
+        }
+
+        virtual void onException(const cms::CMSException& ex) {
+            complete(&ex);
+        }
+
+        /**
+         * Adds a callback that is notified of success right after this commit's callback,
+         * returns false if this commit has already completed.
+         */
+        bool addFollower(cms::AsyncCallback* follower) {
+            synchronized(&mutex) {
+                if (!this->completed) {
+                    this->followers.push_back(follower);
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /**
+         * Waits for the commit to complete, returns false if it didn't within the timeout.
+         */
+        bool await(long long timeout) {
+
+            synchronized(&mutex) {
+                long long deadline = System::currentTimeMillis() + timeout;
+                while (!this->completed) {
+                    if (timeout <= 0) {
+                        this->mutex.wait();
+                    } else {
+                        long long remaining = deadline - System::currentTimeMillis();
+                        if (remaining <= 0) {
+                            return false;
+                        }
+                        this->mutex.wait(remaining);
+                    }
+                }
+            }
+
+            return true;
+        }
+
+    private:
+
+        void complete(const cms::CMSException* error) {
+
+            // Notified under the lock so that a follower added later can't overtake us.
+            synchronized(&mutex) {
+
+                if (this->completed) {
+                    return;
+                }
+
+                try {
+                    if (error == NULL) {
+                        this->callback->onSuccess();
+                    } else {
+                        this->callback->onException(*error);
+                    }
+
+                    std::vector<cms::AsyncCallback*>::const_iterator iter = this->followers.begin();
+                    for (; iter != this->followers.end(); ++iter) {
+                        (*iter)->onSuccess();
+                    }
+                } catch (...) {
+                }
+
+                this->completed = true;
+                this->mutex.notifyAll();
+            }
+        }
+    };
+
     class TxContextData {
     private:
 
@@ -65,11 +168,14 @@ namespace core{
         // Tracks local transactions
         Pointer<commands::TransactionId> transactionId;
 
+        // The last commit that was sent without waiting for its response.
+        Pointer<AsyncCommit> asyncCommit;
+
         // To track XA transactions.
         Pointer<Xid> associatedXid;
         int beforeEndIndex;
 
-        TxContextData() : transactionId(), associatedXid(), beforeEndIndex() {
+        TxContextData() : transactionId(), asyncCommit(), associatedXid(), beforeEndIndex() {
         }
 
     };
@@ -222,6 +328,118 @@ void ActiveMQTransactionContext::commit() {
     AMQ_CATCHALL_THROW(ActiveMQException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQTransactionContext::commit(cms::AsyncCallback* onComplete) {
+
+    try{
+
+        if (onComplete == NULL) {
+            commit();
+            return;
+        }
+
+        if (isInXATransaction()) {
+            throw cms::TransactionInProgressException("Cannot Commit a local transaction while an XA Transaction is in progress.");
+        }
+
+        try {
+            this->beforeEnd();
+        } catch (cms::CMSException& ex) {
+            rollback();
+            throw;
+        }
+
+        if (isInTransaction()) {
+            Pointer<TransactionInfo> info(new TransactionInfo());
+            info->setConnectionId(this->connection->getConnectionInfo().getConnectionId());
+            info->setTransactionId(this->context->transactionId);
+            info->setType(ActiveMQConstants::TRANSACTION_STATE_COMMITONEPHASE);
+
+            // Before we send the command NULL the id in case of an exception.
+            this->context->transactionId.reset(NULL);
+
+            bool hasSynchronizations = false;
+            synchronized(&this->synchronizations) {
+                hasSynchronizations = !this->synchronizations.isEmpty();
+            }
+
+            if (hasSynchronizations) {
+
+                // Consumers must know the outcome before the Session moves on to the next
+                // Transaction, the earlier commits complete before this one's response
+                // arrives so the callbacks are still notified in order.
+                this->context->asyncCommit.reset(NULL);
+
+                try {
+                    this->connection->syncRequest(info);
+                    this->afterCommit();
+                } catch (cms::CMSException& ex) {
+                    this->afterRollback();
+                    onComplete->onException(ex);
+                    return;
+                } catch (ActiveMQException& ex) {
+                    this->afterRollback();
+                    onComplete->onException(ex.convertToCMSException());
+                    return;
+                }
+
+                onComplete->onSuccess();
+                return;
+            }
+
+            // A commit that can't be sent is reported to the callback like any other
+            // failed commit rather than thrown, the GroupCommitter doesn't notify it.
+            Pointer<AsyncCommit> asyncCommit(new AsyncCommit(onComplete));
+            this->context->asyncCommit = asyncCommit;
+
+            try {
+                this->connection->commitAsync(info, asyncCommit);
+            } catch (cms::CMSException& ex) {
+                this->afterRollback();
+                asyncCommit->onException(ex);
+            } catch (ActiveMQException& ex) {
+                this->afterRollback();
+                asyncCommit->onException(ex.convertToCMSException());
+            } catch (Exception& ex) {
+                this->afterRollback();
+                asyncCommit->onException(ActiveMQException(ex).convertToCMSException());
+            }
+        } else {
+
+            // Nothing to commit but the callback still has to follow any earlier commit.
+            Pointer<AsyncCommit> asyncCommit = this->context->asyncCommit;
+            if (asyncCommit == NULL || !asyncCommit->addFollower(onComplete)) {
+                onComplete->onSuccess();
+            }
+        }
+    }
+    AMQ_CATCH_RETHROW(cms::CMSException)
+    AMQ_CATCH_RETHROW(ActiveMQException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, ActiveMQException)
+    AMQ_CATCHALL_THROW(ActiveMQException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQTransactionContext::awaitAsyncCommits(long long timeout) {
+
+    try{
+
+        // Commits complete in the order they were sent so the last one is enough.
+        Pointer<AsyncCommit> asyncCommit = this->context->asyncCommit;
+        if (asyncCommit != NULL) {
+            if (!asyncCommit->await(timeout)) {
+                return false;
+            }
+            this->context->asyncCommit.reset(NULL);
+        }
+
+        return true;
+    }
+    AMQ_CATCH_RETHROW(ActiveMQException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, ActiveMQException)
+    AMQ_CATCHALL_THROW(ActiveMQException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQTransactionContext::rollback() {
 
@@ -19,6 +19,7 @@
 
 #include <memory>
 
+#include <cms/AsyncCallback.h>
 #include <cms/Message.h>
 #include <cms/XAResource.h>
 #include <cms/CMSException.h>
@@ -115,6 +116,32 @@ namespace kernels {
          */
         virtual void commit();
 
+        /**
+         * Commit the current Transaction without waiting for the Broker's response, the
+         * callback is notified of the outcome.  A Transaction that consumed Messages has
+         * Synchronizations that must run before the next Transaction begins, for those the
+         * commit waits for the response and notifies the callback before returning.  A
+         * commit that could not be sent is also reported to the callback.
+         *
+         * @param onComplete
+         *      The callback to notify, if NULL this is a blocking commit.
+         *
+         * @throw ActiveMQException
+         */
+        virtual void commit(cms::AsyncCallback* onComplete);
+
+        /**
+         * Waits for the asynchronous commits of this Transaction context to complete.
+         *
+         * @param timeout
+         *      The maximum time in milliseconds to wait, zero or less waits forever.
+         *
+         * @return true if the commits completed within the timeout.
+         *
+         * @throw ActiveMQException
+         */
+        virtual bool awaitAsyncCommits(long long timeout);
+
         /**
          * Rollback the current Transaction
          * @throw ActiveMQException
@@ -57,6 +57,11 @@ void ActiveMQXASession::commit() {
     throw cms::TransactionInProgressException("Cannot commit inside an XASession");
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQXASession::commit(cms::AsyncCallback* onComplete AMQCPP_UNUSED) {
+    throw cms::TransactionInProgressException("Cannot commit inside an XASession");
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQXASession::rollback() {
     throw cms::TransactionInProgressException("Cannot rollback inside an XASession");
@@ -55,6 +55,8 @@ namespace core {
 
         virtual void commit();
 
+        virtual void commit(cms::AsyncCallback* onComplete);
+
         virtual void rollback();
 
     public:  // XASession overrides
@@ -0,0 +1,80 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AdaptivePrefetchController.h"
+
+#include <decaf/lang/Math.h>
+
+using namespace activemq;
+using namespace activemq::core;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+const long long AdaptivePrefetchController::DEFAULT_SAMPLE_INTERVAL = 1000;
+
+////////////////////////////////////////////////////////////////////////////////
+AdaptivePrefetchController::AdaptivePrefetchController(int maxPrefetchSize, long long targetLatency,
+                                                       long long sampleInterval, long long now) :
+    maxPrefetchSize(Math::max(1, maxPrefetchSize)),
+    targetLatency(Math::max(1LL, targetLatency)),
+    sampleInterval(Math::max(1LL, sampleInterval)),
+    prefetchSize(Math::max(1, maxPrefetchSize)),
+    consumedCount(0),
+    sampleStart(now),
+    consumptionRate(0),
+    adjustments(0) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+AdaptivePrefetchController::~AdaptivePrefetchController() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool AdaptivePrefetchController::evaluate(int backlog, long long now) {
+
+    long long elapsed = now - this->sampleStart;
+    if (elapsed < this->sampleInterval) {
+        return false;
+    }
+
+    this->consumptionRate = (double) this->consumedCount * 1000.0 / (double) elapsed;
+    this->consumedCount = 0;
+    this->sampleStart = now;
+
+    int target;
+    if (backlog > 0) {
+        // The consumer couldn't keep up, hold about targetLatency worth of Messages.
+        double wanted = Math::ceil(this->consumptionRate * (double) this->targetLatency / 1000.0);
+        target = wanted >= (double) this->maxPrefetchSize ? this->maxPrefetchSize : (int) wanted;
+    } else {
+        target = this->prefetchSize > this->maxPrefetchSize / 2 ? this->maxPrefetchSize : this->prefetchSize * 2;
+    }
+
+    target = Math::max(1, target);
+
+    // Ignore changes smaller than a quarter of the current size, moving to either of
+    // the limits is always allowed so the prefetch can settle there.
+    int change = Math::abs(target - this->prefetchSize);
+    if (change == 0 || (change < Math::max(1, this->prefetchSize / 4) &&
+                        target != 1 && target != this->maxPrefetchSize)) {
+        return false;
+    }
+
+    this->prefetchSize = target;
+    this->adjustments++;
+    return true;
+}
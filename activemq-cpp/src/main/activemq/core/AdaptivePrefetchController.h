@@ -0,0 +1,156 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CORE_ADAPTIVEPREFETCHCONTROLLER_H_
+#define _ACTIVEMQ_CORE_ADAPTIVEPREFETCHCONTROLLER_H_
+
+#include <activemq/util/Config.h>
+
+namespace activemq {
+namespace core {
+
+    /**
+     * Works out the prefetch size a consumer should request from the Broker based on the
+     * rate at which it actually consumes Messages.
+     *
+     * The controller counts the Messages consumed over a sample interval.  When the
+     * consumer had a backlog of prefetched Messages at the end of the interval it was the
+     * bottleneck, so the measured rate is its capacity and the prefetch is sized so that
+     * the Messages held locally take roughly the target latency to work through.  When it
+     * had no backlog the consumer kept up with everything it was sent and the prefetch is
+     * doubled, up to the configured maximum, so that a fast consumer isn't starved.  Small
+     * changes are ignored to avoid sending the Broker a stream of tiny adjustments.
+     *
+     * The ack batch size follows the prefetch, acks are sent once half the prefetch has
+     * been consumed the same as the fixed threshold used without the controller.
+     *
+     * This class is not thread safe, it is driven from the thread that delivers Messages
+     * to the consumer.
+     *
+     * @since 3.8
+     */
+    class AMQCPP_API AdaptivePrefetchController {
+    public:
+
+        static const long long DEFAULT_SAMPLE_INTERVAL;
+
+    private:
+
+        int maxPrefetchSize;
+        long long targetLatency;
+        long long sampleInterval;
+
+        int prefetchSize;
+        int consumedCount;
+        long long sampleStart;
+        double consumptionRate;
+        long long adjustments;
+
+    private:
+
+        AdaptivePrefetchController(const AdaptivePrefetchController&);
+        AdaptivePrefetchController& operator=(const AdaptivePrefetchController&);
+
+    public:
+
+        /**
+         * Creates a controller that starts out at the maximum prefetch size.
+         *
+         * @param maxPrefetchSize
+         *      The configured prefetch size of the consumer, the controller never exceeds it.
+         * @param targetLatency
+         *      The time in milliseconds that prefetched Messages should wait to be consumed.
+         * @param sampleInterval
+         *      The time in milliseconds over which the consumption rate is measured.
+         * @param now
+         *      The current time in milliseconds.
+         */
+        AdaptivePrefetchController(int maxPrefetchSize, long long targetLatency,
+                                   long long sampleInterval, long long now);
+
+        virtual ~AdaptivePrefetchController();
+
+        /**
+         * Records that the consumer has finished with a number of Messages.
+         *
+         * @param count
+         *      The number of Messages consumed.
+         */
+        void onMessagesConsumed(int count) {
+            this->consumedCount += count;
+        }
+
+        /**
+         * Evaluates the consumption rate once the sample interval has elapsed and picks a
+         * new prefetch size.
+         *
+         * @param backlog
+         *      The number of prefetched Messages waiting to be delivered to the consumer.
+         * @param now
+         *      The current time in milliseconds.
+         *
+         * @returns true if the prefetch size was changed.
+         */
+        bool evaluate(int backlog, long long now);
+
+        /**
+         * @returns the prefetch size the consumer should currently request.
+         */
+        int getPrefetchSize() const {
+            return this->prefetchSize;
+        }
+
+        /**
+         * @returns the number of consumed Messages to acknowledge together.
+         */
+        int getAckBatchSize() const {
+            return this->prefetchSize > 1 ? this->prefetchSize / 2 : 1;
+        }
+
+        /**
+         * @returns the consumption rate in Messages per second measured over the last sample interval.
+         */
+        double getConsumptionRate() const {
+            return this->consumptionRate;
+        }
+
+        /**
+         * @returns the number of times the prefetch size has been changed.
+         */
+        long long getAdjustments() const {
+            return this->adjustments;
+        }
+
+        /**
+         * @returns the maximum prefetch size the controller will use.
+         */
+        int getMaxPrefetchSize() const {
+            return this->maxPrefetchSize;
+        }
+
+        /**
+         * @returns the target time in milliseconds for prefetched Messages to wait.
+         */
+        long long getTargetLatency() const {
+            return this->targetLatency;
+        }
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_CORE_ADAPTIVEPREFETCHCONTROLLER_H_ */
@@ -0,0 +1,391 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "GroupCommitter.h"
+
+#include <activemq/commands/ExceptionResponse.h>
+#include <activemq/exceptions/ActiveMQException.h>
+#include <activemq/exceptions/BrokerException.h>
+#include <activemq/transport/IOTransport.h>
+#include <activemq/transport/ResponseCallback.h>
+
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/exceptions/InterruptedException.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/util/ArrayList.h>
+#include <decaf/util/LinkedList.h>
+#include <decaf/util/concurrent/Mutex.h>
+
+#include <typeinfo>
+
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace activemq::exceptions;
+using namespace activemq::transport;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class PendingCommit {
+    private:
+
+        PendingCommit(const PendingCommit&);
+        PendingCommit& operator=(const PendingCommit&);
+
+    public:
+
+        Pointer<TransactionInfo> info;
+        Pointer<cms::AsyncCallback> callback;
+        bool written;
+        Pointer<Exception> error;
+
+        PendingCommit(const Pointer<TransactionInfo> info, const Pointer<cms::AsyncCallback> callback) :
+            info(info), callback(callback), written(false), error() {
+        }
+    };
+
+    /**
+     * State shared between the committer and the response callbacks of the commits
+     * it has sent, the callbacks can outlive the committer when the Transport fails.
+     */
+    class CommitWindow {
+    private:
+
+        CommitWindow(const CommitWindow&);
+        CommitWindow& operator=(const CommitWindow&);
+
+    public:
+
+        Mutex mutex;
+        LinkedList< Pointer<PendingCommit> > queue;
+        bool writing;
+        bool closed;
+        int maxPendingCommits;
+        int pendingCommits;
+        long long commitCount;
+        long long groupCount;
+
+        CommitWindow() : mutex(), queue(), writing(false), closed(false), maxPendingCommits(64),
+                         pendingCommits(0), commitCount(0), groupCount(0) {
+        }
+
+        void release() {
+            synchronized(&mutex) {
+                pendingCommits--;
+                mutex.notifyAll();
+            }
+        }
+    };
+
+    class CommitResponseCallback : public ResponseCallback {
+    private:
+
+        Pointer<CommitWindow> window;
+        Pointer<cms::AsyncCallback> callback;
+
+    private:
+
+        CommitResponseCallback(const CommitResponseCallback&);
+        CommitResponseCallback& operator=(const CommitResponseCallback&);
+
+    public:
+
+        CommitResponseCallback(const Pointer<CommitWindow> window, const Pointer<cms::AsyncCallback> callback) :
+            ResponseCallback(), window(window), callback(callback) {
+        }
+
+        virtual ~CommitResponseCallback() {
+        }
+
+        virtual void onComplete(Pointer<commands::Response> response) {
+
+            this->window->release();
+
+            try {
+
+                commands::ExceptionResponse* exceptionResponse =
+                    dynamic_cast<ExceptionResponse*>(response.get());
+
+                if (exceptionResponse != NULL) {
+
+                    Exception ex = exceptionResponse->getException()->createExceptionObject();
+                    const cms::CMSException* cmsError = dynamic_cast<const cms::CMSException*>(ex.getCause());
+                    if (cmsError != NULL) {
+                        this->callback->onException(*cmsError);
+                    } else {
+                        BrokerException error = BrokerException(
+                            __FILE__, __LINE__, exceptionResponse->getException()->getMessage().c_str());
+                        this->callback->onException(error.convertToCMSException());
+                    }
+                } else {
+                    this->callback->onSuccess();
+                }
+            }
+            AMQ_CATCHALL_NOTHROW()
+        }
+    };
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace core {
+
+    class GroupCommitterImpl {
+    private:
+
+        GroupCommitterImpl(const GroupCommitterImpl&);
+        GroupCommitterImpl& operator=(const GroupCommitterImpl&);
+
+    public:
+
+        Pointer<transport::Transport> transport;
+        Pointer<CommitWindow> window;
+
+        GroupCommitterImpl(const Pointer<transport::Transport> transport) :
+            transport(transport), window(new CommitWindow()) {
+        }
+
+        /**
+         * Writes the queued commits, along with any that are queued while it writes, until
+         * the queue is empty.  Only one thread at a time is the writer.
+         */
+        void writeGroups() {
+
+            bool done = false;
+
+            while (!done) {
+
+                ArrayList< Pointer<PendingCommit> > group;
+
+                synchronized(&window->mutex) {
+                    if (window->queue.isEmpty()) {
+                        window->writing = false;
+                        window->mutex.notifyAll();
+                        done = true;
+                    } else {
+                        group.addAll(window->queue);
+                        window->queue.clear();
+                    }
+                }
+
+                if (!done) {
+                    writeGroup(group);
+                }
+            }
+        }
+
+        void writeGroup(ArrayList< Pointer<PendingCommit> >& group) {
+
+            // A fault tolerant transport can swap its IOTransport out from under us so the
+            // writes are only held back when talking to the IOTransport directly.
+            IOTransport* batch = NULL;
+            if (!transport->isFaultTolerant()) {
+                batch = dynamic_cast<IOTransport*>(transport->narrow(typeid(IOTransport)));
+            }
+
+            try {
+                if (batch != NULL) {
+                    batch->beginBatch();
+                }
+            } catch (Exception& ex) {
+                batch = NULL;
+            }
+
+            Pointer<Iterator< Pointer<PendingCommit> > > iter(group.iterator());
+            while (iter->hasNext()) {
+                Pointer<PendingCommit> entry = iter->next();
+                try {
+                    Pointer<ResponseCallback> callback(new CommitResponseCallback(window, entry->callback));
+                    transport->asyncRequest(entry->info, callback);
+                } catch (Exception& ex) {
+                    entry->error.reset(ex.clone());
+                } catch (...) {
+                    entry->error.reset(new Exception(
+                        __FILE__, __LINE__, "GroupCommitter - Unknown error while sending commit"));
+                }
+            }
+
+            // A failed flush fails the Transport which then completes the callbacks.
+            try {
+                if (batch != NULL) {
+                    batch->endBatch();
+                }
+            } catch (Exception& ex) {
+            }
+
+            synchronized(&window->mutex) {
+                iter.reset(group.iterator());
+                while (iter->hasNext()) {
+                    Pointer<PendingCommit> entry = iter->next();
+                    entry->written = true;
+                    if (entry->error != NULL) {
+                        window->pendingCommits--;
+                    }
+                }
+
+                window->commitCount += group.size();
+                window->groupCount++;
+                window->mutex.notifyAll();
+            }
+        }
+    };
+
+}}
+
+////////////////////////////////////////////////////////////////////////////////
+GroupCommitter::GroupCommitter(const Pointer<transport::Transport> transport) : impl(NULL) {
+
+    if (transport == NULL) {
+        throw NullPointerException(__FILE__, __LINE__, "Transport cannot be NULL");
+    }
+
+    this->impl = new GroupCommitterImpl(transport);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+GroupCommitter::~GroupCommitter() {
+    try {
+        close();
+        delete this->impl;
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void GroupCommitter::commit(const Pointer<TransactionInfo> info, const Pointer<cms::AsyncCallback> onComplete) {
+
+    try {
+
+        if (info == NULL || onComplete == NULL) {
+            throw NullPointerException(__FILE__, __LINE__, "Commit and callback cannot be NULL");
+        }
+
+        Pointer<CommitWindow> window = this->impl->window;
+        Pointer<PendingCommit> entry(new PendingCommit(info, onComplete));
+        bool leader = false;
+        bool interrupted = false;
+
+        synchronized(&window->mutex) {
+
+            while (!window->closed && window->pendingCommits >= window->maxPendingCommits) {
+                window->mutex.wait();
+            }
+
+            if (window->closed) {
+                throw ActiveMQException(__FILE__, __LINE__, "GroupCommitter::commit - The committer is closed");
+            }
+
+            window->pendingCommits++;
+            window->queue.add(entry);
+
+            // Once queued the commit will be sent so we wait for the writer without
+            // giving up if interrupted, the interrupt is restored afterwards.
+            while (window->writing && !entry->written) {
+                try {
+                    window->mutex.wait();
+                } catch (InterruptedException& ex) {
+                    interrupted = true;
+                }
+            }
+
+            if (!entry->written) {
+                window->writing = true;
+                leader = true;
+            }
+        }
+
+        if (leader) {
+            this->impl->writeGroups();
+        }
+
+        if (interrupted) {
+            Thread::currentThread()->interrupt();
+        }
+
+        if (entry->error != NULL) {
+            throw ActiveMQException(*entry->error);
+        }
+    }
+    AMQ_CATCH_RETHROW(ActiveMQException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, ActiveMQException)
+    AMQ_CATCHALL_THROW(ActiveMQException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void GroupCommitter::close() {
+
+    synchronized(&this->impl->window->mutex) {
+        this->impl->window->closed = true;
+        this->impl->window->mutex.notifyAll();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int GroupCommitter::getMaxPendingCommits() const {
+
+    int result = 0;
+    synchronized(&this->impl->window->mutex) {
+        result = this->impl->window->maxPendingCommits;
+    }
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void GroupCommitter::setMaxPendingCommits(int value) {
+
+    synchronized(&this->impl->window->mutex) {
+        this->impl->window->maxPendingCommits = value > 0 ? value : 1;
+        this->impl->window->mutex.notifyAll();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int GroupCommitter::getPendingCommitCount() const {
+
+    int result = 0;
+    synchronized(&this->impl->window->mutex) {
+        result = this->impl->window->pendingCommits;
+    }
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long GroupCommitter::getCommitCount() const {
+
+    long long result = 0;
+    synchronized(&this->impl->window->mutex) {
+        result = this->impl->window->commitCount;
+    }
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long GroupCommitter::getGroupCount() const {
+
+    long long result = 0;
+    synchronized(&this->impl->window->mutex) {
+        result = this->impl->window->groupCount;
+    }
+    return result;
+}
@@ -0,0 +1,130 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CORE_GROUPCOMMITTER_H_
+#define _ACTIVEMQ_CORE_GROUPCOMMITTER_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/commands/TransactionInfo.h>
+#include <activemq/transport/Transport.h>
+
+#include <cms/AsyncCallback.h>
+
+#include <decaf/lang/Pointer.h>
+
+namespace activemq {
+namespace core {
+
+    using decaf::lang::Pointer;
+
+    class GroupCommitterImpl;
+
+    /**
+     * Pipelines the local transaction commits of all the Sessions of a Connection.
+     *
+     * A commit handed to the GroupCommitter is sent to the Broker without waiting for the
+     * response of the commits that went before it, the given callback is invoked once the
+     * Broker's response arrives.  Commits that are submitted while another thread is writing
+     * are queued and then written by that thread as one group, on a transport that supports
+     * it the group goes out with a single flush.  The number of commits awaiting a response
+     * is bounded, once the limit is reached callers block until a response frees up a slot.
+     *
+     * Commits are written in the order they were submitted and the Broker answers them in
+     * the order it received them, so the callbacks of a single Session complete in order.
+     * The callbacks are invoked from the Transport's thread and must not block on a request
+     * to the Broker.
+     *
+     * @since 3.8
+     */
+    class AMQCPP_API GroupCommitter {
+    private:
+
+        GroupCommitterImpl* impl;
+
+    private:
+
+        GroupCommitter(const GroupCommitter&);
+        GroupCommitter& operator=(const GroupCommitter&);
+
+    public:
+
+        /**
+         * Creates a new GroupCommitter that sends its commits over the given Transport.
+         *
+         * @param transport
+         *      The Transport, with response correlation, that the commits are sent on.
+         */
+        GroupCommitter(const Pointer<transport::Transport> transport);
+
+        virtual ~GroupCommitter();
+
+        /**
+         * Sends the given commit to the Broker and returns once it has been written, the
+         * callback is notified when the Broker has responded.  Blocks while the maximum
+         * number of commits are awaiting a response.
+         *
+         * @param info
+         *      The TransactionInfo that commits the transaction.
+         * @param onComplete
+         *      The callback notified with the outcome of the commit.
+         *
+         * @throws ActiveMQException if the commit could not be sent, the callback is not
+         *         invoked in that case.
+         */
+        void commit(const Pointer<commands::TransactionInfo> info, const Pointer<cms::AsyncCallback> onComplete);
+
+        /**
+         * Stops accepting new commits and wakes any caller that is waiting for a free slot,
+         * commits that were already sent are completed by their responses or by the failure
+         * of the Transport.
+         */
+        void close();
+
+        /**
+         * @returns the maximum number of commits that can be awaiting a response.
+         */
+        int getMaxPendingCommits() const;
+
+        /**
+         * Sets the maximum number of commits that can be awaiting a response at once.
+         *
+         * @param value
+         *      The maximum number of pending commits, values less than one are treated as one.
+         */
+        void setMaxPendingCommits(int value);
+
+        /**
+         * @returns the number of commits currently awaiting a response from the Broker.
+         */
+        int getPendingCommitCount() const;
+
+        /**
+         * @returns the total number of commits that have been written.
+         */
+        long long getCommitCount() const;
+
+        /**
+         * @returns the number of groups that the commits were written in, comparing this to
+         *          the commit count shows how well commits are being grouped.
+         */
+        long long getGroupCount() const;
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_CORE_GROUPCOMMITTER_H_ */
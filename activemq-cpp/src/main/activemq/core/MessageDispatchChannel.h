@@ -86,6 +86,21 @@ namespace core {
          */
         virtual Pointer<MessageDispatch> dequeueNoWait() = 0;
 
+        /**
+         * Used to get up to maxMessages enqueued messages with a single acquisition of
+         * the Channel lock.  The wait for the first message follows the same timeout
+         * rules as dequeue, once a message is available any others that are already in
+         * the Channel are removed along with it without any further waiting.
+         *
+         * @param timeout
+         *      The time to wait for the first message, -1 to wait forever and 0 to not wait.
+         * @param maxMessages
+         *      The maximum number of messages to remove from the Channel.
+         *
+         * @return a list of Messages in delivery order, empty if we timeout or if the Channel is closed.
+         */
+        virtual std::vector<Pointer<MessageDispatch> > dequeueBatch(long long timeout, int maxMessages) = 0;
+
         /**
          * Peek in the Queue and return the first message in the Channel without removing
          * it from the channel.
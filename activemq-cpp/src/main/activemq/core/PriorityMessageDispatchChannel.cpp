@@ -0,0 +1,335 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PriorityMessageDispatchChannel.h"
+
+#include <cms/Message.h>
+
+#include <decaf/lang/Math.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // Index of the highest set bit for each four bit value, -1 for zero.
+    const int HIGHEST_BIT[16] = { -1, 0, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3 };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PriorityMessageDispatchChannel::PriorityMessageDispatchChannel() :
+    closed(false), running(false), mutex(), nonEmptyLevels(0), freeNodes(NULL), enqueued(0) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PriorityMessageDispatchChannel::~PriorityMessageDispatchChannel() {
+
+    try {
+        clear();
+
+        while (this->freeNodes != NULL) {
+            Node* node = this->freeNodes;
+            this->freeNodes = node->next;
+            delete node;
+        }
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PriorityMessageDispatchChannel::enqueue(const Pointer<MessageDispatch>& message) {
+    synchronized(&mutex) {
+        int priority = getPriority(message);
+        Level& level = this->levels[priority];
+        Node* node = acquireNode(message);
+
+        if (level.tail == NULL) {
+            level.head = node;
+        } else {
+            level.tail->next = node;
+        }
+        level.tail = node;
+
+        this->nonEmptyLevels |= (1u << priority);
+        this->enqueued++;
+        mutex.notify();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PriorityMessageDispatchChannel::enqueueFirst(const Pointer<MessageDispatch>& message) {
+    synchronized(&mutex) {
+        int priority = getPriority(message);
+        Level& level = this->levels[priority];
+        Node* node = acquireNode(message);
+
+        node->next = level.head;
+        level.head = node;
+        if (level.tail == NULL) {
+            level.tail = node;
+        }
+
+        this->nonEmptyLevels |= (1u << priority);
+        this->enqueued++;
+        mutex.notify();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool PriorityMessageDispatchChannel::isEmpty() const {
+    return this->enqueued == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<MessageDispatch> PriorityMessageDispatchChannel::dequeue(long long timeout) {
+
+    synchronized(&mutex) {
+        // Wait until the channel is ready to deliver messages.
+        while (timeout != 0 && !closed && (isEmpty() || !running)) {
+            if (timeout == -1) {
+                mutex.wait();
+            } else {
+                mutex.wait((unsigned long) timeout);
+                break;
+            }
+        }
+
+        if (closed || !running || isEmpty()) {
+            return Pointer<MessageDispatch>();
+        }
+
+        return removeFirst();
+    }
+
+    return Pointer<MessageDispatch>();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<MessageDispatch> PriorityMessageDispatchChannel::dequeueNoWait() {
+    synchronized(&mutex) {
+        if (closed || !running || isEmpty()) {
+            return Pointer<MessageDispatch>();
+        }
+        return removeFirst();
+    }
+
+    return Pointer<MessageDispatch>();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<Pointer<MessageDispatch> > PriorityMessageDispatchChannel::dequeueBatch(long long timeout, int maxMessages) {
+    std::vector<Pointer<MessageDispatch> > result;
+
+    if (maxMessages <= 0) {
+        return result;
+    }
+
+    synchronized(&mutex) {
+        // Wait until the channel is ready to deliver messages.
+        while (timeout != 0 && !closed && (isEmpty() || !running)) {
+            if (timeout == -1) {
+                mutex.wait();
+            } else {
+                mutex.wait((unsigned long) timeout);
+                break;
+            }
+        }
+
+        if (closed || !running || isEmpty()) {
+            return result;
+        }
+
+        drainTo(result, maxMessages);
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<MessageDispatch> PriorityMessageDispatchChannel::peek() const {
+    synchronized(&mutex) {
+        if (closed || !running || isEmpty()) {
+            return Pointer<MessageDispatch>();
+        }
+        return this->levels[highestLevel(this->nonEmptyLevels)].head->dispatch;
+    }
+
+    return Pointer<MessageDispatch>();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PriorityMessageDispatchChannel::start() {
+    synchronized(&mutex) {
+        if (!closed) {
+            running = true;
+            mutex.notifyAll();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PriorityMessageDispatchChannel::stop() {
+    synchronized(&mutex) {
+        running = false;
+        mutex.notifyAll();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PriorityMessageDispatchChannel::close() {
+    synchronized(&mutex) {
+        if (!closed) {
+            running = false;
+            closed = true;
+        }
+        mutex.notifyAll();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PriorityMessageDispatchChannel::clear() {
+    synchronized(&mutex) {
+        while (this->nonEmptyLevels != 0) {
+            removeFirst();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int PriorityMessageDispatchChannel::size() const {
+    synchronized(&mutex) {
+        return this->enqueued;
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<Pointer<MessageDispatch> > PriorityMessageDispatchChannel::removeAll() {
+    std::vector<Pointer<MessageDispatch> > result;
+
+    synchronized(&mutex) {
+        drainTo(result, this->enqueued);
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int PriorityMessageDispatchChannel::getPriority(const Pointer<MessageDispatch>& dispatch) {
+
+    int priority = cms::Message::DEFAULT_MSG_PRIORITY;
+
+    if (dispatch->getMessage() != NULL) {
+        priority = Math::min(Math::max(dispatch->getMessage()->getPriority(), 0), MAX_PRIORITIES - 1);
+    }
+
+    return priority;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int PriorityMessageDispatchChannel::highestLevel(unsigned int levels) {
+
+    if ((levels >> 8) != 0) {
+        return 8 + HIGHEST_BIT[(levels >> 8) & 0xF];
+    } else if ((levels >> 4) != 0) {
+        return 4 + HIGHEST_BIT[(levels >> 4) & 0xF];
+    }
+
+    return HIGHEST_BIT[levels & 0xF];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PriorityMessageDispatchChannel::Node* PriorityMessageDispatchChannel::acquireNode(const Pointer<MessageDispatch>& dispatch) {
+
+    Node* node = this->freeNodes;
+    if (node != NULL) {
+        this->freeNodes = node->next;
+    } else {
+        node = new Node();
+    }
+
+    node->dispatch = dispatch;
+    node->next = NULL;
+
+    return node;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PriorityMessageDispatchChannel::releaseNode(Node* node) {
+    node->dispatch.reset(NULL);
+    node->next = this->freeNodes;
+    this->freeNodes = node;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<MessageDispatch> PriorityMessageDispatchChannel::removeFirst() {
+
+    if (this->nonEmptyLevels == 0) {
+        return Pointer<MessageDispatch>();
+    }
+
+    int priority = highestLevel(this->nonEmptyLevels);
+    Level& level = this->levels[priority];
+    Node* node = level.head;
+
+    level.head = node->next;
+    if (level.head == NULL) {
+        level.tail = NULL;
+        this->nonEmptyLevels &= ~(1u << priority);
+    }
+
+    Pointer<MessageDispatch> dispatch = node->dispatch;
+    releaseNode(node);
+    this->enqueued--;
+
+    return dispatch;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PriorityMessageDispatchChannel::drainTo(std::vector<Pointer<MessageDispatch> >& result, int maxMessages) {
+
+    int count = Math::min(maxMessages, this->enqueued);
+    result.reserve(result.size() + count);
+
+    // Walk whole levels at a time rather than looking up the highest level per Message.
+    while (count > 0 && this->nonEmptyLevels != 0) {
+
+        int priority = highestLevel(this->nonEmptyLevels);
+        Level& level = this->levels[priority];
+
+        while (count > 0 && level.head != NULL) {
+            Node* node = level.head;
+            level.head = node->next;
+            result.push_back(node->dispatch);
+            releaseNode(node);
+            this->enqueued--;
+            count--;
+        }
+
+        if (level.head == NULL) {
+            level.tail = NULL;
+            this->nonEmptyLevels &= ~(1u << priority);
+        }
+    }
+}
@@ -0,0 +1,164 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CORE_PRIORITYMESSAGEDISPATCHCHANNEL_H_
+#define _ACTIVEMQ_CORE_PRIORITYMESSAGEDISPATCHCHANNEL_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/core/MessageDispatchChannel.h>
+
+#include <decaf/util/concurrent/Mutex.h>
+
+namespace activemq {
+namespace core {
+
+    /**
+     * A MessageDispatchChannel that delivers Messages in priority order at close to the
+     * cost of a FIFO channel.  Each priority level is kept as an intrusive list whose
+     * nodes are recycled through a free list so that steady state enqueue and dequeue
+     * don't allocate, and a bitmask of the non-empty levels lets the highest priority
+     * Message be found without scanning the empty ones.
+     *
+     * @since 3.2
+     */
+    class AMQCPP_API PriorityMessageDispatchChannel : public MessageDispatchChannel {
+    private:
+
+        static const int MAX_PRIORITIES = 10;
+
+        struct Node {
+            Pointer<MessageDispatch> dispatch;
+            Node* next;
+
+            Node() : dispatch(), next(NULL) {}
+        };
+
+        struct Level {
+            Node* head;
+            Node* tail;
+
+            Level() : head(NULL), tail(NULL) {}
+        };
+
+        bool closed;
+        bool running;
+
+        mutable decaf::util::concurrent::Mutex mutex;
+
+        Level levels[MAX_PRIORITIES];
+        unsigned int nonEmptyLevels;
+        Node* freeNodes;
+
+        int enqueued;
+
+    private:
+
+        PriorityMessageDispatchChannel(const PriorityMessageDispatchChannel&);
+        PriorityMessageDispatchChannel& operator=(const PriorityMessageDispatchChannel&);
+
+    public:
+
+        PriorityMessageDispatchChannel();
+        virtual ~PriorityMessageDispatchChannel();
+
+        virtual void enqueue(const Pointer<MessageDispatch>& message);
+
+        virtual void enqueueFirst(const Pointer<MessageDispatch>& message);
+
+        virtual bool isEmpty() const;
+
+        virtual bool isClosed() const {
+            return this->closed;
+        }
+
+        virtual bool isRunning() const {
+            return this->running;
+        }
+
+        virtual Pointer<MessageDispatch> dequeue(long long timeout);
+
+        virtual Pointer<MessageDispatch> dequeueNoWait();
+
+        virtual std::vector<Pointer<MessageDispatch> > dequeueBatch(long long timeout, int maxMessages);
+
+        virtual Pointer<MessageDispatch> peek() const;
+
+        virtual void start();
+
+        virtual void stop();
+
+        virtual void close();
+
+        virtual void clear();
+
+        virtual int size() const;
+
+        virtual std::vector<Pointer<MessageDispatch> > removeAll();
+
+    public:
+
+        virtual void lock() {
+            mutex.lock();
+        }
+
+        virtual bool tryLock() {
+            return mutex.tryLock();
+        }
+
+        virtual void unlock() {
+            mutex.unlock();
+        }
+
+        virtual void wait() {
+            mutex.wait();
+        }
+
+        virtual void wait(long long millisecs) {
+            mutex.wait(millisecs);
+        }
+
+        virtual void wait(long long millisecs, int nanos) {
+            mutex.wait(millisecs, nanos);
+        }
+
+        virtual void notify() {
+            mutex.notify();
+        }
+
+        virtual void notifyAll() {
+            mutex.notifyAll();
+        }
+
+    private:
+
+        static int getPriority(const Pointer<MessageDispatch>& dispatch);
+
+        static int highestLevel(unsigned int levels);
+
+        Node* acquireNode(const Pointer<MessageDispatch>& dispatch);
+
+        void releaseNode(Node* node);
+
+        Pointer<MessageDispatch> removeFirst();
+
+        void drainTo(std::vector<Pointer<MessageDispatch> >& result, int maxMessages);
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_CORE_PRIORITYMESSAGEDISPATCHCHANNEL_H_ */
@@ -0,0 +1,314 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ProducerMessageTemplate.h"
+
+#include <activemq/commands/ActiveMQTextMessage.h>
+#include <activemq/commands/ActiveMQBytesMessage.h>
+#include <activemq/util/CMSExceptionSupport.h>
+#include <activemq/wireformat/openwire/marshal/PrimitiveTypesMarshaller.h>
+#include <activemq/wireformat/openwire/utils/ByteCursor.h>
+#include <activemq/wireformat/openwire/utils/FrameOutputStream.h>
+#include <activemq/wireformat/openwire/utils/MessagePropertyInterceptor.h>
+
+#include <cms/UnsupportedOperationException.h>
+
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::util;
+using namespace activemq::commands;
+using namespace activemq::wireformat::openwire::marshal;
+using namespace activemq::wireformat::openwire::utils;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::util;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+ProducerMessageTemplate::ProducerMessageTemplate(const commands::Message& prototype, const std::vector<std::string>& variableProperties) :
+    prototype(prototype.cloneDataStructure()), constants(), constantBytes(), variableNames(variableProperties), variables(),
+    interceptor(), buffer(new FrameOutputStream()), encoded(), text(), bytes(), hasBytes(false) {
+
+    try {
+
+        std::vector<std::string>::const_iterator name = this->variableNames.begin();
+        for (; name != this->variableNames.end(); ++name) {
+            if (name->empty()) {
+                throw IllegalArgumentException(__FILE__, __LINE__, "Message Property names must not be empty");
+            }
+        }
+
+        std::sort(this->variableNames.begin(), this->variableNames.end());
+        this->variableNames.erase(std::unique(this->variableNames.begin(), this->variableNames.end()), this->variableNames.end());
+
+        // Split the prototype's encoded properties into the constant ones, which are
+        // kept encoded in key order, and the variable ones which are set per send.
+        this->prototype->marshalProperties();
+        const std::vector<unsigned char>& properties =
+            static_cast<const commands::Message*>(this->prototype.get())->getMarshalledProperties();
+
+        if (!properties.empty()) {
+
+            ByteCursor cursor(&properties[0], (int) properties.size());
+
+            int size = cursor.readInt();
+            for (int i = 0; i < size; ++i) {
+
+                int start = cursor.getPosition();
+                std::string key = cursor.readUTF();
+                PrimitiveTypesMarshaller::skipPrimitive(cursor);
+
+                if (!isVariableProperty(key)) {
+                    Constant constant;
+                    constant.name = key;
+                    constant.offset = (int) this->constantBytes.size();
+                    constant.length = cursor.getPosition() - start;
+                    this->constantBytes.insert(this->constantBytes.end(), &properties[start], &properties[start] + constant.length);
+                    this->constants.push_back(constant);
+                }
+            }
+        }
+
+        // The prototype is copied for every send, so it holds no properties of its own.
+        std::vector<unsigned char> none;
+        this->prototype->swapEncodedProperties(none);
+        this->prototype->setReadOnlyBody(false);
+
+        this->interceptor.reset(new MessagePropertyInterceptor(this->prototype.get(), &this->variables));
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ProducerMessageTemplate::~ProducerMessageTemplate() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ProducerMessageTemplate::isVariableProperty(const std::string& name) const {
+    return std::binary_search(this->variableNames.begin(), this->variableNames.end(), name);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProducerMessageTemplate::checkVariable(const std::string& name) const {
+
+    if (!isVariableProperty(name)) {
+        throw IllegalArgumentException(__FILE__, __LINE__,
+            "Property is not a variable property of this template: %s", name.c_str());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProducerMessageTemplate::setBooleanProperty(const std::string& name, bool value) {
+
+    try {
+        checkVariable(name);
+        this->interceptor->setBooleanProperty(name, value);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProducerMessageTemplate::setByteProperty(const std::string& name, unsigned char value) {
+
+    try {
+        checkVariable(name);
+        this->interceptor->setByteProperty(name, value);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProducerMessageTemplate::setShortProperty(const std::string& name, short value) {
+
+    try {
+        checkVariable(name);
+        this->interceptor->setShortProperty(name, value);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProducerMessageTemplate::setIntProperty(const std::string& name, int value) {
+
+    try {
+        checkVariable(name);
+        this->interceptor->setIntProperty(name, value);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProducerMessageTemplate::setLongProperty(const std::string& name, long long value) {
+
+    try {
+        checkVariable(name);
+        this->interceptor->setLongProperty(name, value);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProducerMessageTemplate::setFloatProperty(const std::string& name, float value) {
+
+    try {
+        checkVariable(name);
+        this->interceptor->setFloatProperty(name, value);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProducerMessageTemplate::setDoubleProperty(const std::string& name, double value) {
+
+    try {
+        checkVariable(name);
+        this->interceptor->setDoubleProperty(name, value);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProducerMessageTemplate::setStringProperty(const std::string& name, const std::string& value) {
+
+    try {
+        checkVariable(name);
+        this->interceptor->setStringProperty(name, value);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProducerMessageTemplate::clearProperty(const std::string& name) {
+
+    try {
+        checkVariable(name);
+        if (this->variables.containsKey(name)) {
+            this->variables.remove(name);
+        }
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProducerMessageTemplate::setText(const std::string& text) {
+
+    try {
+
+        if (dynamic_cast<ActiveMQTextMessage*>(this->prototype.get()) == NULL) {
+            throw cms::UnsupportedOperationException("The Message template is not for a TextMessage");
+        }
+
+        // The body is replaced on every send, so the prototype's body need not be copied.
+        if (this->text.get() == NULL) {
+            dynamic_cast<ActiveMQTextMessage*>(this->prototype.get())->clearBody();
+        }
+
+        this->text.reset(new std::string(text));
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProducerMessageTemplate::setBytes(const unsigned char* buffer, int length) {
+
+    try {
+
+        if (dynamic_cast<ActiveMQBytesMessage*>(this->prototype.get()) == NULL) {
+            throw cms::UnsupportedOperationException("The Message template is not for a BytesMessage");
+        }
+
+        if (length < 0 || (buffer == NULL && length > 0)) {
+            throw IllegalArgumentException(__FILE__, __LINE__, "Invalid body buffer or length: %d", length);
+        }
+
+        if (!this->hasBytes) {
+            dynamic_cast<ActiveMQBytesMessage*>(this->prototype.get())->clearBody();
+        }
+
+        this->bytes.assign(buffer, buffer + length);
+        this->hasBytes = true;
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<commands::Message> ProducerMessageTemplate::createMessage(ActiveMQConnection* connection) {
+
+    try {
+
+        Pointer<commands::Message> message(this->prototype->cloneDataStructure());
+        message->setConnection(connection);
+
+        // The body is set through the Message so that it is compressed exactly as
+        // it would be had it been set on the prototype.
+        if (this->text.get() != NULL) {
+            dynamic_cast<ActiveMQTextMessage*>(message.get())->setText(*this->text);
+        } else if (this->hasBytes && !this->bytes.empty()) {
+            dynamic_cast<ActiveMQBytesMessage*>(message.get())->setBodyBytes(&this->bytes[0], (int) this->bytes.size());
+        }
+
+        this->encodeProperties();
+        message->swapEncodedProperties(this->encoded);
+
+        return message;
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProducerMessageTemplate::encodeProperties() {
+
+    this->encoded.clear();
+
+    int count = (int) this->constants.size() + this->variables.size();
+    if (count == 0) {
+        return;
+    }
+
+    // Writes the entries in the key order of the PrimitiveMap that the normal send
+    // path encodes, constant entries are copied and only the variable ones encoded.
+    this->buffer->reset();
+    DataOutputStream dataOut(this->buffer.get());
+    dataOut.writeInt(count);
+
+    std::vector<Constant>::const_iterator constant = this->constants.begin();
+
+    Pointer< Iterator<std::string> > keys(this->variables.keySet().iterator());
+    while (keys->hasNext()) {
+        std::string key = keys->next();
+
+        for (; constant != this->constants.end() && constant->name < key; ++constant) {
+            this->buffer->write(&this->constantBytes[constant->offset], constant->length, 0, constant->length);
+        }
+
+        dataOut.writeUTF(key);
+        PrimitiveTypesMarshaller::marshalPrimitive(dataOut, this->variables.get(key));
+    }
+
+    for (; constant != this->constants.end(); ++constant) {
+        this->buffer->write(&this->constantBytes[constant->offset], constant->length, 0, constant->length);
+    }
+
+    this->encoded.assign(this->buffer->getBuffer(), this->buffer->getBuffer() + this->buffer->size());
+}
@@ -0,0 +1,275 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CORE_PRODUCERMESSAGETEMPLATE_H_
+#define _ACTIVEMQ_CORE_PRODUCERMESSAGETEMPLATE_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/util/PrimitiveMap.h>
+#include <activemq/commands/Message.h>
+
+#include <decaf/lang/Pointer.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace activemq {
+namespace wireformat {
+namespace openwire {
+namespace utils {
+    class FrameOutputStream;
+    class MessagePropertyInterceptor;
+}}}
+namespace core {
+
+    class ActiveMQConnection;
+
+    using decaf::lang::Pointer;
+
+    /**
+     * Builds the Messages for a Producer that sends many Messages which differ only in a
+     * few properties and their body.  The properties of the prototype Message are encoded
+     * once when the template is created.  Each Message created afterwards carries a copy
+     * of the prototype's headers, the body set on the template and properties made by
+     * merging the constant encoding with the current values of the variable properties,
+     * so it marshals to the same bytes as the prototype would with those values set on it.
+     *
+     * The properties that change between sends are named when the template is created,
+     * they are not taken from the prototype and are only sent once set on the template.
+     * A variable property keeps its value from one send to the next until it is set
+     * again or cleared.  The reserved JMSX properties are stored in the Message headers
+     * as they are for any other Message.
+     *
+     * Templates are created with ActiveMQProducer::createMessageTemplate and sent with
+     * ActiveMQProducer::send.  This class is not thread safe.
+     *
+     * @since 3.8
+     */
+    class AMQCPP_API ProducerMessageTemplate {
+    private:
+
+        // A constant property, its name and the range of constantBytes that holds
+        // the property as it appears in the marshalled properties.
+        struct Constant {
+            std::string name;
+            int offset;
+            int length;
+        };
+
+        Pointer<commands::Message> prototype;
+        std::vector<Constant> constants;
+        std::vector<unsigned char> constantBytes;
+        std::vector<std::string> variableNames;
+        util::PrimitiveMap variables;
+        std::auto_ptr<wireformat::openwire::utils::MessagePropertyInterceptor> interceptor;
+        std::auto_ptr<wireformat::openwire::utils::FrameOutputStream> buffer;
+        std::vector<unsigned char> encoded;
+        std::auto_ptr<std::string> text;
+        std::vector<unsigned char> bytes;
+        bool hasBytes;
+
+    private:
+
+        ProducerMessageTemplate(const ProducerMessageTemplate&);
+        ProducerMessageTemplate& operator=(const ProducerMessageTemplate&);
+
+    public:
+
+        /**
+         * Creates a template from the given prototype, the prototype is copied and not
+         * referenced afterwards.
+         *
+         * @param prototype
+         *      The Message whose headers, properties and body the template starts from.
+         * @param variableProperties
+         *      The names of the properties that are set on the template for each send.
+         *
+         * @throws CMSException if a name is empty or the prototype's properties can't be encoded.
+         */
+        ProducerMessageTemplate(const commands::Message& prototype, const std::vector<std::string>& variableProperties);
+
+        virtual ~ProducerMessageTemplate();
+
+        /**
+         * @return the sorted names of the properties that are set on the template for each send.
+         */
+        const std::vector<std::string>& getVariablePropertyNames() const {
+            return this->variableNames;
+        }
+
+        /**
+         * @param name
+         *      The property name to check.
+         *
+         * @return true if the named property was declared variable when the template was created.
+         */
+        bool isVariableProperty(const std::string& name) const;
+
+        /**
+         * Sets the value of a variable boolean property for the following sends.
+         *
+         * @param name
+         *      The name of the property, it must have been declared variable.
+         * @param value
+         *      The value to send.
+         *
+         * @throws CMSException if the property is not a variable property of this template.
+         */
+        void setBooleanProperty(const std::string& name, bool value);
+
+        /**
+         * Sets the value of a variable byte property for the following sends.
+         *
+         * @param name
+         *      The name of the property, it must have been declared variable.
+         * @param value
+         *      The value to send.
+         *
+         * @throws CMSException if the property is not a variable property of this template.
+         */
+        void setByteProperty(const std::string& name, unsigned char value);
+
+        /**
+         * Sets the value of a variable short property for the following sends.
+         *
+         * @param name
+         *      The name of the property, it must have been declared variable.
+         * @param value
+         *      The value to send.
+         *
+         * @throws CMSException if the property is not a variable property of this template.
+         */
+        void setShortProperty(const std::string& name, short value);
+
+        /**
+         * Sets the value of a variable int property for the following sends.
+         *
+         * @param name
+         *      The name of the property, it must have been declared variable.
+         * @param value
+         *      The value to send.
+         *
+         * @throws CMSException if the property is not a variable property of this template.
+         */
+        void setIntProperty(const std::string& name, int value);
+
+        /**
+         * Sets the value of a variable long property for the following sends.
+         *
+         * @param name
+         *      The name of the property, it must have been declared variable.
+         * @param value
+         *      The value to send.
+         *
+         * @throws CMSException if the property is not a variable property of this template.
+         */
+        void setLongProperty(const std::string& name, long long value);
+
+        /**
+         * Sets the value of a variable float property for the following sends.
+         *
+         * @param name
+         *      The name of the property, it must have been declared variable.
+         * @param value
+         *      The value to send.
+         *
+         * @throws CMSException if the property is not a variable property of this template.
+         */
+        void setFloatProperty(const std::string& name, float value);
+
+        /**
+         * Sets the value of a variable double property for the following sends.
+         *
+         * @param name
+         *      The name of the property, it must have been declared variable.
+         * @param value
+         *      The value to send.
+         *
+         * @throws CMSException if the property is not a variable property of this template.
+         */
+        void setDoubleProperty(const std::string& name, double value);
+
+        /**
+         * Sets the value of a variable string property for the following sends.
+         *
+         * @param name
+         *      The name of the property, it must have been declared variable.
+         * @param value
+         *      The value to send.
+         *
+         * @throws CMSException if the property is not a variable property of this template.
+         */
+        void setStringProperty(const std::string& name, const std::string& value);
+
+        /**
+         * Removes a variable property so that the following sends don't carry it.
+         *
+         * @param name
+         *      The name of the property, it must have been declared variable.
+         *
+         * @throws CMSException if the property is not a variable property of this template.
+         */
+        void clearProperty(const std::string& name);
+
+        /**
+         * Sets the body of the following sends, in place of the prototype's body.
+         *
+         * @param text
+         *      The text to send.
+         *
+         * @throws CMSException if the prototype is not a TextMessage.
+         */
+        void setText(const std::string& text);
+
+        /**
+         * Sets the body of the following sends, in place of the prototype's body.
+         *
+         * @param buffer
+         *      The bytes to send, copied into the template.
+         * @param length
+         *      The number of bytes in the buffer.
+         *
+         * @throws CMSException if the prototype is not a BytesMessage.
+         */
+        void setBytes(const unsigned char* buffer, int length);
+
+        /**
+         * Creates the next Message to send from this template.  The Message has the
+         * prototype's headers, the current body and properties, the headers assigned on
+         * send are left for the Session to set.
+         *
+         * @param connection
+         *      The Connection the Message is sent on, used for the body compression settings.
+         *
+         * @return the new Message.
+         *
+         * @throws CMSException if the Message can't be created.
+         */
+        Pointer<commands::Message> createMessage(ActiveMQConnection* connection);
+
+    private:
+
+        void checkVariable(const std::string& name) const;
+
+        void encodeProperties();
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_CORE_PRODUCERMESSAGETEMPLATE_H_ */
@@ -102,6 +102,39 @@ Pointer<MessageDispatch> SimplePriorityMessageDispatchChannel::dequeueNoWait() {
     return Pointer<MessageDispatch>();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+std::vector<Pointer<MessageDispatch> > SimplePriorityMessageDispatchChannel::dequeueBatch(long long timeout, int maxMessages) {
+    std::vector<Pointer<MessageDispatch> > result;
+
+    if (maxMessages <= 0) {
+        return result;
+    }
+
+    synchronized(&mutex) {
+        // Wait until the channel is ready to deliver messages.
+        while (timeout != 0 && !closed && (isEmpty() || !running)) {
+            if (timeout == -1) {
+                mutex.wait();
+            } else {
+                mutex.wait((unsigned long) timeout);
+                break;
+            }
+        }
+
+        if (closed || !running || isEmpty()) {
+            return result;
+        }
+
+        int count = Math::min(maxMessages, this->enqueued);
+        result.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            result.push_back(removeFirst());
+        }
+    }
+
+    return result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<MessageDispatch> SimplePriorityMessageDispatchChannel::peek() const {
     synchronized(&mutex) {
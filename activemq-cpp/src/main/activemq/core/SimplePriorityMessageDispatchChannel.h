@@ -72,6 +72,8 @@ namespace core {
 
         virtual Pointer<MessageDispatch> dequeueNoWait();
 
+        virtual std::vector<Pointer<MessageDispatch> > dequeueBatch(long long timeout, int maxMessages);
+
         virtual Pointer<MessageDispatch> peek() const;
 
         virtual void start();
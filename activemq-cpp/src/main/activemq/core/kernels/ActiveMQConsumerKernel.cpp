@@ -34,6 +34,7 @@
 #include <activemq/util/ActiveMQProperties.h>
 #include <activemq/util/ActiveMQMessageTransformation.h>
 #include <activemq/exceptions/ActiveMQException.h>
+#include <activemq/commands/ConsumerControl.h>
 #include <activemq/commands/Message.h>
 #include <activemq/commands/MessageAck.h>
 #include <activemq/commands/MessagePull.h>
@@ -44,8 +45,9 @@
 #include <activemq/core/ActiveMQConstants.h>
 #include <activemq/core/ActiveMQTransactionContext.h>
 #include <activemq/core/ActiveMQAckHandler.h>
+#include <activemq/core/AdaptivePrefetchController.h>
 #include <activemq/core/FifoMessageDispatchChannel.h>
-#include <activemq/core/SimplePriorityMessageDispatchChannel.h>
+#include <activemq/core/PriorityMessageDispatchChannel.h>
 #include <activemq/core/RedeliveryPolicy.h>
 #include <activemq/core/kernels/ActiveMQSessionKernel.h>
 #include <activemq/threads/Scheduler.h>
@@ -61,11 +63,15 @@ using namespace activemq::core::kernels;
 using namespace activemq::commands;
 using namespace activemq::exceptions;
 using namespace activemq::threads;
+using namespace activemq::metrics;
 using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
 using namespace decaf::util;
 using namespace decaf::util::concurrent;
 
+////////////////////////////////////////////////////////////////////////////////
+LOGDECAF_INITIALIZE(logger, ActiveMQConsumerKernel, "activemq.core.kernels.ActiveMQConsumerKernel")
+
 ////////////////////////////////////////////////////////////////////////////////
 namespace activemq {
 namespace core {
@@ -123,10 +129,15 @@ namespace kernels {
         Runnable* optimizedAckTask;
         int ackCounter;
         int dispatchedCount;
+        long long busyPollTime;
+        Counter busyPollSpinCount;
+        Counter busyPollWaitCount;
         Pointer<ExecutorService> executor;
         ActiveMQSessionKernel* session;
         ActiveMQConsumerKernel* parent;
         Pointer<ConsumerInfo> info;
+        Pointer<AdaptivePrefetchController> prefetchController;
+        ConsumerMetrics metrics;
 
         ActiveMQConsumerKernelConfig() : listener(NULL),
                                          messageAvailableListener(NULL),
@@ -160,10 +171,15 @@ namespace kernels {
                                          optimizedAckTask(),
                                          ackCounter(),
                                          dispatchedCount(),
+                                         busyPollTime(0),
+                                         busyPollSpinCount(),
+                                         busyPollWaitCount(),
                                          executor(),
                                          session(),
                                          parent(),
-                                         info() {
+                                         info(),
+                                         prefetchController(),
+                                         metrics() {
         }
 
         bool isTimeForOptimizedAck(int prefetchSize) const {
@@ -714,7 +730,7 @@ ActiveMQConsumerKernel::ActiveMQConsumerKernel(ActiveMQSessionKernel* session,
     this->internal->scheduler = this->session->getScheduler();
 
     if (this->session->getConnection()->isMessagePrioritySupported()) {
-        this->internal->unconsumedMessages.reset(new SimplePriorityMessageDispatchChannel());
+        this->internal->unconsumedMessages.reset(new PriorityMessageDispatchChannel());
     } else {
         this->internal->unconsumedMessages.reset(new FifoMessageDispatchChannel());
     }
@@ -739,6 +755,7 @@ ActiveMQConsumerKernel::ActiveMQConsumerKernel(ActiveMQSessionKernel* session,
     this->internal->failoverRedeliveryWaitPeriod =
         session->getConnection()->getConsumerFailoverRedeliveryWaitPeriod();
     this->internal->nonBlockingRedelivery = session->getConnection()->isNonBlockingRedelivery();
+    this->internal->busyPollTime = session->getConnection()->getConsumerBusyPollTime();
     this->internal->transactedIndividualAck =
         session->getConnection()->isTransactedIndividualAck() || this->internal->nonBlockingRedelivery;
 
@@ -747,6 +764,18 @@ ActiveMQConsumerKernel::ActiveMQConsumerKernel(ActiveMQSessionKernel* session,
         throw IllegalArgumentException(
             __FILE__, __LINE__, "Cannot create a consumer with a negative prefetch");
     }
+
+    // A zero prefetch consumer pulls each message so there is no window to adapt.
+    if (session->getConnection()->isAdaptivePrefetch() &&
+        this->consumerInfo->getPrefetchSize() > 0 && !this->consumerInfo->isBrowser()) {
+
+        this->internal->prefetchController.reset(new AdaptivePrefetchController(
+            this->consumerInfo->getPrefetchSize(), session->getConnection()->getAdaptivePrefetchTargetLatency(),
+            AdaptivePrefetchController::DEFAULT_SAMPLE_INTERVAL, System::currentTimeMillis()));
+    }
+
+    this->internal->metrics.getPrefetchSize().set(this->consumerInfo->getPrefetchSize());
+    this->internal->metrics.getAckBatchSize().set((int) Math::ceil(getAckThreshold()));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -953,7 +982,11 @@ decaf::lang::Pointer<MessageDispatch> ActiveMQConsumerKernel::dequeue(long long
         // Loop until the time is up or we get a non-expired message
         while (true) {
 
-            Pointer<MessageDispatch> dispatch = this->internal->unconsumedMessages->dequeue(timeout);
+            Pointer<MessageDispatch> dispatch = busyPoll(timeout);
+            if (dispatch == NULL) {
+                dispatch = this->internal->unconsumedMessages->dequeue(timeout);
+            }
+
             if (dispatch == NULL) {
                 if (timeout > 0 && !this->internal->unconsumedMessages->isClosed()) {
                     timeout = Math::max(deadline - System::currentTimeMillis(), 0LL);
@@ -988,6 +1021,97 @@ decaf::lang::Pointer<MessageDispatch> ActiveMQConsumerKernel::dequeue(long long
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
 
+////////////////////////////////////////////////////////////////////////////////
+Pointer<MessageDispatch> ActiveMQConsumerKernel::busyPoll(long long timeout) {
+
+    if (this->internal->busyPollTime <= 0 || timeout == 0) {
+        return Pointer<MessageDispatch>();
+    }
+
+    // Spin on the channel rather than parking the thread so that a message arriving
+    // within the budget is handed over without a scheduler wake-up.
+    long long deadline = System::nanoTime() + this->internal->busyPollTime * 1000;
+    do {
+        Pointer<MessageDispatch> dispatch = this->internal->unconsumedMessages->dequeueNoWait();
+        if (dispatch != NULL) {
+            this->internal->busyPollSpinCount.increment();
+            return dispatch;
+        }
+    } while (!this->internal->unconsumedMessages->isClosed() && System::nanoTime() < deadline);
+
+    this->internal->busyPollWaitCount.increment();
+    return Pointer<MessageDispatch>();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector< Pointer<MessageDispatch> > ActiveMQConsumerKernel::dequeueBatch(long long timeout, int maxMessages) {
+
+    try {
+
+        // Calculate the deadline
+        long long deadline = 0;
+        if (timeout > 0) {
+            deadline = System::currentTimeMillis() + timeout;
+        }
+
+        std::vector< Pointer<MessageDispatch> > result;
+
+        // Loop until the time is up or we get at least one non-expired message
+        while (true) {
+
+            std::vector< Pointer<MessageDispatch> > batch =
+                this->internal->unconsumedMessages->dequeueBatch(timeout, maxMessages);
+
+            if (batch.empty()) {
+                if (timeout > 0 && !this->internal->unconsumedMessages->isClosed()) {
+                    timeout = Math::max(deadline - System::currentTimeMillis(), 0LL);
+                    continue;
+                } else if (this->internal->failureError != NULL) {
+                    throw CMSExceptionSupport::create(*this->internal->failureError);
+                }
+
+                return result;
+            }
+
+            for (std::size_t i = 0; i < batch.size(); ++i) {
+
+                Pointer<MessageDispatch> dispatch = batch[i];
+
+                if (dispatch->getMessage() == NULL) {
+                    // End of browse marker, if we already have messages then it goes back
+                    // so the next receive call sees it, anything behind it always goes back.
+                    std::size_t first = result.empty() ? i + 1 : i;
+                    for (std::size_t j = batch.size(); j > first; --j) {
+                        this->internal->unconsumedMessages->enqueueFirst(batch[j - 1]);
+                    }
+
+                    return result;
+                } else if (dispatch->getMessage()->isExpired()) {
+                    beforeMessageIsConsumed(dispatch);
+                    afterMessageIsConsumed(dispatch, true);
+                    continue;
+                }
+
+                result.push_back(dispatch);
+            }
+
+            if (!result.empty()) {
+                return result;
+            }
+
+            if (timeout > 0) {
+                timeout = Math::max(deadline - System::currentTimeMillis(), 0LL);
+            }
+        }
+
+        return result;
+    } catch (InterruptedException& ex) {
+        Thread::currentThread()->interrupt();
+        throw CMSExceptionSupport::create(ex);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 cms::Message* ActiveMQConsumerKernel::receive() {
 
@@ -1069,6 +1193,62 @@ cms::Message* ActiveMQConsumerKernel::receiveNoWait() {
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
 
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQConsumerKernel::receiveBatch(std::vector<cms::Message*>& messages, int maxMessages, int millisecs) {
+
+    try {
+
+        this->checkClosed();
+        this->checkMessageListener();
+
+        if (maxMessages <= 0) {
+            throw IllegalArgumentException(__FILE__, __LINE__,
+                "Batch size must be greater than zero, was: %d", maxMessages);
+        }
+
+        long long timeout = millisecs < 0 ? -1 : millisecs;
+
+        // Send a request for a new message if needed, a pull uses zero to wait
+        // forever and -1 to not wait at all.
+        this->sendPullRequest(timeout < 0 ? 0 : (timeout == 0 ? -1 : timeout));
+
+        // Wait for the first message and take whatever else is ready along with it.
+        std::vector< Pointer<MessageDispatch> > batch = dequeueBatch(timeout, maxMessages);
+        if (batch.empty()) {
+            return 0;
+        }
+
+        beforeMessagesAreConsumed(batch);
+        afterMessagesAreConsumed(batch);
+
+        // Need to clone the messages because the user is responsible for freeing
+        // its copy of the message, createCMSMessage will do this for us.  The copies
+        // are only handed over once all of them exist so a failure part way through
+        // doesn't leave the caller with some of the batch and leak the rest.
+        std::vector<cms::Message*> received;
+        received.reserve(batch.size());
+        messages.reserve(messages.size() + batch.size());
+
+        try {
+            std::vector< Pointer<MessageDispatch> >::const_iterator iter = batch.begin();
+            for (; iter != batch.end(); ++iter) {
+                received.push_back(createCMSMessage(*iter).release());
+            }
+        } catch (...) {
+            std::vector<cms::Message*>::const_iterator iter = received.begin();
+            for (; iter != received.end(); ++iter) {
+                delete *iter;
+            }
+            throw;
+        }
+
+        messages.insert(messages.end(), received.begin(), received.end());
+
+        return (int) received.size();
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQConsumerKernel::setMessageListener(cms::MessageListener* listener) {
 
@@ -1109,6 +1289,12 @@ void ActiveMQConsumerKernel::setMessageListener(cms::MessageListener* listener)
 
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQConsumerKernel::beforeMessageIsConsumed(Pointer<MessageDispatch> dispatch) {
+
+    const Pointer<MessageTrace>& trace = dispatch->getMessage()->getTrace();
+    if (trace != NULL) {
+        trace->mark(MessageTrace::CONSUMER_DELIVER);
+    }
+
     this->internal->lastDeliveredSequenceId = dispatch->getMessage()->getMessageId()->getBrokerSequenceId();
 
     if (!isAutoAcknowledgeBatch()) {
@@ -1128,6 +1314,46 @@ void ActiveMQConsumerKernel::beforeMessageIsConsumed(Pointer<MessageDispatch> di
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConsumerKernel::beforeMessagesAreConsumed(const std::vector< Pointer<MessageDispatch> >& dispatches) {
+
+    if (dispatches.empty()) {
+        return;
+    }
+
+    std::vector< Pointer<MessageDispatch> >::const_iterator iter;
+
+    for (iter = dispatches.begin(); iter != dispatches.end(); ++iter) {
+        const Pointer<MessageTrace>& trace = (*iter)->getMessage()->getTrace();
+        if (trace != NULL) {
+            trace->mark(MessageTrace::CONSUMER_DELIVER);
+        }
+    }
+
+    this->internal->lastDeliveredSequenceId =
+        dispatches.back()->getMessage()->getMessageId()->getBrokerSequenceId();
+
+    if (!isAutoAcknowledgeBatch()) {
+
+        synchronized(&this->internal->dispatchedMessages) {
+            for (iter = dispatches.begin(); iter != dispatches.end(); ++iter) {
+                this->internal->dispatchedMessages.addFirst(*iter);
+            }
+        }
+
+        if (this->session->isTransacted()) {
+            if (this->internal->transactedIndividualAck) {
+                for (iter = dispatches.begin(); iter != dispatches.end(); ++iter) {
+                    immediateIndividualTransactedAck(*iter);
+                }
+            } else {
+                ackLater(dispatches.front(), dispatches.back(),
+                         ActiveMQConstants::ACK_TYPE_DELIVERED, (int) dispatches.size());
+            }
+        }
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQConsumerKernel::immediateIndividualTransactedAck(Pointer<MessageDispatch> dispatch) {
     // acks accumulate on the broker pending transaction completion to indicate delivery status
@@ -1153,11 +1379,23 @@ void ActiveMQConsumerKernel::registerSync() {
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQConsumerKernel::afterMessageIsConsumed(Pointer<MessageDispatch> message, bool messageExpired ) {
 
+    Pointer<MessageTrace> trace = message->getMessage()->getTrace();
+    if (trace != NULL) {
+        // Only complete the trace once, a redelivery of the message isn't traced.
+        message->getMessage()->setTrace(Pointer<MessageTrace>());
+        trace->mark(MessageTrace::CONSUMER_COMPLETE);
+        this->session->getConnection()->getConnectionMetrics().getMessageTracer().complete(*trace);
+    }
+
     try {
 
         if (this->internal->unconsumedMessages->isClosed()) {
             return;
-        } else if (messageExpired) {
+        }
+
+        adaptPrefetch(1);
+
+        if (messageExpired) {
             acknowledge(message, ActiveMQConstants::ACK_TYPE_DELIVERED);
             return;
         } else if (session->isTransacted()) {
@@ -1165,45 +1403,7 @@ void ActiveMQConsumerKernel::afterMessageIsConsumed(Pointer<MessageDispatch> mes
         }
 
         if (isAutoAcknowledgeEach()) {
-            if (this->internal->deliveringAcks.compareAndSet(false, true)) {
-                synchronized(&this->internal->dispatchedMessages) {
-                    if (!this->internal->dispatchedMessages.isEmpty()) {
-                        if (this->internal->optimizeAcknowledge) {
-
-                            this->internal->ackCounter++;
-                            if (this->internal->isTimeForOptimizedAck(this->consumerInfo->getPrefetchSize())) {
-                                Pointer<MessageAck> ack =
-                                    makeAckForAllDeliveredMessages(ActiveMQConstants::ACK_TYPE_CONSUMED);
-                                if (ack != NULL) {
-                                    this->internal->dispatchedMessages.clear();
-                                    this->internal->ackCounter = 0;
-                                    this->session->sendAck(ack);
-                                    this->internal->optimizeAckTimestamp = System::currentTimeMillis();
-                                }
-
-                                // As further optimization send ack for expired messages when there
-                                // are any. This resets the deliveredCounter to 0 so that we won't
-                                // send standard acks with every message just because the deliveredCounter
-                                // just below 0.5 * prefetch as used in ackLater()
-                                if (this->internal->pendingAck != NULL && this->internal->deliveredCounter > 0) {
-                                    this->session->sendAck(this->internal->pendingAck);
-                                    this->internal->pendingAck.reset(NULL);
-                                    this->internal->deliveredCounter = 0;
-                                }
-                            }
-                        } else {
-                            Pointer<MessageAck> ack =
-                                makeAckForAllDeliveredMessages(ActiveMQConstants::ACK_TYPE_CONSUMED);
-                            if (ack != NULL) {
-                                this->internal->dispatchedMessages.clear();
-                                session->sendAck(ack);
-                            }
-                        }
-                    }
-                }
-
-                this->internal->deliveringAcks.set(false);
-            }
+            ackConsumedMessages(1);
         } else if (isAutoAcknowledgeBatch()) {
             ackLater(message, ActiveMQConstants::ACK_TYPE_CONSUMED);
         } else if (session->isClientAcknowledge() || session->isIndividualAcknowledge()) {
@@ -1224,6 +1424,97 @@ void ActiveMQConsumerKernel::afterMessageIsConsumed(Pointer<MessageDispatch> mes
     AMQ_CATCHALL_THROW(ActiveMQException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConsumerKernel::afterMessagesAreConsumed(const std::vector< Pointer<MessageDispatch> >& dispatches) {
+
+    std::vector< Pointer<MessageDispatch> >::const_iterator iter;
+    for (iter = dispatches.begin(); iter != dispatches.end(); ++iter) {
+        Pointer<MessageTrace> trace = (*iter)->getMessage()->getTrace();
+        if (trace != NULL) {
+            // Only complete the trace once, a redelivery of the message isn't traced.
+            (*iter)->getMessage()->setTrace(Pointer<MessageTrace>());
+            trace->mark(MessageTrace::CONSUMER_COMPLETE);
+            this->session->getConnection()->getConnectionMetrics().getMessageTracer().complete(*trace);
+        }
+    }
+
+    try {
+
+        if (dispatches.empty() || this->internal->unconsumedMessages->isClosed()) {
+            return;
+        }
+
+        adaptPrefetch((int) dispatches.size());
+
+        if (session->isTransacted()) {
+            return;
+        }
+
+        // The whole batch is covered by a single ack whose range runs from the
+        // first message to the last one in the batch.
+        int count = (int) dispatches.size();
+
+        if (isAutoAcknowledgeEach()) {
+            ackConsumedMessages(count);
+        } else if (isAutoAcknowledgeBatch()) {
+            ackLater(dispatches.front(), dispatches.back(), ActiveMQConstants::ACK_TYPE_CONSUMED, count);
+        } else if (session->isClientAcknowledge() || session->isIndividualAcknowledge()) {
+            ackLater(dispatches.front(), dispatches.back(), ActiveMQConstants::ACK_TYPE_DELIVERED, count);
+        } else {
+            throw IllegalStateException(__FILE__, __LINE__, "Invalid Session State");
+        }
+    }
+    AMQ_CATCH_RETHROW(ActiveMQException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, ActiveMQException)
+    AMQ_CATCHALL_THROW(ActiveMQException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConsumerKernel::ackConsumedMessages(int consumed) {
+
+    if (this->internal->deliveringAcks.compareAndSet(false, true)) {
+        synchronized(&this->internal->dispatchedMessages) {
+            if (!this->internal->dispatchedMessages.isEmpty()) {
+                if (this->internal->optimizeAcknowledge) {
+
+                    this->internal->ackCounter += consumed;
+                    int prefetchSize = this->internal->prefetchController != NULL ?
+                        this->internal->prefetchController->getPrefetchSize() : this->consumerInfo->getPrefetchSize();
+                    if (this->internal->isTimeForOptimizedAck(prefetchSize)) {
+                        Pointer<MessageAck> ack =
+                            makeAckForAllDeliveredMessages(ActiveMQConstants::ACK_TYPE_CONSUMED);
+                        if (ack != NULL) {
+                            this->internal->dispatchedMessages.clear();
+                            this->internal->ackCounter = 0;
+                            this->session->sendAck(ack);
+                            this->internal->optimizeAckTimestamp = System::currentTimeMillis();
+                        }
+
+                        // As further optimization send ack for expired messages when there
+                        // are any. This resets the deliveredCounter to 0 so that we won't
+                        // send standard acks with every message just because the deliveredCounter
+                        // just below 0.5 * prefetch as used in ackLater()
+                        if (this->internal->pendingAck != NULL && this->internal->deliveredCounter > 0) {
+                            this->session->sendAck(this->internal->pendingAck);
+                            this->internal->pendingAck.reset(NULL);
+                            this->internal->deliveredCounter = 0;
+                        }
+                    }
+                } else {
+                    Pointer<MessageAck> ack =
+                        makeAckForAllDeliveredMessages(ActiveMQConstants::ACK_TYPE_CONSUMED);
+                    if (ack != NULL) {
+                        this->internal->dispatchedMessages.clear();
+                        session->sendAck(ack);
+                    }
+                }
+            }
+        }
+
+        this->internal->deliveringAcks.set(false);
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQConsumerKernel::deliverAcks() {
 
@@ -1266,6 +1557,11 @@ void ActiveMQConsumerKernel::deliverAcks() {
 
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQConsumerKernel::ackLater(Pointer<MessageDispatch> dispatch, int ackType) {
+    ackLater(dispatch, dispatch, ackType, 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConsumerKernel::ackLater(Pointer<MessageDispatch> first, Pointer<MessageDispatch> last, int ackType, int count) {
 
     // Don't acknowledge now, but we may need to let the broker know the
     // consumer got the message to expand the pre-fetch window
@@ -1275,13 +1571,13 @@ void ActiveMQConsumerKernel::ackLater(Pointer<MessageDispatch> dispatch, int ack
 
     // The delivered message list is only needed for the recover method
     // which is only used with client ack.
-    this->internal->deliveredCounter++;
+    this->internal->deliveredCounter += count;
 
     Pointer<MessageAck> oldPendingAck = this->internal->pendingAck;
-    this->internal->pendingAck.reset(new MessageAck(dispatch, ackType, internal->deliveredCounter));
+    this->internal->pendingAck.reset(new MessageAck(last, ackType, internal->deliveredCounter));
 
     if (oldPendingAck == NULL) {
-        this->internal->pendingAck->setFirstMessageId(this->internal->pendingAck->getLastMessageId());
+        this->internal->pendingAck->setFirstMessageId(first->getMessage()->getMessageId());
     } else if (oldPendingAck->getAckType() == this->internal->pendingAck->getAckType()) {
         this->internal->pendingAck->setFirstMessageId(oldPendingAck->getFirstMessageId());
     } else {
@@ -1298,7 +1594,7 @@ void ActiveMQConsumerKernel::ackLater(Pointer<MessageDispatch> dispatch, int ack
 
     // Need to evaluate both expired and normal messages as otherwise consumer may get stalled
     int pendingAcks = (internal->deliveredCounter + internal->ackCounter) - internal->additionalWindowSize;
-    if ((0.5 * this->consumerInfo->getPrefetchSize()) <= pendingAcks) {
+    if (getAckThreshold() <= pendingAcks) {
         session->sendAck(this->internal->pendingAck);
         this->internal->pendingAck.reset(NULL);
         this->internal->deliveredCounter = 0;
@@ -1306,6 +1602,47 @@ void ActiveMQConsumerKernel::ackLater(Pointer<MessageDispatch> dispatch, int ack
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+double ActiveMQConsumerKernel::getAckThreshold() const {
+
+    if (this->internal->prefetchController != NULL) {
+        return this->internal->prefetchController->getAckBatchSize();
+    }
+
+    return 0.5 * this->consumerInfo->getPrefetchSize();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConsumerKernel::adaptPrefetch(int consumed) {
+
+    Pointer<AdaptivePrefetchController> controller = this->internal->prefetchController;
+    if (controller == NULL) {
+        return;
+    }
+
+    controller->onMessagesConsumed(consumed);
+    bool changed = controller->evaluate(this->internal->unconsumedMessages->size(), System::currentTimeMillis());
+    this->internal->metrics.getConsumptionRate().set((int) controller->getConsumptionRate());
+
+    if (!changed) {
+        return;
+    }
+
+    int prefetchSize = controller->getPrefetchSize();
+
+    Pointer<ConsumerControl> control(new ConsumerControl());
+    control->setConsumerId(this->consumerInfo->getConsumerId());
+    control->setDestination(this->consumerInfo->getDestination());
+    control->setPrefetch(prefetchSize);
+
+    this->consumerInfo->setCurrentPrefetchSize(prefetchSize);
+    this->session->oneway(control);
+
+    this->internal->metrics.getPrefetchAdjustments().increment();
+    this->internal->metrics.getPrefetchSize().set(prefetchSize);
+    this->internal->metrics.getAckBatchSize().set(controller->getAckBatchSize());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<MessageAck> ActiveMQConsumerKernel::makeAckForAllDeliveredMessages(int type) {
 
@@ -1436,6 +1773,9 @@ void ActiveMQConsumerKernel::rollback() {
             if (this->internal->redeliveryPolicy->getMaximumRedeliveries() != RedeliveryPolicy::NO_MAXIMUM_REDELIVERIES &&
                 lastMsg->getMessage()->getRedeliveryCounter() > this->internal->redeliveryPolicy->getMaximumRedeliveries()) {
 
+                LOGDECAF_WARN_1(logger, "Maximum redeliveries exceeded, sending poison ack for: ",
+                                lastMsg->getMessage()->getMessageId()->toString());
+
                 // We need to NACK the messages so that they get sent to the DLQ.
                 // Acknowledge the last message.
                 Pointer<MessageAck> ack(new MessageAck(lastMsg, ActiveMQConstants::ACK_TYPE_POISON,
@@ -1444,6 +1784,7 @@ void ActiveMQConsumerKernel::rollback() {
                 Pointer<BrokerError> cause(new BrokerError);
                 ack->setPoisonCause(cause);
                 session->sendAck(ack, true);
+                this->internal->metrics.getPoisonAcks().increment();
                 // Adjust the window size.
                 this->internal->additionalWindowSize = Math::max(0,
                     this->internal->additionalWindowSize - (int) this->internal->dispatchedMessages.size());
@@ -1454,6 +1795,11 @@ void ActiveMQConsumerKernel::rollback() {
 
             } else {
 
+                LOGDECAF_DEBUG_1(logger, "Redelivering " << this->internal->dispatchedMessages.size() <<
+                                 " messages after delay (ms): ", this->internal->redeliveryDelay);
+
+                this->internal->metrics.getMessagesRedelivered().add(this->internal->dispatchedMessages.size());
+
                 // only redelivery_ack after first delivery
                 if (currentRedeliveryCount > 0) {
                     Pointer<MessageAck> ack(new MessageAck(lastMsg, ActiveMQConstants::ACK_TYPE_REDELIVERED,
@@ -1522,6 +1868,11 @@ void ActiveMQConsumerKernel::dispatch(const Pointer<MessageDispatch>& dispatch)
 
                 if (this->consumerInfo->isBrowser() || !session->getConnection()->isDuplicate(this, dispatch->getMessage())) {
 
+                    if (dispatch->getMessage() != NULL) {
+                        this->internal->metrics.getMessagesReceived().increment();
+                        this->internal->metrics.getBytesReceived().add(dispatch->getMessage()->getSize());
+                    }
+
                     synchronized(&this->internal->listenerMutex) {
 
                         if (this->internal->listener != NULL && this->internal->unconsumedMessages->isRunning()) {
@@ -1571,6 +1922,9 @@ void ActiveMQConsumerKernel::dispatch(const Pointer<MessageDispatch>& dispatch)
                             }
                         }
                         if (needsPoisonAck) {
+                            LOGDECAF_WARN_1(logger, "Duplicate dispatch with redelivery pending elsewhere, sending poison ack for: ",
+                                            dispatch->getMessage()->getMessageId()->toString());
+
                             Pointer<MessageAck> poisonAck(new MessageAck(dispatch, ActiveMQConstants::ACK_TYPE_POISON, 1));
                             poisonAck->setFirstMessageId(dispatch->getMessage()->getMessageId());
                             Pointer<BrokerError> cause(new BrokerError);
@@ -1580,6 +1934,7 @@ void ActiveMQConsumerKernel::dispatch(const Pointer<MessageDispatch>& dispatch)
                                               this->session->getConnection()->getConnectionInfo().getConnectionId()->toString());
                             poisonAck->setPoisonCause(cause);
                             session->sendAck(poisonAck);
+                            this->internal->metrics.getPoisonAcks().increment();
                         } else {
                             if (this->internal->transactedIndividualAck) {
                                 immediateIndividualTransactedAck(dispatch);
@@ -1764,6 +2119,26 @@ int ActiveMQConsumerKernel::getMessageAvailableCount() const {
     return this->internal->unconsumedMessages->size();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+ConsumerMetrics& ActiveMQConsumerKernel::getConsumerMetrics() const {
+    return this->internal->metrics;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ConsumerMetricsSnapshot ActiveMQConsumerKernel::getMetricsSnapshot() const {
+
+    ConsumerMetricsSnapshot snapshot;
+
+    snapshot.consumerId = this->consumerInfo->getConsumerId()->toString();
+    this->internal->metrics.snapshot(snapshot);
+
+    // Messages waiting to be consumed plus those consumed but not yet acknowledged, the
+    // delivered count is read without the dispatch lock so it is only a sample.
+    snapshot.prefetchOccupancy = this->internal->unconsumedMessages->size() + this->internal->deliveredCounter;
+
+    return snapshot;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQConsumerKernel::applyDestinationOptions(Pointer<ConsumerInfo> info) {
 
@@ -1976,6 +2351,26 @@ bool ActiveMQConsumerKernel::isOptimizeAcknowledge() const {
     return this->internal->optimizeAcknowledge;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+long long ActiveMQConsumerKernel::getBusyPollTime() const {
+    return this->internal->busyPollTime;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConsumerKernel::setBusyPollTime(long long value) {
+    this->internal->busyPollTime = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long ActiveMQConsumerKernel::getBusyPollSpinCount() const {
+    return this->internal->busyPollSpinCount.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long ActiveMQConsumerKernel::getBusyPollWaitCount() const {
+    return this->internal->busyPollWaitCount.get();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQConsumerKernel::setOptimizeAcknowledge(bool value) {
     if (this->internal->optimizeAcknowledge && !value) {
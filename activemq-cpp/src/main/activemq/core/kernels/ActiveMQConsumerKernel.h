@@ -31,10 +31,13 @@
 #include <activemq/core/Dispatcher.h>
 #include <activemq/core/RedeliveryPolicy.h>
 #include <activemq/core/MessageDispatchChannel.h>
+#include <activemq/metrics/ConsumerMetrics.h>
+#include <activemq/metrics/MetricsSnapshot.h>
 
 #include <decaf/util/concurrent/atomic/AtomicBoolean.h>
 #include <decaf/lang/Pointer.h>
 #include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/logging/LoggerDefines.h>
 
 namespace activemq {
 namespace core {
@@ -54,6 +57,8 @@ namespace kernels {
          */
         ActiveMQConsumerKernelConfig* internal;
 
+        LOGDECAF_DECLARE(logger)
+
         /**
          * The ActiveMQSession that owns this class instance.
          */
@@ -99,6 +104,8 @@ namespace kernels {
 
         virtual cms::Message* receiveNoWait();
 
+        virtual int receiveBatch(std::vector<cms::Message*>& messages, int maxMessages, int millisecs);
+
         virtual void setMessageListener(cms::MessageListener* listener);
 
         virtual cms::MessageListener* getMessageListener() const;
@@ -275,6 +282,19 @@ namespace kernels {
          */
         int getMessageAvailableCount() const;
 
+        /**
+         * @returns the metrics that this Consumer records its deliveries into.
+         */
+        metrics::ConsumerMetrics& getConsumerMetrics() const;
+
+        /**
+         * Takes a snapshot of the metrics of this Consumer, the prefetch occupancy is
+         * sampled at the time of the call.
+         *
+         * @returns a snapshot of the metrics of this Consumer.
+         */
+        metrics::ConsumerMetricsSnapshot getMetricsSnapshot() const;
+
         /**
          * Sets the RedeliveryPolicy this Consumer should use when a rollback is
          * performed on a transacted Consumer.  The Consumer takes ownership of the
@@ -354,6 +374,34 @@ namespace kernels {
          */
         void setOptimizeAcknowledge(bool value);
 
+        /**
+         * Gets the time in microseconds that a synchronous receive spins waiting for a
+         * Message before it blocks, zero means the receive blocks right away.
+         *
+         * @returns the busy poll time in microseconds.
+         */
+        long long getBusyPollTime() const;
+
+        /**
+         * Sets the time in microseconds that a synchronous receive spins waiting for a
+         * Message before it blocks.  Spinning trades a processor for lower latency since
+         * a Message that arrives while spinning is received without waking the thread.
+         *
+         * @param value
+         *      The busy poll time in microseconds, zero or less disables spinning.
+         */
+        void setBusyPollTime(long long value);
+
+        /**
+         * @returns the number of receives that got a Message while spinning.
+         */
+        long long getBusyPollSpinCount() const;
+
+        /**
+         * @returns the number of receives whose spin ran out and had to block.
+         */
+        long long getBusyPollWaitCount() const;
+
     protected:
 
         /**
@@ -386,6 +434,31 @@ namespace kernels {
          */
         void afterMessageIsConsumed(Pointer<commands::MessageDispatch> dispatch, bool messageExpired);
 
+        /**
+         * Used by the batch receive method to wait for up to maxMessages messages, the
+         * wait for the first message follows the same rules as dequeue, once one arrives
+         * the others that are already available are taken with it.
+         *
+         * @param timeout - The maximum number of milliseconds to wait for the first message.
+         * @param maxMessages - The maximum number of messages to return.
+         *
+         * @return the non-expired messages in delivery order, empty if none arrived in time.
+         */
+        std::vector< Pointer<commands::MessageDispatch> > dequeueBatch(long long timeout, int maxMessages);
+
+        /**
+         * Pre-consume processing for a batch of messages.
+         * @param dispatches - the messages being consumed in delivery order.
+         */
+        void beforeMessagesAreConsumed(const std::vector< Pointer<commands::MessageDispatch> >& dispatches);
+
+        /**
+         * Post-consume processing for a batch of messages, a single ack covering the
+         * whole batch is sent or scheduled according to the acknowledgement mode.
+         * @param dispatches - the consumed messages in delivery order.
+         */
+        void afterMessagesAreConsumed(const std::vector< Pointer<commands::MessageDispatch> >& dispatches);
+
     private:
 
         Pointer<cms::Message> createCMSMessage(Pointer<commands::MessageDispatch> dispatch);
@@ -398,8 +471,14 @@ namespace kernels {
 
         void checkMessageListener() const;
 
+        Pointer<commands::MessageDispatch> busyPoll(long long timeout);
+
         void ackLater(Pointer<commands::MessageDispatch> message, int ackType);
 
+        void ackLater(Pointer<commands::MessageDispatch> first, Pointer<commands::MessageDispatch> last, int ackType, int count);
+
+        void ackConsumedMessages(int consumed);
+
         void immediateIndividualTransactedAck(Pointer<commands::MessageDispatch> dispatch);
 
         Pointer<commands::MessageAck> makeAckForAllDeliveredMessages(int type);
@@ -412,6 +491,13 @@ namespace kernels {
 
         void clearDispatchList();
 
+        // Feeds consumed messages to the adaptive prefetch controller, if there is one, and
+        // tells the Broker about any change of prefetch size it makes.
+        void adaptPrefetch(int consumed);
+
+        // The number of consumed messages after which a batch of acks is sent.
+        double getAckThreshold() const;
+
     };
 
 }}}
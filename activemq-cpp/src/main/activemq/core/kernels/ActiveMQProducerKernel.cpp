@@ -20,6 +20,7 @@
 #include <cms/Message.h>
 #include <activemq/core/kernels/ActiveMQSessionKernel.h>
 #include <activemq/core/ActiveMQConnection.h>
+#include <activemq/core/ProducerMessageTemplate.h>
 #include <activemq/commands/RemoveInfo.h>
 #include <activemq/util/CMSExceptionSupport.h>
 #include <activemq/util/ActiveMQProperties.h>
@@ -37,10 +38,47 @@ using namespace activemq::core;
 using namespace activemq::core::kernels;
 using namespace activemq::commands;
 using namespace activemq::exceptions;
+using namespace activemq::metrics;
 using namespace decaf::util;
 using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
 
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // Handed to the session for a send that isn't traced so that no Pointer has
+    // to be created for it, it is only ever passed by reference.
+    const Pointer<MessageTrace> NO_TRACE;
+
+    // Passes the wake-up on to the next sender blocked on the producer window once
+    // a send leaves doSend, whether the send completed or threw, otherwise the other
+    // waiters in the queue would never be released.
+    class NextWaiterSignaller {
+    private:
+
+        MemoryUsage* usage;
+
+    private:
+
+        NextWaiterSignaller(const NextWaiterSignaller&);
+        NextWaiterSignaller& operator=(const NextWaiterSignaller&);
+
+    public:
+
+        NextWaiterSignaller(MemoryUsage* usage) : usage(usage) {}
+
+        ~NextWaiterSignaller() {
+            try {
+                if (this->usage != NULL) {
+                    this->usage->signalNextWaiter();
+                }
+            } catch (...) {
+            }
+        }
+    };
+
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ActiveMQProducerKernel::ActiveMQProducerKernel(ActiveMQSessionKernel* session,
                                                const Pointer<commands::ProducerId>& producerId,
@@ -57,7 +95,8 @@ ActiveMQProducerKernel::ActiveMQProducerKernel(ActiveMQSessionKernel* session,
                                                                         memoryUsage(),
                                                                         destination(),
                                                                         messageSequence(),
-                                                                        transformer() {
+                                                                        transformer(),
+                                                                        metrics() {
 
     if (session == NULL || producerId == NULL) {
         throw ActiveMQException(
@@ -81,8 +120,12 @@ ActiveMQProducerKernel::ActiveMQProducerKernel(ActiveMQSessionKernel* session,
         this->destination = destination.dynamicCast<cms::Destination>();
     }
 
-    // TODO - Check for need of MemoryUsage if there's a producer Windows size
-    //        and the Protocol version is greater than 3.
+    // The Broker only returns ProducerAcks when a window size was requested and the
+    // OpenWire version is greater than 3, without them the window would never drain
+    // so it is only created in that case.
+    if (this->producerInfo->getWindowSize() > 0 && session->getConnection()->getProtocolVersion() > 3) {
+        this->memoryUsage.reset(new MemoryUsage(this->producerInfo->getWindowSize()));
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -210,6 +253,35 @@ void ActiveMQProducerKernel::send(const cms::Destination* destination, cms::Mess
 
         this->checkClosed();
 
+        MessageTracer& tracer = this->session->getConnection()->getConnectionMetrics().getMessageTracer();
+        if (!tracer.isEnabled()) {
+            this->doSend(destination, message, deliveryMode, priority, timeToLive, onComplete, NO_TRACE);
+            return;
+        }
+
+        Pointer<MessageTrace> trace = tracer.sample();
+        if (trace != NULL) {
+            trace->mark(MessageTrace::PRODUCER_SEND);
+        }
+
+        this->doSend(destination, message, deliveryMode, priority, timeToLive, onComplete, trace);
+
+        if (trace != NULL) {
+            tracer.complete(*trace);
+        }
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQProducerKernel::doSend(const cms::Destination* destination, cms::Message* message,
+                                    int deliveryMode, int priority, long long timeToLive, cms::AsyncCallback* onComplete,
+                                    const Pointer<MessageTrace>& trace) {
+
+    try {
+
+        long long start = System::nanoTime();
+
         if (destination == NULL) {
 
             if (this->producerInfo->getDestination() == NULL) {
@@ -257,20 +329,169 @@ void ActiveMQProducerKernel::send(const cms::Destination* destination, cms::Mess
             }
         }
 
-        if (this->memoryUsage.get() != NULL) {
-            try {
-                this->memoryUsage->waitForSpace();
-            } catch (InterruptedException& e) {
-                throw cms::CMSException("Send aborted due to thread interrupt.");
-            }
-        }
+        this->waitForWindowSpace();
+
+        // A synchronous send doesn't take up window space, let the next blocked sender go
+        // once this one is done with, the same applies when the send fails.
+        NextWaiterSignaller signaller(this->memoryUsage.get());
 
         this->session->send(this, dest, outbound, deliveryMode, priority, timeToLive,
-                            this->memoryUsage.get(), this->sendTimeout, onComplete);
+                            this->memoryUsage.get(), this->sendTimeout, onComplete, trace);
+
+        this->metrics.getMessagesSent().increment();
+        this->metrics.getSendLatency().recordSince(start);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ProducerMessageTemplate* ActiveMQProducerKernel::createMessageTemplate(const cms::Message* prototype,
+                                                                       const std::vector<std::string>& variableProperties) {
+
+    try {
+
+        this->checkClosed();
+
+        if (prototype == NULL) {
+            throw NullPointerException(__FILE__, __LINE__, "Prototype Message cannot be NULL");
+        }
+
+        // The prototype goes through the same transformation as a Message that is sent,
+        // a Message from another provider is converted and discarded after the copy.
+        commands::Message* transformed = NULL;
+        Pointer<commands::Message> scopedMessage;
+        if (ActiveMQMessageTransformation::transformMessage(
+                const_cast<cms::Message*>(prototype), this->session->getConnection(), &transformed)) {
+            scopedMessage.reset(transformed);
+        }
+
+        return new ProducerMessageTemplate(*transformed, variableProperties);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQProducerKernel::send(ProducerMessageTemplate* messageTemplate) {
+
+    try {
+        this->checkClosed();
+        this->send(messageTemplate, defaultDeliveryMode, defaultPriority, defaultTimeToLive);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQProducerKernel::send(ProducerMessageTemplate* messageTemplate, int deliveryMode, int priority, long long timeToLive) {
+
+    try {
+
+        this->checkClosed();
+
+        if (messageTemplate == NULL) {
+            throw NullPointerException(__FILE__, __LINE__, "Message template cannot be NULL");
+        }
+
+        if (this->producerInfo->getDestination() == NULL) {
+            throw cms::UnsupportedOperationException("A destination must be specified.", NULL);
+        }
+
+        // A MessageTransformer works on a cms::Message, so the template's Message is
+        // created up front and takes the normal send path.
+        if (this->transformer != NULL) {
+            Pointer<commands::Message> message = messageTemplate->createMessage(this->session->getConnection());
+            this->send(this->destination.get(), dynamic_cast<cms::Message*>(message.get()),
+                       deliveryMode, priority, timeToLive, NULL);
+            return;
+        }
+
+        MessageTracer& tracer = this->session->getConnection()->getConnectionMetrics().getMessageTracer();
+        if (!tracer.isEnabled()) {
+            this->doSend(messageTemplate, deliveryMode, priority, timeToLive, NO_TRACE);
+            return;
+        }
+
+        Pointer<MessageTrace> trace = tracer.sample();
+        if (trace != NULL) {
+            trace->mark(MessageTrace::PRODUCER_SEND);
+        }
+
+        this->doSend(messageTemplate, deliveryMode, priority, timeToLive, trace);
+
+        if (trace != NULL) {
+            tracer.complete(*trace);
+        }
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQProducerKernel::doSend(ProducerMessageTemplate* messageTemplate, int deliveryMode, int priority,
+                                    long long timeToLive, const Pointer<MessageTrace>& trace) {
+
+    try {
+
+        long long start = System::nanoTime();
+
+        this->waitForWindowSpace();
+
+        // A synchronous send doesn't take up window space, let the next blocked sender go
+        // once this one is done with, the same applies when the send fails.
+        NextWaiterSignaller signaller(this->memoryUsage.get());
+
+        this->session->send(this, this->producerInfo->getDestination(), messageTemplate, deliveryMode, priority,
+                            timeToLive, this->memoryUsage.get(), this->sendTimeout, NULL, trace);
+
+        this->metrics.getMessagesSent().increment();
+        this->metrics.getSendLatency().recordSince(start);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQProducerKernel::trySend(cms::Message* message) {
+
+    try {
+
+        checkClosed();
+
+        if (this->memoryUsage.get() != NULL && (this->memoryUsage->isFull() || this->memoryUsage->hasWaiters())) {
+            return false;
+        }
+
+        this->send(message);
+        return true;
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQProducerKernel::trySend(const cms::Destination* destination, cms::Message* message) {
+
+    try {
+
+        checkClosed();
+
+        if (this->memoryUsage.get() != NULL && (this->memoryUsage->isFull() || this->memoryUsage->hasWaiters())) {
+            return false;
+        }
+
+        this->send(destination, message);
+        return true;
     }
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
 
+////////////////////////////////////////////////////////////////////////////////
+ProducerMetricsSnapshot ActiveMQProducerKernel::getMetricsSnapshot() const {
+
+    ProducerMetricsSnapshot snapshot;
+
+    snapshot.producerId = this->producerInfo->getProducerId()->toString();
+    this->metrics.snapshot(snapshot);
+
+    return snapshot;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQProducerKernel::onProducerAck(const commands::ProducerAck& ack) {
 
@@ -285,6 +506,36 @@ void ActiveMQProducerKernel::onProducerAck(const commands::ProducerAck& ack) {
     AMQ_CATCHALL_THROW(ActiveMQException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQProducerKernel::resetProducerWindow() {
+
+    try{
+
+        if (this->memoryUsage.get() != NULL) {
+            this->memoryUsage->setUsage(0);
+        }
+    }
+    AMQ_CATCH_RETHROW(ActiveMQException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, ActiveMQException)
+    AMQ_CATCHALL_THROW(ActiveMQException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQProducerKernel::waitForWindowSpace() {
+
+    if (this->memoryUsage.get() != NULL) {
+        try {
+            if (this->memoryUsage->isFull()) {
+                long long blockStart = System::nanoTime();
+                this->memoryUsage->waitForSpace();
+                this->metrics.getWindowBlockTime().recordSince(blockStart);
+            }
+        } catch (InterruptedException& e) {
+            throw cms::CMSException("Send aborted due to thread interrupt.");
+        }
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQProducerKernel::checkClosed() const {
     if (closed) {
@@ -27,14 +27,22 @@
 #include <activemq/util/Config.h>
 #include <activemq/util/MemoryUsage.h>
 #include <activemq/util/LongSequenceGenerator.h>
+#include <activemq/metrics/ProducerMetrics.h>
+#include <activemq/metrics/MessageTrace.h>
+#include <activemq/metrics/MetricsSnapshot.h>
 #include <activemq/commands/ProducerInfo.h>
 #include <activemq/commands/ProducerAck.h>
 #include <activemq/exceptions/ActiveMQException.h>
 
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace activemq {
 namespace core {
+
+    class ProducerMessageTemplate;
+
 namespace kernels {
 
     using decaf::lang::Pointer;
@@ -83,6 +91,9 @@ namespace kernels {
         // Used to tranform Message before sending them to the CMS bus.
         cms::MessageTransformer* transformer;
 
+        // Send counts and timings for this producer.
+        metrics::ProducerMetrics metrics;
+
     private:
 
         ActiveMQProducerKernel(const ActiveMQProducerKernel&);
@@ -281,6 +292,13 @@ namespace kernels {
          */
         virtual void onProducerAck(const commands::ProducerAck& ack);
 
+        /**
+         * Clears the usage recorded against the producer window, waking any blocked
+         * senders.  Called when the Transport is interrupted or resumed since the
+         * Broker will never acknowledge the sends that were in flight at the time.
+         */
+        void resetProducerWindow();
+
         /**
          * Performs Producer object cleanup but doesn't attempt to send the Remove command
          * to the broker.  Called when the parent resource if closed first to avoid the message
@@ -296,11 +314,118 @@ namespace kernels {
             return this->messageSequence.getNextSequenceId();
         }
 
+        /**
+         * @returns the metrics that this Producer records its sends into.
+         */
+        metrics::ProducerMetrics& getProducerMetrics() {
+            return this->metrics;
+        }
+
+        /**
+         * @returns a snapshot of the metrics of this Producer.
+         */
+        metrics::ProducerMetricsSnapshot getMetricsSnapshot() const;
+
+        /**
+         * Sends the Message to the default Destination of this Producer unless the send
+         * window of this Producer is full, in which case the method returns at once rather
+         * than waiting for the Broker to acknowledge earlier sends.
+         *
+         * @param message
+         *      The Message to send.
+         *
+         * @returns true if the Message was sent, false if the send window was full.
+         *
+         * @throws CMSException if an error occurs while sending the message.
+         */
+        bool trySend(cms::Message* message);
+
+        /**
+         * Sends the Message to the given Destination unless the send window of this Producer
+         * is full, in which case the method returns at once rather than waiting for the Broker
+         * to acknowledge earlier sends.
+         *
+         * @param destination
+         *      The Destination to send the Message to.
+         * @param message
+         *      The Message to send.
+         *
+         * @returns true if the Message was sent, false if the send window was full.
+         *
+         * @throws CMSException if an error occurs while sending the message.
+         */
+        bool trySend(const cms::Destination* destination, cms::Message* message);
+
+        /**
+         * Creates a template for sending Messages that differ from the prototype only in
+         * the named properties and their body, the prototype is converted to the ActiveMQ
+         * Message format as it would be on send and then copied.
+         *
+         * @param prototype
+         *      The Message whose headers, properties and body the template starts from.
+         * @param variableProperties
+         *      The names of the properties that are set on the template for each send.
+         *
+         * @returns a new template which the caller owns.
+         *
+         * @throws CMSException if the template can't be created.
+         */
+        ProducerMessageTemplate* createMessageTemplate(const cms::Message* prototype,
+                                                       const std::vector<std::string>& variableProperties);
+
+        /**
+         * Sends the next Message of the template to the default Destination of this
+         * Producer using the default delivery mode, priority and time to live.
+         *
+         * @param messageTemplate
+         *      The template that creates the Message to send.
+         *
+         * @throws CMSException if an error occurs while sending the message.
+         */
+        void send(ProducerMessageTemplate* messageTemplate);
+
+        /**
+         * Sends the next Message of the template to the default Destination of this Producer.
+         *
+         * @param messageTemplate
+         *      The template that creates the Message to send.
+         * @param deliveryMode
+         *      The delivery mode to be used.
+         * @param priority
+         *      The priority for this message.
+         * @param timeToLive
+         *      The time to live value for this message in milliseconds.
+         *
+         * @throws CMSException if an error occurs while sending the message.
+         */
+        void send(ProducerMessageTemplate* messageTemplate, int deliveryMode, int priority, long long timeToLive);
+
+        /**
+         * @returns the send window of this Producer or NULL if no window size is configured.
+         */
+        const util::MemoryUsage* getProducerWindow() const {
+            return this->memoryUsage.get();
+        }
+
     private:
 
        // Checks for the closed state and throws if so.
        void checkClosed() const;
 
+       // Blocks until the send window of this Producer has space, if it has one.
+       void waitForWindowSpace();
+
+       // Sends the Message once the caller has decided whether it is traced, the trace
+       // is NULL when it isn't.
+       void doSend(const cms::Destination* destination, cms::Message* message, int deliveryMode,
+                   int priority, long long timeToLive, cms::AsyncCallback* onComplete,
+                   const Pointer<metrics::MessageTrace>& trace);
+
+       // Sends a Message built from the template once the caller has decided whether it
+       // is traced, the trace is NULL when it isn't.
+       void doSend(ProducerMessageTemplate* messageTemplate, int deliveryMode, int priority,
+                   long long timeToLive, const Pointer<metrics::MessageTrace>& trace);
+
     };
 
 }}}
@@ -17,6 +17,7 @@
 
 #include "ActiveMQSessionKernel.h"
 
+#include <cms/AsyncCallback.h>
 #include <activemq/exceptions/ActiveMQException.h>
 #include <activemq/core/ActiveMQConstants.h>
 #include <activemq/core/ActiveMQConnection.h>
@@ -26,6 +27,7 @@
 #include <activemq/core/ActiveMQQueueBrowser.h>
 #include <activemq/core/ActiveMQSessionExecutor.h>
 #include <activemq/core/PrefetchPolicy.h>
+#include <activemq/core/ProducerMessageTemplate.h>
 #include <activemq/util/ActiveMQProperties.h>
 #include <activemq/util/ActiveMQMessageTransformation.h>
 #include <activemq/util/CMSExceptionSupport.h>
@@ -53,13 +55,16 @@
 #include <decaf/lang/Runnable.h>
 #include <decaf/lang/Long.h>
 #include <decaf/lang/Math.h>
+#include <decaf/lang/Thread.h>
 #include <decaf/util/Queue.h>
 #include <decaf/util/LinkedList.h>
 #include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
 #include <decaf/util/concurrent/atomic/AtomicBoolean.h>
-#include <decaf/util/concurrent/locks/ReentrantReadWriteLock.h>
+#include <decaf/util/concurrent/locks/StripedReadWriteLock.h>
 #include <decaf/lang/exceptions/InvalidStateException.h>
 #include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/lang/exceptions/InterruptedException.h>
 
 using namespace std;
 using namespace activemq;
@@ -69,6 +74,7 @@ using namespace activemq::core::kernels;
 using namespace activemq::commands;
 using namespace activemq::exceptions;
 using namespace activemq::threads;
+using namespace activemq::metrics;
 using namespace decaf::util;
 using namespace decaf::util::concurrent;
 using namespace decaf::util::concurrent::atomic;
@@ -91,22 +97,23 @@ namespace kernels{
     public:
 
         AtomicBoolean synchronizationRegistered;
-        decaf::util::concurrent::locks::ReentrantReadWriteLock producerLock;
+        decaf::util::concurrent::locks::StripedReadWriteLock producerLock;
         decaf::util::LinkedList< Pointer<ActiveMQProducerKernel> > producers;
-        decaf::util::concurrent::locks::ReentrantReadWriteLock consumerLock;
+        decaf::util::concurrent::locks::StripedReadWriteLock consumerLock;
         decaf::util::LinkedList< Pointer<ActiveMQConsumerKernel> > consumers;
         Pointer<Scheduler> scheduler;
         Pointer<CloseSynhcronization> closeSync;
         Mutex sendMutex;
         cms::MessageTransformer* transformer;
         int hashCode;
+        SessionMetrics metrics;
 
     public:
 
         SessionConfig() : synchronizationRegistered(false),
                           producerLock(), producers(), consumerLock(), consumers(),
                           scheduler(), closeSync(), sendMutex(), transformer(NULL),
-                          hashCode() {}
+                          hashCode(), metrics() {}
         ~SessionConfig() {}
     };
 
@@ -186,6 +193,50 @@ namespace kernels{
         }
     };
 
+    /**
+     * Tracks the broker's response to one ConsumerInfo sent as part of a bulk consumer
+     * creation, the shared latch is counted down once the outcome is known.
+     */
+    class ConsumerCreationCallback : public cms::AsyncCallback {
+    private:
+
+        CountDownLatch* latch;
+        Pointer<cms::CMSException> error;
+
+        // A request that fails on a closed transport is completed by the correlator
+        // and then throws, only the first completion may count down the latch.
+        AtomicBoolean completed;
+
+    private:
+
+        ConsumerCreationCallback(const ConsumerCreationCallback&);
+        ConsumerCreationCallback& operator=(const ConsumerCreationCallback&);
+
+    public:
+
+        ConsumerCreationCallback(CountDownLatch* latch) : cms::AsyncCallback(), latch(latch), error(), completed() {
+        }
+
+        virtual ~ConsumerCreationCallback() {}
+
+        virtual void onSuccess() {
+            if (this->completed.compareAndSet(false, true)) {
+                this->latch->countDown();
+            }
+        }
+
+        virtual void onException(const cms::CMSException& ex) {
+            if (this->completed.compareAndSet(false, true)) {
+                this->error.reset(new cms::CMSException(ex));
+                this->latch->countDown();
+            }
+        }
+
+        Pointer<cms::CMSException> getError() const {
+            return this->error;
+        }
+    };
+
 }}}
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -359,6 +410,14 @@ void ActiveMQSessionKernel::dispose() {
         // Stop the dispatch executor.
         stop();
 
+        // Give any asynchronous commits a chance to complete so that their callbacks
+        // and consumer synchronizations see the real outcome.
+        try {
+            this->transaction->awaitAsyncCommits(this->connection->getCloseTimeout());
+        } catch (cms::CMSException& ex) {
+            /* Absorb */
+        }
+
         // Roll Back the transaction since we were closed without an explicit call
         // to commit it.
         if (this->transaction->isInTransaction()) {
@@ -431,6 +490,26 @@ void ActiveMQSessionKernel::commit() {
 
         // Commit the Transaction
         this->transaction->commit();
+        this->config->metrics.getTransactionsCommitted().increment();
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionKernel::commit(cms::AsyncCallback* onComplete) {
+
+    try {
+
+        this->checkClosed();
+
+        if (!this->isTransacted()) {
+            throw ActiveMQException(
+                __FILE__, __LINE__, "ActiveMQSessionKernel::commit - This Session is not Transacted");
+        }
+
+        // Commit the Transaction without waiting on the Broker
+        this->transaction->commit(onComplete);
+        this->config->metrics.getTransactionsCommitted().increment();
     }
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
@@ -449,6 +528,7 @@ void ActiveMQSessionKernel::rollback() {
 
         // Roll back the Transaction
         this->transaction->rollback();
+        this->config->metrics.getTransactionsRolledBack().increment();
     }
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
@@ -652,6 +732,117 @@ cms::MessageConsumer* ActiveMQSessionKernel::createDurableConsumer(const cms::To
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
 
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQSessionKernel::createConsumers(const std::vector<const cms::Destination*>& destinations,
+                                           const std::string& selector, bool noLocal,
+                                           std::vector<cms::MessageConsumer*>& consumers,
+                                           std::vector< Pointer<cms::CMSException> >& errors) {
+
+    try {
+
+        this->checkClosed();
+
+        std::size_t count = destinations.size();
+
+        consumers.assign(count, (cms::MessageConsumer*) NULL);
+        errors.assign(count, Pointer<cms::CMSException>());
+
+        std::vector< Pointer<ActiveMQConsumerKernel> > kernels(count);
+        std::vector< Pointer<ConsumerCreationCallback> > callbacks(count);
+        CountDownLatch latch((int) count);
+
+        // Send every ConsumerInfo without waiting on the broker in between, each
+        // callback records the outcome of its own consumer.
+        for (std::size_t i = 0; i < count; ++i) {
+
+            callbacks[i].reset(new ConsumerCreationCallback(&latch));
+
+            try {
+
+                const ActiveMQDestination* amqDestination =
+                    dynamic_cast<const ActiveMQDestination*>(destinations[i]);
+
+                if (amqDestination == NULL) {
+                    throw ActiveMQException(__FILE__, __LINE__, "Destination was either NULL or not created by this CMS Client");
+                }
+
+                Pointer<ActiveMQDestination> dest(amqDestination->cloneDataStructure());
+
+                int prefetch = 0;
+                if (dest->isTopic()) {
+                    prefetch = this->connection->getPrefetchPolicy()->getTopicPrefetch();
+                } else {
+                    prefetch = this->connection->getPrefetchPolicy()->getQueuePrefetch();
+                }
+
+                kernels[i].reset(new ActiveMQConsumerKernel(this, this->getNextConsumerId(),
+                                                            dest, "", selector, prefetch, 0, noLocal,
+                                                            false, this->connection->isDispatchAsync(), NULL));
+
+                this->addConsumer(kernels[i]);
+                this->connection->asyncRequest(kernels[i]->getConsumerInfo(), callbacks[i].get());
+
+            } catch (cms::CMSException& ex) {
+                callbacks[i]->onException(ex);
+            } catch (Exception& ex) {
+                callbacks[i]->onException(ActiveMQException(ex).convertToCMSException());
+            }
+        }
+
+        // The callbacks are referenced by the pending requests so we can't leave
+        // until all of them have completed, a failed transport completes them all.
+        bool interrupted = false;
+        while (latch.getCount() > 0) {
+            try {
+                latch.await();
+            } catch (InterruptedException& ex) {
+                interrupted = true;
+            }
+        }
+
+        if (interrupted) {
+            Thread::currentThread()->interrupt();
+        }
+
+        int created = 0;
+
+        for (std::size_t i = 0; i < count; ++i) {
+
+            Pointer<cms::CMSException> error = callbacks[i]->getError();
+
+            if (error == NULL) {
+                try {
+                    kernels[i]->setMessageTransformer(this->config->transformer);
+
+                    if (this->connection->isStarted()) {
+                        kernels[i]->start();
+                    }
+
+                    consumers[i] = new ActiveMQConsumer(kernels[i]);
+                    created++;
+                    continue;
+                } catch (cms::CMSException& ex) {
+                    error.reset(new cms::CMSException(ex));
+                } catch (Exception& ex) {
+                    error.reset(new cms::CMSException(ActiveMQException(ex).convertToCMSException()));
+                }
+            }
+
+            if (kernels[i] != NULL) {
+                try {
+                    this->removeConsumer(kernels[i]);
+                } catch (Exception& ex) {
+                }
+            }
+
+            errors[i] = error;
+        }
+
+        return created;
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 cms::MessageProducer* ActiveMQSessionKernel::createProducer( const cms::Destination* destination ) {
 
@@ -902,19 +1093,13 @@ bool ActiveMQSessionKernel::isTransacted() const {
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQSessionKernel::send(kernels::ActiveMQProducerKernel* producer, Pointer<commands::ActiveMQDestination> destination,
                                  cms::Message* message, int deliveryMode, int priority, long long timeToLive,
-                                 util::MemoryUsage* producerWindow, long long sendTimeout, cms::AsyncCallback* onComplete) {
+                                 util::MemoryUsage* producerWindow, long long sendTimeout, cms::AsyncCallback* onComplete,
+                                 const Pointer<MessageTrace>& trace) {
 
     try {
 
         this->checkClosed();
-
-        if (destination->isTemporary()) {
-            Pointer<ActiveMQTempDestination> tempDest = destination.dynamicCast<ActiveMQTempDestination>();
-            if (this->connection->isDeleted(tempDest)) {
-                throw cms::InvalidDestinationException(
-                    std::string("Cannot publish to a deleted Destination: ") + destination->toString());
-            }
-        }
+        this->checkDestinationNotDeleted(destination);
 
         synchronized(&this->config->sendMutex) {
 
@@ -922,7 +1107,6 @@ void ActiveMQSessionKernel::send(kernels::ActiveMQProducerKernel* producer, Poin
             // sent since the last commit, Broker is notified of a new TX.
             doStartTransaction();
 
-            Pointer<TransactionId> txId = this->transaction->getTransactionId();
             Pointer<ProducerInfo> producerInfo = producer->getProducerInfo();
             Pointer<ProducerId> producerId = producerInfo->getProducerId();
             long long sequenceId = producer->getNextMessageSequence();
@@ -964,6 +1148,9 @@ void ActiveMQSessionKernel::send(kernels::ActiveMQProducerKernel* producer, Poin
             if (ActiveMQMessageTransformation::transformMessage(message, connection, &transformed)) {
                 amqMessage.reset(transformed);
             } else {
+                // The properties are encoded on the original so that when it is sent to
+                // many destinations all of the copies share the one encoding.
+                transformed->marshalProperties();
                 amqMessage.reset(transformed->cloneDataStructure());
             }
 
@@ -971,39 +1158,112 @@ void ActiveMQSessionKernel::send(kernels::ActiveMQProducerKernel* producer, Poin
             message->setCMSMessageID(id->toString());
             message->setCMSDestination(destination.dynamicCast<cms::Destination>().get());
 
-            amqMessage->setMessageId(id);
-            amqMessage->getBrokerPath().clear();
-            amqMessage->setTransactionId(txId);
-            amqMessage->setConnection(this->connection);
+            this->doSend(producer, amqMessage, id, destination, producerWindow, sendTimeout, onComplete, trace);
+        }
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionKernel::send(kernels::ActiveMQProducerKernel* producer, Pointer<commands::ActiveMQDestination> destination,
+                                 ProducerMessageTemplate* messageTemplate, int deliveryMode, int priority, long long timeToLive,
+                                 util::MemoryUsage* producerWindow, long long sendTimeout, cms::AsyncCallback* onComplete,
+                                 const Pointer<MessageTrace>& trace) {
 
-            // destination format is provider specific so only set on transformed message
-            amqMessage->setDestination(destination);
+    try {
 
-            amqMessage->onSend();
-            amqMessage->setProducerId(producerId);
+        this->checkClosed();
+        this->checkDestinationNotDeleted(destination);
 
-            if (onComplete == NULL && sendTimeout <= 0 && !amqMessage->isResponseRequired() && !this->connection->isAlwaysSyncSend() &&
-                (!amqMessage->isPersistent() || this->connection->isUseAsyncSend() || amqMessage->getTransactionId() != NULL)) {
+        synchronized(&this->config->sendMutex) {
 
-                // No Response Required, send is asynchronous.
-                this->connection->oneway(amqMessage);
+            doStartTransaction();
 
-                if (producerWindow != NULL) {
-                    producerWindow->enqueueUsage(amqMessage->getSize());
-                }
+            long long sequenceId = producer->getNextMessageSequence();
 
-            } else {
-                if (sendTimeout > 0 && onComplete == NULL) {
-                    this->connection->syncRequest(amqMessage, (unsigned int)sendTimeout);
-                } else {
-                    this->connection->asyncRequest(amqMessage, onComplete);
+            // The template creates the copy that is sent, so the "CMS" header fields are
+            // set on it directly with the values the cms::Message setters would store.
+            Pointer<commands::Message> amqMessage = messageTemplate->createMessage(this->connection);
+
+            amqMessage->setPersistent(deliveryMode == (int) cms::DeliveryMode::PERSISTENT);
+            long long expiration = 0LL;
+            if (!producer->getDisableMessageTimeStamp()) {
+                long long timeStamp = System::currentTimeMillis();
+                amqMessage->setTimestamp(timeStamp);
+                if (timeToLive > 0) {
+                    expiration = timeToLive + timeStamp;
                 }
             }
+            amqMessage->setExpiration(expiration);
+            amqMessage->setPriority((unsigned char) priority);
+
+            Pointer<commands::MessageId> id(new commands::MessageId());
+            id->setProducerId(producer->getProducerInfo()->getProducerId());
+            id->setProducerSequenceId(sequenceId);
+
+            this->doSend(producer, amqMessage, id, destination, producerWindow, sendTimeout, onComplete, trace);
         }
     }
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionKernel::checkDestinationNotDeleted(const Pointer<commands::ActiveMQDestination>& destination) {
+
+    if (destination->isTemporary()) {
+        Pointer<ActiveMQTempDestination> tempDest = destination.dynamicCast<ActiveMQTempDestination>();
+        if (this->connection->isDeleted(tempDest)) {
+            throw cms::InvalidDestinationException(
+                std::string("Cannot publish to a deleted Destination: ") + destination->toString());
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionKernel::doSend(kernels::ActiveMQProducerKernel* producer, const Pointer<commands::Message>& amqMessage,
+                                   const Pointer<commands::MessageId>& id, const Pointer<commands::ActiveMQDestination>& destination,
+                                   util::MemoryUsage* producerWindow, long long sendTimeout, cms::AsyncCallback* onComplete,
+                                   const Pointer<MessageTrace>& trace) {
+
+    amqMessage->setMessageId(id);
+    amqMessage->getBrokerPath().clear();
+    amqMessage->setTransactionId(this->transaction->getTransactionId());
+    amqMessage->setConnection(this->connection);
+
+    // destination format is provider specific so only set on transformed message
+    amqMessage->setDestination(destination);
+
+    amqMessage->onSend();
+    amqMessage->setProducerId(producer->getProducerInfo()->getProducerId());
+
+    if (trace != NULL) {
+        amqMessage->setTrace(trace);
+        trace->mark(MessageTrace::SESSION_SEND);
+    }
+
+    if (onComplete == NULL && sendTimeout <= 0 && !amqMessage->isResponseRequired() && !this->connection->isAlwaysSyncSend() &&
+        (!amqMessage->isPersistent() || this->connection->isUseAsyncSend() || amqMessage->getTransactionId() != NULL)) {
+
+        // No Response Required, send is asynchronous.
+        this->connection->oneway(amqMessage);
+
+        // The Producer has already waited for space in its window.
+        if (producerWindow != NULL) {
+            producerWindow->increaseUsage(amqMessage->getSize());
+        }
+
+    } else {
+        if (sendTimeout > 0 && onComplete == NULL) {
+            this->connection->syncRequest(amqMessage, (unsigned int)sendTimeout);
+        } else {
+            this->connection->asyncRequest(amqMessage, onComplete);
+        }
+    }
+
+    this->config->metrics.getMessagesSent().increment();
+    this->config->metrics.getBytesSent().add(amqMessage->getSize());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 cms::ExceptionListener* ActiveMQSessionKernel::getExceptionListener() {
 
@@ -1481,9 +1741,55 @@ void ActiveMQSessionKernel::checkMessageListener() const {
 
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQSessionKernel::sendAck(Pointer<MessageAck> ack, bool async) {
+
+    long long start = System::nanoTime();
+
     if (async || this->connection->isSendAcksAsync() || this->isTransacted()) {
         this->connection->oneway(ack);
     } else {
         this->connection->syncRequest(ack);
     }
+
+    this->config->metrics.getAcksSent().increment();
+    this->config->metrics.getAckLatency().recordSince(start);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SessionMetrics& ActiveMQSessionKernel::getSessionMetrics() const {
+    return this->config->metrics;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SessionMetricsSnapshot ActiveMQSessionKernel::getMetricsSnapshot() const {
+
+    SessionMetricsSnapshot snapshot;
+
+    snapshot.sessionId = this->sessionInfo->getSessionId()->toString();
+    this->config->metrics.snapshot(snapshot);
+
+    this->config->consumerLock.readLock().lock();
+    try {
+        Pointer<Iterator< Pointer<ActiveMQConsumerKernel> > > iter(this->config->consumers.iterator());
+        while (iter->hasNext()) {
+            snapshot.consumers.push_back(iter->next()->getMetricsSnapshot());
+        }
+        this->config->consumerLock.readLock().unlock();
+    } catch (Exception& ex) {
+        this->config->consumerLock.readLock().unlock();
+        throw;
+    }
+
+    this->config->producerLock.readLock().lock();
+    try {
+        Pointer<Iterator< Pointer<ActiveMQProducerKernel> > > iter(this->config->producers.iterator());
+        while (iter->hasNext()) {
+            snapshot.producers.push_back(iter->next()->getMetricsSnapshot());
+        }
+        this->config->producerLock.readLock().unlock();
+    } catch (Exception& ex) {
+        this->config->producerLock.readLock().unlock();
+        throw;
+    }
+
+    return snapshot;
 }
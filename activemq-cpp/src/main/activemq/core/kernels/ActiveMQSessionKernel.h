@@ -38,6 +38,9 @@
 #include <activemq/core/Dispatcher.h>
 #include <activemq/core/MessageDispatchChannel.h>
 #include <activemq/util/LongSequenceGenerator.h>
+#include <activemq/metrics/SessionMetrics.h>
+#include <activemq/metrics/MessageTrace.h>
+#include <activemq/metrics/MetricsSnapshot.h>
 #include <activemq/threads/Scheduler.h>
 
 #include <decaf/lang/Pointer.h>
@@ -46,6 +49,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace activemq {
 namespace core {
@@ -54,6 +58,7 @@ namespace core {
     class ActiveMQConsumer;
     class ActiveMQProducer;
     class ActiveMQSessionExecutor;
+    class ProducerMessageTemplate;
 
 namespace kernels {
 
@@ -193,6 +198,8 @@ namespace kernels {
 
         virtual void commit();
 
+        virtual void commit(cms::AsyncCallback* onComplete);
+
         virtual void rollback();
 
         virtual void recover();
@@ -271,12 +278,51 @@ namespace kernels {
          *      of the given message.
          * @param sendTimeout
          *      The amount of time to block during send before failing, or 0 to wait forever.
+         * @param onComplete
+         *      The callback to notify when the send completes, or NULL to send synchronously.
+         * @param trace
+         *      The latency trace of the message if it was sampled, otherwise NULL.
          *
          * @throws CMSException if an error occurs while sending the message.
          */
         void send(kernels::ActiveMQProducerKernel* producer, Pointer<commands::ActiveMQDestination> destination,
                   cms::Message* message, int deliveryMode, int priority, long long timeToLive,
-                  util::MemoryUsage* producerWindow, long long sendTimeout, cms::AsyncCallback* onComplete);
+                  util::MemoryUsage* producerWindow, long long sendTimeout, cms::AsyncCallback* onComplete,
+                  const Pointer<metrics::MessageTrace>& trace);
+
+        /**
+         * Sends the next Message of the given template from the Producer specified, the
+         * Message is sent exactly as the send of a cms::Message would send it but is built
+         * from the template's already encoded headers and properties.
+         *
+         * @param producer
+         *      The sending Producer
+         * @param destination
+         *      The target destination for the Message.
+         * @param messageTemplate
+         *      The template that creates the Message to send.
+         * @param deliveryMode
+         *      The delivery mode to assign to the outgoing message.
+         * @param priority
+         *      The priority value to assign to the outgoing message.
+         * @param timeToLive
+         *      The time to live for the outgoing message.
+         * @param producerWindow
+         *      Pointer to a Usage tracker which if set will be increased by the size
+         *      of the given message.
+         * @param sendTimeout
+         *      The amount of time to block during send before failing, or 0 to wait forever.
+         * @param onComplete
+         *      The callback to notify when the send completes, or NULL to send synchronously.
+         * @param trace
+         *      The latency trace of the message if it was sampled, otherwise NULL.
+         *
+         * @throws CMSException if an error occurs while sending the message.
+         */
+        void send(kernels::ActiveMQProducerKernel* producer, Pointer<commands::ActiveMQDestination> destination,
+                  ProducerMessageTemplate* messageTemplate, int deliveryMode, int priority, long long timeToLive,
+                  util::MemoryUsage* producerWindow, long long sendTimeout, cms::AsyncCallback* onComplete,
+                  const Pointer<metrics::MessageTrace>& trace);
 
         /**
          * This method gets any registered exception listener of this sessions
@@ -288,6 +334,38 @@ namespace kernels {
          */
         cms::ExceptionListener* getExceptionListener();
 
+        /**
+         * Creates a MessageConsumer for each of the given destinations without waiting for
+         * the broker to respond to one ConsumerInfo before sending the next, all the info
+         * commands are pipelined to the broker and then the whole set of responses is waited
+         * for.  This avoids paying a full round trip per consumer when an application opens
+         * many consumers at startup.
+         *
+         * Failures are reported per consumer, on return both vectors hold one entry for each
+         * destination in the same order.  A successfully created consumer has its entry in
+         * the consumers vector set and a NULL error, a failed one has a NULL consumer and the
+         * error that caused it to fail.  The caller owns the returned consumers.
+         *
+         * @param destinations
+         *      The destinations to create the consumers on.
+         * @param selector
+         *      The message selector applied to each of the consumers.
+         * @param noLocal
+         *      If true, inhibits the delivery of messages published by this connection.
+         * @param consumers
+         *      The vector that receives the created consumers.
+         * @param errors
+         *      The vector that receives the error for each consumer that could not be created.
+         *
+         * @return the number of consumers that were successfully created.
+         *
+         * @throws CMSException if the session is closed.
+         */
+        int createConsumers(const std::vector<const cms::Destination*>& destinations,
+                            const std::string& selector, bool noLocal,
+                            std::vector<cms::MessageConsumer*>& consumers,
+                            std::vector< Pointer<cms::CMSException> >& errors);
+
         /**
          * Set an MessageTransformer instance that is passed on to all MessageProducer and MessageConsumer
          * objects created from this Session.
@@ -568,6 +646,19 @@ namespace kernels {
          */
         void sendAck(decaf::lang::Pointer<commands::MessageAck> ack, bool async = false);
 
+        /**
+         * @returns the metrics that this Session records its sends, acks and transactions into.
+         */
+        metrics::SessionMetrics& getSessionMetrics() const;
+
+        /**
+         * Takes a snapshot of the metrics of this Session along with those of each of its
+         * consumers and producers.
+         *
+         * @returns a snapshot of the metrics of this Session.
+         */
+        metrics::SessionMetricsSnapshot getMetricsSnapshot() const;
+
    private:
 
        /**
@@ -581,6 +672,16 @@ namespace kernels {
        // Checks for the closed state and throws if so.
        void checkClosed() const;
 
+       // Throws if the Destination is a Temporary Destination that has been deleted.
+       void checkDestinationNotDeleted(const Pointer<commands::ActiveMQDestination>& destination);
+
+       // Completes the outgoing copy of a Message and hands it to the Connection, the
+       // caller holds the send mutex and has started any transaction.
+       void doSend(kernels::ActiveMQProducerKernel* producer, const Pointer<commands::Message>& amqMessage,
+                   const Pointer<commands::MessageId>& id, const Pointer<commands::ActiveMQDestination>& destination,
+                   util::MemoryUsage* producerWindow, long long sendTimeout, cms::AsyncCallback* onComplete,
+                   const Pointer<metrics::MessageTrace>& trace);
+
        // Send the Destination Creation Request to the Broker, alerting it
        // that we've created a new Temporary Destination.
        // @param tempDestination - The new Temporary Destination
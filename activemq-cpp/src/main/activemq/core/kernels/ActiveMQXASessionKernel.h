@@ -48,6 +48,8 @@ namespace kernels {
 
         virtual void commit();
 
+        virtual void commit(cms::AsyncCallback* onComplete);
+
         virtual void rollback();
 
     public:  // XASession overrides
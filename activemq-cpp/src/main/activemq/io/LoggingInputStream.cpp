@@ -79,6 +79,10 @@ int LoggingInputStream::doReadArrayBounded(unsigned char* buffer, int size, int
 ////////////////////////////////////////////////////////////////////////////////
 void LoggingInputStream::log(const unsigned char* buffer, int len) {
 
+    if (!logger.isInfoEnabled()) {
+        return;
+    }
+
     ostringstream ostream;
 
     ostream << "TCP Trace: Reading: " << endl << "[";
@@ -94,5 +98,5 @@ void LoggingInputStream::log(const unsigned char* buffer, int len) {
     ostream << "] len: " << std::dec << len << " bytes";
 
     // Log the data
-    LOGDECAF_INFO(logger, ostream.str())
+    LOGDECAF_INFO(logger, ostream.str());
 }
@@ -78,6 +78,10 @@ void LoggingOutputStream::doWriteArrayBounded(const unsigned char* buffer, int s
 ////////////////////////////////////////////////////////////////////////////////
 void LoggingOutputStream::log(const unsigned char* buffer, int len) {
 
+    if (!logger.isInfoEnabled()) {
+        return;
+    }
+
     // Write the buffer as hex to a string stream.
     ostringstream ostream;
     ostream << "TCP Trace: Writing:" << endl << '[';
@@ -93,5 +97,5 @@ void LoggingOutputStream::log(const unsigned char* buffer, int len) {
     ostream << "] len: " << std::dec << len << " bytes";
 
     // Log the data
-    LOGDECAF_INFO(logger, ostream.str())
+    LOGDECAF_INFO(logger, ostream.str());
 }
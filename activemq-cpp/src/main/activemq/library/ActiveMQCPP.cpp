@@ -21,6 +21,7 @@
 #include <activemq/wireformat/WireFormatRegistry.h>
 #include <activemq/transport/TransportRegistry.h>
 
+#include <activemq/util/ConnectionIdTable.h>
 #include <activemq/util/IdGenerator.h>
 
 #include <activemq/wireformat/stomp/StompWireFormatFactory.h>
@@ -64,6 +65,9 @@ void ActiveMQCPP::initializeLibrary(int argc, char** argv) {
 
     // Start the IdGenerator Kernel
     IdGenerator::initialize();
+
+    // Start the table of interned connection ids
+    ConnectionIdTable::initialize();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -74,6 +78,9 @@ void ActiveMQCPP::initializeLibrary() {
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQCPP::shutdownLibrary() {
 
+    // Shutdown the table of interned connection ids
+    ConnectionIdTable::shutdown();
+
     // Shutdown the IdGenerator Kernel
     IdGenerator::shutdown();
 
@@ -0,0 +1,49 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "ConnectionMetrics.h"
+
+using namespace activemq;
+using namespace activemq::metrics;
+
+////////////////////////////////////////////////////////////////////////////////
+ConnectionMetrics::ConnectionMetrics() : syncRequests(), inFlightRequests(), syncRequestLatency(), transport(new TransportMetrics()), tracer(new MessageTracer()) {
+
+    this->transport->setMessageTracer(this->tracer);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ConnectionMetrics::~ConnectionMetrics() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ConnectionMetrics::snapshot(ConnectionMetricsSnapshot& snapshot) const {
+    snapshot.syncRequests = this->syncRequests.get();
+    snapshot.inFlightRequests = this->inFlightRequests.get();
+    this->syncRequestLatency.snapshot(snapshot.syncRequestLatency);
+    this->transport->snapshot(snapshot.transport);
+    this->tracer->snapshot(snapshot.stageLatency);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ConnectionMetrics::reset() {
+    this->syncRequests.reset();
+    this->syncRequestLatency.reset();
+    this->transport->reset();
+    this->tracer->reset();
+}
@@ -0,0 +1,115 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _ACTIVEMQ_METRICS_CONNECTIONMETRICS_H_
+#define _ACTIVEMQ_METRICS_CONNECTIONMETRICS_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/metrics/Counter.h>
+#include <activemq/metrics/Gauge.h>
+#include <activemq/metrics/Histogram.h>
+#include <activemq/metrics/MetricsSnapshot.h>
+#include <activemq/metrics/TransportMetrics.h>
+#include <activemq/metrics/MessageTracer.h>
+
+#include <decaf/lang/Pointer.h>
+
+namespace activemq {
+namespace metrics {
+
+    /**
+     * Metrics recorded by a single Connection, the metrics of its sessions are kept by
+     * the sessions themselves.
+     *
+     * @since 3.8
+     */
+    class AMQCPP_API ConnectionMetrics {
+    private:
+
+        Counter syncRequests;
+        Gauge inFlightRequests;
+        Histogram syncRequestLatency;
+
+        decaf::lang::Pointer<TransportMetrics> transport;
+        decaf::lang::Pointer<MessageTracer> tracer;
+
+    private:
+
+        ConnectionMetrics(const ConnectionMetrics&);
+        ConnectionMetrics& operator=(const ConnectionMetrics&);
+
+    public:
+
+        ConnectionMetrics();
+
+        virtual ~ConnectionMetrics();
+
+        /**
+         * @return the Counter of requests sent that waited for a response from the broker.
+         */
+        Counter& getSyncRequests() {
+            return this->syncRequests;
+        }
+
+        /**
+         * @return the Gauge of requests currently waiting for a response from the broker.
+         */
+        Gauge& getInFlightRequests() {
+            return this->inFlightRequests;
+        }
+
+        /**
+         * @return the Histogram of round trip time of requests that waited for a response.
+         */
+        Histogram& getSyncRequestLatency() {
+            return this->syncRequestLatency;
+        }
+
+        /**
+         * @return the metrics shared by the transports of the connection.
+         */
+        decaf::lang::Pointer<TransportMetrics> getTransportMetrics() const {
+            return this->transport;
+        }
+
+        /**
+         * @return the tracer that samples messages passing through the connection.
+         */
+        MessageTracer& getMessageTracer() const {
+            return *this->tracer;
+        }
+
+        /**
+         * Copies the current values into the given snapshot without blocking the threads
+         * that are recording new values.
+         *
+         * @param snapshot
+         *      The snapshot to fill in.
+         */
+        void snapshot(ConnectionMetricsSnapshot& snapshot) const;
+
+        /**
+         * Resets all the metrics to zero.
+         */
+        void reset();
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_METRICS_CONNECTIONMETRICS_H_ */
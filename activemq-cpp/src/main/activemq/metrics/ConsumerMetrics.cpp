@@ -0,0 +1,52 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "ConsumerMetrics.h"
+
+using namespace activemq;
+using namespace activemq::metrics;
+
+////////////////////////////////////////////////////////////////////////////////
+ConsumerMetrics::ConsumerMetrics() : messagesReceived(), bytesReceived(), messagesRedelivered(), poisonAcks(),
+                                     prefetchAdjustments(), prefetchSize(), ackBatchSize(), consumptionRate() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ConsumerMetrics::~ConsumerMetrics() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ConsumerMetrics::snapshot(ConsumerMetricsSnapshot& snapshot) const {
+    snapshot.messagesReceived = this->messagesReceived.get();
+    snapshot.bytesReceived = this->bytesReceived.get();
+    snapshot.messagesRedelivered = this->messagesRedelivered.get();
+    snapshot.poisonAcks = this->poisonAcks.get();
+    snapshot.prefetchAdjustments = this->prefetchAdjustments.get();
+    snapshot.prefetchSize = this->prefetchSize.get();
+    snapshot.ackBatchSize = this->ackBatchSize.get();
+    snapshot.consumptionRate = this->consumptionRate.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ConsumerMetrics::reset() {
+    this->messagesReceived.reset();
+    this->bytesReceived.reset();
+    this->messagesRedelivered.reset();
+    this->poisonAcks.reset();
+    this->prefetchAdjustments.reset();
+}
@@ -0,0 +1,132 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _ACTIVEMQ_METRICS_CONSUMERMETRICS_H_
+#define _ACTIVEMQ_METRICS_CONSUMERMETRICS_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/metrics/Counter.h>
+#include <activemq/metrics/Gauge.h>
+#include <activemq/metrics/MetricsSnapshot.h>
+
+namespace activemq {
+namespace metrics {
+
+    /**
+     * Metrics recorded by a single MessageConsumer.
+     *
+     * @since 3.8
+     */
+    class AMQCPP_API ConsumerMetrics {
+    private:
+
+        Counter messagesReceived;
+        Counter bytesReceived;
+        Counter messagesRedelivered;
+        Counter poisonAcks;
+        Counter prefetchAdjustments;
+        Gauge prefetchSize;
+        Gauge ackBatchSize;
+        Gauge consumptionRate;
+
+    private:
+
+        ConsumerMetrics(const ConsumerMetrics&);
+        ConsumerMetrics& operator=(const ConsumerMetrics&);
+
+    public:
+
+        ConsumerMetrics();
+
+        virtual ~ConsumerMetrics();
+
+        /**
+         * @return the Counter of messages dispatched to the consumer.
+         */
+        Counter& getMessagesReceived() {
+            return this->messagesReceived;
+        }
+
+        /**
+         * @return the Counter of size of the messages dispatched to the consumer.
+         */
+        Counter& getBytesReceived() {
+            return this->bytesReceived;
+        }
+
+        /**
+         * @return the Counter of messages that were rolled back for redelivery.
+         */
+        Counter& getMessagesRedelivered() {
+            return this->messagesRedelivered;
+        }
+
+        /**
+         * @return the Counter of messages that exceeded the maximum redeliveries and were poison acked.
+         */
+        Counter& getPoisonAcks() {
+            return this->poisonAcks;
+        }
+
+        /**
+         * @return the Counter of times the adaptive prefetch controller changed the prefetch size.
+         */
+        Counter& getPrefetchAdjustments() {
+            return this->prefetchAdjustments;
+        }
+
+        /**
+         * @return the Gauge of the prefetch size the consumer currently requests.
+         */
+        Gauge& getPrefetchSize() {
+            return this->prefetchSize;
+        }
+
+        /**
+         * @return the Gauge of the number of consumed messages that are acknowledged together.
+         */
+        Gauge& getAckBatchSize() {
+            return this->ackBatchSize;
+        }
+
+        /**
+         * @return the Gauge of messages consumed per second, measured by the adaptive prefetch controller.
+         */
+        Gauge& getConsumptionRate() {
+            return this->consumptionRate;
+        }
+
+        /**
+         * Copies the current values into the given snapshot without blocking the threads
+         * that are recording new values.
+         *
+         * @param snapshot
+         *      The snapshot to fill in.
+         */
+        void snapshot(ConsumerMetricsSnapshot& snapshot) const;
+
+        /**
+         * Resets all the metrics to zero.
+         */
+        void reset();
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_METRICS_CONSUMERMETRICS_H_ */
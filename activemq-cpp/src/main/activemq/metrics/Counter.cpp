@@ -0,0 +1,95 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Counter.h"
+
+#include <decaf/lang/Thread.h>
+#include <decaf/util/concurrent/Concurrent.h>
+
+using namespace activemq;
+using namespace activemq::metrics;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // Once a cell gets this far from zero its value is moved into the base so the
+    // 32 bit cells never overflow.
+    const int CARRY_THRESHOLD = 1 << 30;
+
+    inline int cellIndex(int cells) {
+        return (int) (Thread::currentThread()->getId() & (cells - 1));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Counter::Counter() : baseLock(), base(0) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Counter::~Counter() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Counter::add(long long delta) {
+
+    if (delta >= CARRY_THRESHOLD || delta <= -CARRY_THRESHOLD) {
+        synchronized(&this->baseLock) {
+            this->base += delta;
+        }
+        return;
+    }
+
+    Cell& cell = this->cells[cellIndex(CELLS)];
+    int value = cell.value.addAndGet((int) delta);
+
+    if (value >= CARRY_THRESHOLD || value <= -CARRY_THRESHOLD) {
+        int carried = cell.value.getAndSet(0);
+        synchronized(&this->baseLock) {
+            this->base += carried;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long Counter::get() const {
+
+    long long result = 0;
+
+    synchronized(&this->baseLock) {
+        result = this->base;
+    }
+
+    for (int i = 0; i < CELLS; ++i) {
+        result += this->cells[i].value.get();
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Counter::reset() {
+
+    synchronized(&this->baseLock) {
+        this->base = 0;
+        for (int i = 0; i < CELLS; ++i) {
+            this->cells[i].value.set(0);
+        }
+    }
+}
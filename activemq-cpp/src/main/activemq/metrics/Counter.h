@@ -0,0 +1,104 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_METRICS_COUNTER_H_
+#define _ACTIVEMQ_METRICS_COUNTER_H_
+
+#include <activemq/util/Config.h>
+
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+
+namespace activemq {
+namespace metrics {
+
+    /**
+     * A 64 bit count that many threads can add to at once without contending with
+     * each other.
+     *
+     * The count is spread over a fixed number of cache line sized cells and each
+     * thread adds to the cell picked by its thread id, so threads only share a cell
+     * when there are more of them than there are cells.  Reading the count sums the
+     * cells without stopping the writers, a value read while other threads are adding
+     * reflects some but maybe not all of the concurrent additions.
+     *
+     * @since 3.8
+     */
+    class AMQCPP_API Counter {
+    public:
+
+        /**
+         * The number of cells the count is spread over.
+         */
+        static const int CELLS = 8;
+
+    private:
+
+        struct Cell {
+            decaf::util::concurrent::atomic::AtomicInteger value;
+            char padding[64];
+
+            Cell() : value() {}
+        };
+
+        Cell cells[CELLS];
+
+        // Holds the amounts carried out of the cells before they can overflow.
+        mutable decaf::util::concurrent::Mutex baseLock;
+        long long base;
+
+    private:
+
+        Counter(const Counter&);
+        Counter& operator=(const Counter&);
+
+    public:
+
+        Counter();
+
+        virtual ~Counter();
+
+        /**
+         * Adds one to the count.
+         */
+        void increment() {
+            add(1);
+        }
+
+        /**
+         * Adds the given amount to the count.
+         *
+         * @param delta
+         *      The amount to add, may be negative.
+         */
+        void add(long long delta);
+
+        /**
+         * @return the current value of the count.
+         */
+        long long get() const;
+
+        /**
+         * Sets the count back to zero.
+         */
+        void reset();
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_METRICS_COUNTER_H_ */
@@ -0,0 +1,77 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_METRICS_GAUGE_H_
+#define _ACTIVEMQ_METRICS_GAUGE_H_
+
+#include <activemq/util/Config.h>
+
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+
+namespace activemq {
+namespace metrics {
+
+    /**
+     * A value that goes up and down, such as the number of requests currently
+     * awaiting a response.
+     *
+     * @since 3.8
+     */
+    class AMQCPP_API Gauge {
+    private:
+
+        decaf::util::concurrent::atomic::AtomicInteger value;
+
+    private:
+
+        Gauge(const Gauge&);
+        Gauge& operator=(const Gauge&);
+
+    public:
+
+        Gauge();
+
+        virtual ~Gauge();
+
+        /**
+         * Sets the current value.
+         *
+         * @param value
+         *      The new value of the Gauge.
+         */
+        void set(int value);
+
+        /**
+         * Adds one to the current value.
+         */
+        void increment();
+
+        /**
+         * Subtracts one from the current value.
+         */
+        void decrement();
+
+        /**
+         * @return the current value.
+         */
+        int get() const;
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_METRICS_GAUGE_H_ */
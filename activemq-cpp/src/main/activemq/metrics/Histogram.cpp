@@ -0,0 +1,122 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Histogram.h"
+
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/util/concurrent/Concurrent.h>
+
+using namespace activemq;
+using namespace activemq::metrics;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const int CARRY_THRESHOLD = 1 << 30;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Histogram::Histogram() : baseLock(), sum() {
+    for (int i = 0; i < HistogramSnapshot::BUCKETS; ++i) {
+        this->base[i] = 0;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Histogram::~Histogram() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int Histogram::getBucketIndex(long long micros) {
+
+    int index = 0;
+    while (micros > 0 && index < HistogramSnapshot::BUCKETS - 1) {
+        micros >>= 1;
+        index++;
+    }
+
+    return index;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Histogram::record(long long micros) {
+
+    if (micros < 0) {
+        micros = 0;
+    }
+
+    int index = getBucketIndex(micros);
+    Row& row = this->rows[Thread::currentThread()->getId() & (CELLS - 1)];
+
+    if (row.buckets[index].incrementAndGet() >= CARRY_THRESHOLD) {
+        int carried = row.buckets[index].getAndSet(0);
+        synchronized(&this->baseLock) {
+            this->base[index] += carried;
+        }
+    }
+
+    this->sum.add(micros);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Histogram::recordSince(long long startNanos) {
+    record((System::nanoTime() - startNanos) / 1000);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Histogram::snapshot(HistogramSnapshot& snapshot) const {
+
+    snapshot.count = 0;
+    snapshot.buckets.assign(HistogramSnapshot::BUCKETS, 0);
+
+    synchronized(&this->baseLock) {
+        for (int i = 0; i < HistogramSnapshot::BUCKETS; ++i) {
+            snapshot.buckets[i] = this->base[i];
+        }
+    }
+
+    for (int row = 0; row < CELLS; ++row) {
+        for (int i = 0; i < HistogramSnapshot::BUCKETS; ++i) {
+            snapshot.buckets[i] += this->rows[row].buckets[i].get();
+        }
+    }
+
+    for (int i = 0; i < HistogramSnapshot::BUCKETS; ++i) {
+        snapshot.count += snapshot.buckets[i];
+    }
+
+    snapshot.sum = this->sum.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Histogram::reset() {
+
+    synchronized(&this->baseLock) {
+        for (int i = 0; i < HistogramSnapshot::BUCKETS; ++i) {
+            this->base[i] = 0;
+            for (int row = 0; row < CELLS; ++row) {
+                this->rows[row].buckets[i].set(0);
+            }
+        }
+    }
+
+    this->sum.reset();
+}
@@ -0,0 +1,118 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_METRICS_HISTOGRAM_H_
+#define _ACTIVEMQ_METRICS_HISTOGRAM_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/metrics/Counter.h>
+#include <activemq/metrics/MetricsSnapshot.h>
+
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+
+namespace activemq {
+namespace metrics {
+
+    /**
+     * Records the distribution of a latency in a fixed set of buckets whose bounds are
+     * powers of two microseconds, bucket i holds the values below 2^i microseconds that
+     * are not in an earlier bucket and the last bucket holds everything larger.
+     *
+     * Like the Counter the buckets are spread over cells picked by the recording thread's
+     * id so that recording doesn't contend, and taking a snapshot doesn't block recording.
+     *
+     * @since 3.8
+     */
+    class AMQCPP_API Histogram {
+    public:
+
+        /**
+         * The number of rows of buckets the recordings are spread over.
+         */
+        static const int CELLS = 4;
+
+    private:
+
+        struct Row {
+            decaf::util::concurrent::atomic::AtomicInteger buckets[HistogramSnapshot::BUCKETS];
+            char padding[64];
+
+            Row() {}
+        };
+
+        Row rows[CELLS];
+
+        // Holds the amounts carried out of the rows before they can overflow.
+        mutable decaf::util::concurrent::Mutex baseLock;
+        long long base[HistogramSnapshot::BUCKETS];
+
+        Counter sum;
+
+    private:
+
+        Histogram(const Histogram&);
+        Histogram& operator=(const Histogram&);
+
+    public:
+
+        Histogram();
+
+        virtual ~Histogram();
+
+        /**
+         * Records one value.
+         *
+         * @param micros
+         *      The value to record in microseconds, negative values are recorded as zero.
+         */
+        void record(long long micros);
+
+        /**
+         * Records the time elapsed since the given start time.
+         *
+         * @param startNanos
+         *      A value previously returned from System::nanoTime.
+         */
+        void recordSince(long long startNanos);
+
+        /**
+         * Copies the current bucket counts into the given snapshot.
+         *
+         * @param snapshot
+         *      The snapshot to fill in.
+         */
+        void snapshot(HistogramSnapshot& snapshot) const;
+
+        /**
+         * Sets all the buckets back to zero.
+         */
+        void reset();
+
+        /**
+         * @param micros
+         *      A value in microseconds.
+         *
+         * @return the index of the bucket that the value is recorded in.
+         */
+        static int getBucketIndex(long long micros);
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_METRICS_HISTOGRAM_H_ */
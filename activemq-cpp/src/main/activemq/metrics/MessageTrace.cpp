@@ -0,0 +1,84 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MessageTrace.h"
+
+#include <decaf/lang/System.h>
+
+using namespace activemq;
+using namespace activemq::metrics;
+using namespace decaf;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const char* STAGE_NAMES[MessageTrace::STAGE_COUNT] = {
+        "producerSend",
+        "sessionSend",
+        "transportSend",
+        "transportReceive",
+        "connectionDispatch",
+        "sessionDispatch",
+        "consumerDeliver",
+        "consumerComplete"
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MessageTrace::MessageTrace() {
+    for (int i = 0; i < STAGE_COUNT; ++i) {
+        this->timestamps[i] = 0;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MessageTrace::~MessageTrace() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageTrace::mark(Stage stage) {
+    this->timestamps[stage] = System::nanoTime();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long MessageTrace::getElapsedTime() const {
+
+    long long first = 0;
+    long long last = 0;
+
+    for (int i = 0; i < STAGE_COUNT; ++i) {
+        if (this->timestamps[i] != 0) {
+            if (first == 0) {
+                first = this->timestamps[i];
+            }
+            last = this->timestamps[i];
+        }
+    }
+
+    return (last - first) / 1000;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string MessageTrace::getStageName(int stage) {
+
+    if (stage < 0 || stage >= STAGE_COUNT) {
+        return "unknown";
+    }
+
+    return STAGE_NAMES[stage];
+}
@@ -0,0 +1,120 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_METRICS_MESSAGETRACE_H_
+#define _ACTIVEMQ_METRICS_MESSAGETRACE_H_
+
+#include <activemq/util/Config.h>
+
+#include <string>
+
+namespace activemq {
+namespace metrics {
+
+    /**
+     * The times at which a single sampled message passed through each stage of the
+     * send or dispatch pipeline.  A trace is created by the MessageTracer when a message
+     * is sampled and travels along with the message, each stage stamps it as the
+     * message passes through.  Only the stages of one side of the pipeline are ever
+     * marked on a given trace.
+     *
+     * @since 3.8
+     */
+    class AMQCPP_API MessageTrace {
+    public:
+
+        enum Stage {
+            // ActiveMQProducerKernel::send was called.
+            PRODUCER_SEND = 0,
+            // The session has prepared the message and hands it to the connection.
+            SESSION_SEND,
+            // The transport has written the message to the wire.
+            TRANSPORT_SEND,
+            // The transport has read the dispatch of the message from the wire.
+            TRANSPORT_RECEIVE,
+            // The connection has found the dispatcher of the message.
+            CONNECTION_DISPATCH,
+            // The session executor passes the message to the consumer.
+            SESSION_DISPATCH,
+            // The message is about to be delivered to the listener or returned from receive.
+            CONSUMER_DELIVER,
+            // The listener or receive call is done with the message.
+            CONSUMER_COMPLETE,
+            STAGE_COUNT
+        };
+
+    private:
+
+        long long timestamps[STAGE_COUNT];
+
+    private:
+
+        MessageTrace(const MessageTrace&);
+        MessageTrace& operator=(const MessageTrace&);
+
+    public:
+
+        MessageTrace();
+
+        virtual ~MessageTrace();
+
+        /**
+         * Records the current time as the time the message reached the given stage.
+         *
+         * @param stage
+         *      The stage that the message has reached.
+         */
+        void mark(Stage stage);
+
+        /**
+         * @param stage
+         *      The stage to check.
+         *
+         * @return true if the message has reached the given stage.
+         */
+        bool isMarked(Stage stage) const {
+            return this->timestamps[stage] != 0;
+        }
+
+        /**
+         * @param stage
+         *      The stage whose time is returned.
+         *
+         * @return the System::nanoTime value at which the stage was reached or zero if it wasn't.
+         */
+        long long getTimestamp(Stage stage) const {
+            return this->timestamps[stage];
+        }
+
+        /**
+         * @return the time in microseconds between the earliest and the latest marked stages.
+         */
+        long long getElapsedTime() const;
+
+        /**
+         * @param stage
+         *      The stage whose name is returned.
+         *
+         * @return the name of the given stage.
+         */
+        static std::string getStageName(int stage);
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_METRICS_MESSAGETRACE_H_ */
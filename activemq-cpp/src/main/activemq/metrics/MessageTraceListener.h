@@ -0,0 +1,53 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_METRICS_MESSAGETRACELISTENER_H_
+#define _ACTIVEMQ_METRICS_MESSAGETRACELISTENER_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/metrics/MessageTrace.h>
+
+namespace activemq {
+namespace metrics {
+
+    /**
+     * Receives the trace of each sampled message once it has completed the send or
+     * dispatch pipeline.
+     *
+     * @since 3.8
+     */
+    class AMQCPP_API MessageTraceListener {
+    public:
+
+        virtual ~MessageTraceListener();
+
+        /**
+         * Called from the thread that completed the trace, which is the producer's thread
+         * for a send or the thread that delivered the message for a dispatch.  The call
+         * is on the message path so implementations should be quick, any exception thrown
+         * is ignored.
+         *
+         * @param trace
+         *      The completed trace, only valid for the duration of the call.
+         */
+        virtual void onMessageTrace(const MessageTrace& trace) = 0;
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_METRICS_MESSAGETRACELISTENER_H_ */
@@ -0,0 +1,98 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MessageTracer.h"
+
+#include <activemq/exceptions/ActiveMQException.h>
+
+using namespace activemq;
+using namespace activemq::metrics;
+using namespace decaf;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+MessageTracer::MessageTracer() : sampleRate(0), sequence(), listener(NULL) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MessageTracer::~MessageTracer() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageTracer::setSampleRate(int value) {
+    this->sampleRate = value < 0 ? 0 : value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<MessageTrace> MessageTracer::sample() {
+
+    int rate = this->sampleRate;
+
+    if (rate <= 0) {
+        return Pointer<MessageTrace>();
+    }
+
+    if (rate > 1 && ((unsigned int) this->sequence.incrementAndGet() % (unsigned int) rate) != 0) {
+        return Pointer<MessageTrace>();
+    }
+
+    return Pointer<MessageTrace>(new MessageTrace());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageTracer::complete(const MessageTrace& trace) {
+
+    int previous = -1;
+    for (int stage = 0; stage < MessageTrace::STAGE_COUNT; ++stage) {
+
+        if (!trace.isMarked((MessageTrace::Stage) stage)) {
+            continue;
+        }
+
+        if (previous >= 0) {
+            long long elapsed = trace.getTimestamp((MessageTrace::Stage) stage) -
+                                trace.getTimestamp((MessageTrace::Stage) previous);
+            this->stageLatency[stage].record(elapsed / 1000);
+        }
+
+        previous = stage;
+    }
+
+    MessageTraceListener* listener = this->listener;
+    if (listener != NULL) {
+        try {
+            listener->onMessageTrace(trace);
+        }
+        AMQ_CATCHALL_NOTHROW()
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageTracer::snapshot(std::vector<HistogramSnapshot>& snapshot) const {
+
+    snapshot.resize(MessageTrace::STAGE_COUNT);
+    for (int stage = 0; stage < MessageTrace::STAGE_COUNT; ++stage) {
+        this->stageLatency[stage].snapshot(snapshot[stage]);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageTracer::reset() {
+    for (int stage = 0; stage < MessageTrace::STAGE_COUNT; ++stage) {
+        this->stageLatency[stage].reset();
+    }
+}
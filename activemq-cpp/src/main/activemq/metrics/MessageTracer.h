@@ -0,0 +1,148 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_METRICS_MESSAGETRACER_H_
+#define _ACTIVEMQ_METRICS_MESSAGETRACER_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/metrics/Histogram.h>
+#include <activemq/metrics/MessageTrace.h>
+#include <activemq/metrics/MessageTraceListener.h>
+#include <activemq/metrics/MetricsSnapshot.h>
+
+#include <decaf/lang/Pointer.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+
+#include <vector>
+
+namespace activemq {
+namespace metrics {
+
+    /**
+     * Samples one in every N messages that pass through the send and dispatch pipelines
+     * of a connection and records how long each sampled message took to get from one
+     * stage to the next.  Tracing is off by default, in which case each stage costs a
+     * single test of the sample rate.
+     *
+     * @since 3.8
+     */
+    class AMQCPP_API MessageTracer {
+    private:
+
+        volatile int sampleRate;
+        decaf::util::concurrent::atomic::AtomicInteger sequence;
+        MessageTraceListener* listener;
+
+        // Time taken to reach each stage from the stage before it.
+        Histogram stageLatency[MessageTrace::STAGE_COUNT];
+
+    private:
+
+        MessageTracer(const MessageTracer&);
+        MessageTracer& operator=(const MessageTracer&);
+
+    public:
+
+        MessageTracer();
+
+        virtual ~MessageTracer();
+
+        /**
+         * @return true if messages are being sampled.
+         */
+        bool isEnabled() const {
+            return this->sampleRate > 0;
+        }
+
+        /**
+         * @return the number of messages out of which one is traced, zero when disabled.
+         */
+        int getSampleRate() const {
+            return this->sampleRate;
+        }
+
+        /**
+         * Sets how many messages pass for each one that is traced, a value of one traces
+         * every message and zero or less disables tracing.
+         *
+         * @param value
+         *      The new sample rate.
+         */
+        void setSampleRate(int value);
+
+        /**
+         * Sets the listener that is given each completed trace, the tracer does not take
+         * ownership of the listener.
+         *
+         * @param listener
+         *      The listener to notify or NULL to clear it.
+         */
+        void setMessageTraceListener(MessageTraceListener* listener) {
+            this->listener = listener;
+        }
+
+        /**
+         * @return the listener that is given each completed trace, or NULL if none is set.
+         */
+        MessageTraceListener* getMessageTraceListener() const {
+            return this->listener;
+        }
+
+        /**
+         * Decides if the next message should be traced.
+         *
+         * @return a new trace if the message is sampled, otherwise NULL.
+         */
+        decaf::lang::Pointer<MessageTrace> sample();
+
+        /**
+         * Records the stage to stage latencies of a trace whose message has left the
+         * pipeline and hands it to the listener, if any.
+         *
+         * @param trace
+         *      The trace to record.
+         */
+        void complete(const MessageTrace& trace);
+
+        /**
+         * @param stage
+         *      The stage whose histogram is returned.
+         *
+         * @return the Histogram of the time taken to reach the stage from the stage before it.
+         */
+        Histogram& getStageLatency(MessageTrace::Stage stage) {
+            return this->stageLatency[stage];
+        }
+
+        /**
+         * Copies the stage latency histograms into the given vector, indexed by stage.
+         *
+         * @param snapshot
+         *      The vector to fill in.
+         */
+        void snapshot(std::vector<HistogramSnapshot>& snapshot) const;
+
+        /**
+         * Resets all the stage latency histograms.
+         */
+        void reset();
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_METRICS_MESSAGETRACER_H_ */
@@ -0,0 +1,265 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MetricsSnapshot.h"
+
+#include <activemq/metrics/MessageTrace.h>
+
+#include <decaf/lang/Long.h>
+
+#include <sstream>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::metrics;
+using namespace decaf;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    void writeString(std::ostream& out, const std::string& value) {
+
+        out << '"';
+        for (std::string::const_iterator iter = value.begin(); iter != value.end(); ++iter) {
+            char c = *iter;
+            if (c == '"' || c == '\\') {
+                out << '\\' << c;
+            } else if ((unsigned char) c < 0x20) {
+                out << ' ';
+            } else {
+                out << c;
+            }
+        }
+        out << '"';
+    }
+
+    void writeHistogram(std::ostream& out, const HistogramSnapshot& histogram) {
+
+        out << "{\"count\":" << histogram.count
+            << ",\"sum\":" << histogram.sum
+            << ",\"p50\":" << histogram.getPercentile(50.0)
+            << ",\"p99\":" << histogram.getPercentile(99.0)
+            << ",\"p999\":" << histogram.getPercentile(99.9)
+            << ",\"buckets\":[";
+
+        for (std::size_t i = 0; i < histogram.buckets.size(); ++i) {
+            if (i > 0) {
+                out << ',';
+            }
+            out << histogram.buckets[i];
+        }
+
+        out << "]}";
+    }
+
+    void writeConsumer(std::ostream& out, const ConsumerMetricsSnapshot& consumer) {
+
+        out << "{\"consumerId\":";
+        writeString(out, consumer.consumerId);
+        out << ",\"messagesReceived\":" << consumer.messagesReceived
+            << ",\"bytesReceived\":" << consumer.bytesReceived
+            << ",\"messagesRedelivered\":" << consumer.messagesRedelivered
+            << ",\"poisonAcks\":" << consumer.poisonAcks
+            << ",\"prefetchOccupancy\":" << consumer.prefetchOccupancy
+            << ",\"prefetchAdjustments\":" << consumer.prefetchAdjustments
+            << ",\"prefetchSize\":" << consumer.prefetchSize
+            << ",\"ackBatchSize\":" << consumer.ackBatchSize
+            << ",\"consumptionRate\":" << consumer.consumptionRate
+            << '}';
+    }
+
+    void writeProducer(std::ostream& out, const ProducerMetricsSnapshot& producer) {
+
+        out << "{\"producerId\":";
+        writeString(out, producer.producerId);
+        out << ",\"messagesSent\":" << producer.messagesSent
+            << ",\"sendLatency\":";
+        writeHistogram(out, producer.sendLatency);
+        out << ",\"windowBlockTime\":";
+        writeHistogram(out, producer.windowBlockTime);
+        out << '}';
+    }
+
+    void writeSession(std::ostream& out, const SessionMetricsSnapshot& session) {
+
+        out << "{\"sessionId\":";
+        writeString(out, session.sessionId);
+        out << ",\"messagesSent\":" << session.messagesSent
+            << ",\"bytesSent\":" << session.bytesSent
+            << ",\"acksSent\":" << session.acksSent
+            << ",\"transactionsCommitted\":" << session.transactionsCommitted
+            << ",\"transactionsRolledBack\":" << session.transactionsRolledBack
+            << ",\"ackLatency\":";
+        writeHistogram(out, session.ackLatency);
+
+        out << ",\"consumers\":[";
+        for (std::size_t i = 0; i < session.consumers.size(); ++i) {
+            if (i > 0) {
+                out << ',';
+            }
+            writeConsumer(out, session.consumers[i]);
+        }
+
+        out << "],\"producers\":[";
+        for (std::size_t i = 0; i < session.producers.size(); ++i) {
+            if (i > 0) {
+                out << ',';
+            }
+            writeProducer(out, session.producers[i]);
+        }
+
+        out << "]}";
+    }
+
+    void writeTransport(std::ostream& out, const TransportMetricsSnapshot& transport) {
+
+        out << "{\"commandsSent\":" << transport.commandsSent
+            << ",\"commandsReceived\":" << transport.commandsReceived
+            << ",\"bytesSent\":" << transport.bytesSent
+            << ",\"bytesReceived\":" << transport.bytesReceived
+            << ",\"failoverInterruptions\":" << transport.failoverInterruptions
+            << ",\"failoverReconnects\":" << transport.failoverReconnects
+            << ",\"failoverConnectFailures\":" << transport.failoverConnectFailures
+            << ",\"reconnectTime\":";
+        writeHistogram(out, transport.reconnectTime);
+        out << '}';
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+HistogramSnapshot::HistogramSnapshot() : count(0), sum(0), buckets(BUCKETS, 0) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+double HistogramSnapshot::getMean() const {
+
+    if (this->count == 0) {
+        return 0.0;
+    }
+
+    return (double) this->sum / (double) this->count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long HistogramSnapshot::getPercentile(double percentile) const {
+
+    if (this->count == 0) {
+        return 0;
+    }
+
+    // The rank of the value at the given percentile, the smallest value that at least
+    // that percentage of all the values is less than or equal to.
+    double target = (percentile * (double) this->count) / 100.0;
+    long long rank = (long long) target;
+    if ((double) rank < target) {
+        rank++;
+    }
+    rank = rank - 1;
+
+    if (rank < 0) {
+        rank = 0;
+    } else if (rank >= this->count) {
+        rank = this->count - 1;
+    }
+
+    long long seen = 0;
+    for (std::size_t i = 0; i < this->buckets.size(); ++i) {
+        seen += this->buckets[i];
+        if (seen > rank) {
+            return getBucketUpperBound((int) i);
+        }
+    }
+
+    return getBucketUpperBound(BUCKETS - 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long HistogramSnapshot::getBucketUpperBound(int index) {
+
+    if (index >= BUCKETS - 1) {
+        return Long::MAX_VALUE;
+    }
+
+    return 1LL << index;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TransportMetricsSnapshot::TransportMetricsSnapshot() :
+    commandsSent(0), commandsReceived(0), bytesSent(0), bytesReceived(0), failoverInterruptions(0),
+    failoverReconnects(0), failoverConnectFailures(0), reconnectTime() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ConsumerMetricsSnapshot::ConsumerMetricsSnapshot() :
+    consumerId(), messagesReceived(0), bytesReceived(0), messagesRedelivered(0), poisonAcks(0), prefetchOccupancy(0),
+    prefetchAdjustments(0), prefetchSize(0), ackBatchSize(0), consumptionRate(0) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ProducerMetricsSnapshot::ProducerMetricsSnapshot() : producerId(), messagesSent(0), sendLatency(), windowBlockTime() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SessionMetricsSnapshot::SessionMetricsSnapshot() :
+    sessionId(), messagesSent(0), bytesSent(0), acksSent(0), transactionsCommitted(0), transactionsRolledBack(0),
+    ackLatency(), consumers(), producers() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ConnectionMetricsSnapshot::ConnectionMetricsSnapshot() :
+    connectionId(), timestamp(0), syncRequests(0), inFlightRequests(0), syncRequestLatency(), transport(),
+    stageLatency(), sessions() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string ConnectionMetricsSnapshot::toJSON() const {
+
+    std::ostringstream out;
+
+    out << "{\"connectionId\":";
+    writeString(out, this->connectionId);
+    out << ",\"timestamp\":" << this->timestamp
+        << ",\"syncRequests\":" << this->syncRequests
+        << ",\"inFlightRequests\":" << this->inFlightRequests
+        << ",\"syncRequestLatency\":";
+    writeHistogram(out, this->syncRequestLatency);
+    out << ",\"transport\":";
+    writeTransport(out, this->transport);
+
+    out << ",\"stageLatency\":{";
+    for (std::size_t i = 0; i < this->stageLatency.size(); ++i) {
+        if (i > 0) {
+            out << ',';
+        }
+        writeString(out, MessageTrace::getStageName((int) i));
+        out << ':';
+        writeHistogram(out, this->stageLatency[i]);
+    }
+    out << '}';
+
+    out << ",\"sessions\":[";
+    for (std::size_t i = 0; i < this->sessions.size(); ++i) {
+        if (i > 0) {
+            out << ',';
+        }
+        writeSession(out, this->sessions[i]);
+    }
+    out << "]}";
+
+    return out.str();
+}
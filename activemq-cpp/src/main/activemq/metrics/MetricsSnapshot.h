@@ -0,0 +1,215 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_METRICS_METRICSSNAPSHOT_H_
+#define _ACTIVEMQ_METRICS_METRICSSNAPSHOT_H_
+
+#include <activemq/util/Config.h>
+
+#include <string>
+#include <vector>
+
+namespace activemq {
+namespace metrics {
+
+    /**
+     * The bucket counts of a Histogram at the time the snapshot was taken.
+     *
+     * @since 3.8
+     */
+    struct AMQCPP_API HistogramSnapshot {
+
+        /**
+         * The number of buckets in every Histogram.
+         */
+        static const int BUCKETS = 32;
+
+        // Number of values recorded.
+        long long count;
+
+        // Sum of the values recorded, in microseconds.
+        long long sum;
+
+        // Number of values recorded in each bucket, see getBucketUpperBound.
+        std::vector<long long> buckets;
+
+        HistogramSnapshot();
+
+        /**
+         * @return the mean of the recorded values in microseconds or zero if there are none.
+         */
+        double getMean() const;
+
+        /**
+         * Gets an estimate of the given percentile, the result is the upper bound of
+         * the bucket that the percentile falls in.
+         *
+         * @param percentile
+         *      The percentile to estimate, from 0.0 to 100.0.
+         *
+         * @return the estimated percentile in microseconds or zero if nothing was recorded.
+         */
+        long long getPercentile(double percentile) const;
+
+        /**
+         * @param index
+         *      The index of a bucket.
+         *
+         * @return the exclusive upper bound of the bucket in microseconds.
+         */
+        static long long getBucketUpperBound(int index);
+
+    };
+
+    /**
+     * Counts kept by the transport, these cover every transport the connection has
+     * used including the ones a failover transport has reconnected through.
+     *
+     * @since 3.8
+     */
+    struct AMQCPP_API TransportMetricsSnapshot {
+
+        long long commandsSent;
+        long long commandsReceived;
+        long long bytesSent;
+        long long bytesReceived;
+
+        // Number of times a failover transport lost its connection.
+        long long failoverInterruptions;
+
+        // Number of times a failover transport successfully (re)connected.
+        long long failoverReconnects;
+
+        // Number of failed connection attempts made by a failover transport.
+        long long failoverConnectFailures;
+
+        // Time from losing a connection to reconnecting.
+        HistogramSnapshot reconnectTime;
+
+        TransportMetricsSnapshot();
+
+    };
+
+    /**
+     * @since 3.8
+     */
+    struct AMQCPP_API ConsumerMetricsSnapshot {
+
+        std::string consumerId;
+
+        long long messagesReceived;
+        long long bytesReceived;
+        long long messagesRedelivered;
+        long long poisonAcks;
+
+        // Messages dispatched to the consumer that the broker hasn't been sent an ack for.
+        int prefetchOccupancy;
+
+        // Decisions of the adaptive prefetch controller, the prefetch and ack batch size are
+        // the fixed configured values when adaptive prefetch is disabled.
+        long long prefetchAdjustments;
+        int prefetchSize;
+        int ackBatchSize;
+        int consumptionRate;
+
+        ConsumerMetricsSnapshot();
+
+    };
+
+    /**
+     * @since 3.8
+     */
+    struct AMQCPP_API ProducerMetricsSnapshot {
+
+        std::string producerId;
+
+        long long messagesSent;
+
+        // Time taken by each send call.
+        HistogramSnapshot sendLatency;
+
+        // Time sends spent blocked waiting for space in the producer window.
+        HistogramSnapshot windowBlockTime;
+
+        ProducerMetricsSnapshot();
+
+    };
+
+    /**
+     * @since 3.8
+     */
+    struct AMQCPP_API SessionMetricsSnapshot {
+
+        std::string sessionId;
+
+        long long messagesSent;
+        long long bytesSent;
+        long long acksSent;
+        long long transactionsCommitted;
+        long long transactionsRolledBack;
+
+        // Time taken to hand each acknowledgement to the transport, or for the broker
+        // to respond when acks are sent synchronously.
+        HistogramSnapshot ackLatency;
+
+        std::vector<ConsumerMetricsSnapshot> consumers;
+        std::vector<ProducerMetricsSnapshot> producers;
+
+        SessionMetricsSnapshot();
+
+    };
+
+    /**
+     * A copy of all the metrics of a connection and its sessions, consumers and producers
+     * taken while they are all running.  Each value is read independently so values that
+     * change while the snapshot is taken may not be consistent with each other.
+     *
+     * @since 3.8
+     */
+    struct AMQCPP_API ConnectionMetricsSnapshot {
+
+        std::string connectionId;
+
+        // Time the snapshot was taken in milliseconds since the epoch.
+        long long timestamp;
+
+        long long syncRequests;
+        int inFlightRequests;
+
+        // Round trip time of requests that wait for a response from the broker.
+        HistogramSnapshot syncRequestLatency;
+
+        TransportMetricsSnapshot transport;
+
+        // Time sampled messages took to reach each stage of the pipeline from the stage
+        // before it, indexed by MessageTrace::Stage.
+        std::vector<HistogramSnapshot> stageLatency;
+
+        std::vector<SessionMetricsSnapshot> sessions;
+
+        ConnectionMetricsSnapshot();
+
+        /**
+         * @return the snapshot as a JSON document.
+         */
+        std::string toJSON() const;
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_METRICS_METRICSSNAPSHOT_H_ */
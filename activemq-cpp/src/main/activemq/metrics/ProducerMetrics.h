@@ -0,0 +1,92 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _ACTIVEMQ_METRICS_PRODUCERMETRICS_H_
+#define _ACTIVEMQ_METRICS_PRODUCERMETRICS_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/metrics/Counter.h>
+#include <activemq/metrics/Histogram.h>
+#include <activemq/metrics/MetricsSnapshot.h>
+
+namespace activemq {
+namespace metrics {
+
+    /**
+     * Metrics recorded by a single MessageProducer.
+     *
+     * @since 3.8
+     */
+    class AMQCPP_API ProducerMetrics {
+    private:
+
+        Counter messagesSent;
+        Histogram sendLatency;
+        Histogram windowBlockTime;
+
+    private:
+
+        ProducerMetrics(const ProducerMetrics&);
+        ProducerMetrics& operator=(const ProducerMetrics&);
+
+    public:
+
+        ProducerMetrics();
+
+        virtual ~ProducerMetrics();
+
+        /**
+         * @return the Counter of messages sent by the producer.
+         */
+        Counter& getMessagesSent() {
+            return this->messagesSent;
+        }
+
+        /**
+         * @return the Histogram of time taken by each send call.
+         */
+        Histogram& getSendLatency() {
+            return this->sendLatency;
+        }
+
+        /**
+         * @return the Histogram of time sends spent blocked waiting for space in the producer window.
+         */
+        Histogram& getWindowBlockTime() {
+            return this->windowBlockTime;
+        }
+
+        /**
+         * Copies the current values into the given snapshot without blocking the threads
+         * that are recording new values.
+         *
+         * @param snapshot
+         *      The snapshot to fill in.
+         */
+        void snapshot(ProducerMetricsSnapshot& snapshot) const;
+
+        /**
+         * Resets all the metrics to zero.
+         */
+        void reset();
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_METRICS_PRODUCERMETRICS_H_ */
@@ -0,0 +1,117 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _ACTIVEMQ_METRICS_SESSIONMETRICS_H_
+#define _ACTIVEMQ_METRICS_SESSIONMETRICS_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/metrics/Counter.h>
+#include <activemq/metrics/Histogram.h>
+#include <activemq/metrics/MetricsSnapshot.h>
+
+namespace activemq {
+namespace metrics {
+
+    /**
+     * Metrics recorded by a single Session, the metrics of its consumers and producers are
+     * kept by the consumers and producers themselves.
+     *
+     * @since 3.8
+     */
+    class AMQCPP_API SessionMetrics {
+    private:
+
+        Counter messagesSent;
+        Counter bytesSent;
+        Counter acksSent;
+        Counter transactionsCommitted;
+        Counter transactionsRolledBack;
+        Histogram ackLatency;
+
+    private:
+
+        SessionMetrics(const SessionMetrics&);
+        SessionMetrics& operator=(const SessionMetrics&);
+
+    public:
+
+        SessionMetrics();
+
+        virtual ~SessionMetrics();
+
+        /**
+         * @return the Counter of messages sent by the producers of the session.
+         */
+        Counter& getMessagesSent() {
+            return this->messagesSent;
+        }
+
+        /**
+         * @return the Counter of size of the messages sent by the producers of the session.
+         */
+        Counter& getBytesSent() {
+            return this->bytesSent;
+        }
+
+        /**
+         * @return the Counter of acknowledgements sent by the session.
+         */
+        Counter& getAcksSent() {
+            return this->acksSent;
+        }
+
+        /**
+         * @return the Counter of local transactions committed.
+         */
+        Counter& getTransactionsCommitted() {
+            return this->transactionsCommitted;
+        }
+
+        /**
+         * @return the Counter of local transactions rolled back.
+         */
+        Counter& getTransactionsRolledBack() {
+            return this->transactionsRolledBack;
+        }
+
+        /**
+         * @return the Histogram of time taken to send each acknowledgement.
+         */
+        Histogram& getAckLatency() {
+            return this->ackLatency;
+        }
+
+        /**
+         * Copies the current values into the given snapshot without blocking the threads
+         * that are recording new values.
+         *
+         * @param snapshot
+         *      The snapshot to fill in.
+         */
+        void snapshot(SessionMetricsSnapshot& snapshot) const;
+
+        /**
+         * Resets all the metrics to zero.
+         */
+        void reset();
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_METRICS_SESSIONMETRICS_H_ */
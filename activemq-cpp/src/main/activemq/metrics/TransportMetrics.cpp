@@ -0,0 +1,54 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "TransportMetrics.h"
+
+using namespace activemq;
+using namespace activemq::metrics;
+
+////////////////////////////////////////////////////////////////////////////////
+TransportMetrics::TransportMetrics() : commandsSent(), commandsReceived(), bytesSent(), bytesReceived(), failoverInterruptions(), failoverReconnects(), failoverConnectFailures(), reconnectTime(), tracer() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TransportMetrics::~TransportMetrics() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TransportMetrics::snapshot(TransportMetricsSnapshot& snapshot) const {
+    snapshot.commandsSent = this->commandsSent.get();
+    snapshot.commandsReceived = this->commandsReceived.get();
+    snapshot.bytesSent = this->bytesSent.get();
+    snapshot.bytesReceived = this->bytesReceived.get();
+    snapshot.failoverInterruptions = this->failoverInterruptions.get();
+    snapshot.failoverReconnects = this->failoverReconnects.get();
+    snapshot.failoverConnectFailures = this->failoverConnectFailures.get();
+    this->reconnectTime.snapshot(snapshot.reconnectTime);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TransportMetrics::reset() {
+    this->commandsSent.reset();
+    this->commandsReceived.reset();
+    this->bytesSent.reset();
+    this->bytesReceived.reset();
+    this->failoverInterruptions.reset();
+    this->failoverReconnects.reset();
+    this->failoverConnectFailures.reset();
+    this->reconnectTime.reset();
+}
@@ -0,0 +1,156 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _ACTIVEMQ_METRICS_TRANSPORTMETRICS_H_
+#define _ACTIVEMQ_METRICS_TRANSPORTMETRICS_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/metrics/Counter.h>
+#include <activemq/metrics/Histogram.h>
+#include <activemq/metrics/MetricsSnapshot.h>
+#include <activemq/metrics/MessageTracer.h>
+
+#include <decaf/lang/Pointer.h>
+
+namespace activemq {
+namespace metrics {
+
+    /**
+     * Metrics recorded by the transports of a connection.  A single instance is shared by
+     * a failover transport and each of the transports it connects through so that the
+     * counts cover the life of the connection.
+     *
+     * @since 3.8
+     */
+    class AMQCPP_API TransportMetrics {
+    private:
+
+        Counter commandsSent;
+        Counter commandsReceived;
+        Counter bytesSent;
+        Counter bytesReceived;
+        Counter failoverInterruptions;
+        Counter failoverReconnects;
+        Counter failoverConnectFailures;
+        Histogram reconnectTime;
+
+        decaf::lang::Pointer<MessageTracer> tracer;
+
+    private:
+
+        TransportMetrics(const TransportMetrics&);
+        TransportMetrics& operator=(const TransportMetrics&);
+
+    public:
+
+        TransportMetrics();
+
+        virtual ~TransportMetrics();
+
+        /**
+         * @return the Counter of commands written to the wire.
+         */
+        Counter& getCommandsSent() {
+            return this->commandsSent;
+        }
+
+        /**
+         * @return the Counter of commands read from the wire.
+         */
+        Counter& getCommandsReceived() {
+            return this->commandsReceived;
+        }
+
+        /**
+         * @return the Counter of bytes written to the wire.
+         */
+        Counter& getBytesSent() {
+            return this->bytesSent;
+        }
+
+        /**
+         * @return the Counter of bytes read from the wire.
+         */
+        Counter& getBytesReceived() {
+            return this->bytesReceived;
+        }
+
+        /**
+         * @return the Counter of times a failover transport lost its connection.
+         */
+        Counter& getFailoverInterruptions() {
+            return this->failoverInterruptions;
+        }
+
+        /**
+         * @return the Counter of times a failover transport successfully connected.
+         */
+        Counter& getFailoverReconnects() {
+            return this->failoverReconnects;
+        }
+
+        /**
+         * @return the Counter of failed connection attempts made by a failover transport.
+         */
+        Counter& getFailoverConnectFailures() {
+            return this->failoverConnectFailures;
+        }
+
+        /**
+         * @return the Histogram of time taken for a failover transport to reconnect.
+         */
+        Histogram& getReconnectTime() {
+            return this->reconnectTime;
+        }
+
+        /**
+         * @return the tracer that the transports stamp sampled messages with, or NULL.
+         */
+        MessageTracer* getMessageTracer() const {
+            return this->tracer.get();
+        }
+
+        /**
+         * Sets the tracer that the transports stamp sampled messages with.
+         *
+         * @param tracer
+         *      The tracer of the connection that these metrics belong to.
+         */
+        void setMessageTracer(const decaf::lang::Pointer<MessageTracer> tracer) {
+            this->tracer = tracer;
+        }
+
+        /**
+         * Copies the current values into the given snapshot without blocking the threads
+         * that are recording new values.
+         *
+         * @param snapshot
+         *      The snapshot to fill in.
+         */
+        void snapshot(TransportMetricsSnapshot& snapshot) const;
+
+        /**
+         * Resets all the metrics to zero.
+         */
+        void reset();
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_METRICS_TRANSPORTMETRICS_H_ */
@@ -18,6 +18,7 @@
 #include "ConnectionStateTracker.h"
 
 #include <decaf/lang/Runnable.h>
+#include <decaf/lang/System.h>
 #include <decaf/util/HashCode.h>
 #include <decaf/util/LinkedHashMap.h>
 #include <decaf/util/MapEntry.h>
@@ -28,7 +29,9 @@
 #include <activemq/commands/ExceptionResponse.h>
 #include <activemq/commands/RemoveInfo.h>
 #include <activemq/core/ActiveMQConstants.h>
+#include <activemq/transport/IOTransport.h>
 #include <activemq/transport/TransportListener.h>
+#include <activemq/util/CompactId.h>
 #include <activemq/wireformat/WireFormat.h>
 
 using namespace activemq;
@@ -36,6 +39,7 @@ using namespace activemq::core;
 using namespace activemq::state;
 using namespace activemq::commands;
 using namespace activemq::exceptions;
+using namespace activemq::util;
 using namespace decaf;
 using namespace decaf::lang;
 using namespace decaf::io;
@@ -46,7 +50,7 @@ namespace activemq {
 namespace state {
 
 
-    class MessageCache : public LinkedHashMap<Pointer<MessageId>, Pointer<Command> > {
+    class MessageCache : public LinkedHashMap<CompactId, Pointer<Command> > {
     protected:
 
         ConnectionStateTracker* parent;
@@ -58,12 +62,12 @@ namespace state {
     public:
 
         MessageCache(ConnectionStateTracker* parent) :
-            LinkedHashMap<Pointer<MessageId>, Pointer<Command> >(), parent(parent), currentCacheSize(0) {
+            LinkedHashMap<CompactId, Pointer<Command> >(), parent(parent), currentCacheSize(0) {
         }
 
         virtual ~MessageCache() {}
 
-        virtual bool removeEldestEntry(const MapEntry<Pointer<MessageId>, Pointer<Command> >& eldest) {
+        virtual bool removeEldestEntry(const MapEntry<CompactId, Pointer<Command> >& eldest) {
             bool result = currentCacheSize > parent->getMaxMessageCacheSize();
             if (result) {
                 Pointer<Message> message = eldest.getValue().dynamicCast<Message>();
@@ -114,11 +118,19 @@ namespace state {
         /** Store MessagePull commands for replay */
         MessagePullCache messagePullCache;
 
+        /** The IOTransport whose writes are batched while a restore is in progress */
+        transport::IOTransport* replayTransport;
+
+        /** Number of Commands replayed by the restore in progress */
+        int replayCount;
+
         StateTrackerImpl(ConnectionStateTracker * parent) : parent(parent),
                                                             TRACKED_RESPONSE_MARKER(new Tracked()),
                                                             connectionStates(),
                                                             messageCache(parent),
-                                                            messagePullCache(parent) {
+                                                            messagePullCache(parent),
+                                                            replayTransport(NULL),
+                                                            replayCount(0) {
         }
 
         ~StateTrackerImpl() {
@@ -172,7 +184,10 @@ ConnectionStateTracker::ConnectionStateTracker() : impl(new StateTrackerImpl(thi
                                                    trackMessages(true),
                                                    trackTransactionProducers(true),
                                                    maxMessageCacheSize(128 * 1024),
-                                                   maxMessagePullCacheSize(10) {
+                                                   maxMessagePullCacheSize(10),
+                                                   restoreSyncInterval(0),
+                                                   lastRestoreDuration(0),
+                                                   lastRestoreCommandCount(0) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -221,6 +236,56 @@ void ConnectionStateTracker::trackBack(Pointer<Command> command) {
 ////////////////////////////////////////////////////////////////////////////////
 void ConnectionStateTracker::restore(Pointer<transport::Transport> transport) {
 
+    long long startTime = System::currentTimeMillis();
+
+    this->impl->replayCount = 0;
+    this->impl->replayTransport = dynamic_cast<transport::IOTransport*>(
+        transport->narrow(typeid(transport::IOTransport)));
+
+    try {
+
+        // Marshal the whole restore set into the output buffer and let it go out in large
+        // writes instead of flushing the socket once per replayed command.
+        if (this->impl->replayTransport != NULL) {
+            this->impl->replayTransport->beginBatch();
+        }
+
+        try {
+            doRestoreConnections(transport);
+        } catch (...) {
+
+            // The transport has most likely failed, release the batch so it isn't left
+            // holding back writes and ignore any error from the flush.
+            try {
+                if (this->impl->replayTransport != NULL) {
+                    this->impl->replayTransport->endBatch();
+                }
+            } catch (...) {
+            }
+
+            this->impl->replayTransport = NULL;
+            this->lastRestoreCommandCount = this->impl->replayCount;
+            this->lastRestoreDuration = System::currentTimeMillis() - startTime;
+            throw;
+        }
+
+        transport::IOTransport* batched = this->impl->replayTransport;
+        this->impl->replayTransport = NULL;
+        if (batched != NULL) {
+            batched->endBatch();
+        }
+
+        this->lastRestoreCommandCount = this->impl->replayCount;
+        this->lastRestoreDuration = System::currentTimeMillis() - startTime;
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ConnectionStateTracker::doRestoreConnections(Pointer<transport::Transport> transport) {
+
     try {
 
         Pointer<Iterator<Pointer<ConnectionState> > > iterator(
@@ -231,7 +296,7 @@ void ConnectionStateTracker::restore(Pointer<transport::Transport> transport) {
 
             Pointer<ConnectionInfo> info = state->getInfo();
             info->setFailoverReconnect(true);
-            transport->oneway(info);
+            replay(transport, info);
 
             doRestoreTempDestinations(transport, state);
 
@@ -247,12 +312,12 @@ void ConnectionStateTracker::restore(Pointer<transport::Transport> transport) {
         // Now we flush messages
         Pointer<Iterator<Pointer<Command> > > messages(this->impl->messageCache.values().iterator());
         while (messages->hasNext()) {
-            transport->oneway(messages->next());
+            replay(transport, messages->next());
         }
 
         Pointer<Iterator<Pointer<Command> > > messagePullIter(this->impl->messagePullCache.values().iterator());
         while (messagePullIter->hasNext()) {
-            transport->oneway(messagePullIter->next());
+            replay(transport, messagePullIter->next());
         }
     }
     AMQ_CATCH_RETHROW(IOException)
@@ -260,6 +325,36 @@ void ConnectionStateTracker::restore(Pointer<transport::Transport> transport) {
     AMQ_CATCHALL_THROW(IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ConnectionStateTracker::replay(Pointer<transport::Transport> transport, Pointer<Command> command) {
+
+    this->impl->replayCount++;
+
+    if (restoreSyncInterval > 0) {
+
+        // The commands that mark a sync barrier ask the broker for a response, the
+        // pending writes are pushed out at each barrier so the broker can start on them.
+        // The tracked command is never modified, a caller blocked on its response across
+        // the failover still needs the flag it was sent with, so a barrier that didn't
+        // already require a response is sent as a copy with the flag raised.
+        bool barrier = (this->impl->replayCount % restoreSyncInterval) == 0;
+        if (barrier && !command->isResponseRequired()) {
+            Pointer<Command> copy(dynamic_cast<Command*>(command->cloneDataStructure()));
+            copy->setResponseRequired(true);
+            transport->oneway(copy);
+        } else {
+            transport->oneway(command);
+        }
+
+        if (barrier && this->impl->replayTransport != NULL) {
+            this->impl->replayTransport->endBatch();
+            this->impl->replayTransport->beginBatch();
+        }
+    } else {
+        transport->oneway(command);
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ConnectionStateTracker::doRestoreTransactions(Pointer<transport::Transport> transport, Pointer<ConnectionState> connectionState) {
 
@@ -285,18 +380,18 @@ void ConnectionStateTracker::doRestoreTransactions(Pointer<transport::Transport>
             // replay short lived producers that may have been involved in the transaction
             Pointer<Iterator<Pointer<ProducerState> > > state(txState->getProducerStates().iterator());
             while (state->hasNext()) {
-                transport->oneway(state->next()->getInfo());
+                replay(transport, state->next()->getInfo());
             }
 
             std::auto_ptr<Iterator<Pointer<Command> > > commands(txState->getCommands().iterator());
 
             while (commands->hasNext()) {
-                transport->oneway(commands->next());
+                replay(transport, commands->next());
             }
 
             state.reset(txState->getProducerStates().iterator());
             while (state->hasNext()) {
-                transport->oneway(state->next()->getInfo()->createRemoveCommand());
+                replay(transport, state->next()->getInfo()->createRemoveCommand());
             }
         }
 
@@ -326,7 +421,7 @@ void ConnectionStateTracker::doRestoreSessions(Pointer<transport::Transport> tra
         Pointer<Iterator<Pointer<SessionState> > > iter(connectionState->getSessionStates().iterator());
         while (iter->hasNext()) {
             Pointer<SessionState> state = iter->next();
-            transport->oneway(state->getInfo());
+            replay(transport, state->getInfo());
 
             if (restoreProducers) {
                 doRestoreProducers(transport, state);
@@ -366,7 +461,7 @@ void ConnectionStateTracker::doRestoreConsumers(Pointer<transport::Transport> tr
                 infoToSend->setPrefetchSize(0);
             }
 
-            transport->oneway(infoToSend);
+            replay(transport, infoToSend);
         }
     }
     AMQ_CATCH_RETHROW(IOException)
@@ -383,7 +478,7 @@ void ConnectionStateTracker::doRestoreProducers(Pointer<transport::Transport> tr
         Pointer<Iterator<Pointer<ProducerState> > > iter(sessionState->getProducerStates().iterator());
         while (iter->hasNext()) {
             Pointer<ProducerState> state = iter->next();
-            transport->oneway(state->getInfo());
+            replay(transport, state->getInfo());
         }
     }
     AMQ_CATCH_RETHROW(IOException)
@@ -397,7 +492,7 @@ void ConnectionStateTracker::doRestoreTempDestinations(Pointer<transport::Transp
         std::auto_ptr<Iterator<Pointer<DestinationInfo> > > iter(connectionState->getTempDesinations().iterator());
 
         while (iter->hasNext()) {
-            transport->oneway(iter->next());
+            replay(transport, iter->next());
         }
     }
     AMQ_CATCH_RETHROW(IOException)
@@ -646,7 +741,7 @@ Pointer<Command> ConnectionStateTracker::processMessage(Message* message) {
                 return this->impl->TRACKED_RESPONSE_MARKER;
             } else if (trackMessages) {
                 this->impl->messageCache.put(
-                    message->getMessageId(), Pointer<Message>(message->cloneDataStructure()));
+                    message->getMessageId()->getCompactId(), Pointer<Message>(message->cloneDataStructure()));
             }
         }
 
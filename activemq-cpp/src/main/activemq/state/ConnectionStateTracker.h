@@ -52,6 +52,9 @@ namespace state {
         bool trackTransactionProducers;
         int maxMessageCacheSize;
         int maxMessagePullCacheSize;
+        int restoreSyncInterval;
+        long long lastRestoreDuration;
+        int lastRestoreCommandCount;
 
         friend class RemoveTransactionAction;
 
@@ -180,8 +183,43 @@ namespace state {
             this->trackTransactionProducers = trackTransactionProducers;
         }
 
+        /**
+         * Gets the number of Commands replayed by restore between sync barriers.  When zero
+         * the replayed Commands keep their original response required flag, otherwise only
+         * every Nth replayed Command asks the Broker for a response and the pending writes
+         * are flushed at each of those barriers.
+         *
+         * @returns the number of Commands replayed between sync barriers, or zero if disabled.
+         */
+        int getRestoreSyncInterval() const {
+            return this->restoreSyncInterval;
+        }
+
+        void setRestoreSyncInterval(int restoreSyncInterval) {
+            this->restoreSyncInterval = restoreSyncInterval > 0 ? restoreSyncInterval : 0;
+        }
+
+        /**
+         * @returns the time in milliseconds that the last call to restore took.
+         */
+        long long getLastRestoreDuration() const {
+            return this->lastRestoreDuration;
+        }
+
+        /**
+         * @returns the number of Commands that were replayed by the last call to restore.
+         */
+        int getLastRestoreCommandCount() const {
+            return this->lastRestoreCommandCount;
+        }
+
     private:
 
+        void replay(decaf::lang::Pointer<transport::Transport> transport,
+                    decaf::lang::Pointer<Command> command);
+
+        void doRestoreConnections(decaf::lang::Pointer<transport::Transport> transport);
+
         void doRestoreTransactions(decaf::lang::Pointer<transport::Transport> transport,
                                    decaf::lang::Pointer<ConnectionState> connectionState);
 
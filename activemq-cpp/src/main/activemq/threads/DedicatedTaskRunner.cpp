@@ -37,6 +37,18 @@ DedicatedTaskRunner::DedicatedTaskRunner(Task* task) :
     this->thread.reset(new Thread(this, "ActiveMQ Dedicated Task Runner"));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+DedicatedTaskRunner::DedicatedTaskRunner(Task* task, const ThreadPlacement& placement) :
+    mutex(), thread(), threadTerminated(false), pending(false), shutDown(false), task(task) {
+
+    if (this->task == NULL) {
+        throw NullPointerException(__FILE__, __LINE__, "Task passed was null");
+    }
+
+    this->thread.reset(new Thread(this, "ActiveMQ Dedicated Task Runner"));
+    placement.applyTo(this->thread.get());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 DedicatedTaskRunner::~DedicatedTaskRunner() {
     try {
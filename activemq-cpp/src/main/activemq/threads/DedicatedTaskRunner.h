@@ -21,6 +21,7 @@
 #include <activemq/util/Config.h>
 #include <activemq/threads/TaskRunner.h>
 #include <activemq/threads/Task.h>
+#include <activemq/threads/ThreadPlacement.h>
 
 #include <decaf/lang/Thread.h>
 #include <decaf/lang/Runnable.h>
@@ -50,6 +51,15 @@ namespace threads {
     public:
 
         DedicatedTaskRunner(Task* task);
+
+        /**
+         * Creates a runner whose thread is placed on the given processors before it
+         * is started.
+         *
+         * @param task - The Task to run.
+         * @param placement - Where the runner's thread should be run.
+         */
+        DedicatedTaskRunner(Task* task, const ThreadPlacement& placement);
         virtual ~DedicatedTaskRunner();
 
         virtual void start();
@@ -0,0 +1,166 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ThreadPlacement.h"
+
+#include <decaf/lang/Exception.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/lang/exceptions/NumberFormatException.h>
+#include <decaf/util/StringTokenizer.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::threads;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const std::string NODE_PREFIX = "node:";
+
+    int parseIndex(const std::string& value, const std::string& placement) {
+
+        try {
+            int result = Integer::parseInt(value);
+            if (result >= 0) {
+                return result;
+            }
+        } catch (NumberFormatException& ex) {
+        }
+
+        throw IllegalArgumentException(__FILE__, __LINE__,
+            "Invalid thread placement \"%s\", \"%s\" is not a valid index.", placement.c_str(), value.c_str());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ThreadPlacement::ThreadPlacement() : cpus(), numaNode(-1) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ThreadPlacement::~ThreadPlacement() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ThreadPlacement ThreadPlacement::parse(const std::string& value) {
+
+    ThreadPlacement placement;
+
+    if (value.empty()) {
+        return placement;
+    }
+
+    if (value.compare(0, NODE_PREFIX.length(), NODE_PREFIX) == 0) {
+        placement.numaNode = parseIndex(value.substr(NODE_PREFIX.length()), value);
+        return placement;
+    }
+
+    StringTokenizer tokenizer(value, ",");
+    while (tokenizer.hasMoreTokens()) {
+
+        std::string token = tokenizer.nextToken();
+        std::string::size_type dash = token.find('-');
+
+        if (dash == std::string::npos) {
+            placement.cpus.push_back(parseIndex(token, value));
+            continue;
+        }
+
+        int first = parseIndex(token.substr(0, dash), value);
+        int last = parseIndex(token.substr(dash + 1), value);
+        if (last < first) {
+            throw IllegalArgumentException(__FILE__, __LINE__,
+                "Invalid thread placement \"%s\", range \"%s\" is reversed.", value.c_str(), token.c_str());
+        }
+
+        for (int cpu = first; cpu <= last; ++cpu) {
+            placement.cpus.push_back(cpu);
+        }
+    }
+
+    if (placement.cpus.empty()) {
+        throw IllegalArgumentException(__FILE__, __LINE__,
+            "Invalid thread placement \"%s\", no processors listed.", value.c_str());
+    }
+
+    std::sort(placement.cpus.begin(), placement.cpus.end());
+    placement.cpus.erase(std::unique(placement.cpus.begin(), placement.cpus.end()), placement.cpus.end());
+
+    return placement;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ThreadPlacement::isEmpty() const {
+    return this->cpus.empty() && this->numaNode < 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ThreadPlacement::applyTo(Thread* thread) const {
+
+    if (thread == NULL) {
+        throw NullPointerException(__FILE__, __LINE__, "Thread passed was null");
+    }
+
+    if (isEmpty()) {
+        return false;
+    }
+
+    try {
+        if (this->numaNode >= 0) {
+            thread->setNumaNode(this->numaNode);
+        } else {
+            thread->setAffinity(this->cpus);
+        }
+    } catch (Exception& ex) {
+        // The placement is only a hint, a platform that can't place threads or a node
+        // or processor it doesn't know about must never stop the thread from running.
+        return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ThreadPlacement::applyToCurrentThread() const {
+    return applyTo(Thread::currentThread());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string ThreadPlacement::toString() const {
+
+    if (this->numaNode >= 0) {
+        return NODE_PREFIX + Integer::toString(this->numaNode);
+    }
+
+    std::string result;
+    std::vector<int>::const_iterator iter = this->cpus.begin();
+    for (; iter != this->cpus.end(); ++iter) {
+        if (!result.empty()) {
+            result += ",";
+        }
+        result += Integer::toString(*iter);
+    }
+
+    return result;
+}
@@ -0,0 +1,120 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_THREADS_THREADPLACEMENT_H_
+#define _ACTIVEMQ_THREADS_THREADPLACEMENT_H_
+
+#include <activemq/util/Config.h>
+
+#include <decaf/lang/Thread.h>
+
+#include <string>
+#include <vector>
+
+namespace activemq {
+namespace threads {
+
+    /**
+     * Describes where a client thread should be run, either on an explicit set of
+     * processors or on the processors of a single NUMA node.  Placements are given
+     * as URI options using the following forms:
+     *
+     *   - "" leaves the thread to the operating system scheduler.
+     *   - "2" or "0,2,4-7" binds the thread to the listed processors.
+     *   - "node:1" binds the thread to the processors of NUMA node one.
+     *
+     * @since 3.2
+     */
+    class AMQCPP_API ThreadPlacement {
+    private:
+
+        std::vector<int> cpus;
+        int numaNode;
+
+    public:
+
+        /**
+         * Creates an empty placement that leaves threads where the OS puts them.
+         */
+        ThreadPlacement();
+
+        virtual ~ThreadPlacement();
+
+        /**
+         * Parses a placement from its string form.
+         *
+         * @param value
+         *      The placement string, see the class description for the accepted forms.
+         *
+         * @return the parsed ThreadPlacement.
+         *
+         * @throws IllegalArgumentException if the value is malformed.
+         */
+        static ThreadPlacement parse(const std::string& value);
+
+        /**
+         * @return true if this placement doesn't restrict where a thread runs.
+         */
+        bool isEmpty() const;
+
+        /**
+         * @return the explicitly listed processors, empty for a NUMA node placement.
+         */
+        const std::vector<int>& getProcessors() const {
+            return this->cpus;
+        }
+
+        /**
+         * @return the NUMA node the thread is bound to, or -1 if none was given.
+         */
+        int getNumaNode() const {
+            return this->numaNode;
+        }
+
+        /**
+         * Applies this placement to the given thread, the thread can be placed before it
+         * is started.  Platforms that can't place threads, unknown NUMA nodes and processor
+         * sets the operating system rejects are silently ignored since the placement is
+         * only ever a performance hint.
+         *
+         * @param thread
+         *      The thread to place.
+         *
+         * @return true if the placement was applied, false if empty or it couldn't be.
+         *
+         * @throws NullPointerException if the thread is NULL.
+         */
+        bool applyTo(decaf::lang::Thread* thread) const;
+
+        /**
+         * Applies this placement to the calling thread, useful for threads that the
+         * client doesn't create itself such as those owned by a Timer.
+         *
+         * @return true if the placement was applied, false if empty or it couldn't be.
+         */
+        bool applyToCurrentThread() const;
+
+        /**
+         * @return the string form of this placement, parse accepts it back.
+         */
+        std::string toString() const;
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_THREADS_THREADPLACEMENT_H_ */
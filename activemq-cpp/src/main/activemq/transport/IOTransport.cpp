@@ -17,11 +17,15 @@
 
 #include "IOTransport.h"
 
+#include <decaf/lang/System.h>
 #include <decaf/util/concurrent/Concurrent.h>
 #include <decaf/util/concurrent/atomic/AtomicBoolean.h>
 #include <decaf/lang/exceptions/UnsupportedOperationException.h>
 #include <activemq/wireformat/WireFormat.h>
+#include <activemq/commands/Message.h>
+#include <activemq/commands/MessageDispatch.h>
 #include <activemq/exceptions/ActiveMQException.h>
+#include <activemq/metrics/Counter.h>
 #include <activemq/util/Config.h>
 #include <typeinfo>
 
@@ -30,6 +34,7 @@ using namespace activemq::transport;
 using namespace activemq::exceptions;
 using namespace activemq::commands;
 using namespace activemq::wireformat;
+using namespace activemq::metrics;
 using namespace decaf;
 using namespace decaf::io;
 using namespace decaf::lang;
@@ -58,12 +63,41 @@ namespace transport {
         Pointer<decaf::lang::Thread> thread;
         AtomicBoolean closed;
         AtomicBoolean started;
-
-        IOTransportImpl() : wireFormat(), listener(NULL), inputStream(NULL), outputStream(NULL), thread(), closed(false) {
+        activemq::threads::ThreadPlacement readerPlacement;
+        long long busyPollTime;
+        activemq::metrics::Counter busyPollSpinCount;
+        activemq::metrics::Counter busyPollWaitCount;
+        Pointer<TransportMetrics> metrics;
+
+        // Nesting depth of write batches, guarded by the output stream's lock.
+        int batchDepth;
+
+        IOTransportImpl() : wireFormat(), listener(NULL), inputStream(NULL), outputStream(NULL), thread(), closed(false),
+                            started(), readerPlacement(), busyPollTime(0), busyPollSpinCount(), busyPollWaitCount(), metrics(),
+                            batchDepth(0) {
         }
 
         IOTransportImpl(const Pointer<WireFormat> wireFormat) :
-            wireFormat(wireFormat), listener(NULL), inputStream(NULL), outputStream(NULL), thread(), closed(false) {
+            wireFormat(wireFormat), listener(NULL), inputStream(NULL), outputStream(NULL), thread(), closed(false),
+            started(), readerPlacement(), busyPollTime(0), busyPollSpinCount(), busyPollWaitCount(), metrics(),
+            batchDepth(0) {
+        }
+
+        /**
+         * Spins until the input stream has data that can be read without blocking or the
+         * busy poll time has elapsed, the outcome is recorded in the spin and wait counters.
+         */
+        void busyPoll() {
+
+            long long deadline = System::nanoTime() + busyPollTime * 1000;
+            do {
+                if (inputStream->available() > 0) {
+                    busyPollSpinCount.increment();
+                    return;
+                }
+            } while (!closed.get() && System::nanoTime() < deadline);
+
+            busyPollWaitCount.increment();
         }
     };
 
@@ -142,9 +176,26 @@ void IOTransport::oneway(const Pointer<Command> command) {
         }
 
         synchronized(impl->outputStream) {
+            long long startSize = this->impl->outputStream->size();
+
             // Write the command to the output stream.
             this->impl->wireFormat->marshal(command, this, this->impl->outputStream);
-            this->impl->outputStream->flush();
+            if (this->impl->batchDepth == 0) {
+                this->impl->outputStream->flush();
+            }
+
+            Pointer<TransportMetrics> metrics = this->impl->metrics;
+            if (metrics != NULL) {
+                metrics->getCommandsSent().increment();
+                metrics->getBytesSent().add(this->impl->outputStream->size() - startSize);
+
+                if (command->isMessage()) {
+                    const Message* message = dynamic_cast<const Message*>(command.get());
+                    if (message != NULL && message->getTrace() != NULL) {
+                        message->getTrace()->mark(MessageTrace::TRANSPORT_SEND);
+                    }
+                }
+            }
         }
     }
     AMQ_CATCH_RETHROW(IOException)
@@ -171,6 +222,7 @@ void IOTransport::start() {
 
             // Start the polling thread.
             impl->thread.reset(new Thread(this, "IOTransport reader Thread"));
+            impl->readerPlacement.applyTo(impl->thread.get());
             impl->thread->start();
         }
     }
@@ -265,11 +317,37 @@ void IOTransport::run() {
 
     try {
 
+        long long bytesRead = this->impl->inputStream->getBytesRead();
+
         while (this->impl->started.get() && !this->impl->closed.get()) {
 
+            if (this->impl->busyPollTime > 0) {
+                this->impl->busyPoll();
+            }
+
             // Read the next command from the input stream.
             Pointer<Command> command(impl->wireFormat->unmarshal(this, this->impl->inputStream));
 
+            Pointer<TransportMetrics> metrics = this->impl->metrics;
+            if (metrics != NULL) {
+                long long total = this->impl->inputStream->getBytesRead();
+                metrics->getCommandsReceived().increment();
+                metrics->getBytesReceived().add(total - bytesRead);
+                bytesRead = total;
+
+                MessageTracer* tracer = metrics->getMessageTracer();
+                if (tracer != NULL && tracer->isEnabled() && command->isMessageDispatch()) {
+                    const Pointer<Message>& message = command.dynamicCast<MessageDispatch>()->getMessage();
+                    if (message != NULL) {
+                        Pointer<MessageTrace> trace = tracer->sample();
+                        if (trace != NULL) {
+                            trace->mark(MessageTrace::TRANSPORT_RECEIVE);
+                            message->setTrace(trace);
+                        }
+                    }
+                }
+            }
+
             // Notify the listener.
             fire(command);
         }
@@ -316,6 +394,73 @@ void IOTransport::setOutputStream(decaf::io::DataOutputStream* os) {
     this->impl->outputStream = os;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void IOTransport::setReaderThreadPlacement(const activemq::threads::ThreadPlacement& placement) {
+    this->impl->readerPlacement = placement;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long IOTransport::getBusyPollTime() const {
+    return this->impl->busyPollTime;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IOTransport::setBusyPollTime(long long value) {
+    this->impl->busyPollTime = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long IOTransport::getBusyPollSpinCount() const {
+    return this->impl->busyPollSpinCount.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long IOTransport::getBusyPollWaitCount() const {
+    return this->impl->busyPollWaitCount.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IOTransport::setTransportMetrics(const Pointer<TransportMetrics> metrics) {
+    this->impl->metrics = metrics;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<TransportMetrics> IOTransport::getTransportMetrics() const {
+    return this->impl->metrics;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IOTransport::beginBatch() {
+
+    if (impl->outputStream == NULL) {
+        throw IOException(__FILE__, __LINE__, "IOTransport::beginBatch() - invalid output stream");
+    }
+
+    synchronized(impl->outputStream) {
+        impl->batchDepth++;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IOTransport::endBatch() {
+
+    try {
+
+        if (impl->outputStream == NULL) {
+            throw IOException(__FILE__, __LINE__, "IOTransport::endBatch() - invalid output stream");
+        }
+
+        synchronized(impl->outputStream) {
+            if (impl->batchDepth > 0 && --impl->batchDepth == 0 && !impl->closed.get()) {
+                impl->outputStream->flush();
+            }
+        }
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<wireformat::WireFormat> IOTransport::getWireFormat() const {
     return this->impl->wireFormat;
@@ -24,6 +24,8 @@
 #include <activemq/commands/Command.h>
 #include <activemq/commands/Response.h>
 #include <activemq/wireformat/WireFormat.h>
+#include <activemq/threads/ThreadPlacement.h>
+#include <activemq/metrics/TransportMetrics.h>
 
 #include <decaf/lang/Runnable.h>
 #include <decaf/lang/Thread.h>
@@ -121,6 +123,76 @@ namespace transport {
          */
         virtual void setOutputStream(decaf::io::DataOutputStream* os);
 
+        /**
+         * Sets the processors that the reader thread is placed on when this Transport is
+         * started, by default the thread is left to the operating system scheduler.
+         *
+         * @param placement
+         *      The placement to apply to the reader thread.
+         */
+        void setReaderThreadPlacement(const activemq::threads::ThreadPlacement& placement);
+
+        /**
+         * Gets the time in microseconds that the reader thread spins waiting for the next
+         * Command to arrive before it blocks in a read.
+         *
+         * @returns the busy poll time in microseconds, zero if spinning is disabled.
+         */
+        long long getBusyPollTime() const;
+
+        /**
+         * Sets the time in microseconds that the reader thread spins waiting for the next
+         * Command to arrive before it blocks in a read.  Spinning keeps the reader on its
+         * processor so that data arriving within the budget is read without a wake-up.
+         *
+         * @param value
+         *      The busy poll time in microseconds, zero or less disables spinning.
+         */
+        void setBusyPollTime(long long value);
+
+        /**
+         * @returns the number of Commands whose data arrived while the reader was spinning.
+         */
+        long long getBusyPollSpinCount() const;
+
+        /**
+         * @returns the number of Commands for which the reader's spin ran out and it blocked.
+         */
+        long long getBusyPollWaitCount() const;
+
+        /**
+         * Sets the metrics that this Transport records the Commands and bytes it sends
+         * and receives into, by default nothing is recorded.
+         *
+         * @param metrics
+         *      The metrics to record into, or NULL to stop recording.
+         */
+        void setTransportMetrics(const Pointer<activemq::metrics::TransportMetrics> metrics);
+
+        /**
+         * @returns the metrics this Transport records into, NULL if none have been set.
+         */
+        Pointer<activemq::metrics::TransportMetrics> getTransportMetrics() const;
+
+        /**
+         * Starts a batch of writes, until the matching call to endBatch the Commands sent
+         * with oneway are marshaled into the output stream's buffer without flushing it
+         * so that many small Commands go out in a few large writes.  Batches may be nested,
+         * the stream is flushed once the outermost batch ends.
+         *
+         * The caller must not wait on a response to a Command sent inside a batch as it
+         * may still be sitting in the buffer.
+         */
+        void beginBatch();
+
+        /**
+         * Ends a batch of writes started with beginBatch and flushes the output stream if
+         * this ends the outermost batch.
+         *
+         * @throws IOException if an error occurs while flushing the output stream.
+         */
+        void endBatch();
+
     public:  // Transport methods
 
         virtual void oneway(const Pointer<Command> command);
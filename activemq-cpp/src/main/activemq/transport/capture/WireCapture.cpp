@@ -0,0 +1,558 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "WireCapture.h"
+
+#include <activemq/exceptions/ActiveMQException.h>
+
+#include <decaf/internal/io/MemoryMappedFile.h>
+#include <decaf/io/IOException.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/Long.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/atomic/AtomicBoolean.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <string.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::exceptions;
+using namespace activemq::transport;
+using namespace activemq::transport::capture;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::atomic;
+using namespace decaf::internal::io;
+
+////////////////////////////////////////////////////////////////////////////////
+const unsigned char WireCapture::SEND = 0x01;
+const unsigned char WireCapture::RECEIVE = 0x02;
+const unsigned char WireCapture::GAP = 0x80;
+const unsigned char WireCapture::MAGIC[8] = { 'A', 'M', 'Q', 'W', 'C', 'A', 'P', '1' };
+const int WireCapture::FILE_HEADER_SIZE = 16;
+const int WireCapture::RECORD_HEADER_SIZE = 13;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    AtomicInteger instanceCounter;
+
+    void writeLong(unsigned char* buffer, long long value) {
+        for (int i = 7; i >= 0; --i) {
+            buffer[i] = (unsigned char) (value & 0xFF);
+            value >>= 8;
+        }
+    }
+
+    void writeInt(unsigned char* buffer, int value) {
+        for (int i = 3; i >= 0; --i) {
+            buffer[i] = (unsigned char) (value & 0xFF);
+            value >>= 8;
+        }
+    }
+
+    int readInt(const unsigned char* buffer) {
+        return (int) (((unsigned int) buffer[0] << 24) | ((unsigned int) buffer[1] << 16) |
+                      ((unsigned int) buffer[2] << 8) | (unsigned int) buffer[3]);
+    }
+
+    /**
+     * A capture file found on disk, ordered oldest first by its modification time and
+     * then by the instance and sequence numbers in its name.
+     */
+    struct CaptureFile {
+
+        std::string path;
+        long long modified;
+        long long instance;
+        long long sequence;
+
+        CaptureFile(const std::string& path, long long modified, long long instance, long long sequence) :
+            path(path), modified(modified), instance(instance), sequence(sequence) {
+        }
+
+        bool operator<(const CaptureFile& other) const {
+            if (this->modified != other.modified) {
+                return this->modified < other.modified;
+            } else if (this->instance != other.instance) {
+                return this->instance < other.instance;
+            }
+            return this->sequence < other.sequence;
+        }
+    };
+
+    // Parses the leading digits of value starting at position, returns false if there are none.
+    bool parseNumber(const std::string& value, std::size_t& position, long long& result) {
+
+        std::size_t start = position;
+        result = 0;
+        while (position < value.size() && value[position] >= '0' && value[position] <= '9' && position - start < 18) {
+            result = result * 10 + (value[position] - '0');
+            position++;
+        }
+
+        return position != start;
+    }
+
+    // Checks that a file name is <baseName>.<instance>.<sequence>.
+    bool parseCaptureName(const std::string& name, const std::string& baseName, long long& instance, long long& sequence) {
+
+        if (name.size() <= baseName.size() + 1 || name.compare(0, baseName.size(), baseName) != 0 ||
+            name[baseName.size()] != '.') {
+            return false;
+        }
+
+        std::size_t position = baseName.size() + 1;
+        if (!parseNumber(name, position, instance) || position >= name.size() || name[position] != '.') {
+            return false;
+        }
+
+        position++;
+        return parseNumber(name, position, sequence) && position == name.size();
+    }
+
+    /**
+     * Single producer, single consumer ring of capture records.  The producer only
+     * writes the tail and the consumer only writes the head, the positions are free
+     * running counters and are masked to find the index into the buffer.
+     */
+    class CaptureRing {
+    private:
+
+        CaptureRing(const CaptureRing&);
+        CaptureRing& operator=(const CaptureRing&);
+
+    public:
+
+        unsigned char* buffer;
+        unsigned int capacity;
+        AtomicInteger head;
+        AtomicInteger tail;
+        AtomicInteger dropped;
+        bool gap;
+        bool skippedGap;
+
+    public:
+
+        CaptureRing(unsigned int capacity) :
+            buffer(new unsigned char[capacity]), capacity(capacity), head(), tail(), dropped(), gap(false), skippedGap(false) {
+        }
+
+        ~CaptureRing() {
+            delete [] buffer;
+        }
+
+        bool offer(unsigned char direction, const unsigned char* data, int length) {
+
+            unsigned int needed = (unsigned int) (WireCapture::RECORD_HEADER_SIZE + length);
+            unsigned int position = (unsigned int) this->tail.get();
+            unsigned int used = position - (unsigned int) this->head.get();
+
+            if (needed > this->capacity - used) {
+                this->gap = true;
+                this->dropped.incrementAndGet();
+                return false;
+            }
+
+            unsigned char header[13];
+            header[0] = (unsigned char) (this->gap ? direction | WireCapture::GAP : direction);
+            writeLong(header + 1, System::currentTimeMillis());
+            writeInt(header + 9, length);
+
+            put(position, header, WireCapture::RECORD_HEADER_SIZE);
+            put(position + WireCapture::RECORD_HEADER_SIZE, data, length);
+
+            this->gap = false;
+
+            // Publishes the record to the consumer.
+            this->tail.addAndGet((int) needed);
+
+            return true;
+        }
+
+        void put(unsigned int position, const unsigned char* source, unsigned int length) {
+            unsigned int index = position & (this->capacity - 1);
+            unsigned int first = length < this->capacity - index ? length : this->capacity - index;
+            ::memcpy(this->buffer + index, source, first);
+            if (first < length) {
+                ::memcpy(this->buffer, source + first, length - first);
+            }
+        }
+
+        void get(unsigned int position, unsigned char* target, unsigned int length) const {
+            unsigned int index = position & (this->capacity - 1);
+            unsigned int first = length < this->capacity - index ? length : this->capacity - index;
+            ::memcpy(target, this->buffer + index, first);
+            if (first < length) {
+                ::memcpy(target + first, this->buffer, length - first);
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace transport {
+namespace capture {
+
+    class WireCaptureImpl : public Runnable {
+    private:
+
+        WireCaptureImpl(const WireCaptureImpl&);
+        WireCaptureImpl& operator=(const WireCaptureImpl&);
+
+    public:
+
+        std::string prefix;
+        int instance;
+        long long maxFileSize;
+        int maxFiles;
+
+        CaptureRing sendRing;
+        CaptureRing receiveRing;
+
+        Mutex mutex;
+        AtomicBoolean started;
+        AtomicBoolean closed;
+        AtomicBoolean failed;
+        std::auto_ptr<Thread> writer;
+
+        MemoryMappedFile file;
+        std::string currentFile;
+        long long sequence;
+        long long records;
+        long long skipped;
+
+    public:
+
+        WireCaptureImpl(const std::string& prefix, unsigned int ringSize, long long maxFileSize, int maxFiles) :
+            Runnable(), prefix(prefix), instance(instanceCounter.incrementAndGet()),
+            maxFileSize(maxFileSize), maxFiles(maxFiles), sendRing(ringSize), receiveRing(ringSize),
+            mutex(), started(false), closed(false), failed(false), writer(), file(), currentFile(),
+            sequence(0), records(0), skipped(0) {
+        }
+
+        virtual ~WireCaptureImpl() {}
+
+        /**
+         * Closes the current capture file if there is one and creates the next, deleting
+         * the oldest files beyond the configured count, see pruneFiles.
+         */
+        void rotate() {
+
+            file.close();
+
+            std::string name = prefix + "." + Integer::toString(instance) + "." + Long::toString(sequence);
+            file.create(name, maxFileSize);
+
+            unsigned char* buffer = file.getBuffer();
+            ::memcpy(buffer, WireCapture::MAGIC, sizeof(WireCapture::MAGIC));
+            writeLong(buffer + sizeof(WireCapture::MAGIC), sequence);
+            file.setLength(WireCapture::FILE_HEADER_SIZE);
+
+            sequence++;
+
+            synchronized(&mutex) {
+                currentFile = name;
+            }
+
+            pruneFiles(name);
+        }
+
+        /**
+         * Deletes the oldest capture files with this prefix until no more than maxFiles
+         * remain.  The files on disk are scanned rather than those this instance created
+         * so that the limit also covers the files left by earlier connections, failover
+         * reconnects and other captures sharing the prefix.  Rotation is rare enough that
+         * the directory scan doesn't matter.
+         */
+        void pruneFiles(const std::string& current) {
+
+            std::size_t separator = prefix.find_last_of("/\\");
+            std::string directory = separator == std::string::npos ? std::string() : prefix.substr(0, separator + 1);
+            std::string baseName = separator == std::string::npos ? prefix : prefix.substr(separator + 1);
+
+            std::vector<std::string> names = MemoryMappedFile::list(directory.empty() ? std::string(".") : directory);
+
+            std::vector<CaptureFile> found;
+            std::vector<std::string>::const_iterator iter = names.begin();
+            for (; iter != names.end(); ++iter) {
+
+                long long fileInstance = 0;
+                long long fileSequence = 0;
+                if (!parseCaptureName(*iter, baseName, fileInstance, fileSequence)) {
+                    continue;
+                }
+
+                std::string path = directory + *iter;
+                long long modified = MemoryMappedFile::lastModified(path);
+                if (modified >= 0) {
+                    found.push_back(CaptureFile(path, modified, fileInstance, fileSequence));
+                }
+            }
+
+            if ((int) found.size() <= maxFiles) {
+                return;
+            }
+
+            std::sort(found.begin(), found.end());
+
+            int excess = (int) found.size() - maxFiles;
+            for (int i = 0; i < (int) found.size() && excess > 0; ++i) {
+                if (found[i].path != current) {
+                    MemoryMappedFile::remove(found[i].path);
+                    excess--;
+                }
+            }
+        }
+
+        /**
+         * Moves everything currently in the ring into the capture file, returns the number
+         * of records that were moved and adds those that had to be dropped to skipped.
+         */
+        int drain(CaptureRing& ring, long long& skipped) {
+
+            unsigned int position = (unsigned int) ring.head.get();
+            unsigned int limit = (unsigned int) ring.tail.get();
+            int count = 0;
+
+            while (position != limit) {
+
+                unsigned char header[13];
+                ring.get(position, header, WireCapture::RECORD_HEADER_SIZE);
+                int length = readInt(header + 9);
+                long long needed = WireCapture::RECORD_HEADER_SIZE + (long long) length;
+
+                if (needed > maxFileSize - WireCapture::FILE_HEADER_SIZE) {
+                    // Can never fit in a capture file, drop it and mark the gap.
+                    ring.skippedGap = true;
+                    skipped++;
+                } else {
+
+                    if (ring.skippedGap) {
+                        header[0] |= WireCapture::GAP;
+                        ring.skippedGap = false;
+                    }
+
+                    if (file.getLength() + needed > file.getCapacity()) {
+                        rotate();
+                    }
+
+                    unsigned char* target = file.getBuffer() + file.getLength();
+                    ::memcpy(target, header, WireCapture::RECORD_HEADER_SIZE);
+                    ring.get(position + WireCapture::RECORD_HEADER_SIZE,
+                             target + WireCapture::RECORD_HEADER_SIZE, (unsigned int) length);
+                    file.setLength(file.getLength() + needed);
+                    count++;
+                }
+
+                position += (unsigned int) needed;
+                ring.head.addAndGet((int) needed);
+            }
+
+            return count;
+        }
+
+        int drainAll() {
+            long long dropped = 0;
+            int count = drain(sendRing, dropped) + drain(receiveRing, dropped);
+            synchronized(&mutex) {
+                records += count;
+                skipped += dropped;
+            }
+            return count + (int) dropped;
+        }
+
+        virtual void run() {
+
+            try {
+
+                while (!closed.get()) {
+
+                    if (drainAll() == 0) {
+                        synchronized(&mutex) {
+                            if (!closed.get()) {
+                                mutex.wait(10);
+                            }
+                        }
+                    }
+                }
+
+                drainAll();
+                file.close();
+
+            } catch (Exception& ex) {
+                failed.set(true);
+                try {
+                    file.close();
+                } catch (...) {
+                }
+            }
+        }
+    };
+
+}}}
+
+////////////////////////////////////////////////////////////////////////////////
+WireCapture::WireCapture(const std::string& prefix, int ringSize, long long maxFileSize, int maxFiles) : impl(NULL) {
+
+    if (prefix.empty()) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Capture file prefix cannot be empty.");
+    }
+
+    if (ringSize <= 0 || ringSize > (1 << 30)) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Invalid capture ring size: %d", ringSize);
+    }
+
+    if (maxFileSize <= FILE_HEADER_SIZE + RECORD_HEADER_SIZE) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Capture file size too small: %lld", maxFileSize);
+    }
+
+    if (maxFiles <= 0) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Must keep at least one capture file: %d", maxFiles);
+    }
+
+    unsigned int capacity = 1;
+    while (capacity < (unsigned int) ringSize) {
+        capacity <<= 1;
+    }
+
+    this->impl = new WireCaptureImpl(prefix, capacity, maxFileSize, maxFiles);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+WireCapture::~WireCapture() {
+    try {
+        close();
+    }
+    AMQ_CATCHALL_NOTHROW()
+
+    try {
+        delete this->impl;
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WireCapture::start() {
+
+    try {
+
+        if (this->impl->closed.get() || !this->impl->started.compareAndSet(false, true)) {
+            return;
+        }
+
+        this->impl->rotate();
+
+        this->impl->writer.reset(new Thread(this->impl, "ActiveMQ Wire Capture: " + this->impl->prefix));
+        this->impl->writer->start();
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WireCapture::close() {
+
+    try {
+
+        if (!this->impl->closed.compareAndSet(false, true)) {
+            return;
+        }
+
+        synchronized(&this->impl->mutex) {
+            this->impl->mutex.notifyAll();
+        }
+
+        if (this->impl->writer.get() != NULL) {
+            this->impl->writer->join();
+            this->impl->writer.reset(NULL);
+        } else {
+            this->impl->file.close();
+        }
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool WireCapture::record(unsigned char direction, const unsigned char* buffer, int length) {
+
+    if (buffer == NULL || length <= 0 || !this->impl->started.get() ||
+        this->impl->closed.get() || this->impl->failed.get()) {
+
+        return false;
+    }
+
+    if (direction == SEND) {
+        return this->impl->sendRing.offer(SEND, buffer, length);
+    } else {
+        return this->impl->receiveRing.offer(RECEIVE, buffer, length);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string WireCapture::getPrefix() const {
+    return this->impl->prefix;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string WireCapture::getCurrentFileName() const {
+    synchronized(&this->impl->mutex) {
+        return this->impl->currentFile;
+    }
+
+    return "";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long WireCapture::getRecordCount() const {
+    synchronized(&this->impl->mutex) {
+        return this->impl->records;
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long WireCapture::getDroppedCount() const {
+
+    long long skipped = 0;
+    synchronized(&this->impl->mutex) {
+        skipped = this->impl->skipped;
+    }
+
+    return skipped + this->impl->sendRing.dropped.get() + this->impl->receiveRing.dropped.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool WireCapture::isFailed() const {
+    return this->impl->failed.get();
+}
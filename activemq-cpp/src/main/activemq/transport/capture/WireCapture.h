@@ -0,0 +1,174 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_TRANSPORT_CAPTURE_WIRECAPTURE_H_
+#define _ACTIVEMQ_TRANSPORT_CAPTURE_WIRECAPTURE_H_
+
+#include <activemq/util/Config.h>
+
+#include <string>
+
+namespace activemq {
+namespace transport {
+namespace capture {
+
+    class WireCaptureImpl;
+
+    /**
+     * Records the raw bytes a Transport sends and receives to a set of rotating capture
+     * files without slowing down the I/O threads.
+     *
+     * The I/O threads hand their data to record() which copies it into a lock free ring,
+     * one for each direction, and returns.  A background thread drains the rings into a
+     * memory mapped capture file, when the file is full it is closed and the next one is
+     * started, once there are more than maxFiles files with the same prefix the oldest
+     * are deleted, whichever WireCapture wrote them.  If a ring
+     * is full the data is dropped rather than blocking the I/O thread and the next record
+     * that makes it into the ring is flagged so a reader knows the stream has a gap.
+     *
+     * Capture files are named <prefix>.<instance>.<sequence> where instance is unique to
+     * each WireCapture created in the process and sequence counts the rotations.  Each file
+     * starts with an eight byte magic value and its sequence number, followed by records of
+     * the form:
+     *
+     *   flags(1) | timestamp millis(8) | length(4) | data(length)
+     *
+     * with all numbers in big endian byte order.  WireCaptureDecoder turns the files back
+     * into a readable list of commands.
+     *
+     * @since 3.8
+     */
+    class AMQCPP_API WireCapture {
+    public:
+
+        /**
+         * Data written to the peer.
+         */
+        static const unsigned char SEND;
+
+        /**
+         * Data read from the peer.
+         */
+        static const unsigned char RECEIVE;
+
+        /**
+         * Set on a record when data before it in the same direction was dropped.
+         */
+        static const unsigned char GAP;
+
+        /**
+         * The magic value each capture file starts with.
+         */
+        static const unsigned char MAGIC[8];
+
+        /**
+         * Size of the file header, the magic value and the file sequence number.
+         */
+        static const int FILE_HEADER_SIZE;
+
+        /**
+         * Size of the header that precedes the data of each record.
+         */
+        static const int RECORD_HEADER_SIZE;
+
+    private:
+
+        WireCaptureImpl* impl;
+
+    private:
+
+        WireCapture(const WireCapture&);
+        WireCapture& operator=(const WireCapture&);
+
+    public:
+
+        /**
+         * Creates a new WireCapture, no files are created until it is started.
+         *
+         * @param prefix
+         *      The path prefix of the capture files.
+         * @param ringSize
+         *      The size in bytes of the in memory ring for each direction, rounded up to a power of two.
+         * @param maxFileSize
+         *      The size in bytes each capture file may grow to before it is rotated.
+         * @param maxFiles
+         *      The number of capture files with this prefix to keep, older files are deleted.
+         */
+        WireCapture(const std::string& prefix, int ringSize, long long maxFileSize, int maxFiles);
+
+        virtual ~WireCapture();
+
+        /**
+         * Creates the first capture file and starts the background writer, does nothing
+         * if already started.
+         *
+         * @throws IOException if the capture file can't be created.
+         */
+        void start();
+
+        /**
+         * Stops the background writer once it has written everything still in the rings
+         * and closes the current capture file.  Nothing is recorded after this.
+         */
+        void close();
+
+        /**
+         * Copies the given bytes into the ring for their direction, never blocks.  Only one
+         * thread at a time may record in each direction, which is how a Transport's reader
+         * thread and serialized writes already behave.
+         *
+         * @param direction
+         *      Either SEND or RECEIVE.
+         * @param buffer
+         *      The bytes that were sent or received.
+         * @param length
+         *      The number of bytes.
+         *
+         * @return true if the bytes were recorded, false if they were dropped.
+         */
+        bool record(unsigned char direction, const unsigned char* buffer, int length);
+
+        /**
+         * @return the prefix the capture file names start with.
+         */
+        std::string getPrefix() const;
+
+        /**
+         * @return the name of the capture file currently being written, empty if not started.
+         */
+        std::string getCurrentFileName() const;
+
+        /**
+         * @return the number of records written to the capture files so far.
+         */
+        long long getRecordCount() const;
+
+        /**
+         * @return the number of records that were dropped because a ring was full.
+         */
+        long long getDroppedCount() const;
+
+        /**
+         * @return true if writing to the capture files failed, nothing more is recorded.
+         */
+        bool isFailed() const;
+
+    };
+
+}}}
+
+#endif /* _ACTIVEMQ_TRANSPORT_CAPTURE_WIRECAPTURE_H_ */
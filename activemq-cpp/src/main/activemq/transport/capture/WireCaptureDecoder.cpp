@@ -0,0 +1,291 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "WireCaptureDecoder.h"
+
+#include <activemq/transport/capture/WireCapture.h>
+#include <activemq/wireformat/openwire/OpenWireFormat.h>
+#include <activemq/commands/Command.h>
+#include <activemq/commands/WireFormatInfo.h>
+#include <activemq/exceptions/ActiveMQException.h>
+
+#include <decaf/internal/io/MemoryMappedFile.h>
+#include <decaf/io/ByteArrayInputStream.h>
+#include <decaf/io/DataInputStream.h>
+#include <decaf/io/IOException.h>
+#include <decaf/util/Properties.h>
+
+#include <algorithm>
+#include <memory>
+#include <ostream>
+#include <string.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::commands;
+using namespace activemq::exceptions;
+using namespace activemq::transport;
+using namespace activemq::transport::capture;
+using namespace activemq::wireformat::openwire;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::util;
+using namespace decaf::internal::io;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    long long readLong(const unsigned char* buffer) {
+        long long value = 0;
+        for (int i = 0; i < 8; ++i) {
+            value = (value << 8) | buffer[i];
+        }
+        return value;
+    }
+
+    int readInt(const unsigned char* buffer) {
+        return (int) (((unsigned int) buffer[0] << 24) | ((unsigned int) buffer[1] << 16) |
+                      ((unsigned int) buffer[2] << 8) | (unsigned int) buffer[3]);
+    }
+
+    struct CaptureFile {
+        long long sequence;
+        std::string path;
+
+        bool operator<(const CaptureFile& other) const {
+            return this->sequence < other.sequence;
+        }
+    };
+
+    /**
+     * The reassembled bytes of one direction and the offsets at which each record
+     * started, used to find the time at which each command started to arrive.
+     */
+    class DirectionStream {
+    private:
+
+        DirectionStream(const DirectionStream&);
+        DirectionStream& operator=(const DirectionStream&);
+
+    public:
+
+        const char* name;
+        std::vector<unsigned char> bytes;
+        std::vector<int> offsets;
+        std::vector<long long> timestamps;
+        int limit;
+        std::auto_ptr<ByteArrayInputStream> source;
+        std::auto_ptr<DataInputStream> input;
+        std::auto_ptr<OpenWireFormat> format;
+        Pointer<WireFormatInfo> info;
+        bool done;
+
+    public:
+
+        DirectionStream(const char* name) : name(name), bytes(), offsets(), timestamps(), limit(-1),
+                                            source(), input(), format(), info(), done(false) {
+        }
+
+        void append(long long timestamp, bool gap, const unsigned char* data, int length) {
+
+            // Nothing after a gap can be decoded, the bytes before it still can.
+            if (gap && limit < 0) {
+                limit = (int) bytes.size();
+            }
+
+            offsets.push_back((int) bytes.size());
+            timestamps.push_back(timestamp);
+            bytes.insert(bytes.end(), data, data + length);
+        }
+
+        void open() {
+
+            if (limit < 0) {
+                limit = (int) bytes.size();
+            }
+
+            done = limit == 0;
+            if (limit > 0) {
+                source.reset(new ByteArrayInputStream(&bytes[0], limit));
+            } else {
+                source.reset(new ByteArrayInputStream());
+            }
+            input.reset(new DataInputStream(source.get()));
+            format.reset(new OpenWireFormat(Properties()));
+        }
+
+        int position() const {
+            return limit - source->available();
+        }
+
+        long long timestamp() const {
+            std::vector<int>::const_iterator iter = std::upper_bound(offsets.begin(), offsets.end(), position());
+            if (iter == offsets.begin()) {
+                return 0;
+            }
+            return timestamps[(iter - offsets.begin()) - 1];
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+WireCaptureDecoder::WireCaptureDecoder() : files() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+WireCaptureDecoder::~WireCaptureDecoder() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WireCaptureDecoder::addFile(const std::string& path) {
+    this->files.push_back(path);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int WireCaptureDecoder::decode(std::ostream& out) {
+
+    try {
+
+        std::vector<CaptureFile> ordered;
+
+        for (std::size_t i = 0; i < this->files.size(); ++i) {
+
+            MemoryMappedFile file;
+            file.open(this->files[i]);
+
+            const unsigned char* buffer = file.getBuffer();
+            if (file.getLength() < WireCapture::FILE_HEADER_SIZE ||
+                ::memcmp(buffer, WireCapture::MAGIC, sizeof(WireCapture::MAGIC)) != 0) {
+
+                throw IOException(__FILE__, __LINE__, "Not a wire capture file: %s", this->files[i].c_str());
+            }
+
+            CaptureFile entry;
+            entry.sequence = readLong(buffer + sizeof(WireCapture::MAGIC));
+            entry.path = this->files[i];
+            ordered.push_back(entry);
+        }
+
+        std::sort(ordered.begin(), ordered.end());
+
+        DirectionStream send("SEND");
+        DirectionStream receive("RECV");
+
+        for (std::size_t i = 0; i < ordered.size(); ++i) {
+
+            MemoryMappedFile file;
+            file.open(ordered[i].path);
+
+            const unsigned char* buffer = file.getBuffer();
+            long long length = file.getLength();
+            long long position = WireCapture::FILE_HEADER_SIZE;
+
+            while (position + WireCapture::RECORD_HEADER_SIZE <= length) {
+
+                unsigned char flags = buffer[position];
+                long long timestamp = readLong(buffer + position + 1);
+                int size = readInt(buffer + position + 9);
+                position += WireCapture::RECORD_HEADER_SIZE;
+
+                if (size < 0 || position + size > length) {
+                    break;
+                }
+
+                DirectionStream& stream = (flags & WireCapture::SEND) != 0 ? send : receive;
+                stream.append(timestamp, (flags & WireCapture::GAP) != 0, buffer + position, size);
+                position += size;
+            }
+        }
+
+        if (!ordered.empty() && ordered[0].sequence != 0) {
+            out << "Capture files before sequence " << ordered[0].sequence
+                << " are missing, decoding may fail." << std::endl;
+        }
+
+        send.open();
+        receive.open();
+
+        int count = 0;
+
+        while (!send.done || !receive.done) {
+
+            DirectionStream* stream = &send;
+            if (send.done || (!receive.done && receive.timestamp() < send.timestamp())) {
+                stream = &receive;
+            }
+
+            // Nothing but the WireFormatInfo crosses the wire in either direction until
+            // both sides have sent theirs, so don't let timestamp ties run ahead of it.
+            if (send.info != NULL && receive.info == NULL && !receive.done) {
+                stream = &receive;
+            } else if (receive.info != NULL && send.info == NULL && !send.done) {
+                stream = &send;
+            }
+
+            if (stream->source->available() == 0) {
+                stream->done = true;
+                continue;
+            }
+
+            long long timestamp = stream->timestamp();
+            Pointer<Command> command;
+
+            try {
+                command = stream->format->unmarshal(NULL, stream->input.get());
+            } catch (Exception& ex) {
+                out << timestamp << " " << stream->name << ": could not decode the command at offset "
+                    << stream->position() << ", " << ex.getMessage() << std::endl;
+                stream->done = true;
+                continue;
+            }
+
+            if (command == NULL) {
+                continue;
+            }
+
+            out << timestamp << " " << stream->name << ": " << command->toString() << std::endl;
+            count++;
+
+            // Mirror the negotiation the connection went through so the rest of each
+            // stream is decoded with the settings it was written with.
+            if (command->isWireFormatInfo()) {
+                stream->info = command.dynamicCast<WireFormatInfo>();
+
+                if (send.info != NULL && receive.info != NULL) {
+                    send.format->setPreferedWireFormatInfo(send.info);
+                    send.format->renegotiateWireFormat(*receive.info);
+                    receive.format->setPreferedWireFormatInfo(send.info);
+                    receive.format->renegotiateWireFormat(*receive.info);
+                }
+            }
+        }
+
+        if (send.limit < (int) send.bytes.size()) {
+            out << "SEND: capture has a gap, " << send.bytes.size() - send.limit << " bytes not decoded." << std::endl;
+        }
+
+        if (receive.limit < (int) receive.bytes.size()) {
+            out << "RECV: capture has a gap, " << receive.bytes.size() - receive.limit << " bytes not decoded." << std::endl;
+        }
+
+        return count;
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
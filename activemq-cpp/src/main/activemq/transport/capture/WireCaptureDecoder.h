@@ -0,0 +1,83 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_TRANSPORT_CAPTURE_WIRECAPTUREDECODER_H_
+#define _ACTIVEMQ_TRANSPORT_CAPTURE_WIRECAPTUREDECODER_H_
+
+#include <activemq/util/Config.h>
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace activemq {
+namespace transport {
+namespace capture {
+
+    /**
+     * Reads the files written by a WireCapture and decodes the captured OpenWire byte
+     * streams back into commands, printing them in the order they crossed the wire along
+     * with their timestamp and direction.
+     *
+     * Each direction is reassembled from its records and unmarshalled with its own
+     * OpenWireFormat instance, once the WireFormatInfo of both sides has been seen the
+     * two are renegotiated just as the live connection was.  Decoding of a direction
+     * stops at the first gap in the capture since the stream can't be resynchronized.
+     *
+     * @since 3.8
+     */
+    class AMQCPP_API WireCaptureDecoder {
+    private:
+
+        std::vector<std::string> files;
+
+    private:
+
+        WireCaptureDecoder(const WireCaptureDecoder&);
+        WireCaptureDecoder& operator=(const WireCaptureDecoder&);
+
+    public:
+
+        WireCaptureDecoder();
+
+        virtual ~WireCaptureDecoder();
+
+        /**
+         * Adds a capture file to decode, the files of one capture can be added in any order.
+         *
+         * @param path
+         *      The path of the capture file.
+         */
+        void addFile(const std::string& path);
+
+        /**
+         * Decodes all the added files and writes one line of text per command.
+         *
+         * @param out
+         *      The stream that the decoded commands are written to.
+         *
+         * @return the number of commands that were decoded.
+         *
+         * @throws IOException if a file can't be read or isn't a capture file.
+         */
+        int decode(std::ostream& out);
+
+    };
+
+}}}
+
+#endif /* _ACTIVEMQ_TRANSPORT_CAPTURE_WIRECAPTUREDECODER_H_ */
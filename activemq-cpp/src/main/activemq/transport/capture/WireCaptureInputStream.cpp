@@ -0,0 +1,73 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "WireCaptureInputStream.h"
+
+#include <activemq/exceptions/ExceptionDefines.h>
+
+using namespace activemq;
+using namespace activemq::transport;
+using namespace activemq::transport::capture;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+WireCaptureInputStream::WireCaptureInputStream(decaf::io::InputStream* next, Pointer<WireCapture> capture, bool own) :
+    FilterInputStream(next, own), capture(capture) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+WireCaptureInputStream::~WireCaptureInputStream() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int WireCaptureInputStream::doReadByte() {
+
+    try {
+
+        int value = FilterInputStream::doReadByte();
+
+        if (value != -1) {
+            unsigned char c = (unsigned char) value;
+            this->capture->record(WireCapture::RECEIVE, &c, 1);
+        }
+
+        return value;
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int WireCaptureInputStream::doReadArrayBounded(unsigned char* buffer, int size, int offset, int length) {
+
+    try {
+
+        int numRead = FilterInputStream::doReadArrayBounded(buffer, size, offset, length);
+
+        if (numRead > 0) {
+            this->capture->record(WireCapture::RECEIVE, buffer + offset, numRead);
+        }
+
+        return numRead;
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_RETHROW(IndexOutOfBoundsException)
+    AMQ_CATCH_RETHROW(NullPointerException)
+    AMQ_CATCHALL_THROW(IOException)
+}
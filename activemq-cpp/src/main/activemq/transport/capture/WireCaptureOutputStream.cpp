@@ -0,0 +1,70 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "WireCaptureOutputStream.h"
+
+#include <activemq/exceptions/ExceptionDefines.h>
+
+using namespace activemq;
+using namespace activemq::transport;
+using namespace activemq::transport::capture;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+WireCaptureOutputStream::WireCaptureOutputStream(decaf::io::OutputStream* next, Pointer<WireCapture> capture, bool own) :
+    FilterOutputStream(next, own), capture(capture) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+WireCaptureOutputStream::~WireCaptureOutputStream() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WireCaptureOutputStream::doWriteByte(unsigned char value) {
+
+    try {
+        FilterOutputStream::doWriteByte(value);
+        this->capture->record(WireCapture::SEND, &value, 1);
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WireCaptureOutputStream::doWriteArrayBounded(const unsigned char* buffer, int size, int offset, int length) {
+
+    try {
+
+        if (isClosed()) {
+            throw IOException(__FILE__, __LINE__, "WireCaptureOutputStream::write - Stream is closed");
+        }
+
+        // Pass the whole block on at once rather than a byte at a time as the base
+        // class does, the capture then gets a single copy of it.
+        this->outputStream->write(buffer, size, offset, length);
+
+        if (length > 0) {
+            this->capture->record(WireCapture::SEND, buffer + offset, length);
+        }
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_RETHROW(IndexOutOfBoundsException)
+    AMQ_CATCH_RETHROW(NullPointerException)
+    AMQ_CATCHALL_THROW(IOException)
+}
@@ -0,0 +1,73 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_TRANSPORT_CAPTURE_WIRECAPTUREOUTPUTSTREAM_H_
+#define _ACTIVEMQ_TRANSPORT_CAPTURE_WIRECAPTUREOUTPUTSTREAM_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/transport/capture/WireCapture.h>
+#include <decaf/io/FilterOutputStream.h>
+#include <decaf/lang/Pointer.h>
+
+namespace activemq {
+namespace transport {
+namespace capture {
+
+    using decaf::lang::Pointer;
+
+    /**
+     * OutputStream filter that copies everything passing through it into a WireCapture.
+     *
+     * @since 3.8
+     */
+    class AMQCPP_API WireCaptureOutputStream : public decaf::io::FilterOutputStream {
+    private:
+
+        Pointer<WireCapture> capture;
+
+    private:
+
+        WireCaptureOutputStream(const WireCaptureOutputStream&);
+        WireCaptureOutputStream& operator=(const WireCaptureOutputStream&);
+
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param next
+         *      The stream to wrap.
+         * @param capture
+         *      The WireCapture that receives a copy of the data.
+         * @param own
+         *      If true, this object will control the lifetime of the stream that it encapsulates.
+         */
+        WireCaptureOutputStream(decaf::io::OutputStream* next, Pointer<WireCapture> capture, bool own = false);
+
+        virtual ~WireCaptureOutputStream();
+
+    protected:
+
+        virtual void doWriteByte(unsigned char value);
+
+        virtual void doWriteArrayBounded(const unsigned char* buffer, int size, int offset, int length);
+
+    };
+
+}}}
+
+#endif /* _ACTIVEMQ_TRANSPORT_CAPTURE_WIRECAPTUREOUTPUTSTREAM_H_ */
@@ -21,13 +21,14 @@
 #include <activemq/commands/ShutdownInfo.h>
 #include <activemq/commands/RemoveInfo.h>
 #include <activemq/transport/TransportRegistry.h>
+#include <activemq/transport/IOTransport.h>
 #include <activemq/threads/DedicatedTaskRunner.h>
 #include <activemq/threads/CompositeTaskRunner.h>
 #include <activemq/transport/failover/BackupTransportPool.h>
 #include <activemq/transport/failover/URIPool.h>
 #include <activemq/transport/failover/FailoverTransportListener.h>
 #include <activemq/transport/failover/CloseTransportsTask.h>
-#include <activemq/transport/failover/URIPool.h>
+#include <activemq/transport/failover/ParallelConnector.h>
 #include <decaf/util/Random.h>
 #include <decaf/util/StringTokenizer.h>
 #include <decaf/util/LinkedList.h>
@@ -37,12 +38,15 @@
 #include <decaf/lang/System.h>
 #include <decaf/lang/Integer.h>
 
+#include <typeinfo>
+
 using namespace std;
 using namespace activemq;
 using namespace activemq::state;
 using namespace activemq::commands;
 using namespace activemq::exceptions;
 using namespace activemq::threads;
+using namespace activemq::metrics;
 using namespace activemq::transport;
 using namespace activemq::transport::failover;
 using namespace decaf;
@@ -53,6 +57,9 @@ using namespace decaf::util::concurrent;
 using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
 
+////////////////////////////////////////////////////////////////////////////////
+LOGDECAF_INITIALIZE(logger, FailoverTransport, "activemq.transport.failover.FailoverTransport")
+
 ////////////////////////////////////////////////////////////////////////////////
 namespace activemq {
 namespace transport {
@@ -94,6 +101,13 @@ namespace failover {
         bool rebalanceUpdateURIs;
         bool priorityBackup;
         bool backupsEnabled;
+        bool parallelConnect;
+        int maxParallelConnects;
+
+        long long reconnectStartTime;
+        int reconnectCount;
+        long long lastReconnectDuration;
+        long long maxReconnectDuration;
 
         bool doRebalance;
         bool connectedToPrioirty;
@@ -113,8 +127,10 @@ namespace failover {
         Pointer<BackupTransportPool> backups;
         Pointer<CloseTransportsTask> closeTask;
         Pointer<CompositeTaskRunner> taskRunner;
+        Pointer<ParallelConnector> parallelConnector;
         Pointer<TransportListener> disposedListener;
         Pointer<TransportListener> myTransportListener;
+        Pointer<TransportMetrics> metrics;
 
         TransportListener* transportListener;
 
@@ -143,6 +159,12 @@ namespace failover {
             rebalanceUpdateURIs(true),
             priorityBackup(false),
             backupsEnabled(false),
+            parallelConnect(false),
+            maxParallelConnects(3),
+            reconnectStartTime(-1),
+            reconnectCount(0),
+            lastReconnectDuration(0),
+            maxReconnectDuration(0),
             doRebalance(false),
             connectedToPrioirty(false),
             reconnectMutex(),
@@ -158,12 +180,15 @@ namespace failover {
             backups(),
             closeTask(new CloseTransportsTask()),
             taskRunner(new CompositeTaskRunner()),
+            parallelConnector(),
             disposedListener(),
             myTransportListener(new FailoverTransportListener(parent)),
+            metrics(),
             transportListener(NULL) {
 
             this->backups.reset(
                 new BackupTransportPool(parent, taskRunner, closeTask, uris, updated, priorityUris));
+            this->parallelConnector.reset(new ParallelConnector(taskRunner, closeTask));
 
             this->taskRunner->addTask(parent);
             this->taskRunner->addTask(this->closeTask.get());
@@ -238,6 +263,36 @@ namespace failover {
             reconnectMutex.notifyAll();
         }
 
+        void recordReconnect() {
+            reconnectCount++;
+            if (metrics != NULL) {
+                metrics->getFailoverReconnects().increment();
+            }
+            if (reconnectStartTime >= 0) {
+                lastReconnectDuration = System::currentTimeMillis() - reconnectStartTime;
+                if (lastReconnectDuration > maxReconnectDuration) {
+                    maxReconnectDuration = lastReconnectDuration;
+                }
+                if (metrics != NULL) {
+                    metrics->getReconnectTime().record(lastReconnectDuration * 1000);
+                }
+                reconnectStartTime = -1;
+            }
+        }
+
+        /**
+         * Hands the metrics to the IOTransport at the bottom of the given transport's
+         * chain so that the Commands it carries are counted.
+         */
+        void attachMetrics(const Pointer<Transport>& transport) {
+            if (metrics != NULL) {
+                IOTransport* ioTransport = dynamic_cast<IOTransport*>(transport->narrow(typeid(IOTransport)));
+                if (ioTransport != NULL) {
+                    ioTransport->setTransportMetrics(metrics);
+                }
+            }
+        }
+
         void resetReconnectDelay() {
             if (!useExponentialBackOff || reconnectDelay == DEFAULT_INITIAL_RECONNECT_DELAY) {
                 reconnectDelay = initialReconnectDelay;
@@ -570,6 +625,7 @@ void FailoverTransport::start() {
             if (this->impl->connectedTransport != NULL) {
                 stateTracker.restore(this->impl->connectedTransport);
             } else {
+                this->impl->reconnectStartTime = System::currentTimeMillis();
                 reconnect(false);
             }
         }
@@ -627,6 +683,7 @@ void FailoverTransport::close() {
         }
 
         this->impl->taskRunner->shutdown(TimeUnit::MINUTES.toMillis(5));
+        this->impl->parallelConnector->close();
 
         if (transportToStop != NULL) {
             transportToStop->close();
@@ -711,6 +768,12 @@ void FailoverTransport::handleTransportFailure(const decaf::lang::Exception& err
             reconnectOk = this->impl->canReconnect();
             URI failedUri = *this->impl->connectedTransportURI;
 
+            LOGDECAF_WARN_1(logger, "Transport failed: " << failedUri.toString() << " - ", error.getMessage());
+
+            if (this->impl->metrics != NULL) {
+                this->impl->metrics->getFailoverInterruptions().increment();
+            }
+
             this->impl->initialized = false;
             this->impl->uris->addURI(failedUri);
             this->impl->connectedTransportURI.reset(NULL);
@@ -727,6 +790,7 @@ void FailoverTransport::handleTransportFailure(const decaf::lang::Exception& err
             }
 
             if (reconnectOk) {
+                this->impl->reconnectStartTime = System::currentTimeMillis();
                 this->impl->updated->removeURI(failedUri);
                 this->impl->taskRunner->wakeup();
             } else if (!this->impl->closed) {
@@ -918,7 +982,28 @@ bool FailoverTransport::iterate() {
                 while (transport == NULL && this->impl->connectedTransport == NULL && !this->impl->closed) {
                     try {
                         // We could be starting the loop with a backup already.
-                        if (transport == NULL) {
+                        if (transport == NULL && this->impl->parallelConnect) {
+
+                            std::vector<URI> candidates;
+                            try {
+                                while ((int) candidates.size() < this->impl->maxParallelConnects) {
+                                    candidates.push_back(connectList->getURI());
+                                }
+                            } catch (NoSuchElementException& ex) {
+                            }
+
+                            if (candidates.empty()) {
+                                break;
+                            }
+
+                            transport = this->impl->parallelConnector->connect(
+                                candidates, this->impl->myTransportListener.get(), uri, failures, failure);
+
+                            if (transport == NULL) {
+                                continue;
+                            }
+
+                        } else if (transport == NULL) {
                             try {
                                 uri = connectList->getURI();
                             } catch (NoSuchElementException& ex) {
@@ -929,6 +1014,7 @@ bool FailoverTransport::iterate() {
                         }
 
                         transport->setTransportListener(this->impl->myTransportListener.get());
+                        this->impl->attachMetrics(transport);
                         transport->start();
 
                         if (this->impl->started && !this->impl->firstConnection) {
@@ -940,6 +1026,9 @@ bool FailoverTransport::iterate() {
                         this->impl->connectedTransport = transport;
                         this->impl->reconnectMutex.notifyAll();
                         this->impl->connectFailures = 0;
+                        this->impl->recordReconnect();
+
+                        LOGDECAF_INFO_1(logger, "Successfully connected to: ", uri.toString());
 
                         if (isPriorityBackup()) {
                             this->impl->connectedToPrioirty = connectList->getPriorityURI().equals(uri) ||
@@ -993,6 +1082,12 @@ bool FailoverTransport::iterate() {
                             transport.reset(NULL);
                         }
 
+                        LOGDECAF_DEBUG_1(logger, "Connect attempt failed: " << uri.toString() << " - ", e.getMessage());
+
+                        if (this->impl->metrics != NULL) {
+                            this->impl->metrics->getFailoverConnectFailures().increment();
+                        }
+
                         failures.add(uri);
                         failure.reset(e.clone());
                     }
@@ -1008,6 +1103,8 @@ bool FailoverTransport::iterate() {
         if (reconnectAttempts >= 0 && ++this->impl->connectFailures >= reconnectAttempts) {
             this->impl->connectionFailure = failure;
 
+            LOGDECAF_ERROR(logger, "Failed to connect after " + Integer::toString(this->impl->connectFailures) + " attempts, giving up");
+
             // Make sure on initial startup, that the transportListener has been initialized
             // for this instance.
             synchronized(&this->impl->listenerMutex) {
@@ -1336,3 +1433,94 @@ void FailoverTransport::setPriorityURIs(const std::string& priorityURIs AMQCPP_U
 const List<URI>& FailoverTransport::getPriorityURIs() const {
     return this->impl->priorityUris->getURIList();
 }
+
+////////////////////////////////////////////////////////////////////////////////
+bool FailoverTransport::isParallelConnect() const {
+    return this->impl->parallelConnect;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransport::setParallelConnect(bool value) {
+    this->impl->parallelConnect = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int FailoverTransport::getMaxParallelConnects() const {
+    return this->impl->maxParallelConnects;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransport::setMaxParallelConnects(int value) {
+    this->impl->maxParallelConnects = value > 0 ? value : 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long FailoverTransport::getParallelConnectDelay() const {
+    return this->impl->parallelConnector->getStaggerDelay();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransport::setParallelConnectDelay(long long value) {
+    this->impl->parallelConnector->setStaggerDelay(value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long FailoverTransport::getParallelConnectTimeout() const {
+    return this->impl->parallelConnector->getAttemptTimeout();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransport::setParallelConnectTimeout(long long value) {
+    this->impl->parallelConnector->setAttemptTimeout(value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int FailoverTransport::getReconnectCount() const {
+    return this->impl->reconnectCount;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long FailoverTransport::getLastReconnectDuration() const {
+    return this->impl->lastReconnectDuration;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long FailoverTransport::getMaxReconnectDuration() const {
+    return this->impl->maxReconnectDuration;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransport::setTransportMetrics(const Pointer<TransportMetrics> metrics) {
+
+    synchronized(&this->impl->reconnectMutex) {
+        this->impl->metrics = metrics;
+        if (this->impl->connectedTransport != NULL) {
+            this->impl->attachMetrics(this->impl->connectedTransport);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<TransportMetrics> FailoverTransport::getTransportMetrics() const {
+    return this->impl->metrics;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int FailoverTransport::getRestoreSyncInterval() const {
+    return this->stateTracker.getRestoreSyncInterval();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransport::setRestoreSyncInterval(int value) {
+    this->stateTracker.setRestoreSyncInterval(value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long FailoverTransport::getLastRestoreDuration() const {
+    return this->stateTracker.getLastRestoreDuration();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int FailoverTransport::getLastRestoreCommandCount() const {
+    return this->stateTracker.getLastRestoreCommandCount();
+}
@@ -27,11 +27,13 @@
 #include <activemq/state/ConnectionStateTracker.h>
 #include <activemq/transport/CompositeTransport.h>
 #include <activemq/wireformat/WireFormat.h>
+#include <activemq/metrics/TransportMetrics.h>
 
 #include <decaf/util/List.h>
 #include <decaf/util/Properties.h>
 #include <decaf/net/URI.h>
 #include <decaf/io/IOException.h>
+#include <decaf/util/logging/LoggerDefines.h>
 
 namespace activemq {
 namespace transport {
@@ -56,6 +58,8 @@ namespace failover {
 
         FailoverTransportImpl* impl;
 
+        LOGDECAF_DECLARE(logger)
+
     private:
 
         FailoverTransport(const FailoverTransport&);
@@ -236,6 +240,87 @@ namespace failover {
 
         const decaf::util::List<decaf::net::URI>& getPriorityURIs() const;
 
+        /**
+         * When enabled the transport races connection attempts to several of its URIs at
+         * once instead of trying them one at a time, keeping the first one to complete.
+         */
+        bool isParallelConnect() const;
+
+        void setParallelConnect(bool value);
+
+        /**
+         * @returns the maximum number of URIs that are raced in one parallel connect.
+         */
+        int getMaxParallelConnects() const;
+
+        void setMaxParallelConnects(int value);
+
+        /**
+         * @returns the delay in milliseconds between starting successive parallel attempts.
+         */
+        long long getParallelConnectDelay() const;
+
+        void setParallelConnectDelay(long long value);
+
+        /**
+         * @returns the time in milliseconds a parallel attempt has to connect and to negotiate.
+         */
+        long long getParallelConnectTimeout() const;
+
+        void setParallelConnectTimeout(long long value);
+
+        /**
+         * @returns the number of times a connection to a Broker has been established,
+         *          including the initial connection.
+         */
+        int getReconnectCount() const;
+
+        /**
+         * @returns the time in milliseconds between the transport starting or losing its
+         *          connection and the last connection being established.
+         */
+        long long getLastReconnectDuration() const;
+
+        /**
+         * @returns the longest time in milliseconds it has taken to establish a connection.
+         */
+        long long getMaxReconnectDuration() const;
+
+        /**
+         * Sets the metrics that this transport records its interruptions, reconnects and
+         * failed connection attempts into.  The metrics are also handed to each transport
+         * that is connected through so that the Commands and bytes they carry are counted.
+         *
+         * @param metrics
+         *      The metrics to record into, or NULL to stop recording.
+         */
+        void setTransportMetrics(const Pointer<activemq::metrics::TransportMetrics> metrics);
+
+        /**
+         * @returns the metrics this transport records into, NULL if none have been set.
+         */
+        Pointer<activemq::metrics::TransportMetrics> getTransportMetrics() const;
+
+        /**
+         * @returns the number of Commands replayed between sync barriers when the connection
+         *          state is restored after a reconnect, zero disables the barriers.
+         */
+        int getRestoreSyncInterval() const;
+
+        void setRestoreSyncInterval(int value);
+
+        /**
+         * @returns the time in milliseconds it took to replay the connection state on the
+         *          last reconnect.
+         */
+        long long getLastRestoreDuration() const;
+
+        /**
+         * @returns the number of Commands replayed to restore the connection state on the
+         *          last reconnect.
+         */
+        int getLastRestoreCommandCount() const;
+
         void setConnectionInterruptProcessingComplete(const Pointer<commands::ConnectionId> connectionId);
 
         bool isConnectedToPriority() const;
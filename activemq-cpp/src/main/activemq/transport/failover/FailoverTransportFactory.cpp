@@ -109,6 +109,16 @@ Pointer<Transport> FailoverTransportFactory::doCreateComposite(const decaf::net:
         transport->setPriorityBackup(
             Boolean::parseBoolean(topLvlProperties.getProperty("priorityBackup", "false")));
         transport->setPriorityURIs(topLvlProperties.getProperty("priorityURIs", ""));
+        transport->setParallelConnect(
+            Boolean::parseBoolean(topLvlProperties.getProperty("parallelConnect", "false")));
+        transport->setMaxParallelConnects(
+            Integer::parseInt(topLvlProperties.getProperty("maxParallelConnects", "3")));
+        transport->setParallelConnectDelay(
+            Long::parseLong(topLvlProperties.getProperty("parallelConnectDelay", "250")));
+        transport->setParallelConnectTimeout(
+            Long::parseLong(topLvlProperties.getProperty("parallelConnectTimeout", "15000")));
+        transport->setRestoreSyncInterval(
+            Integer::parseInt(topLvlProperties.getProperty("restoreSyncInterval", "0")));
 
         transport->addURI(false, data.getComponents());
 
@@ -0,0 +1,552 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ParallelConnector.h"
+
+#include <activemq/exceptions/ActiveMQException.h>
+#include <activemq/transport/DefaultTransportListener.h>
+#include <activemq/transport/TransportFactory.h>
+#include <activemq/transport/TransportRegistry.h>
+#include <activemq/transport/tcp/SslTransport.h>
+#include <activemq/transport/tcp/TcpTransport.h>
+#include <activemq/wireformat/WireFormat.h>
+
+#include <decaf/io/IOException.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/util/concurrent/Concurrent.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
+#include <decaf/util/concurrent/Mutex.h>
+
+using namespace activemq;
+using namespace activemq::commands;
+using namespace activemq::exceptions;
+using namespace activemq::threads;
+using namespace activemq::transport;
+using namespace activemq::transport::tcp;
+using namespace activemq::transport::failover;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::net;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class ConnectAttempt;
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace transport {
+namespace failover {
+
+    class ParallelConnectorImpl {
+    private:
+
+        ParallelConnectorImpl(const ParallelConnectorImpl&);
+        ParallelConnectorImpl& operator= (const ParallelConnectorImpl&);
+
+    public:
+
+        ParallelConnector* parent;
+        Pointer<CompositeTaskRunner> taskRunner;
+        Pointer<CloseTransportsTask> closeTask;
+
+        // Guards the attempt states and is signaled whenever an attempt completes.
+        Mutex mutex;
+
+        std::vector<ConnectAttempt*> attempts;
+        DefaultTransportListener disposedListener;
+
+        bool closed;
+        long long staggerDelay;
+        long long attemptTimeout;
+        long long attemptCount;
+        long long cancelledCount;
+
+        ParallelConnectorImpl(ParallelConnector* parent,
+                              const Pointer<CompositeTaskRunner> taskRunner,
+                              const Pointer<CloseTransportsTask> closeTask) :
+            parent(parent), taskRunner(taskRunner), closeTask(closeTask), mutex(), attempts(),
+            disposedListener(), closed(false), staggerDelay(250), attemptTimeout(15000),
+            attemptCount(0), cancelledCount(0) {
+        }
+
+        Pointer<Transport> createTransport(const URI& location) const {
+            return parent->createTransport(location);
+        }
+
+        void dispose(Pointer<Transport> transport);
+
+        void reap(bool all);
+    };
+
+}}}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    enum AttemptState {
+        ATTEMPT_CONNECTING,
+        ATTEMPT_CONNECTED,
+        ATTEMPT_FAILED
+    };
+
+    /**
+     * A single connection attempt, runs the connect on its own thread and acts as the
+     * TransportListener of its Transport until it is handed off to the winner's listener.
+     */
+    class ConnectAttempt : public DefaultTransportListener, public Runnable {
+    private:
+
+        ConnectAttempt(const ConnectAttempt&);
+        ConnectAttempt& operator= (const ConnectAttempt&);
+
+    private:
+
+        ParallelConnectorImpl* connector;
+
+        // Serializes delivery of events from the Transport with the hand off.
+        Mutex listenerMutex;
+        TransportListener* delegate;
+        std::vector< Pointer<Command> > received;
+        CountDownLatch negotiated;
+        Pointer<Exception> transportError;
+
+    public:
+
+        URI uri;
+        Thread thread;
+
+        // The following are guarded by the connector's mutex.
+        Pointer<Transport> transport;
+        AttemptState state;
+        Pointer<Exception> error;
+        bool cancelled;
+        bool disposed;
+
+    public:
+
+        ConnectAttempt(ParallelConnectorImpl* connector, const URI& uri) :
+            DefaultTransportListener(), Runnable(), connector(connector), listenerMutex(), delegate(NULL),
+            received(), negotiated(1), transportError(), uri(uri),
+            thread(this, std::string("ActiveMQ Failover Connect: ") + uri.toString()),
+            transport(), state(ATTEMPT_CONNECTING), error(), cancelled(false), disposed(false) {
+        }
+
+        virtual ~ConnectAttempt() {}
+
+        virtual void run() {
+
+            Pointer<Transport> transport;
+
+            try {
+
+                transport = connector->createTransport(uri);
+                applyConnectTimeout(transport);
+
+                synchronized(&connector->mutex) {
+                    if (cancelled) {
+                        return;
+                    }
+                    this->transport = transport;
+                }
+
+                transport->setTransportListener(this);
+                transport->start();
+
+                Pointer<wireformat::WireFormat> wireFormat = transport->getWireFormat();
+                if (wireFormat != NULL && wireFormat->hasNegotiator()) {
+                    if (!negotiated.await(connector->attemptTimeout)) {
+                        throw IOException(__FILE__, __LINE__,
+                            "Wire format negotiation with %s timed out", uri.toString().c_str());
+                    }
+                }
+
+                synchronized(&listenerMutex) {
+                    if (transportError != NULL) {
+                        throw IOException(*transportError);
+                    }
+                }
+
+                synchronized(&connector->mutex) {
+                    state = ATTEMPT_CONNECTED;
+                    if (cancelled) {
+                        disposeLocked();
+                    }
+                    connector->mutex.notifyAll();
+                }
+
+            } catch (Exception& ex) {
+                synchronized(&connector->mutex) {
+                    state = ATTEMPT_FAILED;
+                    error.reset(ex.clone());
+                    disposeLocked();
+                    connector->mutex.notifyAll();
+                }
+            } catch (...) {
+                synchronized(&connector->mutex) {
+                    state = ATTEMPT_FAILED;
+                    error.reset(new IOException(__FILE__, __LINE__,
+                        "Caught unknown exception while connecting to %s", uri.toString().c_str()));
+                    disposeLocked();
+                    connector->mutex.notifyAll();
+                }
+            }
+        }
+
+        /**
+         * Disposes of the Transport once the attempt has lost or failed, must be called
+         * with the connector's mutex held.
+         */
+        void disposeLocked() {
+            if (!disposed && transport != NULL) {
+                disposed = true;
+                transport->setTransportListener(&connector->disposedListener);
+                connector->dispose(transport);
+            }
+        }
+
+        /**
+         * Passes the Transport on to the given listener, replaying any commands that
+         * arrived while the attempt was still in the race.
+         */
+        void handOff(TransportListener* listener) {
+            synchronized(&listenerMutex) {
+                transport->setTransportListener(listener);
+                delegate = listener;
+
+                std::vector< Pointer<Command> >::const_iterator iter = received.begin();
+                for (; iter != received.end(); ++iter) {
+                    listener->onCommand(*iter);
+                }
+                received.clear();
+            }
+        }
+
+        virtual void onCommand(const Pointer<Command> command) {
+            synchronized(&listenerMutex) {
+                if (delegate != NULL) {
+                    delegate->onCommand(command);
+                    return;
+                }
+
+                received.push_back(command);
+                if (command->isWireFormatInfo()) {
+                    negotiated.countDown();
+                }
+            }
+        }
+
+        virtual void onException(const decaf::lang::Exception& ex) {
+            synchronized(&listenerMutex) {
+                if (delegate != NULL) {
+                    delegate->onException(ex);
+                    return;
+                }
+
+                if (transportError == NULL) {
+                    transportError.reset(ex.clone());
+                }
+                negotiated.countDown();
+            }
+        }
+
+        virtual void transportInterrupted() {
+            synchronized(&listenerMutex) {
+                if (delegate != NULL) {
+                    delegate->transportInterrupted();
+                }
+            }
+        }
+
+        virtual void transportResumed() {
+            synchronized(&listenerMutex) {
+                if (delegate != NULL) {
+                    delegate->transportResumed();
+                }
+            }
+        }
+
+    private:
+
+        void applyConnectTimeout(Pointer<Transport> transport) {
+
+            TcpTransport* tcp = dynamic_cast<TcpTransport*>(transport->narrow(typeid(TcpTransport)));
+            if (tcp == NULL) {
+                tcp = dynamic_cast<TcpTransport*>(transport->narrow(typeid(SslTransport)));
+            }
+
+            // Bound the connect so an abandoned attempt can't hold up closing the connector.
+            if (tcp != NULL && tcp->getConnectTimeout() <= 0) {
+                tcp->setConnectTimeout((int) connector->attemptTimeout);
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ParallelConnectorImpl::dispose(Pointer<Transport> transport) {
+
+    try {
+        transport->stop();
+    } catch (...) {
+    }
+
+    if (this->closed) {
+        try {
+            transport->close();
+        } catch (...) {
+        }
+    } else {
+        // Hand off to the close task so it gets done in a different thread.
+        this->closeTask->add(transport);
+        this->taskRunner->wakeup();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ParallelConnectorImpl::reap(bool all) {
+
+    std::vector<ConnectAttempt*> remaining;
+
+    std::vector<ConnectAttempt*>::iterator iter = this->attempts.begin();
+    for (; iter != this->attempts.end(); ++iter) {
+        ConnectAttempt* attempt = *iter;
+        if (all || !attempt->thread.isAlive()) {
+            attempt->thread.join();
+            delete attempt;
+        } else {
+            remaining.push_back(attempt);
+        }
+    }
+
+    this->attempts.swap(remaining);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ParallelConnector::ParallelConnector(const Pointer<CompositeTaskRunner> taskRunner,
+                                     const Pointer<CloseTransportsTask> closeTask) : impl(NULL) {
+
+    if (taskRunner == NULL) {
+        throw NullPointerException(__FILE__, __LINE__, "TaskRunner passed is NULL");
+    }
+
+    if (closeTask == NULL) {
+        throw NullPointerException(__FILE__, __LINE__, "Close Transport Task passed is NULL");
+    }
+
+    this->impl = new ParallelConnectorImpl(this, taskRunner, closeTask);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ParallelConnector::~ParallelConnector() {
+    try {
+        close();
+    }
+    AMQ_CATCHALL_NOTHROW()
+
+    try {
+        delete this->impl;
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<Transport> ParallelConnector::connect(const std::vector<URI>& uris,
+                                              TransportListener* listener,
+                                              URI& connected,
+                                              LinkedList<URI>& failures,
+                                              Pointer<Exception>& failure) {
+
+    if (listener == NULL) {
+        throw NullPointerException(__FILE__, __LINE__, "TransportListener passed is NULL");
+    }
+
+    // Attempts from earlier races that have since completed are no longer needed.
+    this->impl->reap(false);
+
+    std::vector<ConnectAttempt*> race;
+    ConnectAttempt* winner = NULL;
+    std::size_t next = 0;
+    long long nextStart = System::currentTimeMillis();
+
+    synchronized(&this->impl->mutex) {
+
+        while (!this->impl->closed) {
+
+            bool running = false;
+            std::vector<ConnectAttempt*>::const_iterator iter = race.begin();
+            for (; iter != race.end(); ++iter) {
+                if ((*iter)->state == ATTEMPT_CONNECTED) {
+                    winner = *iter;
+                    break;
+                } else if ((*iter)->state == ATTEMPT_CONNECTING) {
+                    running = true;
+                }
+            }
+
+            if (winner != NULL) {
+                break;
+            }
+
+            long long now = System::currentTimeMillis();
+
+            if (next < uris.size() && (!running || now >= nextStart)) {
+                ConnectAttempt* attempt = new ConnectAttempt(this->impl, uris[next++]);
+                race.push_back(attempt);
+                this->impl->attempts.push_back(attempt);
+                this->impl->attemptCount++;
+                attempt->thread.start();
+                nextStart = now + this->impl->staggerDelay;
+                continue;
+            }
+
+            if (!running) {
+                break;
+            }
+
+            if (next < uris.size()) {
+                this->impl->mutex.wait(nextStart - now > 0 ? nextStart - now : 1);
+            } else {
+                this->impl->mutex.wait();
+            }
+        }
+
+        std::vector<ConnectAttempt*>::const_iterator iter = race.begin();
+        for (; iter != race.end(); ++iter) {
+            ConnectAttempt* attempt = *iter;
+            if (attempt == winner) {
+                continue;
+            }
+
+            failures.add(attempt->uri);
+
+            if (attempt->state == ATTEMPT_FAILED) {
+                failure = attempt->error;
+            } else {
+                attempt->cancelled = true;
+                this->impl->cancelledCount++;
+                if (attempt->state == ATTEMPT_CONNECTED) {
+                    attempt->disposeLocked();
+                }
+            }
+        }
+
+        for (; next < uris.size(); ++next) {
+            failures.add(uris[next]);
+        }
+    }
+
+    if (winner == NULL) {
+        return Pointer<Transport>();
+    }
+
+    winner->handOff(listener);
+    connected = winner->uri;
+
+    return winner->transport;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ParallelConnector::close() {
+
+    synchronized(&this->impl->mutex) {
+
+        if (this->impl->closed) {
+            return;
+        }
+
+        this->impl->closed = true;
+
+        // Closing the transport of an attempt that is still connecting speeds up its failure.
+        std::vector<ConnectAttempt*>::const_iterator iter = this->impl->attempts.begin();
+        for (; iter != this->impl->attempts.end(); ++iter) {
+            ConnectAttempt* attempt = *iter;
+            if (attempt->state == ATTEMPT_CONNECTING) {
+                attempt->cancelled = true;
+                if (attempt->transport != NULL) {
+                    try {
+                        attempt->transport->close();
+                    } catch (...) {
+                    }
+                }
+            }
+        }
+
+        this->impl->mutex.notifyAll();
+    }
+
+    this->impl->reap(true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<Transport> ParallelConnector::createTransport(const URI& location) const {
+
+    try {
+
+        TransportFactory* factory = TransportRegistry::getInstance().findFactory(location.getScheme());
+
+        if (factory == NULL) {
+            throw IOException(__FILE__, __LINE__, "Invalid URI specified, no valid Factory Found.");
+        }
+
+        Pointer<Transport> transport(factory->createComposite(location));
+
+        return transport;
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ParallelConnector::setStaggerDelay(long long value) {
+    this->impl->staggerDelay = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long ParallelConnector::getStaggerDelay() const {
+    return this->impl->staggerDelay;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ParallelConnector::setAttemptTimeout(long long value) {
+    this->impl->attemptTimeout = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long ParallelConnector::getAttemptTimeout() const {
+    return this->impl->attemptTimeout;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long ParallelConnector::getAttemptCount() const {
+    return this->impl->attemptCount;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long ParallelConnector::getCancelledCount() const {
+    return this->impl->cancelledCount;
+}
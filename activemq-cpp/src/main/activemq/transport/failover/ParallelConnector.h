@@ -0,0 +1,175 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_TRANSPORT_FAILOVER_PARALLELCONNECTOR_H_
+#define _ACTIVEMQ_TRANSPORT_FAILOVER_PARALLELCONNECTOR_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/threads/CompositeTaskRunner.h>
+#include <activemq/transport/Transport.h>
+#include <activemq/transport/TransportListener.h>
+#include <activemq/transport/failover/CloseTransportsTask.h>
+
+#include <decaf/lang/Exception.h>
+#include <decaf/lang/Pointer.h>
+#include <decaf/net/URI.h>
+#include <decaf/util/LinkedList.h>
+
+#include <vector>
+
+namespace activemq {
+namespace transport {
+namespace failover {
+
+    using decaf::lang::Pointer;
+    using decaf::util::LinkedList;
+    using activemq::threads::CompositeTaskRunner;
+
+    class ParallelConnectorImpl;
+
+    /**
+     * Races connection attempts to several URIs at once for the FailoverTransport.
+     *
+     * The attempts are started in list order, each one starting either once the stagger
+     * delay has elapsed since the previous one started or as soon as every attempt that
+     * is already running has failed, whichever comes first.  The first attempt whose
+     * Transport starts and completes its wire format negotiation wins, the others are
+     * cancelled and any Transport they manage to create is closed.  This keeps a broker
+     * that silently drops connection requests from delaying the failover by the full
+     * connect timeout.
+     *
+     * Each attempt runs on its own thread, commands received by an attempt before it
+     * has been chosen are held and replayed to the TransportListener it is handed to.
+     *
+     * @since 3.8
+     */
+    class AMQCPP_API ParallelConnector {
+    private:
+
+        ParallelConnectorImpl* impl;
+
+    private:
+
+        ParallelConnector(const ParallelConnector&);
+        ParallelConnector& operator=(const ParallelConnector&);
+
+    public:
+
+        /**
+         * Creates a new connector.
+         *
+         * @param taskRunner
+         *      The task runner that runs the close task.
+         * @param closeTask
+         *      The task that losing Transports are handed to for closing.
+         */
+        ParallelConnector(const Pointer<CompositeTaskRunner> taskRunner,
+                          const Pointer<CloseTransportsTask> closeTask);
+
+        virtual ~ParallelConnector();
+
+        /**
+         * Races connection attempts to the given URIs and returns the started Transport
+         * of the winner, which has the given TransportListener assigned to it.
+         *
+         * @param uris
+         *      The URIs to connect to, in order of preference.
+         * @param listener
+         *      The TransportListener to assign to the winning Transport.
+         * @param connected
+         *      Set to the URI of the winning attempt.
+         * @param failures
+         *      Every URI other than the winner's is appended to this list.
+         * @param failure
+         *      Set to the error of the last attempt that failed, if any did.
+         *
+         * @returns the connected Transport or NULL if no attempt succeeded.
+         */
+        Pointer<Transport> connect(const std::vector<decaf::net::URI>& uris,
+                                   TransportListener* listener,
+                                   decaf::net::URI& connected,
+                                   LinkedList<decaf::net::URI>& failures,
+                                   Pointer<decaf::lang::Exception>& failure);
+
+        /**
+         * Cancels any attempt that is still running and waits for their threads to
+         * complete, no new attempts are started once this is called.
+         */
+        void close();
+
+        /**
+         * Sets the delay between starting successive connection attempts.
+         *
+         * @param value
+         *      The delay in milliseconds.
+         */
+        void setStaggerDelay(long long value);
+
+        /**
+         * @returns the delay between starting successive connection attempts in milliseconds.
+         */
+        long long getStaggerDelay() const;
+
+        /**
+         * Sets the time an attempt is given to connect and then again to complete its
+         * wire format negotiation.  The connect timeout is only applied to TCP based
+         * Transports that do not have one configured already.
+         *
+         * @param value
+         *      The timeout in milliseconds.
+         */
+        void setAttemptTimeout(long long value);
+
+        /**
+         * @returns the time an attempt is given to connect and to negotiate in milliseconds.
+         */
+        long long getAttemptTimeout() const;
+
+        /**
+         * @returns the number of connection attempts that have been started.
+         */
+        long long getAttemptCount() const;
+
+        /**
+         * @returns the number of attempts that were cancelled because another attempt won.
+         */
+        long long getCancelledCount() const;
+
+    protected:
+
+        /**
+         * Creates the Transport for an attempt, the default implementation looks the
+         * URI scheme up in the TransportRegistry.
+         *
+         * @param location
+         *      The URI to create the Transport for.
+         *
+         * @returns the new Transport, which has not been started.
+         *
+         * @throws IOException if the Transport cannot be created.
+         */
+        virtual Pointer<Transport> createTransport(const decaf::net::URI& location) const;
+
+    private:
+
+        friend class ParallelConnectorImpl;
+
+    };
+
+}}}
+
+#endif /* _ACTIVEMQ_TRANSPORT_FAILOVER_PARALLELCONNECTOR_H_ */
@@ -22,10 +22,12 @@
 
 #include <activemq/threads/CompositeTask.h>
 #include <activemq/threads/CompositeTaskRunner.h>
+#include <activemq/threads/ThreadPlacement.h>
 #include <activemq/commands/WireFormatInfo.h>
 #include <activemq/commands/KeepAliveInfo.h>
 
 #include <decaf/util/Timer.h>
+#include <decaf/util/TimerTask.h>
 #include <decaf/util/concurrent/atomic/AtomicBoolean.h>
 #include <decaf/util/concurrent/atomic/AtomicInteger.h>
 #include <decaf/lang/Math.h>
@@ -49,6 +51,9 @@ using namespace decaf::util::concurrent::atomic;
 using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
 
+////////////////////////////////////////////////////////////////////////////////
+LOGDECAF_INITIALIZE(logger, InactivityMonitor, "activemq.transport.inactivity.InactivityMonitor")
+
 ////////////////////////////////////////////////////////////////////////////////
 namespace activemq {
 namespace transport {
@@ -98,6 +103,8 @@ namespace inactivity {
 
         bool keepAliveResponseRequired;
 
+        ThreadPlacement timerThreadPlacement;
+
         InactivityMonitorData(const Pointer<WireFormat> wireFormat) :
             wireFormat(wireFormat),
             localWireFormatInfo(),
@@ -120,7 +127,31 @@ namespace inactivity {
             readCheckTime(0),
             writeCheckTime(0),
             initialDelayTime(0),
-            keepAliveResponseRequired(false) {
+            keepAliveResponseRequired(false),
+            timerThreadPlacement() {
+        }
+    };
+
+    // One shot Timer Task that moves the Timer's own thread onto the configured processors.
+    class ThreadPlacementTask : public TimerTask {
+    private:
+
+        ThreadPlacement placement;
+
+    private:
+
+        ThreadPlacementTask(const ThreadPlacementTask&);
+        ThreadPlacementTask operator=(const ThreadPlacementTask&);
+
+    public:
+
+        ThreadPlacementTask(const ThreadPlacement& placement) : TimerTask(), placement(placement) {}
+
+        virtual void run() {
+            try {
+                this->placement.applyToCurrentThread();
+            }
+            AMQ_CATCHALL_NOTHROW()
         }
     };
 
@@ -215,6 +246,8 @@ InactivityMonitor::InactivityMonitor(const Pointer<Transport> next, const decaf:
     TransportFilter(next), members(new InactivityMonitorData(wireFormat)) {
 
     this->members->keepAliveResponseRequired = Boolean::parseBoolean(properties.getProperty("keepAliveResponseRequired", "false"));
+    this->members->timerThreadPlacement = ThreadPlacement::parse(
+        properties.getProperty("transport.inactivityMonitorThreadAffinity", ""));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -395,6 +428,8 @@ void InactivityMonitor::readCheck() {
     }
 
     if (!this->members->commandReceived.get()) {
+        LOGDECAF_WARN_1(logger, "No command received within the read check interval from: ", this->getRemoteAddress());
+
         // Set the failed state on our async Read Failure Task and wakeup its runner.
         this->members->asyncReadTask->setFailed(true);
         this->members->asyncTasks->wakeup();
@@ -411,6 +446,7 @@ void InactivityMonitor::writeCheck() {
     }
 
     if (!this->members->commandSent.get()) {
+        LOGDECAF_DEBUG_1(logger, "Sending KeepAliveInfo to: ", this->getRemoteAddress());
 
         this->members->asyncWriteTask->setWrite(true);
         this->members->asyncTasks->wakeup();
@@ -457,6 +493,13 @@ void InactivityMonitor::startMonitorThreads() {
             this->members->readCheckerTask.reset(new ReadChecker(this));
             this->members->writeCheckTime = this->members->readCheckTime > 3 ? this->members->readCheckTime / 3 : this->members->readCheckTime;
 
+            if (!this->members->timerThreadPlacement.isEmpty()) {
+                this->members->writeCheckTimer.schedule(
+                    Pointer<TimerTask>(new ThreadPlacementTask(this->members->timerThreadPlacement)), 0);
+                this->members->readCheckTimer.schedule(
+                    Pointer<TimerTask>(new ThreadPlacementTask(this->members->timerThreadPlacement)), 0);
+            }
+
             this->members->writeCheckTimer.scheduleAtFixedRate(this->members->writeCheckerTask, this->members->initialDelayTime, this->members->writeCheckTime);
             this->members->readCheckTimer.scheduleAtFixedRate(this->members->readCheckerTask, this->members->initialDelayTime, this->members->readCheckTime);
         }
@@ -26,6 +26,7 @@
 
 #include <decaf/lang/Pointer.h>
 #include <decaf/util/Properties.h>
+#include <decaf/util/logging/LoggerDefines.h>
 
 namespace activemq {
 namespace transport {
@@ -45,6 +46,8 @@ namespace inactivity {
         // Internal Class used to house the data structures for this object
         InactivityMonitorData* members;
 
+        LOGDECAF_DECLARE(logger)
+
         friend class ReadChecker;
         friend class AsyncSignalReadErrorkTask;
         friend class WriteChecker;
@@ -23,11 +23,14 @@
 #include <activemq/transport/inactivity/InactivityMonitor.h>
 #include <activemq/transport/logging/LoggingTransport.h>
 
+#include <decaf/lang/Long.h>
+
 #include <memory>
 
 using namespace std;
 using namespace activemq;
 using namespace activemq::io;
+using namespace activemq::threads;
 using namespace activemq::transport;
 using namespace activemq::transport::logging;
 using namespace activemq::transport::inactivity;
@@ -50,7 +53,13 @@ Pointer<Transport> SslTransportFactory::doCreateComposite(const decaf::net::URI&
 
     try {
 
-        Pointer<Transport> transport(new IOTransport(wireFormat));
+        IOTransport* ioTransport = new IOTransport(wireFormat);
+        Pointer<Transport> transport(ioTransport);
+
+        ioTransport->setReaderThreadPlacement(ThreadPlacement::parse(
+            properties.getProperty("transport.readerThreadAffinity", "")));
+        ioTransport->setBusyPollTime(Long::parseLong(
+            properties.getProperty("transport.readerBusyPollTime", "0")));
 
         transport.reset(new SslTransport(transport, location));
 
@@ -19,6 +19,8 @@
 
 #include <activemq/transport/IOTransport.h>
 #include <activemq/transport/TransportFactory.h>
+#include <activemq/transport/capture/WireCaptureInputStream.h>
+#include <activemq/transport/capture/WireCaptureOutputStream.h>
 
 #include <decaf/lang/exceptions/NullPointerException.h>
 #include <decaf/lang/exceptions/IllegalArgumentException.h>
@@ -32,6 +34,7 @@ using namespace activemq;
 using namespace activemq::io;
 using namespace activemq::transport;
 using namespace activemq::transport::tcp;
+using namespace activemq::transport::capture;
 using namespace activemq::exceptions;
 using namespace decaf;
 using namespace decaf::net;
@@ -73,6 +76,8 @@ namespace tcp {
         int soSendBufferSize;
         bool tcpNoDelay;
 
+        Pointer<capture::WireCapture> capture;
+
         TcpTransportImpl(const decaf::net::URI& location) :
             connectTimeout(0),
             socket(),
@@ -86,7 +91,8 @@ namespace tcp {
             soKeepAlive(false),
             soReceiveBufferSize(-1),
             soSendBufferSize(-1),
-            tcpNoDelay(true) {
+            tcpNoDelay(true),
+            capture() {
         }
     };
 }}}
@@ -139,6 +145,10 @@ void TcpTransport::doClose() {
         if (impl->socket.get() != NULL) {
             impl->socket->close();
         }
+
+        if (impl->capture != NULL) {
+            impl->capture->close();
+        }
     }
     AMQ_CATCH_RETHROW(IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
@@ -186,6 +196,17 @@ void TcpTransport::connect() {
         // We don't own these ever, socket object owns.
         InputStream* socketIStream = impl->socket->getInputStream();
         OutputStream* sokcetOStream = impl->socket->getOutputStream();
+        bool ownSocketStreams = false;
+
+        // If wire capture was enabled, wrap the socket streams so that everything that
+        // goes in and out of the socket is copied to the capture.
+        if (this->impl->capture != NULL) {
+            this->impl->capture->start();
+
+            socketIStream = new WireCaptureInputStream(socketIStream, this->impl->capture);
+            sokcetOStream = new WireCaptureOutputStream(sokcetOStream, this->impl->capture);
+            ownSocketStreams = true;
+        }
 
         Pointer<InputStream> inputStream;
         Pointer<OutputStream> outputStream;
@@ -193,16 +214,17 @@ void TcpTransport::connect() {
         // If tcp tracing was enabled, wrap the input / output streams with logging streams
         if (this->impl->trace) {
             // Wrap with logging stream, we don't own the wrapped streams
-            inputStream.reset(new LoggingInputStream(socketIStream));
-            outputStream.reset(new LoggingOutputStream(sokcetOStream));
+            inputStream.reset(new LoggingInputStream(socketIStream, ownSocketStreams));
+            outputStream.reset(new LoggingOutputStream(sokcetOStream, ownSocketStreams));
 
             // Now wrap with the Buffered streams, we own the source streams
             inputStream.reset(new BufferedInputStream(inputStream.release(), inputBufferSize, true));
             outputStream.reset(new BufferedOutputStream(outputStream.release(), outputBufferSize, true));
         } else {
-            // Wrap with the Buffered streams, we don't own the source streams
-            inputStream.reset(new BufferedInputStream(socketIStream, inputBufferSize));
-            outputStream.reset(new BufferedOutputStream(sokcetOStream, outputBufferSize));
+            // Wrap with the Buffered streams, we don't own the source streams unless
+            // they are capture streams.
+            inputStream.reset(new BufferedInputStream(socketIStream, inputBufferSize, ownSocketStreams));
+            outputStream.reset(new BufferedOutputStream(sokcetOStream, outputBufferSize, ownSocketStreams));
         }
 
         // Now wrap the Buffered Streams with DataInput based streams.  We own
@@ -313,6 +335,16 @@ bool TcpTransport::isTrace() const {
     return this->impl->trace;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void TcpTransport::setWireCapture(Pointer<capture::WireCapture> capture) {
+    this->impl->capture = capture;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<capture::WireCapture> TcpTransport::getWireCapture() const {
+    return this->impl->capture;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void TcpTransport::setLinger(int soLinger) {
     this->impl->soLinger = soLinger;
@@ -22,6 +22,7 @@
 #include <activemq/io/LoggingOutputStream.h>
 #include <activemq/util/Config.h>
 #include <activemq/transport/TransportFilter.h>
+#include <activemq/transport/capture/WireCapture.h>
 #include <decaf/net/Socket.h>
 #include <decaf/net/URI.h>
 #include <decaf/util/Properties.h>
@@ -97,6 +98,17 @@ namespace tcp {
         void setTcpNoDelay(bool tcpNoDelay);
         bool isTcpNoDelay() const;
 
+        /**
+         * Sets a WireCapture that records all the bytes sent and received on the socket,
+         * must be set before the Transport is started.  The capture is started when the
+         * socket connects and closed along with this Transport.
+         *
+         * @param capture
+         *      The WireCapture to record to, or NULL to disable capture.
+         */
+        void setWireCapture(Pointer<capture::WireCapture> capture);
+        Pointer<capture::WireCapture> getWireCapture() const;
+
     public: // Transport Methods
 
         virtual bool isFaultTolerant() const {
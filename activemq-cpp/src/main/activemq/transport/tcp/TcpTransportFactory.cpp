@@ -21,20 +21,24 @@
 #include <activemq/transport/tcp/TcpTransport.h>
 #include <activemq/transport/correlator/ResponseCorrelator.h>
 #include <activemq/transport/logging/LoggingTransport.h>
+#include <activemq/transport/capture/WireCapture.h>
 #include <activemq/transport/inactivity/InactivityMonitor.h>
 #include <activemq/util/URISupport.h>
 #include <activemq/wireformat/WireFormat.h>
 #include <decaf/util/Properties.h>
 #include <decaf/lang/Integer.h>
+#include <decaf/lang/Long.h>
 #include <decaf/lang/Boolean.h>
 
 using namespace activemq;
 using namespace activemq::util;
+using namespace activemq::threads;
 using namespace activemq::wireformat;
 using namespace activemq::transport;
 using namespace activemq::transport::tcp;
 using namespace activemq::transport::correlator;
 using namespace activemq::transport::logging;
+using namespace activemq::transport::capture;
 using namespace activemq::transport::inactivity;
 using namespace activemq::exceptions;
 using namespace decaf;
@@ -87,7 +91,13 @@ Pointer<Transport> TcpTransportFactory::doCreateComposite(const decaf::net::URI&
 
     try {
 
-        Pointer<Transport> transport(new IOTransport(wireFormat));
+        IOTransport* ioTransport = new IOTransport(wireFormat);
+        Pointer<Transport> transport(ioTransport);
+
+        ioTransport->setReaderThreadPlacement(ThreadPlacement::parse(
+            properties.getProperty("transport.readerThreadAffinity", "")));
+        ioTransport->setBusyPollTime(Long::parseLong(
+            properties.getProperty("transport.readerBusyPollTime", "0")));
 
         transport.reset(new TcpTransport(transport, location));
 
@@ -137,6 +147,14 @@ void TcpTransportFactory::doConfigureTransport(Pointer<Transport> transport,
         tcp->setSendBufferSize(Integer::parseInt(properties.getProperty("soSendBufferSize", "-1")));
         tcp->setTcpNoDelay(Boolean::parseBoolean(properties.getProperty("tcpNoDelay", "true")));
         tcp->setConnectTimeout(Integer::parseInt(properties.getProperty("soConnectTimeout", "0")));
+
+        std::string captureFile = properties.getProperty("transport.captureFile", "");
+        if (!captureFile.empty()) {
+            tcp->setWireCapture(Pointer<WireCapture>(new WireCapture(captureFile,
+                Integer::parseInt(properties.getProperty("transport.captureRingSize", "4194304")),
+                Long::parseLong(properties.getProperty("transport.captureMaxFileSize", "67108864")),
+                Integer::parseInt(properties.getProperty("transport.captureMaxFiles", "4")))));
+        }
     }
     AMQ_CATCH_RETHROW(ActiveMQException)
     AMQ_CATCH_EXCEPTION_CONVERT(Exception, ActiveMQException)
@@ -0,0 +1,140 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CompactId.h"
+
+#include <sstream>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::util;
+using namespace decaf;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    int compareLongs(long long left, long long right) {
+        return left < right ? -1 : (left == right ? 0 : 1);
+    }
+
+    int hashLong(int hash, long long value) {
+        return 31 * hash + (int) (value ^ (long long) ((unsigned long long) value >> 32));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+CompactId::CompactId() : connection(), sessionId(0), value(0), sequenceId(0) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+CompactId::CompactId(const ConnectionKey& connection,
+                     long long sessionId, long long value, long long sequenceId) :
+    connection(connection), sessionId(sessionId), value(value), sequenceId(sequenceId) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+CompactId::CompactId(const CompactId& other) :
+    connection(other.connection), sessionId(other.sessionId), value(other.value), sequenceId(other.sequenceId) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+CompactId::~CompactId() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+CompactId& CompactId::operator=(const CompactId& other) {
+    this->connection = other.connection;
+    this->sessionId = other.sessionId;
+    this->value = other.value;
+    this->sequenceId = other.sequenceId;
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int CompactId::compareTo(const CompactId& other) const {
+
+    if (this->connection != other.connection) {
+        if (this->connection == NULL) {
+            return -1;
+        } else if (other.connection == NULL) {
+            return 1;
+        }
+
+        int result = this->connection->compareTo(*other.connection);
+        if (result != 0) {
+            return result;
+        }
+    }
+
+    int result = compareLongs(this->sessionId, other.sessionId);
+    if (result != 0) {
+        return result;
+    }
+
+    result = compareLongs(this->value, other.value);
+    if (result != 0) {
+        return result;
+    }
+
+    return compareLongs(this->sequenceId, other.sequenceId);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int CompactId::getHashCode() const {
+
+    int hash = this->connection != NULL ? this->connection->getHashCode() : 0;
+
+    hash = hashLong(hash, this->sessionId);
+    hash = hashLong(hash, this->value);
+    return hashLong(hash, this->sequenceId);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string CompactId::toString() const {
+
+    ostringstream stream;
+
+    if (this->connection != NULL) {
+        stream << this->connection->getConnectionId();
+    }
+
+    stream << ":" << this->sessionId << ":" << this->value << ":" << this->sequenceId;
+
+    return stream.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool CompactId::operator==(const CompactId& other) const {
+
+    if (this->sessionId != other.sessionId || this->value != other.value || this->sequenceId != other.sequenceId) {
+        return false;
+    }
+
+    if (this->connection == other.connection) {
+        return true;
+    } else if (this->connection == NULL || other.connection == NULL) {
+        return false;
+    }
+
+    return this->connection->equals(*other.connection);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool CompactId::operator<(const CompactId& other) const {
+    return this->compareTo(other) < 0;
+}
@@ -0,0 +1,108 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_UTIL_COMPACTID_H_
+#define _ACTIVEMQ_UTIL_COMPACTID_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/util/ConnectionIdTable.h>
+
+#include <string>
+
+namespace activemq {
+namespace util {
+
+    /**
+     * Numeric form of a connection scoped id such as a ProducerId or MessageId, made
+     * up of the interned connection id plus the session, value and sequence numbers
+     * that follow it in the string form.  Comparing and hashing a CompactId only
+     * reads the connection id string when two different connection ids share a hash
+     * code, which makes it a cheap key for the audit and cache maps that see every
+     * message.  Fields an id does not have are left at zero.
+     *
+     * The string form is only built when toString is called.
+     *
+     * @since 3.8
+     */
+    class AMQCPP_API CompactId {
+    private:
+
+        ConnectionKey connection;
+        long long sessionId;
+        long long value;
+        long long sequenceId;
+
+    public:
+
+        CompactId();
+
+        CompactId(const ConnectionKey& connection,
+                  long long sessionId, long long value, long long sequenceId = 0);
+
+        CompactId(const CompactId& other);
+
+        virtual ~CompactId();
+
+        CompactId& operator=(const CompactId& other);
+
+    public:
+
+        /**
+         * @return the interned connection id, or NULL if this id has none.
+         */
+        const ConnectionKey& getConnection() const {
+            return this->connection;
+        }
+
+        long long getSessionId() const {
+            return this->sessionId;
+        }
+
+        long long getValue() const {
+            return this->value;
+        }
+
+        long long getSequenceId() const {
+            return this->sequenceId;
+        }
+
+        /**
+         * Orders ids by connection and then by session, value and sequence.
+         *
+         * @param other
+         *      The id to compare to.
+         *
+         * @return zero if equal, negative if this id orders first, positive otherwise.
+         */
+        int compareTo(const CompactId& other) const;
+
+        int getHashCode() const;
+
+        /**
+         * @return the connection:session:value:sequence form of this id.
+         */
+        std::string toString() const;
+
+        bool operator==(const CompactId& other) const;
+
+        bool operator<(const CompactId& other) const;
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_UTIL_COMPACTID_H_ */
@@ -0,0 +1,257 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ConnectionIdTable.h"
+
+#include <activemq/exceptions/ActiveMQException.h>
+#include <decaf/util/HashCode.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/internal/util/StringUtils.h>
+
+#include <map>
+
+using namespace activemq;
+using namespace activemq::util;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::atomic;
+using namespace decaf::internal::util;
+
+////////////////////////////////////////////////////////////////////////////////
+ConnectionIdTableKernel* ConnectionIdTable::kernel = NULL;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace util {
+
+    class ConnectionIdTableKernel {
+    private:
+
+        ConnectionIdTableKernel(const ConnectionIdTableKernel&);
+        ConnectionIdTableKernel& operator=(const ConnectionIdTableKernel&);
+
+    public:
+
+        // Starts at one, generation zero marks a standalone entry.
+        static int nextGeneration;
+
+        int generation;
+        int nextIndex;
+        std::map<std::string, ConnectionIdTable::Entry*> entries;
+        decaf::util::concurrent::Mutex mutex;
+
+        // One reference for the library plus one for every live Entry, so that keys
+        // released after shutdown can still remove themselves.
+        AtomicInteger references;
+
+        ConnectionIdTableKernel() : generation(nextGeneration++), nextIndex(0), entries(), mutex(), references(1) {
+        }
+
+        void release() {
+            if (this->references.decrementAndGet() == 0) {
+                delete this;
+            }
+        }
+    };
+
+    int ConnectionIdTableKernel::nextGeneration = 1;
+
+}}
+
+////////////////////////////////////////////////////////////////////////////////
+ConnectionIdTable::Entry::Entry(const std::string& connectionId, int index, int generation) :
+    connectionId(connectionId), index(index), generation(generation), hashCode(HashCode<std::string>()(connectionId)),
+    references(1), table(NULL) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ConnectionIdTable::Entry::~Entry() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ConnectionIdTable::Entry::compareTo(const Entry& other) const {
+
+    if (this == &other) {
+        return 0;
+    }
+
+    // Two entries of the same table are never equal, though they still have to be
+    // ordered the same way as entries of any other table so the string decides.
+    if (this->hashCode != other.hashCode) {
+        return this->hashCode < other.hashCode ? -1 : 1;
+    }
+
+    return StringUtils::compare(this->connectionId.c_str(), other.connectionId.c_str());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ConnectionIdTable::Entry::equals(const Entry& other) const {
+
+    if (this == &other) {
+        return true;
+    }
+
+    if (this->generation != 0 && this->generation == other.generation) {
+        return false;
+    }
+
+    return this->hashCode == other.hashCode && this->connectionId == other.connectionId;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ConnectionKey ConnectionIdTable::intern(const std::string& connectionId) {
+
+    if (connectionId.empty()) {
+        return ConnectionKey();
+    }
+
+    ConnectionIdTableKernel* kernel = ConnectionIdTable::kernel;
+
+    if (kernel == NULL) {
+        return ConnectionKey(new Entry(connectionId, -1, 0));
+    }
+
+    synchronized(&kernel->mutex) {
+
+        std::map<std::string, Entry*>::iterator iter = kernel->entries.find(connectionId);
+        if (iter != kernel->entries.end()) {
+
+            // An Entry whose count already reached zero is being released by another
+            // thread and must not be revived, it is replaced below instead.
+            Entry* entry = iter->second;
+            int count = entry->references.get();
+            while (count > 0) {
+                if (entry->references.compareAndSet(count, count + 1)) {
+                    return ConnectionKey(entry);
+                }
+                count = entry->references.get();
+            }
+        }
+
+        kernel->references.incrementAndGet();
+        Entry* entry = new Entry(connectionId, kernel->nextIndex++, kernel->generation);
+        entry->table = kernel;
+        kernel->entries[connectionId] = entry;
+        return ConnectionKey(entry);
+    }
+
+    return ConnectionKey();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ConnectionIdTable::release(Entry* entry) {
+
+    if (entry->references.decrementAndGet() != 0) {
+        return;
+    }
+
+    ConnectionIdTableKernel* table = entry->table;
+
+    if (table != NULL) {
+
+        synchronized(&table->mutex) {
+            std::map<std::string, Entry*>::iterator iter = table->entries.find(entry->connectionId);
+            if (iter != table->entries.end() && iter->second == entry) {
+                table->entries.erase(iter);
+            }
+        }
+
+        table->release();
+    }
+
+    delete entry;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ConnectionIdTable::size() {
+
+    ConnectionIdTableKernel* kernel = ConnectionIdTable::kernel;
+
+    if (kernel == NULL) {
+        return 0;
+    }
+
+    synchronized(&kernel->mutex) {
+        return (int) kernel->entries.size();
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ConnectionIdTable::initialize() {
+    ConnectionIdTable::kernel = new ConnectionIdTableKernel();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ConnectionIdTable::shutdown() {
+    ConnectionIdTableKernel* kernel = ConnectionIdTable::kernel;
+    ConnectionIdTable::kernel = NULL;
+
+    if (kernel != NULL) {
+        kernel->release();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ConnectionKey::ConnectionKey() : entry(NULL) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ConnectionKey::ConnectionKey(ConnectionIdTable::Entry* entry) : entry(entry) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ConnectionKey::ConnectionKey(const ConnectionKey& other) : entry(other.entry) {
+    if (this->entry != NULL) {
+        this->entry->references.incrementAndGet();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ConnectionKey::~ConnectionKey() {
+    try {
+        reset();
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ConnectionKey& ConnectionKey::operator=(const ConnectionKey& other) {
+
+    if (this->entry != other.entry) {
+        if (other.entry != NULL) {
+            other.entry->references.incrementAndGet();
+        }
+        reset();
+        this->entry = other.entry;
+    }
+
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ConnectionKey::reset() {
+    ConnectionIdTable::Entry* entry = this->entry;
+    this->entry = NULL;
+
+    if (entry != NULL) {
+        ConnectionIdTable::release(entry);
+    }
+}
@@ -0,0 +1,234 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_UTIL_CONNECTIONIDTABLE_H_
+#define _ACTIVEMQ_UTIL_CONNECTIONIDTABLE_H_
+
+#include <activemq/util/Config.h>
+
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+
+#include <string>
+
+namespace activemq {
+namespace library {
+    class ActiveMQCPP;
+}
+namespace util {
+
+    class ConnectionIdTableKernel;
+    class ConnectionKey;
+
+    /**
+     * Process wide table of interned connection id strings.
+     *
+     * The ProducerId, ConsumerId and SessionId commands all carry the full connection
+     * id string generated by the IdGenerator.  Interning that string gives every id
+     * from the same connection a shared Entry holding a small index and the string's
+     * precomputed hash code, so that ids can be compared and hashed without touching
+     * the string again, see CompactId.
+     *
+     * Entries are held through ConnectionKey handles, the table itself does not own
+     * them: when the last key for a connection id is released its Entry is removed from
+     * the table and deleted, so the table only ever holds ids that are still in use.
+     * Keys stay valid after the library is shut down, however only entries interned by
+     * the same table instance are known to be unique, comparisons between any other
+     * entries fall back to comparing the strings.  If the library has not been
+     * initialized intern returns a key to a standalone Entry, and the empty id always
+     * maps to a NULL key.
+     *
+     * @since 3.8
+     */
+    class AMQCPP_API ConnectionIdTable {
+    public:
+
+        /**
+         * An interned connection id.
+         */
+        class AMQCPP_API Entry {
+        private:
+
+            std::string connectionId;
+            int index;
+            int generation;
+            int hashCode;
+            decaf::util::concurrent::atomic::AtomicInteger references;
+            ConnectionIdTableKernel* table;
+
+        private:
+
+            Entry(const Entry&);
+            Entry& operator=(const Entry&);
+
+            friend class ConnectionIdTable;
+            friend class ConnectionKey;
+
+        public:
+
+            Entry(const std::string& connectionId, int index, int generation);
+
+            virtual ~Entry();
+
+            /**
+             * @return the connection id string this entry was interned for.
+             */
+            const std::string& getConnectionId() const {
+                return this->connectionId;
+            }
+
+            /**
+             * @return the index assigned by the table, or -1 for a standalone entry.
+             */
+            int getIndex() const {
+                return this->index;
+            }
+
+            /**
+             * @return the hash code of the connection id string.
+             */
+            int getHashCode() const {
+                return this->hashCode;
+            }
+
+            /**
+             * Compares two entries by the hash code of their connection ids and then by
+             * the strings themselves, the same for all entries whichever table interned
+             * them, so the string is only read when the hash codes are equal.
+             *
+             * @param other
+             *      The entry to compare to.
+             *
+             * @return zero if the entries hold the same connection id, negative if this
+             *         entry orders before the other and positive if it orders after it.
+             */
+            int compareTo(const Entry& other) const;
+
+            /**
+             * @param other
+             *      The entry to compare to.
+             *
+             * @return true if both entries hold the same connection id.
+             */
+            bool equals(const Entry& other) const;
+
+        };
+
+    private:
+
+        static ConnectionIdTableKernel* kernel;
+
+    private:
+
+        ConnectionIdTable();
+        ConnectionIdTable(const ConnectionIdTable&);
+        ConnectionIdTable& operator=(const ConnectionIdTable&);
+
+    public:
+
+        /**
+         * Returns a key to the Entry for the given connection id, adding it to the table
+         * if no other key for that id is currently alive.
+         *
+         * @param connectionId
+         *      The connection id string to intern.
+         *
+         * @return a key to the shared Entry, or a NULL key if the id is empty.
+         */
+        static ConnectionKey intern(const std::string& connectionId);
+
+        /**
+         * @return the number of connection ids currently held in the table.
+         */
+        static int size();
+
+    private:
+
+        static void initialize();
+        static void shutdown();
+
+        static void release(Entry* entry);
+
+        friend class activemq::library::ActiveMQCPP;
+        friend class ConnectionKey;
+    };
+
+    /**
+     * Counted handle to an interned ConnectionIdTable::Entry, copying a key shares the
+     * Entry and releasing the last key for an Entry evicts it from the table.  Keys
+     * compare equal when they refer to the same Entry.
+     *
+     * @since 3.8
+     */
+    class AMQCPP_API ConnectionKey {
+    private:
+
+        ConnectionIdTable::Entry* entry;
+
+    private:
+
+        explicit ConnectionKey(ConnectionIdTable::Entry* entry);
+
+        friend class ConnectionIdTable;
+
+    public:
+
+        ConnectionKey();
+
+        ConnectionKey(const ConnectionKey& other);
+
+        ~ConnectionKey();
+
+        ConnectionKey& operator=(const ConnectionKey& other);
+
+        /**
+         * Releases the Entry held by this key, leaving it NULL.
+         */
+        void reset();
+
+        ConnectionIdTable::Entry* get() const {
+            return this->entry;
+        }
+
+        ConnectionIdTable::Entry* operator->() const {
+            return this->entry;
+        }
+
+        ConnectionIdTable::Entry& operator*() const {
+            return *this->entry;
+        }
+
+        bool operator==(const ConnectionKey& other) const {
+            return this->entry == other.entry;
+        }
+
+        bool operator!=(const ConnectionKey& other) const {
+            return this->entry != other.entry;
+        }
+
+        bool operator==(const ConnectionIdTable::Entry* other) const {
+            return this->entry == other;
+        }
+
+        bool operator!=(const ConnectionIdTable::Entry* other) const {
+            return this->entry != other;
+        }
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_UTIL_CONNECTIONIDTABLE_H_ */
@@ -0,0 +1,59 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MappedFileRegion.h"
+
+#include <decaf/internal/io/MemoryMappedFile.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+
+#include <memory>
+
+using namespace activemq;
+using namespace activemq::util;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::internal::io;
+
+////////////////////////////////////////////////////////////////////////////////
+MappedFileRegion::MappedFileRegion(const std::string& path, long long offset, int length) :
+    file(NULL), path(path), data(NULL), length(0) {
+
+    // Only the pages holding the region are mapped, the rest of the file is untouched.
+    std::auto_ptr<MemoryMappedFile> mapped(new MemoryMappedFile());
+    mapped->open(path, offset, (long long) length);
+
+    long long regionLength = mapped->getLength();
+
+    if (regionLength > Integer::MAX_VALUE) {
+        throw IllegalArgumentException(__FILE__, __LINE__,
+            "Region of %lld bytes is too large for a Message body.", regionLength);
+    }
+
+    if (regionLength > 0) {
+        this->data = mapped->getBuffer();
+        this->length = (int) regionLength;
+    }
+
+    this->file = mapped.release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MappedFileRegion::~MappedFileRegion() {
+    delete this->file;
+}
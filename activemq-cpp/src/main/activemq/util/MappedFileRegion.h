@@ -0,0 +1,101 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_UTIL_MAPPEDFILEREGION_H_
+#define _ACTIVEMQ_UTIL_MAPPEDFILEREGION_H_
+
+#include <activemq/util/Config.h>
+
+#include <string>
+
+namespace decaf {
+namespace internal {
+namespace io {
+    class MemoryMappedFile;
+}}}
+
+namespace activemq {
+namespace util {
+
+    /**
+     * A read only view of a range of bytes in a file that is mapped into memory, the
+     * bytes are paged in by the kernel as they are read so a large file can be used as
+     * a Message body without ever being copied onto the heap.  The file stays mapped
+     * until the region is destroyed, the region is immutable so it can be shared by the
+     * copies of a Message.
+     *
+     * @since 3.8
+     */
+    class AMQCPP_API MappedFileRegion {
+    private:
+
+        decaf::internal::io::MemoryMappedFile* file;
+        std::string path;
+        const unsigned char* data;
+        int length;
+
+    private:
+
+        MappedFileRegion(const MappedFileRegion&);
+        MappedFileRegion& operator=(const MappedFileRegion&);
+
+    public:
+
+        /**
+         * Maps the given range of the named file.
+         *
+         * @param path
+         *      The path of the file to map.
+         * @param offset
+         *      The offset in the file of the first byte of the region.
+         * @param length
+         *      The number of bytes in the region, or -1 for the rest of the file.
+         *
+         * @throws IOException if the file can't be opened or mapped.
+         * @throws IllegalArgumentException if the range is outside the file or is larger
+         *         than a Message body can be.
+         */
+        MappedFileRegion(const std::string& path, long long offset, int length);
+
+        virtual ~MappedFileRegion();
+
+        /**
+         * @return the path of the mapped file.
+         */
+        const std::string& getPath() const {
+            return this->path;
+        }
+
+        /**
+         * @return the first byte of the region, or NULL if the region is empty.
+         */
+        const unsigned char* getData() const {
+            return this->data;
+        }
+
+        /**
+         * @return the number of bytes in the region.
+         */
+        int getLength() const {
+            return this->length;
+        }
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_UTIL_MAPPEDFILEREGION_H_ */
@@ -16,20 +16,50 @@
  */
 
 #include "MemoryUsage.h"
+
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/exceptions/InterruptedException.h>
 #include <decaf/util/concurrent/Concurrent.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
 
 using namespace activemq;
 using namespace activemq::util;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
 using namespace decaf::util;
 using namespace decaf::util::concurrent;
 using namespace std;
 
 ////////////////////////////////////////////////////////////////////////////////
-MemoryUsage::MemoryUsage() : limit(0), usage(0), mutex() {
+namespace {
+
+    int toUsage(unsigned long long value) {
+        return value > (unsigned long long) Integer::MAX_VALUE ? Integer::MAX_VALUE : (int) value;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-MemoryUsage::MemoryUsage(unsigned long long limit) : limit(limit), usage(), mutex() {
+namespace activemq {
+namespace util {
+
+    class MemoryUsage::Waiter {
+    public:
+
+        CountDownLatch signal;
+
+        Waiter() : signal(1) {}
+    };
+
+}}
+
+////////////////////////////////////////////////////////////////////////////////
+MemoryUsage::MemoryUsage() : limit(0), usage(0), waiting(0), waiters(), mutex(), blockedCount(), blockedTime() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MemoryUsage::MemoryUsage(unsigned long long limit) : limit(limit), usage(0), waiting(0), waiters(), mutex(),
+                                                     blockedCount(), blockedTime() {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -39,23 +69,103 @@ MemoryUsage::~MemoryUsage() {
 ////////////////////////////////////////////////////////////////////////////////
 void MemoryUsage::waitForSpace() {
 
+    while (this->isFull()) {
+        waitForSpace(0);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryUsage::waitForSpace(unsigned int timeout) {
+
+    if (!this->isFull()) {
+        return;
+    }
+
+    long long start = System::nanoTime();
+
+    Waiter waiter;
     synchronized(&mutex) {
-        while (this->isFull()) {
-            mutex.wait();
+        this->waiters.push_back(&waiter);
+        this->waiting.incrementAndGet();
+    }
+
+    // Space may have been returned before we were queued, in which case nobody
+    // is going to wake us so start the hand off here.
+    if (!this->isFull()) {
+        signalNextWaiter();
+    }
+
+    bool signalled = true;
+
+    try {
+        if (timeout == 0) {
+            waiter.signal.await();
+        } else {
+            signalled = waiter.signal.await(timeout);
         }
+    } catch (InterruptedException& ex) {
+        if (!removeWaiter(&waiter)) {
+            signalNextWaiter();
+        }
+        throw;
+    }
+
+    // Removal always takes the lock which ensures that a concurrent wake up of this
+    // waiter has completed before it goes out of scope.  A waiter that was woken
+    // leaves the next wake up to whoever increases the usage after it, but one that
+    // timed out as it was being woken passes that wake up on as it won't use it.
+    if (!removeWaiter(&waiter) && !signalled) {
+        signalNextWaiter();
     }
+
+    this->blockedCount.increment();
+    this->blockedTime.add((System::nanoTime() - start) / 1000);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void MemoryUsage::waitForSpace(unsigned int timeout) {
+bool MemoryUsage::removeWaiter(Waiter* waiter) {
+
+    synchronized(&mutex) {
+        for (std::list<Waiter*>::iterator iter = this->waiters.begin(); iter != this->waiters.end(); ++iter) {
+            if (*iter == waiter) {
+                this->waiters.erase(iter);
+                this->waiting.decrementAndGet();
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
 
-    if (this->isFull()) {
-        synchronized(&mutex) {
-            mutex.wait(timeout);
+////////////////////////////////////////////////////////////////////////////////
+void MemoryUsage::signalNextWaiter() {
+
+    if (this->waiting.get() == 0) {
+        return;
+    }
+
+    synchronized(&mutex) {
+        if (!this->waiters.empty() && !this->isFull()) {
+            Waiter* next = this->waiters.front();
+            this->waiters.pop_front();
+            this->waiting.decrementAndGet();
+            next->signal.countDown();
         }
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool MemoryUsage::tryEnqueueUsage(unsigned long long value) {
+
+    if (this->isFull() || this->hasWaiters()) {
+        return false;
+    }
+
+    increaseUsage(value);
+    return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void MemoryUsage::increaseUsage(unsigned long long value) {
 
@@ -63,9 +173,17 @@ void MemoryUsage::increaseUsage(unsigned long long value) {
         return;
     }
 
-    synchronized(&mutex) {
-        this->usage += value;
-    }
+    int delta = toUsage(value);
+    int current;
+    int update;
+
+    do {
+        current = this->usage.get();
+        update = current > Integer::MAX_VALUE - delta ? Integer::MAX_VALUE : current + delta;
+    } while (!this->usage.compareAndSet(current, update));
+
+    // The last thread woken has used its share, pass the wake up on if space remains.
+    signalNextWaiter();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -75,19 +193,31 @@ void MemoryUsage::decreaseUsage(unsigned long long value) {
         return;
     }
 
-    synchronized(&mutex) {
-        value > this->usage ? this->usage = 0 : this->usage -= value;
-        mutex.notifyAll();
-    }
+    int delta = toUsage(value);
+    int current;
+    int update;
+
+    do {
+        current = this->usage.get();
+        update = delta > current ? 0 : current - delta;
+    } while (!this->usage.compareAndSet(current, update));
+
+    signalNextWaiter();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-bool MemoryUsage::isFull() const {
-    bool result = false;
+void MemoryUsage::setUsage(unsigned long long usage) {
+    this->usage.set(toUsage(usage));
+    signalNextWaiter();
+}
 
-    synchronized(&mutex) {
-        result = this->usage >= this->limit;
-    }
+////////////////////////////////////////////////////////////////////////////////
+void MemoryUsage::setLimit(unsigned long long limit) {
+    this->limit = limit;
+    signalNextWaiter();
+}
 
-    return result;
+////////////////////////////////////////////////////////////////////////////////
+bool MemoryUsage::isFull() const {
+    return (unsigned long long) this->usage.get() >= this->limit;
 }
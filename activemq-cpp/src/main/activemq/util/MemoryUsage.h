@@ -20,23 +20,55 @@
 
 #include <activemq/util/Config.h>
 #include <activemq/util/Usage.h>
+#include <activemq/metrics/Counter.h>
 #include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+
+#include <list>
 
 namespace activemq {
 namespace util {
 
+    /**
+     * A Usage that tracks the number of bytes in use against a fixed limit, used as the
+     * send window of a Producer.
+     *
+     * The usage is held in an atomic counter so that increasing and decreasing it never
+     * takes a lock.  Threads that wait for space queue up in arrival order and a release
+     * of space wakes only the longest waiting thread, the next increase of the usage then
+     * wakes the following waiter if there is still space left.  The usage is tracked in
+     * 32 bits and saturates at Integer::MAX_VALUE which is larger than any window that
+     * can be configured on the wire.
+     */
     class AMQCPP_API MemoryUsage : public Usage {
     private:
 
+        class Waiter;
+
         // The physical limit of memory usage this object allows.
-        unsigned long long limit;
+        volatile unsigned long long limit;
 
         // Amount of memory currently used in.
-        unsigned long long usage;
+        decaf::util::concurrent::atomic::AtomicInteger usage;
+
+        // Number of threads currently queued waiting for space.
+        decaf::util::concurrent::atomic::AtomicInteger waiting;
+
+        // Threads waiting for space in the order they arrived, guarded by mutex.
+        std::list<Waiter*> waiters;
 
-        // Mutex to lock usage and wait on.
+        // Mutex to lock the waiters list.
         mutable decaf::util::concurrent::Mutex mutex;
 
+        // The number of times a thread had to wait for space and the total microseconds spent waiting.
+        activemq::metrics::Counter blockedCount;
+        activemq::metrics::Counter blockedTime;
+
+    private:
+
+        MemoryUsage(const MemoryUsage&);
+        MemoryUsage& operator=(const MemoryUsage&);
+
     public:
 
         /**
@@ -74,6 +106,17 @@ namespace util {
             increaseUsage(value);
         }
 
+        /**
+         * Increases the usage by the value amount only if that can be done without waiting,
+         * the usage is left unchanged if this object is full or if other threads are already
+         * queued waiting for space.
+         *
+         * @param value Amount of usage in bytes to add.
+         *
+         * @return true if the usage was increased.
+         */
+        bool tryEnqueueUsage(unsigned long long value);
+
         /**
          * Increases the usage by the value amount
          * @param value Amount of usage to add.
@@ -91,21 +134,33 @@ namespace util {
          */
         virtual bool isFull() const;
 
+        /**
+         * Wakes the longest waiting thread if there is space available.  A thread that
+         * has been woken from waitForSpace and then doesn't increase the usage should call
+         * this so that the threads queued behind it are not left waiting.
+         */
+        void signalNextWaiter();
+
+        /**
+         * @return true if there are threads queued waiting for space.
+         */
+        bool hasWaiters() const {
+            return this->waiting.get() > 0;
+        }
+
         /**
          * Gets the current usage amount.
          * @return the amount of bytes currently used.
          */
         unsigned long long getUsage() const {
-            return usage;
+            return (unsigned long long) this->usage.get();
         }
 
         /**
          * Sets the current usage amount
          * @param usage - The amount to tag as used.
          */
-        void setUsage(unsigned long long usage) {
-            this->usage = usage;
-        }
+        void setUsage(unsigned long long usage);
 
         /**
          * Gets the current limit amount.
@@ -119,10 +174,26 @@ namespace util {
          * Sets the current limit amount
          * @param limit - The amount that can be used before full.
          */
-        void setLimit(unsigned long long limit) {
-            this->limit = limit;
+        void setLimit(unsigned long long limit);
+
+        /**
+         * @return the number of times a thread has had to wait for space.
+         */
+        long long getBlockedCount() const {
+            return this->blockedCount.get();
         }
 
+        /**
+         * @return the total time in microseconds that threads have spent waiting for space.
+         */
+        long long getBlockedTime() const {
+            return this->blockedTime.get();
+        }
+
+    private:
+
+        bool removeWaiter(Waiter* waiter);
+
     };
 
 }}
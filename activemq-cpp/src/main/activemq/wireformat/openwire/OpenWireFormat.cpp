@@ -22,16 +22,19 @@
 #include <decaf/lang/Long.h>
 #include <decaf/util/UUID.h>
 #include <decaf/lang/Math.h>
-#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/util/concurrent/Concurrent.h>
 #include <activemq/wireformat/openwire/OpenWireFormatNegotiator.h>
 #include <activemq/wireformat/openwire/utils/BooleanStream.h>
 #include <activemq/wireformat/MarshalAware.h>
 #include <activemq/commands/WireFormatInfo.h>
+#include <activemq/commands/Message.h>
 #include <activemq/commands/DataStructure.h>
 #include <activemq/wireformat/openwire/marshal/DataStreamMarshaller.h>
 #include <activemq/wireformat/openwire/marshal/generated/MarshallerFactory.h>
 #include <activemq/exceptions/ActiveMQException.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace activemq;
 using namespace activemq::util;
@@ -47,6 +50,69 @@ using namespace decaf::util;
 using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
 
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // Marks the wire format as receiving for the duration of an unmarshal.
+    class ReceivingScope {
+    private:
+
+        decaf::util::concurrent::atomic::AtomicBoolean* state;
+
+    private:
+
+        ReceivingScope(const ReceivingScope&);
+        ReceivingScope& operator=(const ReceivingScope&);
+
+    public:
+
+        ReceivingScope(decaf::util::concurrent::atomic::AtomicBoolean* state) : state(state) {
+            state->set(true);
+        }
+
+        ~ReceivingScope() {
+            state->set(false);
+        }
+    };
+
+    // Finds the two BaseCommand fields that differ between sends of the same Message in
+    // a frame written by marshal, the responseRequired flag is the first bit of the
+    // BooleanStream when tight encoded and the byte after the commandId when loose.
+    void locateCommandFields(const std::vector<unsigned char>& frame, bool tight, bool sizePrefix,
+                             int& flagOffset, int& commandIdOffset) {
+
+        int length = (int) frame.size();
+        int pos = (sizePrefix ? 4 : 0) + 1;
+
+        if (tight) {
+
+            int limit = 0;
+            int header = 1;
+
+            if (pos + 3 <= length) {
+                limit = frame[pos] & 0xFF;
+                if (limit == 0xC0) {
+                    limit = frame[pos + 1];
+                    header = 2;
+                } else if (limit == 0x80) {
+                    limit = (frame[pos + 1] << 8) | frame[pos + 2];
+                    header = 3;
+                }
+            }
+
+            flagOffset = limit > 0 ? pos + header : length;
+            commandIdOffset = pos + header + limit;
+        } else {
+            commandIdOffset = pos;
+            flagOffset = pos + 4;
+        }
+
+        if (flagOffset >= length || commandIdOffset + 4 > length) {
+            throw IOException(__FILE__, __LINE__, "OpenWireFormat::marshal - Cached Message frame is corrupt");
+        }
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 const unsigned char OpenWireFormat::NULL_TYPE = 0;
 const int OpenWireFormat::DEFAULT_VERSION = 1;
@@ -55,9 +121,14 @@ const int OpenWireFormat::MAX_SUPPORTED_VERSION = 9;
 ////////////////////////////////////////////////////////////////////////////////
 OpenWireFormat::OpenWireFormat(const decaf::util::Properties& properties) :
     properties(properties), preferedWireFormatInfo(), dataMarshallers(256),
-    id(UUID::randomUUID().toString()), receiving(), version(0), stackTraceEnabled(true),
+    id(UUID::randomUUID().toString()), receiving(), frameBuffer(), frameOut(&frameBuffer), version(0), stackTraceEnabled(true),
     tcpNoDelayEnabled(true), cacheEnabled(true), cacheSize(1024), tightEncodingEnabled(false),
-    sizePrefixDisabled(false), maxInactivityDuration(30000), maxInactivityDurationInitialDelay(10000) {
+    sizePrefixDisabled(false), maxInactivityDuration(30000), maxInactivityDurationInitialDelay(10000),
+    cacheMarshaledMessages(false), lastConnectionKey() {
+
+    // Arrays larger than the buffer memory kept between frames, in practice message
+    // bodies, are written to the transport from where they are rather than copied.
+    this->frameBuffer.setReferenceThreshold(FrameOutputStream::DEFAULT_RETAINED_CAPACITY);
 
     // initialize the universal marshalers, don't need to reset them again
     // after this so its safe to do this here.
@@ -158,49 +229,101 @@ void OpenWireFormat::marshal(const Pointer<commands::Command> command, const act
                 throw IOException(__FILE__, __LINE__, (string("OpenWireFormat::marshal - Unknown data type: ") + Integer::toString(type)).c_str());
             }
 
-            if (tightEncodingEnabled) {
-                BooleanStream bs;
-                size += dsm->tightMarshal1(this, dataStructure, &bs);
-                size += bs.marshalledSize();
+            // A Message that is sent again unchanged reuses the frame it was last
+            // marshaled into, frames written without a size prefix in the loose
+            // encoding never pass through the frame buffer and aren't cached.
+            Message* message = NULL;
+            int cacheKey = 0;
 
-                if (!sizePrefixDisabled) {
-                    dataOut->writeInt(size);
-                }
+            if (cacheMarshaledMessages && command->isMessage() && (tightEncodingEnabled || !sizePrefixDisabled)) {
+                message = dynamic_cast<Message*>(dataStructure);
+                cacheKey = (version << 3) | (tightEncodingEnabled ? 4 : 0) | (sizePrefixDisabled ? 2 : 0) | 1;
+            }
 
-                dataOut->writeByte(type);
-                bs.marshal(dataOut);
-                dsm->tightMarshal2(this, dataStructure, dataOut, &bs);
+            // Frames are assembled in the reusable frame buffer and handed to the
+            // transport in one write, large arrays are referenced rather than copied and
+            // when that is disabled the buffer is bypassed for large tight frames.
+            synchronized(&frameBuffer) {
 
-            } else {
+                frameBuffer.reset();
 
-                if (sizePrefixDisabled) {
-                    dataOut->writeByte(type);
-                    dsm->looseMarshal(this, dataStructure, dataOut);
-                } else {
+                if (message != NULL && message->hasCachedWireForm(cacheKey)) {
 
-                    ByteArrayOutputStream* baos = new ByteArrayOutputStream();
-                    std::auto_ptr<DataOutputStream> looseOut(new DataOutputStream(baos, true));
+                    const std::vector<unsigned char>& cached = message->getCachedWireForm();
 
-                    looseOut->writeByte(type);
-                    dsm->looseMarshal(this, dataStructure, looseOut.get());
-                    looseOut->close();
+                    int flagOffset = 0;
+                    int commandIdOffset = 0;
+                    locateCommandFields(cached, tightEncodingEnabled, !sizePrefixDisabled, flagOffset, commandIdOffset);
 
-                    // Now the data goes to the transport from out byte buffer.
-                    dataOut->writeInt((int) baos->size());
+                    // Copied rather than written so a large frame isn't held by reference
+                    // and its fields can be patched in the buffer.
+                    int offset = frameBuffer.reserve((int) cached.size());
+                    std::copy(cached.begin(), cached.end(), frameBuffer.getBuffer() + offset);
+                    frameBuffer.patchInt(commandIdOffset, command->getCommandId());
 
-                    if (baos->size() > 0) {
-                        std::pair<unsigned char*, int> array = baos->toByteArray();
+                    unsigned char* flag = frameBuffer.getBuffer() + flagOffset;
+                    if (tightEncodingEnabled) {
+                        *flag = (unsigned char) ((*flag & 0xFE) | (command->isResponseRequired() ? 1 : 0));
+                    } else {
+                        *flag = (unsigned char) (command->isResponseRequired() ? 1 : 0);
+                    }
 
-                        try {
-                            dataOut->write(array.first, array.second);
-                        } catch (Exception& ex) {
-                            delete[] array.first;
-                            throw;
-                        }
+                    frameBuffer.writeTo(dataOut);
+                    message = NULL;
+
+                } else if (tightEncodingEnabled) {
+                    BooleanStream bs;
+                    size += dsm->tightMarshal1(this, dataStructure, &bs);
+                    size += bs.marshalledSize();
+
+                    int frameSize = (sizePrefixDisabled ? 0 : 4) + size;
+                    DataOutputStream* out = dataOut;
+
+                    if (frameSize <= frameBuffer.getRetainedCapacity()) {
+                        // Sized once from the first pass so the second never reallocates.
+                        frameBuffer.ensureCapacity(frameSize);
+                        out = &frameOut;
+                    } else if (frameBuffer.getReferenceThreshold() > 0) {
+                        // The large arrays of the frame are only referenced so just the
+                        // small fields around them are copied.
+                        out = &frameOut;
+                    }
 
-                        delete[] array.first;
+                    if (!sizePrefixDisabled) {
+                        out->writeInt(size);
                     }
+
+                    out->writeByte(type);
+                    bs.marshal(out);
+                    dsm->tightMarshal2(this, dataStructure, out, &bs);
+
+                    if (out == &frameOut) {
+                        frameBuffer.writeTo(dataOut);
+                    }
+                } else if (sizePrefixDisabled) {
+                    dataOut->writeByte(type);
+                    dsm->looseMarshal(this, dataStructure, dataOut);
+                } else {
+
+                    // The size isn't known until the command has been written so the
+                    // prefix is reserved and filled in afterwards.
+                    int sizeOffset = frameBuffer.reserve(4);
+
+                    frameOut.writeByte(type);
+                    dsm->looseMarshal(this, dataStructure, &frameOut);
+
+                    frameBuffer.patchInt(sizeOffset, frameBuffer.size() - 4);
+                    frameBuffer.writeTo(dataOut);
                 }
+
+                // Stored last since marshaling goes through the non-const getters,
+                // which discard any frame the Message already holds.  Frames that
+                // reference their body would need the copy the reference avoided.
+                if (message != NULL && frameBuffer.size() > 0 && !frameBuffer.hasReferences()) {
+                    message->setCachedWireForm(cacheKey, frameBuffer.getBuffer(), frameBuffer.size());
+                }
+
+                frameBuffer.reset();
             }
         } else {
             dataOut->writeInt(size);
@@ -222,12 +345,14 @@ Pointer<commands::Command> OpenWireFormat::unmarshal(const activemq::transport::
             throw decaf::io::IOException(__FILE__, __LINE__, "DataInputStream passed is NULL");
         }
 
+        Pointer<DataStructure> data;
+
         if (!sizePrefixDisabled) {
             dis->readInt();
         }
 
         // Get the unmarshalled DataStructure
-        Pointer<DataStructure> data(doUnmarshal(dis));
+        data.reset(doUnmarshal(dis));
 
         if (data == NULL) {
             throw IOException(__FILE__, __LINE__, "OpenWireFormat::doUnmarshal - "
@@ -252,28 +377,7 @@ commands::DataStructure* OpenWireFormat::doUnmarshal(DataInputStream* dis) {
 
     try {
 
-        class Finally {
-        private:
-
-            decaf::util::concurrent::atomic::AtomicBoolean* state;
-
-        private:
-
-            Finally(const Finally&);
-            Finally& operator=(const Finally&);
-
-        public:
-
-            Finally(decaf::util::concurrent::atomic::AtomicBoolean* state) : state(state) {
-                state->set(true);
-            }
-
-            ~Finally() {
-                state->set(false);
-            }
-        }
-
-        finalizer(&(this->receiving));
+        ReceivingScope scope(&(this->receiving));
 
         unsigned char dataType = dis->readByte();
 
@@ -308,6 +412,7 @@ commands::DataStructure* OpenWireFormat::doUnmarshal(DataInputStream* dis) {
     AMQ_CATCHALL_THROW(IOException)
 }
 
+
 ////////////////////////////////////////////////////////////////////////////////
 int OpenWireFormat::tightMarshalNestedObject1(commands::DataStructure* object, utils::BooleanStream* bs) {
 
@@ -477,6 +582,20 @@ void OpenWireFormat::looseMarshalNestedObject(commands::DataStructure* o, decaf:
     AMQ_CATCHALL_THROW(IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+activemq::util::ConnectionKey OpenWireFormat::internConnectionId(const std::string& connectionId) {
+
+    if (this->lastConnectionKey == NULL || this->lastConnectionKey->getConnectionId() != connectionId) {
+        if (connectionId.empty()) {
+            return activemq::util::ConnectionKey();
+        }
+
+        this->lastConnectionKey = activemq::util::ConnectionIdTable::intern(connectionId);
+    }
+
+    return this->lastConnectionKey;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void OpenWireFormat::renegotiateWireFormat(const WireFormatInfo& info) {
 
@@ -21,8 +21,11 @@
 #include <activemq/util/Config.h>
 #include <activemq/commands/WireFormatInfo.h>
 #include <activemq/commands/DataStructure.h>
+#include <activemq/util/ConnectionIdTable.h>
 #include <activemq/wireformat/WireFormat.h>
 #include <activemq/wireformat/openwire/utils/BooleanStream.h>
+#include <activemq/wireformat/openwire/utils/FrameOutputStream.h>
+#include <decaf/io/DataOutputStream.h>
 #include <decaf/lang/Pointer.h>
 #include <decaf/util/Properties.h>
 #include <decaf/util/concurrent/atomic/AtomicBoolean.h>
@@ -69,6 +72,10 @@ namespace marshal {
         // Indicates when we are in the doUnmarshal call
         decaf::util::concurrent::atomic::AtomicBoolean receiving;
 
+        // Outgoing frames are assembled here, reused between calls to marshal
+        utils::FrameOutputStream frameBuffer;
+        decaf::io::DataOutputStream frameOut;
+
         // WireFormat Data
         int version;
         bool stackTraceEnabled;
@@ -80,6 +87,12 @@ namespace marshal {
         long long maxInactivityDuration;
         long long maxInactivityDurationInitialDelay;
 
+        // Local option, Messages keep the frame they were marshaled into for resends
+        bool cacheMarshaledMessages;
+
+        // The connection id last interned while unmarshaling, see internConnectionId
+        activemq::util::ConnectionKey lastConnectionKey;
+
     public:
 
         /**
@@ -173,6 +186,19 @@ namespace marshal {
          */
         void looseMarshalNestedObject(commands::DataStructure* o, decaf::io::DataOutputStream* dataOut);
 
+        /**
+         * Interns a connection id read by the marshalers.  Nearly every id read from a
+         * connection carries the same connection id, so the last key is reused when the
+         * string matches and the ConnectionIdTable is only consulted when it changes.
+         * Only called while unmarshaling, which a Transport does from a single thread.
+         *
+         * @param connectionId
+         *      The connection id string that was read.
+         *
+         * @return the interned key, or a NULL key if the id is empty.
+         */
+        activemq::util::ConnectionKey internConnectionId(const std::string& connectionId);
+
         /**
          * Called to re-negotiate the settings for the WireFormatInfo, these
          * determine how the client and broker communicate.
@@ -357,6 +383,51 @@ namespace marshal {
             this->maxInactivityDurationInitialDelay = value;
         }
 
+        /**
+         * Gets the size from which an array in a frame, such as a message body, is passed
+         * to the transport by reference in a gathering write instead of being copied.
+         *
+         * @return the zero copy threshold in bytes, zero when every array is copied.
+         */
+        int getZeroCopyThreshold() const {
+            return this->frameBuffer.getReferenceThreshold();
+        }
+
+        /**
+         * Sets the size from which an array in a frame, such as a message body, is passed
+         * to the transport by reference in a gathering write instead of being copied.  This
+         * is a local option that is not negotiated with the broker.
+         *
+         * @param value - the zero copy threshold in bytes, zero to copy every array.
+         *
+         * @throws IllegalArgumentException if the value is negative.
+         */
+        void setZeroCopyThreshold(int value) {
+            this->frameBuffer.setReferenceThreshold(value);
+        }
+
+        /**
+         * Checks if Messages keep the frame they are marshaled into so that sending the
+         * same Message again, as happens when messages are replayed after a failover,
+         * copies the frame and only updates its command id and response required flag.
+         *
+         * @return true if marshaled Messages are cached.
+         */
+        bool isCacheMarshaledMessages() const {
+            return this->cacheMarshaledMessages;
+        }
+
+        /**
+         * Sets if Messages keep the frame they are marshaled into, this is a local option
+         * that is not negotiated with the broker.  Any change to a Message through its
+         * setters drops the cached frame.
+         *
+         * @param value - true to cache the frames of marshaled Messages.
+         */
+        void setCacheMarshaledMessages(bool value) {
+            this->cacheMarshaledMessages = value;
+        }
+
     protected:
 
         /**
@@ -68,6 +68,13 @@ Pointer<WireFormat> OpenWireFormatFactory::createWireFormat(const decaf::util::P
         // give the format object the ownership
         wireFormat->setPreferedWireFormatInfo(info);
 
+        // Local options that aren't negotiated with the broker
+        wireFormat->setCacheMarshaledMessages(
+            Boolean::parseBoolean(properties.getProperty("wireFormat.cacheMarshaledMessages", "false")));
+        wireFormat->setZeroCopyThreshold(
+            Integer::parseInt(properties.getProperty("wireFormat.zeroCopyThreshold",
+                Integer::toString(utils::FrameOutputStream::DEFAULT_RETAINED_CAPACITY))));
+
         return wireFormat;
     }
     AMQ_CATCH_RETHROW(IllegalStateException)
@@ -48,6 +48,8 @@ namespace openwire{
          * wireFormat.sizePrefixDisabled
          * wireFormat.maxInactivityDuration
          * wireFormat.maxInactivityDurationInitialDelay
+         * wireFormat.cacheMarshaledMessages
+         * wireFormat.zeroCopyThreshold
          */
         OpenWireFormatFactory() {}
 
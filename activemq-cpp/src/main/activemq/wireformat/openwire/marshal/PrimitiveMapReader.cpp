@@ -0,0 +1,234 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PrimitiveMapReader.h"
+
+#include <activemq/wireformat/openwire/marshal/PrimitiveTypesMarshaller.h>
+#include <activemq/wireformat/openwire/utils/ByteCursor.h>
+#include <activemq/exceptions/ActiveMQException.h>
+#include <decaf/util/NoSuchElementException.h>
+
+#include <algorithm>
+#include <string.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::util;
+using namespace activemq::exceptions;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace activemq::wireformat::openwire::marshal;
+using namespace activemq::wireformat::openwire::utils;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::util;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    int compareBytes(const unsigned char* left, int leftLength, const unsigned char* right, int rightLength) {
+        int result = ::memcmp(left, right, std::min(leftLength, rightLength));
+        return result != 0 ? result : leftLength - rightLength;
+    }
+
+    // Produces the same bytes that DataOutputStream::writeUTF would write for the key so
+    // that it can be compared with the encoded keys in place.
+    std::string encodeKey(const std::string& key) {
+
+        std::string result;
+        result.reserve(key.size());
+
+        for (std::string::const_iterator iter = key.begin(); iter != key.end(); ++iter) {
+            unsigned int value = (unsigned char) *iter;
+            if (value > 0 && value <= 127) {
+                result.push_back((char) value);
+            } else {
+                result.push_back((char) (0xC0 | (0x1F & (value >> 6))));
+                result.push_back((char) (0x80 | (0x3F & value)));
+            }
+        }
+
+        return result;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+class PrimitiveMapReader::EntryComparator {
+private:
+
+    const unsigned char* buffer;
+
+public:
+
+    EntryComparator(const unsigned char* buffer) : buffer(buffer) {}
+
+    bool operator()(const Entry& left, const Entry& right) const {
+        return compareBytes(buffer + left.keyOffset, left.keyLength,
+                            buffer + right.keyOffset, right.keyLength) < 0;
+    }
+
+    bool operator()(const Entry& left, const std::string& right) const {
+        return compareBytes(buffer + left.keyOffset, left.keyLength,
+                            (const unsigned char*) right.data(), (int) right.size()) < 0;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+PrimitiveMapReader::PrimitiveMapReader(const unsigned char* buffer, int length) :
+    buffer(buffer), length(length), entries() {
+
+    try {
+
+        ByteCursor cursor(buffer, length);
+
+        int count = cursor.readInt();
+        if (count > 0) {
+
+            // Every entry takes at least three bytes, don't trust a corrupt count any further.
+            this->entries.reserve(std::min(count, cursor.remaining() / 3));
+
+            for (int i = 0; i < count; ++i) {
+                Entry entry;
+                entry.keyLength = cursor.readUnsignedShort();
+                entry.keyOffset = cursor.getPosition();
+                cursor.skip(entry.keyLength);
+                entry.valueOffset = cursor.getPosition();
+                PrimitiveTypesMarshaller::skipPrimitive(cursor);
+                this->entries.push_back(entry);
+            }
+        }
+
+        EntryComparator comparator(buffer);
+        std::stable_sort(this->entries.begin(), this->entries.end(), comparator);
+
+        // A fully unmarshaled map keeps the last value written for a key, the stable sort
+        // leaves that one at the end of its run of equal keys.
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < this->entries.size(); ++i) {
+            if (i + 1 < this->entries.size() && !comparator(this->entries[i], this->entries[i + 1])) {
+                continue;
+            }
+            this->entries[kept++] = this->entries[i];
+        }
+        this->entries.resize(kept);
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PrimitiveMapReader::~PrimitiveMapReader() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const PrimitiveMapReader::Entry* PrimitiveMapReader::find(const std::string& key) const {
+
+    std::string encoded = encodeKey(key);
+
+    std::vector<Entry>::const_iterator iter =
+        std::lower_bound(this->entries.begin(), this->entries.end(), encoded, EntryComparator(this->buffer));
+
+    if (iter == this->entries.end() ||
+        compareBytes(this->buffer + iter->keyOffset, iter->keyLength,
+                     (const unsigned char*) encoded.data(), (int) encoded.size()) != 0) {
+
+        return NULL;
+    }
+
+    return &(*iter);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool PrimitiveMapReader::containsKey(const std::string& key) const {
+    return find(key) != NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<std::string> PrimitiveMapReader::keySet() const {
+
+    try {
+
+        std::vector<std::string> keys;
+        keys.reserve(this->entries.size());
+
+        ByteCursor cursor(this->buffer, this->length);
+
+        std::vector<Entry>::const_iterator iter = this->entries.begin();
+        for (; iter != this->entries.end(); ++iter) {
+            cursor.setPosition(iter->keyOffset - 2);
+            keys.push_back(cursor.readUTF());
+        }
+
+        std::sort(keys.begin(), keys.end());
+
+        return keys;
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PrimitiveValueNode::PrimitiveType PrimitiveMapReader::getValueType(const std::string& key) const {
+
+    const Entry* entry = find(key);
+    if (entry == NULL) {
+        throw NoSuchElementException(__FILE__, __LINE__, "Key does not exist in map");
+    }
+
+    try {
+
+        ByteCursor cursor(this->buffer, this->length);
+        cursor.setPosition(entry->valueOffset);
+
+        unsigned char type = cursor.readByte();
+
+        // An empty string unmarshals to a null value and a big string to a plain one.
+        if (type == PrimitiveValueNode::STRING_TYPE) {
+            return cursor.readShort() > 0 ? PrimitiveValueNode::STRING_TYPE : PrimitiveValueNode::NULL_TYPE;
+        } else if (type == PrimitiveValueNode::BIG_STRING_TYPE) {
+            return cursor.readInt() > 0 ? PrimitiveValueNode::STRING_TYPE : PrimitiveValueNode::NULL_TYPE;
+        }
+
+        return (PrimitiveValueNode::PrimitiveType) type;
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PrimitiveValueNode PrimitiveMapReader::get(const std::string& key) const {
+
+    const Entry* entry = find(key);
+    if (entry == NULL) {
+        throw NoSuchElementException(__FILE__, __LINE__, "Key does not exist in map");
+    }
+
+    try {
+
+        ByteCursor cursor(this->buffer, this->length);
+        cursor.setPosition(entry->valueOffset);
+
+        return PrimitiveTypesMarshaller::unmarshalPrimitive(cursor);
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
@@ -0,0 +1,161 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_WIREFORMAT_OPENWIRE_MARSHAL_PRIMITIVEMAPREADER_H_
+#define _ACTIVEMQ_WIREFORMAT_OPENWIRE_MARSHAL_PRIMITIVEMAPREADER_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/util/PrimitiveValueNode.h>
+
+#include <string>
+#include <vector>
+
+namespace activemq {
+namespace wireformat {
+namespace openwire {
+namespace marshal {
+
+    /**
+     * Provides read access to a PrimitiveMap that is still in its marshaled form.  A single
+     * pass over the buffer records where each entry's key and value start, a value is then
+     * only decoded when it is asked for so a consumer that reads a few entries of a large
+     * map never pays to decode the rest of it.
+     *
+     * The entries are kept sorted by the bytes of their encoded keys so that a lookup is a
+     * binary search that needs no decoded copy of the keys, when a key appears more than
+     * once the last value wins just as it does when the map is fully unmarshaled.
+     *
+     * The reader never owns the buffer it reads from, the caller must ensure that the
+     * buffer remains valid and unchanged for the lifetime of the reader.
+     *
+     * @since 3.8
+     */
+    class AMQCPP_API PrimitiveMapReader {
+    private:
+
+        struct Entry {
+            int keyOffset;
+            int keyLength;
+            int valueOffset;
+        };
+
+        class EntryComparator;
+
+        const unsigned char* buffer;
+        int length;
+        std::vector<Entry> entries;
+
+    private:
+
+        PrimitiveMapReader(const PrimitiveMapReader&);
+        PrimitiveMapReader& operator=(const PrimitiveMapReader&);
+
+    public:
+
+        /**
+         * Creates a new reader and indexes the entries of the map marshaled in the given
+         * buffer, none of the values are decoded.
+         *
+         * @param buffer
+         *      The buffer holding a map in the format written by PrimitiveTypesMarshaller.
+         * @param length
+         *      The number of valid bytes in the buffer.
+         *
+         * @throws IOException if the encoded map is invalid or runs past the end of the buffer.
+         */
+        PrimitiveMapReader(const unsigned char* buffer, int length);
+
+        ~PrimitiveMapReader();
+
+        /**
+         * @return the buffer this reader was created over.
+         */
+        const unsigned char* getBuffer() const {
+            return this->buffer;
+        }
+
+        /**
+         * @return the number of valid bytes in the buffer this reader was created over.
+         */
+        int getLength() const {
+            return this->length;
+        }
+
+        /**
+         * @return the number of distinct keys in the map.
+         */
+        int size() const {
+            return (int) this->entries.size();
+        }
+
+        /**
+         * @return true if the map has no entries.
+         */
+        bool isEmpty() const {
+            return this->entries.empty();
+        }
+
+        /**
+         * @return true if the map has an entry with the given key.
+         */
+        bool containsKey(const std::string& key) const;
+
+        /**
+         * Decodes each of the keys in the map, the values are not touched.
+         *
+         * @return the keys of the map in sorted order.
+         *
+         * @throws IOException if a key is not validly encoded.
+         */
+        std::vector<std::string> keySet() const;
+
+        /**
+         * Returns the type of the value stored under the given key, reading only as much of
+         * the value as is needed to determine the type the fully unmarshaled map would report.
+         *
+         * @param key
+         *      The key of the value whose type is wanted.
+         *
+         * @return the type of the value.
+         *
+         * @throws NoSuchElementException if the map has no entry with the given key.
+         * @throws IOException if the value is not validly encoded.
+         */
+        util::PrimitiveValueNode::PrimitiveType getValueType(const std::string& key) const;
+
+        /**
+         * Decodes the value stored under the given key.
+         *
+         * @param key
+         *      The key of the value to decode.
+         *
+         * @return a PrimitiveValueNode holding the decoded value.
+         *
+         * @throws NoSuchElementException if the map has no entry with the given key.
+         * @throws IOException if the value is not validly encoded.
+         */
+        util::PrimitiveValueNode get(const std::string& key) const;
+
+    private:
+
+        const Entry* find(const std::string& key) const;
+
+    };
+
+}}}}
+
+#endif /* _ACTIVEMQ_WIREFORMAT_OPENWIRE_MARSHAL_PRIMITIVEMAPREADER_H_ */
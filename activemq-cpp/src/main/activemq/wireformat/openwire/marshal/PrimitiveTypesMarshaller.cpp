@@ -33,6 +33,7 @@ using namespace activemq::exceptions;
 using namespace activemq::wireformat;
 using namespace activemq::wireformat::openwire;
 using namespace activemq::wireformat::openwire::marshal;
+using namespace activemq::wireformat::openwire::utils;
 using namespace decaf;
 using namespace decaf::io;
 using namespace decaf::lang;
@@ -74,9 +75,8 @@ void PrimitiveTypesMarshaller::unmarshal( PrimitiveMap* map, const std::vector<u
         // Clear old data
         map->clear();
 
-        ByteArrayInputStream bytesIn( buffer );
-        DataInputStream dataIn( &bytesIn );
-        PrimitiveTypesMarshaller::unmarshalPrimitiveMap( dataIn, *map );
+        ByteCursor cursor( &buffer[0], (int)buffer.size() );
+        PrimitiveTypesMarshaller::unmarshalPrimitiveMap( cursor, *map );
     }
     AMQ_CATCH_RETHROW( decaf::lang::Exception )
     AMQ_CATCHALL_THROW( decaf::lang::Exception )
@@ -455,3 +455,203 @@ PrimitiveValueNode PrimitiveTypesMarshaller::unmarshalPrimitive( io::DataInputSt
     AMQ_CATCH_EXCEPTION_CONVERT( Exception, io::IOException )
     AMQ_CATCHALL_THROW( io::IOException )
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void PrimitiveTypesMarshaller::unmarshalPrimitiveMap( ByteCursor& cursor, PrimitiveMap& map ) {
+
+    try{
+
+        int size = cursor.readInt();
+
+        if( size > 0 ) {
+            for( int i=0; i < size; i++ ) {
+                std::string key = cursor.readUTF();
+                map.put( key, unmarshalPrimitive( cursor ) );
+            }
+        }
+    }
+    AMQ_CATCH_RETHROW( io::IOException )
+    AMQ_CATCH_EXCEPTION_CONVERT( Exception, io::IOException )
+    AMQ_CATCHALL_THROW( io::IOException )
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void PrimitiveTypesMarshaller::unmarshalPrimitiveList(
+    ByteCursor& cursor, decaf::util::LinkedList<PrimitiveValueNode>& list ) {
+
+    try{
+
+        int size = cursor.readInt();
+        while( size-- > 0 ) {
+            list.add( unmarshalPrimitive( cursor ) );
+        }
+    }
+    AMQ_CATCH_RETHROW( io::IOException )
+    AMQ_CATCH_EXCEPTION_CONVERT( Exception, io::IOException )
+    AMQ_CATCHALL_THROW( io::IOException )
+}
+
+///////////////////////////////////////////////////////////////////////////////
+PrimitiveValueNode PrimitiveTypesMarshaller::unmarshalPrimitive( ByteCursor& cursor ) {
+
+    try {
+
+        unsigned char type = cursor.readByte();
+
+        PrimitiveValueNode value;
+
+        switch( type ) {
+
+            case PrimitiveValueNode::NULL_TYPE:
+                value.clear();
+                break;
+            case PrimitiveValueNode::BYTE_TYPE:
+                value.setByte( cursor.readByte() );
+                break;
+            case PrimitiveValueNode::BOOLEAN_TYPE:
+                value.setBool( cursor.readBoolean() );
+                break;
+            case PrimitiveValueNode::CHAR_TYPE:
+                value.setChar( cursor.readChar() );
+                break;
+            case PrimitiveValueNode::SHORT_TYPE:
+                value.setShort( cursor.readShort() );
+                break;
+            case PrimitiveValueNode::INTEGER_TYPE:
+                value.setInt( cursor.readInt() );
+                break;
+            case PrimitiveValueNode::LONG_TYPE:
+                value.setLong( cursor.readLong() );
+                break;
+            case PrimitiveValueNode::FLOAT_TYPE:
+                value.setFloat( cursor.readFloat() );
+                break;
+            case PrimitiveValueNode::DOUBLE_TYPE:
+                value.setDouble( cursor.readDouble() );
+                break;
+            case PrimitiveValueNode::BYTE_ARRAY_TYPE:
+            {
+                int size = cursor.readInt();
+                std::vector<unsigned char> data;
+                if( size > 0 ) {
+                    data.resize( size );
+                    cursor.readBytes( &data[0], size );
+                }
+                value.setByteArray( data );
+                break;
+            }
+            case PrimitiveValueNode::STRING_TYPE:
+            case PrimitiveValueNode::BIG_STRING_TYPE:
+            {
+                int utfLength = type == PrimitiveValueNode::STRING_TYPE ?
+                    cursor.readShort() : cursor.readInt();
+
+                if( utfLength > 0 ) {
+                    std::string text( utfLength, '\0' );
+                    cursor.readBytes( (unsigned char*)&text[0], utfLength );
+                    value.setString( text );
+                }
+                break;
+            }
+            case PrimitiveValueNode::LIST_TYPE:
+            {
+                PrimitiveList list;
+                PrimitiveTypesMarshaller::unmarshalPrimitiveList( cursor, list );
+                value.setList( list );
+                break;
+            }
+            case PrimitiveValueNode::MAP_TYPE:
+            {
+                PrimitiveMap map;
+                PrimitiveTypesMarshaller::unmarshalPrimitiveMap( cursor, map );
+                value.setMap( map );
+                break;
+            }
+            default:
+                throw IOException(
+                    __FILE__,
+                    __LINE__,
+                    "PrimitiveTypesMarshaller::unmarshalPrimitive - "
+                    "Unsupported data type: %d", (int)type );
+        }
+
+        return value;
+    }
+    AMQ_CATCH_RETHROW( io::IOException )
+    AMQ_CATCH_EXCEPTION_CONVERT( Exception, io::IOException )
+    AMQ_CATCHALL_THROW( io::IOException )
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void PrimitiveTypesMarshaller::skipPrimitive( ByteCursor& cursor ) {
+
+    try {
+
+        unsigned char type = cursor.readByte();
+
+        switch( type ) {
+
+            case PrimitiveValueNode::NULL_TYPE:
+                break;
+            case PrimitiveValueNode::BYTE_TYPE:
+            case PrimitiveValueNode::BOOLEAN_TYPE:
+            case PrimitiveValueNode::CHAR_TYPE:
+                cursor.skip( 1 );
+                break;
+            case PrimitiveValueNode::SHORT_TYPE:
+                cursor.skip( 2 );
+                break;
+            case PrimitiveValueNode::INTEGER_TYPE:
+            case PrimitiveValueNode::FLOAT_TYPE:
+                cursor.skip( 4 );
+                break;
+            case PrimitiveValueNode::LONG_TYPE:
+            case PrimitiveValueNode::DOUBLE_TYPE:
+                cursor.skip( 8 );
+                break;
+            case PrimitiveValueNode::BYTE_ARRAY_TYPE:
+            case PrimitiveValueNode::BIG_STRING_TYPE:
+            {
+                int size = cursor.readInt();
+                if( size > 0 ) {
+                    cursor.skip( size );
+                }
+                break;
+            }
+            case PrimitiveValueNode::STRING_TYPE:
+            {
+                int utfLength = cursor.readShort();
+                if( utfLength > 0 ) {
+                    cursor.skip( utfLength );
+                }
+                break;
+            }
+            case PrimitiveValueNode::LIST_TYPE:
+            {
+                int size = cursor.readInt();
+                while( size-- > 0 ) {
+                    skipPrimitive( cursor );
+                }
+                break;
+            }
+            case PrimitiveValueNode::MAP_TYPE:
+            {
+                int size = cursor.readInt();
+                while( size-- > 0 ) {
+                    cursor.skip( cursor.readUnsignedShort() );
+                    skipPrimitive( cursor );
+                }
+                break;
+            }
+            default:
+                throw IOException(
+                    __FILE__,
+                    __LINE__,
+                    "PrimitiveTypesMarshaller::skipPrimitive - "
+                    "Unsupported data type: %d", (int)type );
+        }
+    }
+    AMQ_CATCH_RETHROW( io::IOException )
+    AMQ_CATCH_EXCEPTION_CONVERT( Exception, io::IOException )
+    AMQ_CATCHALL_THROW( io::IOException )
+}
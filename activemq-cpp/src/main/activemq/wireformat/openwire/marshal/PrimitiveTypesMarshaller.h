@@ -23,6 +23,7 @@
 #include <activemq/util/PrimitiveValueNode.h>
 #include <activemq/util/PrimitiveMap.h>
 #include <activemq/util/PrimitiveList.h>
+#include <activemq/wireformat/openwire/utils/ByteCursor.h>
 #include <decaf/io/DataOutputStream.h>
 #include <decaf/io/DataInputStream.h>
 #include <decaf/io/IOException.h>
@@ -142,6 +143,63 @@ namespace marshal{
          */
         static util::PrimitiveList* unmarshalList( decaf::io::DataInputStream& dataIn );
 
+    public:
+
+        /**
+         * Unmarshals a Map of Primitives directly from the bytes under the given cursor,
+         * this reads the same encoding as the DataInputStream based version without the
+         * stream layers in between.
+         *
+         * @param cursor - the cursor positioned at the start of the encoded map.
+         * @param map - the map to fill with data.
+         *
+         * @throws IOException if the encoding is invalid or runs past the end of the buffer.
+         */
+        static void unmarshalPrimitiveMap( utils::ByteCursor& cursor, util::PrimitiveMap& map );
+
+        /**
+         * Unmarshals a List of Primitives directly from the bytes under the given cursor.
+         *
+         * @param cursor - the cursor positioned at the start of the encoded list.
+         * @param list - the list to fill with data.
+         *
+         * @throws IOException if the encoding is invalid or runs past the end of the buffer.
+         */
+        static void unmarshalPrimitiveList(
+            utils::ByteCursor& cursor,
+            decaf::util::LinkedList<util::PrimitiveValueNode>& list );
+
+        /**
+         * Unmarshals a single type tagged Primitive directly from the bytes under the
+         * given cursor and returns it as a value Node.
+         *
+         * @param cursor - the cursor positioned at the type tag of the value.
+         * @return a PrimitiveValueNode containing the data.
+         *
+         * @throws IOException if the encoding is invalid or runs past the end of the buffer.
+         */
+        static util::PrimitiveValueNode unmarshalPrimitive( utils::ByteCursor& cursor );
+
+        /**
+         * Moves the cursor past a single type tagged Primitive without decoding it, nested
+         * lists and maps are walked but none of their contents are copied.
+         *
+         * @param cursor - the cursor positioned at the type tag of the value.
+         *
+         * @throws IOException if the encoding is invalid or runs past the end of the buffer.
+         */
+        static void skipPrimitive( utils::ByteCursor& cursor );
+
+        /**
+         * Used to Marshal the Primitive types out on the Wire.
+         * @param dataOut - the DataOutputStream to write to
+         * @param value - the ValueNode to write.
+         *
+         * @throws IOException if an I/O error occurs during this operation.
+         */
+        static void marshalPrimitive( decaf::io::DataOutputStream& dataOut,
+                                      const util::PrimitiveValueNode& value );
+
     protected:
 
         /**
@@ -169,16 +227,6 @@ namespace marshal{
             decaf::io::DataOutputStream& dataOut,
             const decaf::util::List<util::PrimitiveValueNode>& list );
 
-        /**
-         * Used to Marshal the Primitive types out on the Wire.
-         * @param dataOut - the DataOutputStream to write to
-         * @param value - the ValueNode to write.
-         *
-         * @throws IOException if an I/O error occurs during this operation.
-         */
-        static void marshalPrimitive( decaf::io::DataOutputStream& dataOut,
-                                      const util::PrimitiveValueNode& value );
-
         /**
          * Unmarshals a Map of Primitives from the given InputStream, can result
          * in recursive calls to this method if the map contains maps of maps.
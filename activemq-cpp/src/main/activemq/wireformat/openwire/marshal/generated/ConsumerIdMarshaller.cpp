@@ -59,7 +59,7 @@ void ConsumerIdMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataStruct
 
         ConsumerId* info =
             dynamic_cast<ConsumerId*>(dataStructure);
-        info->setConnectionId(tightUnmarshalString(dataIn, bs));
+        info->setConnectionKey(wireFormat->internConnectionId(tightUnmarshalString(dataIn, bs)));
         info->setSessionId(tightUnmarshalLong(wireFormat, dataIn, bs));
         info->setValue(tightUnmarshalLong(wireFormat, dataIn, bs));
     }
@@ -114,7 +114,7 @@ void ConsumerIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStruct
         BaseDataStreamMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         ConsumerId* info =
             dynamic_cast<ConsumerId*>(dataStructure);
-        info->setConnectionId(looseUnmarshalString(dataIn));
+        info->setConnectionKey(wireFormat->internConnectionId(looseUnmarshalString(dataIn)));
         info->setSessionId(looseUnmarshalLong(wireFormat, dataIn));
         info->setValue(looseUnmarshalLong(wireFormat, dataIn));
     }
@@ -149,8 +149,8 @@ int MessageMarshaller::tightMarshal1(OpenWireFormat* wireFormat, DataStructure*
         rc += tightMarshalNestedObject1(wireFormat, info->getReplyTo().get(), bs);
         rc += tightMarshalLong1(wireFormat, info->getTimestamp(), bs);
         rc += tightMarshalString1(info->getType(), bs);
-        bs->writeBoolean(info->getContent().size() != 0);
-        rc += info->getContent().size() == 0 ? 0 : (int)info->getContent().size() + 4;
+        bs->writeBoolean(info->getContentLength() != 0);
+        rc += info->getContentLength() == 0 ? 0 : info->getContentLength() + 4;
         bs->writeBoolean(info->getMarshalledProperties().size() != 0);
         rc += info->getMarshalledProperties().size() == 0 ? 0 : (int)info->getMarshalledProperties().size() + 4;
         rc += tightMarshalNestedObject1(wireFormat, info->getDataStructure().get(), bs);
@@ -208,8 +208,8 @@ void MessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStructure*
         tightMarshalLong2(wireFormat, info->getTimestamp(), dataOut, bs);
         tightMarshalString2(info->getType(), dataOut, bs);
         if (bs->readBoolean()) {
-            dataOut->writeInt((int)info->getContent().size() );
-            dataOut->write((const unsigned char*)(&info->getContent()[0]), (int)info->getContent().size(), 0, (int)info->getContent().size());
+            dataOut->writeInt(info->getContentLength());
+            dataOut->write(info->getContentBytes(), info->getContentLength(), 0, info->getContentLength());
         }
         if (bs->readBoolean()) {
             dataOut->writeInt((int)info->getMarshalledProperties().size() );
@@ -350,10 +350,10 @@ void MessageMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataStructure*
         looseMarshalNestedObject(wireFormat, info->getReplyTo().get(), dataOut);
         looseMarshalLong(wireFormat, info->getTimestamp(), dataOut);
         looseMarshalString(info->getType(), dataOut);
-        dataOut->write( info->getContent().size() != 0 );
-        if( info->getContent().size() != 0 ) {
-            dataOut->writeInt( (int)info->getContent().size() );
-            dataOut->write((const unsigned char*)(&info->getContent()[0]), (int)info->getContent().size(), 0, (int)info->getContent().size());
+        dataOut->write( info->getContentLength() != 0 );
+        if( info->getContentLength() != 0 ) {
+            dataOut->writeInt( info->getContentLength() );
+            dataOut->write(info->getContentBytes(), info->getContentLength(), 0, info->getContentLength());
         }
         dataOut->write( info->getMarshalledProperties().size() != 0 );
         if( info->getMarshalledProperties().size() != 0 ) {
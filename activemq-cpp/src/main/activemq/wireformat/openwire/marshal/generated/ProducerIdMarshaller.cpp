@@ -59,7 +59,7 @@ void ProducerIdMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataStruct
 
         ProducerId* info =
             dynamic_cast<ProducerId*>(dataStructure);
-        info->setConnectionId(tightUnmarshalString(dataIn, bs));
+        info->setConnectionKey(wireFormat->internConnectionId(tightUnmarshalString(dataIn, bs)));
         info->setValue(tightUnmarshalLong(wireFormat, dataIn, bs));
         info->setSessionId(tightUnmarshalLong(wireFormat, dataIn, bs));
     }
@@ -114,7 +114,7 @@ void ProducerIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStruct
         BaseDataStreamMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         ProducerId* info =
             dynamic_cast<ProducerId*>(dataStructure);
-        info->setConnectionId(looseUnmarshalString(dataIn));
+        info->setConnectionKey(wireFormat->internConnectionId(looseUnmarshalString(dataIn)));
         info->setValue(looseUnmarshalLong(wireFormat, dataIn));
         info->setSessionId(looseUnmarshalLong(wireFormat, dataIn));
     }
@@ -59,7 +59,7 @@ void SessionIdMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataStructu
 
         SessionId* info =
             dynamic_cast<SessionId*>(dataStructure);
-        info->setConnectionId(tightUnmarshalString(dataIn, bs));
+        info->setConnectionKey(wireFormat->internConnectionId(tightUnmarshalString(dataIn, bs)));
         info->setValue(tightUnmarshalLong(wireFormat, dataIn, bs));
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
@@ -111,7 +111,7 @@ void SessionIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructu
         BaseDataStreamMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         SessionId* info =
             dynamic_cast<SessionId*>(dataStructure);
-        info->setConnectionId(looseUnmarshalString(dataIn));
+        info->setConnectionKey(wireFormat->internConnectionId(looseUnmarshalString(dataIn)));
         info->setValue(looseUnmarshalLong(wireFormat, dataIn));
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
@@ -40,56 +40,6 @@ BooleanStream::BooleanStream() : data(), arrayLimit(0), arrayPos(0), bytePos(0)
 BooleanStream::~BooleanStream() {
 }
 
-///////////////////////////////////////////////////////////////////////////////
-bool BooleanStream::readBoolean() {
-
-    try {
-
-        unsigned char b = data[arrayPos];
-        bool rc = ( ( b >> bytePos ) & 0x01 ) != 0;
-        bytePos++;
-        if( bytePos >= 8 ) {
-            bytePos = 0;
-            arrayPos++;
-        }
-        return rc;
-    }
-    AMQ_CATCH_RETHROW( IOException )
-    AMQ_CATCH_EXCEPTION_CONVERT( Exception, IOException )
-    AMQ_CATCHALL_THROW( IOException )
-}
-
-///////////////////////////////////////////////////////////////////////////////
-void BooleanStream::writeBoolean( bool value ) {
-
-    try{
-
-        if( bytePos == 0 ) {
-            arrayLimit++;
-
-            if( (size_t)arrayLimit >= data.size() ) {
-                // re-grow the array if necessary
-                data.resize( data.size() * 2 );
-            }
-        }
-
-        if( value ) {
-            data[arrayPos] |= (unsigned char)( 0x01 << bytePos );
-        }
-
-        bytePos++;
-
-        // Wrap around when we hit the next byte
-        if( bytePos >= 8 ) {
-            bytePos=0;
-            arrayPos++;
-        }
-    }
-    AMQ_CATCH_RETHROW( IOException )
-    AMQ_CATCH_EXCEPTION_CONVERT( Exception, IOException )
-    AMQ_CATCHALL_THROW( IOException )
-}
-
 ///////////////////////////////////////////////////////////////////////////////
 void BooleanStream::marshal( DataOutputStream* dataOut ) {
 
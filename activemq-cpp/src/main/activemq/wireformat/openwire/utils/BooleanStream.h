@@ -68,21 +68,46 @@ namespace utils{
         virtual ~BooleanStream();
 
         /**
-         * Read a boolean data element from the internal data buffer
+         * Read a boolean data element from the internal data buffer, this is called
+         * for every flag of every marshalled field so it is kept inline.
          *
          * @returns boolean from the stream
-         *
-         * @throws IOException if an I/O error occurs during this operation.
          */
-        bool readBoolean();
+        bool readBoolean() {
+
+            bool rc = ( ( data[arrayPos] >> bytePos ) & 0x01 ) != 0;
+            if( ++bytePos >= 8 ) {
+                bytePos = 0;
+                arrayPos++;
+            }
+            return rc;
+        }
 
         /**
          * Writes a Boolean value to the internal data buffer
          * @param value - boolean data to write.
-         *
-         * @throws IOException if an I/O error occurs during this operation.
          */
-        void writeBoolean( bool value );
+        void writeBoolean( bool value ) {
+
+            if( bytePos == 0 ) {
+                arrayLimit++;
+
+                if( (size_t)arrayLimit >= data.size() ) {
+                    // re-grow the array if necessary
+                    data.resize( data.size() * 2 );
+                }
+            }
+
+            if( value ) {
+                data[arrayPos] |= (unsigned char)( 0x01 << bytePos );
+            }
+
+            // Wrap around when we hit the next byte
+            if( ++bytePos >= 8 ) {
+                bytePos = 0;
+                arrayPos++;
+            }
+        }
 
         /**
          * Marshal the data to a DataOutputStream
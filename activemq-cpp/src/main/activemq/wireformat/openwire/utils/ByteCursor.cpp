@@ -0,0 +1,171 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <activemq/wireformat/openwire/utils/ByteCursor.h>
+
+#include <decaf/io/UTFDataFormatException.h>
+
+#include <vector>
+#include <string.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace activemq::wireformat::openwire::utils;
+using namespace decaf::io;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+void ByteCursor::setPosition(int position) {
+
+    if (position < 0 || position > this->length) {
+        throw IOException(__FILE__, __LINE__, "ByteCursor - Position %d is outside a buffer of %d bytes", position, this->length);
+    }
+
+    this->position = position;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ByteCursor::readBytes(unsigned char* dest, int count) {
+
+    checkRead(count);
+    if (count > 0) {
+        ::memcpy(dest, this->buffer + this->position, count);
+        this->position += count;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string ByteCursor::readUTF() {
+
+    unsigned short utfLength = readUnsignedShort();
+    if (utfLength == 0) {
+        return "";
+    }
+
+    checkRead(utfLength);
+
+    const unsigned char* bytes = this->buffer + this->position;
+    this->position += utfLength;
+
+    std::string result;
+    result.reserve(utfLength);
+
+    std::size_t count = 0;
+    while (count < utfLength) {
+
+        unsigned char a = bytes[count++];
+
+        if (a < 0x80) {
+            result.push_back((char) a);
+        } else if ((a & 0xE0) == 0xC0) {
+
+            if (count >= utfLength) {
+                throw UTFDataFormatException(__FILE__, __LINE__, "Invalid UTF-8 encoding found, start of two byte char found at end.");
+            }
+
+            unsigned char b = bytes[count++];
+            if ((b & 0xC0) != 0x80) {
+                throw UTFDataFormatException(__FILE__, __LINE__, "Invalid UTF-8 encoding found, byte two does not start with 0x80.");
+            }
+
+            // Only encoded values in the range 0-255 are supported, the same as
+            // DataInputStream::readUTF.
+            if (a & 0x1C) {
+                throw UTFDataFormatException(__FILE__, __LINE__, "Invalid 2 byte UTF-8 encoding found, "
+                        "This method only supports encoded ASCII values of (0-255).");
+            }
+
+            result.push_back((char) (((a & 0x1F) << 6) | (b & 0x3F)));
+
+        } else if ((a & 0xF0) == 0xE0) {
+            throw UTFDataFormatException(__FILE__, __LINE__, "Invalid 3 byte UTF-8 encoding found, "
+                    "This method only supports encoded ASCII values of (0-255).");
+        } else {
+            throw UTFDataFormatException(__FILE__, __LINE__, "Invalid UTF-8 encoding found, aborting.");
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ByteCursor::writeBytes(const unsigned char* source, int count) {
+
+    checkWrite(count);
+    if (count > 0) {
+        ::memcpy(this->buffer + this->position, source, count);
+        this->position += count;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ByteCursor::writeBytes(const std::string& value) {
+
+    if (!value.empty()) {
+        writeBytes((const unsigned char*) value.c_str(), (int) value.length());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ByteCursor::writeUTF(const std::string& value) {
+
+    std::size_t length = value.length();
+    unsigned int utfLength = 0;
+
+    for (std::size_t i = 0; i < length; ++i) {
+        unsigned int charValue = (unsigned char) value[i];
+        utfLength += (charValue > 0 && charValue <= 127) ? 1 : 2;
+    }
+
+    if (utfLength > 65535) {
+        throw UTFDataFormatException(__FILE__, __LINE__, "Attempted to write a string as UTF-8 whose length is longer "
+                "than the supported 65535 bytes");
+    }
+
+    checkWrite(2 + (int) utfLength);
+
+    writeShort((short) utfLength);
+
+    unsigned char* bytes = this->buffer + this->position;
+    for (std::size_t i = 0; i < length; ++i) {
+
+        unsigned int charValue = (unsigned char) value[i];
+
+        // A std::string holds single byte characters so the three byte form that
+        // DataOutputStream supports for wider values can never be needed here.
+        if (charValue > 0 && charValue <= 127) {
+            *bytes++ = (unsigned char) charValue;
+        } else {
+            *bytes++ = (unsigned char) (0xC0 | (0x1F & (charValue >> 6)));
+            *bytes++ = (unsigned char) (0x80 | (0x3F & charValue));
+        }
+    }
+
+    this->position += (int) utfLength;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ByteCursor::throwUnderflow(int count) const {
+    throw EOFException(__FILE__, __LINE__, "ByteCursor - Attempted to read %d bytes with only %d remaining", count, remaining());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ByteCursor::throwOverflow(int count) const {
+    throw IOException(__FILE__, __LINE__, "ByteCursor - Attempted to write %d bytes with only %d remaining", count, remaining());
+}
@@ -0,0 +1,273 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_WIREFORMAT_OPENWIRE_UTILS_BYTECURSOR_H_
+#define _ACTIVEMQ_WIREFORMAT_OPENWIRE_UTILS_BYTECURSOR_H_
+
+#include <activemq/util/Config.h>
+
+#include <decaf/io/IOException.h>
+#include <decaf/io/EOFException.h>
+
+#include <string>
+#include <string.h>
+
+namespace activemq {
+namespace wireformat {
+namespace openwire {
+namespace utils {
+
+    /**
+     * A non-virtual read / write cursor over a raw byte buffer that uses the same big
+     * endian encoding as DataInputStream and DataOutputStream.  The direct OpenWire
+     * marshallers encode a whole frame into a buffer sized by the first marshalling
+     * pass and decode a frame that has already been read in full, so the primitive
+     * accessors here are simple inline pointer operations with a single bounds check.
+     *
+     * The cursor never owns the buffer it operates on, the caller must ensure that the
+     * buffer remains valid for the lifetime of the cursor.
+     *
+     * @since 3.8
+     */
+    class AMQCPP_API ByteCursor {
+    private:
+
+        unsigned char* buffer;
+        int length;
+        int position;
+
+    private:
+
+        ByteCursor(const ByteCursor&);
+        ByteCursor& operator=(const ByteCursor&);
+
+    public:
+
+        /**
+         * Creates a new cursor positioned at the start of the given buffer.
+         *
+         * @param buffer
+         *      The buffer that is read from or written into.
+         * @param length
+         *      The number of valid bytes in the buffer.
+         */
+        ByteCursor(unsigned char* buffer, int length) : buffer(buffer), length(length), position(0) {}
+
+        /**
+         * Creates a new read only cursor positioned at the start of the given buffer,
+         * none of the write methods may be called on a cursor created this way.
+         *
+         * @param buffer
+         *      The buffer that is read from.
+         * @param length
+         *      The number of valid bytes in the buffer.
+         */
+        ByteCursor(const unsigned char* buffer, int length) :
+            buffer(const_cast<unsigned char*>(buffer)), length(length), position(0) {}
+
+        ~ByteCursor() {}
+
+        /**
+         * @return the offset of the next byte to be read or written.
+         */
+        int getPosition() const {
+            return this->position;
+        }
+
+        /**
+         * Moves the cursor to the given offset, used to return to a previously
+         * saved position.
+         *
+         * @param position
+         *      The new offset, from zero up to and including the length.
+         *
+         * @throws IOException if the offset is outside the buffer.
+         */
+        void setPosition(int position);
+
+        /**
+         * @return the number of bytes the cursor was created to cover.
+         */
+        int getLength() const {
+            return this->length;
+        }
+
+        /**
+         * @return the number of bytes left between the current position and the end.
+         */
+        int remaining() const {
+            return this->length - this->position;
+        }
+
+        /**
+         * Advances the cursor without reading the skipped bytes.
+         *
+         * @param count
+         *      The number of bytes to skip.
+         *
+         * @throws EOFException if fewer than count bytes remain.
+         */
+        void skip(int count) {
+            checkRead(count);
+            this->position += count;
+        }
+
+        unsigned char readByte() {
+            checkRead(1);
+            return this->buffer[this->position++];
+        }
+
+        bool readBoolean() {
+            return readByte() != 0;
+        }
+
+        char readChar() {
+            return (char) readByte();
+        }
+
+        short readShort() {
+            checkRead(2);
+            const unsigned char* bytes = this->buffer + this->position;
+            this->position += 2;
+            return (short) ((bytes[0] << 8) | bytes[1]);
+        }
+
+        unsigned short readUnsignedShort() {
+            return (unsigned short) readShort();
+        }
+
+        int readInt() {
+            checkRead(4);
+            const unsigned char* bytes = this->buffer + this->position;
+            this->position += 4;
+            return (int) (((unsigned int) bytes[0] << 24) | ((unsigned int) bytes[1] << 16) |
+                          ((unsigned int) bytes[2] << 8) | (unsigned int) bytes[3]);
+        }
+
+        long long readLong() {
+            unsigned long long high = (unsigned int) readInt();
+            unsigned long long low = (unsigned int) readInt();
+            return (long long) ((high << 32) | low);
+        }
+
+        float readFloat() {
+            unsigned int bits = (unsigned int) readInt();
+            float value = 0.0f;
+            ::memcpy(&value, &bits, sizeof(bits));
+            return value;
+        }
+
+        double readDouble() {
+            unsigned long long bits = (unsigned long long) readLong();
+            double value = 0.0;
+            ::memcpy(&value, &bits, sizeof(bits));
+            return value;
+        }
+
+        /**
+         * Copies the next count bytes into the given array.
+         *
+         * @throws EOFException if fewer than count bytes remain.
+         */
+        void readBytes(unsigned char* dest, int count);
+
+        /**
+         * Reads a modified UTF-8 string in the format written by DataOutputStream::writeUTF.
+         *
+         * @throws EOFException if the encoded string runs past the end of the buffer.
+         * @throws UTFDataFormatException if the encoding is invalid or not in the 0-255 range.
+         */
+        std::string readUTF();
+
+        void writeByte(unsigned char value) {
+            checkWrite(1);
+            this->buffer[this->position++] = value;
+        }
+
+        void writeBoolean(bool value) {
+            writeByte(value ? 1 : 0);
+        }
+
+        void writeShort(short value) {
+            checkWrite(2);
+            unsigned char* bytes = this->buffer + this->position;
+            bytes[0] = (unsigned char) ((value & 0xFF00) >> 8);
+            bytes[1] = (unsigned char) (value & 0x00FF);
+            this->position += 2;
+        }
+
+        void writeInt(int value) {
+            checkWrite(4);
+            unsigned char* bytes = this->buffer + this->position;
+            bytes[0] = (unsigned char) (((unsigned int) value) >> 24);
+            bytes[1] = (unsigned char) (((unsigned int) value) >> 16);
+            bytes[2] = (unsigned char) (((unsigned int) value) >> 8);
+            bytes[3] = (unsigned char) ((unsigned int) value);
+            this->position += 4;
+        }
+
+        void writeLong(long long value) {
+            writeInt((int) (((unsigned long long) value) >> 32));
+            writeInt((int) (value & 0xFFFFFFFFLL));
+        }
+
+        /**
+         * Copies count bytes from the given array into the buffer.
+         *
+         * @throws IOException if fewer than count bytes of space remain.
+         */
+        void writeBytes(const unsigned char* source, int count);
+
+        /**
+         * Writes each character of the string as a single byte, the same as
+         * DataOutputStream::writeBytes.
+         *
+         * @throws IOException if the string does not fit in the remaining space.
+         */
+        void writeBytes(const std::string& value);
+
+        /**
+         * Writes a string in the modified UTF-8 format used by DataOutputStream::writeUTF.
+         *
+         * @throws UTFDataFormatException if the encoded string is longer than 65535 bytes.
+         * @throws IOException if the encoded string does not fit in the remaining space.
+         */
+        void writeUTF(const std::string& value);
+
+    private:
+
+        void checkRead(int count) const {
+            if (count < 0 || count > this->length - this->position) {
+                throwUnderflow(count);
+            }
+        }
+
+        void checkWrite(int count) const {
+            if (count < 0 || count > this->length - this->position) {
+                throwOverflow(count);
+            }
+        }
+
+        void throwUnderflow(int count) const;
+
+        void throwOverflow(int count) const;
+
+    };
+
+}}}}
+
+#endif /* _ACTIVEMQ_WIREFORMAT_OPENWIRE_UTILS_BYTECURSOR_H_ */
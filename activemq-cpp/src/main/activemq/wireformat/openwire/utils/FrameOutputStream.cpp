@@ -0,0 +1,249 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FrameOutputStream.h"
+
+#include <activemq/exceptions/ActiveMQException.h>
+
+#include <decaf/lang/System.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/lang/exceptions/IndexOutOfBoundsException.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace activemq::wireformat::openwire::utils;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+const int FrameOutputStream::DEFAULT_RETAINED_CAPACITY = 64 * 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const int MINIMUM_CAPACITY = 256;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+FrameOutputStream::FrameOutputStream() :
+    OutputStream(), buffer(NULL), capacity(0), count(0), retainedCapacity(DEFAULT_RETAINED_CAPACITY),
+    referenceThreshold(0), references(), referencedBytes(0) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+FrameOutputStream::FrameOutputStream(int retainedCapacity) :
+    OutputStream(), buffer(NULL), capacity(0), count(0), retainedCapacity(retainedCapacity),
+    referenceThreshold(0), references(), referencedBytes(0) {
+
+    if (retainedCapacity < 0) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Retained capacity cannot be negative: %d", retainedCapacity);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+FrameOutputStream::~FrameOutputStream() {
+    try {
+        delete[] this->buffer;
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameOutputStream::reset() {
+
+    this->count = 0;
+    this->references.clear();
+    this->referencedBytes = 0;
+
+    if (this->capacity > this->retainedCapacity) {
+        delete[] this->buffer;
+        this->buffer = NULL;
+        this->capacity = 0;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameOutputStream::setReferenceThreshold(int threshold) {
+
+    if (threshold < 0) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Reference threshold cannot be negative: %d", threshold);
+    }
+
+    this->referenceThreshold = threshold;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameOutputStream::ensureCapacity(int required) {
+
+    if (required <= this->capacity) {
+        return;
+    }
+
+    // Grow geometrically so a frame written a piece at a time is copied a bounded
+    // number of times.
+    int newCapacity = std::max(required, std::max(this->capacity * 2, MINIMUM_CAPACITY));
+
+    unsigned char* temp = new unsigned char[newCapacity];
+    if (this->count > 0) {
+        System::arraycopy(this->buffer, 0, temp, 0, this->count);
+    }
+
+    std::swap(temp, this->buffer);
+    this->capacity = newCapacity;
+
+    delete[] temp;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int FrameOutputStream::reserve(int length) {
+
+    if (length < 0) {
+        throw IndexOutOfBoundsException(__FILE__, __LINE__, "Cannot reserve a negative length: %d", length);
+    }
+
+    int offset = this->count;
+    ensureCapacity(this->count + length);
+    this->count += length;
+
+    return offset;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameOutputStream::patchInt(int offset, int value) {
+
+    if (offset < 0 || offset > size() - 4) {
+        throw IndexOutOfBoundsException(__FILE__, __LINE__, "Offset %d is outside the frame of %d bytes", offset, size());
+    }
+
+    // Map the offset in the frame to the offset in the buffer by skipping over
+    // the referenced regions that come before it.
+    int referencedBefore = 0;
+    for (std::vector<Reference>::const_iterator iter = references.begin(); iter != references.end(); ++iter) {
+
+        int start = iter->position + referencedBefore;
+        if (offset + 4 <= start) {
+            break;
+        }
+
+        if (offset < start + iter->length) {
+            throw IndexOutOfBoundsException(__FILE__, __LINE__, "Offset %d is inside a referenced region", offset);
+        }
+
+        referencedBefore += iter->length;
+    }
+
+    offset -= referencedBefore;
+
+    this->buffer[offset] = (unsigned char) (((unsigned int) value) >> 24);
+    this->buffer[offset + 1] = (unsigned char) (((unsigned int) value) >> 16);
+    this->buffer[offset + 2] = (unsigned char) (((unsigned int) value) >> 8);
+    this->buffer[offset + 3] = (unsigned char) ((unsigned int) value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameOutputStream::writeTo(OutputStream* out) const {
+
+    if (out == NULL) {
+        throw NullPointerException(__FILE__, __LINE__, "Stream to write to cannot be NULL");
+    }
+
+    if (this->references.empty()) {
+        if (this->count > 0) {
+            out->write(this->buffer, this->count);
+        }
+        return;
+    }
+
+    std::vector<const unsigned char*> regions;
+    std::vector<int> lengths;
+    regions.reserve(this->references.size() * 2 + 1);
+    lengths.reserve(this->references.size() * 2 + 1);
+
+    int position = 0;
+    for (std::vector<Reference>::const_iterator iter = references.begin(); iter != references.end(); ++iter) {
+
+        if (iter->position > position) {
+            regions.push_back(this->buffer + position);
+            lengths.push_back(iter->position - position);
+            position = iter->position;
+        }
+
+        regions.push_back(iter->data);
+        lengths.push_back(iter->length);
+    }
+
+    if (this->count > position) {
+        regions.push_back(this->buffer + position);
+        lengths.push_back(this->count - position);
+    }
+
+    out->writeGathering(&regions[0], &lengths[0], (int) regions.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameOutputStream::doWriteByte(unsigned char value) {
+
+    if (this->count == this->capacity) {
+        ensureCapacity(this->count + 1);
+    }
+
+    this->buffer[this->count++] = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameOutputStream::doWriteArrayBounded(const unsigned char* source, int size, int offset, int length) {
+
+    if (length == 0) {
+        return;
+    }
+
+    if (source == NULL) {
+        throw NullPointerException(__FILE__, __LINE__, "passed buffer is null");
+    }
+
+    if (size < 0) {
+        throw IndexOutOfBoundsException(__FILE__, __LINE__, "size parameter out of Bounds: %d.", size);
+    }
+
+    if (offset > size || offset < 0) {
+        throw IndexOutOfBoundsException(__FILE__, __LINE__, "offset parameter out of Bounds: %d.", offset);
+    }
+
+    if (length < 0 || length > size - offset) {
+        throw IndexOutOfBoundsException(__FILE__, __LINE__, "length parameter out of Bounds: %d.", length);
+    }
+
+    if (this->referenceThreshold > 0 && length >= this->referenceThreshold) {
+        Reference reference;
+        reference.position = this->count;
+        reference.data = source + offset;
+        reference.length = length;
+        this->references.push_back(reference);
+        this->referencedBytes += length;
+        return;
+    }
+
+    ensureCapacity(this->count + length);
+    System::arraycopy(source, offset, this->buffer, this->count, length);
+    this->count += length;
+}
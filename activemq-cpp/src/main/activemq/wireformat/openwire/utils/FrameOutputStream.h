@@ -0,0 +1,209 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_WIREFORMAT_OPENWIRE_UTILS_FRAMEOUTPUTSTREAM_H_
+#define _ACTIVEMQ_WIREFORMAT_OPENWIRE_UTILS_FRAMEOUTPUTSTREAM_H_
+
+#include <activemq/util/Config.h>
+
+#include <decaf/io/OutputStream.h>
+
+#include <vector>
+
+namespace activemq {
+namespace wireformat {
+namespace openwire {
+namespace utils {
+
+    /**
+     * An OutputStream that collects one OpenWire frame in memory so that it can be
+     * handed to the transport in a single write.  The buffer is kept between frames,
+     * space can be reserved for a value that is only known once the frame has been
+     * written, such as the size prefix, and filled in afterwards with patchInt.
+     *
+     * When a frame grows the buffer beyond the retained capacity the extra memory is
+     * released again on the next reset so that a single large message doesn't pin a
+     * large buffer for the life of the connection.
+     *
+     * When a reference threshold is set any single write of at least that many bytes,
+     * such as a large message body, is not copied.  The frame keeps a reference to the
+     * caller's memory instead and writeTo hands the buffered bytes and the referenced
+     * regions to the target stream in one gathering write.  The referenced memory must
+     * remain unchanged until the frame has been written or reset.
+     *
+     * This class is not thread safe, the owner must serialize access to it.
+     *
+     * @since 3.8
+     */
+    class AMQCPP_API FrameOutputStream : public decaf::io::OutputStream {
+    public:
+
+        /**
+         * The default amount of buffer memory that is kept between frames.
+         */
+        static const int DEFAULT_RETAINED_CAPACITY;
+
+    private:
+
+        // A region of the caller's memory that follows the first position bytes
+        // of the buffer in the frame.
+        struct Reference {
+            int position;
+            const unsigned char* data;
+            int length;
+        };
+
+        unsigned char* buffer;
+        int capacity;
+        int count;
+        int retainedCapacity;
+        int referenceThreshold;
+        std::vector<Reference> references;
+        int referencedBytes;
+
+    private:
+
+        FrameOutputStream(const FrameOutputStream&);
+        FrameOutputStream& operator=(const FrameOutputStream&);
+
+    public:
+
+        FrameOutputStream();
+
+        /**
+         * @param retainedCapacity
+         *      The amount of buffer memory that is kept between frames.
+         */
+        FrameOutputStream(int retainedCapacity);
+
+        virtual ~FrameOutputStream();
+
+        /**
+         * Discards the current frame and any references it holds, releasing buffer
+         * memory above the retained capacity.
+         */
+        void reset();
+
+        /**
+         * Grows the buffer so that it can hold at least the given number of bytes
+         * without further reallocation.
+         *
+         * @param required
+         *      The total number of bytes the frame will hold.
+         */
+        void ensureCapacity(int required);
+
+        /**
+         * Appends the given number of bytes without writing them.
+         *
+         * @param length
+         *      The number of bytes to reserve.
+         *
+         * @return the offset of the reserved bytes in the frame.
+         */
+        int reserve(int length);
+
+        /**
+         * Writes a big endian int over four previously written or reserved bytes, the
+         * bytes cannot be part of a referenced region.
+         *
+         * @param offset
+         *      The offset in the frame to write the value at.
+         * @param value
+         *      The value to write.
+         *
+         * @throws IndexOutOfBoundsException if the four bytes are not inside the buffered
+         *         part of the frame.
+         */
+        void patchInt(int offset, int value);
+
+        /**
+         * @return a pointer to the start of the buffer, valid until the next write or reset.
+         *         The buffer holds the whole frame unless hasReferences returns true.
+         */
+        unsigned char* getBuffer() {
+            return this->buffer;
+        }
+
+        /**
+         * @return the number of bytes in the current frame, including referenced regions.
+         */
+        int size() const {
+            return this->count + this->referencedBytes;
+        }
+
+        /**
+         * @return true if part of the current frame is held by reference.
+         */
+        bool hasReferences() const {
+            return !this->references.empty();
+        }
+
+        /**
+         * @return the size from which writes are referenced rather than copied, zero
+         *         when every write is copied.
+         */
+        int getReferenceThreshold() const {
+            return this->referenceThreshold;
+        }
+
+        /**
+         * Sets the size from which writes are referenced rather than copied.
+         *
+         * @param threshold
+         *      The smallest write that is referenced, zero to copy every write.
+         *
+         * @throws IllegalArgumentException if the threshold is negative.
+         */
+        void setReferenceThreshold(int threshold);
+
+        /**
+         * @return the amount of buffer memory that is kept between frames.
+         */
+        int getRetainedCapacity() const {
+            return this->retainedCapacity;
+        }
+
+        /**
+         * @return the number of bytes the buffer can hold before it must grow.
+         */
+        int getCapacity() const {
+            return this->capacity;
+        }
+
+        /**
+         * Writes the current frame to the given stream with a single write call, or a
+         * single gathering write when part of the frame is held by reference.
+         *
+         * @param out
+         *      The stream to write the frame to.
+         *
+         * @throws IOException if an error occurs while writing.
+         */
+        void writeTo(decaf::io::OutputStream* out) const;
+
+    protected:
+
+        virtual void doWriteByte(unsigned char value);
+
+        virtual void doWriteArrayBounded(const unsigned char* buffer, int size, int offset, int length);
+
+    };
+
+}}}}
+
+#endif /* _ACTIVEMQ_WIREFORMAT_OPENWIRE_UTILS_FRAMEOUTPUTSTREAM_H_ */
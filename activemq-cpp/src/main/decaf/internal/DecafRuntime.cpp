@@ -26,6 +26,7 @@
 #include <decaf/internal/net/Network.h>
 #include <decaf/internal/security/SecurityRuntime.h>
 #include <decaf/internal/util/concurrent/Threading.h>
+#include <decaf/util/logging/LogManager.h>
 
 using namespace decaf;
 using namespace decaf::internal;
@@ -34,6 +35,7 @@ using namespace decaf::internal::security;
 using namespace decaf::internal::util::concurrent;
 using namespace decaf::lang;
 using namespace decaf::util::concurrent;
+using namespace decaf::util::logging;
 
 ////////////////////////////////////////////////////////////////////////////////
 namespace {
@@ -80,6 +82,9 @@ void Runtime::initializeRuntime(int argc, char **argv) {
     System::initSystem(argc, argv);
     Network::initializeNetworking();
     SecurityRuntime::initializeSecurity();
+
+    // Logging comes last since its Handlers can make use of any of the above.
+    LogManager::initialize();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -90,6 +95,10 @@ void Runtime::initializeRuntime() {
 ////////////////////////////////////////////////////////////////////////////////
 void Runtime::shutdownRuntime() {
 
+    // Stop the logging subsystem first so that any pending records are written
+    // while the rest of the Runtime is still available.
+    LogManager::shutdown();
+
     SecurityRuntime::shutdownSecurity();
 
     // Shutdown the networking layer before Threading, many network routines need
@@ -0,0 +1,372 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MemoryMappedFile.h"
+
+#include <decaf/internal/AprPool.h>
+#include <decaf/io/IOException.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/lang/exceptions/IllegalStateException.h>
+
+#include <apr_file_io.h>
+#include <apr_mmap.h>
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::internal;
+using namespace decaf::internal::io;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace decaf {
+namespace internal {
+namespace io {
+
+    class MemoryMappedFileImpl {
+    private:
+
+        MemoryMappedFileImpl(const MemoryMappedFileImpl&);
+        MemoryMappedFileImpl& operator=(const MemoryMappedFileImpl&);
+
+    public:
+
+        AprPool pool;
+        apr_file_t* file;
+        apr_mmap_t* mapping;
+        long long mappingOffset;
+        long long capacity;
+        long long length;
+        bool writable;
+
+        MemoryMappedFileImpl() : pool(), file(NULL), mapping(NULL), mappingOffset(0), capacity(0), length(0), writable(false) {
+        }
+
+    };
+
+}}}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // Offsets handed to the mapping call must be a multiple of the page size.
+    long long getPageSize() {
+
+        long long pageSize = 0;
+
+#if defined(_WIN32)
+        SYSTEM_INFO sysInfo;
+        ::GetSystemInfo(&sysInfo);
+        pageSize = sysInfo.dwAllocationGranularity;
+#else
+        pageSize = (long long) sysconf(_SC_PAGESIZE);
+#endif
+
+        return pageSize > 0 ? pageSize : 4096;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MemoryMappedFile::MemoryMappedFile() : impl(new MemoryMappedFileImpl()) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MemoryMappedFile::~MemoryMappedFile() {
+    try {
+        close();
+    }
+    DECAF_CATCHALL_NOTHROW()
+
+    try {
+        delete this->impl;
+    }
+    DECAF_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryMappedFile::create(const std::string& path, long long capacity) {
+
+    if (isOpen()) {
+        throw IllegalStateException(__FILE__, __LINE__, "A file is already open.");
+    }
+
+    if (capacity <= 0) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Capacity must be greater than zero: %lld", capacity);
+    }
+
+    apr_status_t result = apr_file_open(&this->impl->file, path.c_str(),
+                                        APR_READ | APR_WRITE | APR_CREATE | APR_TRUNCATE | APR_BINARY,
+                                        APR_OS_DEFAULT, this->impl->pool.getAprPool());
+
+    if (result != APR_SUCCESS) {
+        this->impl->file = NULL;
+        throw IOException(__FILE__, __LINE__, "Could not create file: %s", path.c_str());
+    }
+
+    // Extend the file to its full size up front so the whole of it can be mapped.
+    result = apr_file_trunc(this->impl->file, (apr_off_t) capacity);
+
+    if (result == APR_SUCCESS) {
+        result = apr_mmap_create(&this->impl->mapping, this->impl->file, 0, (apr_size_t) capacity,
+                                 APR_MMAP_READ | APR_MMAP_WRITE, this->impl->pool.getAprPool());
+    }
+
+    if (result != APR_SUCCESS) {
+        this->impl->mapping = NULL;
+        apr_file_close(this->impl->file);
+        this->impl->file = NULL;
+        throw IOException(__FILE__, __LINE__, "Could not map %lld bytes of file: %s", capacity, path.c_str());
+    }
+
+    this->impl->capacity = capacity;
+    this->impl->length = 0;
+    this->impl->writable = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryMappedFile::open(const std::string& path) {
+
+    if (isOpen()) {
+        throw IllegalStateException(__FILE__, __LINE__, "A file is already open.");
+    }
+
+    apr_finfo_t info;
+    apr_status_t result = apr_stat(&info, path.c_str(), APR_FINFO_SIZE, this->impl->pool.getAprPool());
+
+    if (result != APR_SUCCESS) {
+        throw IOException(__FILE__, __LINE__, "Could not find file: %s", path.c_str());
+    }
+
+    result = apr_file_open(&this->impl->file, path.c_str(), APR_READ | APR_BINARY,
+                           APR_OS_DEFAULT, this->impl->pool.getAprPool());
+
+    if (result != APR_SUCCESS) {
+        this->impl->file = NULL;
+        throw IOException(__FILE__, __LINE__, "Could not open file: %s", path.c_str());
+    }
+
+    // An empty file can't be mapped, it is simply open with nothing in it.
+    if (info.size > 0) {
+        result = apr_mmap_create(&this->impl->mapping, this->impl->file, 0, (apr_size_t) info.size,
+                                 APR_MMAP_READ, this->impl->pool.getAprPool());
+
+        if (result != APR_SUCCESS) {
+            this->impl->mapping = NULL;
+            apr_file_close(this->impl->file);
+            this->impl->file = NULL;
+            throw IOException(__FILE__, __LINE__, "Could not map file: %s", path.c_str());
+        }
+    }
+
+    this->impl->capacity = info.size;
+    this->impl->length = info.size;
+    this->impl->writable = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryMappedFile::open(const std::string& path, long long offset, long long length) {
+
+    if (isOpen()) {
+        throw IllegalStateException(__FILE__, __LINE__, "A file is already open.");
+    }
+
+    if (offset < 0) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Offset must not be negative: %lld", offset);
+    }
+
+    if (length < -1) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Invalid length: %lld", length);
+    }
+
+    apr_finfo_t info;
+    apr_status_t result = apr_stat(&info, path.c_str(), APR_FINFO_SIZE, this->impl->pool.getAprPool());
+
+    if (result != APR_SUCCESS) {
+        throw IOException(__FILE__, __LINE__, "Could not find file: %s", path.c_str());
+    }
+
+    long long fileLength = (long long) info.size;
+
+    if (offset > fileLength) {
+        throw IllegalArgumentException(__FILE__, __LINE__,
+            "Offset %lld is past the end of file: %s", offset, path.c_str());
+    }
+
+    if (length == -1) {
+        length = fileLength - offset;
+    }
+
+    if (offset + length > fileLength) {
+        throw IllegalArgumentException(__FILE__, __LINE__,
+            "Range of %lld bytes at %lld is past the end of file: %s", length, offset, path.c_str());
+    }
+
+    // Map from the start of the page holding the first byte, the buffer is then
+    // offset into the mapping by however far the range is into that page.
+    long long pageSize = getPageSize();
+    long long mappingOffset = offset % pageSize;
+    long long mappingLength = length + mappingOffset;
+
+    if ((long long) (apr_size_t) mappingLength != mappingLength) {
+        throw IOException(__FILE__, __LINE__, "Range of %lld bytes is too large to map: %s", length, path.c_str());
+    }
+
+    result = apr_file_open(&this->impl->file, path.c_str(), APR_READ | APR_BINARY,
+                           APR_OS_DEFAULT, this->impl->pool.getAprPool());
+
+    if (result != APR_SUCCESS) {
+        this->impl->file = NULL;
+        throw IOException(__FILE__, __LINE__, "Could not open file: %s", path.c_str());
+    }
+
+    // An empty range can't be mapped, the file is simply open with nothing in it.
+    if (length > 0) {
+        result = apr_mmap_create(&this->impl->mapping, this->impl->file, (apr_off_t) (offset - mappingOffset),
+                                 (apr_size_t) mappingLength, APR_MMAP_READ, this->impl->pool.getAprPool());
+
+        if (result != APR_SUCCESS) {
+            this->impl->mapping = NULL;
+            apr_file_close(this->impl->file);
+            this->impl->file = NULL;
+            throw IOException(__FILE__, __LINE__, "Could not map %lld bytes of file: %s", length, path.c_str());
+        }
+    }
+
+    this->impl->mappingOffset = mappingOffset;
+    this->impl->capacity = length;
+    this->impl->length = length;
+    this->impl->writable = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryMappedFile::close() {
+
+    if (this->impl->file == NULL) {
+        return;
+    }
+
+    apr_status_t result = APR_SUCCESS;
+
+    if (this->impl->mapping != NULL) {
+        result = apr_mmap_delete(this->impl->mapping);
+        this->impl->mapping = NULL;
+    }
+
+    if (this->impl->writable && result == APR_SUCCESS) {
+        result = apr_file_trunc(this->impl->file, (apr_off_t) this->impl->length);
+    }
+
+    apr_status_t closeResult = apr_file_close(this->impl->file);
+
+    this->impl->file = NULL;
+    this->impl->mappingOffset = 0;
+    this->impl->capacity = 0;
+    this->impl->length = 0;
+    this->impl->writable = false;
+    this->impl->pool.cleanup();
+
+    if (result != APR_SUCCESS || closeResult != APR_SUCCESS) {
+        throw IOException(__FILE__, __LINE__, "Error while closing a memory mapped file.");
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool MemoryMappedFile::isOpen() const {
+    return this->impl->file != NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+unsigned char* MemoryMappedFile::getBuffer() const {
+
+    if (this->impl->mapping == NULL) {
+        return NULL;
+    }
+
+    return (unsigned char*) this->impl->mapping->mm + this->impl->mappingOffset;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long MemoryMappedFile::getCapacity() const {
+    return this->impl->capacity;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long MemoryMappedFile::getLength() const {
+    return this->impl->length;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryMappedFile::setLength(long long length) {
+
+    if (length < 0 || length > this->impl->capacity) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Length outside of the mapped region: %lld", length);
+    }
+
+    this->impl->length = length;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool MemoryMappedFile::remove(const std::string& path) {
+
+    AprPool pool;
+    return apr_file_remove(path.c_str(), pool.getAprPool()) == APR_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<std::string> MemoryMappedFile::list(const std::string& directory) {
+
+    AprPool pool;
+    apr_dir_t* dir = NULL;
+
+    if (apr_dir_open(&dir, directory.c_str(), pool.getAprPool()) != APR_SUCCESS) {
+        throw IOException(__FILE__, __LINE__, "Could not open directory: %s", directory.c_str());
+    }
+
+    std::vector<std::string> names;
+    apr_finfo_t info;
+
+    // Entries whose type can't be read come back incomplete, they are skipped.
+    apr_status_t status = apr_dir_read(&info, APR_FINFO_NAME | APR_FINFO_TYPE, dir);
+    while (status == APR_SUCCESS || status == APR_INCOMPLETE) {
+        if ((info.valid & APR_FINFO_TYPE) != 0 && info.filetype == APR_REG && info.name != NULL) {
+            names.push_back(info.name);
+        }
+        status = apr_dir_read(&info, APR_FINFO_NAME | APR_FINFO_TYPE, dir);
+    }
+
+    apr_dir_close(dir);
+
+    return names;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long MemoryMappedFile::lastModified(const std::string& path) {
+
+    AprPool pool;
+    apr_finfo_t info;
+
+    apr_status_t status = apr_stat(&info, path.c_str(), APR_FINFO_MTIME, pool.getAprPool());
+    if ((status != APR_SUCCESS && status != APR_INCOMPLETE) || (info.valid & APR_FINFO_MTIME) == 0) {
+        return -1;
+    }
+
+    return (long long) apr_time_as_msec(info.mtime);
+}
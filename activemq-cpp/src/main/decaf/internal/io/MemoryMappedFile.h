@@ -0,0 +1,174 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_INTERNAL_IO_MEMORYMAPPEDFILE_H_
+#define _DECAF_INTERNAL_IO_MEMORYMAPPEDFILE_H_
+
+#include <decaf/util/Config.h>
+
+#include <string>
+#include <vector>
+
+namespace decaf {
+namespace internal {
+namespace io {
+
+    class MemoryMappedFileImpl;
+
+    /**
+     * A file whose contents are mapped into the address space of the process.  A file
+     * opened for writing is created, or truncated, at a fixed size up front and can then
+     * be filled through the mapped buffer without a system call per write, when it is
+     * closed the file is cut back to the number of bytes that were actually used.
+     *
+     * @since 1.0
+     */
+    class DECAF_API MemoryMappedFile {
+    private:
+
+        MemoryMappedFileImpl* impl;
+
+    private:
+
+        MemoryMappedFile(const MemoryMappedFile&);
+        MemoryMappedFile& operator=(const MemoryMappedFile&);
+
+    public:
+
+        MemoryMappedFile();
+
+        virtual ~MemoryMappedFile();
+
+        /**
+         * Creates the named file, replacing any existing file of that name, sized to the
+         * given capacity and maps the whole of it for reading and writing.
+         *
+         * @param path
+         *      The path of the file to create.
+         * @param capacity
+         *      The size of the file and its mapping, must be greater than zero.
+         *
+         * @throws IOException if the file can't be created or mapped.
+         * @throws IllegalStateException if this object already has a file open.
+         */
+        void create(const std::string& path, long long capacity);
+
+        /**
+         * Maps the whole of an existing file for reading.
+         *
+         * @param path
+         *      The path of the file to open.
+         *
+         * @throws IOException if the file can't be opened or mapped.
+         * @throws IllegalStateException if this object already has a file open.
+         */
+        void open(const std::string& path);
+
+        /**
+         * Maps a range of an existing file for reading, only the pages that hold the
+         * range are mapped and the buffer starts at the first byte of the range.
+         *
+         * @param path
+         *      The path of the file to open.
+         * @param offset
+         *      The offset in the file of the first byte to map.
+         * @param length
+         *      The number of bytes to map, or -1 for the rest of the file.
+         *
+         * @throws IOException if the file can't be opened or mapped.
+         * @throws IllegalArgumentException if the range is outside the file.
+         * @throws IllegalStateException if this object already has a file open.
+         */
+        void open(const std::string& path, long long offset, long long length);
+
+        /**
+         * Unmaps and closes the file, a file that was created by this object is truncated
+         * to the length last set with setLength.  Does nothing if no file is open.
+         *
+         * @throws IOException if an error occurs while closing the file.
+         */
+        void close();
+
+        /**
+         * @return true if a file is currently mapped.
+         */
+        bool isOpen() const;
+
+        /**
+         * @return the start of the mapped region, or NULL if no file is open or it is empty.
+         *         When a range was opened this is the first byte of that range.
+         */
+        unsigned char* getBuffer() const;
+
+        /**
+         * @return the size of the mapped region.
+         */
+        long long getCapacity() const;
+
+        /**
+         * @return the number of bytes in use, the length the file has after it is closed.
+         */
+        long long getLength() const;
+
+        /**
+         * Sets the number of bytes in use, a created file is truncated to this on close.
+         *
+         * @param length
+         *      The number of bytes in use, between zero and the capacity.
+         *
+         * @throws IllegalArgumentException if the length is outside the mapped region.
+         */
+        void setLength(long long length);
+
+        /**
+         * Deletes the named file if it exists.
+         *
+         * @param path
+         *      The path of the file to delete.
+         *
+         * @return true if a file was deleted.
+         */
+        static bool remove(const std::string& path);
+
+        /**
+         * Lists the regular files in the named directory.
+         *
+         * @param directory
+         *      The path of the directory to list.
+         *
+         * @return the names of the files, without the directory, in no particular order.
+         *
+         * @throws IOException if the directory can't be read.
+         */
+        static std::vector<std::string> list(const std::string& directory);
+
+        /**
+         * Gets the time the named file was last modified.
+         *
+         * @param path
+         *      The path of the file.
+         *
+         * @return the modification time in milliseconds since the epoch, or -1 if the
+         *         file doesn't exist.
+         */
+        static long long lastModified(const std::string& path);
+
+    };
+
+}}}
+
+#endif /* _DECAF_INTERNAL_IO_MEMORYMAPPEDFILE_H_ */
@@ -28,12 +28,17 @@
 #include <decaf/util/concurrent/atomic/AtomicBoolean.h>
 #include <stdlib.h>
 #include <string>
+#include <vector>
+#include <algorithm>
 #include <stdio.h>
 #include <iostream>
 
 #include <apr_portable.h>
 #include <apr_network_io.h>
 
+#define APR_WANT_IOVEC
+#include <apr_want.h>
+
 #if !defined(HAVE_WINSOCK2_H)
     #include <sys/select.h>
     #include <sys/socket.h>
@@ -62,6 +67,13 @@ using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
 using namespace decaf::util::concurrent::atomic;
 
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // Most arrays passed to a single gathering write, well under any platform's IOV_MAX.
+    const std::size_t MAX_GATHERED_ARRAYS = 64;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 namespace decaf {
 namespace internal {
@@ -760,6 +772,88 @@ void TcpSocket::write(const unsigned char* buffer, int size, int offset, int len
     DECAF_CATCHALL_THROW(IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void TcpSocket::writeGathering(const unsigned char* const* buffers, const int* lengths, int count) {
+
+    try {
+
+        if (count == 0) {
+            return;
+        }
+
+        if (buffers == NULL || lengths == NULL) {
+            throw NullPointerException(__FILE__, __LINE__,
+                "TcpSocket::writeGathering - passed buffers are null");
+        }
+
+        if (isClosed()) {
+            throw IOException(__FILE__, __LINE__,
+                "TcpSocket::writeGathering - This Stream has been closed.");
+        }
+
+        if (count < 0) {
+            throw IndexOutOfBoundsException(__FILE__, __LINE__,
+                "count parameter out of Bounds: %d.", count);
+        }
+
+        std::vector<struct iovec> vectors;
+        vectors.reserve(count);
+
+        for (int i = 0; i < count; ++i) {
+
+            if (lengths[i] < 0) {
+                throw IndexOutOfBoundsException(__FILE__, __LINE__,
+                    "length parameter out of Bounds: %d.", lengths[i]);
+            }
+
+            if (lengths[i] == 0) {
+                continue;
+            }
+
+            if (buffers[i] == NULL) {
+                throw NullPointerException(__FILE__, __LINE__,
+                    "TcpSocket::writeGathering - passed buffer is null");
+            }
+
+            struct iovec vector;
+            vector.iov_base = (char*) buffers[i];
+            vector.iov_len = (std::size_t) lengths[i];
+            vectors.push_back(vector);
+        }
+
+        std::size_t next = 0;
+
+        while (next < vectors.size() && !isClosed()) {
+
+            apr_size_t sent = 0;
+            apr_int32_t batch = (apr_int32_t) std::min(vectors.size() - next, MAX_GATHERED_ARRAYS);
+
+            apr_status_t result = apr_socket_sendv(this->impl->socketHandle, &vectors[next], batch, &sent);
+
+            if (result != APR_SUCCESS || isClosed()) {
+                throw IOException(__FILE__, __LINE__,
+                    "TcpSocketOutputStream::write - %s", SocketError::getErrorString().c_str());
+            }
+
+            // Skip past the arrays that were sent in full and trim the one that was
+            // only partly sent, the remainder goes out on the next pass.
+            while (next < vectors.size() && sent >= (apr_size_t) vectors[next].iov_len) {
+                sent -= (apr_size_t) vectors[next].iov_len;
+                ++next;
+            }
+
+            if (sent > 0) {
+                vectors[next].iov_base = ((char*) vectors[next].iov_base) + sent;
+                vectors[next].iov_len -= sent;
+            }
+        }
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_RETHROW(NullPointerException)
+    DECAF_CATCH_RETHROW(IndexOutOfBoundsException)
+    DECAF_CATCHALL_THROW(IOException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool TcpSocket::isConnected() const {
     return this->impl->connected;
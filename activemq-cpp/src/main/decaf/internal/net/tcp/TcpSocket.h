@@ -184,6 +184,24 @@ namespace tcp {
          */
         void write(const unsigned char* buffer, int size, int offset, int length);
 
+        /**
+         * Writes the given arrays to the Socket in order using gathering writes, so the
+         * data is handed to the operating system without first being copied into one
+         * contiguous buffer.
+         *
+         * @param buffers
+         *      The arrays of bytes to write to the socket.
+         * @param lengths
+         *      The number of bytes to write from each array.
+         * @param count
+         *      The number of arrays passed.
+         *
+         * @throw IOException if an I/O error occurs during the write.
+         * @throw NullPointerException if buffers or lengths is Null.
+         * @throw IndexOutOfBoundsException if count or one of the lengths is negative.
+         */
+        void writeGathering(const unsigned char* const* buffers, const int* lengths, int count);
+
     protected:
 
         void checkResult(apr_status_t value) const;
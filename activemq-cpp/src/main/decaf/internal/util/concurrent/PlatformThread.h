@@ -141,6 +141,45 @@ namespace concurrent {
 
         static void setStackSize(decaf_thread_t thread, long long stackSize);
 
+        /**
+         * Restricts the given thread to run only on the processors whose indices are
+         * contained in the cpus vector.
+         *
+         * @param thread
+         *      The handle of the thread whose affinity is to be changed.
+         * @param cpus
+         *      The zero based indices of the processors the thread may run on.
+         *
+         * @return false if the platform does not support setting thread affinity.
+         *
+         * @throws RuntimeException if the OS rejects the requested processor set.
+         */
+        static bool setAffinity(decaf_thread_t thread, const std::vector<int>& cpus);
+
+        /**
+         * Gets the set of processors that the given thread is allowed to run on.
+         *
+         * @param thread
+         *      The handle of the thread whose affinity is to be read.
+         * @param cpus
+         *      Vector that is filled with the zero based indices of the allowed processors.
+         *
+         * @return false if the platform does not support reading thread affinity.
+         */
+        static bool getAffinity(decaf_thread_t thread, std::vector<int>& cpus);
+
+        /**
+         * Gets the set of processors that belong to the given NUMA node.
+         *
+         * @param node
+         *      The zero based index of the NUMA node.
+         * @param cpus
+         *      Vector that is filled with the zero based indices of the node's processors.
+         *
+         * @return false if the platform does not expose NUMA topology or the node does not exist.
+         */
+        static bool getNumaNodeProcessors(int node, std::vector<int>& cpus);
+
         /**
          * Pause the current thread allowing another thread to be scheduled for
          * execution, no guarantee that this will happen.
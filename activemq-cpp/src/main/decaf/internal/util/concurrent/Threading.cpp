@@ -1295,6 +1295,21 @@ void Threading::setThreadPriority(ThreadHandle* handle, int priority) {
     handle->priority = priority;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool Threading::setThreadAffinity(ThreadHandle* handle, const std::vector<int>& cpus) {
+    return PlatformThread::setAffinity(handle->handle, cpus);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool Threading::getThreadAffinity(ThreadHandle* handle, std::vector<int>& cpus) {
+    return PlatformThread::getAffinity(handle->handle, cpus);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool Threading::getNumaNodeProcessors(int node, std::vector<int>& cpus) {
+    return PlatformThread::getNumaNodeProcessors(node, cpus);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 const char* Threading::getThreadName(ThreadHandle* handle) {
     return handle->name;
@@ -22,6 +22,8 @@
 
 #include <decaf/lang/Thread.h>
 
+#include <vector>
+
 namespace decaf {
 namespace internal {
 namespace util {
@@ -242,6 +244,27 @@ namespace concurrent {
 
         static void setThreadPriority(ThreadHandle* thread, int priority);
 
+        /**
+         * Binds the given thread to the set of processors whose indices are given.
+         *
+         * @returns false if the platform has no support for processor affinity.
+         */
+        static bool setThreadAffinity(ThreadHandle* thread, const std::vector<int>& cpus);
+
+        /**
+         * Fills in the set of processors that the given thread may run on.
+         *
+         * @returns false if the platform has no support for processor affinity.
+         */
+        static bool getThreadAffinity(ThreadHandle* thread, std::vector<int>& cpus);
+
+        /**
+         * Fills in the set of processors that belong to the given NUMA node.
+         *
+         * @returns false if the node is unknown or the platform can't report its processors.
+         */
+        static bool getNumaNodeProcessors(int node, std::vector<int>& cpus);
+
         static const char* getThreadName(ThreadHandle* thread);
 
         static void setThreadName(ThreadHandle* thread, const char* name);
@@ -48,6 +48,8 @@
 #if HAVE_TIME_H
 #include <time.h>
 #endif
+#include <stdio.h>
+#include <stdlib.h>
 
 using namespace decaf;
 using namespace decaf::lang;
@@ -458,6 +460,115 @@ void PlatformThread::setStackSize(decaf_thread_t thread DECAF_UNUSED, long long
     pthread_attr_destroy( &attributes );
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool PlatformThread::setAffinity(decaf_thread_t thread DECAF_UNUSED, const std::vector<int>& cpus DECAF_UNUSED) {
+
+#if defined(HAVE_PTHREAD_SETAFFINITY_NP) && defined(CPU_SETSIZE)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+
+    std::vector<int>::const_iterator iter = cpus.begin();
+    for (; iter != cpus.end(); ++iter) {
+        if (*iter < 0 || *iter >= CPU_SETSIZE) {
+            throw RuntimeException(__FILE__, __LINE__,
+                "Processor index %d is outside the supported range [0, %d).", *iter, CPU_SETSIZE);
+        }
+        CPU_SET(*iter, &cpuSet);
+    }
+
+    int result = pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpuSet);
+    if (result != 0) {
+        throw RuntimeException(__FILE__, __LINE__,
+            "Failed to set Thread affinity, error value is: %d.", result);
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool PlatformThread::getAffinity(decaf_thread_t thread DECAF_UNUSED, std::vector<int>& cpus DECAF_UNUSED) {
+
+#if defined(HAVE_PTHREAD_GETAFFINITY_NP) && defined(CPU_SETSIZE)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+
+    if (pthread_getaffinity_np(thread, sizeof(cpu_set_t), &cpuSet) != 0) {
+        return false;
+    }
+
+    cpus.clear();
+    for (int i = 0; i < CPU_SETSIZE; ++i) {
+        if (CPU_ISSET(i, &cpuSet)) {
+            cpus.push_back(i);
+        }
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool PlatformThread::getNumaNodeProcessors(int node DECAF_UNUSED, std::vector<int>& cpus DECAF_UNUSED) {
+
+#ifdef __linux__
+    if (node < 0) {
+        return false;
+    }
+
+    // The kernel publishes each node's processors as a list of ranges, e.g. "0-3,8-11".
+    char path[64];
+    ::snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+
+    FILE* file = ::fopen(path, "r");
+    if (file == NULL) {
+        return false;
+    }
+
+    char buffer[1024];
+    char* line = ::fgets(buffer, sizeof(buffer), file);
+    ::fclose(file);
+
+    if (line == NULL) {
+        return false;
+    }
+
+    cpus.clear();
+
+    char* cursor = line;
+    while (*cursor != '\0' && *cursor != '\n') {
+        char* end = NULL;
+        long first = ::strtol(cursor, &end, 10);
+        if (end == cursor) {
+            break;
+        }
+
+        long last = first;
+        cursor = end;
+        if (*cursor == '-') {
+            last = ::strtol(cursor + 1, &end, 10);
+            cursor = end;
+        }
+
+        for (long cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back((int) cpu);
+        }
+
+        if (*cursor == ',') {
+            cursor++;
+        }
+    }
+
+    return !cpus.empty();
+#else
+    return false;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void PlatformThread::yeild() {
 
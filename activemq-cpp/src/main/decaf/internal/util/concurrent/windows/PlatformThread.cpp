@@ -422,6 +422,78 @@ long long PlatformThread::getStackSize(decaf_thread_t thread DECAF_UNUSED) {
 void PlatformThread::setStackSize(decaf_thread_t thread DECAF_UNUSED, long long stackSize DECAF_UNUSED) {
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool PlatformThread::setAffinity(decaf_thread_t thread, const std::vector<int>& cpus) {
+
+    const int maxProcessors = (int) (sizeof(DWORD_PTR) * 8);
+    DWORD_PTR mask = 0;
+
+    std::vector<int>::const_iterator iter = cpus.begin();
+    for (; iter != cpus.end(); ++iter) {
+        if (*iter < 0 || *iter >= maxProcessors) {
+            throw RuntimeException(__FILE__, __LINE__,
+                "Processor index %d is outside the supported range [0, %d).", *iter, maxProcessors);
+        }
+        mask |= ((DWORD_PTR) 1) << *iter;
+    }
+
+    if (::SetThreadAffinityMask(thread, mask) == 0) {
+        throw RuntimeException(__FILE__, __LINE__,
+            "Failed to set Thread affinity, error value is: %d.", (int) ::GetLastError());
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool PlatformThread::getAffinity(decaf_thread_t thread, std::vector<int>& cpus) {
+
+    DWORD_PTR processMask = 0;
+    DWORD_PTR systemMask = 0;
+    if (!::GetProcessAffinityMask(::GetCurrentProcess(), &processMask, &systemMask)) {
+        return false;
+    }
+
+    // Windows has no direct query so the previous mask returned from a set is used
+    // and then immediately restored.
+    DWORD_PTR mask = ::SetThreadAffinityMask(thread, processMask);
+    if (mask == 0) {
+        return false;
+    }
+    ::SetThreadAffinityMask(thread, mask);
+
+    cpus.clear();
+    for (int i = 0; i < (int) (sizeof(DWORD_PTR) * 8); ++i) {
+        if ((mask >> i) & 1) {
+            cpus.push_back(i);
+        }
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool PlatformThread::getNumaNodeProcessors(int node, std::vector<int>& cpus) {
+
+    if (node < 0 || node > 0xFF) {
+        return false;
+    }
+
+    ULONGLONG mask = 0;
+    if (!::GetNumaNodeProcessorMask((UCHAR) node, &mask) || mask == 0) {
+        return false;
+    }
+
+    cpus.clear();
+    for (int i = 0; i < 64; ++i) {
+        if ((mask >> i) & 1) {
+            cpus.push_back(i);
+        }
+    }
+
+    return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void PlatformThread::yeild() {
     SwitchToThread();
@@ -20,6 +20,8 @@
 #include <decaf/lang/System.h>
 #include <decaf/lang/Math.h>
 
+#include <vector>
+
 using namespace std;
 using namespace decaf;
 using namespace decaf::io;
@@ -196,3 +198,46 @@ void BufferedOutputStream::doWriteArrayBounded(const unsigned char* buffer, int
     DECAF_CATCH_RETHROW(IndexOutOfBoundsException)
     DECAF_CATCHALL_THROW(IOException)
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void BufferedOutputStream::doWriteGathering(const unsigned char* const* buffers, const int* lengths, int count) {
+
+    try {
+
+        if (isClosed()) {
+            throw IOException(__FILE__, __LINE__, "BufferedOutputStream::write - Stream is clsoed");
+        }
+
+        long long total = 0;
+        for (int i = 0; i < count; ++i) {
+            total += lengths[i];
+        }
+
+        // Arrays that fit in the space left in the buffer are copied as usual, otherwise
+        // the buffered bytes are passed on ahead of them so that nothing is copied.
+        if (total < (long long) (bufferSize - tail)) {
+            OutputStream::doWriteGathering(buffers, lengths, count);
+            return;
+        }
+
+        std::vector<const unsigned char*> regions;
+        std::vector<int> sizes;
+        regions.reserve(count + 1);
+        sizes.reserve(count + 1);
+
+        if (this->head != this->tail) {
+            regions.push_back(this->buffer + this->head);
+            sizes.push_back(this->tail - this->head);
+        }
+
+        regions.insert(regions.end(), buffers, buffers + count);
+        sizes.insert(sizes.end(), lengths, lengths + count);
+
+        this->outputStream->writeGathering(&regions[0], &sizes[0], (int) regions.size());
+        this->head = this->tail = 0;
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_RETHROW(NullPointerException)
+    DECAF_CATCH_RETHROW(IndexOutOfBoundsException)
+    DECAF_CATCHALL_THROW(IOException)
+}
@@ -97,6 +97,8 @@ namespace io{
 
         virtual void doWriteArrayBounded(const unsigned char* buffer, int size, int offset, int length);
 
+        virtual void doWriteGathering(const unsigned char* const* buffers, const int* lengths, int count);
+
     private:
 
         /**
@@ -35,7 +35,7 @@ using namespace decaf::lang::exceptions;
 
 ////////////////////////////////////////////////////////////////////////////////
 DataInputStream::DataInputStream(InputStream* inputStream, bool own) :
-    FilterInputStream(inputStream, own), buffer() {
+    FilterInputStream(inputStream, own), buffer(), bytesRead(0) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -207,6 +207,8 @@ std::string DataInputStream::readString() {
                 throw EOFException(__FILE__, __LINE__, "DataInputStream::readString - Reached EOF");
             }
 
+            this->bytesRead++;
+
             // if null is found we are done
             if (buffer[pos] == '\0') {
                 break;
@@ -341,8 +343,11 @@ std::string DataInputStream::readLine() {
                     return "";
                 }
                 return line;
+            }
 
-            } else if (nextByte == (unsigned char) '\r') {
+            this->bytesRead++;
+
+            if (nextByte == (unsigned char) '\r') {
 
                 PushbackInputStream* pbStream = dynamic_cast<PushbackInputStream*>(inputStream);
 
@@ -353,6 +358,7 @@ std::string DataInputStream::readLine() {
                     }
 
                     pbStream->unread((unsigned char) nextByte);
+                    this->bytesRead--;
                     return line;
                 }
 
@@ -378,6 +384,7 @@ std::string DataInputStream::readLine() {
                     }
 
                     pbStream->unread((unsigned char) nextByte);
+                    this->bytesRead--;
                     return line;
                 }
 
@@ -425,6 +432,7 @@ void DataInputStream::readFully(unsigned char* buffer, int size, int offset, int
                 throw EOFException(__FILE__, __LINE__, "Reached EOF");
             }
             n += count;
+            this->bytesRead += count;
         }
     }
     DECAF_CATCH_RETHROW(NullPointerException)
@@ -450,6 +458,8 @@ long long DataInputStream::skipBytes(long long num) {
             total += cur;
         }
 
+        this->bytesRead += total;
+
         return total;
     }
     DECAF_CATCH_RETHROW(IOException)
@@ -468,6 +478,7 @@ void DataInputStream::readAllData(unsigned char* buffer, int length) {
                 throw EOFException(__FILE__, __LINE__, "DataInputStream::readLong - Reached EOF");
             }
             n += count;
+            this->bytesRead += count;
         } while (n < length);
     }
     DECAF_CATCH_RETHROW(EOFException)
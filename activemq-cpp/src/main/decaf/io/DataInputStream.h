@@ -50,6 +50,9 @@ namespace io{
         // higher order C++ primitives.
         unsigned char buffer[8];
 
+        // The number of bytes read through the DataInput methods so far.
+        long long bytesRead;
+
     private:
 
         DataInputStream(const DataInputStream&);
@@ -68,6 +71,17 @@ namespace io{
 
         virtual ~DataInputStream();
 
+        /**
+         * Returns the number of bytes read from this data input stream so far through its
+         * DataInput methods, this is the counterpart of DataOutputStream::size.  Bytes read
+         * with the plain InputStream read methods are not counted.
+         *
+         * @return the number of bytes read so far.
+         */
+        long long getBytesRead() const {
+            return this->bytesRead;
+        }
+
     public:
         // DataInput
 
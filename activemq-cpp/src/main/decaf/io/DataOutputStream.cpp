@@ -337,3 +337,22 @@ unsigned int DataOutputStream::countUTFLength(const std::string& value) {
 
     return utfCount;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void DataOutputStream::doWriteGathering(const unsigned char* const* buffers, const int* lengths, int count) {
+
+    if (isClosed()) {
+        throw IOException(__FILE__, __LINE__, "DataOutputStream::write - Base stream is Null");
+    }
+
+    try {
+        outputStream->writeGathering(buffers, lengths, count);
+        for (int i = 0; i < count; ++i) {
+            written += lengths[i];
+        }
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_RETHROW(NullPointerException)
+    DECAF_CATCH_RETHROW(IndexOutOfBoundsException)
+    DECAF_CATCHALL_THROW(IOException)
+}
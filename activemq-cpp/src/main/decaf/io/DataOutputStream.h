@@ -134,6 +134,8 @@ namespace io{
 
         virtual void doWriteArrayBounded(const unsigned char* buffer, int size, int offset, int length);
 
+        virtual void doWriteGathering(const unsigned char* const* buffers, const int* lengths, int count);
+
     private:
 
         // Determine the encoded length of a string when written as modified UTF-8
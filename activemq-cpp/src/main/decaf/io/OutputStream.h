@@ -126,6 +126,28 @@ namespace io{
          */
         virtual void write(const unsigned char* buffer, int size, int offset, int length);
 
+        /**
+         * Writes a sequence of byte arrays to the output stream in order, as though each
+         * had been passed to write in turn.  Streams that sit in front of a socket use this
+         * to hand all of the arrays to the operating system in a single gathering write
+         * rather than first copying them into one contiguous buffer.
+         *
+         * The default implementation of this method calls the doWriteGathering method which
+         * writes each array with the doWriteArrayBounded method.
+         *
+         * @param buffers
+         *      The arrays of bytes to write.
+         * @param lengths
+         *      The number of bytes to write from each array.
+         * @param count
+         *      The number of arrays passed.
+         *
+         * @throws IOException if an I/O error occurs.
+         * @throws NullPointerException thrown if buffers or lengths is Null.
+         * @throws IndexOutOfBoundsException if count or one of the lengths is negative.
+         */
+        void writeGathering(const unsigned char* const* buffers, const int* lengths, int count);
+
         /**
          * Output a String representation of this object.
          *
@@ -143,6 +165,8 @@ namespace io{
 
         virtual void doWriteArrayBounded(const unsigned char* buffer, int size, int offset, int length);
 
+        virtual void doWriteGathering(const unsigned char* const* buffers, const int* lengths, int count);
+
     public:
 
         virtual void lock() {
@@ -30,6 +30,7 @@
 #include <decaf/lang/exceptions/RuntimeException.h>
 #include <decaf/lang/exceptions/NullPointerException.h>
 #include <decaf/lang/exceptions/IllegalThreadStateException.h>
+#include <decaf/lang/exceptions/UnsupportedOperationException.h>
 #include <decaf/util/concurrent/TimeUnit.h>
 #include <decaf/util/concurrent/Mutex.h>
 #include <decaf/util/concurrent/Executors.h>
@@ -257,6 +258,52 @@ int Thread::getPriority() const {
     return Threading::getThreadPriority(this->properties->handle);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void Thread::setAffinity(const std::vector<int>& cpus) {
+
+    if (cpus.empty()) {
+        throw IllegalArgumentException(
+            __FILE__, __LINE__, "Thread::setAffinity - At least one processor must be given");
+    }
+
+    std::vector<int>::const_iterator iter = cpus.begin();
+    for (; iter != cpus.end(); ++iter) {
+        if (*iter < 0) {
+            throw IllegalArgumentException(
+                __FILE__, __LINE__, "Thread::setAffinity - Specified processor {%d} is invalid", *iter);
+        }
+    }
+
+    if (!Threading::setThreadAffinity(this->properties->handle, cpus)) {
+        throw UnsupportedOperationException(
+            __FILE__, __LINE__, "Thread::setAffinity - Not supported on this platform");
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<int> Thread::getAffinity() const {
+
+    std::vector<int> cpus;
+    if (!Threading::getThreadAffinity(this->properties->handle, cpus)) {
+        throw UnsupportedOperationException(
+            __FILE__, __LINE__, "Thread::getAffinity - Not supported on this platform");
+    }
+
+    return cpus;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Thread::setNumaNode(int node) {
+
+    std::vector<int> cpus;
+    if (!Threading::getNumaNodeProcessors(node, cpus)) {
+        throw IllegalArgumentException(
+            __FILE__, __LINE__, "Thread::setNumaNode - Specified node {%d} is not available", node);
+    }
+
+    this->setAffinity(cpus);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void Thread::setUncaughtExceptionHandler(UncaughtExceptionHandler* handler) {
     this->properties->exHandler = handler;
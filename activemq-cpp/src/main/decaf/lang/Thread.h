@@ -25,6 +25,8 @@
 #include <decaf/lang/Runnable.h>
 #include <decaf/util/Config.h>
 
+#include <vector>
+
 namespace decaf{
 namespace internal{
 namespace util{
@@ -289,6 +291,40 @@ namespace lang
          */
         void setPriority(int value);
 
+        /**
+         * Restricts this Thread to run only on the processors whose indices are given.  The
+         * affinity can be assigned before the Thread is started so that it never runs on any
+         * other processor.  An empty set is not allowed.
+         *
+         * @param cpus the zero based indices of the processors the Thread may run on.
+         *
+         * @throws IllegalArgumentException if the set is empty or an index is invalid.
+         * @throws UnsupportedOperationException if the platform can't bind threads to processors.
+         * @throws RuntimeException if the operating system rejects the request.
+         */
+        void setAffinity(const std::vector<int>& cpus);
+
+        /**
+         * Gets the set of processors this Thread is currently allowed to run on.
+         *
+         * @return the zero based indices of the processors the Thread may run on.
+         *
+         * @throws UnsupportedOperationException if the platform can't report thread affinity.
+         */
+        std::vector<int> getAffinity() const;
+
+        /**
+         * Restricts this Thread to run only on the processors that belong to the given
+         * NUMA node, memory the Thread allocates after this call then tends to come from
+         * that node's local memory.
+         *
+         * @param node the zero based index of the NUMA node.
+         *
+         * @throws IllegalArgumentException if the node is not known to the platform.
+         * @throws UnsupportedOperationException if the platform can't bind threads to processors.
+         */
+        void setNumaNode(int node);
+
         /**
          * Set the handler invoked when this thread abruptly terminates due to an uncaught exception.
          *
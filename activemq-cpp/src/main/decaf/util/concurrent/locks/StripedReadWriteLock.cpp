@@ -0,0 +1,501 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StripedReadWriteLock.h"
+
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/ThreadLocal.h>
+#include <decaf/lang/exceptions/IllegalMonitorStateException.h>
+#include <decaf/lang/exceptions/UnsupportedOperationException.h>
+#include <decaf/util/concurrent/Concurrent.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/TimeUnit.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::atomic;
+using namespace decaf::util::concurrent::locks;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    /**
+     * Number of reader stripes, must be a power of two.
+     */
+    const int NUM_STRIPES = 16;
+
+    /**
+     * Size of the padding that keeps each stripe on its own cache line.
+     */
+    const int CACHE_LINE_SIZE = 64;
+
+    /**
+     * One reader counter, padded out so that two stripes never share a cache line.
+     */
+    struct ReaderStripe {
+        AtomicInteger count;
+        char pad[CACHE_LINE_SIZE > sizeof(AtomicInteger) ? CACHE_LINE_SIZE - sizeof(AtomicInteger) : 1];
+
+        ReaderStripe() : count() {}
+    };
+
+    /**
+     * The per thread read state, the stripe is fixed the first time a thread uses the
+     * lock so that the same thread always lands on the same cache line.
+     */
+    struct ReadHolds {
+        int count;
+        int stripe;
+
+        ReadHolds() : count(0), stripe(0) {}
+    };
+
+    class ThreadLocalReadHolds : public ThreadLocal<ReadHolds> {
+    public:
+
+        virtual ~ThreadLocalReadHolds() {}
+
+        virtual ReadHolds initialValue() const {
+            ReadHolds holds;
+            holds.stripe = (int)((unsigned long long)Thread::currentThread()->getId() & (NUM_STRIPES - 1));
+            return holds;
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace decaf {
+namespace util {
+namespace concurrent {
+namespace locks {
+
+    class StripedReadWriteLockImpl {
+    private:
+
+        StripedReadWriteLockImpl(const StripedReadWriteLockImpl&);
+        StripedReadWriteLockImpl& operator=(const StripedReadWriteLockImpl&);
+
+    public:
+
+        ReaderStripe stripes[NUM_STRIPES];
+
+        // Set while a writer is waiting for the readers to drain or holds the lock.
+        AtomicInteger writerActive;
+
+        Thread* volatile writeOwner;
+        int writeHolds;
+
+        // Used to park readers and writers, never taken on the uncontended read path.
+        Mutex monitor;
+
+        ThreadLocalReadHolds readHolds;
+
+        Lock* readLock;
+        Lock* writeLock;
+
+    public:
+
+        StripedReadWriteLockImpl();
+
+        ~StripedReadWriteLockImpl();
+
+        int getReadLockCount() const {
+            int result = 0;
+            for (int i = 0; i < NUM_STRIPES; ++i) {
+                result += stripes[i].count.get();
+            }
+            return result;
+        }
+
+        bool acquireShared(long long timeout, bool interruptible) {
+
+            ReadHolds& holds = readHolds.get();
+            if (holds.count > 0) {
+                holds.count++;
+                return true;
+            }
+
+            AtomicInteger& stripe = stripes[holds.stripe].count;
+
+            if (writeOwner == Thread::currentThread()) {
+                stripe.incrementAndGet();
+                holds.count = 1;
+                return true;
+            }
+
+            if (interruptible && Thread::interrupted()) {
+                throw InterruptedException(__FILE__, __LINE__, "Thread interrupted");
+            }
+
+            long long deadline = timeout > 0 ? System::currentTimeMillis() + timeout : 0;
+            bool interrupted = false;
+
+            while (true) {
+
+                stripe.incrementAndGet();
+                if (writerActive.get() == 0) {
+                    holds.count = 1;
+                    break;
+                }
+
+                // A writer is draining or holds the lock, back out so it can proceed.
+                stripe.decrementAndGet();
+
+                try {
+                    if (!awaitWriterRelease(timeout, deadline)) {
+                        return false;
+                    }
+                } catch (InterruptedException& ex) {
+                    if (interruptible) {
+                        throw;
+                    }
+                    interrupted = true;
+                }
+            }
+
+            if (interrupted) {
+                Thread::currentThread()->interrupt();
+            }
+
+            return true;
+        }
+
+        void releaseShared() {
+
+            ReadHolds& holds = readHolds.get();
+            if (holds.count <= 0) {
+                throw IllegalMonitorStateException(
+                    __FILE__, __LINE__, "Attempt to unlock read lock, not locked by current thread");
+            }
+
+            if (--holds.count == 0) {
+                stripes[holds.stripe].count.decrementAndGet();
+                if (writerActive.get() != 0) {
+                    synchronized(&monitor) {
+                        monitor.notifyAll();
+                    }
+                }
+            }
+        }
+
+        bool acquireExclusive(long long timeout, bool interruptible) {
+
+            Thread* current = Thread::currentThread();
+            if (writeOwner == current) {
+                writeHolds++;
+                return true;
+            }
+
+            if (readHolds.get().count > 0) {
+                throw IllegalMonitorStateException(
+                    __FILE__, __LINE__, "Cannot acquire the write lock while holding the read lock");
+            }
+
+            if (interruptible && Thread::interrupted()) {
+                throw InterruptedException(__FILE__, __LINE__, "Thread interrupted");
+            }
+
+            long long deadline = timeout > 0 ? System::currentTimeMillis() + timeout : 0;
+            bool interrupted = false;
+            bool acquired = false;
+
+            synchronized(&monitor) {
+
+                while (!acquired) {
+                    try {
+                        acquired = doAcquireExclusive(current, timeout, deadline);
+                        if (!acquired) {
+                            break;
+                        }
+                    } catch (InterruptedException& ex) {
+                        if (interruptible) {
+                            throw;
+                        }
+                        interrupted = true;
+                    }
+                }
+            }
+
+            if (interrupted) {
+                current->interrupt();
+            }
+
+            return acquired;
+        }
+
+        void releaseExclusive() {
+
+            if (writeOwner != Thread::currentThread()) {
+                throw IllegalMonitorStateException(
+                    __FILE__, __LINE__, "Attempt to unlock write lock, not locked by current thread");
+            }
+
+            if (--writeHolds == 0) {
+                synchronized(&monitor) {
+                    writeOwner = NULL;
+                    writerActive.set(0);
+                    monitor.notifyAll();
+                }
+            }
+        }
+
+    private:
+
+        /**
+         * Waits for the monitor to be signaled, returning false if the timeout has
+         * already expired.  A timeout of zero means don't wait, negative waits forever.
+         */
+        bool awaitSignal(long long timeout, long long deadline) {
+
+            if (timeout == 0) {
+                return false;
+            } else if (timeout < 0) {
+                monitor.wait();
+            } else {
+                long long remaining = deadline - System::currentTimeMillis();
+                if (remaining <= 0) {
+                    return false;
+                }
+                monitor.wait(remaining);
+            }
+
+            return true;
+        }
+
+        bool awaitWriterRelease(long long timeout, long long deadline) {
+
+            synchronized(&monitor) {
+                // Wake a writer that could be waiting on this reader to drain.
+                monitor.notifyAll();
+                while (writerActive.get() != 0) {
+                    if (!awaitSignal(timeout, deadline)) {
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        // Called with the monitor held, on failure the writer flag is left as it was found.
+        bool doAcquireExclusive(Thread* current, long long timeout, long long deadline) {
+
+            while (!writerActive.compareAndSet(0, 1)) {
+                if (!awaitSignal(timeout, deadline)) {
+                    return false;
+                }
+            }
+
+            try {
+                while (getReadLockCount() != 0) {
+                    if (!awaitSignal(timeout, deadline)) {
+                        writerActive.set(0);
+                        monitor.notifyAll();
+                        return false;
+                    }
+                }
+            } catch (InterruptedException& ex) {
+                writerActive.set(0);
+                monitor.notifyAll();
+                throw;
+            }
+
+            writeOwner = current;
+            writeHolds = 1;
+
+            return true;
+        }
+    };
+
+}}}}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class ReadLock : public decaf::util::concurrent::locks::Lock {
+    private:
+
+        ReadLock(const ReadLock&);
+        ReadLock& operator= (const ReadLock&);
+
+    private:
+
+        StripedReadWriteLockImpl* impl;
+
+    public:
+
+        ReadLock(StripedReadWriteLockImpl* impl) : Lock(), impl(impl) {}
+
+        virtual ~ReadLock() {}
+
+        virtual void lock() {
+            impl->acquireShared(-1, false);
+        }
+
+        virtual void lockInterruptibly() {
+            impl->acquireShared(-1, true);
+        }
+
+        virtual bool tryLock() {
+            return impl->acquireShared(0, false);
+        }
+
+        virtual bool tryLock(long long timeout, const TimeUnit& unit) {
+            long long millis = unit.toMillis(timeout);
+            return impl->acquireShared(millis > 0 ? millis : 0, true);
+        }
+
+        virtual void unlock() {
+            impl->releaseShared();
+        }
+
+        virtual Condition* newCondition() {
+            throw UnsupportedOperationException(
+                __FILE__, __LINE__, "Read locks do not support conditions");
+        }
+
+        virtual std::string toString() const {
+            return std::string("ReadLock ") + "[Read locks = " + Integer::toString(impl->getReadLockCount()) + "]";
+        }
+    };
+
+    class WriteLock : public decaf::util::concurrent::locks::Lock {
+    private:
+
+        WriteLock(const WriteLock&);
+        WriteLock& operator= (const WriteLock&);
+
+    private:
+
+        StripedReadWriteLockImpl* impl;
+
+    public:
+
+        WriteLock(StripedReadWriteLockImpl* impl) : Lock(), impl(impl) {}
+
+        virtual ~WriteLock() {}
+
+        virtual void lock() {
+            impl->acquireExclusive(-1, false);
+        }
+
+        virtual void lockInterruptibly() {
+            impl->acquireExclusive(-1, true);
+        }
+
+        virtual bool tryLock() {
+            return impl->acquireExclusive(0, false);
+        }
+
+        virtual bool tryLock(long long timeout, const TimeUnit& unit) {
+            long long millis = unit.toMillis(timeout);
+            return impl->acquireExclusive(millis > 0 ? millis : 0, true);
+        }
+
+        virtual void unlock() {
+            impl->releaseExclusive();
+        }
+
+        virtual Condition* newCondition() {
+            throw UnsupportedOperationException(
+                __FILE__, __LINE__, "Write locks of a StripedReadWriteLock do not support conditions");
+        }
+
+        virtual std::string toString() const {
+            Thread* owner = impl->writeOwner;
+            return std::string("WriteLock ") +
+                (owner == NULL ? "[Unlocked]" : std::string("[Locked by thread ") + owner->getName() + "]");
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+StripedReadWriteLockImpl::StripedReadWriteLockImpl() :
+    stripes(), writerActive(), writeOwner(NULL), writeHolds(0), monitor(), readHolds(), readLock(NULL), writeLock(NULL) {
+
+    this->readLock = new ReadLock(this);
+    this->writeLock = new WriteLock(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+StripedReadWriteLockImpl::~StripedReadWriteLockImpl() {
+    try {
+        delete this->readLock;
+        delete this->writeLock;
+    }
+    DECAF_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+StripedReadWriteLock::StripedReadWriteLock() : ReadWriteLock(), impl(new StripedReadWriteLockImpl) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+StripedReadWriteLock::~StripedReadWriteLock() {
+    try {
+        delete this->impl;
+    }
+    DECAF_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+decaf::util::concurrent::locks::Lock& StripedReadWriteLock::readLock() {
+    return *(this->impl->readLock);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+decaf::util::concurrent::locks::Lock& StripedReadWriteLock::writeLock() {
+    return *(this->impl->writeLock);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool StripedReadWriteLock::isWriteLocked() const {
+    return this->impl->writeOwner != NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool StripedReadWriteLock::isWriteLockedByCurrentThread() const {
+    return this->impl->writeOwner == Thread::currentThread();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int StripedReadWriteLock::getWriteHoldCount() const {
+    return isWriteLockedByCurrentThread() ? this->impl->writeHolds : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int StripedReadWriteLock::getReadHoldCount() const {
+    return this->impl->readHolds.get().count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int StripedReadWriteLock::getReadLockCount() const {
+    return this->impl->getReadLockCount();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string StripedReadWriteLock::toString() const {
+    return std::string("StripedReadWriteLock") +
+           "[Write locks = " + Integer::toString(isWriteLocked() ? this->impl->writeHolds : 0) +
+           ", Read locks = " + Integer::toString(getReadLockCount()) + "]";
+}
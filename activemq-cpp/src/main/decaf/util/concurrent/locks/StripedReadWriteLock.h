@@ -0,0 +1,128 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_UTIL_CONCURRENT_LOCKS_STRIPEDREADWRITELOCK_H_
+#define _DECAF_UTIL_CONCURRENT_LOCKS_STRIPEDREADWRITELOCK_H_
+
+#include <decaf/util/Config.h>
+
+#include <decaf/util/concurrent/locks/ReadWriteLock.h>
+
+namespace decaf {
+namespace util {
+namespace concurrent {
+namespace locks {
+
+    class StripedReadWriteLockImpl;
+
+    /**
+     * A reader biased ReadWriteLock intended for state that is read on every operation
+     * but only rarely modified, such as the registry of Sessions held by a Connection.
+     *
+     * Readers are counted on a set of striped counters, each on its own cache line, and
+     * each thread always uses the same stripe, so concurrent readers running on different
+     * threads do not contend on a single shared state word the way they do with the
+     * ReentrantReadWriteLock.  A reader that already holds the read lock re-enters it by
+     * only updating a thread local hold count.
+     *
+     * A writer first announces itself which stops new readers from entering, and then waits
+     * for the reader counts on all the stripes to drain to zero, writers are therefore more
+     * expensive than with the ReentrantReadWriteLock and the lock should not be used where
+     * writes are frequent.
+     *
+     * The write lock is reentrant and its holder may also acquire the read lock, a thread
+     * that holds the read lock must not try to acquire the write lock as this will deadlock.
+     * Neither the read nor the write lock support Conditions.
+     *
+     * @since 1.0
+     */
+    class DECAF_API StripedReadWriteLock : public ReadWriteLock {
+    private:
+
+        StripedReadWriteLockImpl* impl;
+
+    private:
+
+        StripedReadWriteLock(const StripedReadWriteLock&);
+        StripedReadWriteLock& operator=(const StripedReadWriteLock&);
+
+    public:
+
+        StripedReadWriteLock();
+
+        virtual ~StripedReadWriteLock();
+
+    public:
+
+        /**
+         * {@inheritDoc}
+         */
+        virtual decaf::util::concurrent::locks::Lock& readLock();
+
+        /**
+         * {@inheritDoc}
+         */
+        virtual decaf::util::concurrent::locks::Lock& writeLock();
+
+        /**
+         * Queries if the write lock is held by any thread.
+         *
+         * @returns true if any thread holds the write lock and false otherwise.
+         */
+        bool isWriteLocked() const;
+
+        /**
+         * Queries if the write lock is held by the current thread.
+         *
+         * @returns true if the current thread holds the write lock and false otherwise.
+         */
+        bool isWriteLockedByCurrentThread() const;
+
+        /**
+         * Queries the number of reentrant write holds on this lock by the current thread.
+         *
+         * @returns the number of holds on the write lock by the current thread, or zero.
+         */
+        int getWriteHoldCount() const;
+
+        /**
+         * Queries the number of reentrant read holds on this lock by the current thread.
+         *
+         * @returns the number of holds on the read lock by the current thread, or zero.
+         */
+        int getReadHoldCount() const;
+
+        /**
+         * Queries the number of read locks held for this lock, the value is summed over all
+         * the reader stripes and is intended for monitoring only.
+         *
+         * @returns the number of read locks held.
+         */
+        int getReadLockCount() const;
+
+        /**
+         * Returns a string identifying this lock, as well as its lock state.
+         *
+         * @returns a string identifying this lock, as well as its lock state.
+         */
+        std::string toString() const;
+
+    };
+
+}}}}
+
+#endif /* _DECAF_UTIL_CONCURRENT_LOCKS_STRIPEDREADWRITELOCK_H_ */
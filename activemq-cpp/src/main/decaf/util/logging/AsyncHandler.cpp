@@ -0,0 +1,478 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AsyncHandler.h"
+
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/ThreadLocal.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/lang/exceptions/ExceptionDefines.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/Concurrent.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+#include <decaf/util/concurrent/atomic/AtomicBoolean.h>
+#include <decaf/util/logging/Level.h>
+#include <decaf/util/logging/LogRecord.h>
+
+#include <vector>
+#include <sstream>
+#include <algorithm>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::atomic;
+using namespace decaf::util::logging;
+
+////////////////////////////////////////////////////////////////////////////////
+const int AsyncHandler::DEFAULT_STAGING_CAPACITY = 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // How long the writer sleeps when it finds nothing staged before it looks again,
+    // records staged while the writer sleeps wake it up early.
+    const long long WRITER_IDLE_WAIT = 100;
+
+    /**
+     * Single producer single consumer ring of staged records, the logging thread that
+     * owns the buffer only moves the tail and the writer thread only moves the head.
+     * The ring is marked retired when its owning thread exits, it is freed by the next
+     * drain that finds it empty.
+     */
+    class Staging {
+    private:
+
+        Staging( const Staging& );
+        Staging& operator= ( const Staging& );
+
+    public:
+
+        LogRecord** slots;
+        unsigned int mask;
+        AtomicInteger head;
+        AtomicInteger tail;
+        AtomicBoolean retired;
+
+        Staging( int capacity ) : slots(new LogRecord*[capacity]), mask(capacity - 1), head(), tail(), retired(false) {
+            for( int i = 0; i < capacity; ++i ) {
+                this->slots[i] = NULL;
+            }
+        }
+
+        ~Staging() {
+            for( unsigned int i = 0; i <= this->mask; ++i ) {
+                delete this->slots[i];
+            }
+            delete [] this->slots;
+        }
+
+        bool offer( LogRecord* record ) {
+
+            unsigned int position = (unsigned int) this->tail.get();
+            if( position - (unsigned int) this->head.get() > this->mask ) {
+                return false;
+            }
+
+            this->slots[position & this->mask] = record;
+            this->tail.incrementAndGet();
+            return true;
+        }
+
+        int drainTo( Handler* target ) {
+
+            int count = 0;
+            unsigned int position = (unsigned int) this->head.get();
+            unsigned int limit = (unsigned int) this->tail.get();
+
+            while( position != limit ) {
+
+                LogRecord* record = this->slots[position & this->mask];
+                this->slots[position & this->mask] = NULL;
+
+                try {
+                    target->publish( *record );
+                }
+                DECAF_CATCHALL_NOTHROW()
+
+                delete record;
+                this->head.incrementAndGet();
+                ++position;
+                ++count;
+            }
+
+            return count;
+        }
+    };
+
+    /**
+     * Holds each thread's staging ring, a thread that exits retires its ring so that the
+     * writer can free it once the records left in it have been published.
+     */
+    class StagingLocal : public ThreadLocal<Staging*> {
+    private:
+
+        StagingLocal( const StagingLocal& );
+        StagingLocal& operator= ( const StagingLocal& );
+
+    public:
+
+        StagingLocal() : ThreadLocal<Staging*>() {}
+
+        virtual ~StagingLocal() {}
+
+    protected:
+
+        virtual void doDelete( void* value ) {
+            if( value != NULL ) {
+                Staging* staging = *static_cast<Staging**>( value );
+                if( staging != NULL ) {
+                    staging->retired.set( true );
+                }
+            }
+
+            ThreadLocal<Staging*>::doDelete( value );
+        }
+    };
+
+    LogRecord* copyRecord( const LogRecord& record ) {
+
+        LogRecord* copy = new LogRecord();
+
+        copy->setLevel( record.getLevel() );
+        copy->setLoggerName( record.getLoggerName() );
+        copy->setSourceFile( record.getSourceFile() );
+        copy->setSourceLine( record.getSourceLine() );
+        copy->setSourceFunction( record.getSourceFunction() );
+        copy->setMessage( record.getMessage() );
+        copy->setTimestamp( record.getTimestamp() );
+        copy->setTreadId( record.getTreadId() );
+
+        if( record.getThrown() != NULL ) {
+            copy->setThrown( record.getThrown()->clone() );
+        }
+
+        return copy;
+    }
+
+    int roundUpToPowerOfTwo( int value ) {
+        int result = 1;
+        while( result < value ) {
+            result <<= 1;
+        }
+        return result;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace decaf{
+namespace util{
+namespace logging{
+
+    class AsyncHandlerImpl : public Runnable {
+    private:
+
+        AsyncHandlerImpl( const AsyncHandlerImpl& );
+        AsyncHandlerImpl& operator= ( const AsyncHandlerImpl& );
+
+    public:
+
+        Handler* target;
+        int capacity;
+
+        StagingLocal local;
+        std::vector<Staging*> stagings;
+        Mutex registry;
+
+        // Serializes the consumers of the staging buffers, normally this is only the
+        // writer but flush and close drain from the calling thread.
+        Mutex drainLock;
+        int reportedDrops;
+
+        Mutex wakeup;
+        AtomicBoolean sleeping;
+        AtomicBoolean closed;
+        AtomicInteger dropped;
+        Thread* writer;
+
+        AsyncHandlerImpl( Handler* target, int capacity ) :
+            target(target), capacity(capacity), local(), stagings(), registry(), drainLock(), reportedDrops(0),
+            wakeup(), sleeping(false), closed(false), dropped(), writer(NULL) {
+        }
+
+        virtual ~AsyncHandlerImpl() {
+
+            std::vector<Staging*>::iterator iter = this->stagings.begin();
+            for( ; iter != this->stagings.end(); ++iter ) {
+                delete *iter;
+            }
+
+            delete this->writer;
+            delete this->target;
+        }
+
+        Staging* getStaging() {
+
+            Staging*& staging = this->local.get();
+            if( staging == NULL ) {
+                staging = new Staging( this->capacity );
+                synchronized( &this->registry ) {
+                    this->stagings.push_back( staging );
+                }
+            }
+
+            return staging;
+        }
+
+        void startWriter() {
+            synchronized( &this->wakeup ) {
+                if( this->writer == NULL && !this->closed.get() ) {
+                    this->writer = new Thread( this, "decaf AsyncHandler Writer" );
+                    this->writer->start();
+                }
+            }
+        }
+
+        void wakeWriter() {
+            if( this->sleeping.compareAndSet( true, false ) ) {
+                synchronized( &this->wakeup ) {
+                    this->wakeup.notifyAll();
+                }
+            }
+        }
+
+        void stopWriter() {
+
+            Thread* thread = NULL;
+
+            synchronized( &this->wakeup ) {
+                this->wakeup.notifyAll();
+                thread = this->writer;
+            }
+
+            if( thread != NULL && thread != Thread::currentThread() ) {
+                thread->join();
+            }
+        }
+
+        int drain() {
+
+            int count = 0;
+
+            synchronized( &this->drainLock ) {
+
+                std::vector<Staging*> current;
+                synchronized( &this->registry ) {
+                    current = this->stagings;
+                }
+
+                std::vector<Staging*> retired;
+
+                std::vector<Staging*>::iterator iter = current.begin();
+                for( ; iter != current.end(); ++iter ) {
+
+                    // Checked before draining, a retired ring's owner has exited so once
+                    // drained nothing more can be staged in it.
+                    bool done = (*iter)->retired.get();
+                    count += (*iter)->drainTo( this->target );
+                    if( done ) {
+                        retired.push_back( *iter );
+                    }
+                }
+
+                if( !retired.empty() ) {
+                    releaseStagings( retired );
+                }
+
+                int drops = this->dropped.get();
+                if( drops != this->reportedDrops ) {
+                    reportDrops( drops - this->reportedDrops );
+                    this->reportedDrops = drops;
+                    count++;
+                }
+
+                if( count > 0 ) {
+                    try {
+                        this->target->flush();
+                    }
+                    DECAF_CATCHALL_NOTHROW()
+                }
+            }
+
+            return count;
+        }
+
+        void releaseStagings( const std::vector<Staging*>& retired ) {
+
+            synchronized( &this->registry ) {
+                std::vector<Staging*>::const_iterator iter = retired.begin();
+                for( ; iter != retired.end(); ++iter ) {
+                    this->stagings.erase( std::remove( this->stagings.begin(), this->stagings.end(), *iter ),
+                                          this->stagings.end() );
+                }
+            }
+
+            std::vector<Staging*>::const_iterator iter = retired.begin();
+            for( ; iter != retired.end(); ++iter ) {
+                delete *iter;
+            }
+        }
+
+        void reportDrops( int drops ) {
+
+            std::ostringstream message;
+            message << "AsyncHandler discarded " << drops
+                    << " log records because the staging buffers were full";
+
+            LogRecord record;
+            record.setLevel( Level::WARNING );
+            record.setLoggerName( "decaf.util.logging.AsyncHandler" );
+            record.setSourceFile( __FILE__ );
+            record.setSourceLine( __LINE__ );
+            record.setMessage( message.str() );
+            record.setTimestamp( System::currentTimeMillis() );
+            record.setTreadId( Thread::currentThread()->getId() );
+
+            try {
+                this->target->publish( record );
+            }
+            DECAF_CATCHALL_NOTHROW()
+        }
+
+        virtual void run() {
+
+            while( !this->closed.get() ) {
+
+                if( drain() == 0 ) {
+                    synchronized( &this->wakeup ) {
+                        this->sleeping.set( true );
+                        if( !this->closed.get() ) {
+                            this->wakeup.wait( WRITER_IDLE_WAIT );
+                        }
+                        this->sleeping.set( false );
+                    }
+                }
+            }
+        }
+    };
+
+}}}
+
+////////////////////////////////////////////////////////////////////////////////
+AsyncHandler::AsyncHandler( Handler* target, int stagingCapacity ) : Handler(), impl(NULL) {
+
+    if( target == NULL ) {
+        throw NullPointerException(
+            __FILE__, __LINE__, "AsyncHandler target Handler cannot be NULL." );
+    }
+
+    if( stagingCapacity <= 0 ) {
+        throw IllegalArgumentException(
+            __FILE__, __LINE__, "AsyncHandler staging capacity must be greater than zero." );
+    }
+
+    this->impl = new AsyncHandlerImpl( target, roundUpToPowerOfTwo( stagingCapacity ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+AsyncHandler::~AsyncHandler() {
+    try {
+        this->close();
+    }
+    DECAF_CATCH_NOTHROW( Exception )
+    DECAF_CATCHALL_NOTHROW()
+
+    delete this->impl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandler::publish( const LogRecord& record ) {
+
+    if( this->impl->closed.get() || !this->isLoggable( record ) ) {
+        return;
+    }
+
+    Staging* staging = this->impl->getStaging();
+
+    LogRecord* copy = copyRecord( record );
+    if( !staging->offer( copy ) ) {
+        delete copy;
+        this->impl->dropped.incrementAndGet();
+        return;
+    }
+
+    if( this->impl->writer == NULL ) {
+        this->impl->startWriter();
+    } else {
+        this->impl->wakeWriter();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandler::flush() {
+
+    if( !this->impl->closed.get() ) {
+        this->impl->drain();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandler::close() {
+
+    if( !this->impl->closed.compareAndSet( false, true ) ) {
+        return;
+    }
+
+    this->impl->stopWriter();
+    this->impl->drain();
+
+    try {
+        this->impl->target->close();
+    }
+    DECAF_CATCH_NOTHROW( Exception )
+    DECAF_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Handler* AsyncHandler::getTarget() const {
+    return this->impl->target;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int AsyncHandler::getDroppedCount() const {
+    return this->impl->dropped.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int AsyncHandler::getStagingCapacity() const {
+    return this->impl->capacity;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int AsyncHandler::getStagingCount() const {
+
+    synchronized( &this->impl->registry ) {
+        return (int) this->impl->stagings.size();
+    }
+
+    return 0;
+}
@@ -0,0 +1,128 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_UTIL_LOGGING_ASYNCHANDLER_H_
+#define _DECAF_UTIL_LOGGING_ASYNCHANDLER_H_
+
+#include <decaf/util/Config.h>
+#include <decaf/util/logging/Handler.h>
+
+namespace decaf{
+namespace util{
+namespace logging{
+
+    class AsyncHandlerImpl;
+
+    /**
+     * A Handler that takes LogRecords off the logging thread and publishes them to a
+     * target Handler, such as a StreamHandler or ConsoleHandler, from a single background
+     * writer thread.
+     *
+     * Each thread that logs through the handler is given its own fixed size staging buffer
+     * which only that thread writes to and only the writer thread reads from, so publishing
+     * a record never takes a lock or waits on the target Handler's I/O.  When a thread's
+     * staging buffer is full the record is discarded and counted rather than blocking the
+     * caller, the writer reports the number of discarded records to the target Handler the
+     * next time it runs.
+     *
+     * The writer thread is started when the first record is published.  Formatting of the
+     * record's message is done by the target Handler on the writer thread.  Each staging
+     * buffer costs capacity pointers of memory, the buffer of a decaf Thread is freed by the
+     * writer once the thread has exited and its records have been published.  Buffers of
+     * threads not started through decaf are retained until the handler is destroyed.
+     *
+     * @since 1.0
+     */
+    class DECAF_API AsyncHandler : public Handler {
+    private:
+
+        AsyncHandlerImpl* impl;
+
+    private:
+
+        AsyncHandler( const AsyncHandler& );
+        AsyncHandler& operator= ( const AsyncHandler& );
+
+    public:
+
+        /**
+         * The default number of records each thread can have staged.
+         */
+        static const int DEFAULT_STAGING_CAPACITY;
+
+        /**
+         * Creates a new AsyncHandler that publishes to the given target, the handler takes
+         * ownership of the target and destroys it when it is destroyed.
+         *
+         * @param target
+         *      The Handler that the staged records are published to.
+         * @param stagingCapacity
+         *      The number of records each thread can have staged, rounded up to a power of two.
+         *
+         * @throws NullPointerException if the target is NULL.
+         * @throws IllegalArgumentException if the staging capacity is not positive.
+         */
+        AsyncHandler( Handler* target, int stagingCapacity = DEFAULT_STAGING_CAPACITY );
+
+        virtual ~AsyncHandler();
+
+        /**
+         * Stages a copy of the record for the writer thread, the record is discarded if the
+         * calling thread's staging buffer is full or the handler is closed.
+         *
+         * @param record
+         *      The LogRecord to publish.
+         */
+        virtual void publish( const LogRecord& record );
+
+        /**
+         * Writes out every record staged before this call and then flushes the target.
+         */
+        virtual void flush();
+
+        /**
+         * Stops the writer thread after it has written out all staged records and then
+         * closes the target Handler.
+         */
+        virtual void close();
+
+        /**
+         * @return the Handler that records are published to.
+         */
+        Handler* getTarget() const;
+
+        /**
+         * @return the total number of records discarded because a staging buffer was full.
+         */
+        int getDroppedCount() const;
+
+        /**
+         * @return the number of records each thread can have staged.
+         */
+        int getStagingCapacity() const;
+
+        /**
+         * @return the number of staging buffers currently held, one for each thread that
+         *         has published through this handler and not yet been freed.
+         */
+        int getStagingCount() const;
+
+    };
+
+}}}
+
+#endif /*_DECAF_UTIL_LOGGING_ASYNCHANDLER_H_*/
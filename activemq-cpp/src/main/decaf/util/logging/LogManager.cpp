@@ -17,9 +17,12 @@
 #include "LogManager.h"
 
 #include <decaf/lang/exceptions/RuntimeException.h>
+#include <decaf/lang/exceptions/ExceptionDefines.h>
 #include <decaf/util/StlMap.h>
+#include <decaf/util/Iterator.h>
 #include <decaf/util/logging/PropertiesChangeListener.h>
 #include <decaf/util/logging/Logger.h>
+#include <decaf/util/logging/Level.h>
 #include <decaf/util/concurrent/Concurrent.h>
 #include <decaf/util/Config.h>
 #include <decaf/io/InputStream.h>
@@ -45,7 +48,9 @@ namespace logging{
 
         StlMap<string, Logger*> loggers;
 
-        LogManagerInternals() : loggers() {}
+        Logger* root;
+
+        LogManagerInternals() : loggers(), root(NULL) {}
 
     };
 
@@ -55,16 +60,55 @@ namespace logging{
 namespace {
 
     LogManager* theManager = NULL;
+    int generation = 0;
+
+    class RootLogger : public Logger {
+    private:
+
+        RootLogger( const RootLogger& );
+        RootLogger& operator= ( const RootLogger& );
+
+    public:
+
+        RootLogger() : Logger( "" ) {}
+
+        virtual ~RootLogger() {}
+
+    };
+
+    bool isAncestorName( const std::string& ancestor, const std::string& name ) {
+        return name.length() > ancestor.length() &&
+               name.compare( 0, ancestor.length(), ancestor ) == 0 &&
+               name[ancestor.length()] == '.';
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 LogManager::LogManager() : listeners(), properties(), internal(new LogManagerInternals()) {
+
+    // Logging stays silent until the application configures it, the root Logger
+    // has no Handlers and logs nothing.  An application that wants output sets a
+    // level and adds a Handler, for instance an AsyncHandler around a ConsoleHandler.
+    this->internal->root = new RootLogger();
+    this->internal->root->setLevel( Level::OFF );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 LogManager::~LogManager() {
+
+    try {
+
+        Pointer< Iterator<Logger*> > iter( this->internal->loggers.values().iterator() );
+        while( iter->hasNext() ) {
+            delete iter->next();
+        }
+
+        delete this->internal->root;
+    }
+    DECAF_CATCH_NOTHROW( Exception )
+    DECAF_CATCHALL_NOTHROW()
+
     delete internal;
-    // TODO - Delete all the loggers.
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -93,13 +137,72 @@ void LogManager::removePropertyChangeListener(
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-bool LogManager::addLogger( Logger* logger DECAF_UNUSED ) {
+bool LogManager::addLogger( Logger* logger ) {
+
+    if( logger == NULL ) {
+        throw NullPointerException(
+            __FILE__, __LINE__, "LogManager::addLogger - Logger cannot be null" );
+    }
+
+    const std::string& name = logger->getName();
+
+    if( name.empty() ) {
+        throw IllegalArgumentException(
+            __FILE__, __LINE__, "LogManager::addLogger - Logger must have a name" );
+    }
+
+    synchronized( &this->internal->loggers ) {
+
+        if( this->internal->loggers.containsKey( name ) ) {
+            return false;
+        }
+
+        // The parent is the nearest registered ancestor, or the root if there is none.
+        Logger* parent = this->internal->root;
+        std::string::size_type pos = name.rfind( '.' );
+        while( pos != std::string::npos ) {
+            std::string ancestor = name.substr( 0, pos );
+            if( this->internal->loggers.containsKey( ancestor ) ) {
+                parent = this->internal->loggers.get( ancestor );
+                break;
+            }
+            pos = ancestor.rfind( '.' );
+        }
+
+        logger->setParent( parent );
+
+        // Any existing descendant whose parent is further away than the new Logger
+        // now gets the new Logger as its parent.
+        Pointer< Iterator<Logger*> > iter( this->internal->loggers.values().iterator() );
+        while( iter->hasNext() ) {
+            Logger* child = iter->next();
+            if( isAncestorName( name, child->getName() ) &&
+                ( child->getParent() == NULL ||
+                  child->getParent()->getName().length() < name.length() ) ) {
+
+                child->setParent( logger );
+            }
+        }
+
+        this->internal->loggers.put( name, logger );
+    }
 
-    return false;
+    return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-Logger* LogManager::getLogger( const std::string& name DECAF_UNUSED ) {
+Logger* LogManager::getLogger( const std::string& name ) {
+
+    if( name.empty() ) {
+        return this->internal->root;
+    }
+
+    synchronized( &this->internal->loggers ) {
+        if( this->internal->loggers.containsKey( name ) ) {
+            return this->internal->loggers.get( name );
+        }
+    }
+
     return NULL;
 }
 
@@ -129,13 +232,21 @@ void LogManager::initialize() {
 
     // Initialize the global instance.
     theManager = new LogManager;
+    generation++;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void LogManager::shutdown() {
 
     // Destroy the global LogManager
-    delete theManager;
+    LogManager* manager = theManager;
+    theManager = NULL;
+    delete manager;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int LogManager::getGeneration() {
+    return theManager != NULL ? generation : 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
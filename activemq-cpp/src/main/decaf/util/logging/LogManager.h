@@ -165,6 +165,8 @@ namespace logging{
          * the same name is already registered.
          *
          * The Logger factory methods call this method to register each newly created Logger.
+         * Once added the LogManager owns the Logger and destroys it when the logging subsystem
+         * is shut down.
          *
          * @param logger
          *      The new Logger instance to add to this LogManager.
@@ -287,6 +289,16 @@ namespace logging{
          */
         static LogManager& getLogManager();
 
+        /**
+         * Gets a value that changes each time the Logging subsystem is initialized, code that
+         * caches Logger pointers can compare it against the value seen when the pointer was
+         * obtained to detect that the Logger has since been destroyed.  A value of zero means
+         * the Logging subsystem is not currently initialized.
+         *
+         * @return the generation of the current LogManager or zero if there is none.
+         */
+        static int getGeneration();
+
     private:
 
         /**
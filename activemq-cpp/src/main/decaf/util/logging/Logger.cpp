@@ -17,19 +17,44 @@
 #include "Logger.h"
 
 #include <decaf/util/logging/Handler.h>
+#include <decaf/util/logging/Filter.h>
+#include <decaf/util/logging/LogManager.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
 #include <decaf/util/Config.h>
+#include <decaf/util/concurrent/Concurrent.h>
 #include <algorithm>
+#include <stdio.h>
 
 using namespace std;
 using namespace decaf;
 using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
 using namespace decaf::util;
+using namespace decaf::util::concurrent;
 using namespace decaf::util::logging;
 
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    void initializeRecord( LogRecord& record, const Logger* logger, const Level& level,
+                           const std::string& file, int line,
+                           const std::string& functionName, const std::string& message ) {
+
+        record.setLevel( level );
+        record.setLoggerName( logger->getName() );
+        record.setSourceFile( file );
+        record.setSourceLine( line );
+        record.setSourceFunction( functionName );
+        record.setMessage( message );
+        record.setTimestamp( System::currentTimeMillis() );
+        record.setTreadId( Thread::currentThread()->getId() );
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 Logger::Logger( const std::string& name )
-    : name(name), parent(NULL), handlers(), filter(NULL), level(Level::INHERIT), useParentHandlers(true) {
+    : name(name), parent(NULL), handlers(), handlersLock(), filter(NULL), level(Level::INHERIT), useParentHandlers(true) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -45,12 +70,14 @@ Logger::~Logger() {
 void Logger::addHandler( Handler* handler ) {
 
     if( handler == NULL ) {
-        NullPointerException(
+        throw NullPointerException(
             __FILE__, __LINE__, "Logger::addHandler - Handler cannot be null");
     }
 
-    if( find( handlers.begin(), handlers.end(), handler) != handlers.end() ) {
-        handlers.push_back( handler );
+    synchronized( &handlersLock ) {
+        if( find( handlers.begin(), handlers.end(), handler) == handlers.end() ) {
+            handlers.push_back( handler );
+        }
     }
 }
 
@@ -61,11 +88,14 @@ void Logger::removeHandler( Handler* handler ) {
         return;
     }
 
-    list<Handler*>::iterator itr =
-        find( handlers.begin(), handlers.end(), handler );
+    synchronized( &handlersLock ) {
+
+        list<Handler*>::iterator itr =
+            find( handlers.begin(), handlers.end(), handler );
 
-    if( itr != handlers.end() ) {
-        handlers.erase( itr );
+        if( itr != handlers.end() ) {
+            handlers.erase( itr );
+        }
     }
 }
 
@@ -80,115 +110,278 @@ void Logger::setFilter( Filter* filter ){
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-bool Logger::isLoggable( const Level& level DECAF_UNUSED ) const{
-    return false;
+bool Logger::isLoggable( const Level& level ) const {
+
+    // Walk up to the first Logger that has an explicit Level, this is only a few
+    // integer compares so it is cheap enough to do ahead of any message formatting.
+    int threshold = Level::INFO.intValue();
+    const Logger* logger = this;
+
+    while( logger != NULL ) {
+        int value = logger->level.intValue();
+        if( value != Level::INHERIT.intValue() ) {
+            threshold = value;
+            break;
+        }
+        logger = logger->parent;
+    }
+
+    if( threshold == Level::OFF.intValue() ) {
+        return false;
+    }
+
+    return level.intValue() >= threshold;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void Logger::entering( const std::string& blockName DECAF_UNUSED,
-                       const std::string& file DECAF_UNUSED,
-                       const int line DECAF_UNUSED ) {
+void Logger::entering( const std::string& blockName,
+                       const std::string& file,
+                       const int line ) {
+
+    if( isLoggable( Level::FINER ) ) {
+        LogRecord record;
+        initializeRecord( record, this, Level::FINER, file, line, blockName, "ENTRY" );
+        this->log( record );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void Logger::exiting( const std::string& blockName DECAF_UNUSED,
-                      const std::string& file DECAF_UNUSED,
-                      const int line DECAF_UNUSED) {
+void Logger::exiting( const std::string& blockName,
+                      const std::string& file,
+                      const int line) {
+
+    if( isLoggable( Level::FINER ) ) {
+        LogRecord record;
+        initializeRecord( record, this, Level::FINER, file, line, blockName, "RETURN" );
+        this->log( record );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void Logger::severe( const std::string& file DECAF_UNUSED,
-                     const int line DECAF_UNUSED,
-                     const std::string fnctionName DECAF_UNUSED,
-                     const std::string& message DECAF_UNUSED ) {
+void Logger::severe( const std::string& file,
+                     const int line,
+                     const std::string functionName,
+                     const std::string& message ) {
+
+    if( isLoggable( Level::SEVERE ) ) {
+        LogRecord record;
+        initializeRecord( record, this, Level::SEVERE, file, line, functionName, message );
+        this->log( record );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void Logger::warning( const std::string& file DECAF_UNUSED,
-                      const int line DECAF_UNUSED,
-                      const std::string fnctionName DECAF_UNUSED,
-                      const std::string& message DECAF_UNUSED ) {
+void Logger::warning( const std::string& file,
+                      const int line,
+                      const std::string functionName,
+                      const std::string& message ) {
+
+    if( isLoggable( Level::WARNING ) ) {
+        LogRecord record;
+        initializeRecord( record, this, Level::WARNING, file, line, functionName, message );
+        this->log( record );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void Logger::info( const std::string& file DECAF_UNUSED,
-                   const int line DECAF_UNUSED,
-                   const std::string fnctionName DECAF_UNUSED,
-                   const std::string& message DECAF_UNUSED ) {
+void Logger::info( const std::string& file,
+                   const int line,
+                   const std::string functionName,
+                   const std::string& message ) {
+
+    if( isLoggable( Level::INFO ) ) {
+        LogRecord record;
+        initializeRecord( record, this, Level::INFO, file, line, functionName, message );
+        this->log( record );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void Logger::debug( const std::string& file DECAF_UNUSED,
-                    const int line DECAF_UNUSED,
-                    const std::string fnctionName DECAF_UNUSED,
-                    const std::string& message DECAF_UNUSED ) {
+void Logger::debug( const std::string& file,
+                    const int line,
+                    const std::string functionName,
+                    const std::string& message ) {
+
+    if( isLoggable( Level::DEBUG ) ) {
+        LogRecord record;
+        initializeRecord( record, this, Level::DEBUG, file, line, functionName, message );
+        this->log( record );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void Logger::config( const std::string& file DECAF_UNUSED,
-                     const int line DECAF_UNUSED,
-                     const std::string fnctionName DECAF_UNUSED,
-                     const std::string& message DECAF_UNUSED ) {
+void Logger::config( const std::string& file,
+                     const int line,
+                     const std::string functionName,
+                     const std::string& message ) {
+
+    if( isLoggable( Level::CONFIG ) ) {
+        LogRecord record;
+        initializeRecord( record, this, Level::CONFIG, file, line, functionName, message );
+        this->log( record );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void Logger::fine( const std::string& file DECAF_UNUSED,
-                   const int line DECAF_UNUSED,
-                   const std::string fnctionName DECAF_UNUSED,
-                   const std::string& message DECAF_UNUSED ) {
+void Logger::fine( const std::string& file,
+                   const int line,
+                   const std::string functionName,
+                   const std::string& message ) {
+
+    if( isLoggable( Level::FINE ) ) {
+        LogRecord record;
+        initializeRecord( record, this, Level::FINE, file, line, functionName, message );
+        this->log( record );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void Logger::finer( const std::string& file DECAF_UNUSED,
-                    const int line DECAF_UNUSED,
-                    const std::string fnctionName DECAF_UNUSED,
-                    const std::string& message DECAF_UNUSED ) {
+void Logger::finer( const std::string& file,
+                    const int line,
+                    const std::string functionName,
+                    const std::string& message ) {
+
+    if( isLoggable( Level::FINER ) ) {
+        LogRecord record;
+        initializeRecord( record, this, Level::FINER, file, line, functionName, message );
+        this->log( record );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void Logger::finest( const std::string& file DECAF_UNUSED,
-                     const int line DECAF_UNUSED,
-                     const std::string fnctionName DECAF_UNUSED,
-                     const std::string& message DECAF_UNUSED ) {
+void Logger::finest( const std::string& file,
+                     const int line,
+                     const std::string functionName,
+                     const std::string& message ) {
+
+    if( isLoggable( Level::FINEST ) ) {
+        LogRecord record;
+        initializeRecord( record, this, Level::FINEST, file, line, functionName, message );
+        this->log( record );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void Logger::throwing( const std::string& file DECAF_UNUSED,
-                       const int line DECAF_UNUSED,
-                       const std::string functionName DECAF_UNUSED,
-                       const decaf::lang::Throwable& thrown DECAF_UNUSED ) {
+void Logger::throwing( const std::string& file,
+                       const int line,
+                       const std::string functionName,
+                       const decaf::lang::Throwable& thrown ) {
+
+    if( isLoggable( Level::FINER ) ) {
+        LogRecord record;
+        initializeRecord( record, this, Level::FINER, file, line, functionName, "THROW" );
+        record.setThrown( thrown.clone() );
+        this->log( record );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void Logger::log( const Level& level DECAF_UNUSED,
-                  const std::string& message DECAF_UNUSED ) {
+void Logger::log( const Level& level,
+                  const std::string& message ) {
+
+    if( isLoggable( level ) ) {
+        LogRecord record;
+        initializeRecord( record, this, level, "", 0, "", message );
+        this->log( record );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void Logger::log( const Level& level DECAF_UNUSED,
-                  const std::string& file DECAF_UNUSED,
-                  const int line DECAF_UNUSED,
-                  const std::string& message DECAF_UNUSED,
-                  lang::Exception& ex DECAF_UNUSED ) {
+void Logger::log( const Level& level,
+                  const std::string& file,
+                  const int line,
+                  const std::string& message,
+                  lang::Exception& ex ) {
+
+    if( isLoggable( level ) ) {
+        LogRecord record;
+        initializeRecord( record, this, level, file, line, "", message );
+        record.setThrown( ex.clone() );
+        this->log( record );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void Logger::log( const Level& level DECAF_UNUSED,
-                  const std::string& file DECAF_UNUSED,
-                  const int line DECAF_UNUSED,
-                  const std::string& message DECAF_UNUSED, ... ) {
+void Logger::log( const Level& level,
+                  const std::string& file,
+                  const int line,
+                  const std::string& message, ... ) {
+
+    if( isLoggable( level ) ) {
+
+        char buffer[1024];
+
+        va_list vargs;
+        va_start( vargs, message );
+        vsnprintf( buffer, sizeof(buffer), message.c_str(), vargs );
+        va_end( vargs );
+
+        LogRecord record;
+        initializeRecord( record, this, level, file, line, "", buffer );
+        this->log( record );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void Logger::log( LogRecord& record DECAF_UNUSED ) {
+void Logger::log( LogRecord& record ) {
+
+    if( !isLoggable( record.getLevel() ) ) {
+        return;
+    }
+
+    if( this->filter != NULL && !this->filter->isLoggable( record ) ) {
+        return;
+    }
+
+    // Publish to our own Handlers and then to those of our ancestors until we
+    // reach one that doesn't want its parent's Handlers used.
+    const Logger* logger = this;
+    while( logger != NULL ) {
+
+        // The lock is recursive so a Handler that logs from publish can't deadlock
+        // here, it only keeps add and remove out while the list is walked.
+        synchronized( &logger->handlersLock ) {
+            std::list<Handler*>::const_iterator handler = logger->handlers.begin();
+            for( ; handler != logger->handlers.end(); ++handler ) {
+                (*handler)->publish( record );
+            }
+        }
+
+        if( !logger->useParentHandlers ) {
+            break;
+        }
+
+        logger = logger->parent;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-Logger* Logger::getLogger( const std::string& name DECAF_UNUSED ) {
-    return NULL;
+Logger* Logger::getLogger( const std::string& name ) {
+
+    LogManager& manager = LogManager::getLogManager();
+
+    Logger* logger = manager.getLogger( name );
+    if( logger != NULL ) {
+        return logger;
+    }
+
+    logger = new Logger( name );
+
+    // Another thread could have registered the same name in the meantime in
+    // which case we use its instance and discard our own.
+    if( !manager.addLogger( logger ) ) {
+        delete logger;
+        logger = manager.getLogger( name );
+    }
+
+    return logger;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 Logger* Logger::getAnonymousLogger() {
-    return NULL;
+
+    Logger* logger = new Logger( "" );
+    logger->setParent( LogManager::getLogManager().getLogger( "" ) );
+
+    return logger;
 }
@@ -95,6 +95,9 @@ namespace logging{
         // list of Handlers owned by this logger
         std::list<Handler*> handlers;
 
+        // Guards the list of Handlers against changes while a record is published
+        mutable decaf::util::concurrent::Mutex handlersLock;
+
         // Filter used by this Logger
         Filter* filter;
 
@@ -29,27 +29,69 @@
 #define LOGDECAF_DECLARE_LOCAL(loggerName)                            \
    decaf::util::logging::Logger loggerName;
 
+// The level is checked before the message argument is evaluated so that a
+// disabled level never pays for building the message.  Each macro expands to a
+// single statement and so must be followed by a semicolon.
 #define LOGDECAF_DEBUG(logger, message)                               \
-   logger.debug(__FILE__, __LINE__, message);
+   do {                                                              \
+      if (logger.isDebugEnabled()) {                                 \
+         logger.debug(__FILE__, __LINE__, message);                  \
+      }                                                              \
+   } while (0)
 
-#define LOGDECAF_DEBUG_1(logger, message, value);                     \
-   {                                                                  \
-      std::ostringstream ostream;                                     \
-      ostream << message << value;                                    \
-      logger.debug(__FILE__, __LINE__, ostream.str());                \
-   }
+#define LOGDECAF_DEBUG_1(logger, message, value)                      \
+   do {                                                              \
+      if (logger.isDebugEnabled()) {                                 \
+         std::ostringstream ostream;                                 \
+         ostream << message << value;                                \
+         logger.debug(__FILE__, __LINE__, ostream.str());            \
+      }                                                              \
+   } while (0)
 
 #define LOGDECAF_INFO(logger, message)                                \
-   logger.info(__FILE__, __LINE__, message);
+   do {                                                              \
+      if (logger.isInfoEnabled()) {                                  \
+         logger.info(__FILE__, __LINE__, message);                   \
+      }                                                              \
+   } while (0)
+
+#define LOGDECAF_INFO_1(logger, message, value)                       \
+   do {                                                              \
+      if (logger.isInfoEnabled()) {                                  \
+         std::ostringstream ostream;                                 \
+         ostream << message << value;                                \
+         logger.info(__FILE__, __LINE__, ostream.str());             \
+      }                                                              \
+   } while (0)
 
 #define LOGDECAF_ERROR(logger, message)                               \
-   logger.error(__FILE__, __LINE__, message);
+   do {                                                              \
+      if (logger.isErrorEnabled()) {                                 \
+         logger.error(__FILE__, __LINE__, message);                  \
+      }                                                              \
+   } while (0)
 
 #define LOGDECAF_WARN(logger, message)                                \
-   logger.warn(__FILE__, __LINE__, message);
+   do {                                                              \
+      if (logger.isWarnEnabled()) {                                  \
+         logger.warn(__FILE__, __LINE__, message);                   \
+      }                                                              \
+   } while (0)
 
-#define LOGDECAF_FATAL(logger, message)                               \
-   logger.fatal(__FILE__, __LINE__, message);
+#define LOGDECAF_WARN_1(logger, message, value)                       \
+   do {                                                              \
+      if (logger.isWarnEnabled()) {                                  \
+         std::ostringstream ostream;                                 \
+         ostream << message << value;                                \
+         logger.warn(__FILE__, __LINE__, ostream.str());             \
+      }                                                              \
+   } while (0)
 
+#define LOGDECAF_FATAL(logger, message)                               \
+   do {                                                              \
+      if (logger.isErrorEnabled()) {                                 \
+         logger.fatal(__FILE__, __LINE__, message);                  \
+      }                                                              \
+   } while (0)
 
 #endif
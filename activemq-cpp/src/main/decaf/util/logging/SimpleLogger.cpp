@@ -16,63 +16,140 @@
  */
 #include "SimpleLogger.h"
 
-#include <iostream>
-#include <decaf/util/logging/LogWriter.h>
+#include <decaf/util/logging/Logger.h>
+#include <decaf/util/logging/LogManager.h>
+#include <decaf/util/logging/Level.h>
+#include <decaf/util/logging/LogRecord.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/util/concurrent/Concurrent.h>
 
 using namespace std;
 using namespace decaf;
+using namespace decaf::lang;
 using namespace decaf::util;
+using namespace decaf::util::concurrent;
 using namespace decaf::util::logging;
 
 ////////////////////////////////////////////////////////////////////////////////
-SimpleLogger::SimpleLogger( const std::string& name ) : name(name) {
+SimpleLogger::SimpleLogger( const std::string& name ) : name(name), logger(), generation(0), lookupLock() {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 SimpleLogger::~SimpleLogger() {
 }
 
+////////////////////////////////////////////////////////////////////////////////
+Logger* SimpleLogger::getLogger() const {
+
+    int current = LogManager::getGeneration();
+    if( current == 0 ) {
+        return NULL;
+    }
+
+    // Look the Logger up once per LogManager.  The Logger is published ahead of its
+    // generation so a reader that sees the current generation also sees its Logger,
+    // only the lookup itself takes the lock.
+    if( this->generation.get() != current ) {
+        synchronized( &this->lookupLock ) {
+            if( this->generation.get() != current ) {
+                this->logger.set( Logger::getLogger( this->name ) );
+                this->generation.set( current );
+            }
+        }
+    }
+
+    return this->logger.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool SimpleLogger::isEnabled( const Level& level ) const {
+
+    Logger* target = getLogger();
+    return target != NULL && target->isLoggable( level );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool SimpleLogger::isDebugEnabled() const {
+    return isEnabled( Level::DEBUG );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool SimpleLogger::isInfoEnabled() const {
+    return isEnabled( Level::INFO );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool SimpleLogger::isWarnEnabled() const {
+    return isEnabled( Level::WARNING );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool SimpleLogger::isErrorEnabled() const {
+    return isEnabled( Level::SEVERE );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SimpleLogger::doLog( const Level& level, const std::string& file,
+                          const int line, const std::string& message ) {
+
+    Logger* target = getLogger();
+    if( target != NULL && target->isLoggable( level ) ) {
+
+        LogRecord record;
+        record.setLevel( level );
+        record.setLoggerName( this->name );
+        record.setSourceFile( file );
+        record.setSourceLine( line );
+        record.setMessage( message );
+        record.setTimestamp( System::currentTimeMillis() );
+        record.setTreadId( Thread::currentThread()->getId() );
+
+        target->log( record );
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void SimpleLogger::mark( const std::string& message ) {
-    LogWriter::getInstance().log( "", 0, "", message );
+    doLog( Level::INFO, "", 0, message );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void SimpleLogger::debug( const std::string& file,
                           const int          line,
                           const std::string& message ) {
-    LogWriter::getInstance().log( file, line, "DEBUG:", message );
+    doLog( Level::DEBUG, file, line, message );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void SimpleLogger::info( const std::string& file,
                          const int          line,
                          const std::string& message ) {
-    LogWriter::getInstance().log( file, line, "INFO:", message );
+    doLog( Level::INFO, file, line, message );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void SimpleLogger::warn( const std::string& file,
                          const int          line,
                          const std::string& message ) {
-    LogWriter::getInstance().log( file, line, "WARNING:", message );
+    doLog( Level::WARNING, file, line, message );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void SimpleLogger::error( const std::string& file,
                           const int          line,
                           const std::string& message ) {
-    LogWriter::getInstance().log( file, line, "ERROR:", message );
+    doLog( Level::SEVERE, file, line, message );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void SimpleLogger::fatal( const std::string& file,
                           const int          line,
                           const std::string& message ) {
-    LogWriter::getInstance().log( file, line, "FATAL:", message );
+    doLog( Level::SEVERE, file, line, message );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void SimpleLogger::log(const std::string& message ) {
-    LogWriter::getInstance().log( message );
+    doLog( Level::INFO, "", 0, message );
 }
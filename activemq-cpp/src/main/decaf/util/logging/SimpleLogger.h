@@ -19,11 +19,23 @@
 
 #include <string>
 #include <decaf/util/Config.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+#include <decaf/util/concurrent/atomic/AtomicReference.h>
 
 namespace decaf{
 namespace util{
 namespace logging{
 
+   class Logger;
+   class Level;
+
+   /**
+    * Lightweight front end used by the LOGDECAF macros, each instance forwards to the
+    * Logger of the same name once the logging subsystem is initialized and discards
+    * everything before that.  The isXXXEnabled methods are cheap enough to be checked
+    * before a message is built so that disabled levels cost almost nothing.
+    */
    class DECAF_API SimpleLogger
    {
    public:
@@ -38,6 +50,26 @@ namespace logging{
        */
       virtual ~SimpleLogger();
 
+      /**
+       * @return true if a Debug Level Log would be written.
+       */
+      bool isDebugEnabled() const;
+
+      /**
+       * @return true if a Informational Level Log would be written.
+       */
+      bool isInfoEnabled() const;
+
+      /**
+       * @return true if a Warning Level Log would be written.
+       */
+      bool isWarnEnabled() const;
+
+      /**
+       * @return true if a Error or Fatal Level Log would be written.
+       */
+      bool isErrorEnabled() const;
+
       /**
        * Log a Mark Block Level Log
        */
@@ -83,11 +115,33 @@ namespace logging{
        */
       virtual void log(const std::string& message);
 
+   private:
+
+      SimpleLogger( const SimpleLogger& );
+      SimpleLogger& operator= ( const SimpleLogger& );
+
+   private:
+
+      Logger* getLogger() const;
+
+      bool isEnabled( const Level& level ) const;
+
+      void doLog( const Level& level, const std::string& file, const int line,
+                  const std::string& message );
+
    private:
 
       // Name of this Logger
       std::string name;
 
+      // The Logger we forward to and the LogManager generation it was obtained from,
+      // the Logger is always published before the generation that goes with it.
+      mutable decaf::util::concurrent::atomic::AtomicReference<Logger> logger;
+      mutable decaf::util::concurrent::atomic::AtomicInteger generation;
+
+      // Serializes the lookups done when the LogManager generation changes.
+      mutable decaf::util::concurrent::Mutex lookupLock;
+
    };
 
 }}}
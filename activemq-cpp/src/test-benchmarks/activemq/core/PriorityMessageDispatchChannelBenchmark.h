@@ -0,0 +1,119 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CORE_PRIORITYMESSAGEDISPATCHCHANNELBENCHMARK_H_
+#define _ACTIVEMQ_CORE_PRIORITYMESSAGEDISPATCHCHANNELBENCHMARK_H_
+
+#include <benchmark/BenchmarkBase.h>
+
+#include <activemq/core/PriorityMessageDispatchChannel.h>
+#include <activemq/core/SimplePriorityMessageDispatchChannel.h>
+#include <activemq/commands/Message.h>
+#include <activemq/commands/MessageDispatch.h>
+
+#include <vector>
+
+namespace activemq {
+namespace core {
+
+    /**
+     * Runs the same priority workloads against any MessageDispatchChannel so that the
+     * priority channel implementations can be compared.  The channel is filled to a
+     * prefetch depth with uniform and with skewed priorities and drained, then kept
+     * half full with interleaved enqueues and dequeues.
+     */
+    template< typename CHANNEL >
+    class PriorityMessageDispatchChannelBenchmark :
+        public benchmark::BenchmarkBase< activemq::core::PriorityMessageDispatchChannelBenchmark<CHANNEL>, CHANNEL > {
+    private:
+
+        static const int PREFETCH = 1000;
+
+        CHANNEL channel;
+        std::vector< decaf::lang::Pointer<commands::MessageDispatch> > uniform;
+        std::vector< decaf::lang::Pointer<commands::MessageDispatch> > skewed;
+
+    private:
+
+        static decaf::lang::Pointer<commands::MessageDispatch> createDispatch(int priority) {
+            decaf::lang::Pointer<commands::Message> message(new commands::Message());
+            message->setPriority((unsigned char) priority);
+            decaf::lang::Pointer<commands::MessageDispatch> dispatch(new commands::MessageDispatch());
+            dispatch->setMessage(message);
+            return dispatch;
+        }
+
+    public:
+
+        PriorityMessageDispatchChannelBenchmark() : channel(), uniform(), skewed() {}
+        virtual ~PriorityMessageDispatchChannelBenchmark() {}
+
+        virtual void setUp() {
+
+            // All Messages at the default priority, the common case with priority support on.
+            for (int i = 0; i < PREFETCH; ++i) {
+                uniform.push_back(createDispatch(4));
+            }
+
+            // Mostly default priority with a tail of low priority and a few urgent Messages.
+            for (int i = 0; i < PREFETCH; ++i) {
+                int slot = i % 100;
+                if (slot < 2) {
+                    skewed.push_back(createDispatch(9));
+                } else if (slot < 10) {
+                    skewed.push_back(createDispatch(1));
+                } else {
+                    skewed.push_back(createDispatch(4));
+                }
+            }
+
+            channel.start();
+        }
+
+        virtual void run() {
+
+            // Fill to the prefetch depth and drain one at a time.
+            for (int i = 0; i < PREFETCH; ++i) {
+                channel.enqueue(uniform[i]);
+            }
+            while (channel.dequeueNoWait() != NULL) {
+            }
+
+            for (int i = 0; i < PREFETCH; ++i) {
+                channel.enqueue(skewed[i]);
+            }
+            while (channel.dequeueNoWait() != NULL) {
+            }
+
+            // Steady state with a half full channel and interleaved enqueue and dequeue.
+            for (int i = 0; i < PREFETCH / 2; ++i) {
+                channel.enqueue(skewed[i]);
+            }
+            for (int i = PREFETCH / 2; i < PREFETCH; ++i) {
+                channel.enqueue(skewed[i]);
+                channel.dequeueNoWait();
+            }
+
+            // Bulk drain of what is left.
+            channel.removeAll();
+        }
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_CORE_PRIORITYMESSAGEDISPATCHCHANNELBENCHMARK_H_ */
@@ -0,0 +1,132 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ProducerMessageTemplateBenchmark.h"
+
+#include <activemq/commands/ActiveMQTextMessage.h>
+#include <activemq/transport/IOTransport.h>
+#include <activemq/wireformat/openwire/OpenWireFormat.h>
+#include <decaf/io/OutputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/System.h>
+#include <decaf/util/Properties.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace activemq::transport;
+using namespace activemq::wireformat::openwire;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::util;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const int CONSTANT_PROPERTIES = 16;
+    const int MESSAGES = 5000;
+
+    class NullOutputStream : public OutputStream {
+    protected:
+
+        virtual void doWriteByte(unsigned char value DECAF_UNUSED) {}
+
+        virtual void doWriteArrayBounded(const unsigned char* buffer DECAF_UNUSED, int size DECAF_UNUSED,
+                                         int offset DECAF_UNUSED, int length DECAF_UNUSED) {}
+    };
+
+    void createPrototype(ActiveMQTextMessage& prototype) {
+
+        prototype.setCMSType("quote");
+        for (int i = 0; i < CONSTANT_PROPERTIES; ++i) {
+            prototype.setStringProperty("header-" + Integer::toString(i), "value-" + Integer::toString(i));
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ProducerMessageTemplateBenchmark::ProducerMessageTemplateBenchmark() : normalTime(0), templateTime(0) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ProducerMessageTemplateBenchmark::~ProducerMessageTemplateBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProducerMessageTemplateBenchmark::setUp() {
+    normalTime = 0;
+    templateTime = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProducerMessageTemplateBenchmark::tearDown() {
+
+    std::cout << "Market data messages with " << CONSTANT_PROPERTIES << " constant properties, copied prototype = "
+              << normalTime / 1000000 << " Millisecs, template = "
+              << templateTime / 1000000 << " Millisecs" << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProducerMessageTemplateBenchmark::run() {
+
+    Properties properties;
+    OpenWireFormat format(properties);
+    format.setTightEncodingEnabled(true);
+
+    IOTransport transport;
+    NullOutputStream sink;
+    DataOutputStream out(&sink);
+
+    ActiveMQTextMessage prototype;
+    createPrototype(prototype);
+
+    std::vector<std::string> variables;
+    variables.push_back("price");
+    variables.push_back("seq");
+
+    ProducerMessageTemplate messageTemplate(prototype, variables);
+    std::string body(256, 'q');
+
+    long long start = System::nanoTime();
+    for (int i = 0; i < MESSAGES; ++i) {
+
+        Pointer<ActiveMQTextMessage> message(prototype.cloneDataStructure());
+        message->setIntProperty("seq", i);
+        message->setDoubleProperty("price", 100.0 + i);
+        message->setText(body);
+
+        format.marshal(message, &transport, &out);
+    }
+    normalTime += System::nanoTime() - start;
+
+    start = System::nanoTime();
+    for (int i = 0; i < MESSAGES; ++i) {
+
+        messageTemplate.setIntProperty("seq", i);
+        messageTemplate.setDoubleProperty("price", 100.0 + i);
+        messageTemplate.setText(body);
+
+        format.marshal(messageTemplate.createMessage(NULL), &transport, &out);
+    }
+    templateTime += System::nanoTime() - start;
+}
@@ -0,0 +1,55 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CORE_PRODUCERMESSAGETEMPLATEBENCHMARK_H_
+#define _ACTIVEMQ_CORE_PRODUCERMESSAGETEMPLATEBENCHMARK_H_
+
+#include <benchmark/BenchmarkBase.h>
+
+#include <activemq/core/ProducerMessageTemplate.h>
+
+namespace activemq {
+namespace core {
+
+    /**
+     * Measures building and marshaling the Messages of a market data publisher whose
+     * Messages share most of their properties and differ in a few of them and the body.
+     * Each Message is built once by copying a prototype and setting the variable
+     * properties and body on the copy the way the normal send path does, and once
+     * through a ProducerMessageTemplate.  The times are reported on tearDown.
+     */
+    class ProducerMessageTemplateBenchmark :
+        public benchmark::BenchmarkBase< activemq::core::ProducerMessageTemplateBenchmark, ProducerMessageTemplate, 10 > {
+    private:
+
+        long long normalTime;
+        long long templateTime;
+
+    public:
+
+        ProducerMessageTemplateBenchmark();
+        virtual ~ProducerMessageTemplateBenchmark();
+
+        virtual void setUp();
+        virtual void tearDown();
+        virtual void run();
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_CORE_PRODUCERMESSAGETEMPLATEBENCHMARK_H_ */
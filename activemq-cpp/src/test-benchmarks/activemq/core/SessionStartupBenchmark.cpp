@@ -0,0 +1,109 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SessionStartupBenchmark.h"
+
+#include <activemq/core/ActiveMQConnectionFactory.h>
+
+#include <cms/MessageConsumer.h>
+#include <cms/MessageProducer.h>
+#include <cms/CMSException.h>
+
+#include <decaf/lang/Integer.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::core;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const int CONSUMER_COUNT = 200;
+    const int PRODUCER_COUNT = 20;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SessionStartupBenchmark::SessionStartupBenchmark() : connection(), destinations() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SessionStartupBenchmark::~SessionStartupBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SessionStartupBenchmark::setUp() {
+
+    ActiveMQConnectionFactory factory("mock://127.0.0.1:12345?wireFormat=openwire");
+
+    connection.reset(dynamic_cast<ActiveMQConnection*>(factory.createConnection()));
+    connection->start();
+
+    std::auto_ptr<cms::Session> session(connection->createSession());
+
+    for (int i = 0; i < CONSUMER_COUNT; ++i) {
+        if (i % 2 == 0) {
+            destinations.push_back(session->createTopic("Startup.Topic." + Integer::toString(i)));
+        } else {
+            destinations.push_back(session->createQueue("Startup.Queue." + Integer::toString(i)));
+        }
+    }
+
+    session->close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SessionStartupBenchmark::tearDown() {
+
+    for (std::size_t i = 0; i < destinations.size(); ++i) {
+        delete destinations[i];
+    }
+    destinations.clear();
+
+    if (connection.get() != NULL) {
+        connection->close();
+        connection.reset(NULL);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SessionStartupBenchmark::run() {
+
+    std::auto_ptr<ActiveMQSession> session(
+        dynamic_cast<ActiveMQSession*>(connection->createSession()));
+
+    std::vector<const cms::Destination*> targets(destinations.begin(), destinations.end());
+    std::vector<cms::MessageConsumer*> consumers;
+    std::vector< Pointer<cms::CMSException> > errors;
+
+    session->createConsumers(targets, "", false, consumers, errors);
+
+    std::vector<cms::MessageProducer*> producers;
+    for (int i = 0; i < PRODUCER_COUNT; ++i) {
+        producers.push_back(session->createProducer(destinations[i]));
+    }
+
+    for (std::size_t i = 0; i < producers.size(); ++i) {
+        delete producers[i];
+    }
+
+    for (std::size_t i = 0; i < consumers.size(); ++i) {
+        delete consumers[i];
+    }
+
+    session->close();
+}
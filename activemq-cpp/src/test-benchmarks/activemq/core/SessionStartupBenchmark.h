@@ -0,0 +1,59 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CORE_SESSIONSTARTUPBENCHMARK_H_
+#define _ACTIVEMQ_CORE_SESSIONSTARTUPBENCHMARK_H_
+
+#include <benchmark/BenchmarkBase.h>
+
+#include <activemq/core/ActiveMQConnection.h>
+#include <activemq/core/ActiveMQSession.h>
+
+#include <cms/Destination.h>
+
+#include <memory>
+#include <vector>
+
+namespace activemq {
+namespace core {
+
+    /**
+     * Measures the time an application takes to open a Session along with the set of
+     * consumers and producers it needs at startup when the consumers are created in one
+     * pipelined batch, run against the mock transport's in process broker.
+     */
+    class SessionStartupBenchmark :
+        public benchmark::BenchmarkBase< activemq::core::SessionStartupBenchmark, ActiveMQSession, 20 > {
+    private:
+
+        std::auto_ptr<ActiveMQConnection> connection;
+        std::vector<cms::Destination*> destinations;
+
+    public:
+
+        SessionStartupBenchmark();
+        virtual ~SessionStartupBenchmark();
+
+        virtual void setUp();
+        virtual void tearDown();
+        virtual void run();
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_CORE_SESSIONSTARTUPBENCHMARK_H_ */
@@ -0,0 +1,280 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StreamTransferBenchmark.h"
+
+#include <activemq/core/ActiveMQConnectionFactory.h>
+#include <activemq/core/ActiveMQConstants.h>
+#include <activemq/core/ActiveMQInputStream.h>
+#include <activemq/core/PrefetchPolicy.h>
+#include <activemq/commands/ActiveMQBytesMessage.h>
+#include <activemq/commands/ActiveMQQueue.h>
+#include <activemq/commands/ConsumerInfo.h>
+#include <activemq/commands/MessageAck.h>
+#include <activemq/commands/MessageDispatch.h>
+#include <activemq/transport/TransportListener.h>
+#include <activemq/transport/mock/MockTransport.h>
+
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/util/concurrent/Concurrent.h>
+#include <decaf/util/concurrent/Mutex.h>
+
+#include <deque>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace activemq::transport;
+using namespace decaf::lang;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const long long TRANSFER_SIZE = 4LL * 1024 * 1024 * 1024;
+    const int CHUNK_SIZE = 1024 * 1024;
+    const int PREFETCH = 16;
+    const int BROKER_CAPACITY = 16;
+
+    // Stands in for the Broker: Messages sent on the connection are queued and
+    // dispatched to the consumer within its prefetch, a full queue blocks the
+    // sender the way producer flow control would.
+    class StandInBroker : public TransportListener, public Runnable {
+    private:
+
+        mock::MockTransport* transport;
+        Mutex mutex;
+        std::deque< Pointer<Message> > queue;
+        Pointer<ConsumerId> consumerId;
+        int prefetch;
+        int inflight;
+        bool stopped;
+        long long bytesHeld;
+        long long peakBytesHeld;
+        std::deque<long long> inflightSizes;
+
+    private:
+
+        StandInBroker(const StandInBroker&);
+        StandInBroker& operator=(const StandInBroker&);
+
+    public:
+
+        StandInBroker(mock::MockTransport* transport) :
+            transport(transport), mutex(), queue(), consumerId(), prefetch(0), inflight(0),
+            stopped(false), bytesHeld(0), peakBytesHeld(0), inflightSizes() {}
+
+        virtual ~StandInBroker() {}
+
+        long long getPeakBytesHeld() const {
+            return peakBytesHeld;
+        }
+
+        void stop() {
+            synchronized(&mutex) {
+                stopped = true;
+                mutex.notifyAll();
+            }
+        }
+
+        virtual void onCommand(const Pointer<Command> command) {
+
+            synchronized(&mutex) {
+
+                if (command->isConsumerInfo()) {
+                    Pointer<ConsumerInfo> info = command.dynamicCast<ConsumerInfo>();
+                    consumerId = info->getConsumerId();
+                    prefetch = info->getPrefetchSize();
+                } else if (command->isMessage()) {
+
+                    while (!stopped && (int) queue.size() >= BROKER_CAPACITY) {
+                        mutex.wait();
+                    }
+
+                    Pointer<ActiveMQBytesMessage> message = command.dynamicCast<ActiveMQBytesMessage>();
+                    queue.push_back(message);
+                    bytesHeld += (long long) message->getContent().size();
+                    peakBytesHeld = bytesHeld > peakBytesHeld ? bytesHeld : peakBytesHeld;
+                } else if (command->isMessageAck()) {
+
+                    Pointer<MessageAck> ack = command.dynamicCast<MessageAck>();
+                    if (ack->getAckType() == ActiveMQConstants::ACK_TYPE_CONSUMED) {
+                        for (int i = 0; i < ack->getMessageCount() && !inflightSizes.empty(); ++i) {
+                            bytesHeld -= inflightSizes.front();
+                            inflightSizes.pop_front();
+                            inflight--;
+                        }
+                    }
+                }
+
+                mutex.notifyAll();
+            }
+        }
+
+        // Dispatches from its own thread so that the consumer is never called
+        // while a sender is waiting on the queue.
+        virtual void run() {
+
+            while (true) {
+
+                Pointer<MessageDispatch> dispatch(new MessageDispatch());
+
+                synchronized(&mutex) {
+
+                    while (!stopped && (consumerId == NULL || queue.empty() || inflight >= prefetch)) {
+                        mutex.wait();
+                    }
+
+                    if (stopped) {
+                        return;
+                    }
+
+                    Pointer<Message> message = queue.front();
+                    queue.pop_front();
+                    inflight++;
+                    inflightSizes.push_back((long long) message.dynamicCast<ActiveMQBytesMessage>()->getContent().size());
+
+                    dispatch->setMessage(message);
+                    dispatch->setConsumerId(consumerId);
+                    dispatch->setDestination(message->getDestination());
+
+                    mutex.notifyAll();
+                }
+
+                transport->fireCommand(dispatch);
+            }
+        }
+
+        virtual void onException(const decaf::lang::Exception& ex AMQCPP_UNUSED) {}
+        virtual void transportInterrupted() {}
+        virtual void transportResumed() {}
+    };
+
+    class StreamReader : public Runnable {
+    private:
+
+        ActiveMQInputStream* in;
+
+    private:
+
+        StreamReader(const StreamReader&);
+        StreamReader& operator=(const StreamReader&);
+
+    public:
+
+        long long bytesRead;
+
+    public:
+
+        StreamReader(ActiveMQInputStream* in) : in(in), bytesRead(0) {}
+
+        virtual ~StreamReader() {}
+
+        virtual void run() {
+
+            std::vector<unsigned char> buffer(64 * 1024);
+
+            int count = 0;
+            while ((count = in->read(&buffer[0], (int) buffer.size())) != -1) {
+                bytesRead += count;
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+StreamTransferBenchmark::StreamTransferBenchmark() : connection(), transferTime(0), peakBytesHeld(0) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+StreamTransferBenchmark::~StreamTransferBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StreamTransferBenchmark::setUp() {
+
+    ActiveMQConnectionFactory factory("mock://127.0.0.1:12345?wireFormat=openwire");
+
+    connection.reset(dynamic_cast<ActiveMQConnection*>(factory.createConnection()));
+    connection->getPrefetchPolicy()->setQueuePrefetch(PREFETCH);
+    connection->start();
+
+    transferTime = 0;
+    peakBytesHeld = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StreamTransferBenchmark::tearDown() {
+
+    if (connection.get() != NULL) {
+        connection->close();
+        connection.reset(NULL);
+    }
+
+    std::cout << "Stream transfer of " << TRANSFER_SIZE / (1024 * 1024) << " MB in "
+              << CHUNK_SIZE / 1024 << " KB chunks = " << transferTime / 1000000 << " Millisecs, "
+              << (transferTime > 0 ? (TRANSFER_SIZE * 1000 / transferTime) : 0) << " MB/s, "
+              << "peak chunk memory held = " << peakBytesHeld / (1024 * 1024) << " MB" << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StreamTransferBenchmark::run() {
+
+    mock::MockTransport* transport = dynamic_cast<mock::MockTransport*>(
+        connection->getTransport().narrow(typeid(mock::MockTransport)));
+
+    StandInBroker broker(transport);
+    transport->setOutgoingListener(&broker);
+
+    Thread dispatcher(&broker);
+    dispatcher.start();
+
+    ActiveMQQueue queue("benchmark.stream");
+    ActiveMQInputStream in(connection.get(), &queue);
+    ActiveMQOutputStream out(connection.get(), &queue, CHUNK_SIZE);
+
+    StreamReader reader(&in);
+    Thread readerThread(&reader);
+
+    std::vector<unsigned char> payload(CHUNK_SIZE, 'x');
+
+    long long start = System::nanoTime();
+    readerThread.start();
+
+    for (long long written = 0; written < TRANSFER_SIZE; written += CHUNK_SIZE) {
+        out.write(&payload[0], CHUNK_SIZE);
+    }
+    out.close();
+
+    readerThread.join();
+    transferTime += System::nanoTime() - start;
+
+    if (reader.bytesRead != TRANSFER_SIZE) {
+        std::cout << "Stream transfer read " << reader.bytesRead << " of " << TRANSFER_SIZE << " bytes" << std::endl;
+    }
+
+    peakBytesHeld = broker.getPeakBytesHeld();
+
+    broker.stop();
+    dispatcher.join();
+    transport->setOutgoingListener(NULL);
+}
@@ -0,0 +1,60 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CORE_STREAMTRANSFERBENCHMARK_H_
+#define _ACTIVEMQ_CORE_STREAMTRANSFERBENCHMARK_H_
+
+#include <benchmark/BenchmarkBase.h>
+
+#include <activemq/core/ActiveMQConnection.h>
+#include <activemq/core/ActiveMQOutputStream.h>
+
+#include <memory>
+
+namespace activemq {
+namespace core {
+
+    /**
+     * Measures streaming a 4 GB payload from an ActiveMQOutputStream to an
+     * ActiveMQInputStream read on another thread, through a stand in for the Broker
+     * on the mock transport that honours the consumer's prefetch and holds only a
+     * small number of chunks before it stops taking more from the producer.  The
+     * throughput and the most chunk memory held at any one time are reported on
+     * tearDown.
+     */
+    class StreamTransferBenchmark :
+        public benchmark::BenchmarkBase< activemq::core::StreamTransferBenchmark, ActiveMQOutputStream, 1 > {
+    private:
+
+        std::auto_ptr<ActiveMQConnection> connection;
+        long long transferTime;
+        long long peakBytesHeld;
+
+    public:
+
+        StreamTransferBenchmark();
+        virtual ~StreamTransferBenchmark();
+
+        virtual void setUp();
+        virtual void tearDown();
+        virtual void run();
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_CORE_STREAMTRANSFERBENCHMARK_H_ */
@@ -0,0 +1,121 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MemoryUsageBenchmark.h"
+
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/Runnable.h>
+
+#include <vector>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::util;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const int PRODUCER_COUNT = 64;
+    const int SENDS_PER_PRODUCER = 500;
+    const int MESSAGE_SIZE = 1024;
+    const int WINDOW_SIZE = 16 * MESSAGE_SIZE;
+
+    class ProducerTask : public Runnable {
+    private:
+
+        MemoryUsage* window;
+
+    private:
+
+        ProducerTask(const ProducerTask&);
+        ProducerTask& operator=(const ProducerTask&);
+
+    public:
+
+        ProducerTask(MemoryUsage* window) : Runnable(), window(window) {}
+
+        virtual void run() {
+            for (int i = 0; i < SENDS_PER_PRODUCER; ++i) {
+                window->enqueueUsage(MESSAGE_SIZE);
+            }
+        }
+    };
+
+    class AckTask : public Runnable {
+    private:
+
+        MemoryUsage* window;
+
+    private:
+
+        AckTask(const AckTask&);
+        AckTask& operator=(const AckTask&);
+
+    public:
+
+        AckTask(MemoryUsage* window) : Runnable(), window(window) {}
+
+        virtual void run() {
+            int remaining = PRODUCER_COUNT * SENDS_PER_PRODUCER;
+            while (remaining > 0) {
+                if (window->getUsage() >= (unsigned long long) MESSAGE_SIZE) {
+                    window->decreaseUsage(MESSAGE_SIZE);
+                    remaining--;
+                } else {
+                    Thread::yield();
+                }
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MemoryUsageBenchmark::MemoryUsageBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MemoryUsageBenchmark::~MemoryUsageBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryUsageBenchmark::run() {
+
+    MemoryUsage window(WINDOW_SIZE);
+
+    AckTask ackTask(&window);
+    Thread acker(&ackTask);
+
+    std::vector<ProducerTask*> tasks;
+    std::vector<Thread*> producers;
+    for (int i = 0; i < PRODUCER_COUNT; ++i) {
+        tasks.push_back(new ProducerTask(&window));
+        producers.push_back(new Thread(tasks.back()));
+    }
+
+    acker.start();
+    for (int i = 0; i < PRODUCER_COUNT; ++i) {
+        producers[i]->start();
+    }
+
+    for (int i = 0; i < PRODUCER_COUNT; ++i) {
+        producers[i]->join();
+        delete producers[i];
+        delete tasks[i];
+    }
+    acker.join();
+}
@@ -0,0 +1,46 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_UTIL_MEMORYUSAGEBENCHMARK_H_
+#define _ACTIVEMQ_UTIL_MEMORYUSAGEBENCHMARK_H_
+
+#include <benchmark/BenchmarkBase.h>
+
+#include <activemq/util/MemoryUsage.h>
+
+namespace activemq {
+namespace util {
+
+    /**
+     * Measures the time for 64 producer threads that share one send window to push a
+     * fixed volume of sends through it while a single thread returns the window space
+     * as ProducerAcks would.
+     */
+    class MemoryUsageBenchmark :
+        public benchmark::BenchmarkBase< activemq::util::MemoryUsageBenchmark, MemoryUsage, 10 > {
+    public:
+
+        MemoryUsageBenchmark();
+        virtual ~MemoryUsageBenchmark();
+
+        virtual void run();
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_UTIL_MEMORYUSAGEBENCHMARK_H_ */
@@ -17,15 +17,31 @@
 
 #include "PrimitiveMapBenchmark.h"
 
+#include <activemq/wireformat/openwire/marshal/PrimitiveMapReader.h>
+#include <activemq/wireformat/openwire/marshal/PrimitiveTypesMarshaller.h>
+
+#include <iostream>
 #include <string>
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/System.h>
 #include <decaf/lang/Thread.h>
 
 using namespace std;
 using namespace activemq;
 using namespace activemq::util;
+using namespace activemq::wireformat::openwire::marshal;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const int FIELDS = 500;
+    const int READS = 200;
+}
 
 ////////////////////////////////////////////////////////////////////////////////
-PrimitiveMapBenchmark::PrimitiveMapBenchmark() : map(), testString(), byteBuffer() {}
+PrimitiveMapBenchmark::PrimitiveMapBenchmark() :
+    map(), testString(), byteBuffer(), marshaledFields(), unmarshalTime(0), readerTime(0) {}
 
 ////////////////////////////////////////////////////////////////////////////////
 PrimitiveMapBenchmark::~PrimitiveMapBenchmark() {}
@@ -36,6 +52,28 @@ void PrimitiveMapBenchmark::setUp(){
         testString += "a";
         byteBuffer.push_back( 'a' );
     }
+
+    PrimitiveMap fields;
+    for( int i = 0; i < FIELDS; ++i ) {
+        std::string name = "field" + Integer::toString( i );
+        if( i % 2 == 0 ) {
+            fields.setString( name, "value of " + name );
+        } else {
+            fields.setLong( name, i );
+        }
+    }
+    PrimitiveTypesMarshaller::marshal( &fields, marshaledFields );
+
+    unmarshalTime = 0;
+    readerTime = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PrimitiveMapBenchmark::tearDown() {
+
+    std::cout << "Read 2 of " << FIELDS << " marshaled fields " << READS << " times, unmarshaled = "
+              << unmarshalTime / 1000000 << " Millisecs, reader = "
+              << readerTime / 1000000 << " Millisecs" << std::endl;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -120,4 +158,22 @@ void PrimitiveMapBenchmark::run() {
         PrimitiveMap theCopy;
         theCopy.copy( map );
     }
+
+    // Read a couple of fields of a large map as a consumer of a MapMessage would.
+    long long start = System::nanoTime();
+    for( int i = 0; i < READS; ++i ){
+        PrimitiveMap fields;
+        PrimitiveTypesMarshaller::unmarshal( &fields, marshaledFields );
+        CPPUNIT_ASSERT(fields.getLong( "field1" ) == 1);
+        CPPUNIT_ASSERT(fields.getString( "field400" ) == "value of field400");
+    }
+    unmarshalTime += System::nanoTime() - start;
+
+    start = System::nanoTime();
+    for( int i = 0; i < READS; ++i ){
+        PrimitiveMapReader reader( &marshaledFields[0], (int)marshaledFields.size() );
+        CPPUNIT_ASSERT(reader.get( "field1" ).getLong() == 1);
+        CPPUNIT_ASSERT(reader.get( "field400" ).getString() == "value of field400");
+    }
+    readerTime += System::nanoTime() - start;
 }
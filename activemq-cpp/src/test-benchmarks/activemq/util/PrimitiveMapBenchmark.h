@@ -25,6 +25,12 @@
 namespace activemq{
 namespace util{
 
+    /**
+     * Measures setting, getting and copying the values of a PrimitiveMap.  It also reads
+     * two fields out of a marshaled map with many fields, once by unmarshaling the whole
+     * map and once through a PrimitiveMapReader that decodes only the fields asked for,
+     * those times are reported on tearDown.
+     */
     class PrimitiveMapBenchmark :
         public benchmark::BenchmarkBase<
             activemq::util::PrimitiveMapBenchmark, PrimitiveMap >
@@ -34,6 +40,9 @@ namespace util{
         PrimitiveMap map;
         std::string testString;
         std::vector<unsigned char> byteBuffer;
+        std::vector<unsigned char> marshaledFields;
+        long long unmarshalTime;
+        long long readerTime;
 
     public:
 
@@ -41,6 +50,7 @@ namespace util{
         virtual ~PrimitiveMapBenchmark();
 
         void setUp();
+        void tearDown();
         void run();
 
     };
@@ -0,0 +1,136 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LargeMessageSendBenchmark.h"
+
+#include <activemq/commands/ActiveMQBytesMessage.h>
+#include <activemq/transport/IOTransport.h>
+#include <decaf/io/OutputStream.h>
+#include <decaf/io/BufferedOutputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/lang/System.h>
+#include <decaf/util/Properties.h>
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::commands;
+using namespace activemq::transport;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::util;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const int MEGABYTE = 1024 * 1024;
+    const int BODY_SIZES[] = { 1 * MEGABYTE, 10 * MEGABYTE, 100 * MEGABYTE };
+    const int BODY_SIZE_COUNT = (int) (sizeof(BODY_SIZES) / sizeof(int));
+
+    // Stands in for the socket, every byte written is copied once into a scratch
+    // buffer the way the kernel copies it into the socket send buffer.
+    class SocketOutputStream : public OutputStream {
+    private:
+
+        std::vector<unsigned char> scratch;
+
+    public:
+
+        SocketOutputStream() : OutputStream(), scratch(64 * 1024) {}
+        virtual ~SocketOutputStream() {}
+
+    protected:
+
+        virtual void doWriteByte(unsigned char value) {
+            scratch[0] = value;
+        }
+
+        virtual void doWriteArrayBounded(const unsigned char* buffer, int size DECAF_UNUSED, int offset, int length) {
+
+            const unsigned char* data = buffer + offset;
+            while (length > 0) {
+                int chunk = std::min(length, (int) scratch.size());
+                std::copy(data, data + chunk, scratch.begin());
+                data += chunk;
+                length -= chunk;
+            }
+        }
+    };
+
+    long long send(OpenWireFormat& format, const Pointer<ActiveMQBytesMessage>& message) {
+
+        IOTransport transport;
+        SocketOutputStream socket;
+        BufferedOutputStream buffered(&socket);
+        DataOutputStream out(&buffered);
+
+        long long start = System::nanoTime();
+        format.marshal(message, &transport, &out);
+        out.flush();
+
+        return System::nanoTime() - start;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LargeMessageSendBenchmark::LargeMessageSendBenchmark() : copiedTime(0), referencedTime(0) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LargeMessageSendBenchmark::~LargeMessageSendBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LargeMessageSendBenchmark::setUp() {
+    copiedTime = 0;
+    referencedTime = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LargeMessageSendBenchmark::tearDown() {
+
+    std::cout << "Large message send of 1, 10 and 100 MB bodies, body copied = "
+              << copiedTime / 1000000 << " Millisecs, body referenced = "
+              << referencedTime / 1000000 << " Millisecs" << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LargeMessageSendBenchmark::run() {
+
+    Properties properties;
+
+    OpenWireFormat copyingFormat(properties);
+    copyingFormat.setTightEncodingEnabled(true);
+    copyingFormat.setZeroCopyThreshold(0);
+
+    OpenWireFormat referencingFormat(properties);
+    referencingFormat.setTightEncodingEnabled(true);
+
+    for (int i = 0; i < BODY_SIZE_COUNT; ++i) {
+
+        Pointer<ActiveMQBytesMessage> message(new ActiveMQBytesMessage());
+        message->setContent(std::vector<unsigned char>(BODY_SIZES[i], 'x'));
+
+        copiedTime += send(copyingFormat, message);
+        referencedTime += send(referencingFormat, message);
+    }
+}
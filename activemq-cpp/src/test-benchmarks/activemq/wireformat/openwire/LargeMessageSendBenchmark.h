@@ -0,0 +1,55 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_WIREFORMAT_OPENWIRE_LARGEMESSAGESENDBENCHMARK_H_
+#define _ACTIVEMQ_WIREFORMAT_OPENWIRE_LARGEMESSAGESENDBENCHMARK_H_
+
+#include <benchmark/BenchmarkBase.h>
+
+#include <activemq/wireformat/openwire/OpenWireFormat.h>
+
+namespace activemq {
+namespace wireformat {
+namespace openwire {
+
+    /**
+     * Measures sending BytesMessages with bodies from one to one hundred megabytes
+     * through the same buffered stream stack the TCP transport uses, once with the
+     * body copied into the frame buffer and once with it referenced and handed to
+     * the stream in a gathering write.  The times are reported on tearDown.
+     */
+    class LargeMessageSendBenchmark :
+        public benchmark::BenchmarkBase< activemq::wireformat::openwire::LargeMessageSendBenchmark, OpenWireFormat, 5 > {
+    private:
+
+        long long copiedTime;
+        long long referencedTime;
+
+    public:
+
+        LargeMessageSendBenchmark();
+        virtual ~LargeMessageSendBenchmark();
+
+        virtual void setUp();
+        virtual void tearDown();
+        virtual void run();
+
+    };
+
+}}}
+
+#endif /* _ACTIVEMQ_WIREFORMAT_OPENWIRE_LARGEMESSAGESENDBENCHMARK_H_ */
@@ -0,0 +1,195 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MessageFanOutBenchmark.h"
+
+#include <activemq/commands/ActiveMQBytesMessage.h>
+#include <activemq/commands/ActiveMQQueue.h>
+#include <activemq/commands/MessageId.h>
+#include <activemq/commands/ProducerId.h>
+#include <activemq/transport/IOTransport.h>
+#include <decaf/io/OutputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/System.h>
+#include <decaf/util/Properties.h>
+
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::commands;
+using namespace activemq::transport;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::util;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const int DESTINATIONS = 32;
+    const int PROPERTIES = 16;
+    const int BODY_SIZE = 1024;
+    const int ROUNDS = 100;
+
+    class NullOutputStream : public OutputStream {
+    protected:
+
+        virtual void doWriteByte(unsigned char value DECAF_UNUSED) {}
+
+        virtual void doWriteArrayBounded(const unsigned char* buffer DECAF_UNUSED, int size DECAF_UNUSED,
+                                         int offset DECAF_UNUSED, int length DECAF_UNUSED) {}
+    };
+
+    Pointer<ActiveMQBytesMessage> createMessage() {
+
+        Pointer<ActiveMQBytesMessage> message(new ActiveMQBytesMessage());
+        message->setContent(std::vector<unsigned char>(BODY_SIZE, 'x'));
+
+        for (int i = 0; i < PROPERTIES; ++i) {
+            message->setStringProperty("property-" + Integer::toString(i), "value-" + Integer::toString(i));
+        }
+
+        return message;
+    }
+
+    std::vector< Pointer<ActiveMQDestination> > createDestinations() {
+
+        std::vector< Pointer<ActiveMQDestination> > destinations;
+        for (int i = 0; i < DESTINATIONS; ++i) {
+            destinations.push_back(Pointer<ActiveMQDestination>(
+                new ActiveMQQueue("benchmark.fanout." + Integer::toString(i))));
+        }
+
+        return destinations;
+    }
+
+    // Copies the Message for each destination and marshals the copies, returns the
+    // time taken and leaves the sent copies in the given vector.
+    long long fanOut(OpenWireFormat& format, const Pointer<Message>& source, bool shareProperties,
+                     const std::vector< Pointer<ActiveMQDestination> >& destinations,
+                     std::vector< Pointer<Command> >& sent) {
+
+        Pointer<ProducerId> producerId(new ProducerId());
+        producerId->setConnectionId("ID:benchmark-host-1234-5678-0:1");
+        producerId->setSessionId(1);
+        producerId->setValue(1);
+
+        IOTransport transport;
+        NullOutputStream sink;
+        DataOutputStream out(&sink);
+
+        long long start = System::nanoTime();
+        for (int i = 0; i < (int) destinations.size(); ++i) {
+
+            if (shareProperties) {
+                source->marshalProperties();
+            }
+
+            Pointer<Message> copy(source->cloneDataStructure());
+            if (!shareProperties) {
+                copy->invalidateMarshalledProperties();
+            }
+
+            Pointer<MessageId> id(new MessageId());
+            id->setProducerId(producerId);
+            id->setProducerSequenceId(i + 1);
+
+            copy->setMessageId(id);
+            copy->setProducerId(producerId);
+            copy->setDestination(destinations[i]);
+            copy->setCommandId(i + 1);
+
+            format.marshal(copy, &transport, &out);
+            sent.push_back(copy);
+        }
+
+        return System::nanoTime() - start;
+    }
+
+    long long replay(OpenWireFormat& format, const std::vector< Pointer<Command> >& sent) {
+
+        IOTransport transport;
+        NullOutputStream sink;
+        DataOutputStream out(&sink);
+
+        long long start = System::nanoTime();
+        for (int i = 0; i < (int) sent.size(); ++i) {
+            sent[i]->setCommandId(i + DESTINATIONS + 1);
+            format.marshal(sent[i], &transport, &out);
+        }
+
+        return System::nanoTime() - start;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MessageFanOutBenchmark::MessageFanOutBenchmark() :
+    reencodedTime(0), sharedTime(0), replayTime(0), cachedReplayTime(0) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MessageFanOutBenchmark::~MessageFanOutBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageFanOutBenchmark::setUp() {
+    reencodedTime = 0;
+    sharedTime = 0;
+    replayTime = 0;
+    cachedReplayTime = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageFanOutBenchmark::tearDown() {
+
+    std::cout << "Message fan out to " << DESTINATIONS << " destinations, properties encoded per copy = "
+              << reencodedTime / 1000000 << " Millisecs, shared = "
+              << sharedTime / 1000000 << " Millisecs" << std::endl;
+    std::cout << "Message replay of " << DESTINATIONS << " copies, marshaled = "
+              << replayTime / 1000000 << " Millisecs, cached = "
+              << cachedReplayTime / 1000000 << " Millisecs" << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageFanOutBenchmark::run() {
+
+    Properties properties;
+    OpenWireFormat format(properties);
+    format.setTightEncodingEnabled(true);
+
+    OpenWireFormat cachingFormat(properties);
+    cachingFormat.setTightEncodingEnabled(true);
+    cachingFormat.setCacheMarshaledMessages(true);
+
+    Pointer<Message> source = createMessage();
+    std::vector< Pointer<ActiveMQDestination> > destinations = createDestinations();
+
+    for (int round = 0; round < ROUNDS; ++round) {
+
+        std::vector< Pointer<Command> > sent;
+        reencodedTime += fanOut(format, source, false, destinations, sent);
+        replayTime += replay(format, sent);
+
+        sent.clear();
+        sharedTime += fanOut(cachingFormat, source, true, destinations, sent);
+        cachedReplayTime += replay(cachingFormat, sent);
+    }
+}
@@ -0,0 +1,60 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_WIREFORMAT_OPENWIRE_MESSAGEFANOUTBENCHMARK_H_
+#define _ACTIVEMQ_WIREFORMAT_OPENWIRE_MESSAGEFANOUTBENCHMARK_H_
+
+#include <benchmark/BenchmarkBase.h>
+
+#include <activemq/wireformat/openwire/OpenWireFormat.h>
+
+namespace activemq {
+namespace wireformat {
+namespace openwire {
+
+    /**
+     * Measures a producer that sends one Message with a set of properties to many
+     * destinations, each send copies the Message and gives the copy its own id and
+     * destination the way the session does.  The copies are marshaled once with the
+     * properties encoded for every copy and once with the encoding shared from the
+     * original, then all of the copies are marshaled again as they would be when the
+     * connection state is replayed after a failover, with and without the cached
+     * frames.  The times are reported on tearDown.
+     */
+    class MessageFanOutBenchmark :
+        public benchmark::BenchmarkBase< activemq::wireformat::openwire::MessageFanOutBenchmark, OpenWireFormat, 10 > {
+    private:
+
+        long long reencodedTime;
+        long long sharedTime;
+        long long replayTime;
+        long long cachedReplayTime;
+
+    public:
+
+        MessageFanOutBenchmark();
+        virtual ~MessageFanOutBenchmark();
+
+        virtual void setUp();
+        virtual void tearDown();
+        virtual void run();
+
+    };
+
+}}}
+
+#endif /* _ACTIVEMQ_WIREFORMAT_OPENWIRE_MESSAGEFANOUTBENCHMARK_H_ */
@@ -0,0 +1,126 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "OpenWireFormatBenchmark.h"
+
+#include <activemq/commands/ActiveMQBytesMessage.h>
+#include <activemq/commands/MessageId.h>
+#include <activemq/commands/ProducerId.h>
+#include <activemq/transport/IOTransport.h>
+#include <decaf/io/OutputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/lang/System.h>
+#include <decaf/util/Properties.h>
+
+#include <iostream>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::commands;
+using namespace activemq::transport;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::util;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const int SIZES[] = { 64, 4 * 1024, 256 * 1024 };
+    const int SIZE_COUNT = (int) (sizeof(SIZES) / sizeof(int));
+    const int MESSAGES_PER_SIZE[] = { 2000, 1000, 50 };
+
+    class NullOutputStream : public OutputStream {
+    protected:
+
+        virtual void doWriteByte(unsigned char value DECAF_UNUSED) {}
+
+        virtual void doWriteArrayBounded(const unsigned char* buffer DECAF_UNUSED, int size DECAF_UNUSED,
+                                         int offset DECAF_UNUSED, int length DECAF_UNUSED) {}
+    };
+
+    Pointer<ActiveMQBytesMessage> createMessage(int bodySize) {
+
+        Pointer<ProducerId> producerId(new ProducerId());
+        producerId->setConnectionId("ID:benchmark-host-1234-5678-0:1");
+        producerId->setSessionId(1);
+        producerId->setValue(1);
+
+        Pointer<MessageId> messageId(new MessageId());
+        messageId->setProducerId(producerId);
+        messageId->setProducerSequenceId(1);
+
+        Pointer<ActiveMQBytesMessage> message(new ActiveMQBytesMessage());
+        message->setMessageId(messageId);
+        message->setContent(std::vector<unsigned char>(bodySize, 'x'));
+
+        return message;
+    }
+
+    long long marshalAll(bool tightEncoding, const Pointer<Command>& command, int count) {
+
+        Properties properties;
+        OpenWireFormat format(properties);
+        format.setTightEncodingEnabled(tightEncoding);
+
+        IOTransport transport;
+        NullOutputStream sink;
+        DataOutputStream out(&sink);
+
+        long long start = System::nanoTime();
+        for (int i = 0; i < count; ++i) {
+            format.marshal(command, &transport, &out);
+        }
+
+        return System::nanoTime() - start;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+OpenWireFormatBenchmark::OpenWireFormatBenchmark() : looseTimes(), tightTimes() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+OpenWireFormatBenchmark::~OpenWireFormatBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatBenchmark::setUp() {
+    looseTimes.assign(SIZE_COUNT, 0);
+    tightTimes.assign(SIZE_COUNT, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatBenchmark::tearDown() {
+
+    for (int i = 0; i < SIZE_COUNT; ++i) {
+        std::cout << "OpenWireFormat " << SIZES[i] << " byte messages, loose = "
+                  << looseTimes[i] / 1000000 << " Millisecs, tight = "
+                  << tightTimes[i] / 1000000 << " Millisecs" << std::endl;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatBenchmark::run() {
+
+    for (int i = 0; i < SIZE_COUNT; ++i) {
+        Pointer<Command> message = createMessage(SIZES[i]);
+        looseTimes[i] += marshalAll(false, message, MESSAGES_PER_SIZE[i]);
+        tightTimes[i] += marshalAll(true, message, MESSAGES_PER_SIZE[i]);
+    }
+}
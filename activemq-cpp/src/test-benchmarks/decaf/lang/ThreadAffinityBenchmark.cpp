@@ -0,0 +1,152 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ThreadAffinityBenchmark.h"
+
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/exceptions/UnsupportedOperationException.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+
+#include <algorithm>
+#include <iostream>
+
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util::concurrent::atomic;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const int ROUND_TRIPS = 1000;
+
+    class Ponger : public Runnable {
+    private:
+
+        AtomicInteger* token;
+
+    private:
+
+        Ponger(const Ponger&);
+        Ponger& operator=(const Ponger&);
+
+    public:
+
+        Ponger(AtomicInteger* token) : token(token) {}
+
+        virtual void run() {
+            for (int i = 0; i < ROUND_TRIPS; ++i) {
+                while (token->get() != 1) {
+                    Thread::yield();
+                }
+                token->set(0);
+            }
+        }
+    };
+
+    void pingPong(std::vector<long long>& samples, const std::vector<int>* placement) {
+
+        AtomicInteger token(0);
+        Ponger ponger(&token);
+        Thread pongThread(&ponger);
+
+        if (placement != NULL) {
+            std::vector<int> pingCpu(1, placement->at(0));
+            std::vector<int> pongCpu(1, placement->at(1));
+            Thread::currentThread()->setAffinity(pingCpu);
+            pongThread.setAffinity(pongCpu);
+        }
+
+        pongThread.start();
+
+        for (int i = 0; i < ROUND_TRIPS; ++i) {
+            long long start = System::nanoTime();
+            token.set(1);
+            while (token.get() != 0) {
+                Thread::yield();
+            }
+            samples.push_back(System::nanoTime() - start);
+        }
+
+        pongThread.join();
+    }
+
+    void report(const char* label, std::vector<long long>& samples) {
+
+        if (samples.empty()) {
+            std::cout << "ThreadAffinityBenchmark " << label << ": not available" << std::endl;
+            return;
+        }
+
+        std::sort(samples.begin(), samples.end());
+        std::size_t size = samples.size();
+
+        std::cout << "ThreadAffinityBenchmark " << label << " round trip nanos:"
+                  << " p50 = " << samples[size / 2]
+                  << " p99 = " << samples[(size * 99) / 100]
+                  << " p99.9 = " << samples[(size * 999) / 1000]
+                  << " max = " << samples[size - 1]
+                  << std::endl;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ThreadAffinityBenchmark::ThreadAffinityBenchmark() : cpus(), unpinned(), pinned() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ThreadAffinityBenchmark::~ThreadAffinityBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ThreadAffinityBenchmark::setUp() {
+
+    try {
+        this->cpus = Thread::currentThread()->getAffinity();
+    } catch (UnsupportedOperationException& ex) {
+        this->cpus.clear();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ThreadAffinityBenchmark::tearDown() {
+
+    if (this->cpus.size() >= 2) {
+        Thread::currentThread()->setAffinity(this->cpus);
+    }
+
+    report("unpinned", this->unpinned);
+    report("pinned", this->pinned);
+
+    this->unpinned.clear();
+    this->pinned.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ThreadAffinityBenchmark::run() {
+
+    if (this->cpus.size() >= 2) {
+        Thread::currentThread()->setAffinity(this->cpus);
+    }
+
+    pingPong(this->unpinned, NULL);
+
+    if (this->cpus.size() >= 2) {
+        pingPong(this->pinned, &this->cpus);
+    }
+}
@@ -0,0 +1,55 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_LANG_THREADAFFINITYBENCHMARK_H_
+#define _DECAF_LANG_THREADAFFINITYBENCHMARK_H_
+
+#include <benchmark/BenchmarkBase.h>
+#include <decaf/lang/Thread.h>
+
+#include <vector>
+
+namespace decaf {
+namespace lang {
+
+    /**
+     * Measures the round trip latency of handing a token back and forth between two
+     * threads, once with both threads left to the scheduler and once with each pinned
+     * to its own processor.  The spread of the round trip times shows the jitter that
+     * thread migration adds.
+     */
+    class ThreadAffinityBenchmark : public benchmark::BenchmarkBase< decaf::lang::ThreadAffinityBenchmark, Thread > {
+    private:
+
+        std::vector<int> cpus;
+        std::vector<long long> unpinned;
+        std::vector<long long> pinned;
+
+    public:
+
+        ThreadAffinityBenchmark();
+        virtual ~ThreadAffinityBenchmark();
+
+        virtual void setUp();
+        virtual void tearDown();
+        virtual void run();
+
+    };
+
+}}
+
+#endif /* _DECAF_LANG_THREADAFFINITYBENCHMARK_H_ */
@@ -0,0 +1,126 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StripedReadWriteLockBenchmark.h"
+
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
+#include <decaf/util/concurrent/locks/ReentrantReadWriteLock.h>
+
+#include <iostream>
+#include <vector>
+
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::locks;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const int NUM_READERS = 4;
+    const int READS_PER_THREAD = 10000;
+
+    class Reader : public Runnable {
+    private:
+
+        ReadWriteLock* lock;
+        CountDownLatch* startSignal;
+
+    private:
+
+        Reader(const Reader&);
+        Reader& operator=(const Reader&);
+
+    public:
+
+        Reader(ReadWriteLock* lock, CountDownLatch* startSignal) : lock(lock), startSignal(startSignal) {}
+
+        virtual void run() {
+            startSignal->await();
+            for (int i = 0; i < READS_PER_THREAD; ++i) {
+                lock->readLock().lock();
+                lock->readLock().unlock();
+            }
+        }
+    };
+
+    long long readers(ReadWriteLock* lock) {
+
+        CountDownLatch startSignal(1);
+        std::vector<Reader*> runnables;
+        std::vector<Thread*> threads;
+
+        for (int i = 0; i < NUM_READERS; ++i) {
+            runnables.push_back(new Reader(lock, &startSignal));
+            threads.push_back(new Thread(runnables.back()));
+            threads.back()->start();
+        }
+
+        long long start = System::nanoTime();
+        startSignal.countDown();
+
+        for (int i = 0; i < NUM_READERS; ++i) {
+            threads[i]->join();
+        }
+
+        long long elapsed = System::nanoTime() - start;
+
+        for (int i = 0; i < NUM_READERS; ++i) {
+            delete threads[i];
+            delete runnables[i];
+        }
+
+        return elapsed;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+StripedReadWriteLockBenchmark::StripedReadWriteLockBenchmark() : stripedNanos(0), reentrantNanos(0) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+StripedReadWriteLockBenchmark::~StripedReadWriteLockBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StripedReadWriteLockBenchmark::setUp() {
+    this->stripedNanos = 0;
+    this->reentrantNanos = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StripedReadWriteLockBenchmark::tearDown() {
+
+    std::cout << "StripedReadWriteLockBenchmark " << NUM_READERS << " readers, total nanos:"
+              << " StripedReadWriteLock = " << this->stripedNanos
+              << " ReentrantReadWriteLock = " << this->reentrantNanos
+              << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StripedReadWriteLockBenchmark::run() {
+
+    StripedReadWriteLock striped;
+    this->stripedNanos += readers(&striped);
+
+    ReentrantReadWriteLock reentrant;
+    this->reentrantNanos += readers(&reentrant);
+}
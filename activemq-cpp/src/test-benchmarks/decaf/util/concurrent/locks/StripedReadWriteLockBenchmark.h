@@ -0,0 +1,55 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_UTIL_CONCURRENT_LOCKS_STRIPEDREADWRITELOCKBENCHMARK_H_
+#define _DECAF_UTIL_CONCURRENT_LOCKS_STRIPEDREADWRITELOCKBENCHMARK_H_
+
+#include <benchmark/BenchmarkBase.h>
+#include <decaf/util/concurrent/locks/StripedReadWriteLock.h>
+
+namespace decaf {
+namespace util {
+namespace concurrent {
+namespace locks {
+
+    /**
+     * Runs a number of reader threads that repeatedly take and release the read lock,
+     * once against a StripedReadWriteLock and once against a ReentrantReadWriteLock, and
+     * reports the total time spent by each so the cost of readers contending on the
+     * lock state can be compared.
+     */
+    class StripedReadWriteLockBenchmark :
+        public benchmark::BenchmarkBase< decaf::util::concurrent::locks::StripedReadWriteLockBenchmark, StripedReadWriteLock > {
+    private:
+
+        long long stripedNanos;
+        long long reentrantNanos;
+
+    public:
+
+        StripedReadWriteLockBenchmark();
+        virtual ~StripedReadWriteLockBenchmark();
+
+        virtual void setUp();
+        virtual void tearDown();
+        virtual void run();
+
+    };
+
+}}}}
+
+#endif /* _DECAF_UTIL_CONCURRENT_LOCKS_STRIPEDREADWRITELOCKBENCHMARK_H_ */
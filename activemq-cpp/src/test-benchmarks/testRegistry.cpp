@@ -17,11 +17,32 @@
 
 #include <activemq/util/PrimitiveMapBenchmark.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::util::PrimitiveMapBenchmark );
+#include <activemq/util/MemoryUsageBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::util::MemoryUsageBenchmark );
+
+#include <activemq/wireformat/openwire/OpenWireFormatBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::openwire::OpenWireFormatBenchmark );
+#include <activemq/wireformat/openwire/MessageFanOutBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::openwire::MessageFanOutBenchmark );
+#include <activemq/wireformat/openwire/LargeMessageSendBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::openwire::LargeMessageSendBenchmark );
+
+#include <activemq/core/PriorityMessageDispatchChannelBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::PriorityMessageDispatchChannelBenchmark<activemq::core::PriorityMessageDispatchChannel> );
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::PriorityMessageDispatchChannelBenchmark<activemq::core::SimplePriorityMessageDispatchChannel> );
+#include <activemq/core/SessionStartupBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::SessionStartupBenchmark );
+#include <activemq/core/StreamTransferBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::StreamTransferBenchmark );
+#include <activemq/core/ProducerMessageTemplateBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::ProducerMessageTemplateBenchmark );
 
 #include <decaf/lang/BooleanBenchmark.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::lang::BooleanBenchmark );
 #include <decaf/lang/ThreadBenchmark.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::lang::ThreadBenchmark );
+#include <decaf/lang/ThreadAffinityBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::lang::ThreadAffinityBenchmark );
 
 #include <decaf/util/PropertiesBenchmark.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::PropertiesBenchmark );
@@ -37,6 +58,8 @@ CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::HashMapBenchmark );
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::StlListBenchmark );
 #include <decaf/util/LinkedListBenchmark.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::LinkedListBenchmark );
+#include <decaf/util/concurrent/locks/StripedReadWriteLockBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::concurrent::locks::StripedReadWriteLockBenchmark );
 
 #include <decaf/io/ByteArrayOutputStreamBenchmark.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::io::ByteArrayOutputStreamBenchmark );
@@ -19,6 +19,7 @@
 
 #include <activemq/util/CMSListener.h>
 #include <activemq/core/ActiveMQConnection.h>
+#include <activemq/core/ActiveMQConsumer.h>
 #include <activemq/core/PrefetchPolicy.h>
 #include <activemq/exceptions/ActiveMQException.h>
 
@@ -383,3 +384,39 @@ void OpenwireSimpleTest::testMessageIdSetOnSend() {
     CPPUNIT_ASSERT(message->getCMSMessageID() != "");
     CPPUNIT_ASSERT(message->getCMSDestination() != NULL);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenwireSimpleTest::testReceiveBatch() {
+
+    // Create CMS Object for Comms
+    cms::Session* session(cmsProvider->getSession());
+    ActiveMQConsumer* consumer = dynamic_cast<ActiveMQConsumer*>(cmsProvider->getConsumer());
+    CPPUNIT_ASSERT(consumer != NULL);
+    cms::MessageProducer* producer = cmsProvider->getProducer();
+    producer->setDeliveryMode(DeliveryMode::NON_PERSISTENT);
+
+    const int MSG_COUNT = 50;
+
+    auto_ptr<cms::TextMessage> txtMessage(session->createTextMessage("TEST MESSAGE"));
+    for (int i = 0; i < MSG_COUNT; ++i) {
+        producer->send(txtMessage.get());
+    }
+
+    std::vector<cms::Message*> messages;
+
+    int received = 0;
+    while (received < MSG_COUNT) {
+        int count = consumer->receiveBatch(messages, 10, 2000);
+        CPPUNIT_ASSERT(count > 0);
+        CPPUNIT_ASSERT(count <= 10);
+        received += count;
+    }
+
+    CPPUNIT_ASSERT_EQUAL(MSG_COUNT, (int) messages.size());
+    CPPUNIT_ASSERT_EQUAL(0, consumer->receiveBatch(messages, 10, 0));
+
+    std::vector<cms::Message*>::iterator iter = messages.begin();
+    for (; iter != messages.end(); ++iter) {
+        delete *iter;
+    }
+}
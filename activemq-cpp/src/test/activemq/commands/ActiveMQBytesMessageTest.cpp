@@ -20,6 +20,13 @@
 #include <decaf/util/UUID.h>
 #include <decaf/lang/Exception.h>
 #include <activemq/commands/ActiveMQBytesMessage.h>
+#include <decaf/internal/io/MemoryMappedFile.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/util/zip/DeflaterOutputStream.h>
+
+#include <cstring>
+#include <memory>
 
 using namespace std;
 using namespace cms;
@@ -28,6 +35,24 @@ using namespace activemq::util;
 using namespace activemq::commands;
 using namespace decaf;
 using namespace decaf::lang;
+using namespace decaf::io;
+using namespace decaf::util::zip;
+using namespace decaf::internal::io;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    void createFile(const std::string& path, int size) {
+
+        MemoryMappedFile file;
+        file.create(path, size);
+        for (int i = 0; i < size; ++i) {
+            file.getBuffer()[i] = (unsigned char) i;
+        }
+        file.setLength(size);
+        file.close();
+    }
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQBytesMessageTest::testGetBodyLength() {
@@ -459,3 +484,182 @@ void ActiveMQBytesMessageTest::testWriteOnlyBody() {
     } catch( MessageNotReadableException& e ) {
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQBytesMessageTest::testSetBodyFromFile() {
+
+    const std::string path = "bytes-message-body-test.bin";
+    createFile(path, 64);
+
+    {
+        ActiveMQBytesMessage message;
+        message.writeInt(42);
+        message.setBodyFromFile(path, 16, 32);
+
+        CPPUNIT_ASSERT(message.getMappedContent() != NULL);
+        CPPUNIT_ASSERT(message.isReadOnlyBody());
+        CPPUNIT_ASSERT_EQUAL(32, message.getContentLength());
+        CPPUNIT_ASSERT_EQUAL(32, message.getBodyLength());
+
+        std::vector<unsigned char> body(32);
+        CPPUNIT_ASSERT_EQUAL(32, message.readBytes(body));
+        for (int i = 0; i < 32; ++i) {
+            CPPUNIT_ASSERT_EQUAL((unsigned char) (16 + i), body[i]);
+        }
+
+        // Copies share the mapping rather than copying the body.
+        std::auto_ptr<ActiveMQBytesMessage> copy(message.cloneDataStructure());
+        CPPUNIT_ASSERT(copy->getMappedContent().get() == message.getMappedContent().get());
+        CPPUNIT_ASSERT_EQUAL(32, copy->getBodyLength());
+
+        // Neither the clone nor a second clone reads the body onto the heap.
+        std::auto_ptr<ActiveMQBytesMessage> second(copy->cloneDataStructure());
+        CPPUNIT_ASSERT(second->getMappedContent().get() == message.getMappedContent().get());
+        const ActiveMQBytesMessage& constMessage = message;
+        const ActiveMQBytesMessage& constCopy = *copy;
+        const ActiveMQBytesMessage& constSecond = *second;
+        CPPUNIT_ASSERT(constMessage.getContent().empty());
+        CPPUNIT_ASSERT(constCopy.getContent().empty());
+        CPPUNIT_ASSERT(constSecond.getContent().empty());
+        CPPUNIT_ASSERT_EQUAL(32, second->getContentLength());
+
+        // Handing out the content for modification copies the body out of the mapping.
+        CPPUNIT_ASSERT_EQUAL((size_t) 32, copy->getContent().size());
+        CPPUNIT_ASSERT(copy->getMappedContent() == NULL);
+        CPPUNIT_ASSERT_EQUAL((unsigned char) 16, copy->getContent()[0]);
+
+        // A mapped body compares equal to the same bytes held in the content.
+        CPPUNIT_ASSERT(message.Message::equals(copy.get()));
+        CPPUNIT_ASSERT(copy->Message::equals(&message));
+        CPPUNIT_ASSERT(message.getMappedContent() != NULL);
+        CPPUNIT_ASSERT(constMessage.getContent().empty());
+
+        ActiveMQBytesMessage rest;
+        rest.setBodyFromFile(path, 60);
+        CPPUNIT_ASSERT_EQUAL(4, rest.getBodyLength());
+        CPPUNIT_ASSERT_THROW(rest.setBodyFromFile(path), MessageNotWriteableException);
+
+        rest.clearBody();
+        CPPUNIT_ASSERT(rest.getMappedContent() == NULL);
+        rest.writeInt(42);
+        rest.reset();
+        CPPUNIT_ASSERT_EQUAL(42, rest.readInt());
+
+        ActiveMQBytesMessage invalid;
+        CPPUNIT_ASSERT_THROW(invalid.setBodyFromFile(path, 60, 8), CMSException);
+        CPPUNIT_ASSERT_THROW(invalid.setBodyFromFile(path, 65), CMSException);
+        CPPUNIT_ASSERT_THROW(invalid.setBodyFromFile("bytes-message-missing.bin"), CMSException);
+        CPPUNIT_ASSERT(invalid.getMappedContent() == NULL);
+        CPPUNIT_ASSERT(!invalid.isReadOnlyBody());
+    }
+
+    CPPUNIT_ASSERT(MemoryMappedFile::remove(path));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQBytesMessageTest::testWriteBodyToFile() {
+
+    const std::string path = "bytes-message-body-test.bin";
+
+    std::vector<unsigned char> data(1000);
+    for (int i = 0; i < 1000; ++i) {
+        data[i] = (unsigned char) (i * 7);
+    }
+
+    ActiveMQBytesMessage message;
+    message.writeBytes(data);
+    CPPUNIT_ASSERT_THROW(message.writeBodyToFile(path), MessageNotReadableException);
+
+    message.reset();
+    message.readInt();
+    CPPUNIT_ASSERT_EQUAL(1000, message.writeBodyToFile(path));
+
+    // The whole body is written whatever has been read of it already.
+    CPPUNIT_ASSERT_EQUAL(data[4], message.readByte());
+
+    MemoryMappedFile file;
+    file.open(path);
+    CPPUNIT_ASSERT_EQUAL(1000LL, file.getLength());
+    CPPUNIT_ASSERT(std::memcmp(&data[0], file.getBuffer(), 1000) == 0);
+    file.close();
+
+    // A compressed body is written out as it was before compression.
+    ByteArrayOutputStream bytes;
+    DataOutputStream header(&bytes);
+    header.writeInt(1000);
+    DeflaterOutputStream deflater(&bytes);
+    deflater.write(&data[0], 1000, 0, 1000);
+    deflater.close();
+
+    std::pair<unsigned char*, int> array = bytes.toByteArray();
+    ActiveMQBytesMessage compressed;
+    compressed.setContent(std::vector<unsigned char>(array.first, array.first + array.second));
+    compressed.setCompressed(true);
+    compressed.setReadOnlyBody(true);
+    delete [] array.first;
+
+    CPPUNIT_ASSERT_EQUAL(1000, compressed.writeBodyToFile(path));
+    file.open(path);
+    CPPUNIT_ASSERT_EQUAL(1000LL, file.getLength());
+    CPPUNIT_ASSERT(std::memcmp(&data[0], file.getBuffer(), 1000) == 0);
+    file.close();
+
+    ActiveMQBytesMessage empty;
+    empty.reset();
+    CPPUNIT_ASSERT_EQUAL(0, empty.writeBodyToFile(path));
+    file.open(path);
+    CPPUNIT_ASSERT_EQUAL(0LL, file.getLength());
+    file.close();
+
+    CPPUNIT_ASSERT(MemoryMappedFile::remove(path));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQBytesMessageTest::testGetBodyView() {
+
+    std::vector<unsigned char> data(100);
+    for (int i = 0; i < 100; ++i) {
+        data[i] = (unsigned char) (i * 3);
+    }
+
+    ActiveMQBytesMessage message;
+    message.writeBytes(data);
+    CPPUNIT_ASSERT_THROW(message.getBodyView(), MessageNotReadableException);
+
+    message.reset();
+    message.readInt();
+
+    // The view is the content itself and doesn't move the read position.
+    std::pair<const unsigned char*, int> view = message.getBodyView();
+    CPPUNIT_ASSERT(view.first == message.getContentBytes());
+    CPPUNIT_ASSERT_EQUAL(100, view.second);
+    CPPUNIT_ASSERT(std::memcmp(&data[0], view.first, 100) == 0);
+    CPPUNIT_ASSERT_EQUAL(data[4], message.readByte());
+
+    // A compressed body is decompressed once and the same bytes returned after.
+    ByteArrayOutputStream bytes;
+    DataOutputStream header(&bytes);
+    header.writeInt(100);
+    DeflaterOutputStream deflater(&bytes);
+    deflater.write(&data[0], 100, 0, 100);
+    deflater.close();
+
+    std::pair<unsigned char*, int> array = bytes.toByteArray();
+    ActiveMQBytesMessage compressed;
+    compressed.setContent(std::vector<unsigned char>(array.first, array.first + array.second));
+    compressed.setCompressed(true);
+    compressed.setReadOnlyBody(true);
+    delete [] array.first;
+
+    view = compressed.getBodyView();
+    CPPUNIT_ASSERT_EQUAL(100, view.second);
+    CPPUNIT_ASSERT(std::memcmp(&data[0], view.first, 100) == 0);
+    CPPUNIT_ASSERT(compressed.getBodyView().first == view.first);
+    CPPUNIT_ASSERT_EQUAL(data[0], compressed.readByte());
+
+    ActiveMQBytesMessage empty;
+    empty.reset();
+    view = empty.getBodyView();
+    CPPUNIT_ASSERT(view.first == NULL);
+    CPPUNIT_ASSERT_EQUAL(0, view.second);
+}
@@ -43,6 +43,9 @@ namespace commands{
         CPPUNIT_TEST( testReset );
         CPPUNIT_TEST( testReadOnlyBody );
         CPPUNIT_TEST( testWriteOnlyBody );
+        CPPUNIT_TEST( testSetBodyFromFile );
+        CPPUNIT_TEST( testWriteBodyToFile );
+        CPPUNIT_TEST( testGetBodyView );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -67,6 +70,9 @@ namespace commands{
         void testReset();
         void testReadOnlyBody();
         void testWriteOnlyBody();
+        void testSetBodyFromFile();
+        void testWriteBodyToFile();
+        void testGetBodyView();
 
     };
 
@@ -18,6 +18,10 @@
 #include "ActiveMQMapMessageTest.h"
 
 #include <activemq/commands/ActiveMQMapMessage.h>
+#include <activemq/wireformat/openwire/marshal/PrimitiveTypesMarshaller.h>
+
+#include <cms/MessageFormatException.h>
+#include <decaf/lang/Integer.h>
 
 #include <algorithm>
 
@@ -26,6 +30,8 @@ using namespace std;
 using namespace activemq;
 using namespace activemq::util;
 using namespace activemq::commands;
+using namespace activemq::wireformat::openwire::marshal;
+using namespace decaf::lang;
 
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQMapMessageTest::test() {
@@ -475,3 +481,56 @@ void ActiveMQMapMessageTest::testWriteOnlyBody() {
     msg.getShort( "short" );
     msg.getString( "string" );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQMapMessageTest::testReadMarshaledContent() {
+
+    PrimitiveMap map;
+    for( int i = 0; i < 200; ++i ) {
+        map.setLong( "field" + Integer::toString( i ), i );
+    }
+    map.setInt( "int", 42 );
+    map.setString( "string", "value" );
+
+    std::vector<unsigned char> content;
+    PrimitiveTypesMarshaller::marshal( &map, content );
+
+    // Set up the message the way it arrives from the broker.
+    ActiveMQMapMessage msg;
+    msg.setContent( content );
+    msg.setReadOnlyBody( true );
+
+    CPPUNIT_ASSERT_EQUAL( 42, msg.getInt( "int" ) );
+    CPPUNIT_ASSERT_EQUAL( 42LL, msg.getLong( "int" ) );
+    CPPUNIT_ASSERT_EQUAL( std::string( "value" ), msg.getString( "string" ) );
+    CPPUNIT_ASSERT_EQUAL( 199LL, msg.getLong( "field199" ) );
+    CPPUNIT_ASSERT( msg.itemExists( "field0" ) );
+    CPPUNIT_ASSERT( !msg.itemExists( "field200" ) );
+    CPPUNIT_ASSERT( !msg.isEmpty() );
+    CPPUNIT_ASSERT_EQUAL( (std::size_t)202, msg.getMapNames().size() );
+    CPPUNIT_ASSERT( msg.getValueType( "string" ) == cms::Message::STRING_TYPE );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a MessageFormatException",
+        msg.getBoolean( "int" ),
+        cms::MessageFormatException );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a CMSException",
+        msg.getInt( "missing" ),
+        cms::CMSException );
+
+    // Sending the message on unchanged keeps the content it arrived with.
+    msg.beforeMarshal( NULL );
+    CPPUNIT_ASSERT( msg.getContent() == content );
+
+    ActiveMQMapMessage copy;
+    copy.copyDataStructure( &msg );
+    CPPUNIT_ASSERT_EQUAL( 42, copy.getInt( "int" ) );
+
+    // Replacing the content is picked up on the next read.
+    map.setInt( "int", 7 );
+    PrimitiveTypesMarshaller::marshal( &map, content );
+    msg.setContent( content );
+    CPPUNIT_ASSERT_EQUAL( 7, msg.getInt( "int" ) );
+}
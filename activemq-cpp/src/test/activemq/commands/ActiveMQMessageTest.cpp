@@ -818,3 +818,71 @@ void ActiveMQMessageTest::testIsExpired() {
     msg.setCMSExpiration( System::currentTimeMillis() + 10000 );
     CPPUNIT_ASSERT( !msg.isExpired() );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQMessageTest::testMarshalProperties() {
+
+    ActiveMQMessage msg;
+    const ActiveMQMessage& constMsg = msg;
+
+    msg.setIntProperty( "count", 1 );
+    msg.marshalProperties();
+    std::vector<unsigned char> first = constMsg.getMarshalledProperties();
+    CPPUNIT_ASSERT( !first.empty() );
+
+    // Copies share the encoding of the original.
+    Pointer<ActiveMQMessage> copy( msg.cloneDataStructure() );
+    const ActiveMQMessage& constCopy = *copy;
+    CPPUNIT_ASSERT( first == constCopy.getMarshalledProperties() );
+    CPPUNIT_ASSERT_EQUAL( 1, copy->getIntProperty( "count" ) );
+
+    msg.setIntProperty( "count", 2 );
+    msg.marshalProperties();
+    CPPUNIT_ASSERT( first != constMsg.getMarshalledProperties() );
+
+    msg.clearProperties();
+    msg.marshalProperties();
+    CPPUNIT_ASSERT( constMsg.getMarshalledProperties().empty() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQMessageTest::testCachedWireForm() {
+
+    const unsigned char frame[] = { 1, 2, 3, 4 };
+    const int key = 5;
+
+    ActiveMQMessage msg;
+    const ActiveMQMessage& constMsg = msg;
+    CPPUNIT_ASSERT( !msg.hasCachedWireForm( key ) );
+    CPPUNIT_ASSERT( !msg.hasCachedWireForm( 0 ) );
+
+    msg.setCachedWireForm( key, frame, 4 );
+    CPPUNIT_ASSERT( msg.hasCachedWireForm( key ) );
+    CPPUNIT_ASSERT( !msg.hasCachedWireForm( key + 1 ) );
+    CPPUNIT_ASSERT_EQUAL( 4, (int)msg.getCachedWireForm().size() );
+
+    // Reading through the const getters keeps the frame.
+    constMsg.getDestination();
+    constMsg.getContent();
+    CPPUNIT_ASSERT( msg.hasCachedWireForm( key ) );
+
+    // Copies never inherit the frame.
+    Pointer<ActiveMQMessage> copy( msg.cloneDataStructure() );
+    CPPUNIT_ASSERT( !copy->hasCachedWireForm( key ) );
+
+    msg.setPersistent( true );
+    CPPUNIT_ASSERT( !msg.hasCachedWireForm( key ) );
+    CPPUNIT_ASSERT( msg.getCachedWireForm().empty() );
+
+    msg.setCachedWireForm( key, frame, 4 );
+    msg.getDestination();
+    CPPUNIT_ASSERT( !msg.hasCachedWireForm( key ) );
+
+    msg.setCachedWireForm( key, frame, 4 );
+    msg.setStringProperty( "name", "value" );
+    CPPUNIT_ASSERT( !msg.hasCachedWireForm( key ) );
+
+    msg.setCachedWireForm( key, frame, 4 );
+    msg.clearCachedWireForm();
+    CPPUNIT_ASSERT( !msg.hasCachedWireForm( key ) );
+}
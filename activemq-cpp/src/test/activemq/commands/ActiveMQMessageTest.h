@@ -75,6 +75,8 @@ namespace commands{
         CPPUNIT_TEST( testDoublePropertyConversion );
         CPPUNIT_TEST( testReadOnlyProperties );
         CPPUNIT_TEST( testIsExpired );
+        CPPUNIT_TEST( testMarshalProperties );
+        CPPUNIT_TEST( testCachedWireForm );
         CPPUNIT_TEST_SUITE_END();
 
     private:
@@ -142,6 +144,8 @@ namespace commands{
         void testStringPropertyConversion();
         void testReadOnlyProperties();
         void testIsExpired();
+        void testMarshalProperties();
+        void testCachedWireForm();
 
     };
 
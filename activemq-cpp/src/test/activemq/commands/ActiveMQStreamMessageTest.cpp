@@ -32,6 +32,8 @@
 #include <decaf/lang/Long.h>
 #include <decaf/lang/Float.h>
 #include <decaf/lang/Double.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/util/zip/DeflaterOutputStream.h>
 
 using namespace cms;
 using namespace std;
@@ -973,3 +975,44 @@ void ActiveMQStreamMessageTest::testWriteOnlyBody() {
     } catch( MessageNotReadableException& e ) {
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQStreamMessageTest::testReadCompressed() {
+
+    ActiveMQStreamMessage plain;
+    plain.writeBoolean( true );
+    plain.writeInt( 1024 );
+    plain.writeString( "compressed" );
+    plain.writeBytes( this->buffer );
+    plain.reset();
+
+    const std::vector<unsigned char>& content = plain.getContent();
+
+    decaf::io::ByteArrayOutputStream bytes;
+    decaf::util::zip::DeflaterOutputStream deflater( &bytes );
+    deflater.write( &content[0], (int)content.size(), 0, (int)content.size() );
+    deflater.close();
+
+    std::pair<unsigned char*, int> array = bytes.toByteArray();
+    ActiveMQStreamMessage msg;
+    msg.setContent( std::vector<unsigned char>( array.first, array.first + array.second ) );
+    msg.setCompressed( true );
+    msg.setReadOnlyBody( true );
+    delete [] array.first;
+
+    CPPUNIT_ASSERT( msg.readBoolean() == true );
+
+    // A failed conversion leaves the value to be read again.
+    CPPUNIT_ASSERT_THROW( msg.readBoolean(), MessageFormatException );
+    CPPUNIT_ASSERT_EQUAL( 1024, msg.readInt() );
+    CPPUNIT_ASSERT_EQUAL( std::string( "compressed" ), msg.readString() );
+
+    std::vector<unsigned char> result( this->buffer.size() );
+    CPPUNIT_ASSERT_EQUAL( (int)this->buffer.size(), msg.readBytes( result ) );
+    CPPUNIT_ASSERT( result == this->buffer );
+
+    CPPUNIT_ASSERT_THROW( msg.readInt(), MessageEOFException );
+
+    msg.reset();
+    CPPUNIT_ASSERT( msg.readBoolean() == true );
+}
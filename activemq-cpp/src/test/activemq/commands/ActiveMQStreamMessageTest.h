@@ -43,6 +43,7 @@ namespace commands {
         CPPUNIT_TEST( testReset );
         CPPUNIT_TEST( testReadOnlyBody );
         CPPUNIT_TEST( testWriteOnlyBody );
+        CPPUNIT_TEST( testReadCompressed );
         CPPUNIT_TEST_SUITE_END();
 
     private:
@@ -73,6 +74,7 @@ namespace commands {
         void testReset();
         void testReadOnlyBody();
         void testWriteOnlyBody();
+        void testReadCompressed();
 
     };
 
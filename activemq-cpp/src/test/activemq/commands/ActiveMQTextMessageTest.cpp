@@ -18,12 +18,18 @@
 #include "ActiveMQTextMessageTest.h"
 
 #include <activemq/commands/ActiveMQTextMessage.h>
+#include <activemq/util/MarshallingSupport.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/util/zip/DeflaterOutputStream.h>
 
 using namespace cms;
 using namespace std;
 using namespace activemq;
 using namespace activemq::util;
 using namespace activemq::commands;
+using namespace decaf::io;
+using namespace decaf::util::zip;
 
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQTextMessageTest::test() {
@@ -126,3 +132,50 @@ void ActiveMQTextMessageTest::testWriteOnlyBody() {
     } catch( MessageNotWriteableException& mnwe ) {
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQTextMessageTest::testGetTextView() {
+
+    const std::string testText = "{\"name\":\"value\"}";
+
+    ActiveMQTextMessage message;
+    std::pair<const char*, int> view = message.getTextView();
+    CPPUNIT_ASSERT_EQUAL( 0, view.second );
+
+    message.setText( testText );
+    view = message.getTextView();
+    CPPUNIT_ASSERT_EQUAL( testText, std::string( view.first, view.second ) );
+
+    // Once encoded the text is read in place from the content.
+    message.beforeMarshal( NULL );
+    view = message.getTextView();
+    CPPUNIT_ASSERT( view.first == (const char*)message.getContentBytes() + 4 );
+    CPPUNIT_ASSERT_EQUAL( testText, std::string( view.first, view.second ) );
+    CPPUNIT_ASSERT_EQUAL( testText, message.getText() );
+    CPPUNIT_ASSERT( message.getTextView().first == view.first );
+
+    // Compressed text is decompressed once and the same text returned after.
+    ByteArrayOutputStream bytes;
+    DataOutputStream dataOut( new DeflaterOutputStream( &bytes ), true );
+    MarshallingSupport::writeString32( dataOut, testText );
+    dataOut.close();
+
+    std::pair<unsigned char*, int> array = bytes.toByteArray();
+    ActiveMQTextMessage compressed;
+    compressed.setContent( std::vector<unsigned char>( array.first, array.first + array.second ) );
+    compressed.setCompressed( true );
+    delete [] array.first;
+
+    view = compressed.getTextView();
+    CPPUNIT_ASSERT_EQUAL( testText, std::string( view.first, view.second ) );
+    CPPUNIT_ASSERT( compressed.getTextView().first == view.first );
+    CPPUNIT_ASSERT_EQUAL( testText, compressed.getText() );
+
+    // A length prefix longer than the content is rejected.
+    std::vector<unsigned char> content( 8, 0 );
+    content[3] = 100;
+    ActiveMQTextMessage invalid;
+    invalid.setContent( content );
+    CPPUNIT_ASSERT_THROW( invalid.getTextView(), MessageFormatException );
+    CPPUNIT_ASSERT_THROW( invalid.getText(), MessageFormatException );
+}
@@ -33,6 +33,7 @@ namespace commands{
         CPPUNIT_TEST( testWriteOnlyBody );
         CPPUNIT_TEST( testShallowCopy );
         CPPUNIT_TEST( testGetBytes );
+        CPPUNIT_TEST( testGetTextView );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -46,6 +47,7 @@ namespace commands{
         void testWriteOnlyBody();
         void testShallowCopy();
         void testGetBytes();
+        void testGetTextView();
 
     };
 
@@ -17,6 +17,7 @@
 
 #include "ActiveMQSessionTest.h"
 
+#include <cms/AsyncCallback.h>
 #include <cms/ExceptionListener.h>
 #include <activemq/transport/mock/MockTransportFactory.h>
 #include <activemq/transport/TransportRegistry.h>
@@ -27,10 +28,20 @@
 #include <activemq/core/ActiveMQSession.h>
 #include <activemq/core/ActiveMQConsumer.h>
 #include <activemq/core/ActiveMQProducer.h>
+#include <activemq/core/ProducerMessageTemplate.h>
+#include <activemq/transport/IOTransport.h>
+#include <activemq/transport/DefaultTransportListener.h>
+#include <activemq/transport/correlator/ResponseCorrelator.h>
+#include <activemq/wireformat/openwire/OpenWireFormat.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/IOException.h>
+#include <decaf/io/DataOutputStream.h>
 #include <decaf/util/Properties.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
 #include <decaf/lang/System.h>
 #include <decaf/lang/Pointer.h>
 #include <decaf/lang/Thread.h>
+#include <decaf/lang/Runnable.h>
 #include <decaf/net/Socket.h>
 #include <decaf/net/ServerSocket.h>
 
@@ -101,6 +112,75 @@ namespace core {
             AMQ_CATCHALL_THROW( activemq::exceptions::ActiveMQException )
         }
     };
+
+    class MyCommitCallback : public cms::AsyncCallback {
+    public:
+
+        decaf::util::concurrent::atomic::AtomicInteger successes;
+        decaf::util::concurrent::atomic::AtomicInteger failures;
+
+    public:
+
+        MyCommitCallback() : successes(), failures() {
+        }
+
+        virtual ~MyCommitCallback() {}
+
+        virtual void onSuccess() {
+            successes.incrementAndGet();
+        }
+
+        virtual void onException(const cms::CMSException& ex) {
+            failures.incrementAndGet();
+        }
+    };
+
+    class MySentMessages : public transport::DefaultTransportListener {
+    public:
+
+        std::vector< Pointer<commands::Message> > messages;
+
+    public:
+
+        MySentMessages() : messages() {
+        }
+
+        virtual ~MySentMessages() {}
+
+        virtual void onCommand(const Pointer<commands::Command> command) {
+            if (command->isMessage()) {
+                messages.push_back(command.dynamicCast<commands::Message>());
+            }
+        }
+    };
+
+    class DelayedInjector : public decaf::lang::Runnable {
+    private:
+
+        DelayedInjector(const DelayedInjector&);
+        DelayedInjector& operator= (const DelayedInjector&);
+
+    private:
+
+        ActiveMQSessionTest* test;
+        const cms::Destination* destination;
+        const commands::ConsumerId* consumerId;
+        long long delay;
+
+    public:
+
+        DelayedInjector(ActiveMQSessionTest* test, const cms::Destination* destination,
+                        const commands::ConsumerId* consumerId, long long delay) :
+            Runnable(), test(test), destination(destination), consumerId(consumerId), delay(delay) {
+        }
+
+        virtual ~DelayedInjector() {}
+
+        virtual void run() {
+            Thread::sleep(delay);
+            test->injectTextMessage("This is a Test 1", *destination, *consumerId);
+        }
+    };
 }}
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -142,6 +222,106 @@ void ActiveMQSessionTest::testCreateManyConsumersAndSetListeners() {
     consumers.clear();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionTest::testCreateConsumersPipelined() {
+
+    MyCMSMessageListener msgListener1;
+
+    CPPUNIT_ASSERT( connection.get() != NULL );
+    CPPUNIT_ASSERT( connection->isStarted() == true );
+
+    std::auto_ptr<ActiveMQSession> session(
+        dynamic_cast<ActiveMQSession*>( connection->createSession() ) );
+    CPPUNIT_ASSERT( session.get() != NULL );
+
+    std::auto_ptr<cms::Topic> topic1( session->createTopic( "TestTopic1" ) );
+    std::auto_ptr<cms::Queue> queue1( session->createQueue( "TestQueue1" ) );
+
+    std::vector<const cms::Destination*> destinations;
+    for( int ix = 0; ix < 50; ++ix ) {
+        destinations.push_back( topic1.get() );
+        destinations.push_back( queue1.get() );
+    }
+
+    // One bad entry must not affect the rest.
+    destinations.push_back( NULL );
+
+    std::vector<cms::MessageConsumer*> consumers;
+    std::vector< Pointer<cms::CMSException> > errors;
+
+    int created = session->createConsumers( destinations, "", false, consumers, errors );
+
+    CPPUNIT_ASSERT_EQUAL( 100, created );
+    CPPUNIT_ASSERT_EQUAL( destinations.size(), consumers.size() );
+    CPPUNIT_ASSERT_EQUAL( destinations.size(), errors.size() );
+
+    for( std::size_t ix = 0; ix < 100; ++ix ) {
+        CPPUNIT_ASSERT( consumers[ix] != NULL );
+        CPPUNIT_ASSERT( errors[ix] == NULL );
+    }
+
+    CPPUNIT_ASSERT( consumers[100] == NULL );
+    CPPUNIT_ASSERT( errors[100] != NULL );
+
+    ActiveMQConsumer* consumer = dynamic_cast<ActiveMQConsumer*>( consumers[0] );
+    CPPUNIT_ASSERT( consumer != NULL );
+    consumer->setMessageListener( &msgListener1 );
+
+    injectTextMessage( "This is a Test 1" , *topic1, *( consumer->getConsumerId() ) );
+
+    msgListener1.asyncWaitForMessages( 1 );
+
+    CPPUNIT_ASSERT( msgListener1.messages.size() == 1 );
+
+    for( std::size_t ix = 0; ix < consumers.size(); ++ix ) {
+        if( consumers[ix] != NULL ) {
+            consumers[ix]->close();
+            delete consumers[ix];
+        }
+    }
+
+    session->close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionTest::testCreateConsumersDisposedTransport() {
+
+    CPPUNIT_ASSERT( connection.get() != NULL );
+
+    std::auto_ptr<ActiveMQSession> session(
+        dynamic_cast<ActiveMQSession*>( connection->createSession() ) );
+    CPPUNIT_ASSERT( session.get() != NULL );
+
+    std::auto_ptr<cms::Topic> topic1( session->createTopic( "TestTopic1" ) );
+
+    // Dispose of the correlator without failing the connection so each request is
+    // completed by the correlator and then also throws.
+    transport::correlator::ResponseCorrelator* correlator =
+        dynamic_cast<transport::correlator::ResponseCorrelator*>(
+            connection->getTransport().narrow( typeid( transport::correlator::ResponseCorrelator ) ) );
+    CPPUNIT_ASSERT( correlator != NULL );
+
+    transport::TransportListener* listener = correlator->getTransportListener();
+    correlator->setTransportListener( NULL );
+    correlator->onException( decaf::io::IOException( __FILE__, __LINE__, "Transport disposed" ) );
+    correlator->setTransportListener( listener );
+
+    std::vector<const cms::Destination*> destinations( 10, topic1.get() );
+    std::vector<cms::MessageConsumer*> consumers;
+    std::vector< Pointer<cms::CMSException> > errors;
+
+    int created = session->createConsumers( destinations, "", false, consumers, errors );
+
+    CPPUNIT_ASSERT_EQUAL( 0, created );
+    CPPUNIT_ASSERT_EQUAL( destinations.size(), consumers.size() );
+    CPPUNIT_ASSERT_EQUAL( destinations.size(), errors.size() );
+
+    for( std::size_t ix = 0; ix < destinations.size(); ++ix ) {
+        CPPUNIT_ASSERT( consumers[ix] == NULL );
+        CPPUNIT_ASSERT( errors[ix] != NULL );
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQSessionTest::testAutoAcking() {
 
@@ -556,6 +736,74 @@ void ActiveMQSessionTest::testTransactionCloseWithoutCommit() {
     session->close();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionTest::testTransactionAsyncCommitProducer() {
+
+    static const int COMMIT_COUNT = 20;
+
+    MyCommitCallback callback;
+
+    CPPUNIT_ASSERT(connection.get() != NULL);
+
+    std::auto_ptr<ActiveMQSession> session(
+        dynamic_cast<ActiveMQSession*>(connection->createSession(cms::Session::SESSION_TRANSACTED)));
+    CPPUNIT_ASSERT(session.get() != NULL);
+    std::auto_ptr<cms::Topic> topic1(session->createTopic("TestTopic1"));
+    std::auto_ptr<cms::MessageProducer> producer(session->createProducer(topic1.get()));
+
+    for (int i = 0; i < COMMIT_COUNT; ++i) {
+        std::auto_ptr<cms::TextMessage> message(session->createTextMessage("This is a Test 1"));
+        producer->send(message.get());
+        session->commit(&callback);
+    }
+
+    // With no transaction in progress the callback still completes.
+    session->commit(&callback);
+
+    session->close();
+
+    CPPUNIT_ASSERT_EQUAL(COMMIT_COUNT + 1, callback.successes.get());
+    CPPUNIT_ASSERT_EQUAL(0, callback.failures.get());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionTest::testTransactionAsyncCommitConsumer() {
+
+    static const int MSG_COUNT = 50;
+
+    MyCMSMessageListener msgListener1;
+    MyCommitCallback callback;
+
+    CPPUNIT_ASSERT(connection.get() != NULL);
+
+    std::auto_ptr<ActiveMQSession> session(
+        dynamic_cast<ActiveMQSession*>(connection->createSession(cms::Session::SESSION_TRANSACTED)));
+    CPPUNIT_ASSERT(session.get() != NULL);
+    std::auto_ptr<cms::Topic> topic1(session->createTopic("TestTopic1"));
+
+    std::auto_ptr<ActiveMQConsumer> consumer1(
+        dynamic_cast<ActiveMQConsumer*> (session->createConsumer(topic1.get())));
+    CPPUNIT_ASSERT(consumer1.get() != NULL);
+
+    consumer1->setMessageListener(&msgListener1);
+
+    for (int i = 0; i < MSG_COUNT; ++i) {
+        injectTextMessage("This is a Test 1", *topic1, *(consumer1->getConsumerId()));
+    }
+
+    msgListener1.asyncWaitForMessages(MSG_COUNT);
+    CPPUNIT_ASSERT_EQUAL(MSG_COUNT, (int)msgListener1.messages.size());
+
+    // The consumer has to learn the outcome so the callback is done on return.
+    session->commit(&callback);
+
+    CPPUNIT_ASSERT_EQUAL(1, callback.successes.get());
+    CPPUNIT_ASSERT_EQUAL(0, callback.failures.get());
+
+    consumer1->close();
+    session->close();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQSessionTest::testExpiration() {
 
@@ -658,6 +906,88 @@ void ActiveMQSessionTest::testTransactionCommitAfterConsumerClosed() {
     msgListener1.clear();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // Marshals a copy of the sent Message with the fields that differ from one
+    // send to the next set to fixed values.
+    std::vector<unsigned char> marshalSent(const Pointer<commands::Message>& message) {
+
+        Pointer<commands::Message> copy(message->cloneDataStructure());
+        copy->setCommandId(1);
+        copy->setMessageId(Pointer<MessageId>(new MessageId()));
+
+        decaf::util::Properties properties;
+        wireformat::openwire::OpenWireFormat format(properties);
+        transport::IOTransport transport;
+        decaf::io::ByteArrayOutputStream bytes;
+        decaf::io::DataOutputStream out(&bytes);
+
+        format.marshal(copy, &transport, &out);
+
+        std::pair<unsigned char*, int> array = bytes.toByteArray();
+        std::vector<unsigned char> frame(array.first, array.first + array.second);
+        delete [] array.first;
+
+        return frame;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionTest::testSendMessageTemplate() {
+
+    MySentMessages sent;
+    dTransport->setOutgoingListener(&sent);
+
+    std::auto_ptr<cms::Session> session(connection->createSession());
+    std::auto_ptr<cms::Queue> queue(session->createQueue("TestQueue1"));
+    std::auto_ptr<ActiveMQProducer> producer(
+        dynamic_cast<ActiveMQProducer*>(session->createProducer(queue.get())));
+    CPPUNIT_ASSERT(producer.get() != NULL);
+
+    producer->setDeliveryMode(cms::DeliveryMode::NON_PERSISTENT);
+    producer->setDisableMessageTimeStamp(true);
+
+    std::auto_ptr<cms::TextMessage> prototype(session->createTextMessage());
+    prototype->setStringProperty("symbol", "IBM");
+
+    std::vector<std::string> variables;
+    variables.push_back("seq");
+    std::auto_ptr<ProducerMessageTemplate> messageTemplate(
+        producer->createMessageTemplate(prototype.get(), variables));
+
+    static const int MSG_COUNT = 3;
+
+    // Each template send is followed by the normal send of the same Message.
+    for (int i = 0; i < MSG_COUNT; ++i) {
+
+        messageTemplate->setIntProperty("seq", i);
+        messageTemplate->setText("quote");
+        producer->send(messageTemplate.get());
+
+        std::auto_ptr<cms::TextMessage> message(session->createTextMessage("quote"));
+        message->setStringProperty("symbol", "IBM");
+        message->setIntProperty("seq", i);
+        producer->send(message.get());
+    }
+
+    dTransport->setOutgoingListener(NULL);
+
+    CPPUNIT_ASSERT_EQUAL(MSG_COUNT * 2, (int) sent.messages.size());
+
+    for (int i = 0; i < MSG_COUNT * 2; i += 2) {
+        Pointer<commands::Message> fromTemplate = sent.messages[i];
+        Pointer<commands::Message> normal = sent.messages[i + 1];
+
+        CPPUNIT_ASSERT_EQUAL(normal->getMessageId()->getProducerSequenceId() - 1,
+                             fromTemplate->getMessageId()->getProducerSequenceId());
+        CPPUNIT_ASSERT(fromTemplate->getDestination()->equals(normal->getDestination().get()));
+        CPPUNIT_ASSERT(marshalSent(fromTemplate) == marshalSent(normal));
+    }
+
+    session->close();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQSessionTest::setUp() {
 
@@ -729,3 +1059,45 @@ void ActiveMQSessionTest::injectTextMessage(const std::string message,
 
     dTransport->fireCommand(dispatch);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionTest::testConsumerBusyPoll() {
+
+    CPPUNIT_ASSERT(connection.get() != NULL);
+
+    std::auto_ptr<cms::Session> session(connection->createSession());
+    std::auto_ptr<cms::Topic> topic1(session->createTopic("TestTopic1"));
+
+    std::auto_ptr<ActiveMQConsumer> consumer1(
+        dynamic_cast<ActiveMQConsumer*>(session->createConsumer(topic1.get())));
+    CPPUNIT_ASSERT(consumer1.get() != NULL);
+
+    // A budget far longer than the injection delay, the message arrives while spinning.
+    consumer1->setBusyPollTime(5000000);
+    CPPUNIT_ASSERT_EQUAL(5000000LL, consumer1->getBusyPollTime());
+
+    DelayedInjector injector(this, topic1.get(), consumer1->getConsumerId().get(), 100);
+    Thread thread(&injector);
+    thread.start();
+
+    std::auto_ptr<cms::Message> message(consumer1->receive(10000));
+    thread.join();
+
+    CPPUNIT_ASSERT(message.get() != NULL);
+    CPPUNIT_ASSERT_EQUAL(1LL, consumer1->getBusyPollSpinCount());
+    CPPUNIT_ASSERT_EQUAL(0LL, consumer1->getBusyPollWaitCount());
+
+    // With nothing to receive the spin runs out and the receive blocks.
+    consumer1->setBusyPollTime(1000);
+    CPPUNIT_ASSERT(consumer1->receive(50) == NULL);
+    CPPUNIT_ASSERT_EQUAL(1LL, consumer1->getBusyPollSpinCount());
+    CPPUNIT_ASSERT(consumer1->getBusyPollWaitCount() >= 1LL);
+
+    // A receiveNoWait never spins.
+    long long waits = consumer1->getBusyPollWaitCount();
+    CPPUNIT_ASSERT(consumer1->receiveNoWait() == NULL);
+    CPPUNIT_ASSERT_EQUAL(waits, consumer1->getBusyPollWaitCount());
+
+    consumer1->close();
+    session->close();
+}
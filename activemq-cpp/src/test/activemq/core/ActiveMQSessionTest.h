@@ -47,8 +47,14 @@ namespace core{
         CPPUNIT_TEST( testTransactionRollbackOneConsumer );
         CPPUNIT_TEST( testTransactionRollbackTwoConsumer );
         CPPUNIT_TEST( testTransactionCloseWithoutCommit );
+        CPPUNIT_TEST( testTransactionAsyncCommitProducer );
+        CPPUNIT_TEST( testTransactionAsyncCommitConsumer );
         CPPUNIT_TEST( testExpiration );
         CPPUNIT_TEST( testCreateManyConsumersAndSetListeners );
+        CPPUNIT_TEST( testCreateConsumersPipelined );
+        CPPUNIT_TEST( testCreateConsumersDisposedTransport );
+        CPPUNIT_TEST( testSendMessageTemplate );
+        CPPUNIT_TEST( testConsumerBusyPoll );
         CPPUNIT_TEST_SUITE_END();
 
     private:
@@ -96,11 +102,17 @@ namespace core{
         void testAutoAcking();
         void testClientAck();
         void testCreateManyConsumersAndSetListeners();
+        void testCreateConsumersPipelined();
+        void testCreateConsumersDisposedTransport();
+        void testSendMessageTemplate();
+        void testConsumerBusyPoll();
         void testTransactionCommitOneConsumer();
         void testTransactionCommitTwoConsumer();
         void testTransactionRollbackOneConsumer();
         void testTransactionRollbackTwoConsumer();
         void testTransactionCloseWithoutCommit();
+        void testTransactionAsyncCommitProducer();
+        void testTransactionAsyncCommitConsumer();
         void testTransactionCommitAfterConsumerClosed();
         void testExpiration();
 
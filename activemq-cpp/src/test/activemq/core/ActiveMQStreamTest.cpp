@@ -0,0 +1,312 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ActiveMQStreamTest.h"
+
+#include <activemq/core/ActiveMQConnectionFactory.h>
+#include <activemq/core/ActiveMQInputStream.h>
+#include <activemq/core/ActiveMQOutputStream.h>
+#include <activemq/commands/ActiveMQBytesMessage.h>
+#include <activemq/commands/ActiveMQQueue.h>
+#include <activemq/commands/ConsumerInfo.h>
+#include <activemq/commands/MessageDispatch.h>
+#include <activemq/transport/TransportListener.h>
+
+#include <decaf/io/IOException.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/util/concurrent/Mutex.h>
+
+#include <vector>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace activemq::transport;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // Plays the part of the Broker, every Message sent on the connection is
+    // dispatched straight back to the last consumer that was created.
+    class LoopbackListener : public TransportListener {
+    private:
+
+        mock::MockTransport* transport;
+        Pointer<ConsumerId> consumerId;
+        int dropSequence;
+
+    public:
+
+        std::vector< Pointer<Message> > sent;
+
+    public:
+
+        LoopbackListener(mock::MockTransport* transport, int dropSequence = 0) :
+            transport(transport), consumerId(), dropSequence(dropSequence), sent() {}
+
+        virtual ~LoopbackListener() {}
+
+        virtual void onCommand(const Pointer<Command> command) {
+
+            if (command->isConsumerInfo()) {
+                consumerId = command.dynamicCast<ConsumerInfo>()->getConsumerId();
+            } else if (command->isMessage()) {
+
+                Pointer<Message> message = command.dynamicCast<Message>();
+                sent.push_back(message);
+
+                if (consumerId == NULL || message->getGroupSequence() == dropSequence) {
+                    return;
+                }
+
+                Pointer<MessageDispatch> dispatch(new MessageDispatch());
+                dispatch->setMessage(message);
+                dispatch->setConsumerId(consumerId);
+                dispatch->setDestination(message->getDestination());
+
+                transport->fireCommand(dispatch);
+            }
+        }
+
+        virtual void onException(const decaf::lang::Exception& ex AMQCPP_UNUSED) {}
+        virtual void transportInterrupted() {}
+        virtual void transportResumed() {}
+    };
+
+    std::vector<unsigned char> createPayload(int size) {
+
+        std::vector<unsigned char> payload(size);
+        for (int i = 0; i < size; ++i) {
+            payload[i] = (unsigned char) (i % 251);
+        }
+
+        return payload;
+    }
+
+    std::vector<unsigned char> readAll(InputStream& in, int readSize) {
+
+        std::vector<unsigned char> result;
+        std::vector<unsigned char> buffer(readSize);
+
+        int count = 0;
+        while ((count = in.read(&buffer[0], readSize, 0, readSize)) != -1) {
+            result.insert(result.end(), buffer.begin(), buffer.begin() + count);
+        }
+
+        return result;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ActiveMQStreamTest::ActiveMQStreamTest() : connection(), transport() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ActiveMQStreamTest::~ActiveMQStreamTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQStreamTest::setUp() {
+
+    ActiveMQConnectionFactory factory("mock://127.0.0.1:12345?wireFormat=openwire");
+
+    connection.reset(dynamic_cast<ActiveMQConnection*>(factory.createConnection()));
+
+    transport = dynamic_cast<mock::MockTransport*>(
+        connection->getTransport().narrow(typeid(mock::MockTransport)));
+    CPPUNIT_ASSERT(transport != NULL);
+
+    connection->start();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQStreamTest::tearDown() {
+    transport->setOutgoingListener(NULL);
+    connection.reset(NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQStreamTest::testConstructor() {
+
+    ActiveMQQueue queue("test.stream");
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a NullPointerException",
+        ActiveMQOutputStream(NULL, &queue),
+        NullPointerException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a NullPointerException",
+        ActiveMQInputStream(connection.get(), NULL),
+        NullPointerException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        ActiveMQOutputStream(connection.get(), &queue, 0),
+        IllegalArgumentException);
+
+    ActiveMQOutputStream out(connection.get(), &queue, 1024);
+    CPPUNIT_ASSERT_EQUAL(1024, out.getChunkSize());
+    CPPUNIT_ASSERT(!out.getGroupId().empty());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQStreamTest::testChunking() {
+
+    LoopbackListener broker(transport);
+    transport->setOutgoingListener(&broker);
+
+    ActiveMQQueue queue("test.stream");
+    ActiveMQOutputStream out(connection.get(), &queue, 1024);
+
+    std::vector<unsigned char> payload = createPayload(10000);
+
+    // A mix of single bytes, small arrays and arrays larger than a chunk.
+    out.write(payload[0]);
+    out.write(&payload[0], (int) payload.size(), 1, 99);
+    out.write(&payload[0], (int) payload.size(), 100, 4000);
+    out.write(&payload[0], (int) payload.size(), 4100, 5900);
+    CPPUNIT_ASSERT_EQUAL(9, out.getChunksSent());
+
+    out.close();
+    CPPUNIT_ASSERT_EQUAL(10, out.getChunksSent());
+
+    CPPUNIT_ASSERT_EQUAL(11, (int) broker.sent.size());
+    for (int i = 0; i < 11; ++i) {
+
+        Pointer<ActiveMQBytesMessage> chunk = broker.sent[i].dynamicCast<ActiveMQBytesMessage>();
+        CPPUNIT_ASSERT_EQUAL(out.getGroupId(), chunk->getGroupID());
+
+        if (i < 9) {
+            CPPUNIT_ASSERT_EQUAL(i + 1, chunk->getGroupSequence());
+            CPPUNIT_ASSERT_EQUAL(1024, (int) chunk->getContent().size());
+        } else if (i == 9) {
+            CPPUNIT_ASSERT_EQUAL(10, chunk->getGroupSequence());
+            CPPUNIT_ASSERT_EQUAL(10000 - 9 * 1024, (int) chunk->getContent().size());
+        } else {
+            CPPUNIT_ASSERT_EQUAL(-1, chunk->getGroupSequence());
+            CPPUNIT_ASSERT(chunk->getContent().empty());
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQStreamTest::testRoundTrip() {
+
+    LoopbackListener broker(transport);
+    transport->setOutgoingListener(&broker);
+
+    ActiveMQQueue queue("test.stream");
+    ActiveMQInputStream in(connection.get(), &queue, "", 2000);
+    ActiveMQOutputStream out(connection.get(), &queue, 1000);
+
+    std::vector<unsigned char> payload = createPayload(25000);
+    out.write(&payload[0], 12345);
+    out.flush();
+    out.write(&payload[0], (int) payload.size(), 12345, 25000 - 12345);
+    out.close();
+
+    // Reads are smaller than a chunk and don't line up with the chunk boundaries.
+    CPPUNIT_ASSERT_EQUAL(payload[0], (unsigned char) in.read());
+    std::vector<unsigned char> received = readAll(in, 333);
+    received.insert(received.begin(), payload[0]);
+
+    CPPUNIT_ASSERT(payload == received);
+    CPPUNIT_ASSERT_EQUAL(out.getGroupId(), in.getGroupId());
+    CPPUNIT_ASSERT_EQUAL(-1, in.read());
+    CPPUNIT_ASSERT_EQUAL(0, in.available());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQStreamTest::testEmptyStream() {
+
+    LoopbackListener broker(transport);
+    transport->setOutgoingListener(&broker);
+
+    ActiveMQQueue queue("test.stream");
+    ActiveMQInputStream in(connection.get(), &queue, "", 2000);
+
+    ActiveMQOutputStream out(connection.get(), &queue);
+    out.close();
+
+    CPPUNIT_ASSERT_EQUAL(1, (int) broker.sent.size());
+    CPPUNIT_ASSERT_EQUAL(-1, in.read());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQStreamTest::testMissingChunk() {
+
+    LoopbackListener broker(transport, 2);
+    transport->setOutgoingListener(&broker);
+
+    ActiveMQQueue queue("test.stream");
+    ActiveMQInputStream in(connection.get(), &queue, "", 2000);
+    ActiveMQOutputStream out(connection.get(), &queue, 100);
+
+    std::vector<unsigned char> payload = createPayload(1000);
+    out.write(&payload[0], (int) payload.size());
+    out.close();
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        readAll(in, 100),
+        IOException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQStreamTest::testReceiveTimeout() {
+
+    ActiveMQQueue queue("test.stream");
+    ActiveMQInputStream in(connection.get(), &queue, "", 100);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        in.read(),
+        IOException);
+
+    in.close();
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        in.read(),
+        IOException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQStreamTest::testWriteAfterClose() {
+
+    ActiveMQQueue queue("test.stream");
+    ActiveMQOutputStream out(connection.get(), &queue);
+    out.close();
+    out.close();
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        out.write('a'),
+        IOException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        out.flush(),
+        IOException);
+}
@@ -0,0 +1,74 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CORE_ACTIVEMQSTREAMTEST_H_
+#define _ACTIVEMQ_CORE_ACTIVEMQSTREAMTEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <activemq/core/ActiveMQConnection.h>
+#include <activemq/transport/mock/MockTransport.h>
+
+#include <memory>
+
+namespace activemq {
+namespace core {
+
+    class ActiveMQStreamTest : public CppUnit::TestFixture {
+
+        CPPUNIT_TEST_SUITE( ActiveMQStreamTest );
+        CPPUNIT_TEST( testConstructor );
+        CPPUNIT_TEST( testChunking );
+        CPPUNIT_TEST( testRoundTrip );
+        CPPUNIT_TEST( testEmptyStream );
+        CPPUNIT_TEST( testMissingChunk );
+        CPPUNIT_TEST( testReceiveTimeout );
+        CPPUNIT_TEST( testWriteAfterClose );
+        CPPUNIT_TEST_SUITE_END();
+
+    private:
+
+        std::auto_ptr<ActiveMQConnection> connection;
+        transport::mock::MockTransport* transport;
+
+    private:
+
+        ActiveMQStreamTest(const ActiveMQStreamTest&);
+        ActiveMQStreamTest& operator= (const ActiveMQStreamTest&);
+
+    public:
+
+        ActiveMQStreamTest();
+        virtual ~ActiveMQStreamTest();
+
+        virtual void setUp();
+        virtual void tearDown();
+
+        void testConstructor();
+        void testChunking();
+        void testRoundTrip();
+        void testEmptyStream();
+        void testMissingChunk();
+        void testReceiveTimeout();
+        void testWriteAfterClose();
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_CORE_ACTIVEMQSTREAMTEST_H_ */
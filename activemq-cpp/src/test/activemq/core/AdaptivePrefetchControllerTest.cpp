@@ -0,0 +1,137 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AdaptivePrefetchControllerTest.h"
+
+#include <activemq/core/AdaptivePrefetchController.h>
+
+using namespace activemq;
+using namespace activemq::core;
+
+////////////////////////////////////////////////////////////////////////////////
+void AdaptivePrefetchControllerTest::testInitialState() {
+
+    AdaptivePrefetchController controller(1000, 500, 1000, 0);
+
+    CPPUNIT_ASSERT_EQUAL(1000, controller.getPrefetchSize());
+    CPPUNIT_ASSERT_EQUAL(1000, controller.getMaxPrefetchSize());
+    CPPUNIT_ASSERT_EQUAL(500, controller.getAckBatchSize());
+    CPPUNIT_ASSERT_EQUAL(500LL, controller.getTargetLatency());
+    CPPUNIT_ASSERT_EQUAL(0LL, controller.getAdjustments());
+
+    AdaptivePrefetchController single(1, 500, 1000, 0);
+    CPPUNIT_ASSERT_EQUAL(1, single.getPrefetchSize());
+    CPPUNIT_ASSERT_EQUAL(1, single.getAckBatchSize());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AdaptivePrefetchControllerTest::testSampleInterval() {
+
+    AdaptivePrefetchController controller(1000, 1000, 1000, 0);
+
+    controller.onMessagesConsumed(10);
+    CPPUNIT_ASSERT(!controller.evaluate(100, 999));
+    CPPUNIT_ASSERT_EQUAL(1000, controller.getPrefetchSize());
+    CPPUNIT_ASSERT_EQUAL(0.0, controller.getConsumptionRate());
+
+    // The messages counted before the interval elapsed are part of the sample.
+    controller.onMessagesConsumed(10);
+    CPPUNIT_ASSERT(controller.evaluate(100, 1000));
+    CPPUNIT_ASSERT_EQUAL(20.0, controller.getConsumptionRate());
+    CPPUNIT_ASSERT_EQUAL(20, controller.getPrefetchSize());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AdaptivePrefetchControllerTest::testShrinkWhenBacklogged() {
+
+    AdaptivePrefetchController controller(1000, 1000, 1000, 0);
+
+    controller.onMessagesConsumed(50);
+    CPPUNIT_ASSERT(controller.evaluate(10, 1000));
+    CPPUNIT_ASSERT_EQUAL(50, controller.getPrefetchSize());
+    CPPUNIT_ASSERT_EQUAL(25, controller.getAckBatchSize());
+    CPPUNIT_ASSERT_EQUAL(1LL, controller.getAdjustments());
+
+    // Half the target latency halves the window.
+    AdaptivePrefetchController faster(1000, 500, 1000, 0);
+    faster.onMessagesConsumed(200);
+    CPPUNIT_ASSERT(faster.evaluate(10, 1000));
+    CPPUNIT_ASSERT_EQUAL(100, faster.getPrefetchSize());
+
+    // A consumer that can keep up with the maximum stays there.
+    AdaptivePrefetchController fast(1000, 1000, 1000, 0);
+    fast.onMessagesConsumed(5000);
+    CPPUNIT_ASSERT(!fast.evaluate(10, 1000));
+    CPPUNIT_ASSERT_EQUAL(1000, fast.getPrefetchSize());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AdaptivePrefetchControllerTest::testGrowWhenKeepingUp() {
+
+    AdaptivePrefetchController controller(1000, 1000, 1000, 0);
+
+    controller.onMessagesConsumed(50);
+    CPPUNIT_ASSERT(controller.evaluate(10, 1000));
+    CPPUNIT_ASSERT_EQUAL(50, controller.getPrefetchSize());
+
+    const int expected[] = { 100, 200, 400, 800, 1000 };
+    for (int i = 0; i < 5; ++i) {
+        controller.onMessagesConsumed(50);
+        CPPUNIT_ASSERT(controller.evaluate(0, 2000 + i * 1000));
+        CPPUNIT_ASSERT_EQUAL(expected[i], controller.getPrefetchSize());
+    }
+
+    controller.onMessagesConsumed(50);
+    CPPUNIT_ASSERT(!controller.evaluate(0, 7000));
+    CPPUNIT_ASSERT_EQUAL(1000, controller.getPrefetchSize());
+    CPPUNIT_ASSERT_EQUAL(6LL, controller.getAdjustments());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AdaptivePrefetchControllerTest::testSmallChangesIgnored() {
+
+    AdaptivePrefetchController controller(1000, 1000, 1000, 0);
+
+    controller.onMessagesConsumed(100);
+    CPPUNIT_ASSERT(controller.evaluate(10, 1000));
+    CPPUNIT_ASSERT_EQUAL(100, controller.getPrefetchSize());
+
+    controller.onMessagesConsumed(90);
+    CPPUNIT_ASSERT(!controller.evaluate(10, 2000));
+    CPPUNIT_ASSERT_EQUAL(100, controller.getPrefetchSize());
+    CPPUNIT_ASSERT_EQUAL(90.0, controller.getConsumptionRate());
+
+    controller.onMessagesConsumed(70);
+    CPPUNIT_ASSERT(controller.evaluate(10, 3000));
+    CPPUNIT_ASSERT_EQUAL(70, controller.getPrefetchSize());
+    CPPUNIT_ASSERT_EQUAL(2LL, controller.getAdjustments());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AdaptivePrefetchControllerTest::testMinimumPrefetch() {
+
+    AdaptivePrefetchController controller(1000, 1000, 1000, 0);
+
+    // A consumer stuck on one message with others waiting drops to a single message window.
+    CPPUNIT_ASSERT(controller.evaluate(10, 5000));
+    CPPUNIT_ASSERT_EQUAL(0.0, controller.getConsumptionRate());
+    CPPUNIT_ASSERT_EQUAL(1, controller.getPrefetchSize());
+    CPPUNIT_ASSERT_EQUAL(1, controller.getAckBatchSize());
+
+    CPPUNIT_ASSERT(!controller.evaluate(10, 6000));
+    CPPUNIT_ASSERT_EQUAL(1, controller.getPrefetchSize());
+}
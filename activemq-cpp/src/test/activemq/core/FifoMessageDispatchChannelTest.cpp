@@ -230,3 +230,40 @@ void FifoMessageDispatchChannelTest::testRemoveAll() {
     CPPUNIT_ASSERT( channel.size() == 0 );
     CPPUNIT_ASSERT( channel.isEmpty() == true );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void FifoMessageDispatchChannelTest::testDequeueBatch() {
+
+    FifoMessageDispatchChannel channel;
+
+    Pointer<MessageDispatch> dispatch1( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch2( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch3( new MessageDispatch() );
+
+    channel.enqueue( dispatch1 );
+    channel.enqueue( dispatch2 );
+    channel.enqueue( dispatch3 );
+
+    CPPUNIT_ASSERT( channel.dequeueBatch( 0, 10 ).empty() );
+
+    channel.start();
+    CPPUNIT_ASSERT( channel.isRunning() == true );
+    CPPUNIT_ASSERT( channel.dequeueBatch( 0, 0 ).empty() );
+
+    std::vector< Pointer<MessageDispatch> > batch = channel.dequeueBatch( -1, 2 );
+    CPPUNIT_ASSERT( batch.size() == 2 );
+    CPPUNIT_ASSERT( batch[0] == dispatch1 );
+    CPPUNIT_ASSERT( batch[1] == dispatch2 );
+    CPPUNIT_ASSERT( channel.size() == 1 );
+
+    batch = channel.dequeueBatch( 1000, 10 );
+    CPPUNIT_ASSERT( batch.size() == 1 );
+    CPPUNIT_ASSERT( batch[0] == dispatch3 );
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+
+    long long timeStarted = System::currentTimeMillis();
+
+    CPPUNIT_ASSERT( channel.dequeueBatch( 1000, 10 ).empty() );
+
+    CPPUNIT_ASSERT( System::currentTimeMillis() - timeStarted >= 999 );
+}
@@ -0,0 +1,412 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "GroupCommitterTest.h"
+
+#include <activemq/core/GroupCommitter.h>
+#include <activemq/commands/BrokerError.h>
+#include <activemq/commands/ExceptionResponse.h>
+#include <activemq/commands/LocalTransactionId.h>
+#include <activemq/commands/Response.h>
+#include <activemq/commands/TransactionInfo.h>
+#include <activemq/core/ActiveMQConstants.h>
+#include <activemq/exceptions/ActiveMQException.h>
+#include <activemq/transport/Transport.h>
+#include <activemq/wireformat/WireFormat.h>
+
+#include <decaf/io/IOException.h>
+#include <decaf/lang/Pointer.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/exceptions/UnsupportedOperationException.h>
+#include <decaf/util/ArrayList.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/TimeUnit.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace activemq::exceptions;
+using namespace activemq::transport;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::atomic;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    /**
+     * Records the requests sent to it so that the test decides when they are answered.
+     */
+    class PendingTransport : public activemq::transport::Transport {
+    public:
+
+        Mutex mutex;
+        ArrayList< Pointer<Command> > commands;
+        ArrayList< Pointer<ResponseCallback> > callbacks;
+        bool failSend;
+
+    public:
+
+        PendingTransport() : mutex(), commands(), callbacks(), failSend(false) {}
+
+        virtual ~PendingTransport() {}
+
+        virtual void start() {}
+
+        virtual void stop() {}
+
+        virtual void close() {}
+
+        virtual void oneway(const Pointer<Command> command) {
+            throw UnsupportedOperationException();
+        }
+
+        virtual Pointer<FutureResponse> asyncRequest(const Pointer<Command> command,
+                                                     const Pointer<ResponseCallback> responseCallback) {
+            if (failSend) {
+                throw IOException(__FILE__, __LINE__, "Failed to send");
+            }
+
+            synchronized(&mutex) {
+                command->setCommandId(commands.size() + 1);
+                commands.add(command);
+                callbacks.add(responseCallback);
+                mutex.notifyAll();
+            }
+
+            return Pointer<FutureResponse>();
+        }
+
+        virtual Pointer<Response> request(const Pointer<Command> command) {
+            throw UnsupportedOperationException();
+        }
+
+        virtual Pointer<Response> request(const Pointer<Command> command, unsigned int timeout) {
+            throw UnsupportedOperationException();
+        }
+
+        virtual Pointer<wireformat::WireFormat> getWireFormat() const {
+            return Pointer<wireformat::WireFormat>();
+        }
+
+        virtual void setWireFormat(const Pointer<wireformat::WireFormat> wireFormat) {
+        }
+
+        virtual void setTransportListener(TransportListener* listener) {
+        }
+
+        virtual TransportListener* getTransportListener() const {
+            return NULL;
+        }
+
+        virtual Transport* narrow(const std::type_info& typeId) {
+            return NULL;
+        }
+
+        virtual bool isFaultTolerant() const {
+            return false;
+        }
+
+        virtual bool isConnected() const {
+            return true;
+        }
+
+        virtual bool isClosed() const {
+            return false;
+        }
+
+        virtual bool isReconnectSupported() const {
+            return false;
+        }
+
+        virtual bool isUpdateURIsSupported() const {
+            return false;
+        }
+
+        virtual std::string getRemoteAddress() const {
+            return "";
+        }
+
+        virtual void reconnect(const decaf::net::URI& uri) {
+        }
+
+        virtual void updateURIs(bool rebalance, const decaf::util::List<decaf::net::URI>& uris) {
+        }
+
+        int sentCount() {
+            int result = 0;
+            synchronized(&mutex) {
+                result = commands.size();
+            }
+            return result;
+        }
+
+        void respond(int index) {
+            Pointer<Response> response(new Response());
+            response->setCorrelationId(commands.get(index)->getCommandId());
+            callbacks.get(index)->onComplete(response);
+        }
+
+        void fail(int index, const std::string& message) {
+            Pointer<BrokerError> error(new BrokerError());
+            error->setExceptionClass("javax.jms.JMSException");
+            error->setMessage(message);
+            Pointer<ExceptionResponse> response(new ExceptionResponse());
+            response->setCorrelationId(commands.get(index)->getCommandId());
+            response->setException(error);
+            callbacks.get(index)->onComplete(response);
+        }
+    };
+
+    class RecordingCallback : public cms::AsyncCallback {
+    private:
+
+        RecordingCallback(const RecordingCallback&);
+        RecordingCallback& operator=(const RecordingCallback&);
+
+    public:
+
+        AtomicInteger* order;
+        AtomicInteger successes;
+        AtomicInteger failures;
+        int completedAt;
+
+        RecordingCallback(AtomicInteger* order = NULL) :
+            order(order), successes(), failures(), completedAt(0) {}
+
+        virtual ~RecordingCallback() {}
+
+        virtual void onSuccess() {
+            if (order != NULL) {
+                completedAt = order->incrementAndGet();
+            }
+            successes.incrementAndGet();
+        }
+
+        virtual void onException(const cms::CMSException& ex) {
+            failures.incrementAndGet();
+        }
+    };
+
+    Pointer<TransactionInfo> createCommit(int value) {
+        Pointer<LocalTransactionId> id(new LocalTransactionId());
+        id->setValue(value);
+        Pointer<TransactionInfo> info(new TransactionInfo());
+        info->setTransactionId(id);
+        info->setType(ActiveMQConstants::TRANSACTION_STATE_COMMITONEPHASE);
+        return info;
+    }
+
+    class CommitTask : public Runnable {
+    private:
+
+        CommitTask(const CommitTask&);
+        CommitTask& operator=(const CommitTask&);
+
+    public:
+
+        GroupCommitter* committer;
+        Pointer<cms::AsyncCallback> callback;
+        CountDownLatch done;
+        bool failed;
+
+        CommitTask(GroupCommitter* committer, Pointer<cms::AsyncCallback> callback) :
+            committer(committer), callback(callback), done(1), failed(false) {}
+
+        virtual ~CommitTask() {}
+
+        virtual void run() {
+            try {
+                committer->commit(createCommit(99), callback);
+            } catch (Exception& ex) {
+                failed = true;
+            }
+            done.countDown();
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+GroupCommitterTest::GroupCommitterTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+GroupCommitterTest::~GroupCommitterTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void GroupCommitterTest::testCommitCompletesOnResponse() {
+
+    Pointer<PendingTransport> transport(new PendingTransport());
+    GroupCommitter committer(transport);
+
+    RecordingCallback* recorder = new RecordingCallback();
+    Pointer<cms::AsyncCallback> callback(recorder);
+
+    committer.commit(createCommit(1), callback);
+
+    CPPUNIT_ASSERT_EQUAL(1, transport->sentCount());
+    CPPUNIT_ASSERT_EQUAL(1, committer.getPendingCommitCount());
+    CPPUNIT_ASSERT_EQUAL(0, recorder->successes.get());
+
+    transport->respond(0);
+
+    CPPUNIT_ASSERT_EQUAL(1, recorder->successes.get());
+    CPPUNIT_ASSERT_EQUAL(0, recorder->failures.get());
+    CPPUNIT_ASSERT_EQUAL(0, committer.getPendingCommitCount());
+    CPPUNIT_ASSERT_EQUAL(1LL, committer.getCommitCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void GroupCommitterTest::testCommitExceptionResponse() {
+
+    Pointer<PendingTransport> transport(new PendingTransport());
+    GroupCommitter committer(transport);
+
+    RecordingCallback* recorder = new RecordingCallback();
+    Pointer<cms::AsyncCallback> callback(recorder);
+
+    committer.commit(createCommit(1), callback);
+    transport->fail(0, "Commit Failed");
+
+    CPPUNIT_ASSERT_EQUAL(0, recorder->successes.get());
+    CPPUNIT_ASSERT_EQUAL(1, recorder->failures.get());
+    CPPUNIT_ASSERT_EQUAL(0, committer.getPendingCommitCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void GroupCommitterTest::testCommitsPipelined() {
+
+    static const int COUNT = 10;
+
+    Pointer<PendingTransport> transport(new PendingTransport());
+    GroupCommitter committer(transport);
+
+    AtomicInteger order;
+    std::vector<RecordingCallback*> recorders;
+
+    for (int i = 0; i < COUNT; ++i) {
+        RecordingCallback* recorder = new RecordingCallback(&order);
+        recorders.push_back(recorder);
+        committer.commit(createCommit(i), Pointer<cms::AsyncCallback>(recorder));
+    }
+
+    CPPUNIT_ASSERT_MESSAGE("All commits should be sent before any response",
+                           transport->sentCount() == COUNT);
+    CPPUNIT_ASSERT_EQUAL(COUNT, committer.getPendingCommitCount());
+
+    for (int i = 0; i < COUNT; ++i) {
+        transport->respond(i);
+    }
+
+    for (int i = 0; i < COUNT; ++i) {
+        CPPUNIT_ASSERT_EQUAL(1, recorders[i]->successes.get());
+        CPPUNIT_ASSERT_EQUAL(i + 1, recorders[i]->completedAt);
+    }
+
+    CPPUNIT_ASSERT_EQUAL((long long) COUNT, committer.getCommitCount());
+    CPPUNIT_ASSERT(committer.getGroupCount() <= committer.getCommitCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void GroupCommitterTest::testMaxPendingCommitsBlocks() {
+
+    Pointer<PendingTransport> transport(new PendingTransport());
+    GroupCommitter committer(transport);
+    committer.setMaxPendingCommits(1);
+    CPPUNIT_ASSERT_EQUAL(1, committer.getMaxPendingCommits());
+
+    committer.commit(createCommit(1), Pointer<cms::AsyncCallback>(new RecordingCallback()));
+
+    RecordingCallback* recorder = new RecordingCallback();
+    CommitTask task(&committer, Pointer<cms::AsyncCallback>(recorder));
+    Thread thread(&task);
+    thread.start();
+
+    CPPUNIT_ASSERT_MESSAGE("Second commit should wait for a free slot",
+                           !task.done.await(200, TimeUnit::MILLISECONDS));
+    CPPUNIT_ASSERT_EQUAL(1, transport->sentCount());
+
+    transport->respond(0);
+
+    CPPUNIT_ASSERT(task.done.await(2000, TimeUnit::MILLISECONDS));
+    CPPUNIT_ASSERT(!task.failed);
+    CPPUNIT_ASSERT_EQUAL(2, transport->sentCount());
+
+    transport->respond(1);
+    CPPUNIT_ASSERT_EQUAL(1, recorder->successes.get());
+
+    thread.join();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void GroupCommitterTest::testSendFailure() {
+
+    Pointer<PendingTransport> transport(new PendingTransport());
+    GroupCommitter committer(transport);
+    transport->failSend = true;
+
+    RecordingCallback* recorder = new RecordingCallback();
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an ActiveMQException",
+        committer.commit(createCommit(1), Pointer<cms::AsyncCallback>(recorder)),
+        ActiveMQException);
+
+    CPPUNIT_ASSERT_EQUAL(0, committer.getPendingCommitCount());
+    CPPUNIT_ASSERT_EQUAL(0, recorder->successes.get());
+    CPPUNIT_ASSERT_EQUAL(0, recorder->failures.get());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void GroupCommitterTest::testClose() {
+
+    Pointer<PendingTransport> transport(new PendingTransport());
+    GroupCommitter committer(transport);
+    committer.setMaxPendingCommits(1);
+
+    committer.commit(createCommit(1), Pointer<cms::AsyncCallback>(new RecordingCallback()));
+
+    CommitTask task(&committer, Pointer<cms::AsyncCallback>(new RecordingCallback()));
+    Thread thread(&task);
+    thread.start();
+
+    CPPUNIT_ASSERT(!task.done.await(100, TimeUnit::MILLISECONDS));
+
+    committer.close();
+
+    CPPUNIT_ASSERT(task.done.await(2000, TimeUnit::MILLISECONDS));
+    CPPUNIT_ASSERT_MESSAGE("Waiting commit should fail once closed", task.failed);
+    thread.join();
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an ActiveMQException",
+        committer.commit(createCommit(2), Pointer<cms::AsyncCallback>(new RecordingCallback())),
+        ActiveMQException);
+
+    // The commit that was already sent still completes.
+    transport->respond(0);
+    CPPUNIT_ASSERT_EQUAL(0, committer.getPendingCommitCount());
+}
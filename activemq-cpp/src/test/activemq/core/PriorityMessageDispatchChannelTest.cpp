@@ -0,0 +1,412 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PriorityMessageDispatchChannelTest.h"
+
+#include <activemq/core/PriorityMessageDispatchChannel.h>
+#include <activemq/commands/MessageDispatch.h>
+#include <decaf/lang/Pointer.h>
+#include <decaf/lang/System.h>
+
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace decaf;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+void PriorityMessageDispatchChannelTest::testCtor() {
+
+    PriorityMessageDispatchChannel channel;
+    CPPUNIT_ASSERT( channel.isRunning() == false );
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+    CPPUNIT_ASSERT( channel.size() == 0 );
+    CPPUNIT_ASSERT( channel.isClosed() == false );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PriorityMessageDispatchChannelTest::testStart() {
+
+    PriorityMessageDispatchChannel channel;
+    channel.start();
+    CPPUNIT_ASSERT( channel.isRunning() == true );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PriorityMessageDispatchChannelTest::testStop() {
+
+    PriorityMessageDispatchChannel channel;
+    channel.start();
+    CPPUNIT_ASSERT( channel.isRunning() == true );
+    channel.stop();
+    CPPUNIT_ASSERT( channel.isRunning() == false );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PriorityMessageDispatchChannelTest::testClose() {
+
+    PriorityMessageDispatchChannel channel;
+    channel.start();
+    CPPUNIT_ASSERT( channel.isRunning() == true );
+    CPPUNIT_ASSERT( channel.isClosed() == false );
+    channel.close();
+    CPPUNIT_ASSERT( channel.isRunning() == false );
+    CPPUNIT_ASSERT( channel.isClosed() == true );
+    channel.start();
+    CPPUNIT_ASSERT( channel.isRunning() == false );
+    CPPUNIT_ASSERT( channel.isClosed() == true );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PriorityMessageDispatchChannelTest::testEnqueue() {
+
+    PriorityMessageDispatchChannel channel;
+    Pointer<MessageDispatch> dispatch1( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch2( new MessageDispatch() );
+
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+    CPPUNIT_ASSERT( channel.size() == 0 );
+
+    channel.enqueue( dispatch1 );
+
+    CPPUNIT_ASSERT( channel.isEmpty() == false );
+    CPPUNIT_ASSERT( channel.size() == 1 );
+
+    channel.enqueue( dispatch2 );
+
+    CPPUNIT_ASSERT( channel.isEmpty() == false );
+    CPPUNIT_ASSERT( channel.size() == 2 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PriorityMessageDispatchChannelTest::testEnqueueFront() {
+
+    PriorityMessageDispatchChannel channel;
+    Pointer<MessageDispatch> dispatch1( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch2( new MessageDispatch() );
+
+    Pointer<Message> message1( new Message() );
+    Pointer<Message> message2( new Message() );
+
+    message1->setPriority( 2 );
+    message2->setPriority( 1 );
+
+    dispatch1->setMessage( message1 );
+    dispatch2->setMessage( message2 );
+
+    channel.start();
+
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+    CPPUNIT_ASSERT( channel.size() == 0 );
+
+    channel.enqueueFirst( dispatch1 );
+
+    CPPUNIT_ASSERT( channel.isEmpty() == false );
+    CPPUNIT_ASSERT( channel.size() == 1 );
+
+    channel.enqueueFirst( dispatch2 );
+
+    CPPUNIT_ASSERT( channel.isEmpty() == false );
+    CPPUNIT_ASSERT( channel.size() == 2 );
+
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == dispatch1 );
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == dispatch2 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PriorityMessageDispatchChannelTest::testPeek() {
+
+    PriorityMessageDispatchChannel channel;
+    Pointer<MessageDispatch> dispatch1( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch2( new MessageDispatch() );
+
+    Pointer<Message> message1( new Message() );
+    Pointer<Message> message2( new Message() );
+
+    message1->setPriority( 2 );
+    message2->setPriority( 1 );
+
+    dispatch1->setMessage( message1 );
+    dispatch2->setMessage( message2 );
+
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+    CPPUNIT_ASSERT( channel.size() == 0 );
+
+    channel.enqueueFirst( dispatch1 );
+
+    CPPUNIT_ASSERT( channel.isEmpty() == false );
+    CPPUNIT_ASSERT( channel.size() == 1 );
+
+    channel.enqueueFirst( dispatch2 );
+
+    CPPUNIT_ASSERT( channel.isEmpty() == false );
+    CPPUNIT_ASSERT( channel.size() == 2 );
+
+    CPPUNIT_ASSERT( channel.peek() == NULL );
+
+    channel.start();
+
+    CPPUNIT_ASSERT( channel.peek() == dispatch1 );
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == dispatch1 );
+    CPPUNIT_ASSERT( channel.peek() == dispatch2 );
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == dispatch2 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PriorityMessageDispatchChannelTest::testDequeueNoWait() {
+
+    PriorityMessageDispatchChannel channel;
+
+    Pointer<MessageDispatch> dispatch1( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch2( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch3( new MessageDispatch() );
+
+    Pointer<Message> message1( new Message() );
+    Pointer<Message> message2( new Message() );
+    Pointer<Message> message3( new Message() );
+
+    message1->setPriority( 2 );
+    message2->setPriority( 3 );
+    message3->setPriority( 1 );
+
+    dispatch1->setMessage( message1 );
+    dispatch2->setMessage( message2 );
+    dispatch3->setMessage( message3 );
+
+    CPPUNIT_ASSERT( channel.isRunning() == false );
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == NULL );
+
+    channel.enqueue( dispatch1 );
+    channel.enqueue( dispatch2 );
+    channel.enqueue( dispatch3 );
+
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == NULL );
+    channel.start();
+    CPPUNIT_ASSERT( channel.isRunning() == true );
+
+    CPPUNIT_ASSERT( channel.isEmpty() == false );
+    CPPUNIT_ASSERT( channel.size() == 3 );
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == dispatch2 );
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == dispatch1 );
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == dispatch3 );
+
+    CPPUNIT_ASSERT( channel.size() == 0 );
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PriorityMessageDispatchChannelTest::testDequeue() {
+
+    PriorityMessageDispatchChannel channel;
+
+    Pointer<MessageDispatch> dispatch1( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch2( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch3( new MessageDispatch() );
+
+    Pointer<Message> message1( new Message() );
+    Pointer<Message> message2( new Message() );
+    Pointer<Message> message3( new Message() );
+
+    message1->setPriority( 2 );
+    message2->setPriority( 3 );
+    message3->setPriority( 1 );
+
+    dispatch1->setMessage( message1 );
+    dispatch2->setMessage( message2 );
+    dispatch3->setMessage( message3 );
+
+    channel.start();
+    CPPUNIT_ASSERT( channel.isRunning() == true );
+
+    long long timeStarted = System::currentTimeMillis();
+
+    CPPUNIT_ASSERT( channel.dequeue( 1000 ) == NULL );
+
+    CPPUNIT_ASSERT( System::currentTimeMillis() - timeStarted >= 999 );
+
+    channel.enqueue( dispatch1 );
+    channel.enqueue( dispatch2 );
+    channel.enqueue( dispatch3 );
+    CPPUNIT_ASSERT( channel.isEmpty() == false );
+    CPPUNIT_ASSERT( channel.size() == 3 );
+    CPPUNIT_ASSERT( channel.dequeue( -1 ) == dispatch2 );
+    CPPUNIT_ASSERT( channel.dequeue( 0 ) == dispatch1 );
+    CPPUNIT_ASSERT( channel.dequeue( 1000 ) == dispatch3 );
+
+    CPPUNIT_ASSERT( channel.size() == 0 );
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PriorityMessageDispatchChannelTest::testRemoveAll() {
+
+    PriorityMessageDispatchChannel channel;
+
+    Pointer<MessageDispatch> dispatch1( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch2( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch3( new MessageDispatch() );
+
+    Pointer<Message> message1( new Message() );
+    Pointer<Message> message2( new Message() );
+    Pointer<Message> message3( new Message() );
+
+    message1->setPriority( 2 );
+    message2->setPriority( 3 );
+    message3->setPriority( 1 );
+
+    dispatch1->setMessage( message1 );
+    dispatch2->setMessage( message2 );
+    dispatch3->setMessage( message3 );
+
+    channel.enqueue( dispatch1 );
+    channel.enqueue( dispatch2 );
+    channel.enqueue( dispatch3 );
+
+    channel.start();
+    CPPUNIT_ASSERT( channel.isRunning() == true );
+    CPPUNIT_ASSERT( channel.isEmpty() == false );
+    CPPUNIT_ASSERT( channel.size() == 3 );
+    CPPUNIT_ASSERT( channel.removeAll().size() == 3 );
+    CPPUNIT_ASSERT( channel.size() == 0 );
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PriorityMessageDispatchChannelTest::testDequeueBatch() {
+
+    PriorityMessageDispatchChannel channel;
+
+    Pointer<MessageDispatch> dispatch1( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch2( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch3( new MessageDispatch() );
+
+    Pointer<Message> message1( new Message() );
+    Pointer<Message> message2( new Message() );
+    Pointer<Message> message3( new Message() );
+
+    message1->setPriority( 2 );
+    message2->setPriority( 3 );
+    message3->setPriority( 1 );
+
+    dispatch1->setMessage( message1 );
+    dispatch2->setMessage( message2 );
+    dispatch3->setMessage( message3 );
+
+    channel.enqueue( dispatch1 );
+    channel.enqueue( dispatch2 );
+    channel.enqueue( dispatch3 );
+
+    CPPUNIT_ASSERT( channel.dequeueBatch( 0, 10 ).empty() );
+
+    channel.start();
+    CPPUNIT_ASSERT( channel.isRunning() == true );
+
+    std::vector< Pointer<MessageDispatch> > batch = channel.dequeueBatch( -1, 2 );
+    CPPUNIT_ASSERT( batch.size() == 2 );
+    CPPUNIT_ASSERT( batch[0] == dispatch2 );
+    CPPUNIT_ASSERT( batch[1] == dispatch1 );
+    CPPUNIT_ASSERT( channel.size() == 1 );
+
+    batch = channel.dequeueBatch( 0, 10 );
+    CPPUNIT_ASSERT( batch.size() == 1 );
+    CPPUNIT_ASSERT( batch[0] == dispatch3 );
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    Pointer<MessageDispatch> createDispatch( int priority ) {
+        Pointer<Message> message( new Message() );
+        message->setPriority( (unsigned char) priority );
+        Pointer<MessageDispatch> dispatch( new MessageDispatch() );
+        dispatch->setMessage( message );
+        return dispatch;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PriorityMessageDispatchChannelTest::testPriorityOrdering() {
+
+    PriorityMessageDispatchChannel channel;
+    channel.start();
+
+    std::vector< Pointer<MessageDispatch> > dispatches;
+    for( int i = 0; i < 30; ++i ) {
+        dispatches.push_back( createDispatch( ( i * 7 ) % 10 ) );
+        channel.enqueue( dispatches.back() );
+    }
+
+    // Out of range priorities are delivered with the highest priority.
+    Pointer<MessageDispatch> high = createDispatch( 20 );
+    channel.enqueue( high );
+
+    // A redelivered Message goes ahead of others of its own priority.
+    Pointer<MessageDispatch> first = createDispatch( 9 );
+    channel.enqueueFirst( first );
+
+    CPPUNIT_ASSERT_EQUAL( 32, channel.size() );
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == first );
+
+    int lastPriority = 9;
+    int count = 0;
+    while( !channel.isEmpty() ) {
+        Pointer<MessageDispatch> dispatch = channel.dequeueNoWait();
+        int priority = dispatch->getMessage()->getPriority() > 9 ? 9 : dispatch->getMessage()->getPriority();
+        CPPUNIT_ASSERT( priority <= lastPriority );
+        lastPriority = priority;
+        count++;
+    }
+
+    CPPUNIT_ASSERT_EQUAL( 31, count );
+
+    // Messages of the same priority keep their arrival order.
+    for( int i = 0; i < 30; ++i ) {
+        channel.enqueue( dispatches[i] );
+    }
+
+    std::vector< Pointer<MessageDispatch> > drained = channel.removeAll();
+    CPPUNIT_ASSERT_EQUAL( (std::size_t) 30, drained.size() );
+    CPPUNIT_ASSERT( drained[0] == dispatches[7] );
+    CPPUNIT_ASSERT( drained[1] == dispatches[17] );
+    CPPUNIT_ASSERT( drained[2] == dispatches[27] );
+    CPPUNIT_ASSERT( drained[27] == dispatches[0] );
+    CPPUNIT_ASSERT( drained[28] == dispatches[10] );
+    CPPUNIT_ASSERT( drained[29] == dispatches[20] );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PriorityMessageDispatchChannelTest::testClear() {
+
+    PriorityMessageDispatchChannel channel;
+
+    channel.enqueue( createDispatch( 1 ) );
+    channel.enqueue( createDispatch( 5 ) );
+    channel.enqueue( createDispatch( 9 ) );
+
+    CPPUNIT_ASSERT_EQUAL( 3, channel.size() );
+    channel.clear();
+    CPPUNIT_ASSERT_EQUAL( 0, channel.size() );
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+
+    channel.start();
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == NULL );
+
+    Pointer<MessageDispatch> dispatch = createDispatch( 4 );
+    channel.enqueue( dispatch );
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == dispatch );
+}
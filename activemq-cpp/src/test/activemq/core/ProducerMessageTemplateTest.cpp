@@ -0,0 +1,304 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ProducerMessageTemplateTest.h"
+
+#include <activemq/core/ProducerMessageTemplate.h>
+#include <activemq/commands/ActiveMQTextMessage.h>
+#include <activemq/commands/ActiveMQBytesMessage.h>
+#include <activemq/transport/IOTransport.h>
+#include <activemq/wireformat/openwire/OpenWireFormat.h>
+
+#include <cms/CMSException.h>
+
+#include <decaf/io/ByteArrayInputStream.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataInputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/util/Properties.h>
+
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace activemq::transport;
+using namespace activemq::wireformat::openwire;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::util;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    std::vector<unsigned char> marshalFrame(const Pointer<commands::Message>& message, bool tightEncoding) {
+
+        Properties properties;
+        OpenWireFormat format(properties);
+        format.setTightEncodingEnabled(tightEncoding);
+
+        IOTransport transport;
+        ByteArrayOutputStream bytes;
+        DataOutputStream out(&bytes);
+
+        format.marshal(message, &transport, &out);
+
+        std::pair<unsigned char*, int> array = bytes.toByteArray();
+        std::vector<unsigned char> frame(array.first, array.first + array.second);
+        delete [] array.first;
+
+        return frame;
+    }
+
+    Pointer<commands::Message> unmarshalFrame(const std::vector<unsigned char>& frame) {
+
+        Properties properties;
+        OpenWireFormat format(properties);
+        format.setTightEncodingEnabled(false);
+
+        IOTransport transport;
+        ByteArrayInputStream bais(frame);
+        DataInputStream in(&bais);
+
+        return format.unmarshal(&transport, &in).dynamicCast<commands::Message>();
+    }
+
+    void assertSameFrames(const Pointer<commands::Message>& expected, const Pointer<commands::Message>& actual) {
+        CPPUNIT_ASSERT(marshalFrame(expected, false) == marshalFrame(actual, false));
+        CPPUNIT_ASSERT(marshalFrame(expected, true) == marshalFrame(actual, true));
+    }
+
+    std::vector<std::string> names(const char* first, const char* second = NULL, const char* third = NULL) {
+        std::vector<std::string> result;
+        result.push_back(first);
+        if (second != NULL) {
+            result.push_back(second);
+        }
+        if (third != NULL) {
+            result.push_back(third);
+        }
+        return result;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ProducerMessageTemplateTest::ProducerMessageTemplateTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ProducerMessageTemplateTest::~ProducerMessageTemplateTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProducerMessageTemplateTest::testTextMessageMatchesNormalSend() {
+
+    ActiveMQTextMessage prototype;
+    prototype.setCMSType("quote");
+    prototype.setCMSCorrelationID("feed");
+    prototype.setStringProperty("symbol", "IBM");
+    prototype.setStringProperty("exchange", "NYSE");
+    prototype.setIntProperty("venue", 7);
+    prototype.setIntProperty("seq", -1);
+    prototype.setText("prototype");
+
+    // The variable names sort between and around the constant ones.
+    ProducerMessageTemplate messageTemplate(prototype, names("seq", "price", "zone"));
+
+    for (int i = 0; i < 3; ++i) {
+
+        std::string text = std::string("quote ") + Integer::toString(i);
+
+        messageTemplate.setIntProperty("seq", i);
+        messageTemplate.setDoubleProperty("price", 100.5 + i);
+        if (i == 1) {
+            messageTemplate.setStringProperty("zone", "east");
+        }
+        messageTemplate.setText(text);
+
+        // What the normal send path sends for the prototype with the same values set.
+        Pointer<ActiveMQTextMessage> expected(prototype.cloneDataStructure());
+        expected->setIntProperty("seq", i);
+        expected->setDoubleProperty("price", 100.5 + i);
+        if (i >= 1) {
+            expected->setStringProperty("zone", "east");
+        }
+        expected->setText(text);
+
+        assertSameFrames(expected, messageTemplate.createMessage(NULL));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProducerMessageTemplateTest::testBytesMessageMatchesNormalSend() {
+
+    ActiveMQBytesMessage prototype;
+    prototype.setBooleanProperty("book", true);
+    prototype.setLongProperty("account", 1234567890123LL);
+    prototype.writeInt(42);
+    prototype.reset();
+
+    ProducerMessageTemplate messageTemplate(prototype, names("level", "amount"));
+
+    // Without a body set on the template the prototype's body is sent.
+    messageTemplate.setShortProperty("level", 3);
+
+    Pointer<ActiveMQBytesMessage> expected(prototype.cloneDataStructure());
+    expected->setShortProperty("level", 3);
+    assertSameFrames(expected, messageTemplate.createMessage(NULL));
+
+    unsigned char body[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    messageTemplate.setBytes(body, (int) sizeof(body));
+    messageTemplate.setFloatProperty("amount", 2.5f);
+
+    Pointer<commands::Message> created = messageTemplate.createMessage(NULL);
+    created.dynamicCast<ActiveMQBytesMessage>()->reset();
+
+    expected.reset(prototype.cloneDataStructure());
+    expected->clearBody();
+    expected->setShortProperty("level", 3);
+    expected->setFloatProperty("amount", 2.5f);
+    expected->writeBytes(body, 0, (int) sizeof(body));
+    expected->reset();
+
+    assertSameFrames(expected, created);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProducerMessageTemplateTest::testNoProperties() {
+
+    ActiveMQTextMessage prototype;
+    prototype.setText("constant");
+
+    ProducerMessageTemplate messageTemplate(prototype, names("seq"));
+
+    Pointer<commands::Message> created = messageTemplate.createMessage(NULL);
+    CPPUNIT_ASSERT(created->getMarshalledProperties().empty());
+
+    Pointer<ActiveMQTextMessage> expected(prototype.cloneDataStructure());
+    assertSameFrames(expected, created);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProducerMessageTemplateTest::testClearProperty() {
+
+    ActiveMQTextMessage prototype;
+    prototype.setStringProperty("symbol", "IBM");
+
+    ProducerMessageTemplate messageTemplate(prototype, names("seq"));
+
+    messageTemplate.setIntProperty("seq", 1);
+    Pointer<ActiveMQTextMessage> created =
+        messageTemplate.createMessage(NULL).dynamicCast<ActiveMQTextMessage>();
+    CPPUNIT_ASSERT(created->propertyExists("seq"));
+
+    messageTemplate.clearProperty("seq");
+    created = messageTemplate.createMessage(NULL).dynamicCast<ActiveMQTextMessage>();
+    CPPUNIT_ASSERT(!created->propertyExists("seq"));
+
+    Pointer<ActiveMQTextMessage> expected(prototype.cloneDataStructure());
+    assertSameFrames(expected, created);
+
+    // Clearing a property that isn't set does nothing.
+    messageTemplate.clearProperty("seq");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProducerMessageTemplateTest::testReservedProperties() {
+
+    ActiveMQTextMessage prototype;
+
+    ProducerMessageTemplate messageTemplate(prototype, names("JMSXGroupID", "JMSXGroupSeq"));
+    messageTemplate.setStringProperty("JMSXGroupID", "group");
+    messageTemplate.setIntProperty("JMSXGroupSeq", 3);
+
+    Pointer<commands::Message> created = messageTemplate.createMessage(NULL);
+    CPPUNIT_ASSERT_EQUAL(std::string("group"), created->getGroupID());
+    CPPUNIT_ASSERT_EQUAL(3, created->getGroupSequence());
+    CPPUNIT_ASSERT(created->getMarshalledProperties().empty());
+
+    Pointer<ActiveMQTextMessage> expected(prototype.cloneDataStructure());
+    expected->setStringProperty("JMSXGroupID", "group");
+    expected->setIntProperty("JMSXGroupSeq", 3);
+    assertSameFrames(expected, created);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProducerMessageTemplateTest::testReadCreatedMessage() {
+
+    ActiveMQTextMessage prototype;
+    prototype.setStringProperty("symbol", "IBM");
+
+    ProducerMessageTemplate messageTemplate(prototype, names("seq"));
+    messageTemplate.setIntProperty("seq", 5);
+
+    Pointer<ActiveMQTextMessage> created =
+        messageTemplate.createMessage(NULL).dynamicCast<ActiveMQTextMessage>();
+
+    // Copies carry the encoded properties, reading them decodes the encoding.
+    Pointer<ActiveMQTextMessage> copy(created->cloneDataStructure());
+    CPPUNIT_ASSERT_EQUAL(std::string("IBM"), copy->getStringProperty("symbol"));
+    CPPUNIT_ASSERT_EQUAL(5, copy->getIntProperty("seq"));
+    CPPUNIT_ASSERT_EQUAL(2, (int) copy->getPropertyNames().size());
+
+    // A property set after creation is sent along with the others.
+    created->setIntProperty("seq", 6);
+    Pointer<commands::Message> received = unmarshalFrame(marshalFrame(created, false));
+    Pointer<ActiveMQTextMessage> text = received.dynamicCast<ActiveMQTextMessage>();
+    CPPUNIT_ASSERT_EQUAL(std::string("IBM"), text->getStringProperty("symbol"));
+    CPPUNIT_ASSERT_EQUAL(6, text->getIntProperty("seq"));
+
+    // Marshaling again resends the same encoding.
+    Pointer<commands::Message> other = messageTemplate.createMessage(NULL);
+    std::vector<unsigned char> frame = marshalFrame(other, true);
+    CPPUNIT_ASSERT(frame == marshalFrame(other, true));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProducerMessageTemplateTest::testInvalidProperties() {
+
+    ActiveMQTextMessage prototype;
+    prototype.setStringProperty("symbol", "IBM");
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a CMSException for an empty name",
+        ProducerMessageTemplate(prototype, names("")),
+        cms::CMSException);
+
+    ProducerMessageTemplate messageTemplate(prototype, names("seq"));
+
+    CPPUNIT_ASSERT(messageTemplate.isVariableProperty("seq"));
+    CPPUNIT_ASSERT(!messageTemplate.isVariableProperty("symbol"));
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a CMSException for a constant property",
+        messageTemplate.setStringProperty("symbol", "HPQ"),
+        cms::CMSException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a CMSException for an undeclared property",
+        messageTemplate.clearProperty("other"),
+        cms::CMSException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a CMSException for a body of the wrong type",
+        messageTemplate.setBytes(NULL, 0),
+        cms::CMSException);
+}
@@ -0,0 +1,135 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CounterTest.h"
+
+#include <activemq/metrics/Counter.h>
+
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/Runnable.h>
+
+using namespace activemq;
+using namespace activemq::metrics;
+using namespace decaf;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class IncrementTask : public Runnable {
+    private:
+
+        Counter* counter;
+        int count;
+
+    private:
+
+        IncrementTask(const IncrementTask&);
+        IncrementTask& operator=(const IncrementTask&);
+
+    public:
+
+        IncrementTask(Counter* counter, int count) : Runnable(), counter(counter), count(count) {}
+
+        virtual void run() {
+            for (int i = 0; i < count; ++i) {
+                counter->increment();
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void CounterTest::testIncrement() {
+
+    Counter counter;
+    CPPUNIT_ASSERT_EQUAL(0LL, counter.get());
+
+    counter.increment();
+    counter.increment();
+    CPPUNIT_ASSERT_EQUAL(2LL, counter.get());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void CounterTest::testAdd() {
+
+    Counter counter;
+
+    counter.add(10);
+    counter.add(-3);
+    CPPUNIT_ASSERT_EQUAL(7LL, counter.get());
+
+    counter.add(0);
+    CPPUNIT_ASSERT_EQUAL(7LL, counter.get());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void CounterTest::testCarry() {
+
+    Counter counter;
+
+    // Large deltas would overflow a cell and so must be carried into the base.
+    const long long large = 5000000000LL;
+    counter.add(large);
+    counter.add(large);
+    CPPUNIT_ASSERT_EQUAL(2 * large, counter.get());
+
+    for (int i = 0; i < 3; ++i) {
+        counter.add(1 << 29);
+    }
+    CPPUNIT_ASSERT_EQUAL(2 * large + 3 * (1LL << 29), counter.get());
+
+    counter.add(-2 * large);
+    CPPUNIT_ASSERT_EQUAL(3 * (1LL << 29), counter.get());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void CounterTest::testReset() {
+
+    Counter counter;
+
+    counter.add(5000000000LL);
+    counter.increment();
+    counter.reset();
+    CPPUNIT_ASSERT_EQUAL(0LL, counter.get());
+
+    counter.increment();
+    CPPUNIT_ASSERT_EQUAL(1LL, counter.get());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void CounterTest::testConcurrentIncrement() {
+
+    static const int THREADS = 8;
+    static const int COUNT = 20000;
+
+    Counter counter;
+    IncrementTask task(&counter, COUNT);
+
+    Thread* threads[THREADS];
+    for (int i = 0; i < THREADS; ++i) {
+        threads[i] = new Thread(&task);
+        threads[i]->start();
+    }
+
+    for (int i = 0; i < THREADS; ++i) {
+        threads[i]->join();
+        delete threads[i];
+    }
+
+    CPPUNIT_ASSERT_EQUAL((long long) THREADS * COUNT, counter.get());
+}
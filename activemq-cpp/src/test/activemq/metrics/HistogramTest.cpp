@@ -0,0 +1,147 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HistogramTest.h"
+
+#include <activemq/metrics/Histogram.h>
+
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/Runnable.h>
+
+using namespace activemq;
+using namespace activemq::metrics;
+using namespace decaf;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class RecordTask : public Runnable {
+    private:
+
+        Histogram* histogram;
+        int count;
+
+    private:
+
+        RecordTask(const RecordTask&);
+        RecordTask& operator=(const RecordTask&);
+
+    public:
+
+        RecordTask(Histogram* histogram, int count) : Runnable(), histogram(histogram), count(count) {}
+
+        virtual void run() {
+            for (int i = 0; i < count; ++i) {
+                histogram->record(i % 1000);
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void HistogramTest::testGetBucketIndex() {
+
+    CPPUNIT_ASSERT_EQUAL(0, Histogram::getBucketIndex(0));
+    CPPUNIT_ASSERT_EQUAL(1, Histogram::getBucketIndex(1));
+    CPPUNIT_ASSERT_EQUAL(2, Histogram::getBucketIndex(2));
+    CPPUNIT_ASSERT_EQUAL(2, Histogram::getBucketIndex(3));
+    CPPUNIT_ASSERT_EQUAL(3, Histogram::getBucketIndex(4));
+    CPPUNIT_ASSERT_EQUAL(10, Histogram::getBucketIndex(1000));
+    CPPUNIT_ASSERT_EQUAL(HistogramSnapshot::BUCKETS - 1, Histogram::getBucketIndex(1LL << 40));
+
+    for (int i = 0; i < HistogramSnapshot::BUCKETS - 1; ++i) {
+        long long bound = HistogramSnapshot::getBucketUpperBound(i);
+        CPPUNIT_ASSERT_EQUAL(i + 1, Histogram::getBucketIndex(bound));
+        CPPUNIT_ASSERT_EQUAL(i, Histogram::getBucketIndex(bound - 1));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void HistogramTest::testRecord() {
+
+    Histogram histogram;
+    HistogramSnapshot snapshot;
+
+    histogram.record(0);
+    histogram.record(3);
+    histogram.record(3);
+    histogram.record(1000);
+    histogram.record(-5);
+
+    histogram.snapshot(snapshot);
+
+    CPPUNIT_ASSERT_EQUAL(5LL, snapshot.count);
+    CPPUNIT_ASSERT_EQUAL(1006LL, snapshot.sum);
+    CPPUNIT_ASSERT_EQUAL(2LL, snapshot.buckets[0]);
+    CPPUNIT_ASSERT_EQUAL(2LL, snapshot.buckets[2]);
+    CPPUNIT_ASSERT_EQUAL(1LL, snapshot.buckets[10]);
+
+    histogram.reset();
+    histogram.snapshot(snapshot);
+
+    CPPUNIT_ASSERT_EQUAL(0LL, snapshot.count);
+    CPPUNIT_ASSERT_EQUAL(0LL, snapshot.sum);
+    CPPUNIT_ASSERT_EQUAL(0LL, snapshot.buckets[0]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void HistogramTest::testPercentile() {
+
+    Histogram histogram;
+    HistogramSnapshot snapshot;
+
+    for (int i = 0; i < 99; ++i) {
+        histogram.record(10);
+    }
+    histogram.record(5000);
+
+    histogram.snapshot(snapshot);
+
+    CPPUNIT_ASSERT_EQUAL(100LL, snapshot.count);
+    CPPUNIT_ASSERT_EQUAL(16LL, snapshot.getPercentile(50.0));
+    CPPUNIT_ASSERT_EQUAL(16LL, snapshot.getPercentile(99.0));
+    CPPUNIT_ASSERT_EQUAL(8192LL, snapshot.getPercentile(100.0));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(59.9, snapshot.getMean(), 0.001);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void HistogramTest::testConcurrentRecord() {
+
+    static const int THREADS = 8;
+    static const int COUNT = 10000;
+
+    Histogram histogram;
+    RecordTask task(&histogram, COUNT);
+
+    Thread* threads[THREADS];
+    for (int i = 0; i < THREADS; ++i) {
+        threads[i] = new Thread(&task);
+        threads[i]->start();
+    }
+
+    for (int i = 0; i < THREADS; ++i) {
+        threads[i]->join();
+        delete threads[i];
+    }
+
+    HistogramSnapshot snapshot;
+    histogram.snapshot(snapshot);
+
+    CPPUNIT_ASSERT_EQUAL((long long) THREADS * COUNT, snapshot.count);
+    CPPUNIT_ASSERT_EQUAL((long long) THREADS * (COUNT / 1000) * 499500, snapshot.sum);
+}
@@ -0,0 +1,179 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MessageTracerTest.h"
+
+#include <activemq/metrics/MessageTracer.h>
+#include <activemq/metrics/MessageTraceListener.h>
+
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/exceptions/RuntimeException.h>
+
+using namespace activemq;
+using namespace activemq::metrics;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class CountingListener : public MessageTraceListener {
+    public:
+
+        int count;
+        long long elapsed;
+        bool fail;
+
+    public:
+
+        CountingListener() : MessageTraceListener(), count(0), elapsed(0), fail(false) {}
+
+        virtual void onMessageTrace(const MessageTrace& trace) {
+            count++;
+            elapsed = trace.getElapsedTime();
+
+            if (fail) {
+                throw RuntimeException(__FILE__, __LINE__, "Listener failure");
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageTracerTest::testDisabled() {
+
+    MessageTracer tracer;
+    CPPUNIT_ASSERT(!tracer.isEnabled());
+    CPPUNIT_ASSERT_EQUAL(0, tracer.getSampleRate());
+    CPPUNIT_ASSERT(tracer.sample() == NULL);
+
+    tracer.setSampleRate(-5);
+    CPPUNIT_ASSERT(!tracer.isEnabled());
+    CPPUNIT_ASSERT_EQUAL(0, tracer.getSampleRate());
+    CPPUNIT_ASSERT(tracer.sample() == NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageTracerTest::testSampleRate() {
+
+    MessageTracer tracer;
+    tracer.setSampleRate(1);
+    CPPUNIT_ASSERT(tracer.isEnabled());
+
+    for (int i = 0; i < 10; ++i) {
+        CPPUNIT_ASSERT(tracer.sample() != NULL);
+    }
+
+    tracer.setSampleRate(4);
+
+    int sampled = 0;
+    for (int i = 0; i < 100; ++i) {
+        if (tracer.sample() != NULL) {
+            sampled++;
+        }
+    }
+
+    CPPUNIT_ASSERT_EQUAL(25, sampled);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageTracerTest::testMark() {
+
+    MessageTrace trace;
+    CPPUNIT_ASSERT_EQUAL(0LL, trace.getElapsedTime());
+
+    for (int stage = 0; stage < MessageTrace::STAGE_COUNT; ++stage) {
+        CPPUNIT_ASSERT(!trace.isMarked((MessageTrace::Stage) stage));
+    }
+
+    trace.mark(MessageTrace::PRODUCER_SEND);
+    Thread::sleep(2);
+    trace.mark(MessageTrace::TRANSPORT_SEND);
+
+    CPPUNIT_ASSERT(trace.isMarked(MessageTrace::PRODUCER_SEND));
+    CPPUNIT_ASSERT(!trace.isMarked(MessageTrace::SESSION_SEND));
+    CPPUNIT_ASSERT(trace.isMarked(MessageTrace::TRANSPORT_SEND));
+    CPPUNIT_ASSERT(trace.getTimestamp(MessageTrace::TRANSPORT_SEND) > trace.getTimestamp(MessageTrace::PRODUCER_SEND));
+    CPPUNIT_ASSERT(trace.getElapsedTime() >= 1000);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageTracerTest::testComplete() {
+
+    MessageTracer tracer;
+    tracer.setSampleRate(1);
+
+    Pointer<MessageTrace> trace = tracer.sample();
+    trace->mark(MessageTrace::TRANSPORT_RECEIVE);
+    trace->mark(MessageTrace::CONNECTION_DISPATCH);
+    Thread::sleep(2);
+    trace->mark(MessageTrace::CONSUMER_DELIVER);
+    tracer.complete(*trace);
+
+    std::vector<HistogramSnapshot> snapshot;
+    tracer.snapshot(snapshot);
+    CPPUNIT_ASSERT_EQUAL((std::size_t) MessageTrace::STAGE_COUNT, snapshot.size());
+
+    // The first marked stage has nothing to measure against, skipped stages record nothing.
+    CPPUNIT_ASSERT_EQUAL(0LL, snapshot[MessageTrace::TRANSPORT_RECEIVE].count);
+    CPPUNIT_ASSERT_EQUAL(1LL, snapshot[MessageTrace::CONNECTION_DISPATCH].count);
+    CPPUNIT_ASSERT_EQUAL(0LL, snapshot[MessageTrace::SESSION_DISPATCH].count);
+    CPPUNIT_ASSERT_EQUAL(1LL, snapshot[MessageTrace::CONSUMER_DELIVER].count);
+    CPPUNIT_ASSERT(snapshot[MessageTrace::CONSUMER_DELIVER].sum >= 1000);
+
+    tracer.reset();
+    tracer.snapshot(snapshot);
+    CPPUNIT_ASSERT_EQUAL(0LL, snapshot[MessageTrace::CONSUMER_DELIVER].count);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageTracerTest::testListener() {
+
+    CountingListener listener;
+
+    MessageTracer tracer;
+    tracer.setSampleRate(1);
+    tracer.setMessageTraceListener(&listener);
+    CPPUNIT_ASSERT(tracer.getMessageTraceListener() == &listener);
+
+    MessageTrace trace;
+    trace.mark(MessageTrace::PRODUCER_SEND);
+    Thread::sleep(1);
+    trace.mark(MessageTrace::TRANSPORT_SEND);
+
+    tracer.complete(trace);
+    CPPUNIT_ASSERT_EQUAL(1, listener.count);
+    CPPUNIT_ASSERT_EQUAL(trace.getElapsedTime(), listener.elapsed);
+
+    listener.fail = true;
+    CPPUNIT_ASSERT_NO_THROW(tracer.complete(trace));
+    CPPUNIT_ASSERT_EQUAL(2, listener.count);
+
+    tracer.setMessageTraceListener(NULL);
+    tracer.complete(trace);
+    CPPUNIT_ASSERT_EQUAL(2, listener.count);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageTracerTest::testStageNames() {
+
+    CPPUNIT_ASSERT_EQUAL(std::string("producerSend"), MessageTrace::getStageName(MessageTrace::PRODUCER_SEND));
+    CPPUNIT_ASSERT_EQUAL(std::string("consumerComplete"), MessageTrace::getStageName(MessageTrace::CONSUMER_COMPLETE));
+    CPPUNIT_ASSERT_EQUAL(std::string("unknown"), MessageTrace::getStageName(MessageTrace::STAGE_COUNT));
+    CPPUNIT_ASSERT_EQUAL(std::string("unknown"), MessageTrace::getStageName(-1));
+}
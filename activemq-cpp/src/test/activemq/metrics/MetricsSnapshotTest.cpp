@@ -0,0 +1,78 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MetricsSnapshotTest.h"
+
+#include <activemq/metrics/MetricsSnapshot.h>
+#include <activemq/metrics/ConnectionMetrics.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::metrics;
+
+////////////////////////////////////////////////////////////////////////////////
+void MetricsSnapshotTest::testHistogramSnapshot() {
+
+    HistogramSnapshot snapshot;
+
+    CPPUNIT_ASSERT_EQUAL((std::size_t) HistogramSnapshot::BUCKETS, snapshot.buckets.size());
+    CPPUNIT_ASSERT_EQUAL(0LL, snapshot.getPercentile(99.0));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, snapshot.getMean(), 0.0);
+
+    CPPUNIT_ASSERT_EQUAL(1LL, HistogramSnapshot::getBucketUpperBound(0));
+    CPPUNIT_ASSERT_EQUAL(1024LL, HistogramSnapshot::getBucketUpperBound(10));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MetricsSnapshotTest::testToJSON() {
+
+    ConnectionMetrics metrics;
+
+    metrics.getSyncRequests().add(3);
+    metrics.getInFlightRequests().increment();
+    metrics.getSyncRequestLatency().record(100);
+    metrics.getTransportMetrics()->getCommandsSent().add(7);
+
+    ConnectionMetricsSnapshot snapshot;
+    snapshot.connectionId = "ID:test\"1";
+    metrics.snapshot(snapshot);
+
+    CPPUNIT_ASSERT_EQUAL(3LL, snapshot.syncRequests);
+    CPPUNIT_ASSERT_EQUAL(1, snapshot.inFlightRequests);
+    CPPUNIT_ASSERT_EQUAL(1LL, snapshot.syncRequestLatency.count);
+    CPPUNIT_ASSERT_EQUAL(7LL, snapshot.transport.commandsSent);
+
+    SessionMetricsSnapshot session;
+    session.sessionId = "ID:test:1";
+    session.acksSent = 2;
+    session.consumers.push_back(ConsumerMetricsSnapshot());
+    session.consumers.back().consumerId = "ID:test:1:1";
+    session.consumers.back().prefetchOccupancy = 5;
+    snapshot.sessions.push_back(session);
+
+    std::string json = snapshot.toJSON();
+
+    CPPUNIT_ASSERT(json.find("{\"connectionId\":\"ID:test\\\"1\"") == 0);
+    CPPUNIT_ASSERT(json.find("\"syncRequests\":3") != std::string::npos);
+    CPPUNIT_ASSERT(json.find("\"inFlightRequests\":1") != std::string::npos);
+    CPPUNIT_ASSERT(json.find("\"commandsSent\":7") != std::string::npos);
+    CPPUNIT_ASSERT(json.find("\"sessionId\":\"ID:test:1\"") != std::string::npos);
+    CPPUNIT_ASSERT(json.find("\"acksSent\":2") != std::string::npos);
+    CPPUNIT_ASSERT(json.find("\"prefetchOccupancy\":5") != std::string::npos);
+    CPPUNIT_ASSERT(json.find("\"producers\":[]") != std::string::npos);
+    CPPUNIT_ASSERT_EQUAL('}', json[json.size() - 1]);
+}
@@ -53,6 +53,7 @@ namespace {
         LinkedList< Pointer<Command> > consumers;
         LinkedList< Pointer<Command> > messages;
         LinkedList< Pointer<Command> > messagePulls;
+        LinkedList< Pointer<Command> > responseRequired;
 
     public:
 
@@ -65,6 +66,10 @@ namespace {
         virtual void close() {}
 
         virtual void oneway(const Pointer<Command> command) {
+            if (command->isResponseRequired()) {
+                responseRequired.add(command);
+            }
+
             if (command->isConnectionInfo()) {
                 connections.add(command);
             } else if (command->isSessionInfo()) {
@@ -266,3 +271,86 @@ void ConnectionStateTrackerTest::testMessagePullCache() {
 
     CPPUNIT_ASSERT_EQUAL_MESSAGE("Should only be three message pulls", 10, transport->messagePulls.size());
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void ConnectionStateTrackerTest::testRestoreCommandCount() {
+
+    Pointer<TrackingTransport> transport(new TrackingTransport);
+    ConnectionStateTracker tracker;
+    tracker.setTrackMessages(true);
+
+    // The tracker keeps copies so the consumer has to be tracked again with the flag set
+    ConnectionData conn = createConnectionState(tracker);
+    conn.consumer->setResponseRequired(true);
+    tracker.processConsumerInfo(conn.consumer.get());
+
+    for (int i = 0; i < 3; ++i) {
+        decaf::lang::Pointer<commands::MessageId> id(new commands::MessageId());
+        id->setProducerId(conn.producer->getProducerId());
+        id->setProducerSequenceId(i + 1);
+        Pointer<Message> message(new Message);
+        message->setMessageId(id);
+
+        tracker.processMessage(message.get());
+        tracker.trackBack(message);
+    }
+
+    tracker.restore(transport);
+
+    CPPUNIT_ASSERT_EQUAL(7, tracker.getLastRestoreCommandCount());
+    CPPUNIT_ASSERT(tracker.getLastRestoreDuration() >= 0);
+    CPPUNIT_ASSERT_EQUAL(3, transport->messages.size());
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Original response flags should be kept",
+                                 1, transport->responseRequired.size());
+    CPPUNIT_ASSERT(transport->responseRequired.getFirst()->isConsumerInfo());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ConnectionStateTrackerTest::testRestoreSyncBarriers() {
+
+    Pointer<TrackingTransport> transport(new TrackingTransport);
+    ConnectionStateTracker tracker;
+    tracker.setTrackMessages(true);
+    tracker.setRestoreSyncInterval(3);
+
+    ConnectionData conn = createConnectionState(tracker);
+    conn.consumer->setResponseRequired(true);
+    tracker.processConsumerInfo(conn.consumer.get());
+
+    for (int i = 0; i < 3; ++i) {
+        decaf::lang::Pointer<commands::MessageId> id(new commands::MessageId());
+        id->setProducerId(conn.producer->getProducerId());
+        id->setProducerSequenceId(i + 1);
+        Pointer<Message> message(new Message);
+        message->setMessageId(id);
+
+        tracker.processMessage(message.get());
+        tracker.trackBack(message);
+    }
+
+    tracker.restore(transport);
+
+    CPPUNIT_ASSERT_EQUAL(7, tracker.getLastRestoreCommandCount());
+
+    // connection, session, producer, consumer then messages, barriers at the 3rd and 6th,
+    // the consumer keeps the response it originally asked for
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Sync barriers and original requests should require a response",
+                                 3, transport->responseRequired.size());
+    CPPUNIT_ASSERT(transport->responseRequired.get(0)->isProducerInfo());
+    CPPUNIT_ASSERT(transport->responseRequired.get(1)->isConsumerInfo());
+    CPPUNIT_ASSERT(transport->responseRequired.get(2)->isMessage());
+
+    // The tracked commands must keep their original flags, a restore without barriers
+    // should only see the consumer's request for a response
+    tracker.setRestoreSyncInterval(0);
+    Pointer<TrackingTransport> transport2(new TrackingTransport);
+    tracker.restore(transport2);
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Original response flags should survive a restore",
+                                 1, transport2->responseRequired.size());
+    CPPUNIT_ASSERT(transport2->responseRequired.getFirst()->isConsumerInfo());
+
+    tracker.setRestoreSyncInterval(-1);
+    CPPUNIT_ASSERT_EQUAL(0, tracker.getRestoreSyncInterval());
+}
@@ -30,6 +30,8 @@ namespace state {
         CPPUNIT_TEST( test );
         CPPUNIT_TEST( testMessageCache );
         CPPUNIT_TEST( testMessagePullCache );
+        CPPUNIT_TEST( testRestoreCommandCount );
+        CPPUNIT_TEST( testRestoreSyncBarriers );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -40,6 +42,8 @@ namespace state {
         void test();
         void testMessageCache();
         void testMessagePullCache();
+        void testRestoreCommandCount();
+        void testRestoreSyncBarriers();
 
     };
 
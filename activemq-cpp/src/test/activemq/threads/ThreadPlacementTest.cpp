@@ -0,0 +1,136 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ThreadPlacementTest.h"
+
+#include <activemq/threads/ThreadPlacement.h>
+
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/lang/exceptions/UnsupportedOperationException.h>
+
+using namespace activemq;
+using namespace activemq::threads;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class NoOpRunnable : public Runnable {
+    public:
+
+        virtual ~NoOpRunnable() {}
+
+        virtual void run() {}
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ThreadPlacementTest::testParseEmpty() {
+
+    ThreadPlacement placement = ThreadPlacement::parse("");
+
+    CPPUNIT_ASSERT(placement.isEmpty());
+    CPPUNIT_ASSERT(placement.getProcessors().empty());
+    CPPUNIT_ASSERT_EQUAL(-1, placement.getNumaNode());
+    CPPUNIT_ASSERT_EQUAL(std::string(""), placement.toString());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ThreadPlacementTest::testParseProcessorList() {
+
+    ThreadPlacement placement = ThreadPlacement::parse("6,0,2-4,3");
+
+    CPPUNIT_ASSERT(!placement.isEmpty());
+    CPPUNIT_ASSERT_EQUAL(-1, placement.getNumaNode());
+    CPPUNIT_ASSERT_EQUAL((std::size_t)5, placement.getProcessors().size());
+    CPPUNIT_ASSERT_EQUAL(0, placement.getProcessors()[0]);
+    CPPUNIT_ASSERT_EQUAL(2, placement.getProcessors()[1]);
+    CPPUNIT_ASSERT_EQUAL(3, placement.getProcessors()[2]);
+    CPPUNIT_ASSERT_EQUAL(4, placement.getProcessors()[3]);
+    CPPUNIT_ASSERT_EQUAL(6, placement.getProcessors()[4]);
+    CPPUNIT_ASSERT_EQUAL(std::string("0,2,3,4,6"), placement.toString());
+
+    ThreadPlacement single = ThreadPlacement::parse("1");
+    CPPUNIT_ASSERT_EQUAL((std::size_t)1, single.getProcessors().size());
+    CPPUNIT_ASSERT_EQUAL(1, single.getProcessors()[0]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ThreadPlacementTest::testParseNumaNode() {
+
+    ThreadPlacement placement = ThreadPlacement::parse("node:1");
+
+    CPPUNIT_ASSERT(!placement.isEmpty());
+    CPPUNIT_ASSERT(placement.getProcessors().empty());
+    CPPUNIT_ASSERT_EQUAL(1, placement.getNumaNode());
+    CPPUNIT_ASSERT_EQUAL(std::string("node:1"), placement.toString());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ThreadPlacementTest::testParseInvalid() {
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        ThreadPlacement::parse("a,b"),
+        IllegalArgumentException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        ThreadPlacement::parse("4-2"),
+        IllegalArgumentException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        ThreadPlacement::parse("node:x"),
+        IllegalArgumentException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        ThreadPlacement::parse(","),
+        IllegalArgumentException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ThreadPlacementTest::testApplyTo() {
+
+    NoOpRunnable runnable;
+    Thread thread(&runnable);
+
+    CPPUNIT_ASSERT(!ThreadPlacement().applyTo(&thread));
+
+    std::vector<int> available;
+    try {
+        available = thread.getAffinity();
+    } catch (UnsupportedOperationException& ex) {
+        CPPUNIT_ASSERT(!ThreadPlacement::parse("0").applyTo(&thread));
+        return;
+    }
+
+    ThreadPlacement placement = ThreadPlacement::parse(Integer::toString(available.front()));
+    CPPUNIT_ASSERT(placement.applyTo(&thread));
+    CPPUNIT_ASSERT_EQUAL((std::size_t)1, thread.getAffinity().size());
+
+    // A node that doesn't exist is ignored like any other placement that can't be applied.
+    CPPUNIT_ASSERT(!ThreadPlacement::parse("node:65535").applyTo(&thread));
+
+    thread.start();
+    thread.join();
+}
@@ -297,6 +297,49 @@ void IOTransportTest::testRead(){
     transport.close();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void IOTransportTest::testReadBusyPoll(){
+
+    decaf::io::BlockingByteArrayInputStream is;
+    decaf::io::ByteArrayOutputStream os;
+    decaf::io::DataInputStream input( &is );
+    decaf::io::DataOutputStream output( &os );
+
+    Pointer<MyWireFormat> wireFormat( new MyWireFormat() );
+    MyTransportListener listener(10);
+    IOTransport transport;
+    transport.setInputStream( &input );
+    transport.setOutputStream( &output );
+    transport.setTransportListener( &listener );
+    transport.setWireFormat( wireFormat );
+    transport.setBusyPollTime( 500000 );
+
+    CPPUNIT_ASSERT_EQUAL( 500000LL, transport.getBusyPollTime() );
+
+    transport.start();
+
+    decaf::lang::Thread::sleep( 10 );
+
+    unsigned char buffer[10] = { '1', '2', '3', '4', '5', '6', '7', '8', '9', '0' };
+    try{
+        synchronized( &is ){
+            is.setByteArray( buffer, 10 );
+        }
+    }catch( decaf::lang::Exception& ex ){
+        ex.setMark( __FILE__, __LINE__ );
+    }
+
+    listener.await();
+
+    CPPUNIT_ASSERT( listener.str == "1234567890" );
+
+    // Every byte arrived well within the spin budget so none of the reads blocked.
+    CPPUNIT_ASSERT_EQUAL( 10LL, transport.getBusyPollSpinCount() );
+    CPPUNIT_ASSERT_EQUAL( 0LL, transport.getBusyPollWaitCount() );
+
+    transport.close();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void IOTransportTest::testWrite(){
 
@@ -342,6 +385,57 @@ void IOTransportTest::testWrite(){
     transport.close();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void IOTransportTest::testWriteBatch() {
+
+    decaf::io::BlockingByteArrayInputStream is;
+    decaf::io::ByteArrayOutputStream os;
+    decaf::io::BufferedOutputStream buffered(&os);
+    decaf::io::DataInputStream input(&is);
+    decaf::io::DataOutputStream output(&buffered);
+
+    Pointer<MyWireFormat> wireFormat(new MyWireFormat());
+    MyTransportListener listener;
+    IOTransport transport;
+    transport.setInputStream(&input);
+    transport.setOutputStream(&output);
+    transport.setTransportListener(&listener);
+    transport.setWireFormat(wireFormat);
+
+    transport.start();
+
+    Pointer<MyCommand> cmd(new MyCommand());
+
+    transport.beginBatch();
+    cmd->c = '1';
+    transport.oneway(cmd);
+
+    transport.beginBatch();
+    cmd->c = '2';
+    transport.oneway(cmd);
+    transport.endBatch();
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Nothing should be written while batching", 0, (int) os.size());
+
+    cmd->c = '3';
+    transport.oneway(cmd);
+    transport.endBatch();
+
+    std::pair<const unsigned char*, int> array = os.toByteArray();
+    CPPUNIT_ASSERT_EQUAL(3, array.second);
+    CPPUNIT_ASSERT(array.first[0] == '1');
+    CPPUNIT_ASSERT(array.first[1] == '2');
+    CPPUNIT_ASSERT(array.first[2] == '3');
+    delete [] array.first;
+
+    // Once the batch ends each oneway is flushed again.
+    cmd->c = '4';
+    transport.oneway(cmd);
+    CPPUNIT_ASSERT_EQUAL(4, (int) os.size());
+
+    transport.close();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void IOTransportTest::testException(){
 
@@ -0,0 +1,241 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "WireCaptureTest.h"
+
+#include <activemq/transport/capture/WireCapture.h>
+#include <activemq/transport/capture/WireCaptureDecoder.h>
+#include <activemq/transport/IOTransport.h>
+#include <activemq/wireformat/openwire/OpenWireFormat.h>
+#include <activemq/commands/KeepAliveInfo.h>
+#include <activemq/commands/Response.h>
+#include <activemq/commands/WireFormatInfo.h>
+
+#include <decaf/internal/io/MemoryMappedFile.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/lang/Long.h>
+#include <decaf/lang/Pointer.h>
+#include <decaf/util/Properties.h>
+
+#include <sstream>
+#include <vector>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::commands;
+using namespace activemq::transport;
+using namespace activemq::transport::capture;
+using namespace activemq::wireformat::openwire;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::util;
+using namespace decaf::internal::io;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    std::vector<unsigned char> toBytes(OpenWireFormat& format, Pointer<Command> command) {
+
+        IOTransport transport;
+        ByteArrayOutputStream bytes;
+        DataOutputStream out(&bytes);
+
+        format.marshal(command, &transport, &out);
+        out.flush();
+
+        std::pair<unsigned char*, int> array = bytes.toByteArray();
+        std::vector<unsigned char> result(array.first, array.first + array.second);
+        delete [] array.first;
+
+        return result;
+    }
+
+    std::string siblingFile(const std::string& current, long long sequence) {
+        return current.substr(0, current.rfind('.') + 1) + Long::toString(sequence);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+WireCaptureTest::WireCaptureTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+WireCaptureTest::~WireCaptureTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WireCaptureTest::testCaptureAndDecode() {
+
+    OpenWireFormat format((Properties()));
+
+    Pointer<WireFormatInfo> info(new WireFormatInfo());
+    info->setVersion(format.getVersion());
+    info->setTightEncodingEnabled(false);
+    info->setCacheEnabled(false);
+    info->setStackTraceEnabled(true);
+    info->setTcpNoDelayEnabled(true);
+    info->setSizePrefixDisabled(false);
+    info->setCacheSize(1024);
+    info->setMaxInactivityDuration(30000);
+    info->setMaxInactivityDurationInitalDelay(10000);
+
+    std::vector<unsigned char> infoBytes = toBytes(format, info);
+    std::vector<unsigned char> keepAliveBytes = toBytes(format, Pointer<Command>(new KeepAliveInfo()));
+
+    Pointer<Response> response(new Response());
+    response->setCorrelationId(42);
+    std::vector<unsigned char> responseBytes = toBytes(format, response);
+
+    WireCapture capture("wire-capture-test", 64 * 1024, 1024 * 1024, 2);
+    capture.start();
+
+    std::string fileName = capture.getCurrentFileName();
+    CPPUNIT_ASSERT( !fileName.empty() );
+
+    CPPUNIT_ASSERT( capture.record(WireCapture::SEND, &infoBytes[0], (int) infoBytes.size()) );
+    CPPUNIT_ASSERT( capture.record(WireCapture::RECEIVE, &infoBytes[0], (int) infoBytes.size()) );
+
+    // Split a frame across two records the way socket reads would.
+    int half = (int) keepAliveBytes.size() / 2;
+    CPPUNIT_ASSERT( capture.record(WireCapture::SEND, &keepAliveBytes[0], half) );
+    CPPUNIT_ASSERT( capture.record(WireCapture::SEND, &keepAliveBytes[half], (int) keepAliveBytes.size() - half) );
+    CPPUNIT_ASSERT( capture.record(WireCapture::RECEIVE, &responseBytes[0], (int) responseBytes.size()) );
+
+    capture.close();
+
+    CPPUNIT_ASSERT_EQUAL( 5LL, capture.getRecordCount() );
+    CPPUNIT_ASSERT_EQUAL( 0LL, capture.getDroppedCount() );
+    CPPUNIT_ASSERT( !capture.isFailed() );
+
+    WireCaptureDecoder decoder;
+    decoder.addFile(fileName);
+
+    std::ostringstream text;
+    CPPUNIT_ASSERT_EQUAL( 4, decoder.decode(text) );
+
+    std::string output = text.str();
+    CPPUNIT_ASSERT( output.find("SEND: WireFormatInfo") != std::string::npos );
+    CPPUNIT_ASSERT( output.find("RECV: WireFormatInfo") != std::string::npos );
+    CPPUNIT_ASSERT( output.find("SEND: KeepAliveInfo") != std::string::npos );
+    CPPUNIT_ASSERT( output.find("RECV: Response") != std::string::npos );
+
+    MemoryMappedFile::remove(fileName);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WireCaptureTest::testRotation() {
+
+    unsigned char data[100] = { 0 };
+
+    WireCapture capture("wire-capture-test", 64 * 1024, 256, 2);
+    capture.start();
+
+    for (int i = 0; i < 20; ++i) {
+        CPPUNIT_ASSERT( capture.record(WireCapture::SEND, data, sizeof(data)) );
+    }
+
+    capture.close();
+
+    CPPUNIT_ASSERT_EQUAL( 20LL, capture.getRecordCount() );
+
+    // Two records fit in each file so there were ten files, only the last two are kept.
+    std::string last = capture.getCurrentFileName();
+    CPPUNIT_ASSERT( last == siblingFile(last, 9) );
+
+    MemoryMappedFile file;
+    CPPUNIT_ASSERT_THROW( file.open(siblingFile(last, 7)), decaf::io::IOException );
+    file.open(siblingFile(last, 8));
+    CPPUNIT_ASSERT_EQUAL( (long long) (WireCapture::FILE_HEADER_SIZE + 2 * (WireCapture::RECORD_HEADER_SIZE + 100)),
+                          file.getLength() );
+    file.close();
+
+    CPPUNIT_ASSERT( MemoryMappedFile::remove(siblingFile(last, 8)) );
+    CPPUNIT_ASSERT( MemoryMappedFile::remove(last) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WireCaptureTest::testMaxFilesSharedByPrefix() {
+
+    unsigned char data[100] = { 0 };
+
+    // Two records fit in each file, the first capture leaves two files behind.
+    WireCapture first("wire-capture-shared-test", 64 * 1024, 256, 2);
+    first.start();
+    std::string firstFile = first.getCurrentFileName();
+    for (int i = 0; i < 4; ++i) {
+        CPPUNIT_ASSERT( first.record(WireCapture::SEND, data, sizeof(data)) );
+    }
+    first.close();
+
+    std::string firstLast = first.getCurrentFileName();
+    CPPUNIT_ASSERT( firstLast == siblingFile(firstFile, 1) );
+
+    // As a reconnect would, a second capture with the same prefix counts the files
+    // the first one left towards its own limit and deletes the oldest of them.
+    WireCapture second("wire-capture-shared-test", 64 * 1024, 256, 2);
+    second.start();
+    second.close();
+
+    MemoryMappedFile file;
+    CPPUNIT_ASSERT_THROW( file.open(firstFile), decaf::io::IOException );
+
+    CPPUNIT_ASSERT( MemoryMappedFile::remove(firstLast) );
+    CPPUNIT_ASSERT( MemoryMappedFile::remove(second.getCurrentFileName()) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WireCaptureTest::testDropWhenRingFull() {
+
+    std::vector<unsigned char> data(2048, 0);
+
+    WireCapture capture("wire-capture-test", 1024, 64 * 1024, 1);
+    capture.start();
+
+    CPPUNIT_ASSERT( !capture.record(WireCapture::RECEIVE, &data[0], (int) data.size()) );
+    CPPUNIT_ASSERT( capture.record(WireCapture::RECEIVE, &data[0], 100) );
+
+    capture.close();
+
+    CPPUNIT_ASSERT_EQUAL( 1LL, capture.getDroppedCount() );
+    CPPUNIT_ASSERT_EQUAL( 1LL, capture.getRecordCount() );
+
+    // The record after the dropped one carries the gap flag.
+    MemoryMappedFile file;
+    file.open(capture.getCurrentFileName());
+    CPPUNIT_ASSERT( (file.getBuffer()[WireCapture::FILE_HEADER_SIZE] & WireCapture::GAP) != 0 );
+    file.close();
+
+    MemoryMappedFile::remove(capture.getCurrentFileName());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WireCaptureTest::testNotRecordingUntilStarted() {
+
+    unsigned char data[10] = { 0 };
+
+    WireCapture capture("wire-capture-test", 1024, 64 * 1024, 1);
+
+    CPPUNIT_ASSERT( !capture.record(WireCapture::SEND, data, sizeof(data)) );
+    CPPUNIT_ASSERT( capture.getCurrentFileName().empty() );
+
+    capture.close();
+
+    CPPUNIT_ASSERT( !capture.record(WireCapture::SEND, data, sizeof(data)) );
+    CPPUNIT_ASSERT_EQUAL( 0LL, capture.getRecordCount() );
+}
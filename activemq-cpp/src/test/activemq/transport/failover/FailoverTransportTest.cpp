@@ -24,8 +24,11 @@
 #include <activemq/commands/ActiveMQMessage.h>
 #include <activemq/commands/ConnectionControl.h>
 #include <activemq/mock/MockBrokerService.h>
+#include <decaf/lang/Integer.h>
 #include <decaf/lang/Pointer.h>
 #include <decaf/lang/Thread.h>
+#include <decaf/net/ServerSocket.h>
+#include <decaf/net/Socket.h>
 #include <decaf/util/UUID.h>
 
 using namespace activemq;
@@ -37,6 +40,7 @@ using namespace activemq::transport::mock;
 using namespace activemq::exceptions;
 using namespace decaf::io;
 using namespace decaf::lang;
+using namespace decaf::net;
 using namespace decaf::util;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -710,3 +714,97 @@ void FailoverTransportTest::testConnectedToMockBroker() {
     broker1.stop();
     broker1.waitUntilStopped();
 }
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    /**
+     * A listener that never accepts, once its backlog has been filled the kernel drops
+     * any further connection requests so a connect to it hangs until it times out.
+     */
+    class BlackholeListener {
+    private:
+
+        ServerSocket server;
+        std::vector<Socket*> fillers;
+
+    private:
+
+        BlackholeListener(const BlackholeListener&);
+        BlackholeListener& operator= (const BlackholeListener&);
+
+    public:
+
+        BlackholeListener() : server(0, 1), fillers() {
+            for (int i = 0; i < 4; ++i) {
+                Socket* socket = new Socket();
+                fillers.push_back(socket);
+                try {
+                    socket->connect("127.0.0.1", server.getLocalPort(), 250);
+                } catch (Exception& ex) {
+                }
+            }
+        }
+
+        ~BlackholeListener() {
+            for (std::size_t i = 0; i < fillers.size(); ++i) {
+                try {
+                    fillers[i]->close();
+                } catch (Exception& ex) {
+                }
+                delete fillers[i];
+            }
+            server.close();
+        }
+
+        int getPort() const {
+            return server.getLocalPort();
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransportTest::testParallelConnectPastBlackholedBroker() {
+
+    BlackholeListener blackhole;
+    MockBrokerService broker(61619);
+
+    broker.start();
+    broker.waitUntilStarted();
+
+    std::string uri = "failover://(tcp://127.0.0.1:" + Integer::toString(blackhole.getPort()) +
+                      ",tcp://127.0.0.1:61619)?randomize=false&parallelConnect=true"
+                      "&parallelConnectDelay=100&parallelConnectTimeout=10000";
+
+    DefaultTransportListener listener;
+    FailoverTransportFactory factory;
+
+    Pointer<Transport> transport(factory.create(uri));
+    CPPUNIT_ASSERT(transport != NULL);
+    transport->setTransportListener(&listener);
+
+    FailoverTransport* failover = dynamic_cast<FailoverTransport*>(
+        transport->narrow(typeid(FailoverTransport)));
+
+    CPPUNIT_ASSERT(failover != NULL);
+    CPPUNIT_ASSERT(failover->isParallelConnect() == true);
+    CPPUNIT_ASSERT_EQUAL(100LL, failover->getParallelConnectDelay());
+    CPPUNIT_ASSERT_EQUAL(10000LL, failover->getParallelConnectTimeout());
+
+    transport->start();
+
+    // Connecting to the blackholed broker would take the full ten second timeout.
+    int count = 0;
+    while (!failover->isConnected() && count++ < 25) {
+        Thread::sleep(200);
+    }
+    CPPUNIT_ASSERT(failover->isConnected() == true);
+    CPPUNIT_ASSERT_EQUAL(1, failover->getReconnectCount());
+    CPPUNIT_ASSERT(failover->getLastReconnectDuration() < 5000);
+    CPPUNIT_ASSERT(failover->getMaxReconnectDuration() == failover->getLastReconnectDuration());
+
+    transport->close();
+
+    broker.stop();
+    broker.waitUntilStopped();
+}
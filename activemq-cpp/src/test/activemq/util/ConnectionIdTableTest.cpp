@@ -0,0 +1,231 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ConnectionIdTableTest.h"
+
+#include <activemq/util/CompactId.h>
+#include <activemq/util/ConnectionIdTable.h>
+#include <activemq/util/IdGenerator.h>
+#include <activemq/commands/ConsumerId.h>
+#include <activemq/commands/MessageId.h>
+#include <activemq/commands/ProducerId.h>
+#include <activemq/commands/SessionId.h>
+
+#include <decaf/lang/Integer.h>
+#include <decaf/util/HashMap.h>
+#include <decaf/util/StlMap.h>
+
+using namespace activemq;
+using namespace activemq::util;
+using namespace activemq::commands;
+using namespace decaf;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+ConnectionIdTableTest::ConnectionIdTableTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ConnectionIdTableTest::~ConnectionIdTableTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ConnectionIdTableTest::testIntern() {
+
+    IdGenerator idGen;
+
+    std::string id1 = idGen.generateId();
+    std::string id2 = idGen.generateId();
+
+    int size = ConnectionIdTable::size();
+
+    ConnectionKey entry1 = ConnectionIdTable::intern(id1);
+    ConnectionKey entry2 = ConnectionIdTable::intern(id2);
+
+    CPPUNIT_ASSERT_EQUAL(size + 2, ConnectionIdTable::size());
+    CPPUNIT_ASSERT(entry1 == ConnectionIdTable::intern(std::string(id1)));
+    CPPUNIT_ASSERT_EQUAL(size + 2, ConnectionIdTable::size());
+
+    CPPUNIT_ASSERT_EQUAL(id1, entry1->getConnectionId());
+    CPPUNIT_ASSERT(entry1->getIndex() >= 0);
+    CPPUNIT_ASSERT(entry1->getIndex() != entry2->getIndex());
+
+    CPPUNIT_ASSERT(entry1->equals(*entry1));
+    CPPUNIT_ASSERT(!entry1->equals(*entry2));
+    CPPUNIT_ASSERT(entry1->compareTo(*entry2) != 0);
+    CPPUNIT_ASSERT_EQUAL(entry1->compareTo(*entry2) < 0, entry2->compareTo(*entry1) > 0);
+
+    // An entry orders the same against interned and standalone entries.
+    ConnectionIdTable::Entry standalone(id1, -1, 0);
+    CPPUNIT_ASSERT_EQUAL(0, standalone.compareTo(*entry1));
+    CPPUNIT_ASSERT_EQUAL(entry1->compareTo(*entry2) < 0, standalone.compareTo(*entry2) < 0);
+
+    CPPUNIT_ASSERT(ConnectionIdTable::intern("") == NULL);
+    CPPUNIT_ASSERT_EQUAL(size + 2, ConnectionIdTable::size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ConnectionIdTableTest::testEviction() {
+
+    IdGenerator idGen;
+
+    std::string connectionId = idGen.generateId();
+
+    int size = ConnectionIdTable::size();
+
+    ConnectionKey key1 = ConnectionIdTable::intern(connectionId);
+    ConnectionKey key2 = key1;
+    CPPUNIT_ASSERT_EQUAL(size + 1, ConnectionIdTable::size());
+
+    key1.reset();
+    CPPUNIT_ASSERT(key1 == NULL);
+    CPPUNIT_ASSERT_EQUAL(size + 1, ConnectionIdTable::size());
+
+    key2.reset();
+    CPPUNIT_ASSERT_EQUAL(size, ConnectionIdTable::size());
+
+    {
+        ProducerId producerId(connectionId + ":1:1");
+        ConsumerId consumerId(*producerId.getParentId(), 1);
+        CPPUNIT_ASSERT(consumerId.getConnectionKey() == producerId.getConnectionKey());
+        CPPUNIT_ASSERT_EQUAL(size + 1, ConnectionIdTable::size());
+
+        producerId.setConnectionId(idGen.generateId());
+        CPPUNIT_ASSERT_EQUAL(size + 2, ConnectionIdTable::size());
+    }
+
+    CPPUNIT_ASSERT_EQUAL(size, ConnectionIdTable::size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ConnectionIdTableTest::testStandaloneEntries() {
+
+    ConnectionKey interned = ConnectionIdTable::intern("ID:standalone-1");
+
+    ConnectionIdTable::Entry entry1("ID:standalone-1", -1, 0);
+    ConnectionIdTable::Entry entry2("ID:standalone-1", -1, 0);
+    ConnectionIdTable::Entry entry3("ID:standalone-2", -1, 0);
+
+    CPPUNIT_ASSERT(entry1.equals(entry2));
+    CPPUNIT_ASSERT_EQUAL(0, entry1.compareTo(entry2));
+    CPPUNIT_ASSERT_EQUAL(entry1.getHashCode(), entry2.getHashCode());
+    CPPUNIT_ASSERT(!entry1.equals(entry3));
+    CPPUNIT_ASSERT(entry1.compareTo(entry3) != 0);
+    CPPUNIT_ASSERT_EQUAL(entry1.compareTo(entry3) < 0, entry3.compareTo(entry1) > 0);
+
+    CPPUNIT_ASSERT(interned->equals(entry1));
+    CPPUNIT_ASSERT(entry1.equals(*interned));
+    CPPUNIT_ASSERT_EQUAL(interned->getHashCode(), entry1.getHashCode());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ConnectionIdTableTest::testProducerIdKey() {
+
+    IdGenerator idGen;
+
+    std::string connectionId = idGen.generateId();
+
+    ProducerId producerId1(connectionId + ":1:2");
+    ProducerId producerId2(connectionId + ":1:2");
+    ProducerId producerId3(connectionId + ":1:3");
+
+    CPPUNIT_ASSERT(producerId1.getConnectionKey() == producerId2.getConnectionKey());
+    CPPUNIT_ASSERT(producerId1.getCompactId() == producerId2.getCompactId());
+    CPPUNIT_ASSERT_EQUAL(producerId1.getHashCode(), producerId2.getHashCode());
+    CPPUNIT_ASSERT(!(producerId1.getCompactId() == producerId3.getCompactId()));
+    CPPUNIT_ASSERT(producerId1.getCompactId() < producerId3.getCompactId());
+    CPPUNIT_ASSERT(producerId1.compareTo(producerId3) < 0);
+
+    ProducerId copy(producerId1);
+    CPPUNIT_ASSERT(copy.getConnectionKey() == producerId1.getConnectionKey());
+    CPPUNIT_ASSERT_EQUAL(0, copy.compareTo(producerId1));
+
+    copy.setConnectionId(idGen.generateId());
+    CPPUNIT_ASSERT(copy.getConnectionKey() != producerId1.getConnectionKey());
+    CPPUNIT_ASSERT(copy.compareTo(producerId1) != 0);
+    CPPUNIT_ASSERT(!(copy.getCompactId() == producerId1.getCompactId()));
+
+    SessionId sessionId(&producerId1);
+    ProducerId child(sessionId, 2);
+    CPPUNIT_ASSERT(sessionId.getConnectionKey() == producerId1.getConnectionKey());
+    CPPUNIT_ASSERT(child.getConnectionKey() == producerId1.getConnectionKey());
+    CPPUNIT_ASSERT(child.equals(producerId1));
+    CPPUNIT_ASSERT_EQUAL(child.getHashCode(), producerId1.getHashCode());
+
+    CPPUNIT_ASSERT_EQUAL(connectionId + ":1:2", producerId1.toString());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ConnectionIdTableTest::testMessageIdKey() {
+
+    IdGenerator idGen;
+
+    std::string connectionId = idGen.generateId();
+
+    Pointer<ProducerId> producerId(new ProducerId(connectionId + ":1:1"));
+
+    MessageId messageId1(producerId, 5);
+    MessageId messageId2(connectionId + ":1:1:5");
+    MessageId messageId3(producerId, 6);
+
+    CPPUNIT_ASSERT(messageId1.getCompactId() == messageId2.getCompactId());
+    CPPUNIT_ASSERT_EQUAL(messageId1.getHashCode(), messageId2.getHashCode());
+    CPPUNIT_ASSERT_EQUAL(5LL, messageId1.getCompactId().getSequenceId());
+    CPPUNIT_ASSERT(!(messageId1.getCompactId() == messageId3.getCompactId()));
+    CPPUNIT_ASSERT(messageId1.getCompactId() < messageId3.getCompactId());
+
+    CPPUNIT_ASSERT_EQUAL(connectionId + ":1:1:5", messageId1.toString());
+
+    MessageId empty;
+    CPPUNIT_ASSERT(empty.getCompactId().getConnection() == NULL);
+    CPPUNIT_ASSERT(empty.getCompactId() == MessageId().getCompactId());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ConnectionIdTableTest::testCompactIdAsMapKey() {
+
+    IdGenerator idGen;
+
+    std::string connectionId1 = idGen.generateId();
+    std::string connectionId2 = idGen.generateId();
+
+    decaf::util::HashMap<CompactId, int> hashMap;
+    decaf::util::StlMap<CompactId, int> stlMap;
+
+    for (int i = 0; i < 10; ++i) {
+        MessageId messageId1(connectionId1 + ":1:1", i);
+        MessageId messageId2(connectionId2 + ":1:1", i);
+
+        hashMap.put(messageId1.getCompactId(), i);
+        hashMap.put(messageId2.getCompactId(), i + 10);
+        stlMap.put(messageId1.getCompactId(), i);
+        stlMap.put(messageId2.getCompactId(), i + 10);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(20, hashMap.size());
+    CPPUNIT_ASSERT_EQUAL(20, stlMap.size());
+
+    for (int i = 0; i < 10; ++i) {
+        MessageId messageId1(connectionId1 + ":1:1:" + decaf::lang::Integer::toString(i));
+        MessageId messageId2(connectionId2 + ":1:1:" + decaf::lang::Integer::toString(i));
+
+        CPPUNIT_ASSERT_EQUAL(i, hashMap.get(messageId1.getCompactId()));
+        CPPUNIT_ASSERT_EQUAL(i + 10, hashMap.get(messageId2.getCompactId()));
+        CPPUNIT_ASSERT_EQUAL(i, stlMap.get(messageId1.getCompactId()));
+        CPPUNIT_ASSERT_EQUAL(i + 10, stlMap.get(messageId2.getCompactId()));
+    }
+}
@@ -21,10 +21,16 @@
 #include <decaf/lang/Runnable.h>
 #include <decaf/lang/System.h>
 #include <decaf/lang/Thread.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/Concurrent.h>
+
+#include <vector>
 
 using namespace activemq;
 using namespace activemq::util;
 using namespace decaf::lang;
+using namespace decaf::util::concurrent;
 
 ////////////////////////////////////////////////////////////////////////////////
 namespace {
@@ -48,6 +54,32 @@ namespace {
             this->usage->decreaseUsage(this->usage->getUsage());
         }
     };
+
+    class OrderedWaiter : public decaf::lang::Runnable {
+    private:
+
+        OrderedWaiter(const OrderedWaiter&);
+        OrderedWaiter& operator= (const OrderedWaiter&);
+
+    private:
+
+        MemoryUsage* usage;
+        int id;
+        Mutex* mutex;
+        std::vector<int>* order;
+
+    public:
+
+        OrderedWaiter(MemoryUsage* usage, int id, Mutex* mutex, std::vector<int>* order) :
+            usage(usage), id(id), mutex(mutex), order(order) {}
+
+        virtual void run() {
+            this->usage->enqueueUsage(1024);
+            synchronized(mutex) {
+                order->push_back(id);
+            }
+        }
+    };
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -121,3 +153,108 @@ void MemoryUsageTest::testWait() {
 
     myThread.join();
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryUsageTest::testTryEnqueueUsage() {
+
+    MemoryUsage usage( 2048 );
+
+    CPPUNIT_ASSERT( usage.tryEnqueueUsage( 1024 ) );
+    CPPUNIT_ASSERT( usage.getUsage() == 1024 );
+    CPPUNIT_ASSERT( usage.tryEnqueueUsage( 1024 ) );
+    CPPUNIT_ASSERT( usage.getUsage() == 2048 );
+
+    CPPUNIT_ASSERT( usage.isFull() );
+    CPPUNIT_ASSERT( !usage.tryEnqueueUsage( 1024 ) );
+    CPPUNIT_ASSERT( usage.getUsage() == 2048 );
+
+    usage.decreaseUsage( 1 );
+    CPPUNIT_ASSERT( usage.tryEnqueueUsage( 1024 ) );
+    CPPUNIT_ASSERT( usage.getUsage() == 3071 );
+
+    CPPUNIT_ASSERT( usage.getBlockedCount() == 0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryUsageTest::testSaturation() {
+
+    MemoryUsage usage( 1024 );
+
+    usage.increaseUsage( (unsigned long long) Integer::MAX_VALUE * 4 );
+    CPPUNIT_ASSERT( usage.getUsage() == (unsigned long long) Integer::MAX_VALUE );
+
+    usage.increaseUsage( 1024 );
+    CPPUNIT_ASSERT( usage.getUsage() == (unsigned long long) Integer::MAX_VALUE );
+
+    usage.decreaseUsage( (unsigned long long) Integer::MAX_VALUE * 4 );
+    CPPUNIT_ASSERT( usage.getUsage() == 0 );
+    CPPUNIT_ASSERT( !usage.isFull() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryUsageTest::testFifoWakeup() {
+
+    const int COUNT = 4;
+
+    MemoryUsage usage( 1024 );
+    usage.increaseUsage( 1024 );
+
+    Mutex mutex;
+    std::vector<int> order;
+    std::vector<OrderedWaiter*> waiters;
+    std::vector<Thread*> threads;
+
+    for( int i = 0; i < COUNT; ++i ) {
+        waiters.push_back( new OrderedWaiter( &usage, i, &mutex, &order ) );
+        threads.push_back( new Thread( waiters.back() ) );
+        threads.back()->start();
+
+        // Let each thread queue up before the next one starts.
+        Thread::sleep( 50 );
+    }
+
+    // Each release of space lets exactly one waiter through, in arrival order.
+    for( int i = 0; i < COUNT; ++i ) {
+        usage.decreaseUsage( 1024 );
+
+        while( true ) {
+            bool done = false;
+            synchronized( &mutex ) {
+                done = (int) order.size() == i + 1;
+            }
+            if( done ) {
+                break;
+            }
+            Thread::sleep( 1 );
+        }
+    }
+
+    for( int i = 0; i < COUNT; ++i ) {
+        threads[i]->join();
+        delete threads[i];
+        delete waiters[i];
+        CPPUNIT_ASSERT_EQUAL( i, order[i] );
+    }
+
+    CPPUNIT_ASSERT( !usage.hasWaiters() );
+    CPPUNIT_ASSERT( usage.getBlockedCount() == COUNT );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryUsageTest::testBlockedStatistics() {
+
+    MemoryUsage usage( 2048 );
+    CPPUNIT_ASSERT( usage.getBlockedCount() == 0 );
+    CPPUNIT_ASSERT( usage.getBlockedTime() == 0 );
+
+    // No time is recorded when there is space.
+    usage.waitForSpace( 100 );
+    CPPUNIT_ASSERT( usage.getBlockedCount() == 0 );
+
+    usage.increaseUsage( 4096 );
+    usage.waitForSpace( 50 );
+
+    CPPUNIT_ASSERT( usage.getBlockedCount() == 1 );
+    CPPUNIT_ASSERT( usage.getBlockedTime() >= 40000 );
+    CPPUNIT_ASSERT( !usage.hasWaiters() );
+}
@@ -31,6 +31,10 @@ namespace util {
         CPPUNIT_TEST( testUsage );
         CPPUNIT_TEST( testTimedWait );
         CPPUNIT_TEST( testWait );
+        CPPUNIT_TEST( testTryEnqueueUsage );
+        CPPUNIT_TEST( testSaturation );
+        CPPUNIT_TEST( testFifoWakeup );
+        CPPUNIT_TEST( testBlockedStatistics );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -42,6 +46,10 @@ namespace util {
         void testUsage();
         void testTimedWait();
         void testWait();
+        void testTryEnqueueUsage();
+        void testSaturation();
+        void testFifoWakeup();
+        void testBlockedStatistics();
 
     };
 
@@ -18,7 +18,20 @@
 #include "OpenWireFormatTest.h"
 
 #include <decaf/util/Properties.h>
+#include <decaf/io/ByteArrayInputStream.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataInputStream.h>
+#include <decaf/io/DataOutputStream.h>
 #include <activemq/wireformat/openwire/OpenWireFormat.h>
+#include <activemq/wireformat/openwire/utils/FrameOutputStream.h>
+#include <activemq/commands/ActiveMQBytesMessage.h>
+#include <activemq/commands/MessageId.h>
+#include <activemq/commands/ProducerId.h>
+#include <activemq/transport/IOTransport.h>
+#include <activemq/util/ConnectionIdTable.h>
+#include <decaf/internal/io/MemoryMappedFile.h>
+
+#include <vector>
 
 using namespace std;
 using namespace activemq;
@@ -27,8 +40,12 @@ using namespace decaf::io;
 using namespace decaf::lang;
 using namespace decaf::util;
 using namespace activemq::exceptions;
+using namespace activemq::commands;
+using namespace activemq::transport;
 using namespace activemq::wireformat;
 using namespace activemq::wireformat::openwire;
+using namespace activemq::wireformat::openwire::utils;
+using namespace decaf::internal::io;
 
 ////////////////////////////////////////////////////////////////////////////////
 void OpenWireFormatTest::test()
@@ -36,3 +53,245 @@ void OpenWireFormatTest::test()
     Properties properties;
     //OpenWireFormat myWireFormat( properties );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    Pointer<ActiveMQBytesMessage> createMessage(int bodySize) {
+
+        Pointer<ProducerId> producerId(new ProducerId());
+        producerId->setConnectionId("ConnectionId");
+        producerId->setSessionId(1);
+        producerId->setValue(2);
+
+        Pointer<MessageId> messageId(new MessageId());
+        messageId->setProducerId(producerId);
+        messageId->setProducerSequenceId(bodySize);
+
+        std::vector<unsigned char> content(bodySize);
+        for (int i = 0; i < bodySize; ++i) {
+            content[i] = (unsigned char) i;
+        }
+
+        Pointer<ActiveMQBytesMessage> message(new ActiveMQBytesMessage());
+        message->setMessageId(messageId);
+        message->setContent(content);
+
+        return message;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::checkFrames(bool tightEncoding, int zeroCopyThreshold) {
+
+    Properties properties;
+    OpenWireFormat format(properties);
+    format.setTightEncodingEnabled(tightEncoding);
+    format.setZeroCopyThreshold(zeroCopyThreshold);
+
+    // Sizes on both sides of the retained frame buffer capacity, written back to
+    // back so that a frame left over in the buffer would corrupt the next one.
+    const int sizes[] = { 0, 16, FrameOutputStream::DEFAULT_RETAINED_CAPACITY + 1, 32 };
+    const int count = (int) (sizeof(sizes) / sizeof(int));
+
+    IOTransport transport;
+    ByteArrayOutputStream bytes;
+    DataOutputStream out(&bytes);
+
+    std::vector<long long> frameEnds;
+    for (int i = 0; i < count; ++i) {
+        format.marshal(createMessage(sizes[i]), &transport, &out);
+        frameEnds.push_back(out.size());
+    }
+
+    std::pair<unsigned char*, int> array = bytes.toByteArray();
+    ByteArrayInputStream bais(array.first, array.second, true);
+    DataInputStream in(&bais);
+
+    long long frameStart = 0;
+    for (int i = 0; i < count; ++i) {
+
+        // Each size prefix must match the bytes that follow it.
+        in.mark(4);
+        int size = in.readInt();
+        in.reset();
+        CPPUNIT_ASSERT_EQUAL(frameEnds[i] - frameStart - 4, (long long) size);
+        frameStart = frameEnds[i];
+
+        Pointer<Command> command = format.unmarshal(&transport, &in);
+        Pointer<ActiveMQBytesMessage> message = command.dynamicCast<ActiveMQBytesMessage>();
+        CPPUNIT_ASSERT(message->equals(createMessage(sizes[i]).get()));
+    }
+
+    CPPUNIT_ASSERT_EQUAL(0, bais.available());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::testLooseFrames() {
+    checkFrames(false, FrameOutputStream::DEFAULT_RETAINED_CAPACITY);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::testTightFrames() {
+    checkFrames(true, FrameOutputStream::DEFAULT_RETAINED_CAPACITY);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::testLooseFramesCopied() {
+    checkFrames(false, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::testTightFramesCopied() {
+    checkFrames(true, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    std::vector<unsigned char> marshalFrame(OpenWireFormat& format, const Pointer<Command>& command) {
+
+        IOTransport transport;
+        ByteArrayOutputStream bytes;
+        DataOutputStream out(&bytes);
+
+        format.marshal(command, &transport, &out);
+
+        std::pair<unsigned char*, int> array = bytes.toByteArray();
+        std::vector<unsigned char> frame(array.first, array.first + array.second);
+        delete [] array.first;
+
+        return frame;
+    }
+
+    Pointer<ActiveMQBytesMessage> unmarshalFrame(OpenWireFormat& format, const std::vector<unsigned char>& frame) {
+
+        IOTransport transport;
+        ByteArrayInputStream bais(frame);
+        DataInputStream in(&bais);
+
+        return format.unmarshal(&transport, &in).dynamicCast<ActiveMQBytesMessage>();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::checkCachedFrames(bool tightEncoding) {
+
+    Properties properties;
+    OpenWireFormat format(properties);
+    format.setTightEncodingEnabled(tightEncoding);
+    format.setCacheMarshaledMessages(true);
+
+    OpenWireFormat reference(properties);
+    reference.setTightEncodingEnabled(tightEncoding);
+
+    Pointer<ActiveMQBytesMessage> message = createMessage(16);
+    message->setStringProperty("name", "value");
+    message->setCommandId(1);
+
+    std::vector<unsigned char> first = marshalFrame(format, message);
+    CPPUNIT_ASSERT(!message->getCachedWireForm().empty());
+
+    // A resend with a new command id must match a frame marshaled from scratch.
+    message->setCommandId(70000);
+    message->setResponseRequired(true);
+    std::vector<unsigned char> resent = marshalFrame(format, message);
+    CPPUNIT_ASSERT(!message->getCachedWireForm().empty());
+    CPPUNIT_ASSERT(first != resent);
+    CPPUNIT_ASSERT(resent == marshalFrame(reference, message->copy()));
+
+    Pointer<ActiveMQBytesMessage> received = unmarshalFrame(format, resent);
+    CPPUNIT_ASSERT_EQUAL(70000, received->getCommandId());
+    CPPUNIT_ASSERT(received->isResponseRequired());
+    CPPUNIT_ASSERT_EQUAL(std::string("value"), received->getStringProperty("name"));
+
+    // Any change drops the frame so the next send carries it.
+    message->setCorrelationId("correlation");
+    CPPUNIT_ASSERT(message->getCachedWireForm().empty());
+
+    received = unmarshalFrame(format, marshalFrame(format, message));
+    CPPUNIT_ASSERT_EQUAL(std::string("correlation"), received->getCMSCorrelationID());
+    CPPUNIT_ASSERT(message->getCachedWireForm().size() > first.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::testLooseCachedFrames() {
+    checkCachedFrames(false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::testTightCachedFrames() {
+    checkCachedFrames(true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::checkMappedFrames(bool tightEncoding) {
+
+    Properties properties;
+    OpenWireFormat format(properties);
+    format.setTightEncodingEnabled(tightEncoding);
+
+    // The body starts a whole cycle into the file so that it holds the same bytes
+    // as the content of the messages it is compared with.
+    const std::string path = "openwire-mapped-body-test.bin";
+    const int offset = 256;
+    const int largest = FrameOutputStream::DEFAULT_RETAINED_CAPACITY + 1;
+
+    MemoryMappedFile file;
+    file.create(path, offset + largest);
+    for (int i = 0; i < offset + largest; ++i) {
+        file.getBuffer()[i] = (unsigned char) i;
+    }
+    file.setLength(offset + largest);
+    file.close();
+
+    const int sizes[] = { 0, 16, largest };
+    const int count = (int) (sizeof(sizes) / sizeof(int));
+
+    for (int i = 0; i < count; ++i) {
+
+        Pointer<ActiveMQBytesMessage> expected = createMessage(sizes[i]);
+        Pointer<ActiveMQBytesMessage> mapped = createMessage(0);
+        mapped->getMessageId()->setProducerSequenceId(sizes[i]);
+        mapped->setBodyFromFile(path, offset, sizes[i]);
+
+        std::vector<unsigned char> frame = marshalFrame(format, mapped);
+        CPPUNIT_ASSERT(frame == marshalFrame(format, expected));
+        CPPUNIT_ASSERT(mapped->getMappedContent() != NULL);
+
+        Pointer<ActiveMQBytesMessage> received = unmarshalFrame(format, frame);
+        CPPUNIT_ASSERT(received->equals(expected.get()));
+    }
+
+    CPPUNIT_ASSERT(MemoryMappedFile::remove(path));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::testLooseMappedFrames() {
+    checkMappedFrames(false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::testTightMappedFrames() {
+    checkMappedFrames(true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::testInternConnectionId() {
+
+    Properties properties;
+    OpenWireFormat format(properties);
+
+    ConnectionKey key = format.internConnectionId("ConnectionId");
+    CPPUNIT_ASSERT(key != NULL);
+    CPPUNIT_ASSERT(key == format.internConnectionId("ConnectionId"));
+    CPPUNIT_ASSERT(key == ConnectionIdTable::intern("ConnectionId"));
+    CPPUNIT_ASSERT(format.internConnectionId("") == NULL);
+    CPPUNIT_ASSERT(format.internConnectionId("OtherConnectionId") != key);
+
+    // Ids read back from the wire share the key interned for their connection.
+    Pointer<ActiveMQBytesMessage> received = unmarshalFrame(format, marshalFrame(format, createMessage(16)));
+    const Pointer<ProducerId>& producerId = received->getMessageId()->getProducerId();
+    CPPUNIT_ASSERT_EQUAL(std::string("ConnectionId"), producerId->getConnectionId());
+    CPPUNIT_ASSERT(producerId->getConnectionKey() == key);
+}
@@ -29,6 +29,15 @@ namespace openwire {
 
         CPPUNIT_TEST_SUITE( OpenWireFormatTest );
         CPPUNIT_TEST( test );
+        CPPUNIT_TEST( testLooseFrames );
+        CPPUNIT_TEST( testTightFrames );
+        CPPUNIT_TEST( testLooseFramesCopied );
+        CPPUNIT_TEST( testTightFramesCopied );
+        CPPUNIT_TEST( testLooseCachedFrames );
+        CPPUNIT_TEST( testTightCachedFrames );
+        CPPUNIT_TEST( testLooseMappedFrames );
+        CPPUNIT_TEST( testTightMappedFrames );
+        CPPUNIT_TEST( testInternConnectionId );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -37,6 +46,21 @@ namespace openwire {
         virtual ~OpenWireFormatTest() {}
 
         virtual void test();
+        void testLooseFrames();
+        void testTightFrames();
+        void testLooseFramesCopied();
+        void testTightFramesCopied();
+        void testLooseCachedFrames();
+        void testTightCachedFrames();
+        void testLooseMappedFrames();
+        void testTightMappedFrames();
+        void testInternConnectionId();
+
+    private:
+
+        void checkFrames(bool tightEncoding, int zeroCopyThreshold);
+        void checkCachedFrames(bool tightEncoding);
+        void checkMappedFrames(bool tightEncoding);
 
     };
 
@@ -0,0 +1,209 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PrimitiveMapReaderTest.h"
+
+#include <activemq/util/PrimitiveMap.h>
+#include <activemq/util/PrimitiveList.h>
+#include <activemq/wireformat/openwire/marshal/PrimitiveMapReader.h>
+#include <activemq/wireformat/openwire/marshal/PrimitiveTypesMarshaller.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/io/IOException.h>
+#include <decaf/util/NoSuchElementException.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::util;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace activemq::wireformat::openwire::marshal;
+using namespace decaf::io;
+using namespace decaf::util;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    std::vector<unsigned char> toVector( ByteArrayOutputStream& stream ) {
+        std::pair<unsigned char*, int> array = stream.toByteArray();
+        std::vector<unsigned char> result( array.first, array.first + array.second );
+        delete [] array.first;
+        return result;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PrimitiveMapReaderTest::testGet() {
+
+    PrimitiveMap myMap;
+
+    std::vector<unsigned char> bytes;
+    bytes.push_back( 65 );
+    bytes.push_back( 66 );
+    bytes.push_back( 67 );
+
+    myMap.setString( "stringKey", "The test string" );
+    myMap.setBool( "boolKey", true );
+    myMap.setByte( "byteKey", 'A' );
+    myMap.setChar( "charKey", 'B' );
+    myMap.setShort( "shortKey", 2048 );
+    myMap.setInt( "intKey", 655369 );
+    myMap.setLong( "longKey", 0xFFFFFFFF00000000ULL );
+    myMap.setFloat( "floatKey", 45.6545f );
+    myMap.setDouble( "doubleKey", 654564.654654 );
+    myMap.setByteArray( "bytesKey", bytes );
+    myMap.setString( "bigStringKey", std::string( 70000, 'x' ) );
+
+    std::vector<unsigned char> marshaled;
+    PrimitiveTypesMarshaller::marshal( &myMap, marshaled );
+
+    PrimitiveMapReader reader( &marshaled[0], (int)marshaled.size() );
+
+    CPPUNIT_ASSERT_EQUAL( 11, reader.size() );
+
+    std::vector<std::string> keys = myMap.keySet().toArray();
+    for( std::size_t i = 0; i < keys.size(); ++i ) {
+        CPPUNIT_ASSERT_MESSAGE( keys[i], reader.get( keys[i] ) == myMap.get( keys[i] ) );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PrimitiveMapReaderTest::testKeys() {
+
+    PrimitiveMap myMap;
+    myMap.setInt( "b", 2 );
+    myMap.setInt( "a", 1 );
+    myMap.setInt( "caf\xE9", 3 );
+    myMap.setInt( "", 0 );
+
+    std::vector<unsigned char> marshaled;
+    PrimitiveTypesMarshaller::marshal( &myMap, marshaled );
+
+    PrimitiveMapReader reader( &marshaled[0], (int)marshaled.size() );
+
+    CPPUNIT_ASSERT( !reader.isEmpty() );
+    CPPUNIT_ASSERT( reader.containsKey( "a" ) );
+    CPPUNIT_ASSERT( reader.containsKey( "" ) );
+    CPPUNIT_ASSERT( reader.containsKey( "caf\xE9" ) );
+    CPPUNIT_ASSERT( !reader.containsKey( "c" ) );
+    CPPUNIT_ASSERT( !reader.containsKey( "caf" ) );
+    CPPUNIT_ASSERT_EQUAL( 3, reader.get( "caf\xE9" ).getInt() );
+
+    std::vector<std::string> keys = reader.keySet();
+    CPPUNIT_ASSERT( keys == myMap.keySet().toArray() );
+
+    CPPUNIT_ASSERT_THROW( reader.get( "missing" ), NoSuchElementException );
+    CPPUNIT_ASSERT_THROW( reader.getValueType( "missing" ), NoSuchElementException );
+
+    PrimitiveMap emptyMap;
+    PrimitiveTypesMarshaller::marshal( &emptyMap, marshaled );
+
+    PrimitiveMapReader emptyReader( &marshaled[0], (int)marshaled.size() );
+    CPPUNIT_ASSERT( emptyReader.isEmpty() );
+    CPPUNIT_ASSERT( emptyReader.keySet().empty() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PrimitiveMapReaderTest::testValueTypes() {
+
+    PrimitiveList list;
+    list.add( 1 );
+    list.add( std::string( "two" ) );
+
+    PrimitiveMap nested;
+    nested.setInt( "1", 1 );
+
+    PrimitiveMap myMap;
+    myMap.put( "list", list );
+    myMap.put( "map", nested );
+    myMap.setString( "empty", "" );
+    myMap.setString( "string", "value" );
+    myMap.setString( "bigString", std::string( 70000, 'x' ) );
+    myMap.setInt( "after", 42 );
+
+    std::vector<unsigned char> marshaled;
+    PrimitiveTypesMarshaller::marshal( &myMap, marshaled );
+
+    PrimitiveMap unmarshaled;
+    PrimitiveTypesMarshaller::unmarshal( &unmarshaled, marshaled );
+
+    PrimitiveMapReader reader( &marshaled[0], (int)marshaled.size() );
+
+    std::vector<std::string> keys = unmarshaled.keySet().toArray();
+    for( std::size_t i = 0; i < keys.size(); ++i ) {
+        CPPUNIT_ASSERT_MESSAGE( keys[i], reader.getValueType( keys[i] ) == unmarshaled.getValueType( keys[i] ) );
+    }
+
+    CPPUNIT_ASSERT( reader.getValueType( "empty" ) == PrimitiveValueNode::NULL_TYPE );
+    CPPUNIT_ASSERT( reader.getValueType( "bigString" ) == PrimitiveValueNode::STRING_TYPE );
+    CPPUNIT_ASSERT( reader.get( "list" ).getList().size() == 2 );
+    CPPUNIT_ASSERT( reader.get( "map" ).getMap().get( "1" ).getInt() == 1 );
+    CPPUNIT_ASSERT_EQUAL( 42, reader.get( "after" ).getInt() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PrimitiveMapReaderTest::testDuplicateKeys() {
+
+    ByteArrayOutputStream bytesOut;
+    DataOutputStream dataOut( &bytesOut );
+
+    dataOut.writeInt( 3 );
+    dataOut.writeUTF( "key" );
+    dataOut.writeByte( PrimitiveValueNode::INTEGER_TYPE );
+    dataOut.writeInt( 1 );
+    dataOut.writeUTF( "other" );
+    dataOut.writeByte( PrimitiveValueNode::NULL_TYPE );
+    dataOut.writeUTF( "key" );
+    dataOut.writeByte( PrimitiveValueNode::INTEGER_TYPE );
+    dataOut.writeInt( 2 );
+
+    std::vector<unsigned char> marshaled = toVector( bytesOut );
+
+    PrimitiveMap unmarshaled;
+    PrimitiveTypesMarshaller::unmarshal( &unmarshaled, marshaled );
+
+    PrimitiveMapReader reader( &marshaled[0], (int)marshaled.size() );
+
+    CPPUNIT_ASSERT_EQUAL( unmarshaled.size(), reader.size() );
+    CPPUNIT_ASSERT_EQUAL( 2, reader.get( "key" ).getInt() );
+    CPPUNIT_ASSERT_EQUAL( unmarshaled.getInt( "key" ), reader.get( "key" ).getInt() );
+    CPPUNIT_ASSERT( reader.getValueType( "other" ) == PrimitiveValueNode::NULL_TYPE );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PrimitiveMapReaderTest::testInvalidContent() {
+
+    PrimitiveMap myMap;
+    myMap.setString( "string", "value" );
+    myMap.setInt( "int", 1 );
+
+    std::vector<unsigned char> marshaled;
+    PrimitiveTypesMarshaller::marshal( &myMap, marshaled );
+
+    // Cut the last value short.
+    CPPUNIT_ASSERT_THROW( PrimitiveMapReader( &marshaled[0], (int)marshaled.size() - 1 ), IOException );
+
+    ByteArrayOutputStream bytesOut;
+    DataOutputStream dataOut( &bytesOut );
+
+    dataOut.writeInt( 1 );
+    dataOut.writeUTF( "key" );
+    dataOut.writeByte( 99 );
+
+    std::vector<unsigned char> unknownType = toVector( bytesOut );
+    CPPUNIT_ASSERT_THROW( PrimitiveMapReader( &unknownType[0], (int)unknownType.size() ), IOException );
+}
@@ -0,0 +1,262 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ByteCursorTest.h"
+
+#include <activemq/wireformat/openwire/utils/ByteCursor.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/io/EOFException.h>
+#include <decaf/io/IOException.h>
+#include <decaf/io/UTFDataFormatException.h>
+
+#include <vector>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::io;
+using namespace activemq;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace activemq::wireformat::openwire::utils;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    std::vector<unsigned char> toVector( ByteArrayOutputStream& stream ) {
+        std::pair<unsigned char*, int> array = stream.toByteArray();
+        std::vector<unsigned char> result( array.first, array.first + array.second );
+        delete [] array.first;
+        return result;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ByteCursorTest::testMatchesDataOutputStream() {
+
+    const unsigned char raw[] = { 1, 2, 3, 250 };
+    std::string utf = "ASCII and \xE9\xFF";
+
+    ByteArrayOutputStream baos;
+    DataOutputStream dataOut( &baos );
+    dataOut.writeByte( 0xFE );
+    dataOut.writeBoolean( true );
+    dataOut.writeBoolean( false );
+    dataOut.writeShort( -2 );
+    dataOut.writeShort( 0x1234 );
+    dataOut.writeInt( -123456789 );
+    dataOut.writeInt( 0x7FFFFFFF );
+    dataOut.writeLong( -1234567890123LL );
+    dataOut.writeLong( 0x0102030405060708LL );
+    dataOut.write( raw, 4 );
+    dataOut.writeBytes( "bytes" );
+    dataOut.writeUTF( utf );
+
+    std::vector<unsigned char> expected = toVector( baos );
+
+    std::vector<unsigned char> buffer( expected.size() );
+    ByteCursor cursor( &buffer[0], (int)buffer.size() );
+    cursor.writeByte( 0xFE );
+    cursor.writeBoolean( true );
+    cursor.writeBoolean( false );
+    cursor.writeShort( -2 );
+    cursor.writeShort( 0x1234 );
+    cursor.writeInt( -123456789 );
+    cursor.writeInt( 0x7FFFFFFF );
+    cursor.writeLong( -1234567890123LL );
+    cursor.writeLong( 0x0102030405060708LL );
+    cursor.writeBytes( raw, 4 );
+    cursor.writeBytes( std::string( "bytes" ) );
+    cursor.writeUTF( utf );
+
+    CPPUNIT_ASSERT_EQUAL( (int)expected.size(), cursor.getPosition() );
+    CPPUNIT_ASSERT_EQUAL( 0, cursor.remaining() );
+    CPPUNIT_ASSERT( buffer == expected );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ByteCursorTest::testRoundTrip() {
+
+    unsigned char buffer[64];
+    ByteCursor out( buffer, (int)sizeof( buffer ) );
+    out.writeByte( 0x80 );
+    out.writeBoolean( true );
+    out.writeShort( -32768 );
+    out.writeShort( (short)0xFFFF );
+    out.writeInt( -1 );
+    out.writeLong( -9223372036854775807LL - 1 );
+    out.writeBytes( (const unsigned char*)"xyz", 3 );
+
+    ByteCursor in( buffer, out.getPosition() );
+    CPPUNIT_ASSERT_EQUAL( (int)0x80, (int)in.readByte() );
+    CPPUNIT_ASSERT( in.readBoolean() );
+    CPPUNIT_ASSERT_EQUAL( (short)-32768, in.readShort() );
+    CPPUNIT_ASSERT_EQUAL( (unsigned short)0xFFFF, in.readUnsignedShort() );
+    CPPUNIT_ASSERT_EQUAL( -1, in.readInt() );
+    CPPUNIT_ASSERT_EQUAL( -9223372036854775807LL - 1, in.readLong() );
+
+    unsigned char bytes[3];
+    in.readBytes( bytes, 3 );
+    CPPUNIT_ASSERT_EQUAL( std::string( "xyz" ), std::string( (char*)bytes, 3 ) );
+    CPPUNIT_ASSERT_EQUAL( 0, in.remaining() );
+
+    ByteCursor skipper( buffer, out.getPosition() );
+    skipper.skip( 4 );
+    CPPUNIT_ASSERT_EQUAL( 4, skipper.getPosition() );
+    CPPUNIT_ASSERT_EQUAL( (short)0xFFFF, skipper.readShort() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ByteCursorTest::testUTF() {
+
+    std::string values[3];
+    values[0] = "";
+    values[1] = "plain ascii";
+    values[2] = std::string( "nul \0 and \xC4\xD6\xDC", 13 );
+
+    for( int i = 0; i < 3; ++i ) {
+
+        unsigned char buffer[64];
+        ByteCursor out( buffer, (int)sizeof( buffer ) );
+        out.writeUTF( values[i] );
+
+        ByteCursor in( buffer, out.getPosition() );
+        CPPUNIT_ASSERT( values[i] == in.readUTF() );
+        CPPUNIT_ASSERT_EQUAL( 0, in.remaining() );
+    }
+
+    std::string tooLong( 65536, 'a' );
+    std::vector<unsigned char> buffer( 65540 );
+    ByteCursor out( &buffer[0], (int)buffer.size() );
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a UTFDataFormatException",
+        out.writeUTF( tooLong ),
+        UTFDataFormatException );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ByteCursorTest::testUTFInvalid() {
+
+    // A three byte encoded character can't be represented in a std::string.
+    unsigned char threeByte[] = { 0x00, 0x03, 0xE2, 0x82, 0xAC };
+    ByteCursor in( threeByte, (int)sizeof( threeByte ) );
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a UTFDataFormatException",
+        in.readUTF(),
+        UTFDataFormatException );
+
+    // The second byte of the pair doesn't have the continuation bits.
+    unsigned char badPair[] = { 0x00, 0x02, 0xC3, 0x00 };
+    ByteCursor in2( badPair, (int)sizeof( badPair ) );
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a UTFDataFormatException",
+        in2.readUTF(),
+        UTFDataFormatException );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ByteCursorTest::testOverflow() {
+
+    unsigned char buffer[3];
+    ByteCursor out( buffer, (int)sizeof( buffer ) );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        out.writeInt( 1 ),
+        IOException );
+
+    // A failed write leaves the cursor where it was.
+    CPPUNIT_ASSERT_EQUAL( 0, out.getPosition() );
+    out.writeShort( 1 );
+    out.writeByte( 1 );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        out.writeByte( 1 ),
+        IOException );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ByteCursorTest::testUnderflow() {
+
+    unsigned char buffer[] = { 0, 1, 2 };
+    ByteCursor in( buffer, (int)sizeof( buffer ) );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an EOFException",
+        in.readInt(),
+        EOFException );
+
+    CPPUNIT_ASSERT_EQUAL( 0, in.getPosition() );
+    CPPUNIT_ASSERT_EQUAL( (short)1, in.readShort() );
+
+    unsigned char bytes[2];
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an EOFException",
+        in.readBytes( bytes, 2 ),
+        EOFException );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an EOFException",
+        in.skip( -1 ),
+        EOFException );
+
+    // The length prefix claims more bytes than the buffer holds.
+    unsigned char utf[] = { 0x00, 0x05, 'a', 'b' };
+    ByteCursor in2( utf, (int)sizeof( utf ) );
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an EOFException",
+        in2.readUTF(),
+        EOFException );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ByteCursorTest::testSetPosition() {
+
+    ByteArrayOutputStream bytesOut;
+    DataOutputStream dataOut( &bytesOut );
+    dataOut.writeChar( 'z' );
+    dataOut.writeFloat( 45.45f );
+    dataOut.writeDouble( 1321.1516 );
+
+    const std::vector<unsigned char> expected = toVector( bytesOut );
+
+    ByteCursor in( &expected[0], (int)expected.size() );
+    CPPUNIT_ASSERT_EQUAL( 'z', in.readChar() );
+
+    int mark = in.getPosition();
+    CPPUNIT_ASSERT_EQUAL( 45.45f, in.readFloat() );
+    CPPUNIT_ASSERT_EQUAL( 1321.1516, in.readDouble() );
+    CPPUNIT_ASSERT_EQUAL( 0, in.remaining() );
+
+    // Going back re-reads the same value.
+    in.setPosition( mark );
+    CPPUNIT_ASSERT_EQUAL( 45.45f, in.readFloat() );
+
+    in.setPosition( (int)expected.size() );
+    CPPUNIT_ASSERT_EQUAL( 0, in.remaining() );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        in.setPosition( (int)expected.size() + 1 ),
+        IOException );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        in.setPosition( -1 ),
+        IOException );
+}
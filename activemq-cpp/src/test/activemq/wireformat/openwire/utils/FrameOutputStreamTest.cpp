@@ -0,0 +1,184 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FrameOutputStreamTest.h"
+
+#include <activemq/wireformat/openwire/utils/FrameOutputStream.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/lang/exceptions/IndexOutOfBoundsException.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+
+#include <string>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang::exceptions;
+using namespace activemq;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace activemq::wireformat::openwire::utils;
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameOutputStreamTest::testWrite() {
+
+    FrameOutputStream frame;
+    DataOutputStream out( &frame );
+
+    out.writeByte( 1 );
+    out.writeInt( 0x02030405 );
+    out.writeBytes( "abc" );
+
+    CPPUNIT_ASSERT_EQUAL( 8, frame.size() );
+    CPPUNIT_ASSERT_EQUAL( (int)0x02, (int)frame.getBuffer()[1] );
+    CPPUNIT_ASSERT_EQUAL( (int)0x05, (int)frame.getBuffer()[4] );
+    CPPUNIT_ASSERT_EQUAL( std::string( "abc" ), std::string( (char*)frame.getBuffer() + 5, 3 ) );
+
+    // Enough writes to force the buffer to grow several times.
+    for( int i = 0; i < 10000; ++i ) {
+        out.writeInt( i );
+    }
+
+    CPPUNIT_ASSERT_EQUAL( 40008, frame.size() );
+    CPPUNIT_ASSERT_EQUAL( std::string( "abc" ), std::string( (char*)frame.getBuffer() + 5, 3 ) );
+    CPPUNIT_ASSERT_EQUAL( (int)0x27, (int)frame.getBuffer()[40006] );
+    CPPUNIT_ASSERT_EQUAL( (int)0x0F, (int)frame.getBuffer()[40007] );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameOutputStreamTest::testReserveAndPatch() {
+
+    FrameOutputStream frame;
+    DataOutputStream out( &frame );
+
+    int offset = frame.reserve( 4 );
+    CPPUNIT_ASSERT_EQUAL( 0, offset );
+    CPPUNIT_ASSERT_EQUAL( 4, frame.size() );
+
+    out.writeBytes( "payload" );
+    frame.patchInt( offset, frame.size() - 4 );
+
+    const unsigned char* buffer = frame.getBuffer();
+    CPPUNIT_ASSERT_EQUAL( 0, (int)buffer[0] );
+    CPPUNIT_ASSERT_EQUAL( 0, (int)buffer[1] );
+    CPPUNIT_ASSERT_EQUAL( 0, (int)buffer[2] );
+    CPPUNIT_ASSERT_EQUAL( 7, (int)buffer[3] );
+
+    frame.patchInt( 0, -2 );
+    CPPUNIT_ASSERT_EQUAL( 0xFF, (int)frame.getBuffer()[0] );
+    CPPUNIT_ASSERT_EQUAL( 0xFE, (int)frame.getBuffer()[3] );
+    CPPUNIT_ASSERT_EQUAL( std::string( "payload" ), std::string( (char*)frame.getBuffer() + 4, 7 ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameOutputStreamTest::testPatchOutOfBounds() {
+
+    FrameOutputStream frame;
+    frame.reserve( 6 );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IndexOutOfBoundsException",
+        frame.patchInt( 3, 1 ),
+        IndexOutOfBoundsException );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IndexOutOfBoundsException",
+        frame.patchInt( -1, 1 ),
+        IndexOutOfBoundsException );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IndexOutOfBoundsException",
+        frame.reserve( -1 ),
+        IndexOutOfBoundsException );
+
+    frame.patchInt( 2, 1 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameOutputStreamTest::testResetReleasesLargeBuffer() {
+
+    FrameOutputStream frame( 1024 );
+
+    frame.reserve( 512 );
+    int capacity = frame.getCapacity();
+    frame.reset();
+    CPPUNIT_ASSERT_EQUAL( 0, frame.size() );
+    CPPUNIT_ASSERT_EQUAL( capacity, frame.getCapacity() );
+
+    frame.ensureCapacity( 4096 );
+    CPPUNIT_ASSERT( frame.getCapacity() >= 4096 );
+    frame.reset();
+    CPPUNIT_ASSERT_EQUAL( 0, frame.getCapacity() );
+
+    frame.reserve( 8 );
+    CPPUNIT_ASSERT_EQUAL( 8, frame.size() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameOutputStreamTest::testWriteTo() {
+
+    FrameOutputStream frame;
+    ByteArrayOutputStream target;
+
+    frame.writeTo( &target );
+    CPPUNIT_ASSERT_EQUAL( 0LL, target.size() );
+
+    DataOutputStream out( &frame );
+    out.writeBytes( "frame" );
+    frame.writeTo( &target );
+
+    CPPUNIT_ASSERT_EQUAL( std::string( "frame" ), target.toString() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameOutputStreamTest::testReferences() {
+
+    FrameOutputStream frame;
+    frame.setReferenceThreshold( 8 );
+    CPPUNIT_ASSERT_EQUAL( 8, frame.getReferenceThreshold() );
+
+    const unsigned char body[] = { 'b', 'b', 'b', 'b', 'b', 'b', 'b', 'b', 'b', 'b' };
+
+    DataOutputStream out( &frame );
+    out.writeBytes( "abc" );
+    out.write( body, 10, 0, 10 );
+    out.writeBytes( "defgh" );
+
+    CPPUNIT_ASSERT( frame.hasReferences() );
+    CPPUNIT_ASSERT_EQUAL( 18, frame.size() );
+
+    // Offsets are logical, the bytes after the referenced region are still patchable.
+    frame.patchInt( 13, 0x78797A7A );
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "should throw IndexOutOfBoundsException",
+        frame.patchInt( 2, 0 ),
+        IndexOutOfBoundsException );
+
+    ByteArrayOutputStream target;
+    frame.writeTo( &target );
+    CPPUNIT_ASSERT_EQUAL( std::string( "abcbbbbbbbbbbxyzzh" ), target.toString() );
+
+    frame.reset();
+    CPPUNIT_ASSERT( !frame.hasReferences() );
+    CPPUNIT_ASSERT_EQUAL( 0, frame.size() );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "should throw IllegalArgumentException",
+        frame.setReferenceThreshold( -1 ),
+        decaf::lang::exceptions::IllegalArgumentException );
+}
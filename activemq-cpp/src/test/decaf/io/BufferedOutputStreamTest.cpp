@@ -29,6 +29,22 @@ using namespace decaf::util;
 ////////////////////////////////////////////////////////////////////////////////
 namespace {
 
+    class GatheringOutputStream : public ByteArrayOutputStream {
+    public:
+
+        int gatheringWrites;
+
+        GatheringOutputStream() : ByteArrayOutputStream(), gatheringWrites(0) {}
+        virtual ~GatheringOutputStream() {}
+
+    protected:
+
+        virtual void doWriteGathering(const unsigned char* const* buffers, const int* lengths, int count) {
+            gatheringWrites++;
+            ByteArrayOutputStream::doWriteGathering(buffers, lengths, count);
+        }
+    };
+
     class MyOutputStream : public OutputStream{
     private:
         char buffer[100];
@@ -314,3 +330,34 @@ void BufferedOutputStreamTest::testBiggerBuffer(){
     bufStream.flush();
     CPPUNIT_ASSERT( strcmp( buffer, "TESTTEST12345678910" ) == 0 );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void BufferedOutputStreamTest::testWriteGathering() {
+
+    GatheringOutputStream target;
+    BufferedOutputStream os( &target, 16 );
+
+    const unsigned char* small[] = { (const unsigned char*)"ab", (const unsigned char*)"cd" };
+    const int smallLengths[] = { 2, 2 };
+
+    // Arrays that fit in the buffer are buffered as usual.
+    os.writeGathering( small, smallLengths, 2 );
+    CPPUNIT_ASSERT_EQUAL( 0LL, target.size() );
+
+    // Larger ones are passed on behind the buffered bytes in one gathering write.
+    const unsigned char* large[] = { (const unsigned char*)"0123456789", (const unsigned char*)"ABCDEFGHIJ" };
+    const int largeLengths[] = { 10, 10 };
+
+    os.writeGathering( large, largeLengths, 2 );
+    CPPUNIT_ASSERT_EQUAL( 1, target.gatheringWrites );
+    CPPUNIT_ASSERT_EQUAL( std::string( "abcd0123456789ABCDEFGHIJ" ), target.toString() );
+
+    os.writeGathering( small, smallLengths, 2 );
+    os.flush();
+    CPPUNIT_ASSERT_EQUAL( std::string( "abcd0123456789ABCDEFGHIJabcd" ), target.toString() );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "should throw NullPointerException",
+        os.writeGathering( NULL, smallLengths, 2 ),
+        NullPointerException );
+}
@@ -43,6 +43,7 @@ namespace io{
       CPPUNIT_TEST( testWriteNullStreamNullArraySize );
       CPPUNIT_TEST( testWriteNullStreamSize );
       CPPUNIT_TEST( testWriteI );
+      CPPUNIT_TEST( testWriteGathering );
       CPPUNIT_TEST_SUITE_END();
 
       std::string testString;
@@ -69,6 +70,7 @@ namespace io{
         void testWriteNullStream();
         void testWriteNullStreamSize();
         void testWriteI();
+        void testWriteGathering();
 
     };
 
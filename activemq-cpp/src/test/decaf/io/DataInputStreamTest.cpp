@@ -399,6 +399,31 @@ void DataInputStreamTest::test_skipBytes() {
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void DataInputStreamTest::test_getBytesRead() {
+
+    os->writeInt( 42 );
+    os->writeLong( 42LL );
+    os->writeUTF( "test" );
+    os->writeChars( "abc" );
+    os->close();
+    openDataInputStream();
+
+    CPPUNIT_ASSERT_EQUAL( 0LL, is->getBytesRead() );
+
+    is->readInt();
+    CPPUNIT_ASSERT_EQUAL( 4LL, is->getBytesRead() );
+    is->readLong();
+    CPPUNIT_ASSERT_EQUAL( 12LL, is->getBytesRead() );
+    is->readUTF();
+    CPPUNIT_ASSERT_EQUAL( 18LL, is->getBytesRead() );
+    is->readString();
+    CPPUNIT_ASSERT_EQUAL( 22LL, is->getBytesRead() );
+    CPPUNIT_ASSERT_EQUAL( os->size(), is->getBytesRead() );
+
+    is->close();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void DataInputStreamTest::test(){
 
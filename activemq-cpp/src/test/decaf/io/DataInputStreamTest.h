@@ -59,6 +59,7 @@ namespace io{
         CPPUNIT_TEST( test_readUnsignedByte );
         CPPUNIT_TEST( test_readUnsignedShort );
         CPPUNIT_TEST( test_skipBytes );
+        CPPUNIT_TEST( test_getBytesRead );
         CPPUNIT_TEST_SUITE_END();
 
         std::auto_ptr<ByteArrayOutputStream> baos;
@@ -111,6 +112,7 @@ namespace io{
         void test_readUnsignedByte();
         void test_readUnsignedShort();
         void test_skipBytes();
+        void test_getBytesRead();
 
     private:
 
@@ -23,6 +23,7 @@
 #include <decaf/util/Random.h>
 #include <decaf/lang/exceptions/InterruptedException.h>
 #include <decaf/lang/exceptions/RuntimeException.h>
+#include <decaf/lang/exceptions/UnsupportedOperationException.h>
 
 #include <memory>
 
@@ -525,6 +526,41 @@ void ThreadTest::testSetPriority() {
     ct.join();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ThreadTest::testSetAffinity() {
+
+    std::auto_ptr<Runnable> runnable( new SimpleThread( 10 ) );
+    Thread ct( runnable.get() );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        ct.setAffinity( std::vector<int>() ),
+        IllegalArgumentException );
+
+    std::vector<int> available;
+    try {
+        available = ct.getAffinity();
+    } catch( UnsupportedOperationException& ex ) {
+        // Platform can't place threads, nothing more to check.
+        ct.start();
+        ct.join();
+        return;
+    }
+
+    CPPUNIT_ASSERT( !available.empty() );
+
+    std::vector<int> cpus;
+    cpus.push_back( available.front() );
+    ct.setAffinity( cpus );
+
+    std::vector<int> result = ct.getAffinity();
+    CPPUNIT_ASSERT_EQUAL( (std::size_t)1, result.size() );
+    CPPUNIT_ASSERT_EQUAL( available.front(), result.front() );
+
+    ct.start();
+    ct.join();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ThreadTest::testIsAlive() {
 
@@ -39,6 +39,7 @@ namespace lang{
       CPPUNIT_TEST( testJoin3 );
       CPPUNIT_TEST( testJoin4 );
       CPPUNIT_TEST( testSetPriority );
+      CPPUNIT_TEST( testSetAffinity );
       CPPUNIT_TEST( testIsAlive );
       CPPUNIT_TEST( testGetId );
       CPPUNIT_TEST( testGetState );
@@ -77,6 +78,7 @@ namespace lang{
         void testJoin3();
         void testJoin4();
         void testSetPriority();
+        void testSetAffinity();
         void testIsAlive();
         void testGetId();
         void testGetState();
@@ -0,0 +1,528 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StripedReadWriteLockTest.h"
+
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/exceptions/IllegalMonitorStateException.h>
+#include <decaf/lang/exceptions/UnsupportedOperationException.h>
+#include <decaf/util/concurrent/TimeUnit.h>
+#include <decaf/util/concurrent/locks/Lock.h>
+#include <decaf/util/concurrent/locks/StripedReadWriteLock.h>
+
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::locks;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class TryLockRunnable : public Runnable {
+    private:
+
+        TryLockRunnable(const TryLockRunnable&);
+        TryLockRunnable operator= (const TryLockRunnable&);
+
+    public:
+
+        locks::Lock* lock;
+        bool result;
+
+        TryLockRunnable(locks::Lock* lock) : Runnable(), lock(lock), result(false) {}
+        virtual ~TryLockRunnable() {}
+
+        virtual void run() {
+            result = lock->tryLock();
+            if (result) {
+                lock->unlock();
+            }
+        }
+    };
+
+    class LockUnlockRunnable : public Runnable {
+    private:
+
+        LockUnlockRunnable(const LockUnlockRunnable&);
+        LockUnlockRunnable operator= (const LockUnlockRunnable&);
+
+    public:
+
+        locks::Lock* lock;
+        bool acquired;
+
+        LockUnlockRunnable(locks::Lock* lock) : Runnable(), lock(lock), acquired(false) {}
+        virtual ~LockUnlockRunnable() {}
+
+        virtual void run() {
+            lock->lock();
+            acquired = true;
+            lock->unlock();
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+StripedReadWriteLockTest::StripedReadWriteLockTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+StripedReadWriteLockTest::~StripedReadWriteLockTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StripedReadWriteLockTest::testConstructor() {
+
+    StripedReadWriteLock rl;
+    CPPUNIT_ASSERT(!rl.isWriteLocked());
+    CPPUNIT_ASSERT(!rl.isWriteLockedByCurrentThread());
+    CPPUNIT_ASSERT_EQUAL(0, rl.getReadLockCount());
+    CPPUNIT_ASSERT_EQUAL(0, rl.getReadHoldCount());
+    CPPUNIT_ASSERT_EQUAL(0, rl.getWriteHoldCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StripedReadWriteLockTest::testLock() {
+
+    StripedReadWriteLock rl;
+    rl.writeLock().lock();
+    CPPUNIT_ASSERT(rl.isWriteLocked());
+    CPPUNIT_ASSERT(rl.isWriteLockedByCurrentThread());
+    CPPUNIT_ASSERT_EQUAL(0, rl.getReadLockCount());
+    rl.writeLock().unlock();
+    CPPUNIT_ASSERT(!rl.isWriteLocked());
+    CPPUNIT_ASSERT(!rl.isWriteLockedByCurrentThread());
+    CPPUNIT_ASSERT_EQUAL(0, rl.getReadLockCount());
+    rl.readLock().lock();
+    CPPUNIT_ASSERT(!rl.isWriteLocked());
+    CPPUNIT_ASSERT_EQUAL(1, rl.getReadLockCount());
+    rl.readLock().unlock();
+    CPPUNIT_ASSERT_EQUAL(0, rl.getReadLockCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StripedReadWriteLockTest::testGetWriteHoldCount() {
+
+    StripedReadWriteLock lock;
+    for (int i = 1; i <= 256; i++) {
+        lock.writeLock().lock();
+        CPPUNIT_ASSERT_EQUAL(i, lock.getWriteHoldCount());
+    }
+    for (int i = 256; i > 0; i--) {
+        lock.writeLock().unlock();
+        CPPUNIT_ASSERT_EQUAL(i - 1, lock.getWriteHoldCount());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StripedReadWriteLockTest::testReentrantReadLock() {
+
+    StripedReadWriteLock lock;
+    for (int i = 1; i <= 256; i++) {
+        lock.readLock().lock();
+        CPPUNIT_ASSERT_EQUAL(i, lock.getReadHoldCount());
+        // Reentrant holds are tracked per thread and only count once on the stripes.
+        CPPUNIT_ASSERT_EQUAL(1, lock.getReadLockCount());
+    }
+    for (int i = 256; i > 0; i--) {
+        lock.readLock().unlock();
+        CPPUNIT_ASSERT_EQUAL(i - 1, lock.getReadHoldCount());
+    }
+    CPPUNIT_ASSERT_EQUAL(0, lock.getReadLockCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StripedReadWriteLockTest::testUnlockIllegalMonitorStateException() {
+
+    StripedReadWriteLock rl;
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IllegalMonitorStateException",
+        rl.writeLock().unlock(),
+        IllegalMonitorStateException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IllegalMonitorStateException",
+        rl.readLock().unlock(),
+        IllegalMonitorStateException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StripedReadWriteLockTest::testWriteLockWhileHoldingReadLock() {
+
+    StripedReadWriteLock lock;
+    lock.readLock().lock();
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IllegalMonitorStateException",
+        lock.writeLock().lock(),
+        IllegalMonitorStateException);
+
+    lock.readLock().unlock();
+    CPPUNIT_ASSERT(!lock.isWriteLocked());
+    CPPUNIT_ASSERT(lock.writeLock().tryLock());
+    lock.writeLock().unlock();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StripedReadWriteLockTest::testReadAfterWriteLock() {
+
+    StripedReadWriteLock lock;
+    lock.writeLock().lock();
+    lock.readLock().lock();
+    CPPUNIT_ASSERT_EQUAL(1, lock.getReadLockCount());
+    lock.writeLock().unlock();
+
+    // Downgraded, other readers can now get in but writers can't.
+    TryLockRunnable reader(&lock.readLock());
+    Thread t1(&reader);
+    t1.start();
+    t1.join();
+    CPPUNIT_ASSERT(reader.result);
+
+    TryLockRunnable writer(&lock.writeLock());
+    Thread t2(&writer);
+    t2.start();
+    t2.join();
+    CPPUNIT_ASSERT(!writer.result);
+
+    lock.readLock().unlock();
+    CPPUNIT_ASSERT_EQUAL(0, lock.getReadLockCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StripedReadWriteLockTest::testWriteTryLockWhenLocked() {
+
+    StripedReadWriteLock lock;
+    TryLockRunnable runnable(&lock.writeLock());
+    Thread t(&runnable);
+    lock.writeLock().lock();
+
+    try {
+        t.start();
+        t.join();
+        lock.writeLock().unlock();
+    } catch (Exception& e) {
+        unexpectedException();
+    }
+
+    CPPUNIT_ASSERT(!runnable.result);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StripedReadWriteLockTest::testReadTryLockWhenLocked() {
+
+    StripedReadWriteLock lock;
+    TryLockRunnable runnable(&lock.readLock());
+    Thread t(&runnable);
+    lock.writeLock().lock();
+
+    try {
+        t.start();
+        t.join();
+        lock.writeLock().unlock();
+    } catch (Exception& e) {
+        unexpectedException();
+    }
+
+    CPPUNIT_ASSERT(!runnable.result);
+    CPPUNIT_ASSERT_EQUAL(0, lock.getReadLockCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StripedReadWriteLockTest::testWriteTryLockWhenReadLocked() {
+
+    StripedReadWriteLock lock;
+    TryLockRunnable runnable(&lock.writeLock());
+    Thread t(&runnable);
+    lock.readLock().lock();
+
+    try {
+        t.start();
+        t.join();
+        lock.readLock().unlock();
+    } catch (Exception& e) {
+        unexpectedException();
+    }
+
+    CPPUNIT_ASSERT(!runnable.result);
+    CPPUNIT_ASSERT(!lock.isWriteLocked());
+
+    // A failed writer must not leave readers blocked.
+    CPPUNIT_ASSERT(lock.readLock().tryLock());
+    lock.readLock().unlock();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StripedReadWriteLockTest::testMultipleReadLocks() {
+
+    StripedReadWriteLock lock;
+    TryLockRunnable runnable(&lock.readLock());
+    Thread t(&runnable);
+
+    lock.readLock().lock();
+    try {
+        t.start();
+        t.join();
+        lock.readLock().unlock();
+    } catch (Exception& e) {
+        unexpectedException();
+    }
+
+    CPPUNIT_ASSERT(runnable.result);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StripedReadWriteLockTest::testWriteAfterReadLockReleased() {
+
+    StripedReadWriteLock lock;
+    LockUnlockRunnable runnable(&lock.writeLock());
+    Thread t(&runnable);
+
+    lock.readLock().lock();
+    try {
+        t.start();
+        Thread::sleep(SHORT_DELAY_MS);
+        CPPUNIT_ASSERT(!runnable.acquired);
+        lock.readLock().unlock();
+        t.join(LONG_DELAY_MS);
+        CPPUNIT_ASSERT(!t.isAlive());
+    } catch (Exception& e) {
+        unexpectedException();
+    }
+
+    CPPUNIT_ASSERT(runnable.acquired);
+    CPPUNIT_ASSERT(!lock.isWriteLocked());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class TestReadTryLockTimeoutRunnable : public Runnable {
+    private:
+
+        StripedReadWriteLockTest* test;
+        StripedReadWriteLock* lock;
+
+    private:
+
+        TestReadTryLockTimeoutRunnable(const TestReadTryLockTimeoutRunnable&);
+        TestReadTryLockTimeoutRunnable operator= (const TestReadTryLockTimeoutRunnable&);
+
+    public:
+
+        TestReadTryLockTimeoutRunnable(StripedReadWriteLockTest* test, StripedReadWriteLock* lock) :
+            Runnable(), test(test), lock(lock) {}
+        virtual ~TestReadTryLockTimeoutRunnable() {}
+
+        virtual void run() {
+            try {
+                test->threadAssertFalse(lock->readLock().tryLock(1, TimeUnit::MILLISECONDS));
+                test->threadAssertFalse(lock->writeLock().tryLock(1, TimeUnit::MILLISECONDS));
+            } catch (Exception& ex) {
+                test->threadUnexpectedException();
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StripedReadWriteLockTest::testReadTryLockTimeout() {
+
+    StripedReadWriteLock lock;
+    TestReadTryLockTimeoutRunnable runnable(this, &lock);
+    Thread t(&runnable);
+    lock.writeLock().lock();
+
+    try {
+        t.start();
+        t.join();
+        lock.writeLock().unlock();
+    } catch (Exception& e) {
+        unexpectedException();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class TestWriteLockInterruptiblyRunnable : public Runnable {
+    private:
+
+        StripedReadWriteLockTest* test;
+        StripedReadWriteLock* lock;
+
+    private:
+
+        TestWriteLockInterruptiblyRunnable(const TestWriteLockInterruptiblyRunnable&);
+        TestWriteLockInterruptiblyRunnable operator= (const TestWriteLockInterruptiblyRunnable&);
+
+    public:
+
+        TestWriteLockInterruptiblyRunnable(StripedReadWriteLockTest* test, StripedReadWriteLock* lock) :
+            Runnable(), test(test), lock(lock) {}
+        virtual ~TestWriteLockInterruptiblyRunnable() {}
+
+        virtual void run() {
+            try {
+                lock->writeLock().lockInterruptibly();
+                test->threadShouldThrow();
+            } catch (InterruptedException& success) {
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StripedReadWriteLockTest::testWriteLockInterruptibly() {
+
+    StripedReadWriteLock lock;
+    TestWriteLockInterruptiblyRunnable runnable(this, &lock);
+    Thread t(&runnable);
+
+    lock.readLock().lock();
+    try {
+        t.start();
+        Thread::sleep(SHORT_DELAY_MS);
+        t.interrupt();
+        t.join();
+        lock.readLock().unlock();
+    } catch (Exception& e) {
+        unexpectedException();
+    }
+
+    // The interrupted writer must have withdrawn so readers and writers can proceed.
+    CPPUNIT_ASSERT(!lock.isWriteLocked());
+    CPPUNIT_ASSERT(lock.readLock().tryLock());
+    lock.readLock().unlock();
+    CPPUNIT_ASSERT(lock.writeLock().tryLock());
+    lock.writeLock().unlock();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StripedReadWriteLockTest::testNewCondition() {
+
+    StripedReadWriteLock lock;
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an UnsupportedOperationException",
+        lock.readLock().newCondition(),
+        UnsupportedOperationException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an UnsupportedOperationException",
+        lock.writeLock().newCondition(),
+        UnsupportedOperationException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StripedReadWriteLockTest::testToString() {
+
+    StripedReadWriteLock lock;
+    std::string us = lock.toString();
+    CPPUNIT_ASSERT(us.find("Write locks = 0") != std::string::npos);
+    CPPUNIT_ASSERT(us.find("Read locks = 0") != std::string::npos);
+    lock.writeLock().lock();
+    std::string ws = lock.toString();
+    CPPUNIT_ASSERT(ws.find("Write locks = 1") != std::string::npos);
+    CPPUNIT_ASSERT(ws.find("Read locks = 0") != std::string::npos);
+    CPPUNIT_ASSERT(lock.writeLock().toString().find("Locked") != std::string::npos);
+    lock.writeLock().unlock();
+    lock.readLock().lock();
+    lock.readLock().lock();
+    std::string rs = lock.toString();
+    CPPUNIT_ASSERT(rs.find("Write locks = 0") != std::string::npos);
+    CPPUNIT_ASSERT(rs.find("Read locks = 1") != std::string::npos);
+    lock.readLock().unlock();
+    lock.readLock().unlock();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class ReaderWriterRunnable : public Runnable {
+    private:
+
+        ReaderWriterRunnable(const ReaderWriterRunnable&);
+        ReaderWriterRunnable operator= (const ReaderWriterRunnable&);
+
+    public:
+
+        StripedReadWriteLockTest* test;
+        StripedReadWriteLock* lock;
+        int* left;
+        int* right;
+        bool writer;
+
+        ReaderWriterRunnable(StripedReadWriteLockTest* test, StripedReadWriteLock* lock,
+                             int* left, int* right, bool writer) :
+            Runnable(), test(test), lock(lock), left(left), right(right), writer(writer) {}
+        virtual ~ReaderWriterRunnable() {}
+
+        virtual void run() {
+            for (int i = 0; i < 2000; ++i) {
+                if (writer && (i % 10) == 0) {
+                    lock->writeLock().lock();
+                    (*left)++;
+                    Thread::yield();
+                    (*right)++;
+                    lock->writeLock().unlock();
+                } else {
+                    lock->readLock().lock();
+                    test->threadAssertEquals(*left, *right);
+                    lock->readLock().unlock();
+                }
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StripedReadWriteLockTest::testConcurrentReadersAndWriters() {
+
+    static const int NUM_THREADS = 8;
+
+    StripedReadWriteLock lock;
+    int left = 0;
+    int right = 0;
+
+    std::vector<ReaderWriterRunnable*> runnables;
+    std::vector<Thread*> threads;
+
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        runnables.push_back(new ReaderWriterRunnable(this, &lock, &left, &right, i < 2));
+        threads.push_back(new Thread(runnables.back()));
+    }
+
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        threads[i]->start();
+    }
+
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        threads[i]->join();
+        delete threads[i];
+        delete runnables[i];
+    }
+
+    CPPUNIT_ASSERT_EQUAL(400, left);
+    CPPUNIT_ASSERT_EQUAL(400, right);
+    CPPUNIT_ASSERT_EQUAL(0, lock.getReadLockCount());
+    CPPUNIT_ASSERT(!lock.isWriteLocked());
+}
@@ -0,0 +1,79 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_UTIL_CONCURRENT_LOCKS_STRIPEDREADWRITELOCKTEST_H_
+#define _DECAF_UTIL_CONCURRENT_LOCKS_STRIPEDREADWRITELOCKTEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <decaf/util/concurrent/ExecutorsTestSupport.h>
+
+namespace decaf {
+namespace util {
+namespace concurrent {
+namespace locks {
+
+    class StripedReadWriteLockTest : public ExecutorsTestSupport {
+
+        CPPUNIT_TEST_SUITE( StripedReadWriteLockTest );
+        CPPUNIT_TEST( testConstructor );
+        CPPUNIT_TEST( testLock );
+        CPPUNIT_TEST( testGetWriteHoldCount );
+        CPPUNIT_TEST( testReentrantReadLock );
+        CPPUNIT_TEST( testUnlockIllegalMonitorStateException );
+        CPPUNIT_TEST( testWriteLockWhileHoldingReadLock );
+        CPPUNIT_TEST( testReadAfterWriteLock );
+        CPPUNIT_TEST( testWriteTryLockWhenLocked );
+        CPPUNIT_TEST( testReadTryLockWhenLocked );
+        CPPUNIT_TEST( testWriteTryLockWhenReadLocked );
+        CPPUNIT_TEST( testMultipleReadLocks );
+        CPPUNIT_TEST( testWriteAfterReadLockReleased );
+        CPPUNIT_TEST( testReadTryLockTimeout );
+        CPPUNIT_TEST( testWriteLockInterruptibly );
+        CPPUNIT_TEST( testNewCondition );
+        CPPUNIT_TEST( testToString );
+        CPPUNIT_TEST( testConcurrentReadersAndWriters );
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+
+        StripedReadWriteLockTest();
+        virtual ~StripedReadWriteLockTest();
+
+        void testConstructor();
+        void testLock();
+        void testGetWriteHoldCount();
+        void testReentrantReadLock();
+        void testUnlockIllegalMonitorStateException();
+        void testWriteLockWhileHoldingReadLock();
+        void testReadAfterWriteLock();
+        void testWriteTryLockWhenLocked();
+        void testReadTryLockWhenLocked();
+        void testWriteTryLockWhenReadLocked();
+        void testMultipleReadLocks();
+        void testWriteAfterReadLockReleased();
+        void testReadTryLockTimeout();
+        void testWriteLockInterruptibly();
+        void testNewCondition();
+        void testToString();
+        void testConcurrentReadersAndWriters();
+
+    };
+
+}}}}
+
+#endif /* _DECAF_UTIL_CONCURRENT_LOCKS_STRIPEDREADWRITELOCKTEST_H_ */
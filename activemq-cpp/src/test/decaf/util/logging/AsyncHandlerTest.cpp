@@ -0,0 +1,243 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AsyncHandlerTest.h"
+
+#include <decaf/util/logging/AsyncHandler.h>
+#include <decaf/util/logging/Level.h>
+#include <decaf/util/logging/LogRecord.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/Concurrent.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/Integer.h>
+
+#include <vector>
+#include <string>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::logging;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class RecordingHandler : public Handler {
+    private:
+
+        RecordingHandler( const RecordingHandler& );
+        RecordingHandler& operator= ( const RecordingHandler& );
+
+    public:
+
+        Mutex mutex;
+        std::vector<std::string> messages;
+        std::vector<long long> threads;
+        bool closed;
+
+        // When set the first publish signals entered and then blocks until released.
+        CountDownLatch* entered;
+        CountDownLatch* release;
+
+        RecordingHandler() : Handler(), mutex(), messages(), threads(), closed(false), entered(NULL), release(NULL) {}
+
+        virtual ~RecordingHandler() {}
+
+        virtual void publish( const LogRecord& record ) {
+
+            if( entered != NULL ) {
+                CountDownLatch* latch = release;
+                entered->countDown();
+                entered = NULL;
+                latch->await();
+            }
+
+            synchronized( &mutex ) {
+                messages.push_back( record.getMessage() );
+                threads.push_back( Thread::currentThread()->getId() );
+            }
+        }
+
+        virtual void flush() {}
+
+        virtual void close() {
+            closed = true;
+        }
+
+        int size() {
+            synchronized( &mutex ) {
+                return (int) messages.size();
+            }
+            return 0;
+        }
+    };
+
+    void publish( Handler& handler, const std::string& message ) {
+        LogRecord record;
+        record.setLevel( Level::INFO );
+        record.setMessage( message );
+        handler.publish( record );
+    }
+
+    class PublishingRunnable : public Runnable {
+    private:
+
+        PublishingRunnable( const PublishingRunnable& );
+        PublishingRunnable& operator= ( const PublishingRunnable& );
+
+    private:
+
+        Handler* handler;
+        int count;
+
+    public:
+
+        PublishingRunnable( Handler* handler, int count ) : Runnable(), handler(handler), count(count) {}
+
+        virtual ~PublishingRunnable() {}
+
+        virtual void run() {
+            for( int i = 0; i < count; ++i ) {
+                publish( *handler, Integer::toString( i ) );
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandlerTest::testPublishFromWriterThread() {
+
+    RecordingHandler* target = new RecordingHandler();
+    AsyncHandler handler( target );
+
+    for( int i = 0; i < 100; ++i ) {
+        publish( handler, Integer::toString( i ) );
+    }
+
+    for( int i = 0; i < 100 && target->size() < 100; ++i ) {
+        Thread::sleep( 50 );
+    }
+
+    CPPUNIT_ASSERT_EQUAL( 100, target->size() );
+    for( int i = 0; i < 100; ++i ) {
+        CPPUNIT_ASSERT_EQUAL( Integer::toString( i ), target->messages[i] );
+        CPPUNIT_ASSERT( target->threads[i] != Thread::currentThread()->getId() );
+    }
+
+    CPPUNIT_ASSERT_EQUAL( 0, handler.getDroppedCount() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandlerTest::testFlush() {
+
+    RecordingHandler* target = new RecordingHandler();
+    AsyncHandler handler( target );
+
+    for( int i = 0; i < 10; ++i ) {
+        publish( handler, Integer::toString( i ) );
+    }
+
+    handler.flush();
+
+    CPPUNIT_ASSERT_EQUAL( 10, target->size() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandlerTest::testDropCountingWhenFull() {
+
+    CountDownLatch entered( 1 );
+    CountDownLatch release( 1 );
+
+    RecordingHandler* target = new RecordingHandler();
+    target->entered = &entered;
+    target->release = &release;
+
+    AsyncHandler handler( target, 4 );
+    CPPUNIT_ASSERT_EQUAL( 4, handler.getStagingCapacity() );
+
+    // The writer holds the first record's slot while it is blocked publishing it.
+    publish( handler, "0" );
+    CPPUNIT_ASSERT( entered.await( 5000 ) );
+
+    for( int i = 1; i < 8; ++i ) {
+        publish( handler, Integer::toString( i ) );
+    }
+
+    CPPUNIT_ASSERT_EQUAL( 4, handler.getDroppedCount() );
+
+    release.countDown();
+    handler.close();
+
+    CPPUNIT_ASSERT( target->closed );
+    CPPUNIT_ASSERT_EQUAL( 5, target->size() );
+
+    // The drop report follows the record the writer was blocked on.
+    CPPUNIT_ASSERT_EQUAL( std::string( "0" ), target->messages[0] );
+    CPPUNIT_ASSERT( target->messages[1].find( "discarded 4" ) != std::string::npos );
+    CPPUNIT_ASSERT_EQUAL( std::string( "3" ), target->messages[4] );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandlerTest::testCloseDrainsStagedRecords() {
+
+    RecordingHandler* target = new RecordingHandler();
+    AsyncHandler handler( target );
+
+    for( int i = 0; i < 50; ++i ) {
+        publish( handler, Integer::toString( i ) );
+    }
+
+    handler.close();
+
+    CPPUNIT_ASSERT( target->closed );
+    CPPUNIT_ASSERT_EQUAL( 50, target->size() );
+
+    // Nothing is accepted once closed.
+    publish( handler, "late" );
+    CPPUNIT_ASSERT_EQUAL( 50, target->size() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandlerTest::testStagingFreedOnThreadExit() {
+
+    static const int THREAD_COUNT = 10;
+
+    RecordingHandler* target = new RecordingHandler();
+    AsyncHandler handler( target );
+
+    PublishingRunnable runnable( &handler, 10 );
+
+    for( int i = 0; i < THREAD_COUNT; ++i ) {
+        Thread thread( &runnable );
+        thread.start();
+        thread.join();
+    }
+
+    for( int i = 0; i < 100 && handler.getStagingCount() > 0; ++i ) {
+        Thread::sleep( 50 );
+    }
+
+    CPPUNIT_ASSERT_EQUAL( 0, handler.getStagingCount() );
+    CPPUNIT_ASSERT_EQUAL( THREAD_COUNT * 10, target->size() );
+
+    publish( handler, "main" );
+    CPPUNIT_ASSERT_EQUAL( 1, handler.getStagingCount() );
+}
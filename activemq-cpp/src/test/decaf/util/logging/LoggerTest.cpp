@@ -0,0 +1,132 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LoggerTest.h"
+
+#include <decaf/util/logging/Logger.h>
+#include <decaf/util/logging/Handler.h>
+#include <decaf/util/logging/Level.h>
+#include <decaf/util/logging/LogRecord.h>
+
+#include <vector>
+#include <string>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::util;
+using namespace decaf::util::logging;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class RecordingHandler : public Handler {
+    public:
+
+        std::vector<std::string> messages;
+
+        RecordingHandler() : Handler(), messages() {}
+
+        virtual ~RecordingHandler() {}
+
+        virtual void publish( const LogRecord& record ) {
+            if( isLoggable( record ) ) {
+                messages.push_back( record.getMessage() );
+            }
+        }
+
+        virtual void flush() {}
+
+        virtual void close() {}
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LoggerTest::testIsLoggable() {
+
+    Logger* logger = Logger::getLogger( "decaf.util.logging.LoggerTest.isLoggable" );
+    CPPUNIT_ASSERT( logger != NULL );
+    CPPUNIT_ASSERT( logger == Logger::getLogger( "decaf.util.logging.LoggerTest.isLoggable" ) );
+
+    // Inherits OFF from the root Logger.
+    CPPUNIT_ASSERT( !logger->isLoggable( Level::SEVERE ) );
+    CPPUNIT_ASSERT( !logger->isLoggable( Level::INFO ) );
+    CPPUNIT_ASSERT( !logger->isLoggable( Level::DEBUG ) );
+    CPPUNIT_ASSERT_EQUAL( 0, (int) Logger::getLogger( "" )->getHandlers().size() );
+
+    logger->setLevel( Level::FINEST );
+    CPPUNIT_ASSERT( logger->isLoggable( Level::DEBUG ) );
+    CPPUNIT_ASSERT( logger->isLoggable( Level::FINEST ) );
+
+    logger->setLevel( Level::OFF );
+    CPPUNIT_ASSERT( !logger->isLoggable( Level::SEVERE ) );
+
+    logger->setLevel( Level::INHERIT );
+    CPPUNIT_ASSERT( !logger->isLoggable( Level::SEVERE ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LoggerTest::testHierarchy() {
+
+    Logger* child = Logger::getLogger( "decaf.util.logging.LoggerTest.hierarchy.child" );
+    CPPUNIT_ASSERT( child->getParent() != NULL );
+    CPPUNIT_ASSERT_EQUAL( std::string( "" ), child->getParent()->getName() );
+
+    // Registering an intermediate Logger makes it the parent of existing descendants.
+    Logger* parent = Logger::getLogger( "decaf.util.logging.LoggerTest.hierarchy" );
+    CPPUNIT_ASSERT( child->getParent() == parent );
+
+    parent->setLevel( Level::FINE );
+    CPPUNIT_ASSERT( child->isLoggable( Level::FINE ) );
+    CPPUNIT_ASSERT( !child->isLoggable( Level::FINER ) );
+
+    parent->setLevel( Level::INHERIT );
+    CPPUNIT_ASSERT( !child->isLoggable( Level::FINE ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LoggerTest::testPublishToHandlers() {
+
+    Logger* parent = Logger::getLogger( "decaf.util.logging.LoggerTest.publish" );
+    Logger* child = Logger::getLogger( "decaf.util.logging.LoggerTest.publish.child" );
+
+    RecordingHandler parentHandler;
+    RecordingHandler childHandler;
+
+    parent->setLevel( Level::INFO );
+    parent->setUseParentHandlers( false );
+    parent->addHandler( &parentHandler );
+    child->addHandler( &childHandler );
+
+    child->info( __FILE__, __LINE__, "testPublishToHandlers", "published" );
+    child->debug( __FILE__, __LINE__, "testPublishToHandlers", "not published" );
+
+    CPPUNIT_ASSERT_EQUAL( 1, (int) childHandler.messages.size() );
+    CPPUNIT_ASSERT_EQUAL( std::string( "published" ), childHandler.messages[0] );
+    CPPUNIT_ASSERT_EQUAL( 1, (int) parentHandler.messages.size() );
+
+    child->setUseParentHandlers( false );
+    child->warning( __FILE__, __LINE__, "testPublishToHandlers", "child only" );
+
+    CPPUNIT_ASSERT_EQUAL( 2, (int) childHandler.messages.size() );
+    CPPUNIT_ASSERT_EQUAL( 1, (int) parentHandler.messages.size() );
+
+    child->removeHandler( &childHandler );
+    parent->removeHandler( &parentHandler );
+    child->setUseParentHandlers( true );
+    parent->setUseParentHandlers( true );
+    parent->setLevel( Level::INHERIT );
+}
@@ -49,9 +49,15 @@ CPPUNIT_TEST_SUITE_REGISTRATION( activemq::commands::XATransactionIdTest );
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::openwire::marshal::BaseDataStreamMarshallerTest );
 #include <activemq/wireformat/openwire/marshal/PrimitiveTypesMarshallerTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::openwire::marshal::PrimitiveTypesMarshallerTest );
+#include <activemq/wireformat/openwire/marshal/PrimitiveMapReaderTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::openwire::marshal::PrimitiveMapReaderTest );
 
 #include <activemq/wireformat/openwire/utils/BooleanStreamTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::openwire::utils::BooleanStreamTest );
+#include <activemq/wireformat/openwire/utils/ByteCursorTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::openwire::utils::ByteCursorTest );
+#include <activemq/wireformat/openwire/utils/FrameOutputStreamTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::openwire::utils::FrameOutputStreamTest );
 #include <activemq/wireformat/openwire/utils/HexTableTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::openwire::utils::HexTableTest );
 #include <activemq/wireformat/openwire/utils/MessagePropertyInterceptorTest.h>
@@ -84,14 +90,24 @@ CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::ActiveMQConnectionFactoryTest )
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::ActiveMQConnectionTest );
 #include <activemq/core/ActiveMQSessionTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::ActiveMQSessionTest );
+#include <activemq/core/ActiveMQStreamTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::ActiveMQStreamTest );
 #include <activemq/core/FifoMessageDispatchChannelTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::FifoMessageDispatchChannelTest );
 #include <activemq/core/SimplePriorityMessageDispatchChannelTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::SimplePriorityMessageDispatchChannelTest );
+#include <activemq/core/PriorityMessageDispatchChannelTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::PriorityMessageDispatchChannelTest );
 #include <activemq/core/ActiveMQMessageAuditTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::ActiveMQMessageAuditTest );
 #include <activemq/core/ConnectionAuditTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::ConnectionAuditTest );
+#include <activemq/core/GroupCommitterTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::GroupCommitterTest );
+#include <activemq/core/AdaptivePrefetchControllerTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::AdaptivePrefetchControllerTest );
+#include <activemq/core/ProducerMessageTemplateTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::ProducerMessageTemplateTest );
 
 #include <activemq/state/ConnectionStateTrackerTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::state::ConnectionStateTrackerTest );
@@ -112,6 +128,9 @@ CPPUNIT_TEST_SUITE_REGISTRATION( activemq::transport::failover::FailoverTranspor
 #include <activemq/transport/tcp/TcpTransportTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::transport::tcp::TcpTransportTest );
 
+#include <activemq/transport/capture/WireCaptureTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::transport::capture::WireCaptureTest );
+
 #include <activemq/transport/correlator/ResponseCorrelatorTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::transport::correlator::ResponseCorrelatorTest );
 
@@ -135,6 +154,8 @@ CPPUNIT_TEST_SUITE_REGISTRATION( activemq::util::AdvisorySupportTest );
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::util::ActiveMQMessageTransformationTest );
 #include <activemq/util/IdGeneratorTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::util::IdGeneratorTest );
+#include <activemq/util/ConnectionIdTableTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::util::ConnectionIdTableTest );
 #include <activemq/util/LongSequenceGeneratorTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::util::LongSequenceGeneratorTest );
 #include <activemq/util/PrimitiveValueNodeTest.h>
@@ -158,6 +179,17 @@ CPPUNIT_TEST_SUITE_REGISTRATION( activemq::threads::SchedulerTest );
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::threads::DedicatedTaskRunnerTest );
 #include <activemq/threads/CompositeTaskRunnerTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::threads::CompositeTaskRunnerTest );
+#include <activemq/threads/ThreadPlacementTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::threads::ThreadPlacementTest );
+
+#include <activemq/metrics/CounterTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::metrics::CounterTest );
+#include <activemq/metrics/HistogramTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::metrics::HistogramTest );
+#include <activemq/metrics/MessageTracerTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::metrics::MessageTracerTest );
+#include <activemq/metrics/MetricsSnapshotTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::metrics::MetricsSnapshotTest );
 
 #include <activemq/wireformat/WireFormatRegistryTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::WireFormatRegistryTest );
@@ -325,6 +357,8 @@ CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::concurrent::locks::AbstractQueuedS
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::concurrent::locks::ReentrantLockTest );
 #include <decaf/util/concurrent/locks/ReentrantReadWriteLockTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::concurrent::locks::ReentrantReadWriteLockTest );
+#include <decaf/util/concurrent/locks/StripedReadWriteLockTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::concurrent::locks::StripedReadWriteLockTest );
 
 #include <decaf/util/CollectionsTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::CollectionsTest );
@@ -377,6 +411,11 @@ CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::PriorityQueueTest );
 #include <decaf/util/LRUCacheTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::LRUCacheTest );
 
+#include <decaf/util/logging/LoggerTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::logging::LoggerTest );
+#include <decaf/util/logging/AsyncHandlerTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::logging::AsyncHandlerTest );
+
 #include <decaf/util/zip/DeflaterTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::zip::DeflaterTest );
 #include <decaf/util/zip/InflaterTest.h>